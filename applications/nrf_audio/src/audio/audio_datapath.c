@@ -26,6 +26,7 @@
 #include "streamctrl.h"
 #include "sd_card_playback.h"
 #include "audio_clock.h"
+#include "jitter_buf.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(audio_datapath, CONFIG_AUDIO_DATAPATH_LOG_LEVEL);
@@ -93,6 +94,9 @@ LOG_MODULE_REGISTER(audio_datapath, CONFIG_AUDIO_DATAPATH_LOG_LEVEL);
 /* How often to print under-run warning */
 #define LOG_INTERVAL_BLKS 5000
 
+/* Highest jitter buffer depth, leaving room for the frame that is added */
+#define JITTER_BUF_DEPTH_MAX_US (CONFIG_AUDIO_MAX_PRES_DLY_US - CONFIG_AUDIO_FRAME_DURATION_US)
+
 NET_BUF_POOL_FIXED_DEFINE(pool_i2s_rx, FIFO_NUM_BLKS / CONFIG_FIFO_FRAME_SPLIT_NUM,
 			  (BLK_MULTI_CHAN_SIZE_OCTETS * CONFIG_FIFO_FRAME_SPLIT_NUM),
 			  sizeof(struct audio_metadata), NULL);
@@ -170,6 +174,8 @@ static struct {
 		uint32_t pres_delay_us;
 		bool enabled;
 	} pres_comp;
+
+	struct jitter_buf jitter_buf;
 } ctrl_blk;
 
 /**
@@ -972,9 +978,136 @@ void audio_datapath_pres_delay_us_get(uint32_t *delay_us)
 	*delay_us = ctrl_blk.pres_comp.pres_delay_us;
 }
 
+/**
+ * @brief	Decode an audio frame and add the decoded blocks to the output FIFO.
+ *
+ * @param	audio_frame_in	Pointer to the coded audio frame.
+ * @param	rx_ts_us	Reception timestamp to record for the decoded blocks.
+ * @param	conceal		True to synthesize the frame with packet-loss concealment
+ *				instead of decoding its data.
+ *
+ * @return	0 if successful, error otherwise.
+ */
+static int audio_datapath_frame_decode_add(struct net_buf *audio_frame_in, uint32_t rx_ts_us,
+					   bool conceal)
+{
+	int ret;
+	struct audio_metadata *meta_in = net_buf_user_data(audio_frame_in);
+	uint32_t bad_data = meta_in->bad_data;
+	struct net_buf *audio_frame_out = net_buf_alloc(&audio_pcm_pool, K_NO_WAIT);
+
+	if (audio_frame_out == NULL) {
+		LOG_ERR("Out of I2S PCM TX buffers.");
+		return -ENOMEM;
+	}
+
+	if (conceal) {
+		/* Mark all locations as bad to make the decoder run PLC */
+		meta_in->bad_data = meta_in->locations;
+	}
+
+	/* Output I2S related metadata */
+	struct audio_metadata *meta_out = net_buf_user_data(audio_frame_out);
+	*meta_out = i2s_meta;
+	meta_out->data_len_us = meta_in->data_len_us;
+	meta_out->ref_ts_us = meta_in->ref_ts_us;
+	meta_out->data_rx_ts_us = rx_ts_us;
+	meta_out->bad_data = meta_in->bad_data;
+
+	ret = sw_codec_decode(audio_frame_in, audio_frame_out);
+
+	meta_in->bad_data = bad_data;
+
+	if (ret) {
+		net_buf_unref(audio_frame_out);
+		LOG_WRN("SW codec decode error: %d", ret);
+		return ret;
+	}
+
+	if (IS_ENABLED(CONFIG_SD_CARD_PLAYBACK)) {
+		if (sd_card_playback_is_active()) {
+			sd_card_playback_mix_with_stream((void *const)audio_frame_out->data,
+							 audio_frame_out->len);
+		}
+	}
+
+	if (audio_frame_out->len != PCM_NUM_BYTES_MONO * CONFIG_AUDIO_OUTPUT_CHANNELS) {
+		LOG_WRN("Decoded audio has wrong size: %d. Expected: %d", audio_frame_out->len,
+			PCM_NUM_BYTES_MONO * CONFIG_AUDIO_OUTPUT_CHANNELS);
+		/* Discard frame */
+		net_buf_unref(audio_frame_out);
+		return -EINVAL;
+	}
+
+	/*** Add audio data to FIFO buffer ***/
+	uint32_t num_blks_in_fifo = filled_blocks_get();
+
+	if ((num_blks_in_fifo + NUM_BLKS_IN_FRAME) > FIFO_NUM_BLKS) {
+		LOG_WRN("Output audio stream overrun - Discarding audio frame");
+
+		/* Discard frame to allow consumer to catch up */
+		net_buf_unref(audio_frame_out);
+		return -ENOSPC;
+	}
+
+	uint32_t out_blk_idx = ctrl_blk.out.prod_blk_idx;
+
+	for (uint32_t i = 0; i < NUM_BLKS_IN_FRAME; i++) {
+		if (IS_ENABLED(CONFIG_AUDIO_BIT_DEPTH_16)) {
+			memcpy(&ctrl_blk.out.fifo[out_blk_idx * BLK_MULTI_CHAN_NUM_SAMPS],
+			       (int16_t *)audio_frame_out->data, BLK_MULTI_CHAN_SIZE_OCTETS);
+		} else if (IS_ENABLED(CONFIG_AUDIO_BIT_DEPTH_32)) {
+			memcpy(&ctrl_blk.out.fifo[out_blk_idx * BLK_MULTI_CHAN_NUM_SAMPS],
+			       (int32_t *)audio_frame_out->data, BLK_MULTI_CHAN_SIZE_OCTETS);
+		}
+
+		/* Remove consumed data from net buffer */
+		net_buf_pull(audio_frame_out, BLK_MULTI_CHAN_SIZE_OCTETS);
+
+		/* Record producer block start reference */
+		ctrl_blk.out.prod_blk_ts[out_blk_idx] = rx_ts_us + (i * BLK_PERIOD_US);
+
+		out_blk_idx = NEXT_IDX(out_blk_idx);
+	}
+
+	ctrl_blk.out.prod_blk_idx = out_blk_idx;
+
+	net_buf_unref(audio_frame_out);
+
+	return 0;
+}
+
+/**
+ * @brief	Move the output FIFO depth one block towards the jitter buffer target.
+ *
+ * @note	A block is inserted by repeating the last block, and dropped by removing it.
+ *
+ * @param	depth_adj_us	Adjustment from the jitter buffer.
+ */
+static void audio_datapath_depth_adjust(int32_t depth_adj_us)
+{
+	uint16_t last_blk_idx = PREV_IDX(ctrl_blk.out.prod_blk_idx);
+
+	if (depth_adj_us > 0 && (filled_blocks_get() + 1) < FIFO_NUM_BLKS) {
+		memcpy(&ctrl_blk.out.fifo[ctrl_blk.out.prod_blk_idx * BLK_MULTI_CHAN_NUM_SAMPS],
+		       &ctrl_blk.out.fifo[last_blk_idx * BLK_MULTI_CHAN_NUM_SAMPS],
+		       BLK_MULTI_CHAN_SIZE_OCTETS);
+
+		ctrl_blk.out.prod_blk_ts[ctrl_blk.out.prod_blk_idx] =
+			ctrl_blk.out.prod_blk_ts[last_blk_idx] + BLK_PERIOD_US;
+
+		ctrl_blk.out.prod_blk_idx = NEXT_IDX(ctrl_blk.out.prod_blk_idx);
+	} else if (depth_adj_us < 0 && filled_blocks_get() > 1) {
+		ctrl_blk.out.prod_blk_idx = last_blk_idx;
+	}
+}
+
 void audio_datapath_stream_out(struct net_buf *audio_frame_in)
 {
+	int ret;
 	bool sdu_ref_not_consecutive = false;
+	uint32_t num_missing = 0;
+	uint32_t level_us;
 
 	if (!ctrl_blk.stream_started) {
 		LOG_WRN("Stream not started");
@@ -996,11 +1129,25 @@ void audio_datapath_stream_out(struct net_buf *audio_frame_in)
 
 	uint32_t sdu_ref_delta_us = meta_in->ref_ts_us - ctrl_blk.prev_pres_sdu_ref_us;
 
+	/* Audio left in the FIFO when the frame arrived */
+	level_us = filled_blocks_get() * BLK_PERIOD_US;
+
+	if (IS_ENABLED(CONFIG_AUDIO_JITTER_BUF)) {
+		num_missing = jitter_buf_gap_get(&ctrl_blk.jitter_buf, meta_in->ref_ts_us, level_us);
+	}
+
 	if (meta_in->ref_ts_us == 0 && ctrl_blk.prev_pres_sdu_ref_us == 0) {
 		/* Timestamp not received yet */
 		ctrl_blk.prev_pres_sdu_ref_us = meta_in->ref_ts_us;
 		sdu_ref_not_consecutive = true;
 
+	} else if (num_missing > 0) {
+		/* The missing frames are concealed, so the stream stays consecutive */
+		LOG_DBG("Concealing %d missing frame(s)", num_missing);
+
+		ctrl_blk.prev_pres_sdu_ref_us = meta_in->ref_ts_us;
+		consec_invalid_ts_deltas = 0;
+
 	} else if (sdu_ref_delta_us > CONSECUTIVE_TS_LIMIT_US) {
 		/* If the new timestamp is not consecutive wrt. the previous timestamp */
 		if (consec_invalid_ts_deltas) {
@@ -1054,81 +1201,34 @@ void audio_datapath_stream_out(struct net_buf *audio_frame_in)
 							 sdu_ref_not_consecutive);
 	}
 
-	/*** Decode ***/
-
-	int ret;
-	struct net_buf *audio_frame_out = net_buf_alloc(&audio_pcm_pool, K_NO_WAIT);
-
-	if (audio_frame_out == NULL) {
-		LOG_ERR("Out of I2S PCM TX buffers.");
-		return;
-	}
-
-	/* Output I2S related metadata */
-	struct audio_metadata *meta_out = net_buf_user_data(audio_frame_out);
-	*meta_out = i2s_meta;
-	meta_out->data_len_us = meta_in->data_len_us;
-	meta_out->ref_ts_us = meta_in->ref_ts_us;
-	meta_out->data_rx_ts_us = meta_in->data_rx_ts_us;
-	meta_out->bad_data = meta_in->bad_data;
-
-	ret = sw_codec_decode(audio_frame_in, audio_frame_out);
-	if (ret) {
-		net_buf_unref(audio_frame_out);
-		LOG_WRN("SW codec decode error: %d", ret);
-		return;
-	}
-
-	if (IS_ENABLED(CONFIG_SD_CARD_PLAYBACK)) {
-		if (sd_card_playback_is_active()) {
-			sd_card_playback_mix_with_stream((void *const)audio_frame_out->data,
-							 audio_frame_out->len);
+	/*** Packet-loss concealment ***/
+	for (uint32_t i = num_missing; i > 0; i--) {
+		ret = audio_datapath_frame_decode_add(
+			audio_frame_in, meta_in->data_rx_ts_us - (i * CONFIG_AUDIO_FRAME_DURATION_US),
+			true);
+		if (ret) {
+			return;
 		}
 	}
 
-	if (audio_frame_out->len != PCM_NUM_BYTES_MONO * CONFIG_AUDIO_OUTPUT_CHANNELS) {
-		LOG_WRN("Decoded audio has wrong size: %d. Expected: %d", audio_frame_out->len,
-			PCM_NUM_BYTES_MONO * CONFIG_AUDIO_OUTPUT_CHANNELS);
-		/* Discard frame */
-		net_buf_unref(audio_frame_out);
-		return;
-	}
-
-	/*** Add audio data to FIFO buffer ***/
-	uint32_t num_blks_in_fifo = filled_blocks_get();
-
-	if ((num_blks_in_fifo + NUM_BLKS_IN_FRAME) > FIFO_NUM_BLKS) {
-		LOG_WRN("Output audio stream overrun - Discarding audio frame");
-
-		/* Discard frame to allow consumer to catch up */
-		net_buf_unref(audio_frame_out);
+	ret = audio_datapath_frame_decode_add(audio_frame_in, meta_in->data_rx_ts_us, false);
+	if (ret) {
 		return;
 	}
 
-	uint32_t out_blk_idx = ctrl_blk.out.prod_blk_idx;
+	/*** Jitter buffer ***/
+	if (IS_ENABLED(CONFIG_AUDIO_JITTER_BUF)) {
+		int32_t depth_adj_us = jitter_buf_frame_rx(&ctrl_blk.jitter_buf, meta_in->ref_ts_us,
+							   meta_in->data_rx_ts_us, level_us,
+							   num_missing, meta_in->bad_data != 0);
 
-	for (uint32_t i = 0; i < NUM_BLKS_IN_FRAME; i++) {
-		if (IS_ENABLED(CONFIG_AUDIO_BIT_DEPTH_16)) {
-			memcpy(&ctrl_blk.out.fifo[out_blk_idx * BLK_MULTI_CHAN_NUM_SAMPS],
-			       (int16_t *)audio_frame_out->data, BLK_MULTI_CHAN_SIZE_OCTETS);
-		} else if (IS_ENABLED(CONFIG_AUDIO_BIT_DEPTH_32)) {
-			memcpy(&ctrl_blk.out.fifo[out_blk_idx * BLK_MULTI_CHAN_NUM_SAMPS],
-			       (int32_t *)audio_frame_out->data, BLK_MULTI_CHAN_SIZE_OCTETS);
+		/* Presentation compensation keeps the depth that the presentation delay
+		 * requires
+		 */
+		if (!ctrl_blk.pres_comp.enabled) {
+			audio_datapath_depth_adjust(depth_adj_us);
 		}
-
-		/* Remove consumed data from net buffer */
-		net_buf_pull(audio_frame_out, BLK_MULTI_CHAN_SIZE_OCTETS);
-
-		/* Record producer block start reference */
-		ctrl_blk.out.prod_blk_ts[out_blk_idx] =
-			meta_in->data_rx_ts_us + (i * BLK_PERIOD_US);
-
-		out_blk_idx = NEXT_IDX(out_blk_idx);
 	}
-
-	ctrl_blk.out.prod_blk_idx = out_blk_idx;
-
-	net_buf_unref(audio_frame_out);
 }
 
 int audio_datapath_start(struct k_msgq *audio_q_rx)
@@ -1146,6 +1246,10 @@ int audio_datapath_start(struct k_msgq *audio_q_rx)
 		/* Clear counters and mute initial audio */
 		memset(&ctrl_blk.out, 0, sizeof(ctrl_blk.out));
 
+		if (IS_ENABLED(CONFIG_AUDIO_JITTER_BUF)) {
+			jitter_buf_reset(&ctrl_blk.jitter_buf);
+		}
+
 		audio_datapath_i2s_start();
 		ctrl_blk.stream_started = true;
 
@@ -1193,6 +1297,20 @@ int audio_datapath_init(void)
 
 	ctrl_blk.pres_comp.pres_delay_us = CONFIG_BT_AUDIO_PRESENTATION_DELAY_US;
 
+	if (IS_ENABLED(CONFIG_AUDIO_JITTER_BUF)) {
+		int ret;
+
+		ret = jitter_buf_init(&ctrl_blk.jitter_buf, CONFIG_AUDIO_FRAME_DURATION_US,
+				      BLK_PERIOD_US, CONFIG_AUDIO_JITTER_BUF_DEPTH_MIN_US,
+				      JITTER_BUF_DEPTH_MAX_US, CONFIG_AUDIO_JITTER_BUF_MARGIN_US,
+				      CONFIG_AUDIO_JITTER_BUF_WINDOW_MS * USEC_PER_MSEC,
+				      CONFIG_AUDIO_JITTER_BUF_PLC_FRAMES_MAX);
+		if (ret) {
+			LOG_ERR("Failed to initialize jitter buffer: %d", ret);
+			return ret;
+		}
+	}
+
 	return 0;
 }
 
@@ -1320,6 +1438,30 @@ static int cmd_audio_pres_comp_disable(const struct shell *shell, size_t argc, c
 	return 0;
 }
 
+static int cmd_jitter_buf_stats(const struct shell *shell, size_t argc, const char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct jitter_buf_stats stats;
+
+	if (!IS_ENABLED(CONFIG_AUDIO_JITTER_BUF)) {
+		shell_print(shell, "Jitter buffer disabled");
+		return 0;
+	}
+
+	jitter_buf_stats_get(&ctrl_blk.jitter_buf, &stats);
+
+	shell_print(shell, "Depth: %u us, target: %u us (%s)", stats.depth_us, stats.target_us,
+		    ctrl_blk.pres_comp.enabled ? "set by pres comp" : "adaptive");
+	shell_print(shell, "Jitter: %u us, late peak: %u us", stats.jitter_us,
+		    stats.late_peak_us);
+	shell_print(shell, "Late frames: %u, concealed frames: %u, block under-runs: %u",
+		    stats.late_frames, stats.concealed_frames, ctrl_blk.out.total_blk_underruns);
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(test_cmd,
 			       SHELL_COND_CMD(CONFIG_SHELL, nrf_tone_start, NULL,
 					      "Start local tone from nRF5340", cmd_i2s_tone_play),
@@ -1337,6 +1479,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(test_cmd,
 			       SHELL_COND_CMD(CONFIG_SHELL, pll_pres_comp_disable, NULL,
 					      "Disable audio presentation compensation",
 					      cmd_audio_pres_comp_disable),
+			       SHELL_COND_CMD(CONFIG_AUDIO_JITTER_BUF, jitter_buf_stats, NULL,
+					      "Print jitter buffer statistics",
+					      cmd_jitter_buf_stats),
 			       SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(test, &test_cmd, "Test mode commands", NULL);
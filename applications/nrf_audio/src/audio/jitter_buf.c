@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "jitter_buf.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+/* The base transit time follows a later arrival by 1/256 of the difference per frame, so a
+ * lasting shift of the arrival times is not taken as jitter.
+ */
+#define BASE_TRANSIT_FOLLOW_SHIFT 8
+
+/* Smoothing factor of the jitter estimate, as in RFC 3550 */
+#define JITTER_SMOOTH_DIV 16
+
+int jitter_buf_init(struct jitter_buf *jb, uint32_t frame_dur_us, uint32_t blk_dur_us,
+		    uint32_t depth_min_us, uint32_t depth_max_us, uint32_t margin_us,
+		    uint32_t window_us, uint32_t plc_frames_max)
+{
+	if (jb == NULL || frame_dur_us == 0 || blk_dur_us == 0 || depth_min_us > depth_max_us ||
+	    window_us < frame_dur_us) {
+		return -EINVAL;
+	}
+
+	memset(jb, 0, sizeof(*jb));
+
+	jb->frame_dur_us = frame_dur_us;
+	jb->blk_dur_us = blk_dur_us;
+	jb->depth_min_us = depth_min_us;
+	jb->depth_max_us = depth_max_us;
+	jb->margin_us = margin_us;
+	jb->window_frames = window_us / frame_dur_us;
+	jb->plc_frames_max = plc_frames_max;
+
+	jitter_buf_reset(jb);
+
+	return 0;
+}
+
+void jitter_buf_reset(struct jitter_buf *jb)
+{
+	jb->primed = false;
+	jb->filled = false;
+	jb->window_cnt = 0;
+	jb->late_max_us[0] = 0;
+	jb->late_max_us[1] = 0;
+	jb->jitter_q4 = 0;
+
+	jb->stats.depth_us = 0;
+	jb->stats.target_us = jb->depth_min_us;
+	jb->stats.jitter_us = 0;
+	jb->stats.late_peak_us = 0;
+}
+
+uint32_t jitter_buf_gap_get(const struct jitter_buf *jb, uint32_t ref_ts_us, uint32_t level_us)
+{
+	uint32_t num_frames;
+
+	if (!jb->primed || level_us == 0) {
+		return 0;
+	}
+
+	/* Round to the nearest number of frame durations */
+	num_frames = (ref_ts_us - jb->prev_ref_ts_us + (jb->frame_dur_us / 2)) / jb->frame_dur_us;
+
+	if (num_frames < 2 || (num_frames - 1) > jb->plc_frames_max) {
+		return 0;
+	}
+
+	return num_frames - 1;
+}
+
+/* Move the target depth to cover the highest lateness of the current and previous window. */
+static void target_update(struct jitter_buf *jb, uint32_t late_us)
+{
+	uint32_t target_us;
+
+	jb->late_max_us[0] = MAX(jb->late_max_us[0], late_us);
+	jb->stats.late_peak_us = MAX(jb->late_max_us[0], jb->late_max_us[1]);
+
+	if (++jb->window_cnt >= jb->window_frames) {
+		jb->late_max_us[1] = jb->late_max_us[0];
+		jb->late_max_us[0] = 0;
+		jb->window_cnt = 0;
+	}
+
+	target_us = ROUND_UP(jb->stats.late_peak_us + jb->margin_us, jb->blk_dur_us);
+	jb->stats.target_us = CLAMP(target_us, jb->depth_min_us, jb->depth_max_us);
+}
+
+int32_t jitter_buf_frame_rx(struct jitter_buf *jb, uint32_t ref_ts_us, uint32_t rx_ts_us,
+			    uint32_t level_us, uint32_t num_missing, bool bad_data)
+{
+	int32_t transit_us = (int32_t)(rx_ts_us - ref_ts_us);
+	uint32_t late_us;
+
+	jb->stats.concealed_frames += num_missing + (bad_data ? 1 : 0);
+
+	if (!jb->primed) {
+		jb->primed = true;
+		jb->base_transit_us = transit_us;
+		jb->prev_transit_us = transit_us;
+		jb->prev_ref_ts_us = ref_ts_us;
+
+		return 0;
+	}
+
+	if (level_us == 0 && jb->filled) {
+		jb->stats.late_frames++;
+	}
+
+	/* Smoothed absolute difference between consecutive transit times */
+	jb->jitter_q4 += ((int32_t)(abs(transit_us - jb->prev_transit_us) * JITTER_SMOOTH_DIV) -
+			  (int32_t)jb->jitter_q4) /
+			 JITTER_SMOOTH_DIV;
+	jb->stats.jitter_us = jb->jitter_q4 / JITTER_SMOOTH_DIV;
+
+	/* Lateness relative to the earliest arrival */
+	if (transit_us < jb->base_transit_us) {
+		jb->base_transit_us = transit_us;
+	} else {
+		jb->base_transit_us += (transit_us - jb->base_transit_us) >>
+				       BASE_TRANSIT_FOLLOW_SHIFT;
+	}
+
+	late_us = transit_us - jb->base_transit_us;
+
+	jb->prev_transit_us = transit_us;
+	jb->prev_ref_ts_us = ref_ts_us;
+
+	target_update(jb, late_us);
+
+	/* The depth the buffer would have had if the frame had arrived on time */
+	jb->stats.depth_us = level_us + (num_missing * jb->frame_dur_us) + late_us;
+
+	if (jb->stats.depth_us < jb->stats.target_us) {
+		return jb->blk_dur_us;
+	}
+
+	/* Running empty from here on means that a frame was late */
+	jb->filled = true;
+
+	if (jb->stats.depth_us > jb->stats.target_us + jb->blk_dur_us) {
+		return -(int32_t)jb->blk_dur_us;
+	}
+
+	return 0;
+}
+
+void jitter_buf_stats_get(const struct jitter_buf *jb, struct jitter_buf_stats *stats)
+{
+	*stats = jb->stats;
+}
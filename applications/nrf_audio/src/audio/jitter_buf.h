@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/** @file
+ * @defgroup audio_app_jitter_buf Jitter buffer
+ * @{
+ * @brief Adaptive jitter buffer control for Audio applications.
+ *
+ * This module estimates the arrival jitter of the received audio frames from their SDU
+ * reference and reception timestamps. It calculates the lowest output buffer depth that covers
+ * the lateness observed over the last measurement windows, and tells the audio datapath how
+ * to move the depth towards it. It also detects missing frames, so they can be concealed.
+ */
+
+#ifndef _JITTER_BUF_H_
+#define _JITTER_BUF_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Jitter buffer statistics.
+ */
+struct jitter_buf_stats {
+	/** Buffer depth at the arrival of the last frame, had it been on time [µs]. */
+	uint32_t depth_us;
+	/** Target buffer depth [µs]. */
+	uint32_t target_us;
+	/** Smoothed arrival jitter [µs]. */
+	uint32_t jitter_us;
+	/** Highest lateness in the last two measurement windows [µs]. */
+	uint32_t late_peak_us;
+	/** Number of frames that arrived after the output buffer had run empty. */
+	uint32_t late_frames;
+	/** Number of frames synthesized by packet-loss concealment. */
+	uint32_t concealed_frames;
+};
+
+/**
+ * @brief Jitter buffer context.
+ *
+ * @note Members are private, use the functions below.
+ */
+struct jitter_buf {
+	uint32_t frame_dur_us;
+	uint32_t blk_dur_us;
+	uint32_t depth_min_us;
+	uint32_t depth_max_us;
+	uint32_t margin_us;
+	uint32_t window_frames;
+	uint32_t plc_frames_max;
+
+	bool primed;
+	bool filled;
+	uint32_t prev_ref_ts_us;
+	int32_t prev_transit_us;
+	int32_t base_transit_us;
+	uint32_t window_cnt;
+	uint32_t late_max_us[2];
+	/* Jitter estimate in 1/16 µs */
+	uint32_t jitter_q4;
+
+	struct jitter_buf_stats stats;
+};
+
+/**
+ * @brief	Initialize a jitter buffer context.
+ *
+ * @param[out]	jb		Pointer to the jitter buffer context.
+ * @param[in]	frame_dur_us	Duration of an audio frame [µs].
+ * @param[in]	blk_dur_us	Duration of an output block, the step of depth changes [µs].
+ * @param[in]	depth_min_us	Lowest target buffer depth [µs].
+ * @param[in]	depth_max_us	Highest target buffer depth [µs].
+ * @param[in]	margin_us	Depth added on top of the observed lateness [µs].
+ * @param[in]	window_us	Duration of a measurement window [µs].
+ * @param[in]	plc_frames_max	Highest number of consecutive missing frames to conceal.
+ *
+ * @retval	0		Success.
+ * @retval	-EINVAL		Invalid parameters.
+ */
+int jitter_buf_init(struct jitter_buf *jb, uint32_t frame_dur_us, uint32_t blk_dur_us,
+		    uint32_t depth_min_us, uint32_t depth_max_us, uint32_t margin_us,
+		    uint32_t window_us, uint32_t plc_frames_max);
+
+/**
+ * @brief	Restart the estimation, for example when the stream restarts.
+ *
+ * @note	The statistics counters are kept.
+ *
+ * @param[in,out]	jb	Pointer to the jitter buffer context.
+ */
+void jitter_buf_reset(struct jitter_buf *jb);
+
+/**
+ * @brief	Get the number of missing frames between the last frame and a new frame.
+ *
+ * @note	Missing frames are only concealed while the output buffer still holds audio.
+ *		Once it has run empty, the slots of the missing frames have been played as
+ *		silence, and concealing them would only add latency.
+ *
+ * @param[in]	jb		Pointer to the jitter buffer context.
+ * @param[in]	ref_ts_us	SDU reference timestamp of the new frame.
+ * @param[in]	level_us	Audio left in the output buffer when the new frame arrived [µs].
+ *
+ * @return	Number of frames to conceal before the new frame. 0 if no frames are missing,
+ *		if the output buffer is empty, or if more frames than can be concealed are
+ *		missing.
+ */
+uint32_t jitter_buf_gap_get(const struct jitter_buf *jb, uint32_t ref_ts_us, uint32_t level_us);
+
+/**
+ * @brief	Register the arrival of a frame and get the depth adjustment to apply.
+ *
+ * @param[in,out]	jb		Pointer to the jitter buffer context.
+ * @param[in]		ref_ts_us	SDU reference timestamp of the frame.
+ * @param[in]		rx_ts_us	Reception timestamp of the frame, same clock as
+ *					@p ref_ts_us.
+ * @param[in]		level_us	Audio left in the output buffer when the frame arrived,
+ *					before any concealed frames were added [µs].
+ * @param[in]		num_missing	Number of missing frames concealed before this frame.
+ * @param[in]		bad_data	True if the frame itself is concealed.
+ *
+ * @return	Depth adjustment [µs]. A positive value asks for one block to be inserted,
+ *		a negative value for one block to be dropped, and 0 for no change.
+ */
+int32_t jitter_buf_frame_rx(struct jitter_buf *jb, uint32_t ref_ts_us, uint32_t rx_ts_us,
+			    uint32_t level_us, uint32_t num_missing, bool bad_data);
+
+/**
+ * @brief	Get the jitter buffer statistics.
+ *
+ * @param[in]	jb	Pointer to the jitter buffer context.
+ * @param[out]	stats	Pointer to the statistics.
+ */
+void jitter_buf_stats_get(const struct jitter_buf *jb, struct jitter_buf_stats *stats);
+
+/**
+ * @}
+ */
+
+#endif /* _JITTER_BUF_H_ */
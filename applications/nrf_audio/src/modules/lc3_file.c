@@ -7,6 +7,8 @@
 #include "lc3_file.h"
 #include "sd_card.h"
 
+#include <string.h>
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(sd_card_lc3_file, CONFIG_MODULE_SD_CARD_LC3_FILE_LOG_LEVEL);
 
@@ -88,6 +90,184 @@ int lc3_file_frame_get(struct lc3_file_ctx *file, uint8_t *buffer, size_t buffer
 	return 0;
 }
 
+int lc3_file_cache_init(struct lc3_file_cache *cache, struct lc3_file_ctx *file, uint8_t *buf,
+			size_t ring_size, size_t frame_size_max)
+{
+	if ((cache == NULL) || (file == NULL) || (buf == NULL)) {
+		LOG_ERR("Nullptr received");
+		return -EINVAL;
+	}
+
+	/* A full chunk must fit in the ring next to a partially read frame */
+	if ((ring_size % LC3_FILE_CACHE_CHUNK_SIZE) ||
+	    (ring_size < LC3_FILE_CACHE_CHUNK_SIZE + frame_size_max + sizeof(uint16_t))) {
+		LOG_ERR("Invalid ring size: %zu", ring_size);
+		return -EINVAL;
+	}
+
+	cache->file = file;
+	cache->buf = buf;
+	cache->ring_size = ring_size;
+	cache->frame_size_max = frame_size_max;
+	/* The file has been read up to the end of the LC3 header */
+	cache->head = sizeof(struct lc3_file_header);
+	cache->parsed = cache->head;
+	cache->released = cache->head;
+	cache->eof = false;
+
+	return 0;
+}
+
+int lc3_file_cache_fill(struct lc3_file_cache *cache)
+{
+	int ret;
+	k_spinlock_key_t key;
+	size_t head;
+	size_t used;
+	size_t size;
+	size_t read_size;
+
+	if (cache == NULL) {
+		LOG_ERR("Nullptr received");
+		return -EINVAL;
+	}
+
+	while (true) {
+		key = k_spin_lock(&cache->lock);
+		head = cache->head;
+		used = head - cache->released;
+		ret = cache->eof ? -ENODATA : 0;
+		k_spin_unlock(&cache->lock, key);
+
+		if (ret) {
+			return ret;
+		}
+
+		/* Read up to the next chunk boundary, which never crosses the end of the ring */
+		size = LC3_FILE_CACHE_CHUNK_SIZE - (head % LC3_FILE_CACHE_CHUNK_SIZE);
+		if (used + size > cache->ring_size) {
+			return 0;
+		}
+
+		read_size = size;
+
+		/* The space after the head is not used by the frames being parsed */
+		ret = sd_card_read((char *)&cache->buf[head % cache->ring_size], &read_size,
+				   &cache->file->file_object);
+		if (ret) {
+			LOG_ERR("Failed to read file: %d", ret);
+			return ret;
+		}
+
+		key = k_spin_lock(&cache->lock);
+		cache->head += read_size;
+		cache->eof = (read_size < size);
+		k_spin_unlock(&cache->lock, key);
+	}
+}
+
+int lc3_file_cache_frame_get(struct lc3_file_cache *cache, const uint8_t **frame,
+			     size_t *frame_size)
+{
+	int ret = 0;
+	k_spinlock_key_t key;
+	size_t avail;
+	size_t start;
+	uint16_t frame_header;
+
+	if ((cache == NULL) || (frame == NULL) || (frame_size == NULL)) {
+		LOG_ERR("Nullptr received");
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&cache->lock);
+
+	avail = cache->head - cache->parsed;
+
+	if (avail < sizeof(frame_header)) {
+		if (!cache->eof) {
+			ret = -EAGAIN;
+		} else if (avail == 0) {
+			LOG_DBG("No more frames to read");
+			ret = -ENODATA;
+		} else {
+			ret = -EIO;
+		}
+
+		goto unlock;
+	}
+
+	/* The frame header is little endian and may wrap around the end of the ring */
+	frame_header = cache->buf[cache->parsed % cache->ring_size] |
+		       (cache->buf[(cache->parsed + 1) % cache->ring_size] << 8);
+
+	if (frame_header == 0) {
+		LOG_DBG("No more frames to read");
+		ret = -ENODATA;
+		goto unlock;
+	}
+
+	if (frame_header > cache->frame_size_max) {
+		LOG_ERR("Frame too large: %d > %zu", frame_header, cache->frame_size_max);
+		ret = -ENOMEM;
+		goto unlock;
+	}
+
+	if (avail < sizeof(frame_header) + frame_header) {
+		ret = cache->eof ? -EIO : -EAGAIN;
+		goto unlock;
+	}
+
+	start = (cache->parsed + sizeof(frame_header)) % cache->ring_size;
+
+	if (start + frame_header > cache->ring_size) {
+		/* Make the frame contiguous */
+		memcpy(&cache->buf[cache->ring_size], cache->buf,
+		       start + frame_header - cache->ring_size);
+	}
+
+	*frame = &cache->buf[start];
+	*frame_size = frame_header;
+	cache->parsed += sizeof(frame_header) + frame_header;
+
+unlock:
+	k_spin_unlock(&cache->lock, key);
+
+	if (ret == -EIO) {
+		LOG_ERR("File ends in the middle of a frame");
+	}
+
+	return ret;
+}
+
+void lc3_file_cache_frames_release(struct lc3_file_cache *cache)
+{
+	k_spinlock_key_t key;
+
+	if (cache == NULL) {
+		LOG_ERR("Nullptr received");
+		return;
+	}
+
+	key = k_spin_lock(&cache->lock);
+	cache->released = cache->parsed;
+	k_spin_unlock(&cache->lock, key);
+}
+
+void lc3_file_cache_eof_clear(struct lc3_file_cache *cache)
+{
+	k_spinlock_key_t key;
+
+	if (cache == NULL) {
+		LOG_ERR("Nullptr received");
+		return;
+	}
+
+	key = k_spin_lock(&cache->lock);
+	cache->eof = false;
+	k_spin_unlock(&cache->lock, key);
+}
+
 int lc3_file_open(struct lc3_file_ctx *file, const char *file_name)
 {
 	int ret;
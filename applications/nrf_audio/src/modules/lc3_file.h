@@ -20,8 +20,20 @@
 #include <stdint.h>
 
 #include <zephyr/fs/fs.h>
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/util.h>
 
+/** Size of the chunks read by the read-ahead cache, one SD card sector. */
+#define LC3_FILE_CACHE_CHUNK_SIZE 512
+
+/**
+ * @brief Size of the buffer for the read-ahead cache.
+ *
+ * @param ring_size		Size of the ring, a multiple of @ref LC3_FILE_CACHE_CHUNK_SIZE.
+ * @param frame_size_max	Maximum frame size.
+ */
+#define LC3_FILE_CACHE_BUF_SIZE(ring_size, frame_size_max) ((ring_size) + (frame_size_max))
+
 /**
  * @brief LC3 file header structure.
  *
@@ -54,6 +66,29 @@ struct lc3_file_ctx {
 	uint32_t number_of_samples;
 };
 
+/**
+ * @brief LC3 file read-ahead cache.
+ *
+ * This structure holds the state of a ring buffer that is filled from an open LC3 file
+ * in chunks of @ref LC3_FILE_CACHE_CHUNK_SIZE bytes. Frames are parsed from memory and
+ * returned as pointers into the ring buffer. A frame that wraps around the end of the ring
+ * is made contiguous by copying its end past the end of the ring.
+ *
+ * The positions are offsets in the stream of bytes read from the file, so that the
+ * reads are aligned to the sectors of the file.
+ */
+struct lc3_file_cache {
+	struct lc3_file_ctx *file; /**< File the cache reads from */
+	uint8_t *buf;		   /**< Ring, followed by room for the end of a wrapped frame */
+	size_t ring_size;	   /**< Size of the ring */
+	size_t frame_size_max;	   /**< Maximum frame size */
+	size_t head;		   /**< End of the data read from the file */
+	size_t parsed;		   /**< Start of the next frame header */
+	size_t released;	   /**< Start of the oldest frame in use */
+	bool eof;		   /**< End of file reached, cleared when the file is reopened */
+	struct k_spinlock lock;	   /**< Protects the positions */
+};
+
 /**
  * @brief Get the LC3 header from the file.
  *
@@ -77,6 +112,74 @@ int lc3_header_get(struct lc3_file_ctx const *const file, struct lc3_file_header
  */
 int lc3_file_frame_get(struct lc3_file_ctx *file, uint8_t *buffer, size_t buffer_size);
 
+/**
+ * @brief Initialize a read-ahead cache for an open LC3 file.
+ *
+ * @details The file must be opened with @ref lc3_file_open, and must not be read with
+ *	    @ref lc3_file_frame_get while the cache is in use.
+ *
+ * @param[out]	cache		Pointer to the cache.
+ * @param[in]	file		Pointer to the file context.
+ * @param[in]	buf		Buffer of @ref LC3_FILE_CACHE_BUF_SIZE bytes.
+ * @param[in]	ring_size	Size of the ring, a multiple of @ref LC3_FILE_CACHE_CHUNK_SIZE,
+ *				and at least @ref LC3_FILE_CACHE_CHUNK_SIZE + frame_size_max + 2.
+ * @param[in]	frame_size_max	Maximum frame size.
+ *
+ * @retval -EINVAL	Invalid parameters.
+ * @retval 0		Success.
+ */
+int lc3_file_cache_init(struct lc3_file_cache *cache, struct lc3_file_ctx *file, uint8_t *buf,
+			size_t ring_size, size_t frame_size_max);
+
+/**
+ * @brief Read from the file until the ring of the cache is full.
+ *
+ * @details Can be called from another thread than @ref lc3_file_cache_frame_get and
+ *	    @ref lc3_file_cache_frames_release.
+ *
+ * @param[in]	cache	Pointer to the cache.
+ *
+ * @retval -ENODATA	End of file reached. Frames read so far remain in the cache.
+ * @retval 0		Success.
+ */
+int lc3_file_cache_fill(struct lc3_file_cache *cache);
+
+/**
+ * @brief Get the next LC3 frame from the cache, without copying.
+ *
+ * @details The frame stays valid until it is released with
+ *	    @ref lc3_file_cache_frames_release.
+ *
+ * @param[in]	cache		Pointer to the cache.
+ * @param[out]	frame		Pointer to the frame.
+ * @param[out]	frame_size	Size of the frame.
+ *
+ * @retval -EAGAIN	The next frame has not been read from the file yet.
+ * @retval -ENODATA	No more frames to read.
+ * @retval -ENOMEM	Frame larger than the maximum frame size.
+ * @retval -EIO		The file ends in the middle of a frame.
+ * @retval 0		Success.
+ */
+int lc3_file_cache_frame_get(struct lc3_file_cache *cache, const uint8_t **frame,
+			     size_t *frame_size);
+
+/**
+ * @brief Release all frames returned by @ref lc3_file_cache_frame_get.
+ *
+ * @param[in]	cache	Pointer to the cache.
+ */
+void lc3_file_cache_frames_release(struct lc3_file_cache *cache);
+
+/**
+ * @brief Continue filling the cache after the file has been reopened.
+ *
+ * @details Used to loop a file. The frames of the reopened file follow the frames
+ *	    already in the cache.
+ *
+ * @param[in]	cache	Pointer to the cache.
+ */
+void lc3_file_cache_eof_clear(struct lc3_file_cache *cache);
+
 /**
  * @brief Open a LC3 file for reading
  *
@@ -45,8 +45,10 @@ struct lc3_stream {
 	/* Flag set at initialization to restart a stream when it reaches end. */
 	bool loop_stream;
 
+#if !defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
 	/* Pointer to the data_fifo buffer that holds valid, readable LC3 data */
 	char *active_buffer;
+#endif
 
 	/* Filename of the file being streamed */
 	char filename[CONFIG_FS_FATFS_MAX_LFN];
@@ -57,6 +59,15 @@ struct lc3_stream {
 	/* Work queue context */
 	struct k_work work;
 
+#if defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
+	/* Read-ahead cache that holds the frames read from the file */
+	struct lc3_file_cache cache;
+
+	/* Buffer used by the read-ahead cache */
+	uint8_t cache_buffer[LC3_FILE_CACHE_BUF_SIZE(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD_SIZE,
+						     CONFIG_SD_CARD_LC3_STREAMER_MAX_FRAME_SIZE)]
+		__aligned(4);
+#else
 	/* data_fifo context */
 	struct data_fifo fifo;
 
@@ -64,8 +75,18 @@ struct lc3_stream {
 	char msgq_buffer[LC3_STREAMER_BUFFER_NUM_FRAMES * sizeof(struct data_fifo_msgq)];
 	char slab_buffer[LC3_STREAMER_BUFFER_NUM_FRAMES *
 			 CONFIG_SD_CARD_LC3_STREAMER_MAX_FRAME_SIZE];
+#endif /* defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD) */
 };
 
+#if defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
+BUILD_ASSERT((CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD_SIZE % LC3_FILE_CACHE_CHUNK_SIZE) == 0,
+	     "Read-ahead size must be a multiple of the chunk size");
+BUILD_ASSERT(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD_SIZE >=
+		     LC3_FILE_CACHE_CHUNK_SIZE + CONFIG_SD_CARD_LC3_STREAMER_MAX_FRAME_SIZE +
+			     sizeof(uint16_t),
+	     "Read-ahead size must hold a chunk next to the largest frame");
+#endif
+
 static struct lc3_stream streams[CONFIG_SD_CARD_LC3_STREAMER_MAX_NUM_STREAMS];
 #if (CONFIG_SD_CARD_LC3_STREAMER_MAX_NUM_STREAMS > UINT8_MAX)
 #error "CONFIG_SD_CARD_LC3_STREAMER_MAX_NUM_STREAMS is larger than UINT8_MAX"
@@ -89,22 +110,26 @@ static int stream_close(struct lc3_stream *stream)
 		return -EINVAL;
 	}
 
+#if !defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
 	if (stream->active_buffer != NULL) {
 		data_fifo_block_free(&stream->fifo, (void *)stream->active_buffer);
 		stream->active_buffer = NULL;
 	}
+#endif
 
 	ret = lc3_file_close(&stream->file);
 	if (ret) {
 		LOG_ERR("Failed to close file %d", ret);
 	}
 
+#if !defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
 	if (stream->fifo.initialized) {
 		ret = data_fifo_uninit(&stream->fifo);
 		if (ret) {
 			LOG_ERR("Failed to empty data fifo %d", ret);
 		}
 	}
+#endif
 
 	stream->state = STREAM_IDLE;
 	memset(stream->filename, 0, sizeof(stream->filename));
@@ -112,6 +137,7 @@ static int stream_close(struct lc3_stream *stream)
 	return 0;
 }
 
+#if !defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
 /**
  * @brief Get the next frame from the file and put it in the fifo.
  *
@@ -150,6 +176,27 @@ static int put_next_frame_to_fifo(struct lc3_stream *stream)
 
 	return 0;
 }
+#endif /* !defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD) */
+
+/**
+ * @brief Load the next frames from the file.
+ *
+ * @details With read-ahead, the file is read until the cache of the stream is full.
+ *	    Otherwise, the next frame is put in the fifo.
+ *
+ * @param[in]	stream	Pointer to the stream to load the frames for.
+ *
+ * @retval	-ENODATA	End of file reached.
+ * @retval	0		Success, negative value otherwise.
+ */
+static int frames_load(struct lc3_stream *stream)
+{
+#if defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
+	return lc3_file_cache_fill(&stream->cache);
+#else
+	return put_next_frame_to_fifo(stream);
+#endif
+}
 
 /**
  * @brief Loop the stream by closing and re-opening the file, and loading the first frame.
@@ -174,7 +221,17 @@ static int stream_loop(struct lc3_stream *stream)
 		return ret;
 	}
 
-	ret = put_next_frame_to_fifo(stream);
+#if defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
+	/* The frames of the reopened file follow the frames in the cache */
+	lc3_file_cache_eof_clear(&stream->cache);
+#endif
+
+	ret = frames_load(stream);
+	if (ret == -ENODATA && IS_ENABLED(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)) {
+		/* The whole file fits in the cache */
+		ret = 0;
+	}
+
 	if (ret) {
 		LOG_ERR("Failed to put first frame after loop to fifo %d", ret);
 
@@ -200,7 +257,7 @@ static void next_frame_load(struct k_work *work)
 	int ret;
 	struct lc3_stream *stream = CONTAINER_OF(work, struct lc3_stream, work);
 
-	ret = put_next_frame_to_fifo(stream);
+	ret = frames_load(stream);
 	if (ret == -ENODATA) {
 		LOG_DBG("End of stream");
 		if (stream->loop_stream) {
@@ -221,8 +278,12 @@ static void next_frame_load(struct k_work *work)
 int lc3_streamer_next_frame_get(const uint8_t streamer_idx, const uint8_t **const frame_buffer)
 {
 	int ret;
+#if defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
+	size_t frame_size;
+#else
 	char *data_ptr;
 	size_t data_len;
+#endif
 
 	if (!initialized) {
 		LOG_ERR("LC3 streamer not initialized");
@@ -241,6 +302,39 @@ int lc3_streamer_next_frame_get(const uint8_t streamer_idx, const uint8_t **cons
 		return -EFAULT;
 	}
 
+#if defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
+	/* The frames are read directly from the cache, the previous frame is no longer used */
+	lc3_file_cache_frames_release(&stream->cache);
+
+	ret = lc3_file_cache_frame_get(&stream->cache, frame_buffer, &frame_size);
+	if (ret == -ENODATA && stream->loop_stream) {
+		/* The file is reopened by the work queue */
+		ret = -EAGAIN;
+	}
+
+	if (ret == -ENODATA) {
+		LOG_INF("Stream ended");
+		stream->state = STREAM_ENDED;
+		return -ENODATA;
+	} else if (ret && ret != -EAGAIN) {
+		LOG_ERR("Failed to get frame from cache %d", ret);
+		stream->state = STREAM_ENDED;
+		return ret;
+	}
+
+	/* Refill the space freed by the previous frame */
+	int work_ret = k_work_submit_to_queue(&lc3_streamer_work_q, &stream->work);
+
+	if (work_ret < 0) {
+		LOG_ERR("Failed to submit work item %d", work_ret);
+		return work_ret;
+	}
+
+	if (ret == -EAGAIN) {
+		LOG_DBG("Next frame is not ready");
+		return -ENOMSG;
+	}
+#else
 	if (stream->active_buffer != NULL) {
 		data_fifo_block_free(&stream->fifo, (void *)stream->active_buffer);
 		stream->active_buffer = NULL;
@@ -271,6 +365,7 @@ int lc3_streamer_next_frame_get(const uint8_t streamer_idx, const uint8_t **cons
 		LOG_ERR("Failed to submit work item %d", ret);
 		return ret;
 	}
+#endif /* defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD) */
 
 	return 0;
 }
@@ -378,9 +473,16 @@ int lc3_streamer_stream_register(const char *const filename, uint8_t *const stre
 
 	strcpy(streams[*streamer_idx].filename, filename);
 
+#if defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
+	ret = lc3_file_cache_init(&streams[*streamer_idx].cache, &streams[*streamer_idx].file,
+				  streams[*streamer_idx].cache_buffer,
+				  CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD_SIZE,
+				  CONFIG_SD_CARD_LC3_STREAMER_MAX_FRAME_SIZE);
+#else
 	ret = data_fifo_init(&streams[*streamer_idx].fifo);
+#endif
 	if (ret) {
-		LOG_ERR("Failed to initialize data fifo %d", ret);
+		LOG_ERR("Failed to initialize frame buffer %d", ret);
 		int lc3_file_ret;
 
 		lc3_file_ret = lc3_file_close(&streams[*streamer_idx].file);
@@ -393,7 +495,12 @@ int lc3_streamer_stream_register(const char *const filename, uint8_t *const stre
 
 	k_work_init(&streams[*streamer_idx].work, next_frame_load);
 
-	ret = put_next_frame_to_fifo(&streams[*streamer_idx]);
+	ret = frames_load(&streams[*streamer_idx]);
+	if (ret == -ENODATA && IS_ENABLED(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)) {
+		/* The whole file fits in the cache */
+		ret = 0;
+	}
+
 	if (ret) {
 		LOG_ERR("Failed to put next frame to fifo %d", ret);
 		streams[*streamer_idx].state = STREAM_ENDED;
@@ -518,12 +625,14 @@ int lc3_streamer_init(void)
 	}
 
 	for (int i = 0; i < ARRAY_SIZE(streams); i++) {
+#if !defined(CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD)
 		streams[i].fifo.msgq_buffer = streams[i].msgq_buffer;
 		streams[i].fifo.slab_buffer = streams[i].slab_buffer;
 		streams[i].fifo.block_size_max = WB_UP(CONFIG_SD_CARD_LC3_STREAMER_MAX_FRAME_SIZE);
 		streams[i].fifo.elements_max = LC3_STREAMER_BUFFER_NUM_FRAMES;
 		streams[i].fifo.initialized = false;
 		streams[i].active_buffer = NULL;
+#endif
 		streams[i].state = STREAM_IDLE;
 	}
 
@@ -90,6 +90,27 @@ static inline bool app_event_get_type_flag(const struct event_type *et,
  */
 #define APP_EVENT_LISTENER(lname, cb_fn) _APP_EVENT_LISTENER(lname, cb_fn)
 
+/** @brief Create an event listener object that can handle batches of events.
+ *
+ * Consecutive events of a type that has at least one batch-aware subscriber are
+ * coalesced (up to @kconfig{CONFIG_APP_EVENT_MANAGER_BATCH_SIZE} events) and the
+ * batch handler is called once for all of them, in submission order. Events passed
+ * to the batch handler cannot be consumed. Events consumed by an earlier subscriber
+ * are not included in the batch.
+ *
+ * Listeners that are not batch-aware are still notified about each event separately,
+ * but every subscriber receives the whole batch before the next subscriber is notified.
+ *
+ * If @kconfig{CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH} is disabled, the macro is
+ * equivalent to @ref APP_EVENT_LISTENER and the batch handler is not referenced.
+ *
+ * @param lname     Module name.
+ * @param cb_fn     Pointer to the event handler function.
+ * @param batch_fn  Pointer to the batch handler function.
+ */
+#define APP_EVENT_LISTENER_BATCH(lname, cb_fn, batch_fn) \
+	_APP_EVENT_LISTENER_BATCH(lname, cb_fn, batch_fn)
+
 
 /** @brief Subscribe a listener to an event type as first module that is
  *  being notified.
@@ -178,6 +199,42 @@ static inline bool app_event_get_type_flag(const struct event_type *et,
 	_APP_EVENT_TYPE_DEFINE(ename, log_fn, ev_info_struct, app_event_type_flags)
 
 
+/** @brief Define a memory pool for an event type.
+ *
+ * Events of the given type are allocated from a statically allocated pool of
+ * @p num_events objects. If the pool is exhausted, the events are allocated using
+ * app_event_manager_alloc. Events with dynamic data cannot use a pool.
+ *
+ * Events that are allocated, but never submitted must be released using
+ * @ref app_event_manager_event_free.
+ *
+ * The macro does nothing if @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_POOLS} is disabled.
+ *
+ * @param ename       Name of the event.
+ * @param num_events  Number of events in the pool.
+ */
+#define APP_EVENT_POOL_DEFINE(ename, num_events) _APP_EVENT_POOL_DEFINE(ename, num_events)
+
+
+/** @brief Assign an event type to an event queue.
+ *
+ * Events of the given type are processed by the queue with index @p queue.
+ * Event types without an assignment are processed by queue 0, which uses the system
+ * workqueue. A queue with a higher index has a higher priority. The assignment takes
+ * effect when the Application Event Manager is initialized.
+ *
+ * Requires @kconfig{CONFIG_APP_EVENT_MANAGER_QUEUES}.
+ *
+ * @param ename  Name of the event.
+ * @param queue  Index of the queue.
+ */
+#define APP_EVENT_QUEUE_ASSIGN(ename, queue) _APP_EVENT_QUEUE_ASSIGN(ename, queue)
+
+
+/** @brief Number of event queues. */
+#define APP_EVENT_QUEUE_CNT _APP_EVENT_QUEUE_CNT
+
+
 /** @brief Verify if an event ID is valid.
  *
  * The pointer to an event type structure is used as its ID. This macro
@@ -403,6 +460,108 @@ void *app_event_manager_alloc(size_t size);
 void app_event_manager_free(void *addr);
 
 
+/** @brief Free an event that was allocated, but not submitted.
+ *
+ * The event is returned to the pool of its type (see @ref APP_EVENT_POOL_DEFINE)
+ * or released using app_event_manager_free.
+ *
+ * @param aeh  Pointer to the application event header of the event.
+ **/
+void app_event_manager_event_free(struct app_event_header *aeh);
+
+
+/** @brief Event queue statistics. */
+struct app_event_manager_queue_stats {
+	/** Number of events waiting in the queue. */
+	uint32_t depth;
+
+	/** Maximum number of events waiting in the queue. */
+	uint32_t depth_max;
+
+	/** Number of events taken from the queue for processing. */
+	uint32_t processed_cnt;
+
+	/** Sum of residence times of the processed events in microseconds. */
+	uint64_t residence_total_us;
+
+	/** Maximum residence time of a processed event in microseconds. */
+	uint32_t residence_max_us;
+};
+
+
+/** @brief Get statistics of an event queue.
+ *
+ * The residence time is the time between the event submission and the start of its
+ * processing.
+ *
+ * Requires @kconfig{CONFIG_APP_EVENT_MANAGER_QUEUE_STATS}.
+ *
+ * @param queue  Index of the queue.
+ * @param stats  Pointer to the structure to be filled.
+ *
+ * @retval 0		  Success.
+ * @retval -EINVAL	  Invalid queue index.
+ */
+int app_event_manager_queue_stats_get(uint8_t queue, struct app_event_manager_queue_stats *stats);
+
+
+/** @brief Reset statistics of all event queues.
+ *
+ * The current depth of the queues is kept.
+ *
+ * Requires @kconfig{CONFIG_APP_EVENT_MANAGER_QUEUE_STATS}.
+ */
+void app_event_manager_queue_stats_reset(void);
+
+
+/** @brief Latency statistics. */
+struct app_event_manager_latency_stats {
+	/** Number of measured times. */
+	uint32_t cnt;
+
+	/** Median of the measured times in microseconds. */
+	uint32_t p50_us;
+
+	/** 99th percentile of the measured times in microseconds. */
+	uint32_t p99_us;
+
+	/** Maximum of the measured times in microseconds. */
+	uint32_t max_us;
+};
+
+
+/** @brief Get latency statistics of an event type or of its listener.
+ *
+ * If @p listener is NULL, the statistics of the residence time of the events of the given type
+ * are returned. The residence time is the time between the event submission and the start of
+ * its processing. Otherwise, the statistics of the time spent by the listener handling the
+ * events of the given type are returned. A batch of events is measured as a single handling.
+ *
+ * The percentiles are estimated using log-scale histograms and are rounded up to the upper
+ * bound of the histogram bucket.
+ *
+ * Requires @kconfig{CONFIG_APP_EVENT_MANAGER_LATENCY_STATS}.
+ *
+ * @param et        Event type, see @ref APP_EVENT_ID.
+ * @param listener  Name of the listener or NULL.
+ * @param stats     Pointer to the structure to be filled.
+ *
+ * @retval 0		  Success.
+ * @retval -EINVAL	  Invalid event type.
+ * @retval -ENOENT	  The listener is not subscribed to the event type or its handling time
+ *			  is not tracked.
+ */
+int app_event_manager_latency_stats_get(const struct event_type *et, const char *listener,
+					struct app_event_manager_latency_stats *stats);
+
+
+/** @brief Reset latency statistics of all event types and listeners.
+ *
+ * Requires @kconfig{CONFIG_APP_EVENT_MANAGER_LATENCY_STATS}.
+ */
+void app_event_manager_latency_stats_reset(void);
+
+
 /** @brief Log event.
  *
  * This helper macro simplifies event logging.
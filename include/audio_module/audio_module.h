@@ -34,7 +34,8 @@ extern "C" {
 	(p).thread.msg_rx = (fifo_rx);                                                             \
 	(p).thread.msg_tx = (fifo_tx);                                                             \
 	(p).thread.data_slab = (slab);                                                             \
-	(p).thread.data_size = (slab_size);
+	(p).thread.data_size = (slab_size);                                                        \
+	(p).thread.execution = AUDIO_MODULE_EXECUTION_THREAD;
 
 /**
  * @brief Number of valid location bits.
@@ -71,6 +72,21 @@ enum audio_module_type {
 	AUDIO_MODULE_TYPE_IN_OUT
 };
 
+/**
+ * @brief Module execution mode.
+ */
+enum audio_module_execution {
+	/* The module runs in a thread of its own. */
+	AUDIO_MODULE_EXECUTION_THREAD = 0,
+
+	/* The module has no thread and runs in the thread of the module that sends data to it.
+	 *
+	 * @note Requires CONFIG_AUDIO_MODULE_GRAPH, and is only valid for an output or an in/out
+	 *       module opened without a thread stack.
+	 */
+	AUDIO_MODULE_EXECUTION_INLINE
+};
+
 /**
  * @brief Module state.
  */
@@ -248,7 +264,7 @@ struct audio_module_description {
  * @brief Module's thread configuration structure.
  */
 struct audio_module_thread_configuration {
-	/* Thread stack. */
+	/* Thread stack, NULL for a module with AUDIO_MODULE_EXECUTION_INLINE. */
 	k_thread_stack_t *stack;
 
 	/* Thread stack size. */
@@ -263,13 +279,41 @@ struct audio_module_thread_configuration {
 	/* A pointer to a module's audio data transmitter FIFO, can be NULL. */
 	struct data_fifo *msg_tx;
 
-	/* A pointer to the audio data buffer slab, can be NULL. */
+	/* A pointer to the audio data buffer slab, can be NULL.
+	 * With CONFIG_AUDIO_MODULE_GRAPH the buffers are then taken from a shared pool.
+	 */
 	struct k_mem_slab *data_slab;
 
 	/* Size of each memory data buffer in bytes that will be
 	 * taken from the audio data buffer slab. The size can be 0.
 	 */
 	size_t data_size;
+
+	/* Execution mode of the module. */
+	enum audio_module_execution execution;
+};
+
+/**
+ * @brief Cycles spent in the data process function of a module.
+ */
+struct audio_module_cycles {
+	/* Number of audio data items processed since the module was started. */
+	uint32_t count;
+
+	/* Cycles spent on the last audio data item. */
+	uint32_t last;
+
+	/* Highest number of cycles spent on an audio data item. */
+	uint32_t max;
+
+	/* Total number of cycles spent on all audio data items. */
+	uint64_t total;
+
+	/* Cycle budget, the duration of the last audio data item in cycles. */
+	uint32_t budget;
+
+	/* Number of audio data items that took more cycles than the budget. */
+	uint32_t over_budget;
 };
 
 /**
@@ -323,6 +367,16 @@ struct audio_module_handle {
 	/* Module's thread configuration. */
 	struct audio_module_thread_configuration thread;
 
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+	/* Cycles spent in the module's data process function. */
+	struct audio_module_cycles cycles;
+
+	/* Mutex to serialise the data processing of a module with AUDIO_MODULE_EXECUTION_INLINE,
+	 * as several modules can send data to it from their own threads.
+	 */
+	struct k_mutex process_mutex;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	/* Private context for the module. */
 	struct audio_module_context *context;
 };
@@ -537,6 +591,22 @@ int audio_module_state_get(struct audio_module_handle const *const handle,
  */
 int audio_module_number_channels_calculate(uint32_t locations, int8_t *number_channels);
 
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+/**
+ * @brief Get the cycles spent in the data process function of a module.
+ *
+ * @note Modules that run in the thread of another module share the budget of that thread, so
+ *       the sum of their cycles must stay within the budget.
+ *
+ * @param handle  [in]   The handle to the module instance.
+ * @param cycles  [out]  Pointer to the cycle statistics of the module.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_cycles_get(struct audio_module_handle const *const handle,
+			    struct audio_module_cycles *cycles);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 #ifdef __cplusplus
 }
 #endif
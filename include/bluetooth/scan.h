@@ -562,6 +562,49 @@ int bt_scan_blocklist_device_add(const bt_addr_le_t *addr);
  */
 void bt_scan_blocklist_clear(void);
 
+/**@brief RSSI of the reports received from an advertiser.
+ */
+struct bt_scan_rssi {
+	/** RSSI of the last report. */
+	int8_t last;
+
+	/** Lowest RSSI. */
+	int8_t min;
+
+	/** Highest RSSI. */
+	int8_t max;
+
+	/** Smoothed average RSSI. */
+	int8_t avg;
+
+	/** Number of reports received, including the suppressed ones. */
+	uint32_t count;
+};
+
+/**@brief Get the RSSI of the reports from a recently seen advertiser.
+ *
+ * @details The RSSI is tracked for the advertisers in the duplicate
+ *          report cache, also for the reports that are not delivered
+ *          to the application.
+ *
+ * @param[in]  addr Advertiser address.
+ * @param[out] rssi RSSI of the reports from the advertiser.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If a parameter is NULL.
+ * @retval -ENOENT If the advertiser is not in the cache.
+ */
+int bt_scan_dedup_rssi_get(const bt_addr_le_t *addr, struct bt_scan_rssi *rssi);
+
+/**@brief Clear the duplicate report cache.
+ *
+ * @details Use this function to deliver the next report from every
+ *          advertiser, even if its advertising data has not changed.
+ *          The cache is also cleared when the scanning is started and
+ *          when the filters are changed.
+ */
+void bt_scan_dedup_clear(void);
+
 /**@brief Function to update the autoconnect flag after a filter match.
  *
  * @note The function should not be used when scanning is active.
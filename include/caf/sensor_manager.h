@@ -70,6 +70,14 @@ struct sm_sensor_config {
 	 * be passed to Application Event Manager.
 	 */
 	uint8_t active_events_limit;
+	/**
+	 * @brief Number of samples in a single event
+	 *
+	 * Samples are gathered in a single sensor_event and submitted together
+	 * when the given number of samples is reached. Value of 0 or 1 means
+	 * that each sample is submitted in a separate event.
+	 */
+	uint8_t samples_in_event;
 	/**
 	 * @brief Sampling period
 	 */
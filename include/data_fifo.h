@@ -17,6 +17,12 @@
  * @brief Used to allocate a memory slab, use it,
  * and signal to a receiver when the write operation has completed.
  * The reader can then read and free the memory slab when done.
+ *
+ * With @kconfig{CONFIG_DATA_FIFO_BACKEND_SPSC}, the blocks are kept in a
+ * lock-free single-producer, single-consumer ring instead. Blocks must then
+ * be locked in the order they were allocated and freed in the order they
+ * were read. The most recently allocated block can be freed by the producer
+ * without being locked.
  */
 
 #include <stddef.h>
@@ -34,8 +40,22 @@ struct data_fifo_msgq {
 struct data_fifo {
 	char *msgq_buffer;
 	char *slab_buffer;
+#if defined(CONFIG_DATA_FIFO_BACKEND_SPSC)
+	/* Ring indices, wrapping at 2 * elements_max. alloc_idx and commit_idx are only written
+	 * by the producer, read_idx and free_idx are only written by the consumer.
+	 */
+	uint32_t alloc_idx;
+	uint32_t commit_idx;
+	uint32_t read_idx;
+	uint32_t free_idx;
+	/* Set while the consumer or producer is blocked waiting for the other side. */
+	atomic_t waiters;
+	struct k_sem sem_filled;
+	struct k_sem sem_vacant;
+#else
 	struct k_mem_slab mem_slab;
 	struct k_msgq msgq;
+#endif /* CONFIG_DATA_FIFO_BACKEND_SPSC */
 	uint32_t elements_max;
 	size_t block_size_max;
 	bool initialized;
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef __CPU_LOAD_SAMPLER_H
+#define __CPU_LOAD_SAMPLER_H
+
+#include <stdint.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup cpu_load_sampler CPU usage sampler
+ * @brief Module for statistical sampling of the CPU usage.
+ *
+ * The module periodically samples the thread and the program counter interrupted by a timer
+ * interrupt, and counts the samples in tables of a fixed size.
+ *
+ * @{
+ */
+
+/** Name reported for the samples that interrupted an interrupt service routine. */
+#define CPU_LOAD_SAMPLER_ISR_NAME "isr"
+
+/** Name reported for the samples of threads that did not fit in the thread table. */
+#define CPU_LOAD_SAMPLER_OTHER_NAME "other"
+
+/** @brief Sampler statistics. */
+struct cpu_load_sampler_stats {
+	/** Number of samples taken since the last reset. */
+	uint32_t samples;
+
+	/** Number of samples not counted in the program counter table because it was full.
+	 *  These samples are still counted for their thread.
+	 */
+	uint32_t dropped;
+};
+
+/** @brief Callback for the program counter samples.
+ *
+ * @param thread    Name of the sampled thread.
+ * @param pc        Sampled program counter, or 0 if it is not available.
+ * @param count     Number of samples.
+ * @param user_data User data.
+ */
+typedef void (*cpu_load_sampler_pc_cb_t)(const char *thread, uintptr_t pc, uint32_t count,
+					 void *user_data);
+
+/** @brief Callback for the thread samples.
+ *
+ * @param thread    Name of the sampled thread.
+ * @param count     Number of samples.
+ * @param user_data User data.
+ */
+typedef void (*cpu_load_sampler_thread_cb_t)(const char *thread, uint32_t count,
+					     void *user_data);
+
+/** @brief Start sampling.
+ *
+ * If the sampler is already running, it is restarted with the new interval.
+ * Collected samples are kept.
+ *
+ * @param interval_us Sampling interval in microseconds.
+ *
+ * @retval 0 Sampling started.
+ * @retval -EINVAL Interval is zero.
+ */
+int cpu_load_sampler_start(uint32_t interval_us);
+
+/** @brief Stop sampling.
+ *
+ * Collected samples are kept.
+ */
+void cpu_load_sampler_stop(void);
+
+/** @brief Remove all collected samples. */
+void cpu_load_sampler_reset(void);
+
+/** @brief Get the sampler statistics.
+ *
+ * @param[out] stats Sampler statistics.
+ */
+void cpu_load_sampler_stats_get(struct cpu_load_sampler_stats *stats);
+
+/** @brief Iterate over the samples counted per thread and program counter.
+ *
+ * The callback is called without holding any lock, so sampling can continue during the
+ * iteration.
+ *
+ * @param cb        Callback called for every counted pair of the thread and program counter.
+ * @param user_data User data passed to the callback.
+ */
+void cpu_load_sampler_pc_foreach(cpu_load_sampler_pc_cb_t cb, void *user_data);
+
+/** @brief Iterate over the samples counted per thread.
+ *
+ * @param cb        Callback called for every thread with samples.
+ * @param user_data User data passed to the callback.
+ */
+void cpu_load_sampler_thread_foreach(cpu_load_sampler_thread_cb_t cb, void *user_data);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CPU_LOAD_SAMPLER_H */
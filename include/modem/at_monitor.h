@@ -117,6 +117,25 @@ static inline void at_monitor_resume(struct at_monitor_entry *mon)
 	mon->flags.paused = false;
 }
 
+/**
+ * @brief AT monitor statistics.
+ */
+struct at_monitor_stats {
+	/** Number of notifications queued for dispatching in the system workqueue thread. */
+	uint32_t queued;
+	/** Number of notifications dropped because the notification pool was full. */
+	uint32_t dropped;
+	/** Highest number of bytes in use in the notification pool. */
+	uint32_t pool_peak;
+};
+
+/**
+ * @brief Get the AT monitor statistics.
+ *
+ * @param stats Pointer to the structure to store the statistics in.
+ */
+void at_monitor_stats_get(struct at_monitor_stats *stats);
+
 /** @} */
 
 #ifdef __cplusplus
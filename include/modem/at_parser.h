@@ -36,6 +36,20 @@ enum at_parser_cmd_type {
 	AT_PARSER_CMD_TYPE_TEST
 };
 
+/**
+ * @brief Entry of an AT parser token index.
+ *
+ * The content is private to the parser.
+ */
+struct at_parser_token {
+	/* Start of the token in the AT command string. */
+	const char *start;
+	/* Length of the token. */
+	size_t len;
+	/* Token type. */
+	uint8_t type;
+};
+
 /**
  * @brief AT parser
  *
@@ -53,6 +67,22 @@ struct at_parser {
 	bool is_next_empty;
 	/* Sentinel value for determining initialization state. */
 	uint32_t init_sentinel;
+	/* Token index of the current AT command line. */
+	struct at_parser_token *index;
+	/* Number of entries that fit in the token index. */
+	size_t index_size;
+	/* Number of tokens in the token index. */
+	size_t index_count;
+	/* Error that ended indexing of the current line, or 0 if the index is full. */
+	int index_err;
+	/* Cursor after the last indexed token, where sequential parsing continues. */
+	const char *index_cursor;
+	/* Value of is_next_empty after the last indexed token. */
+	bool index_next_empty;
+#if defined(CONFIG_AT_PARSER_INDEX_SIZE) && (CONFIG_AT_PARSER_INDEX_SIZE > 0)
+	/* Built-in token index used by at_parser_init(). */
+	struct at_parser_token index_buf[CONFIG_AT_PARSER_INDEX_SIZE];
+#endif
 };
 
 /**
@@ -99,6 +129,28 @@ struct at_parser {
  */
 int at_parser_init(struct at_parser *parser, const char *at);
 
+/**
+ * @brief Initialize an AT parser with a token index for a given AT command string.
+ *
+ * The parser tokenizes each AT command line once, when it is initialized and when it moves to
+ * the next line, and stores the tokens in @p tokens. Values at indices covered by the token
+ * index are then retrieved in constant time, in any order. Values at higher indices are parsed
+ * sequentially, starting after the last indexed token.
+ *
+ * The token array must remain valid for as long as the parser is used.
+ *
+ * @param[in] parser     A pointer to the AT parser.
+ * @param[in] at         A pointer to the AT command string to parse.
+ * @param[in] tokens     A pointer to the token array.
+ * @param[in] num_tokens Number of entries in @p tokens.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ * @retval -EINVAL One or more of the supplied parameters are invalid.
+ */
+int at_parser_init_indexed(struct at_parser *parser, const char *at,
+			   struct at_parser_token *tokens, size_t num_tokens);
+
 /**
  * @brief Move the cursor of an AT parser to the next command line of its configured AT command
  *        string.
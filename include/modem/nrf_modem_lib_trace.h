@@ -133,6 +133,20 @@ int nrf_modem_lib_trace_peek_at(size_t offset, uint8_t *buf, size_t len);
 uint32_t nrf_modem_lib_trace_backend_bitrate_get(void);
 #endif /* defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE) || defined(__DOXYGEN__) */
 
+#if (defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE) &&                                      \
+	defined(CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION)) || defined(__DOXYGEN__)
+/** @brief Get the last measured compression ratio of the trace data.
+ *
+ * This function returns the ratio between the size of the trace data and the size of the
+ * compressed blocks written to the trace backend, multiplied by 100, measured over the last
+ * @kconfig{CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE_PERIOD_MS} period.
+ * If no blocks were compressed during the period, the previous ratio is returned.
+ *
+ * @return Compression ratio multiplied by 100, or 0 if no blocks have been compressed yet.
+ */
+uint32_t nrf_modem_lib_trace_compression_ratio_get(void);
+#endif /* (defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE) && ... || defined(__DOXYGEN__) */
+
 /** @} */
 
 #ifdef __cplusplus
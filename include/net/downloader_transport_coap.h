@@ -35,6 +35,13 @@ struct downloader_transport_coap_cfg {
 	 *  block is received successfully. A value of 0 selects the default.
 	 */
 	uint8_t max_reconnects;
+	/**
+	 * Number of block requests kept in flight. Zero sets the default,
+	 * @kconfig{CONFIG_DOWNLOADER_TRANSPORT_COAP_WINDOW}, which is also the maximum.
+	 * When more than one block is in flight, @a block_size is the largest block size
+	 * used, and the block size is adapted to the packet loss.
+	 */
+	uint8_t window;
 };
 
 /**
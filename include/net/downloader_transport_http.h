@@ -24,6 +24,12 @@
 struct downloader_transport_http_cfg {
 	/** Socket receive timeout in milliseconds. The default timeout is 30000 ms. */
 	uint32_t sock_recv_timeo_ms;
+	/**
+	 * Number of range requests kept in flight on the connection, when downloading with
+	 * range requests, at most 8. Zero sets the default,
+	 * @kconfig{CONFIG_DOWNLOADER_TRANSPORT_HTTP_PIPELINE_DEPTH}.
+	 */
+	uint8_t pipeline_depth;
 };
 
 /**
@@ -32,6 +38,7 @@ struct downloader_transport_http_cfg {
  * @param dl downloader instance
  * @param cfg HTTP transport configuration
  *
+ * @retval -EINVAL if a parameter is NULL or the pipeline depth is out of range.
  * @return Zero on success, negative errno on failure.
  */
 int downloader_transport_http_set_config(struct downloader *dl,
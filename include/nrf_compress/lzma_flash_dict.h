@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file
+ * @brief LZMA external dictionary backed by the destination flash area
+ */
+
+#ifndef NRF_COMPRESS_LZMA_FLASH_DICT_H_
+#define NRF_COMPRESS_LZMA_FLASH_DICT_H_
+
+#include <zephyr/storage/flash_map.h>
+#include "lzma_types.h"
+
+/**
+ * @brief LZMA flash dictionary
+ * @defgroup lzma_flash_dict LZMA flash dictionary
+ * @ingroup compression_decompression_subsystem
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializer of the dictionary interface that uses the destination flash area.
+ *
+ * The decompressed data is written to the flash area set with @ref lzma_flash_dict_set and
+ * the dictionary window is read back from the written data, so the decoder does not need
+ * a RAM buffer for the dictionary. The data is written in blocks of
+ * CONFIG_NRF_COMPRESS_DICTIONARY_CACHE_SIZE bytes. The destination must be erased before the
+ * decompression starts.
+ *
+ * When the decompression is finished, the decompressed data is available in the flash area,
+ * and the output buffer returned by the decompress function is not used.
+ *
+ * Use it to initialize the @a dict_if field of @ref lzma_codec, for example:
+ *
+ * @code{.c}
+ * static lzma_codec inst = {
+ *	.dict_if = LZMA_FLASH_DICT_INTERFACE,
+ * };
+ * @endcode
+ */
+#define LZMA_FLASH_DICT_INTERFACE			\
+	{						\
+		.open = lzma_flash_dict_open,		\
+		.close = lzma_flash_dict_close,		\
+		.write = lzma_flash_dict_write,		\
+		.read = lzma_flash_dict_read,		\
+	}
+
+/**
+ * @brief		Set the destination of the decompressed data.
+ *
+ * @param[in] fa	Flash area to write the decompressed data to.
+ * @param[in] offset	Offset in the flash area where the decompressed data starts. It must be
+ *			aligned to the write block size of the flash area.
+ *
+ * @retval		0 Success.
+ * @retval		-EINVAL Invalid flash area or offset.
+ * @retval		-EBUSY Dictionary is in use by the decoder.
+ */
+int lzma_flash_dict_set(const struct flash_area *fa, size_t offset);
+
+/** @brief Open dictionary interface, see @ref lzma_dictionary_open_func_t. */
+int lzma_flash_dict_open(size_t dict_size, size_t *buff_size);
+
+/** @brief Close dictionary interface, see @ref lzma_dictionary_close_func_t. */
+int lzma_flash_dict_close(void);
+
+/** @brief Write dictionary interface, see @ref lzma_dictionary_write_func_t. */
+size_t lzma_flash_dict_write(size_t pos, const uint8_t *data, size_t len);
+
+/** @brief Read dictionary interface, see @ref lzma_dictionary_read_func_t. */
+size_t lzma_flash_dict_read(size_t pos, uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* NRF_COMPRESS_LZMA_FLASH_DICT_H_ */
@@ -13,6 +13,7 @@
 #define NRF_COMPRESS_LZMA_TYPES_H_
 
 #include <zephyr/types.h>
+#include <zephyr/sys/util.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,12 +75,42 @@ typedef struct lzma_dictionary_interface_t {
 	const lzma_dictionary_read_func_t read;
 } lzma_dictionary_interface;
 
+/**
+ * @brief Size of the LZMA probability array in bytes.
+ */
+#define NRF_COMPRESS_LZMA_PROBS_SIZE \
+	((1984 + (0x300 << CONFIG_NRF_COMPRESS_LZMA_MAX_LC_LP)) * sizeof(uint16_t))
+
+/**
+ * @brief Minimum size of the memory arena in bytes, when
+ * CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA is enabled.
+ *
+ * The arena holds the probability array and, unless the external dictionary is used,
+ * the dictionary.
+ */
+#if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+#define NRF_COMPRESS_LZMA_ARENA_SIZE NRF_COMPRESS_LZMA_PROBS_SIZE
+#else
+#define NRF_COMPRESS_LZMA_ARENA_SIZE \
+	(ROUND_UP(CONFIG_NRF_COMPRESS_LZMA_MAX_DICT_SIZE, sizeof(uint32_t)) + \
+	 NRF_COMPRESS_LZMA_PROBS_SIZE)
+#endif
+
 /**
  * @brief This is an initialization context struct type. Instantionize and pass it to
  * interface functions like for e.g. nrf_compress_init_func_t, nrf_compress_decompress_func_t.
  */
 typedef struct lzma_codec_t {
 	const lzma_dictionary_interface dict_if;
+	/**
+	 * Memory lent to the decoder between the init and deinit calls, used when
+	 * CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA is enabled. It must be aligned to
+	 * CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT (and to at least 2 bytes) and be at least
+	 * @ref NRF_COMPRESS_LZMA_ARENA_SIZE bytes long.
+	 */
+	void *arena;
+	/** Size of @a arena in bytes. */
+	size_t arena_size;
 } lzma_codec;
 
 #ifdef __cplusplus
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file
+ * @defgroup nrf_rpc_schema NRF RPC schema-based serialization
+ * @{
+ * @brief Encoders and decoders generated from a declarative description of a structure.
+ *
+ * A schema lists the members of an existing structure together with their CBOR
+ * representation. @ref NRF_RPC_SCHEMA_DEFINE expands the schema into an encoder and a decoder
+ * that process all members in a single straight-line function, without the per-member validity
+ * checks of the generic @ref nrf_rpc_serialize functions, and into a compile-time bound of the
+ * encoded size. The encoded data is identical to the data produced by the generic functions,
+ * so a peer can use either of them.
+ *
+ * Each schema entry has the form @c X(kind, member, ...), where the kind is one of:
+ *
+ * - @c BOOL - a @c bool member, encoded like @ref nrf_rpc_encode_bool.
+ * - @c UINT - an unsigned integer member of any size, encoded like @ref nrf_rpc_encode_uint.
+ * - @c INT - a signed integer member of any size, encoded like @ref nrf_rpc_encode_int.
+ * - @c STR - a @c char array member holding a NULL-terminated string, encoded like
+ *   @ref nrf_rpc_encode_str.
+ * - @c BUF - a member of any type encoded as a byte string of its size, like
+ *   @ref nrf_rpc_encode_buffer.
+ * - @c VBUF - a @c uint8_t array member with the number of used bytes in another member,
+ *   given as the third argument. Encoded like @ref nrf_rpc_encode_buffer.
+ *
+ * Example:
+ *
+ * @code{.c}
+ * #define FOO_SCHEMA(X)            \
+ *	X(UINT, id)              \
+ *	X(BUF, addr)             \
+ *	X(VBUF, data, data_len)
+ *
+ * NRF_RPC_SCHEMA_DEFINE(foo, struct foo, FOO_SCHEMA);
+ *
+ * NRF_RPC_CBOR_ALLOC(group, ctx, NRF_RPC_SCHEMA_SIZE_MAX(foo));
+ * foo_encode(&ctx, &value);
+ * @endcode
+ */
+
+#ifndef NRF_RPC_SCHEMA_H_
+#define NRF_RPC_SCHEMA_H_
+
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include <nrf_rpc_cbor.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Size of a CBOR header for an item with the given argument. */
+#define NRF_RPC_SCHEMA_HEADER_SIZE(arg)                                                            \
+	(1 + ((arg) < 24 ? 0 : (arg) <= UINT8_MAX ? 1 : (arg) <= UINT16_MAX ? 2 : 4))
+
+/** @brief Maximum encoded size of a structure described by a schema.
+ *
+ * The size is derived from the sizes of the structure members and folded into a constant by
+ * the compiler.
+ *
+ * @param name Schema name passed to @ref NRF_RPC_SCHEMA_DEFINE.
+ */
+#define NRF_RPC_SCHEMA_SIZE_MAX(name) name##_size_max()
+
+/** @brief Define an encoder and a decoder for a structure.
+ *
+ * Defines the following functions:
+ *
+ * - <tt>bool name_encode(struct nrf_rpc_cbor_ctx *ctx, const type *in)</tt>
+ * - <tt>bool name_decode(struct nrf_rpc_cbor_ctx *ctx, type *out)</tt>
+ *
+ * Both return false if the buffer is too small or the data does not match the schema. After
+ * a failed decoding, the content of @c out is undefined.
+ *
+ * @param name Schema name.
+ * @param type Structure type.
+ * @param schema Schema macro that takes the entry macro as an argument.
+ */
+#define NRF_RPC_SCHEMA_DEFINE(name, type, schema)                                                  \
+	static inline size_t name##_size_max(void)                                                 \
+	{                                                                                          \
+		const type *in = NULL;                                                             \
+                                                                                                   \
+		ARG_UNUSED(in);                                                                    \
+		return 0 schema(_NRF_RPC_SCHEMA_SIZE);                                             \
+	}                                                                                          \
+	static inline bool name##_encode(struct nrf_rpc_cbor_ctx *ctx, const type *in)             \
+	{                                                                                          \
+		zcbor_state_t *zs = ctx->zs;                                                       \
+		bool ok = true;                                                                    \
+                                                                                                   \
+		schema(_NRF_RPC_SCHEMA_ENC)                                                        \
+                                                                                                   \
+		return ok;                                                                         \
+	}                                                                                          \
+	static inline bool name##_decode(struct nrf_rpc_cbor_ctx *ctx, type *out)                  \
+	{                                                                                          \
+		zcbor_state_t *zs = ctx->zs;                                                       \
+		struct zcbor_string zst;                                                           \
+		bool ok = true;                                                                    \
+                                                                                                   \
+		ARG_UNUSED(zst);                                                                   \
+		schema(_NRF_RPC_SCHEMA_DEC)                                                        \
+                                                                                                   \
+		return ok;                                                                         \
+	}
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Size bounds. The member sizes are taken from an unevaluated pointer to the structure. */
+#define _NRF_RPC_SCHEMA_SIZE(kind, member, ...) + _NRF_RPC_SCHEMA_BOUND_##kind(sizeof(in->member))
+
+#define _NRF_RPC_SCHEMA_BOUND_BOOL(size) 1
+#define _NRF_RPC_SCHEMA_BOUND_UINT(size) (1 + (size))
+#define _NRF_RPC_SCHEMA_BOUND_INT(size)	 (1 + (size))
+#define _NRF_RPC_SCHEMA_BOUND_STR(size)	 (NRF_RPC_SCHEMA_HEADER_SIZE(size) + (size))
+#define _NRF_RPC_SCHEMA_BOUND_BUF(size)	 _NRF_RPC_SCHEMA_BOUND_STR(size)
+#define _NRF_RPC_SCHEMA_BOUND_VBUF(size) _NRF_RPC_SCHEMA_BOUND_STR(size)
+
+/* Encoders. The zcbor functions fail without side effects once the buffer is exhausted, so
+ * the result is only checked once at the end.
+ */
+#define _NRF_RPC_SCHEMA_ENC(kind, ...) _NRF_RPC_SCHEMA_ENC_##kind(__VA_ARGS__)
+
+#define _NRF_RPC_SCHEMA_ENC_BOOL(member) ok &= zcbor_bool_put(zs, in->member);
+#define _NRF_RPC_SCHEMA_ENC_UINT(member) ok &= zcbor_uint_encode(zs, &in->member, sizeof(in->member));
+#define _NRF_RPC_SCHEMA_ENC_INT(member)	 ok &= zcbor_int_encode(zs, &in->member, sizeof(in->member));
+#define _NRF_RPC_SCHEMA_ENC_STR(member)                                                            \
+	ok &= zcbor_tstr_encode_ptr(zs, in->member, strnlen(in->member, sizeof(in->member)));
+#define _NRF_RPC_SCHEMA_ENC_BUF(member)                                                            \
+	ok &= zcbor_bstr_encode_ptr(zs, (const char *)&in->member, sizeof(in->member));
+#define _NRF_RPC_SCHEMA_ENC_VBUF(member, len_member)                                               \
+	ok &= (in->len_member <= sizeof(in->member)) &&                                            \
+	      zcbor_bstr_encode_ptr(zs, (const char *)in->member, in->len_member);
+
+/* Decoders. Stop at the first error, so that no data is copied from an invalid item. */
+#define _NRF_RPC_SCHEMA_DEC(kind, ...) _NRF_RPC_SCHEMA_DEC_##kind(__VA_ARGS__)
+
+#define _NRF_RPC_SCHEMA_DEC_BOOL(member) ok = ok && zcbor_bool_decode(zs, &out->member);
+#define _NRF_RPC_SCHEMA_DEC_UINT(member)                                                           \
+	ok = ok && zcbor_uint_decode(zs, &out->member, sizeof(out->member));
+#define _NRF_RPC_SCHEMA_DEC_INT(member)                                                            \
+	ok = ok && zcbor_int_decode(zs, &out->member, sizeof(out->member));
+#define _NRF_RPC_SCHEMA_DEC_STR(member)                                                            \
+	ok = ok && zcbor_tstr_decode(zs, &zst) && zst.len < sizeof(out->member);                  \
+	if (ok) {                                                                                  \
+		memcpy(out->member, zst.value, zst.len);                                           \
+		out->member[zst.len] = '\0';                                                       \
+	}
+#define _NRF_RPC_SCHEMA_DEC_BUF(member)                                                            \
+	ok = ok && zcbor_bstr_decode(zs, &zst) && zst.len == sizeof(out->member);                 \
+	if (ok) {                                                                                  \
+		memcpy(&out->member, zst.value, zst.len);                                          \
+	}
+#define _NRF_RPC_SCHEMA_DEC_VBUF(member, len_member)                                               \
+	ok = ok && zcbor_bstr_decode(zs, &zst) && zst.len <= sizeof(out->member);                 \
+	if (ok) {                                                                                  \
+		memcpy(out->member, zst.value, zst.len);                                           \
+		out->len_member = zst.len;                                                         \
+	}
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* NRF_RPC_SCHEMA_H_ */
@@ -266,6 +266,27 @@ void *nrf_rpc_decode_buffer(struct nrf_rpc_cbor_ctx *ctx, void *buffer, size_t b
  */
 const void *nrf_rpc_decode_buffer_ptr_and_size(struct nrf_rpc_cbor_ctx *ctx, size_t *size);
 
+/** @brief Decode a buffer and keep it after decoding is done.
+ *
+ * If @kconfig{CONFIG_NRF_RPC_OS_RX_BUF_POOL} is enabled and the packet was received into
+ * a reference-counted receive buffer, the returned pointer points into the packet and no data is
+ * copied. Otherwise, the buffer is copied into the scratchpad, like with
+ * @ref nrf_rpc_decode_buffer_into_scratchpad.
+ *
+ * @param[in] scratchpad Pointer to the scratchpad.
+ * @param[out] size Buffer size.
+ *
+ * @retval Pointer to the buffer, which must be released with @ref nrf_rpc_buffer_release,
+ *         or NULL if the buffer is nil or on error.
+ */
+const void *nrf_rpc_decode_buffer_borrow(struct nrf_rpc_scratchpad *scratchpad, size_t *size);
+
+/** @brief Release a buffer returned by @ref nrf_rpc_decode_buffer_borrow.
+ *
+ * @param[in] buffer Borrowed buffer, or NULL.
+ */
+void nrf_rpc_buffer_release(const void *buffer);
+
 /** @brief Decode buffer into a scratchpad.
  *
  * @param[in] scratchpad Pointer to the scratchpad.
@@ -53,6 +53,10 @@ extern void nrf_rpc_uart_initialized_hook(const struct device *uart_dev);
 
 DT_FOREACH_STATUS_OKAY(nordic_nrf_uarte, _NRF_RPC_UART_TRANSPORT_DECLARE);
 
+#if defined(CONFIG_UART_EMUL)
+DT_FOREACH_STATUS_OKAY(zephyr_uart_emul, _NRF_RPC_UART_TRANSPORT_DECLARE);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,23 @@ enum pcm_mix_mode {
 	B_MONO_INTO_A_STEREO_R,
 };
 
+/** Gain value that leaves an input unchanged, in Q2.14 fixed-point format. */
+#define PCM_MIX_GAIN_UNITY (1U << 14)
+
+/**
+ * @brief Description of one input to @ref pcm_mix_multi.
+ */
+struct pcm_mix_input {
+	/** Pointer to the PCM data. NULL is treated as silence. */
+	void const *pcm;
+
+	/** Size of the PCM data (in bytes). Must be equal to the output size. */
+	size_t size;
+
+	/** Gain applied to the input in Q2.14 format, see @ref PCM_MIX_GAIN_UNITY. */
+	uint16_t gain;
+};
+
 /**
  * @brief Mixes two buffers of PCM data.
  *
@@ -52,6 +69,31 @@ enum pcm_mix_mode {
 int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
 	    enum pcm_mix_mode mix_mode);
 
+/**
+ * @brief Mixes any number of PCM buffers into one output buffer in a single pass.
+ *
+ * @note Each input is scaled by its gain and added to the output with saturation
+ * to the range of the bit depth after every input, which gives the same result as
+ * calling @ref pcm_mix repeatedly on the output buffer.
+ * All buffers must have the same channel layout and size. The output buffer may
+ * be the same buffer as one of the inputs.
+ * Uses the DSP SIMD instructions when @kconfig{CONFIG_PCM_MIX_DSP_INSTRUCTIONS} is
+ * enabled and supported by the CPU.
+ *
+ * @param pcm_out       [out] Pointer to the output PCM data buffer.
+ * @param size_out      [in]  Size of the output PCM data buffer (in bytes).
+ * @param inputs        [in]  Array of inputs to mix.
+ * @param num_inputs    [in]  Number of elements in inputs.
+ * @param pcm_bit_depth [in]  Bit depth of PCM samples (16, 24, or 32).
+ *
+ * @retval 0            Success. Result stored in pcm_out.
+ * @retval -EINVAL      pcm_out or inputs is NULL, size_out = 0, size_out is not a
+ *			multiple of the sample size or the bit depth is not supported.
+ * @retval -EPERM       The size of an input differs from size_out.
+ */
+int pcm_mix_multi(void *const pcm_out, size_t size_out, struct pcm_mix_input const *const inputs,
+		  size_t num_inputs, uint8_t pcm_bit_depth);
+
 /**
  * @}
  */
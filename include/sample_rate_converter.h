@@ -172,6 +172,121 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 				  size_t output_size, size_t *output_written,
 				  uint32_t output_sample_rate);
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE
+/**
+ * Number of input samples kept in the polyphase history buffer. The buffer must hold the filter
+ * history and one full input block.
+ */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_HISTORY_SIZE                                               \
+	(CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX + CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS)
+
+/** Largest clock drift correction that can be applied, in parts per billion. */
+#define SAMPLE_RATE_CONVERTER_POLYPHASE_DRIFT_MAX_PPB 10000000
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+typedef int16_t sample_rate_converter_sample_t;
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+typedef int32_t sample_rate_converter_sample_t;
+#endif
+
+/** Context for the polyphase sample rate conversion */
+struct sample_rate_converter_polyphase_ctx {
+	/* Input and output sample rate to be used for the conversion. */
+	uint32_t sample_rate_input;
+	uint32_t sample_rate_output;
+
+	/* Position of the next output sample relative to the oldest sample in the history, in
+	 * input samples as a Q32.32 fixed-point number.
+	 */
+	uint64_t position;
+
+	/* Nominal step between output samples in Q32.32. The remainder of the division is
+	 * accumulated in step_error so that rational ratios are tracked exactly.
+	 */
+	uint64_t step;
+	uint32_t step_remainder;
+	uint32_t step_error;
+
+	/* Signed adjustment added to step to track clock drift, in Q32.32. */
+	int64_t drift_step;
+	int32_t drift_ppb;
+
+	/* Input samples not yet consumed by the filter. */
+	sample_rate_converter_sample_t history[SAMPLE_RATE_CONVERTER_POLYPHASE_HISTORY_SIZE];
+	size_t history_len;
+
+	/* Filter bank in Q30, one row per phase plus one extra row for interpolating the last
+	 * phase.
+	 */
+	int32_t coeffs[CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES + 1]
+		      [CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS];
+};
+
+/**
+ * @brief	Open the polyphase sample rate converter for a new stream.
+ *
+ * @details	Designs the polyphase filter bank for the given ratio and resets the stream state.
+ *		Any ratio between the input and output sample rate is supported, as long as each
+ *		rate is within a factor of eight of the other. The low-pass cut-off is placed
+ *		below the lower of the two Nyquist frequencies.
+ *
+ * @param[out]	ctx			Pointer to the polyphase conversion context.
+ * @param[in]	sample_rate_input	Sample rate of the input samples.
+ * @param[in]	sample_rate_output	Sample rate of the output samples.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	NULL pointer given for context or the sample rates are not supported.
+ */
+int sample_rate_converter_polyphase_open(struct sample_rate_converter_polyphase_ctx *ctx,
+					 uint32_t sample_rate_input, uint32_t sample_rate_output);
+
+/**
+ * @brief	Set the clock drift correction of the polyphase sample rate converter.
+ *
+ * @details	Adjusts the conversion ratio by a fraction of a sample per sample, so that the
+ *		converter can follow a source and sink that are clocked from different
+ *		oscillators without dropping or inserting samples. A positive value consumes
+ *		input samples faster, producing fewer output samples. The change takes effect from
+ *		the next output sample and does not reset the stream state.
+ *
+ * @param[in,out]	ctx		Pointer to the polyphase conversion context.
+ * @param[in]		drift_ppb	Ratio correction in parts per billion.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	NULL pointer given for context or the correction is larger than
+ *			SAMPLE_RATE_CONVERTER_POLYPHASE_DRIFT_MAX_PPB.
+ */
+int sample_rate_converter_polyphase_drift_set(struct sample_rate_converter_polyphase_ctx *ctx,
+					      int32_t drift_ppb);
+
+/**
+ * @brief	Process input samples and produce output samples with new sample rate.
+ *
+ * @details	The number of output samples depends on the ratio and the current filter phase,
+ *		and may differ by one sample between calls for the same input size. Input samples
+ *		that can not yet be used are kept in the context for the next call. The output
+ *		buffer should be able to hold at least
+ *		(input samples * output rate / input rate) + 2 samples. If it is smaller, the
+ *		remaining input is kept in the history and -ENOMEM is returned when the history
+ *		can not take the next block.
+ *
+ * @param[in,out]	ctx		Pointer to the polyphase conversion context.
+ * @param[in]		input		Pointer to samples to process.
+ * @param[in]		input_size	Size of the input in bytes.
+ * @param[out]		output		Array that output will be written.
+ * @param[in]		output_size	Size of the output array in bytes.
+ * @param[out]		output_written	Number of bytes written to output.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	Invalid parameters or the context has not been opened.
+ * @retval	-ENOMEM	Not enough space in the history for the input samples.
+ */
+int sample_rate_converter_polyphase_process(struct sample_rate_converter_polyphase_ctx *ctx,
+					    void const *const input, size_t input_size,
+					    void *const output, size_t output_size,
+					    size_t *output_written);
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE */
+
 /**
  * @}
  */
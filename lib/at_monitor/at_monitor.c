@@ -8,6 +8,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/device.h>
+#include <zephyr/sys/barrier.h>
 #include <nrf_modem_at.h>
 #include <modem/at_monitor.h>
 #include <zephyr/toolchain.h>
@@ -15,17 +16,44 @@
 
 LOG_MODULE_REGISTER(at_monitor, CONFIG_AT_MONITOR_LOG_LEVEL);
 
-struct at_notif_fifo {
-	void *fifo_reserved;
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+#define MATCH_WORDS DIV_ROUND_UP(CONFIG_AT_MONITOR_MATCHER_MONITORS, 32)
+#endif
+
+/* Notification queued in the notification pool.
+ * Notifications are allocated from the pool in the order of reception and released in the same
+ * order by the workqueue task, so the pool is a ring of variable-size records.
+ */
+struct at_notif_rec {
+	/* Size of the record, including this header, or 0 if the pool wraps at this record. */
+	uint16_t size;
+	/* The record has been filled and can be dispatched. */
+	bool ready;
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	/* The monitors have been matched when the notification was received. */
+	bool matched;
+	/* Monitors whose filter matches the notification, by index in the monitor section. */
+	uint32_t match[MATCH_WORDS];
+#endif
 	char data[]; /* Null-terminated AT notification string */
 };
 
 static void at_monitor_task(struct k_work *work);
 
-static K_FIFO_DEFINE(at_monitor_fifo);
-static K_HEAP_DEFINE(at_monitor_heap, CONFIG_AT_MONITOR_HEAP_SIZE);
 static K_WORK_DEFINE(at_monitor_work, at_monitor_task);
 
+static struct {
+	uint8_t buf[CONFIG_AT_MONITOR_HEAP_SIZE] __aligned(4);
+	/* Offset of the next record to allocate */
+	size_t head;
+	/* Offset of the oldest record */
+	size_t tail;
+	/* Bytes in use, including the unused space at the end when the pool wraps */
+	size_t used;
+	struct k_spinlock lock;
+	struct at_monitor_stats stats;
+} pool;
+
 static bool is_paused(const struct at_monitor_entry *mon)
 {
 	return mon->flags.paused;
@@ -41,6 +69,279 @@ static bool has_match(const struct at_monitor_entry *mon, const char *notif)
 	return (mon->filter == ANY || strstr(notif, mon->filter));
 }
 
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+
+/* Aho-Corasick automaton over the filters of all monitors.
+ * Node 0 is the root. Since the root is never a child and has no monitors, 0 also means none.
+ */
+struct matcher_node {
+	char c;
+	uint8_t depth;
+	/* First child */
+	uint16_t child;
+	/* Next sibling */
+	uint16_t sibling;
+	/* Longest proper suffix of this node that is also a node */
+	uint16_t fail;
+	/* Longest proper suffix of this node that ends a filter */
+	uint16_t dict;
+	/* Index plus one of the first monitor whose filter ends at this node */
+	uint16_t mon;
+};
+
+static struct {
+	struct matcher_node nodes[CONFIG_AT_MONITOR_MATCHER_NODES];
+	/* Index plus one of the next monitor with the same filter */
+	uint16_t mon_next[CONFIG_AT_MONITOR_MATCHER_MONITORS];
+	/* Monitors that match any notification */
+	uint32_t any[MATCH_WORDS];
+	bool ready;
+} matcher;
+
+static uint16_t mon_idx_get(const struct at_monitor_entry *mon)
+{
+	STRUCT_SECTION_START_EXTERN(at_monitor_entry);
+
+	return (mon - STRUCT_SECTION_START(at_monitor_entry));
+}
+
+static uint16_t matcher_child_find(uint16_t node, char c)
+{
+	uint16_t child;
+
+	for (child = matcher.nodes[node].child; child; child = matcher.nodes[child].sibling) {
+		if (matcher.nodes[child].c == c) {
+			break;
+		}
+	}
+
+	return child;
+}
+
+static int matcher_insert(const char *filter, uint16_t mon_idx, size_t *count, uint8_t *depth)
+{
+	uint16_t node = 0;
+	uint16_t child;
+
+	for (const char *c = filter; *c; c++) {
+		child = matcher_child_find(node, *c);
+		if (!child) {
+			if (*count == ARRAY_SIZE(matcher.nodes) ||
+			    matcher.nodes[node].depth == UINT8_MAX) {
+				return -ENOMEM;
+			}
+
+			child = (*count)++;
+			matcher.nodes[child] = (struct matcher_node){
+				.c = *c,
+				.depth = matcher.nodes[node].depth + 1,
+				.sibling = matcher.nodes[node].child,
+			};
+			matcher.nodes[node].child = child;
+			*depth = MAX(*depth, matcher.nodes[child].depth);
+		}
+
+		node = child;
+	}
+
+	matcher.mon_next[mon_idx] = matcher.nodes[node].mon;
+	matcher.nodes[node].mon = mon_idx + 1;
+
+	return 0;
+}
+
+/* Set the failure and dictionary links of the children of the given node. The links of all
+ * shallower nodes must already be set.
+ */
+static void matcher_link_children(uint16_t node)
+{
+	struct matcher_node *n;
+	uint16_t f;
+
+	for (uint16_t child = matcher.nodes[node].child; child;
+	     child = matcher.nodes[child].sibling) {
+		n = &matcher.nodes[child];
+		n->fail = 0;
+
+		for (f = node; f; ) {
+			f = matcher.nodes[f].fail;
+			n->fail = matcher_child_find(f, n->c);
+			if (n->fail || !f) {
+				break;
+			}
+		}
+
+		n->dict = matcher.nodes[n->fail].mon ? n->fail : matcher.nodes[n->fail].dict;
+	}
+}
+
+static int matcher_build(void)
+{
+	size_t count = 1;
+	size_t mon_count;
+	uint8_t depth = 0;
+	int err;
+
+	STRUCT_SECTION_COUNT(at_monitor_entry, &mon_count);
+	if (mon_count > ARRAY_SIZE(matcher.mon_next)) {
+		LOG_ERR("Too many monitors for the matcher: %zu", mon_count);
+		return -ENOMEM;
+	}
+
+	memset(&matcher, 0, sizeof(matcher));
+
+	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
+		uint16_t mon_idx = mon_idx_get(e);
+
+		if (e->filter == ANY || e->filter[0] == '\0') {
+			matcher.any[mon_idx / 32] |= BIT(mon_idx % 32);
+			continue;
+		}
+
+		err = matcher_insert(e->filter, mon_idx, &count, &depth);
+		if (err) {
+			LOG_ERR("Too many filter characters for the matcher");
+			return err;
+		}
+	}
+
+	/* Link the nodes in breadth-first order, one depth at a time */
+	for (uint8_t d = 0; d < depth; d++) {
+		for (uint16_t node = 0; node < count; node++) {
+			if (matcher.nodes[node].depth == d) {
+				matcher_link_children(node);
+			}
+		}
+	}
+
+	LOG_DBG("Matcher built with %zu nodes for %zu monitors", count, mon_count);
+
+	return 0;
+}
+
+/* Find all monitors whose filter matches the notification, in a single pass. */
+static void matcher_run(const char *notif, uint32_t *match)
+{
+	uint16_t state = 0;
+	uint16_t next;
+	uint16_t out;
+	uint16_t mon;
+
+	memcpy(match, matcher.any, sizeof(matcher.any));
+
+	for (const char *c = notif; *c; c++) {
+		while (!(next = matcher_child_find(state, *c)) && state) {
+			state = matcher.nodes[state].fail;
+		}
+
+		state = next;
+
+		out = matcher.nodes[state].mon ? state : matcher.nodes[state].dict;
+		for (; out; out = matcher.nodes[out].dict) {
+			for (mon = matcher.nodes[out].mon; mon; mon = matcher.mon_next[mon - 1]) {
+				match[(mon - 1) / 32] |= BIT((mon - 1) % 32);
+			}
+		}
+	}
+}
+
+static bool is_set(const uint32_t *match, const struct at_monitor_entry *mon)
+{
+	uint16_t idx = mon_idx_get(mon);
+
+	return match[idx / 32] & BIT(idx % 32);
+}
+
+#endif /* CONFIG_AT_MONITOR_MATCHER */
+
+static struct at_notif_rec *pool_rec(size_t offset)
+{
+	return (struct at_notif_rec *)&pool.buf[offset];
+}
+
+static struct at_notif_rec *pool_alloc(size_t len)
+{
+	struct at_notif_rec *rec = NULL;
+	size_t size = ROUND_UP(sizeof(struct at_notif_rec) + len + sizeof(char), 4);
+	size_t to_end;
+
+	K_SPINLOCK(&pool.lock) {
+		if (pool.used == 0) {
+			/* Start from the beginning to get the largest contiguous space */
+			pool.head = 0;
+			pool.tail = 0;
+		}
+
+		to_end = sizeof(pool.buf) - pool.head;
+
+		if (pool.head >= pool.tail && pool.used < sizeof(pool.buf) && size > to_end &&
+		    size <= pool.tail) {
+			/* Skip the space at the end of the pool */
+			if (to_end >= sizeof(struct at_notif_rec)) {
+				pool_rec(pool.head)->size = 0;
+			}
+
+			pool.used += to_end;
+			pool.head = 0;
+		} else if (pool.head >= pool.tail && pool.used < sizeof(pool.buf) &&
+			   size <= to_end) {
+			/* Fits at the end */
+		} else if (pool.head < pool.tail && size <= pool.tail - pool.head) {
+			/* Fits before the oldest record */
+		} else {
+			pool.stats.dropped++;
+			K_SPINLOCK_BREAK;
+		}
+
+		rec = pool_rec(pool.head);
+		rec->size = size;
+		rec->ready = false;
+
+		pool.head = (pool.head + size) % sizeof(pool.buf);
+		pool.used += size;
+		pool.stats.queued++;
+		pool.stats.pool_peak = MAX(pool.stats.pool_peak, pool.used);
+	}
+
+	return rec;
+}
+
+/* Get the oldest record, if it is ready. */
+static struct at_notif_rec *pool_peek(void)
+{
+	struct at_notif_rec *rec = NULL;
+
+	K_SPINLOCK(&pool.lock) {
+		if (pool.used == 0) {
+			K_SPINLOCK_BREAK;
+		}
+
+		if (sizeof(pool.buf) - pool.tail < sizeof(struct at_notif_rec) ||
+		    pool_rec(pool.tail)->size == 0) {
+			/* The pool wraps here */
+			pool.used -= sizeof(pool.buf) - pool.tail;
+			pool.tail = 0;
+		}
+
+		rec = pool_rec(pool.tail);
+	}
+
+	/* Do not read the record before the producer has published it */
+	barrier_dmem_fence_full();
+
+	return (rec && rec->ready) ? rec : NULL;
+}
+
+static void pool_free(struct at_notif_rec *rec)
+{
+	K_SPINLOCK(&pool.lock) {
+		__ASSERT_NO_MSG(rec == pool_rec(pool.tail));
+
+		pool.used -= rec->size;
+		pool.tail = (pool.tail + rec->size) % sizeof(pool.buf);
+	}
+}
+
 /* Dispatch AT notifications immediately, or schedules a workqueue task to do that.
  * Keep this function public so that it can be called by tests.
  * This function is called from an ISR.
@@ -48,14 +349,33 @@ static bool has_match(const struct at_monitor_entry *mon, const char *notif)
 void at_monitor_dispatch(const char *notif)
 {
 	bool monitored;
-	struct at_notif_fifo *at_notif;
-	size_t sz_needed;
+	struct at_notif_rec *at_notif;
+	size_t len;
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	uint32_t match[MATCH_WORDS];
+	bool matched = matcher.ready;
+#endif
 
 	__ASSERT_NO_MSG(notif != NULL);
 
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	if (matched) {
+		matcher_run(notif, match);
+	}
+#endif
+
 	monitored = false;
 	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
-		if (!is_paused(e) && has_match(e, notif)) {
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+		if (matched ? !is_set(match, e) : !has_match(e, notif)) {
+			continue;
+		}
+#else
+		if (!has_match(e, notif)) {
+			continue;
+		}
+#endif
+		if (!is_paused(e)) {
 			if (is_direct(e)) {
 				LOG_DBG("Dispatching to %p (ISR)", e->handler);
 				e->handler(notif);
@@ -67,39 +387,67 @@ void at_monitor_dispatch(const char *notif)
 	}
 
 	if (!monitored) {
-		/* Only copy monitored notifications to save heap */
+		/* Only copy monitored notifications to save memory */
 		return;
 	}
 
-	sz_needed = sizeof(struct at_notif_fifo) + strlen(notif) + sizeof(char);
+	len = strlen(notif);
 
-	at_notif = k_heap_alloc(&at_monitor_heap, sz_needed, K_NO_WAIT);
+	at_notif = pool_alloc(len);
 	if (!at_notif) {
-		LOG_WRN("No heap space for incoming notification: %s", notif);
-		__ASSERT(at_notif, "No heap space for incoming notification: %s", notif);
+		LOG_WRN("No space in pool for incoming notification: %s", notif);
 		return;
 	}
 
-	strcpy(at_notif->data, notif);
+	memcpy(at_notif->data, notif, len + sizeof(char));
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	at_notif->matched = matched;
+	if (matched) {
+		memcpy(at_notif->match, match, sizeof(match));
+	}
+#endif
+
+	/* Publish the record contents before the record */
+	barrier_dmem_fence_full();
+	at_notif->ready = true;
 
-	k_fifo_put(&at_monitor_fifo, at_notif);
 	k_work_submit(&at_monitor_work);
 }
 
 static void at_monitor_task(struct k_work *work)
 {
-	struct at_notif_fifo *at_notif;
+	struct at_notif_rec *at_notif;
 
-	while ((at_notif = k_fifo_get(&at_monitor_fifo, K_NO_WAIT))) {
-		/* Match notification with all monitors */
+	while ((at_notif = pool_peek())) {
+		/* Dispatch to all monitors matched on reception */
 		LOG_DBG("AT notif: %.*s", strlen(at_notif->data) - strlen("\r\n"), at_notif->data);
 		STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
-			if (!is_paused(e) && !is_direct(e) && has_match(e, at_notif->data)) {
-				LOG_DBG("Dispatching to %p", e->handler);
-				e->handler(at_notif->data);
+			if (is_paused(e) || is_direct(e)) {
+				continue;
+			}
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+			if (at_notif->matched ? !is_set(at_notif->match, e)
+					      : !has_match(e, at_notif->data)) {
+				continue;
 			}
+#else
+			if (!has_match(e, at_notif->data)) {
+				continue;
+			}
+#endif
+			LOG_DBG("Dispatching to %p", e->handler);
+			e->handler(at_notif->data);
 		}
-		k_heap_free(&at_monitor_heap, at_notif);
+		pool_free(at_notif);
+	}
+}
+
+void at_monitor_stats_get(struct at_monitor_stats *stats)
+{
+	__ASSERT_NO_MSG(stats != NULL);
+
+	K_SPINLOCK(&pool.lock) {
+		*stats = pool.stats;
 	}
 }
 
@@ -107,6 +455,16 @@ static int at_monitor_sys_init(void)
 {
 	int err;
 
+#if defined(CONFIG_AT_MONITOR_MATCHER)
+	err = matcher_build();
+	if (err) {
+		LOG_WRN("Matching filters one by one, increase "
+			"CONFIG_AT_MONITOR_MATCHER_NODES or CONFIG_AT_MONITOR_MATCHER_MONITORS");
+	} else {
+		matcher.ready = true;
+	}
+#endif
+
 	err = nrf_modem_at_notif_handler_set(at_monitor_dispatch);
 	if (err) {
 		LOG_ERR("Failed to hook the dispatch function, err %d", err);
@@ -231,15 +231,58 @@ finalize:
 	return 0;
 }
 
+/* Tokenize the current AT command line into the token index, if there is one, and record the
+ * state after the last indexed token, from where sequential parsing continues.
+ */
+static void at_parser_index_build(struct at_parser *parser)
+{
+	int err = 0;
+	struct at_token token;
+
+	parser->index_count = 0;
+
+	while (parser->index_count < parser->index_size) {
+		err = at_parser_tok(parser, &token);
+		if (err) {
+			break;
+		}
+
+		parser->index[parser->index_count++] = (struct at_parser_token){
+			.start = token.start,
+			.len = token.len,
+			.type = token.type,
+		};
+	}
+
+	parser->index_err = err;
+	parser->index_cursor = parser->cursor;
+	parser->index_next_empty = parser->is_next_empty;
+}
+
 /* Seek the AT parser cursor to the given index. */
 static int at_parser_seek(struct at_parser *parser, size_t index, struct at_token *token)
 {
 	int err;
 
+	if (index < parser->index_count) {
+		token->start = parser->index[index].start;
+		token->len = parser->index[index].len;
+		token->type = parser->index[index].type;
+		token->var = AT_TOKEN_VAR_NO_COMMA;
+
+		return 0;
+	}
+
+	if (parser->index_err) {
+		/* The whole line is indexed. */
+		return parser->index_err;
+	}
+
 	if (!is_index_ahead(parser, index)) {
-		/* Rewind parser. */
-		parser->cursor = parser->at;
-		parser->count = 0;
+		/* Rewind parser to the first token that is not indexed. */
+		parser->cursor = parser->index_cursor;
+		parser->count = parser->index_count;
+		parser->is_next_empty = parser->index_next_empty;
 	}
 
 	do {
@@ -261,6 +304,33 @@ int at_parser_init(struct at_parser *parser, const char *at)
 	parser->cursor = at;
 	parser->init_sentinel = INIT_SENTINEL;
 
+#if defined(CONFIG_AT_PARSER_INDEX_SIZE) && (CONFIG_AT_PARSER_INDEX_SIZE > 0)
+	parser->index = parser->index_buf;
+	parser->index_size = ARRAY_SIZE(parser->index_buf);
+#endif
+
+	at_parser_index_build(parser);
+
+	return 0;
+}
+
+int at_parser_init_indexed(struct at_parser *parser, const char *at,
+			   struct at_parser_token *tokens, size_t num_tokens)
+{
+	if (!parser || !at || !tokens || num_tokens == 0) {
+		return -EINVAL;
+	}
+
+	memset(parser, 0, sizeof(struct at_parser));
+
+	parser->at = at;
+	parser->cursor = at;
+	parser->init_sentinel = INIT_SENTINEL;
+	parser->index = tokens;
+	parser->index_size = num_tokens;
+
+	at_parser_index_build(parser);
+
 	return 0;
 }
 
@@ -291,6 +361,8 @@ int at_parser_cmd_next(struct at_parser *parser)
 	 */
 	parser->at = parser->cursor;
 
+	at_parser_index_build(parser);
+
 	return 0;
 }
 
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <data_fifo.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(data_fifo, CONFIG_DATA_FIFO_LOG_LEVEL);
+
+/* Bits in data_fifo.waiters */
+#define WAITER_CONSUMER BIT(0)
+#define WAITER_PRODUCER BIT(1)
+
+/* The indices are shared between the producer and the consumer without a lock. Each index has
+ * a single writer, so a plain load or store is enough as long as the compiler does not cache or
+ * tear it.
+ */
+#define INDEX_GET(idx)	    (*(volatile uint32_t *)&(idx))
+#define INDEX_SET(idx, val) (*(volatile uint32_t *)&(idx) = (val))
+
+/* The indices run from 0 to 2 * elements_max - 1 and then wrap. Counting each slot twice tells
+ * a full ring from an empty one, and keeps the slot mapping continuous across the wrap for any
+ * number of elements.
+ */
+static inline uint32_t index_next(struct data_fifo *data_fifo, uint32_t idx)
+{
+	idx++;
+
+	return (idx == 2 * data_fifo->elements_max) ? 0 : idx;
+}
+
+static inline uint32_t index_prev(struct data_fifo *data_fifo, uint32_t idx)
+{
+	return ((idx == 0) ? 2 * data_fifo->elements_max : idx) - 1;
+}
+
+/* Number of steps from tail forward to head */
+static inline uint32_t index_count(struct data_fifo *data_fifo, uint32_t head, uint32_t tail)
+{
+	return (head >= tail) ? (head - tail) : (head + 2 * data_fifo->elements_max - tail);
+}
+
+static inline uint32_t slot_num(struct data_fifo *data_fifo, uint32_t idx)
+{
+	return (idx < data_fifo->elements_max) ? idx : (idx - data_fifo->elements_max);
+}
+
+static inline void *slot_get(struct data_fifo *data_fifo, uint32_t idx)
+{
+	return data_fifo->slab_buffer + slot_num(data_fifo, idx) * data_fifo->block_size_max;
+}
+
+static inline struct data_fifo_msgq *desc_get(struct data_fifo *data_fifo, uint32_t idx)
+{
+	return &((struct data_fifo_msgq *)data_fifo->msgq_buffer)[slot_num(data_fifo, idx)];
+}
+
+static inline void wake(struct data_fifo *data_fifo, atomic_val_t waiter, struct k_sem *sem)
+{
+	/* Order the index update before the waiter check. The waiting side sets its flag before
+	 * it checks the index again, so one of the two will always see the other.
+	 */
+	barrier_dmem_fence_full();
+
+	if (atomic_get(&data_fifo->waiters) & waiter) {
+		k_sem_give(sem);
+	}
+}
+
+/**
+ * @brief Block until the other side has moved an index, or the timeout expires.
+ *
+ * @retval true		The condition may have changed, the caller must check again.
+ * @retval false	The timeout expired.
+ */
+static bool wait(struct data_fifo *data_fifo, atomic_val_t waiter, struct k_sem *sem,
+		 bool (*ready)(struct data_fifo *data_fifo), k_timepoint_t end)
+{
+	int ret;
+
+	(void)atomic_or(&data_fifo->waiters, waiter);
+
+	if (ready(data_fifo)) {
+		(void)atomic_and(&data_fifo->waiters, ~waiter);
+		return true;
+	}
+
+	ret = k_sem_take(sem, sys_timepoint_timeout(end));
+
+	(void)atomic_and(&data_fifo->waiters, ~waiter);
+
+	return ret == 0;
+}
+
+static bool vacant_available(struct data_fifo *data_fifo)
+{
+	return index_count(data_fifo, data_fifo->alloc_idx, INDEX_GET(data_fifo->free_idx)) <
+	       data_fifo->elements_max;
+}
+
+static bool filled_available(struct data_fifo *data_fifo)
+{
+	return data_fifo->read_idx != INDEX_GET(data_fifo->commit_idx);
+}
+
+int data_fifo_pointer_first_vacant_get(struct data_fifo *data_fifo, void **data,
+				       k_timeout_t timeout)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	while (!vacant_available(data_fifo)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMEM;
+		}
+
+		if (!wait(data_fifo, WAITER_PRODUCER, &data_fifo->sem_vacant, vacant_available,
+			  end)) {
+			return -EAGAIN;
+		}
+	}
+
+	/* Do not touch the block before the consumer has released it */
+	barrier_dmem_fence_full();
+
+	*data = slot_get(data_fifo, data_fifo->alloc_idx);
+	INDEX_SET(data_fifo->alloc_idx, index_next(data_fifo, data_fifo->alloc_idx));
+
+	return 0;
+}
+
+int data_fifo_block_lock(struct data_fifo *data_fifo, void **data, size_t size)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	uint32_t commit_idx = data_fifo->commit_idx;
+
+	if (size > data_fifo->block_size_max) {
+		LOG_ERR("Size %zu too big, max: %zu", size, data_fifo->block_size_max);
+		return -ENOMEM;
+	} else if (size == 0) {
+		LOG_ERR("Size is zero");
+		return -EINVAL;
+	}
+
+	if (commit_idx == data_fifo->alloc_idx || *data != slot_get(data_fifo, commit_idx)) {
+		LOG_ERR("Blocks must be locked in the order they were allocated");
+		return -ESPIPE;
+	}
+
+	desc_get(data_fifo, commit_idx)->block_ptr = *data;
+	desc_get(data_fifo, commit_idx)->size = size;
+
+	/* Publish the block contents and size before the index */
+	barrier_dmem_fence_full();
+	INDEX_SET(data_fifo->commit_idx, index_next(data_fifo, commit_idx));
+
+	wake(data_fifo, WAITER_CONSUMER, &data_fifo->sem_filled);
+
+	return 0;
+}
+
+int data_fifo_pointer_last_filled_get(struct data_fifo *data_fifo, void **data, size_t *size,
+				      k_timeout_t timeout)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct data_fifo_msgq *desc;
+
+	while (!filled_available(data_fifo)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		if (!wait(data_fifo, WAITER_CONSUMER, &data_fifo->sem_filled, filled_available,
+			  end)) {
+			return -EAGAIN;
+		}
+	}
+
+	/* Do not read the block before the producer has published it */
+	barrier_dmem_fence_full();
+
+	desc = desc_get(data_fifo, data_fifo->read_idx);
+	*data = desc->block_ptr;
+	*size = desc->size;
+
+	INDEX_SET(data_fifo->read_idx, index_next(data_fifo, data_fifo->read_idx));
+
+	return 0;
+}
+
+void data_fifo_block_free(struct data_fifo *data_fifo, void *data)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	/* Read commit before alloc, so a stale alloc index can never match a block that has
+	 * already been handed to the consumer.
+	 */
+	uint32_t commit_idx = INDEX_GET(data_fifo->commit_idx);
+	uint32_t alloc_idx = INDEX_GET(data_fifo->alloc_idx);
+	uint32_t last_idx = index_prev(data_fifo, alloc_idx);
+
+	if (alloc_idx != commit_idx && data == slot_get(data_fifo, last_idx)) {
+		/* The producer gives back the block it allocated last without locking it */
+		INDEX_SET(data_fifo->alloc_idx, last_idx);
+		return;
+	}
+
+	__ASSERT(data_fifo->free_idx != data_fifo->read_idx, "No block has been read");
+	__ASSERT(data == slot_get(data_fifo, data_fifo->free_idx),
+		 "Blocks must be freed in the order they were read");
+
+	/* Finish all reads of the block before it can be reused */
+	barrier_dmem_fence_full();
+	INDEX_SET(data_fifo->free_idx, index_next(data_fifo, data_fifo->free_idx));
+
+	wake(data_fifo, WAITER_PRODUCER, &data_fifo->sem_vacant);
+}
+
+int data_fifo_num_used_get(struct data_fifo *data_fifo, uint32_t *alloced_num, uint32_t *locked_num)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	/* Read the consumer indices first so that the counts can only be overestimated */
+	uint32_t free_idx = INDEX_GET(data_fifo->free_idx);
+	uint32_t read_idx = INDEX_GET(data_fifo->read_idx);
+	uint32_t commit_idx = INDEX_GET(data_fifo->commit_idx);
+	uint32_t alloc_idx = INDEX_GET(data_fifo->alloc_idx);
+
+	uint32_t alloced = index_count(data_fifo, alloc_idx, free_idx);
+	uint32_t locked = index_count(data_fifo, commit_idx, read_idx);
+
+	if (alloced < locked) {
+		LOG_ERR("Num locked %d cannot be larger than alloced %d", locked, alloced);
+		*alloced_num = UINT32_MAX;
+		*locked_num = UINT32_MAX;
+		return -EACCES;
+	}
+
+	*alloced_num = alloced;
+	*locked_num = locked;
+
+	return 0;
+}
+
+int data_fifo_empty(struct data_fifo *data_fifo)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+
+	/* Drop all blocks, both locked ones and blocks that are still being written */
+	data_fifo->alloc_idx = 0;
+	data_fifo->commit_idx = 0;
+	data_fifo->read_idx = 0;
+	data_fifo->free_idx = 0;
+
+	k_sem_reset(&data_fifo->sem_filled);
+	k_sem_reset(&data_fifo->sem_vacant);
+
+	return 0;
+}
+
+int data_fifo_uninit(struct data_fifo *data_fifo)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->initialized);
+	int ret;
+
+	ret = data_fifo_empty(data_fifo);
+	if (ret) {
+		return ret;
+	}
+
+	data_fifo->initialized = false;
+
+	return 0;
+}
+
+int data_fifo_init(struct data_fifo *data_fifo)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(!data_fifo->initialized);
+	__ASSERT_NO_MSG(data_fifo->elements_max != 0);
+	__ASSERT_NO_MSG(data_fifo->block_size_max != 0);
+	__ASSERT_NO_MSG((data_fifo->block_size_max % WB_UP(1)) == 0);
+
+	data_fifo->alloc_idx = 0;
+	data_fifo->commit_idx = 0;
+	data_fifo->read_idx = 0;
+	data_fifo->free_idx = 0;
+	atomic_clear(&data_fifo->waiters);
+
+	k_sem_init(&data_fifo->sem_filled, 0, 1);
+	k_sem_init(&data_fifo->sem_vacant, 0, 1);
+
+	data_fifo->initialized = true;
+
+	return 0;
+}
+
+bool data_fifo_state(struct data_fifo *data_fifo)
+{
+	__ASSERT_NO_MSG(data_fifo != NULL);
+	__ASSERT_NO_MSG(data_fifo->elements_max != 0);
+	__ASSERT_NO_MSG(data_fifo->block_size_max != 0);
+	__ASSERT_NO_MSG((data_fifo->block_size_max % WB_UP(1)) == 0);
+
+	return data_fifo->initialized;
+}
@@ -417,7 +417,9 @@ static int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *ce
 {
 	int err, status, tmp;
 	struct at_parser parser;
+	struct at_parser_token *tokens;
 	size_t count = 0;
+	size_t num_tokens;
 	bool incomplete = false;
 
 	__ASSERT_NO_MSG(at_response != NULL);
@@ -426,7 +428,17 @@ static int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *ce
 	cells->ncells_count = 0;
 	cells->current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
 
-	err = at_parser_init(&parser, at_response);
+	/* The parameters are not read in order, so index all of them. 2 is added to account for
+	 * the notification prefix and the last parameter, which does not have a trailing comma.
+	 */
+	num_tokens = get_char_frequency(at_response, ',') + 2;
+	tokens = k_calloc(num_tokens, sizeof(struct at_parser_token));
+	if (tokens) {
+		err = at_parser_init_indexed(&parser, at_response, tokens, num_tokens);
+	} else {
+		/* Parse the response sequentially instead. */
+		err = at_parser_init(&parser, at_response);
+	}
 	__ASSERT_NO_MSG(err == 0);
 
 	err = at_parser_cmd_count_get(&parser, &count);
@@ -607,6 +619,8 @@ static int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *ce
 	}
 
 clean_exit:
+	k_free(tokens);
+
 	return err;
 }
 
@@ -16,6 +16,8 @@
 #include <nrf_modem_trace.h>
 #include <nrf_errno.h>
 
+#include "trace_backends/compression/trace_compression.h"
+
 LOG_MODULE_REGISTER(nrf_modem_lib_trace, CONFIG_NRF_MODEM_LIB_LOG_LEVEL);
 
 K_SEM_DEFINE(trace_sem, 0, 1);
@@ -24,6 +26,12 @@ K_SEM_DEFINE(trace_done_sem, 1, 1);
 K_SEM_DEFINE(modem_trace_level_sem, 1, 1);
 
 extern struct nrf_modem_lib_trace_backend trace_backend;
+extern struct nrf_modem_lib_trace_backend trace_backend_compression;
+
+/* The compression stage writes to the selected backend */
+static const struct nrf_modem_lib_trace_backend *backend =
+	IS_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION) ? &trace_backend_compression :
+							     &trace_backend;
 static bool has_space = true;
 
 #define TRACE_THREAD_PRIORITY                                                                      \
@@ -42,11 +50,11 @@ static void backend_suspend(void)
 {
 	int err;
 
-	if (backend_suspended || !trace_backend.suspend) {
+	if (backend_suspended || !backend->suspend) {
 		return;
 	}
 
-	err = trace_backend.suspend();
+	err = backend->suspend();
 	if (err) {
 		LOG_ERR("Could not suspend trace backend");
 	}
@@ -59,11 +67,11 @@ static void backend_resume(void)
 {
 	int err;
 
-	if (!backend_suspended || !trace_backend.resume) {
+	if (!backend_suspended || !backend->resume) {
 		return;
 	}
 
-	err = trace_backend.resume();
+	err = backend->resume();
 	if (err) {
 		LOG_ERR("Could not resume trace backend");
 	}
@@ -79,22 +87,55 @@ static void backend_suspend_handle(struct k_work *item)
 
 #if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE
 static uint32_t backend_bps_avg;
-static uint32_t backend_bps_tot;
-static uint32_t backend_bps_samples;
+static uint64_t backend_bytes_tot;
+static uint64_t backend_ticks_tot;
 static int64_t backend_measurement_start;
 
 #define BACKEND_BPS_AVG_UPDATE_PERIOD K_MSEC(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE_PERIOD_MS)
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION
+static uint32_t compression_ratio;
+static uint32_t compression_raw_bytes_last;
+static uint32_t compression_compressed_bytes_last;
+
+static void compression_ratio_update(void)
+{
+	uint32_t raw_bytes;
+	uint32_t compressed_bytes;
+	uint32_t raw_delta;
+	uint32_t compressed_delta;
+
+	trace_compression_stats_get(&raw_bytes, &compressed_bytes);
+
+	/* The counters wrap around, only their difference is used */
+	raw_delta = raw_bytes - compression_raw_bytes_last;
+	compressed_delta = compressed_bytes - compression_compressed_bytes_last;
+
+	compression_raw_bytes_last = raw_bytes;
+	compression_compressed_bytes_last = compressed_bytes;
+
+	/* Keep the last ratio if no blocks were compressed during the period */
+	if (compressed_delta != 0) {
+		compression_ratio = (uint64_t)raw_delta * 100 / compressed_delta;
+	}
+}
+
+uint32_t nrf_modem_lib_trace_compression_ratio_get(void)
+{
+	return compression_ratio;
+}
+#endif
+
 static void backend_bps_reset(void)
 {
-	backend_bps_tot = 0;
-	backend_bps_samples = 0;
+	backend_bytes_tot = 0;
+	backend_ticks_tot = 0;
 }
 
-static void backend_bps_update(int bps)
+static void backend_bps_update(int size, int64_t ticks)
 {
-	backend_bps_tot += bps;
-	backend_bps_samples++;
+	backend_bytes_tot += size;
+	backend_ticks_tot += ticks;
 }
 
 static void backend_bps_avg_update(struct k_work *item);
@@ -103,15 +144,22 @@ K_WORK_DELAYABLE_DEFINE(backend_bps_avg_update_work, backend_bps_avg_update);
 
 static void backend_bps_avg_update(struct k_work *item)
 {
-	if (backend_bps_samples != 0) {
-		backend_bps_avg = backend_bps_tot / backend_bps_samples;
+	/* Sustained throughput: all bytes written over all time spent writing in the period.
+	 * Averaging the bitrate of each write instead would let small writes that only
+	 * fill a buffer outweigh the writes that wait for the backend.
+	 */
+	if (backend_ticks_tot != 0) {
+		backend_bps_avg = backend_bytes_tot * 8 * CONFIG_SYS_CLOCK_TICKS_PER_SEC /
+				  backend_ticks_tot;
 	} else {
-		/* With 0 samples the average is 0 */
+		/* Without writes the bitrate is 0 */
 		backend_bps_avg = 0;
 	}
 
 	backend_bps_reset();
 
+	IF_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION, (compression_ratio_update();))
+
 	k_work_schedule(&backend_bps_avg_update_work, BACKEND_BPS_AVG_UPDATE_PERIOD);
 }
 
@@ -128,13 +176,11 @@ static void trace_backend_bitrate_perf_start(void)
 static void trace_backend_bitrate_perf_end(int size)
 {
 	int64_t delta;
-	uint32_t bps;
 
 	delta = k_uptime_ticks() - backend_measurement_start;
 
-	if (size > 0 && delta > 0) {
-		bps = size * 8 * CONFIG_SYS_CLOCK_TICKS_PER_SEC / delta;
-		backend_bps_update(bps);
+	if (size > 0) {
+		backend_bps_update(size, delta);
 	}
 }
 
@@ -160,6 +206,10 @@ K_WORK_DELAYABLE_DEFINE(backend_bps_log_work, backend_bps_log);
 static void backend_bps_log(struct k_work *item)
 {
 	LOG_INF("Trace backend bitrate (bps): %u", backend_bps_avg);
+#if CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION
+	LOG_INF("Trace compression ratio: %u.%02u", compression_ratio / 100,
+		compression_ratio % 100);
+#endif
 
 	k_work_schedule(&backend_bps_log_work, BACKEND_BPS_LOG_PERIOD);
 }
@@ -239,7 +289,7 @@ static int trace_fragment_write(struct nrf_modem_trace_data *frag)
 	while (frag->len) {
 		PERF_START();
 
-		ret = trace_backend.write(frag->data, frag->len);
+		ret = backend->write(frag->data, frag->len);
 
 		PERF_END(ret);
 
@@ -289,19 +339,19 @@ trace_reset:
 	/* Trace backend is suspended here to keep it suspended until first trace data is received
 	 * and to suspend the trace backend after deinit and reset.
 	 */
-	if (trace_backend.suspend) {
+	if (backend->suspend) {
 		k_work_schedule(&backend_suspend_work, K_NO_WAIT);
 	}
 
 	k_sem_take(&trace_sem, K_FOREVER);
 
 	while (true) {
-		if (trace_backend.suspend) {
+		if (backend->suspend) {
 			k_work_schedule(&backend_suspend_work, BACKEND_SUSPEND_DELAY);
 		}
 
 		err = nrf_modem_trace_get(&frags, &n_frags, NRF_MODEM_OS_FOREVER);
-		if (trace_backend.suspend) {
+		if (backend->suspend) {
 			k_work_cancel_delayable(&backend_suspend_work);
 		}
 		switch (err) {
@@ -338,7 +388,7 @@ retry:
 				break;
 			case -ENOSPC:
 				nrf_modem_lib_trace_callback(NRF_MODEM_LIB_TRACE_EVT_FULL);
-				if (!trace_backend.clear) {
+				if (!backend->clear) {
 					goto deinit;
 				}
 
@@ -386,14 +436,14 @@ static int trace_init(void)
 {
 	int err;
 
-	if (!trace_backend.init || !trace_backend.deinit || !trace_backend.write) {
+	if (!backend->init || !backend->deinit || !backend->write) {
 		LOG_ERR("trace backend must implement init, deinit and write");
 		return -ENOTSUP;
 	}
 
 	k_sem_take(&trace_done_sem, K_FOREVER);
 
-	err = trace_backend.init(nrf_modem_trace_processed);
+	err = backend->init(nrf_modem_trace_processed);
 	if (err) {
 		LOG_ERR("trace_backend: init failed with err: %d", err);
 		return err;
@@ -403,6 +453,8 @@ static int trace_init(void)
 	k_sem_give(&trace_sem);
 
 #if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE
+	/* Writes from a previous trace session do not count in the first period */
+	backend_bps_reset();
 	k_work_schedule(&backend_bps_avg_update_work, BACKEND_BPS_AVG_UPDATE_PERIOD);
 #endif
 
@@ -442,7 +494,7 @@ static int trace_deinit(void)
 {
 	int err;
 
-	err = trace_backend.deinit();
+	err = backend->deinit();
 	if (err) {
 		LOG_ERR("trace_backend: deinit failed with err: %d", err);
 		return err;
@@ -492,22 +544,22 @@ int nrf_modem_lib_trace_level_set(enum nrf_modem_lib_trace_level trace_level)
 
 size_t nrf_modem_lib_trace_data_size(void)
 {
-	if (!trace_backend.data_size) {
+	if (!backend->data_size) {
 		return -ENOTSUP;
 	}
 
-	return trace_backend.data_size();
+	return backend->data_size();
 }
 
 int nrf_modem_lib_trace_read(uint8_t *buf, size_t len)
 {
 	int read;
 
-	if (!trace_backend.read) {
+	if (!backend->read) {
 		return -ENOTSUP;
 	}
 
-	read = trace_backend.read(buf, len);
+	read = backend->read(buf, len);
 	if (read > 0) {
 		UPDATE_TRACE_BYTES_READ(read);
 		/* Traces are read, we can attempt to write more. */
@@ -525,22 +577,22 @@ int nrf_modem_lib_trace_read(uint8_t *buf, size_t len)
 
 int nrf_modem_lib_trace_peek_at(size_t offset, uint8_t *buf, size_t len)
 {
-	if (!trace_backend.peek_at) {
+	if (!backend->peek_at) {
 		return -ENOTSUP;
 	}
 
-	return trace_backend.peek_at(offset, buf, len);
+	return backend->peek_at(offset, buf, len);
 }
 
 int nrf_modem_lib_trace_clear(void)
 {
 	int err;
 
-	if (!trace_backend.clear) {
+	if (!backend->clear) {
 		return -ENOTSUP;
 	}
 
-	err = trace_backend.clear();
+	err = backend->clear();
 	if (err) {
 		return err;
 	}
@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <modem/trace_backend.h>
+
+#include "trace_compression.h"
+
+LOG_MODULE_REGISTER(modem_trace_compression, CONFIG_MODEM_TRACE_BACKEND_LOG_LEVEL);
+
+#define BLOCK_SIZE CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_BLOCK_SIZE
+#define HASH_BITS CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_HASH_BITS
+
+/* LZ4 block format constraints */
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MF_LIMIT 12
+#define LZ4_MAX_OFFSET 65535
+#define LZ4_RUN_MASK 15
+
+BUILD_ASSERT(BLOCK_SIZE <= UINT16_MAX, "Block length must fit in the block header");
+
+/* The backend selected in the trace backend choice */
+extern struct nrf_modem_lib_trace_backend trace_backend;
+
+static trace_backend_processed_cb trace_processed_callback;
+
+static K_MUTEX_DEFINE(compression_mutex);
+
+static uint8_t block[BLOCK_SIZE];
+static size_t block_len;
+
+/* Compressed block, waiting to be written to the backend */
+static uint8_t out[TRACE_COMPRESSION_HDR_SIZE + BLOCK_SIZE];
+static size_t out_len;
+static size_t out_pos;
+
+static uint16_t hash_table[1 << HASH_BITS];
+
+/* Read from the system workqueue, which must not wait for a backend write */
+static struct k_spinlock stats_lock;
+static uint32_t raw_bytes_tot;
+static uint32_t compressed_bytes_tot;
+
+static inline uint32_t hash(uint32_t seq)
+{
+	return (seq * 2654435761U) >> (32 - HASH_BITS);
+}
+
+static inline uint32_t read32(const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static uint8_t *length_encode(uint8_t *op, size_t len)
+{
+	while (len >= 255) {
+		*op++ = 255;
+		len -= 255;
+	}
+	*op++ = len;
+
+	return op;
+}
+
+/* Worst case size of a sequence with the given literal and match lengths */
+static size_t sequence_size(size_t lit_len, size_t match_len)
+{
+	return 1 + lit_len / 255 + 1 + lit_len + 2 + match_len / 255 + 1;
+}
+
+static uint8_t *sequence_encode(uint8_t *op, const uint8_t *lit, size_t lit_len,
+				size_t offset, size_t match_len)
+{
+	uint8_t *token = op++;
+
+	*token = MIN(lit_len, LZ4_RUN_MASK) << 4;
+	if (lit_len >= LZ4_RUN_MASK) {
+		op = length_encode(op, lit_len - LZ4_RUN_MASK);
+	}
+
+	memcpy(op, lit, lit_len);
+	op += lit_len;
+
+	/* The last sequence has literals only */
+	if (offset == 0) {
+		return op;
+	}
+
+	sys_put_le16(offset, op);
+	op += 2;
+
+	match_len -= LZ4_MIN_MATCH;
+	*token |= MIN(match_len, LZ4_RUN_MASK);
+	if (match_len >= LZ4_RUN_MASK) {
+		op = length_encode(op, match_len - LZ4_RUN_MASK);
+	}
+
+	return op;
+}
+
+size_t trace_compression_lz4_encode(const uint8_t *src, size_t src_len, uint8_t *dst,
+				    size_t dst_size)
+{
+	uint8_t *op = dst;
+	uint8_t *const op_end = dst + dst_size;
+	size_t anchor = 0;
+	size_t ip = 0;
+
+	memset(hash_table, 0, sizeof(hash_table));
+
+	/* Greedy parse; matches must start LZ4_MF_LIMIT bytes before the end of the block
+	 * and leave the last LZ4_LAST_LITERALS bytes as literals.
+	 */
+	while (src_len > LZ4_MF_LIMIT && ip < src_len - LZ4_MF_LIMIT) {
+		uint32_t seq = read32(&src[ip]);
+		uint32_t h = hash(seq);
+		size_t ref = hash_table[h];
+		size_t match_len;
+
+		hash_table[h] = ip;
+
+		if (ref >= ip || ip - ref > LZ4_MAX_OFFSET || read32(&src[ref]) != seq) {
+			ip++;
+			continue;
+		}
+
+		match_len = LZ4_MIN_MATCH;
+		while (ip + match_len < src_len - LZ4_LAST_LITERALS &&
+		       src[ref + match_len] == src[ip + match_len]) {
+			match_len++;
+		}
+
+		if (sequence_size(ip - anchor, match_len) > op_end - op) {
+			return 0;
+		}
+
+		op = sequence_encode(op, &src[anchor], ip - anchor, ip - ref, match_len);
+		ip += match_len;
+		anchor = ip;
+	}
+
+	if (sequence_size(src_len - anchor, 0) > op_end - op) {
+		return 0;
+	}
+
+	op = sequence_encode(op, &src[anchor], src_len - anchor, 0, 0);
+
+	return op - dst;
+}
+
+static void block_compress(void)
+{
+	size_t len;
+	uint8_t type;
+	uint8_t *hdr = out;
+
+	/* Keep the block uncompressed unless compression saves space */
+	len = trace_compression_lz4_encode(block, block_len, &out[TRACE_COMPRESSION_HDR_SIZE],
+					   block_len - 1);
+	if (len) {
+		type = TRACE_COMPRESSION_BLOCK_LZ4;
+	} else {
+		type = TRACE_COMPRESSION_BLOCK_STORED;
+		memcpy(&out[TRACE_COMPRESSION_HDR_SIZE], block, block_len);
+		len = block_len;
+	}
+
+	hdr[0] = TRACE_COMPRESSION_MAGIC_0;
+	hdr[1] = TRACE_COMPRESSION_MAGIC_1;
+	hdr[2] = type;
+	sys_put_le16(block_len, &hdr[4]);
+	sys_put_le16(len, &hdr[6]);
+	hdr[3] = hdr[0] ^ hdr[1] ^ hdr[2] ^ hdr[4] ^ hdr[5] ^ hdr[6] ^ hdr[7];
+
+	out_len = TRACE_COMPRESSION_HDR_SIZE + len;
+	out_pos = 0;
+
+	K_SPINLOCK(&stats_lock) {
+		raw_bytes_tot += block_len;
+		compressed_bytes_tot += out_len;
+	}
+
+	LOG_DBG("Compressed %zu bytes to %zu", block_len, out_len);
+
+	block_len = 0;
+}
+
+/* Write the pending compressed block to the backend */
+static int out_drain(void)
+{
+	int ret;
+
+	while (out_pos < out_len) {
+		ret = trace_backend.write(&out[out_pos], out_len - out_pos);
+		if (ret < 0) {
+			return ret;
+		}
+
+		out_pos += ret;
+	}
+
+	out_len = 0;
+	out_pos = 0;
+
+	return 0;
+}
+
+/* Compress and write the partially filled block */
+static int block_flush(void)
+{
+	int err;
+
+	err = out_drain();
+	if (err) {
+		return err;
+	}
+
+	if (block_len == 0) {
+		return 0;
+	}
+
+	block_compress();
+
+	return out_drain();
+}
+
+/* The stage frees the trace data itself once it is copied into the block */
+static int backend_processed_cb(size_t len)
+{
+	return 0;
+}
+
+static int compression_init(trace_backend_processed_cb trace_processed_cb)
+{
+	if (trace_processed_cb == NULL) {
+		return -EFAULT;
+	}
+
+	trace_processed_callback = trace_processed_cb;
+
+	k_mutex_lock(&compression_mutex, K_FOREVER);
+	block_len = 0;
+	out_len = 0;
+	out_pos = 0;
+	k_mutex_unlock(&compression_mutex);
+
+	return trace_backend.init(backend_processed_cb);
+}
+
+static int compression_deinit(void)
+{
+	int err;
+
+	k_mutex_lock(&compression_mutex, K_FOREVER);
+	err = block_flush();
+	k_mutex_unlock(&compression_mutex);
+
+	if (err) {
+		LOG_WRN("Could not write the last trace block, err %d", err);
+	}
+
+	return trace_backend.deinit();
+}
+
+static int compression_write(const void *data, size_t len)
+{
+	int err;
+	size_t n;
+
+	k_mutex_lock(&compression_mutex, K_FOREVER);
+
+	/* Errors from writing the previous block are returned before any data is consumed,
+	 * so that the caller retries the same data once the backend has room again.
+	 */
+	err = out_drain();
+	if (err) {
+		k_mutex_unlock(&compression_mutex);
+		return err;
+	}
+
+	n = MIN(len, BLOCK_SIZE - block_len);
+	memcpy(&block[block_len], data, n);
+	block_len += n;
+
+	if (block_len == BLOCK_SIZE) {
+		block_compress();
+		/* On failure, retried on the next call */
+		(void)out_drain();
+	}
+
+	k_mutex_unlock(&compression_mutex);
+
+	err = trace_processed_callback(n);
+	if (err) {
+		LOG_ERR("Trace processed callback failed, err %d", err);
+		return err;
+	}
+
+	return n;
+}
+
+static size_t compression_data_size(void)
+{
+	if (!trace_backend.data_size) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&compression_mutex, K_FOREVER);
+	(void)block_flush();
+	k_mutex_unlock(&compression_mutex);
+
+	return trace_backend.data_size();
+}
+
+static int compression_read(void *buf, size_t len)
+{
+	if (!trace_backend.read) {
+		return -ENOTSUP;
+	}
+
+	k_mutex_lock(&compression_mutex, K_FOREVER);
+	(void)block_flush();
+	k_mutex_unlock(&compression_mutex);
+
+	return trace_backend.read(buf, len);
+}
+
+static int compression_peek_at(size_t offset, void *buf, size_t len)
+{
+	if (!trace_backend.peek_at) {
+		return -ENOTSUP;
+	}
+
+	return trace_backend.peek_at(offset, buf, len);
+}
+
+static int compression_clear(void)
+{
+	if (!trace_backend.clear) {
+		return -ENOTSUP;
+	}
+
+	return trace_backend.clear();
+}
+
+static int compression_suspend(void)
+{
+	int err;
+
+	/* Traces have stopped for a while, write what is buffered */
+	k_mutex_lock(&compression_mutex, K_FOREVER);
+	err = block_flush();
+	k_mutex_unlock(&compression_mutex);
+
+	if (err) {
+		LOG_DBG("Could not write the trace block, err %d", err);
+	}
+
+	if (!trace_backend.suspend) {
+		return 0;
+	}
+
+	return trace_backend.suspend();
+}
+
+static int compression_resume(void)
+{
+	if (!trace_backend.resume) {
+		return 0;
+	}
+
+	return trace_backend.resume();
+}
+
+void trace_compression_stats_get(uint32_t *raw_bytes, uint32_t *compressed_bytes)
+{
+	K_SPINLOCK(&stats_lock) {
+		*raw_bytes = raw_bytes_tot;
+		*compressed_bytes = compressed_bytes_tot;
+	}
+}
+
+struct nrf_modem_lib_trace_backend trace_backend_compression = {
+	.init = compression_init,
+	.deinit = compression_deinit,
+	.write = compression_write,
+	.data_size = compression_data_size,
+	.read = compression_read,
+	.peek_at = compression_peek_at,
+	.clear = compression_clear,
+	.suspend = compression_suspend,
+	.resume = compression_resume,
+};
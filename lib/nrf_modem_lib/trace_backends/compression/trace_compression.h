@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TRACE_COMPRESSION_H__
+#define TRACE_COMPRESSION_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Each block written to the trace backend starts with this header:
+ *
+ * | 'M' | 'T' | type | check | raw_len (le16) | len (le16) |
+ *
+ * followed by len bytes of block data, which decompress to raw_len bytes of trace data.
+ * The check byte is the XOR of the other seven header bytes, so that a reader can
+ * find the next block after a gap in the stored data.
+ */
+#define TRACE_COMPRESSION_HDR_SIZE 8
+#define TRACE_COMPRESSION_MAGIC_0 'M'
+#define TRACE_COMPRESSION_MAGIC_1 'T'
+
+enum trace_compression_block_type {
+	/* Block data is the raw trace data */
+	TRACE_COMPRESSION_BLOCK_STORED = 0,
+	/* Block data is an LZ4 block */
+	TRACE_COMPRESSION_BLOCK_LZ4 = 1,
+};
+
+/**
+ * @brief Compress @p src_len bytes in LZ4 block format.
+ *
+ * @return Number of bytes written to @p dst, or 0 if the compressed data does not fit
+ *         in @p dst_size bytes.
+ */
+size_t trace_compression_lz4_encode(const uint8_t *src, size_t src_len, uint8_t *dst,
+				    size_t dst_size);
+
+/**
+ * @brief Get the number of trace bytes compressed, and the number of bytes they were
+ *        compressed to, including block headers.
+ *
+ * Both counters wrap around; use the difference between two calls. Does not wait for
+ * the trace backend, and can be called from the system workqueue.
+ */
+void trace_compression_stats_get(uint32_t *raw_bytes, uint32_t *compressed_bytes);
+
+#endif /* TRACE_COMPRESSION_H__ */
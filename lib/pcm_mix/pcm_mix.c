@@ -8,6 +8,8 @@
 
 #include <zephyr/kernel.h>
 
+#include "pcm_mix_kernels.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pcm_mix, CONFIG_PCM_MIX_LOG_LEVEL);
 
@@ -27,15 +29,12 @@ static void hard_limiter(int32_t *const pcm)
 static void pcm_mix_identical(void *const pcm_a, size_t size_a, void const *const pcm_b,
 			      size_t size_b)
 {
-	int32_t res;
-
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i];
-
-		hard_limiter(&res);
+	struct pcm_mix_input const inputs[] = {
+		{.pcm = pcm_a, .size = size_b, .gain = PCM_MIX_GAIN_UNITY},
+		{.pcm = pcm_b, .size = size_b, .gain = PCM_MIX_GAIN_UNITY},
+	};
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
-	}
+	pcm_mix_kernel_s16(pcm_a, inputs, ARRAY_SIZE(inputs), size_b / 2);
 }
 
 /* Mix mono into both channels of a stereo buffer */
@@ -133,3 +132,45 @@ int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t si
 
 	return 0;
 }
+
+int pcm_mix_multi(void *const pcm_out, size_t size_out, struct pcm_mix_input const *const inputs,
+		  size_t num_inputs, uint8_t pcm_bit_depth)
+{
+	uint8_t bytes_per_sample = pcm_bit_depth / 8;
+
+	if (pcm_out == NULL || size_out == 0 || (inputs == NULL && num_inputs != 0)) {
+		return -EINVAL;
+	}
+
+	if (pcm_bit_depth != 16 && pcm_bit_depth != 24 && pcm_bit_depth != 32) {
+		LOG_ERR("Invalid bit depth: %d", pcm_bit_depth);
+		return -EINVAL;
+	}
+
+	if (size_out % bytes_per_sample != 0) {
+		LOG_ERR("Size: %zu is not a multiple of the sample size", size_out);
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < num_inputs; i++) {
+		if (inputs[i].pcm != NULL && inputs[i].size != size_out) {
+			LOG_ERR("Input %zu size %zu differs from output size %zu", i, inputs[i].size,
+				size_out);
+			return -EPERM;
+		}
+	}
+
+	switch (pcm_bit_depth) {
+	case 16:
+		pcm_mix_kernel_s16(pcm_out, inputs, num_inputs, size_out / bytes_per_sample);
+		break;
+	case 24:
+		pcm_mix_kernel_s24(pcm_out, inputs, num_inputs, size_out / bytes_per_sample);
+		break;
+	case 32:
+		pcm_mix_kernel_s32(pcm_out, inputs, num_inputs, size_out / bytes_per_sample);
+		break;
+	}
+
+	return 0;
+}
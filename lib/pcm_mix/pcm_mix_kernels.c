@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "pcm_mix_kernels.h"
+
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_PCM_MIX_DSP_INSTRUCTIONS) && defined(__ARM_FEATURE_DSP) &&                  \
+	(__ARM_FEATURE_DSP == 1)
+#include <cmsis_core.h>
+#define PCM_MIX_USE_DSP 1
+#endif
+
+/* Number of samples mixed from each input before moving on to the next input.
+ * The partial sums live on the stack, so the output can be written once per chunk
+ * even when it aliases one of the inputs.
+ */
+#define CHUNK_SAMPLES 32
+
+#define GAIN_SHIFT 14
+
+#define S24_MIN (-(1 << 23))
+#define S24_MAX ((1 << 23) - 1)
+
+static inline int32_t sat_s16(int32_t val)
+{
+#if defined(PCM_MIX_USE_DSP)
+	return __SSAT(val, 16);
+#else
+	return CLAMP(val, INT16_MIN, INT16_MAX);
+#endif
+}
+
+static inline int32_t sat_s24(int32_t val)
+{
+#if defined(PCM_MIX_USE_DSP)
+	return __SSAT(val, 24);
+#else
+	return CLAMP(val, S24_MIN, S24_MAX);
+#endif
+}
+
+static inline int32_t sat_s32(int64_t val)
+{
+	return (int32_t)CLAMP(val, INT32_MIN, INT32_MAX);
+}
+
+static inline int32_t s24_load(uint8_t const *p)
+{
+	/* Shift into the top of a 32-bit word and back down to sign extend */
+	return ((int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24)) >> 8;
+}
+
+static inline void s24_store(uint8_t *p, int32_t val)
+{
+	p[0] = (uint8_t)val;
+	p[1] = (uint8_t)(val >> 8);
+	p[2] = (uint8_t)(val >> 16);
+}
+
+/* Mix the samples from index start up to num_samples */
+static void kernel_s16_portable(int16_t *out, struct pcm_mix_input const *inputs,
+				size_t num_inputs, size_t start, size_t num_samples)
+{
+	int32_t acc[CHUNK_SAMPLES];
+
+	for (size_t base = start; base < num_samples; base += CHUNK_SAMPLES) {
+		size_t len = MIN(CHUNK_SAMPLES, num_samples - base);
+
+		memset(acc, 0, len * sizeof(acc[0]));
+
+		for (size_t k = 0; k < num_inputs; k++) {
+			int16_t const *in = inputs[k].pcm;
+			int32_t gain = inputs[k].gain;
+
+			if (in == NULL) {
+				continue;
+			}
+
+			in += base;
+
+			if (gain == PCM_MIX_GAIN_UNITY) {
+				for (size_t j = 0; j < len; j++) {
+					acc[j] = sat_s16(acc[j] + in[j]);
+				}
+			} else {
+				for (size_t j = 0; j < len; j++) {
+					acc[j] = sat_s16(acc[j] + sat_s16((in[j] * gain) >> GAIN_SHIFT));
+				}
+			}
+		}
+
+		for (size_t j = 0; j < len; j++) {
+			out[base + j] = (int16_t)acc[j];
+		}
+	}
+}
+
+#if defined(PCM_MIX_USE_DSP)
+static bool all_word_aligned(int16_t const *out, struct pcm_mix_input const *inputs,
+			     size_t num_inputs)
+{
+	if (!IS_PTR_ALIGNED(out, uint32_t)) {
+		return false;
+	}
+
+	for (size_t k = 0; k < num_inputs; k++) {
+		if (inputs[k].pcm != NULL && !IS_PTR_ALIGNED(inputs[k].pcm, uint32_t)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Two samples are mixed per instruction with QADD16, which saturates each half-word lane */
+static void kernel_s16_dsp(int16_t *out, struct pcm_mix_input const *inputs, size_t num_inputs,
+			   size_t num_words)
+{
+	uint32_t acc[CHUNK_SAMPLES / 2];
+	uint32_t *out_w = (uint32_t *)out;
+
+	for (size_t base = 0; base < num_words; base += ARRAY_SIZE(acc)) {
+		size_t len = MIN(ARRAY_SIZE(acc), num_words - base);
+
+		memset(acc, 0, len * sizeof(acc[0]));
+
+		for (size_t k = 0; k < num_inputs; k++) {
+			uint32_t const *in = inputs[k].pcm;
+			int32_t gain = inputs[k].gain;
+
+			if (in == NULL) {
+				continue;
+			}
+
+			in += base;
+
+			if (gain == PCM_MIX_GAIN_UNITY) {
+				for (size_t j = 0; j < len; j++) {
+					acc[j] = __QADD16(acc[j], in[j]);
+				}
+			} else {
+				for (size_t j = 0; j < len; j++) {
+					int32_t lo = __SSAT(((int16_t)in[j] * gain) >> GAIN_SHIFT, 16);
+					int32_t hi = __SSAT(((int16_t)(in[j] >> 16) * gain) >> GAIN_SHIFT,
+							    16);
+
+					acc[j] = __QADD16(acc[j], __PKHBT(lo, hi, 16));
+				}
+			}
+		}
+
+		memcpy(&out_w[base], acc, len * sizeof(acc[0]));
+	}
+}
+#endif /* PCM_MIX_USE_DSP */
+
+void pcm_mix_kernel_s16(int16_t *out, struct pcm_mix_input const *inputs, size_t num_inputs,
+			size_t num_samples)
+{
+#if defined(PCM_MIX_USE_DSP)
+	if (all_word_aligned(out, inputs, num_inputs)) {
+		size_t num_words = num_samples / 2;
+
+		kernel_s16_dsp(out, inputs, num_inputs, num_words);
+
+		/* Mix the odd sample that is left over, if any */
+		kernel_s16_portable(out, inputs, num_inputs, num_words * 2, num_samples);
+		return;
+	}
+#endif /* PCM_MIX_USE_DSP */
+
+	kernel_s16_portable(out, inputs, num_inputs, 0, num_samples);
+}
+
+void pcm_mix_kernel_s24(uint8_t *out, struct pcm_mix_input const *inputs, size_t num_inputs,
+			size_t num_samples)
+{
+	int32_t acc[CHUNK_SAMPLES];
+
+	for (size_t base = 0; base < num_samples; base += CHUNK_SAMPLES) {
+		size_t len = MIN(CHUNK_SAMPLES, num_samples - base);
+
+		memset(acc, 0, len * sizeof(acc[0]));
+
+		for (size_t k = 0; k < num_inputs; k++) {
+			uint8_t const *in = inputs[k].pcm;
+			int64_t gain = inputs[k].gain;
+
+			if (in == NULL) {
+				continue;
+			}
+
+			in += base * 3;
+
+			if (gain == PCM_MIX_GAIN_UNITY) {
+				for (size_t j = 0; j < len; j++) {
+					acc[j] = sat_s24(acc[j] + s24_load(&in[j * 3]));
+				}
+			} else {
+				for (size_t j = 0; j < len; j++) {
+					int64_t scaled = (s24_load(&in[j * 3]) * gain) >> GAIN_SHIFT;
+
+					acc[j] = sat_s24(acc[j] + CLAMP(scaled, S24_MIN, S24_MAX));
+				}
+			}
+		}
+
+		for (size_t j = 0; j < len; j++) {
+			s24_store(&out[(base + j) * 3], acc[j]);
+		}
+	}
+}
+
+void pcm_mix_kernel_s32(int32_t *out, struct pcm_mix_input const *inputs, size_t num_inputs,
+			size_t num_samples)
+{
+	int32_t acc[CHUNK_SAMPLES];
+
+	for (size_t base = 0; base < num_samples; base += CHUNK_SAMPLES) {
+		size_t len = MIN(CHUNK_SAMPLES, num_samples - base);
+
+		memset(acc, 0, len * sizeof(acc[0]));
+
+		for (size_t k = 0; k < num_inputs; k++) {
+			int32_t const *in = inputs[k].pcm;
+			int64_t gain = inputs[k].gain;
+
+			if (in == NULL) {
+				continue;
+			}
+
+			in += base;
+
+			if (gain == PCM_MIX_GAIN_UNITY) {
+				for (size_t j = 0; j < len; j++) {
+#if defined(PCM_MIX_USE_DSP)
+					acc[j] = __QADD(acc[j], in[j]);
+#else
+					acc[j] = sat_s32((int64_t)acc[j] + in[j]);
+#endif
+				}
+			} else {
+				for (size_t j = 0; j < len; j++) {
+					int64_t scaled = (in[j] * gain) >> GAIN_SHIFT;
+
+					acc[j] = sat_s32((int64_t)acc[j] + sat_s32(scaled));
+				}
+			}
+		}
+
+		memcpy(&out[base], acc, len * sizeof(acc[0]));
+	}
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _PCM_MIX_KERNELS_H_
+#define _PCM_MIX_KERNELS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pcm_mix.h>
+
+/**
+ * @brief Mix signed 16-bit inputs into out with saturation after each input.
+ *
+ * @param out          Output buffer, may alias any of the inputs.
+ * @param inputs       Inputs to mix. Inputs with a NULL pointer are skipped.
+ * @param num_inputs   Number of inputs.
+ * @param num_samples  Number of samples to mix from each input.
+ */
+void pcm_mix_kernel_s16(int16_t *out, struct pcm_mix_input const *inputs, size_t num_inputs,
+			size_t num_samples);
+
+/**
+ * @brief Mix signed, packed 24-bit inputs into out with saturation after each input.
+ *
+ * @param out          Output buffer, may alias any of the inputs.
+ * @param inputs       Inputs to mix. Inputs with a NULL pointer are skipped.
+ * @param num_inputs   Number of inputs.
+ * @param num_samples  Number of samples to mix from each input.
+ */
+void pcm_mix_kernel_s24(uint8_t *out, struct pcm_mix_input const *inputs, size_t num_inputs,
+			size_t num_samples);
+
+/**
+ * @brief Mix signed 32-bit inputs into out with saturation after each input.
+ *
+ * @param out          Output buffer, may alias any of the inputs.
+ * @param inputs       Inputs to mix. Inputs with a NULL pointer are skipped.
+ * @param num_inputs   Number of inputs.
+ * @param num_samples  Number of samples to mix from each input.
+ */
+void pcm_mix_kernel_s32(int32_t *out, struct pcm_mix_input const *inputs, size_t num_inputs,
+			size_t num_samples);
+
+#endif /* _PCM_MIX_KERNELS_H_ */
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "sample_rate_converter.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(sample_rate_converter_polyphase, CONFIG_SAMPLE_RATE_CONVERTER_LOG_LEVEL);
+
+#define TAPS   CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS
+#define PHASES CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES
+
+BUILD_ASSERT((TAPS % 2) == 0, "Number of taps must be even");
+
+/* Coefficients are stored in Q30 to leave headroom for the filter overshoot */
+#define COEFF_FRAC_BITS 30
+
+/* Weight between two neighbouring phases is applied in Q15 */
+#define WEIGHT_FRAC_BITS 15
+
+/* Largest supported ratio between the input and output sample rate, in either direction */
+#define RATIO_MAX 8
+
+/* Place the cut-off slightly below the Nyquist frequency to leave room for the transition band */
+#define CUTOFF_FACTOR 0.9f
+
+#define PI_F 3.14159265358979f
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+#define SAMPLE_MIN INT16_MIN
+#define SAMPLE_MAX INT16_MAX
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+#define SAMPLE_MIN INT32_MIN
+#define SAMPLE_MAX INT32_MAX
+#endif
+
+static float sinc(float x)
+{
+	if (fabsf(x) < 1e-6f) {
+		return 1.0f;
+	}
+
+	return sinf(PI_F * x) / (PI_F * x);
+}
+
+static float blackman(float t)
+{
+	/* Window spans the full filter length, centred on t = 0 */
+	float x = t / TAPS;
+
+	if (fabsf(x) > 0.5f) {
+		return 0.0f;
+	}
+
+	return 0.42f + 0.5f * cosf(2.0f * PI_F * x) + 0.08f * cosf(4.0f * PI_F * x);
+}
+
+/**
+ * @brief Design the polyphase filter bank.
+ *
+ * @details Row p of the filter bank holds a windowed-sinc low-pass filter sampled at an offset of
+ *	    p / PHASES input samples. The output for a fractional position between two rows is
+ *	    found by interpolating the coefficients of the two rows. Every row is normalised to
+ *	    unity gain at DC.
+ */
+static void filter_bank_design(struct sample_rate_converter_polyphase_ctx *ctx)
+{
+	float cutoff = CUTOFF_FACTOR;
+
+	if (ctx->sample_rate_output < ctx->sample_rate_input) {
+		cutoff *= (float)ctx->sample_rate_output / (float)ctx->sample_rate_input;
+	}
+
+	for (int p = 0; p <= PHASES; p++) {
+		float row[TAPS];
+		float sum = 0.0f;
+
+		for (int k = 0; k < TAPS; k++) {
+			float t = (float)(k - (TAPS / 2 - 1)) - (float)p / PHASES;
+
+			row[k] = cutoff * sinc(cutoff * t) * blackman(t);
+			sum += row[k];
+		}
+
+		for (int k = 0; k < TAPS; k++) {
+			ctx->coeffs[p][k] = (int32_t)lroundf(row[k] / sum * (1 << COEFF_FRAC_BITS));
+		}
+	}
+}
+
+static void drift_step_update(struct sample_rate_converter_polyphase_ctx *ctx)
+{
+	ctx->drift_step = ((int64_t)ctx->step * ctx->drift_ppb) / 1000000000LL;
+}
+
+int sample_rate_converter_polyphase_open(struct sample_rate_converter_polyphase_ctx *ctx,
+					 uint32_t sample_rate_input, uint32_t sample_rate_output)
+{
+	uint64_t ratio;
+
+	if (ctx == NULL) {
+		LOG_ERR("Context cannot be NULL");
+		return -EINVAL;
+	}
+
+	if ((sample_rate_input == 0) || (sample_rate_output == 0) ||
+	    ((uint64_t)sample_rate_input > (uint64_t)sample_rate_output * RATIO_MAX) ||
+	    ((uint64_t)sample_rate_output > (uint64_t)sample_rate_input * RATIO_MAX)) {
+		LOG_ERR("Unsupported sample rates: %d -> %d", sample_rate_input,
+			sample_rate_output);
+		return -EINVAL;
+	}
+
+	memset(ctx, 0, sizeof(struct sample_rate_converter_polyphase_ctx));
+
+	ctx->sample_rate_input = sample_rate_input;
+	ctx->sample_rate_output = sample_rate_output;
+
+	ratio = (uint64_t)sample_rate_input << 32;
+	ctx->step = ratio / sample_rate_output;
+	ctx->step_remainder = ratio % sample_rate_output;
+
+	/* Prefill the history so that the first output sample is aligned with the first input
+	 * sample.
+	 */
+	ctx->history_len = TAPS / 2 - 1;
+
+	filter_bank_design(ctx);
+
+	LOG_DBG("Polyphase converter opened. Input sample rate: %d, Output sample rate: %d",
+		sample_rate_input, sample_rate_output);
+
+	return 0;
+}
+
+int sample_rate_converter_polyphase_drift_set(struct sample_rate_converter_polyphase_ctx *ctx,
+					      int32_t drift_ppb)
+{
+	if (ctx == NULL) {
+		LOG_ERR("Context cannot be NULL");
+		return -EINVAL;
+	}
+
+	if ((drift_ppb > SAMPLE_RATE_CONVERTER_POLYPHASE_DRIFT_MAX_PPB) ||
+	    (drift_ppb < -SAMPLE_RATE_CONVERTER_POLYPHASE_DRIFT_MAX_PPB)) {
+		LOG_ERR("Drift correction %d ppb out of range", drift_ppb);
+		return -EINVAL;
+	}
+
+	ctx->drift_ppb = drift_ppb;
+	drift_step_update(ctx);
+
+	return 0;
+}
+
+static inline sample_rate_converter_sample_t
+filter_sample(struct sample_rate_converter_polyphase_ctx *ctx, size_t index, uint32_t frac)
+{
+	uint64_t phase_pos = (uint64_t)frac * PHASES;
+	uint32_t phase = phase_pos >> 32;
+	int32_t weight = (uint32_t)phase_pos >> (32 - WEIGHT_FRAC_BITS);
+	int32_t const *c0 = ctx->coeffs[phase];
+	int32_t const *c1 = ctx->coeffs[phase + 1];
+	sample_rate_converter_sample_t const *x = &ctx->history[index];
+	int64_t acc = 0;
+
+	for (int k = 0; k < TAPS; k++) {
+		int32_t c = c0[k] + (int32_t)(((int64_t)(c1[k] - c0[k]) * weight) >>
+					      WEIGHT_FRAC_BITS);
+
+		acc += (int64_t)x[k] * c;
+	}
+
+	acc = (acc + (1LL << (COEFF_FRAC_BITS - 1))) >> COEFF_FRAC_BITS;
+
+	return (sample_rate_converter_sample_t)CLAMP(acc, SAMPLE_MIN, SAMPLE_MAX);
+}
+
+static inline void position_advance(struct sample_rate_converter_polyphase_ctx *ctx)
+{
+	ctx->position += ctx->step + ctx->drift_step;
+
+	/* Carry the remainder of the nominal ratio so that the long-term ratio is exact */
+	ctx->step_error += ctx->step_remainder;
+	if (ctx->step_error >= ctx->sample_rate_output) {
+		ctx->step_error -= ctx->sample_rate_output;
+		ctx->position++;
+	}
+}
+
+int sample_rate_converter_polyphase_process(struct sample_rate_converter_polyphase_ctx *ctx,
+					    void const *const input, size_t input_size,
+					    void *const output, size_t output_size,
+					    size_t *output_written)
+{
+	size_t bytes_per_sample = sizeof(sample_rate_converter_sample_t);
+	sample_rate_converter_sample_t *out = output;
+	size_t samples_out_max;
+	size_t samples_in;
+	size_t samples_written = 0;
+	size_t consumed;
+
+	if ((ctx == NULL) || (input == NULL && input_size != 0) || (output == NULL) ||
+	    (output_written == NULL)) {
+		LOG_ERR("Null pointer received");
+		return -EINVAL;
+	}
+
+	if (ctx->sample_rate_output == 0) {
+		LOG_ERR("Context has not been opened");
+		return -EINVAL;
+	}
+
+	if (input_size % bytes_per_sample != 0) {
+		LOG_ERR("Size of input is not a byte multiple");
+		return -EINVAL;
+	}
+
+	samples_in = input_size / bytes_per_sample;
+	samples_out_max = output_size / bytes_per_sample;
+
+	if (samples_in > ARRAY_SIZE(ctx->history) - ctx->history_len) {
+		LOG_ERR("Not enough space in history for %zu samples", samples_in);
+		return -ENOMEM;
+	}
+
+	memcpy(&ctx->history[ctx->history_len], input, input_size);
+	ctx->history_len += samples_in;
+
+	while (samples_written < samples_out_max) {
+		size_t index = ctx->position >> 32;
+
+		if (index + TAPS > ctx->history_len) {
+			break;
+		}
+
+		out[samples_written++] = filter_sample(ctx, index, (uint32_t)ctx->position);
+		position_advance(ctx);
+	}
+
+	/* Drop the samples that no later output sample depends on */
+	consumed = MIN(ctx->position >> 32, ctx->history_len);
+	ctx->history_len -= consumed;
+	memmove(ctx->history, &ctx->history[consumed], ctx->history_len * bytes_per_sample);
+	ctx->position -= (uint64_t)consumed << 32;
+
+	*output_written = samples_written * bytes_per_sample;
+
+	return 0;
+}
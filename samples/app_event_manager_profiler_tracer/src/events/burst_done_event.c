@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <stdio.h>
+#include "burst_done_event.h"
+
+
+static void profile_burst_done_event(struct log_event_buf *buf,
+				  const struct app_event_header *aeh)
+{
+}
+
+APP_EVENT_INFO_DEFINE(burst_done_event,
+		  ENCODE(),
+		  ENCODE(),
+		  profile_burst_done_event);
+
+APP_EVENT_TYPE_DEFINE(burst_done_event,
+		  NULL,
+		  &burst_done_event_info,
+		  APP_EVENT_FLAGS_CREATE(APP_EVENT_TYPE_FLAGS_INIT_LOG_ENABLE));
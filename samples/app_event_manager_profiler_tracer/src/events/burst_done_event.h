@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _BURST_DONE_EVENT_H_
+#define _BURST_DONE_EVENT_H_
+
+/**
+ * @brief Burst done event
+ * @defgroup burst_done_event Burst done event
+ * @{
+ */
+
+#include <app_event_manager.h>
+#include <app_event_manager_profiler_tracer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct burst_done_event {
+	struct app_event_header header;
+};
+
+APP_EVENT_TYPE_DECLARE(burst_done_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _BURST_DONE_EVENT_H_ */
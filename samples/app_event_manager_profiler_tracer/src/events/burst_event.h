@@ -20,6 +20,9 @@
 extern "C" {
 #endif
 
+/* Number of burst events sent in one burst */
+#define BURST_EVENT_NUMBER 50
+
 struct burst_event {
 	struct app_event_header header;
 };
@@ -15,7 +15,6 @@
 #define MODULE_A_THREAD_PRIORITY 1
 #define MODULE_A_THREAD_SLEEP_MS 1000
 #define MODULE_A_WORK_SIMULATE_CALCULATION_US 100000
-#define MODULE_A_BURST_EVENT_NUMBER 50
 #define MODULE_A_BURST_INTERVAL_US 2000
 #define MODULE module_a
 
@@ -74,7 +73,7 @@ static bool app_event_handler(const struct app_event_header *aeh)
 
 	if (is_five_sec_event(aeh)) {
 		atomic_clear(&cnt);
-		send_event_burst(MODULE_A_BURST_EVENT_NUMBER);
+		send_event_burst(BURST_EVENT_NUMBER);
 		k_busy_wait(MODULE_A_WORK_SIMULATE_CALCULATION_US);
 		return false;
 	}
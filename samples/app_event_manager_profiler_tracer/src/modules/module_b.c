@@ -8,9 +8,25 @@
 
 #include "five_sec_event.h"
 #include "one_sec_event.h"
+#include "burst_event.h"
+#include "burst_done_event.h"
 
 #define MODULE module_b
 
+static size_t burst_cnt;
+
+
+static void burst_received(size_t cnt)
+{
+	burst_cnt += cnt;
+
+	if (burst_cnt >= BURST_EVENT_NUMBER) {
+		struct burst_done_event *event = new_burst_done_event();
+
+		burst_cnt = 0;
+		APP_EVENT_SUBMIT(event);
+	}
+}
 
 static bool app_event_handler(const struct app_event_header *aeh)
 {
@@ -26,11 +42,25 @@ static bool app_event_handler(const struct app_event_header *aeh)
 		return false;
 	}
 
+	if (is_burst_event(aeh)) {
+		burst_received(1);
+		return false;
+	}
+
 	/* If event is unhandled, unsubscribe. */
 	__ASSERT_NO_MSG(false);
 
 	return false;
 }
 
-APP_EVENT_LISTENER(MODULE, app_event_handler);
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH)
+/* Used instead of app_event_handler for burst events */
+static void app_event_batch_handler(const struct app_event_header *const *aehs, size_t cnt)
+{
+	burst_received(cnt);
+}
+#endif
+
+APP_EVENT_LISTENER_BATCH(MODULE, app_event_handler, app_event_batch_handler);
 APP_EVENT_SUBSCRIBE(MODULE, one_sec_event);
+APP_EVENT_SUBSCRIBE(MODULE, burst_event);
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""
+Resolve the output of the ``cpu_sampler folded`` shell command to function names.
+
+The script reads lines in the folded stack format, in which the program counters are
+hexadecimal addresses, and prints the samples aggregated per thread and function.
+The output can be passed directly to flame graph tools, for example ``flamegraph.pl``.
+"""
+
+import argparse
+import bisect
+import re
+import sys
+from collections import Counter
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+LINE_RE = re.compile(r'^(?P<thread>.+?)(?:;0x(?P<pc>[0-9a-fA-F]+))? (?P<count>\d+)\s*$')
+
+
+class Symbols:
+    def __init__(self, elf_path):
+        funcs = []
+
+        with open(elf_path, 'rb') as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym['st_info']['type'] == 'STT_FUNC' and sym['st_size'] > 0:
+                        # Clear the Thumb bit of Arm function addresses.
+                        funcs.append((sym['st_value'] & ~1, sym['st_size'], sym.name))
+
+        funcs.sort()
+        self.addrs = [f[0] for f in funcs]
+        self.funcs = funcs
+
+    def resolve(self, pc):
+        i = bisect.bisect_right(self.addrs, pc) - 1
+        if i >= 0:
+            addr, size, name = self.funcs[i]
+            if pc < addr + size:
+                return name
+        return f'0x{pc:x}'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Resolve CPU usage sampler output to function names.',
+                                     allow_abbrev=False)
+    parser.add_argument('elf', help='ELF file of the application (zephyr.elf)')
+    parser.add_argument('input', nargs='?', type=argparse.FileType('r'), default=sys.stdin,
+                        help='File with the output of the "cpu_sampler folded" command '
+                             '(default: standard input)')
+    args = parser.parse_args()
+
+    symbols = Symbols(args.elf)
+    stacks = Counter()
+
+    for line in args.input:
+        match = LINE_RE.match(line.strip())
+        if not match:
+            continue
+
+        stack = match['thread'].replace(' ', '_')
+        if match['pc']:
+            stack += ';' + symbols.resolve(int(match['pc'], 16))
+
+        stacks[stack] += int(match['count'])
+
+    for stack, count in stacks.most_common():
+        print(f'{stack} {count}')
+
+
+if __name__ == '__main__':
+    main()
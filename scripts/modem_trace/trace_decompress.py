@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""
+Reconstruct the modem trace stream written with CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION.
+
+The input is the data read from the trace backend, for example with
+nrf_modem_lib_trace_read() or from the RTT or UART trace channel.
+It is a sequence of blocks, each one starting with an 8-byte header:
+
+    'M' 'T' type check raw_len(le16) len(le16)
+
+followed by len bytes of block data: the raw trace data (type 0) or an LZ4 block (type 1).
+Data that is not a valid block, for example where the oldest flash sectors were erased,
+is skipped until the next block header.
+The output is the original trace stream, which can be passed to the trace tools.
+"""
+
+import argparse
+import struct
+import sys
+
+HDR = struct.Struct('<2sBBHH')
+MAGIC = b'MT'
+TYPE_STORED = 0
+TYPE_LZ4 = 1
+
+
+def lz4_block_decode(src: bytes, raw_len: int) -> bytes:
+    """Decode one LZ4 block of raw_len bytes."""
+    out = bytearray()
+    pos = 0
+
+    def length(nibble):
+        nonlocal pos
+        if nibble == 15:
+            while True:
+                b = src[pos]
+                pos += 1
+                nibble += b
+                if b != 255:
+                    break
+        return nibble
+
+    while True:
+        token = src[pos]
+        pos += 1
+        lit_len = length(token >> 4)
+        out += src[pos:pos + lit_len]
+        pos += lit_len
+        if pos >= len(src):
+            break
+
+        offset = src[pos] | (src[pos + 1] << 8)
+        pos += 2
+        if offset == 0 or offset > len(out):
+            raise ValueError('Invalid match offset')
+
+        match_len = length(token & 0x0f) + 4
+        start = len(out) - offset
+        # Matches can overlap the data they produce
+        for i in range(match_len):
+            out.append(out[start + i])
+
+    if len(out) != raw_len:
+        raise ValueError('Invalid block length')
+
+    return bytes(out)
+
+
+def header_valid(hdr: bytes) -> bool:
+    check = 0
+    for i, b in enumerate(hdr):
+        if i != 3:
+            check ^= b
+    return hdr[:2] == MAGIC and hdr[2] in (TYPE_STORED, TYPE_LZ4) and check == hdr[3]
+
+
+def decompress(data: bytes):
+    """Return the trace stream and the number of bytes skipped."""
+    out = bytearray()
+    skipped = 0
+    pos = 0
+
+    while pos + HDR.size <= len(data):
+        hdr = data[pos:pos + HDR.size]
+        if header_valid(hdr):
+            _, block_type, _, raw_len, block_len = HDR.unpack(hdr)
+            block = data[pos + HDR.size:pos + HDR.size + block_len]
+            if len(block) == block_len:
+                try:
+                    if block_type == TYPE_LZ4:
+                        out += lz4_block_decode(block, raw_len)
+                    elif block_len == raw_len:
+                        out += block
+                    else:
+                        raise ValueError('Invalid block length')
+                    pos += HDR.size + block_len
+                    continue
+                except (ValueError, IndexError):
+                    pass
+
+        # Resynchronize on the next block header
+        pos += 1
+        skipped += 1
+
+    skipped += len(data) - pos
+
+    return bytes(out), skipped
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0].strip(),
+                                     allow_abbrev=False)
+    parser.add_argument('input', type=argparse.FileType('rb'),
+                        help='Compressed trace data read from the trace backend')
+    parser.add_argument('output', type=argparse.FileType('wb'),
+                        help='File to write the modem trace stream to')
+    args = parser.parse_args()
+
+    data = args.input.read()
+    trace, skipped = decompress(data)
+    args.output.write(trace)
+
+    print(f'{len(data)} bytes decompressed to {len(trace)} bytes', file=sys.stderr)
+    if skipped:
+        print(f'{skipped} bytes skipped, not part of a valid block', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,106 @@
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+import logging
+import struct
+import sys
+
+from stream import Stream, StreamError
+
+
+class Dump2Stream:
+    INFO_PREFIX = 'nrf_profiler_info:'
+    DATA_PREFIX = 'nrf_profiler_data:'
+    DROPPED_PREFIX = 'nrf_profiler_dropped:'
+    INFO_START_TAG = '<ev_info_start>'
+    # Record header: arguments length, CPU ID, event type ID and timestamp, little-endian.
+    RECORD_HDR = struct.Struct('<HBBI')
+
+    def __init__(self, out_stream, event_close, dump_filename, log_lvl=logging.INFO):
+        self.out_stream = out_stream
+        self.event_close = event_close
+        self.dump_filename = dump_filename
+
+        self.logger = logging.getLogger('dump2stream')
+        self.logger_console = logging.StreamHandler()
+        self.logger.setLevel(log_lvl)
+        self.log_format = logging.Formatter('[%(levelname)s] %(name)s: %(message)s')
+        self.logger_console.setFormatter(self.log_format)
+        self.logger.addHandler(self.logger_console)
+
+    @staticmethod
+    def _line_value(line, prefix):
+        idx = line.find(prefix)
+        if idx == -1:
+            return None
+        return line[idx + len(prefix):].rstrip('\r\n')
+
+    @staticmethod
+    def _record_to_event(record):
+        # Converts a ring buffer record to the layout of the data sent by the Nordic backend:
+        # event type ID, timestamp and arguments.
+        if len(record) < Dump2Stream.RECORD_HDR.size:
+            raise ValueError("record shorter than its header")
+
+        args_len, _, type_id, timestamp = Dump2Stream.RECORD_HDR.unpack_from(record)
+        args = record[Dump2Stream.RECORD_HDR.size:]
+        if len(args) != args_len:
+            raise ValueError("record length does not match its header")
+
+        return struct.pack('<BI', type_id, timestamp) + args
+
+    def _parse_dump(self):
+        # Event descriptions are printed again when new event types are registered.
+        # Event types are never removed, so the last printed descriptions are used.
+        info_lines = []
+        data = bytearray()
+
+        try:
+            with open(self.dump_filename, encoding='utf-8', errors='replace') as f:
+                for line in f:
+                    value = self._line_value(line, Dump2Stream.INFO_PREFIX)
+                    if value is not None:
+                        if value == Dump2Stream.INFO_START_TAG:
+                            info_lines = []
+                        info_lines.append(value)
+                        continue
+
+                    value = self._line_value(line, Dump2Stream.DATA_PREFIX)
+                    if value is not None:
+                        try:
+                            data.extend(self._record_to_event(bytes.fromhex(value)))
+                        except ValueError:
+                            self.logger.error(f"Malformed record skipped: {value}")
+                        continue
+
+                    value = self._line_value(line, Dump2Stream.DROPPED_PREFIX)
+                    if value is not None:
+                        cpu, cnt = value.split(',')
+                        self.logger.warning(f"{cnt} events dropped on CPU {cpu}")
+        except OSError as err:
+            self.logger.error(f"Cannot read dump file: {err}")
+            sys.exit()
+
+        if len(info_lines) == 0:
+            self.logger.error("No event descriptions found in the dump")
+            sys.exit()
+
+        # Empty line ends the descriptions, as in the RTT info channel.
+        desc = '\n'.join(info_lines) + '\n\n'
+
+        return desc.encode(), data
+
+    def read_and_transmit_data(self):
+        desc_buf, data = self._parse_dump()
+
+        try:
+            self.out_stream.send_desc(desc_buf)
+            for pos in range(0, len(data), Stream.RECV_BUF_SIZE):
+                self.out_stream.send_ev(data[pos:pos + Stream.RECV_BUF_SIZE])
+        except StreamError as err:
+            self.logger.error(f"Error: {err}. Unable to send data")
+            sys.exit()
+
+        self.logger.info(f"Sent {len(data)} bytes of events data")
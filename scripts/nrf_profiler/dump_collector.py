@@ -0,0 +1,90 @@
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+import argparse
+import logging
+import signal
+from multiprocessing import Event, Process
+
+from dump2stream import Dump2Stream
+from model_creator import ModelCreator
+from stream import Stream
+
+
+def dump2stream(stream, event, event_done, event_close, dump_filename, log_lvl_number):
+    signal.signal(signal.SIGINT, signal.SIG_IGN)
+    try:
+        d2s = Dump2Stream(stream, event_close, dump_filename, log_lvl=log_lvl_number)
+        event.wait()
+        d2s.read_and_transmit_data()
+    except Exception as e:
+        print(f"[ERROR] Unhandled exception in Profiler dump to stream module: {e}")
+    event_done.set()
+    # Keep the sending end of the stream open until all the data is received.
+    event_close.wait()
+
+def model_creator(stream, event, event_close, dataset_name, log_lvl_number):
+    signal.signal(signal.SIGINT, signal.SIG_IGN)
+    try:
+        mc = ModelCreator(stream,
+                          event_close,
+                          sending_events=False,
+                          event_filename=dataset_name + ".csv",
+                          event_types_filename=dataset_name + ".json",
+                          log_lvl=log_lvl_number)
+        event.set()
+        mc.start()
+    except Exception as e:
+        print(f"[ERROR] Unhandled exception in Profiler model creator module: {e}")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Decoding console output of the ring buffer nrf_profiler backend and saving '
+                    'it to files.',
+        allow_abbrev=False)
+    parser.add_argument('dump_file', help='Console output captured from the device')
+    parser.add_argument('dataset_name', help='Name of dataset')
+    parser.add_argument('--log', help='Log level')
+    args = parser.parse_args()
+
+    if args.log is not None:
+        log_lvl_number = int(getattr(logging, args.log.upper(), None))
+    else:
+        log_lvl_number = logging.INFO
+
+    # Event is made to ensure that ModelCreator class is initialized before Dump2Stream starts
+    # sending data.
+    event = Event()
+    event_done = Event()
+    # Setting these events results in closing corresponding modules.
+    event_close_dump2stream = Event()
+    event_close_model_creator = Event()
+
+    streams = Stream.create_stream(2)
+
+    p_dump2stream = Process(target=dump2stream,
+                            args=(streams[0], event, event_done, event_close_dump2stream,
+                                  args.dump_file, log_lvl_number),
+                            daemon=True)
+    p_model_creator = Process(target=model_creator,
+                              args=(streams[1], event, event_close_model_creator,
+                                    args.dataset_name, log_lvl_number),
+                              daemon=True)
+
+    p_dump2stream.start()
+    p_model_creator.start()
+
+    event_done.wait()
+
+    # ModelCreator closes after it has received all the data.
+    event_close_model_creator.set()
+    p_model_creator.join()
+
+    event_close_dump2stream.set()
+    p_dump2stream.join()
+
+if __name__ == "__main__":
+    main()
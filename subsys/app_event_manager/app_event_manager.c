@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/slist.h>
@@ -19,10 +20,295 @@ static void event_processor_fn(struct k_work *work);
 
 struct app_event_manager_event_display_bm _app_event_manager_event_display_bm;
 
-static K_WORK_DEFINE(event_processor, event_processor_fn);
-static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
+struct event_queue {
+	sys_slist_t events;
+	struct k_work work;
+	struct k_work_q *workq;
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+	struct app_event_manager_queue_stats stats;
+#endif
+};
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUES)
+static K_THREAD_STACK_ARRAY_DEFINE(queue_stacks, APP_EVENT_QUEUE_CNT - 1,
+				   CONFIG_APP_EVENT_MANAGER_QUEUE_STACK_SIZE);
+static struct k_work_q queue_workqs[APP_EVENT_QUEUE_CNT - 1];
+#endif
+
+/* Queue 0 is processed by the system workqueue, other queues by dedicated workqueues.
+ * Work submitted to a dedicated workqueue before it is started is rejected, so such queues
+ * are kicked off by app_event_manager_init.
+ */
+#define EVENT_QUEUE_INIT(i, _)								\
+	{										\
+		.events = SYS_SLIST_STATIC_INIT(&queues[i].events),			\
+		.work = Z_WORK_INITIALIZER(event_processor_fn),				\
+		.workq = COND_CODE_0(i, (&k_sys_work_q), (&queue_workqs[i - 1])),	\
+	}
+
+static struct event_queue queues[APP_EVENT_QUEUE_CNT] = {
+	LISTIFY(APP_EVENT_QUEUE_CNT, EVENT_QUEUE_INIT, (,))
+};
 static struct k_spinlock lock;
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUES)
+/* Index of the queue processing an event type. */
+static uint8_t queue_lut[CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT];
+
+static struct event_queue *event_queue_get(const struct event_type *et)
+{
+	return &queues[queue_lut[et - _event_type_list_start]];
+}
+
+static void event_queues_init(void)
+{
+	static const char * const names[] = {
+		"aem_q1", "aem_q2", "aem_q3", "aem_q4", "aem_q5", "aem_q6", "aem_q7"
+	};
+
+	BUILD_ASSERT(ARRAY_SIZE(names) >= ARRAY_SIZE(queue_workqs));
+
+	STRUCT_SECTION_FOREACH(event_queue_assignment, qa) {
+		queue_lut[qa->type - _event_type_list_start] = qa->queue;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(queue_workqs); i++) {
+		struct k_work_queue_config cfg = {
+			.name = names[i],
+		};
+
+		k_work_queue_start(&queue_workqs[i], queue_stacks[i],
+				   K_THREAD_STACK_SIZEOF(queue_stacks[i]),
+				   CONFIG_APP_EVENT_MANAGER_QUEUE_THREAD_PRIO - i, &cfg);
+	}
+}
+
+/* Let a higher priority queue run if the queue threads are cooperative. */
+static void event_queue_yield(const struct event_queue *q)
+{
+	for (const struct event_queue *hq = q + 1; hq < &queues[ARRAY_SIZE(queues)]; hq++) {
+		if (!sys_slist_is_empty(&hq->events)) {
+			k_yield();
+			return;
+		}
+	}
+}
+#else
+static struct event_queue *event_queue_get(const struct event_type *et)
+{
+	return &queues[0];
+}
+
+static void event_queues_init(void)
+{
+}
+
+static void event_queue_yield(const struct event_queue *q)
+{
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_QUEUES */
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+/* Must be called with the lock held. */
+static void queue_stats_submitted(struct event_queue *q, struct app_event_header *aeh)
+{
+	q->stats.depth++;
+	q->stats.depth_max = MAX(q->stats.depth_max, q->stats.depth);
+}
+
+static void queue_stats_taken(struct event_queue *q, const struct app_event_header *aeh)
+{
+	uint32_t residence_us = k_cyc_to_us_floor32(k_cycle_get_32() - aeh->submit_cycles);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	q->stats.depth--;
+	q->stats.processed_cnt++;
+	q->stats.residence_total_us += residence_us;
+	q->stats.residence_max_us = MAX(q->stats.residence_max_us, residence_us);
+
+	k_spin_unlock(&lock, key);
+}
+
+int app_event_manager_queue_stats_get(uint8_t queue, struct app_event_manager_queue_stats *stats)
+{
+	if (queue >= ARRAY_SIZE(queues)) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = queues[queue].stats;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+void app_event_manager_queue_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(queues); i++) {
+		struct app_event_manager_queue_stats *stats = &queues[i].stats;
+
+		stats->depth_max = stats->depth;
+		stats->processed_cnt = 0;
+		stats->residence_total_us = 0;
+		stats->residence_max_us = 0;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+#else
+static void queue_stats_submitted(struct event_queue *q, struct app_event_header *aeh)
+{
+}
+
+static void queue_stats_taken(struct event_queue *q, const struct app_event_header *aeh)
+{
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_QUEUE_STATS */
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LATENCY_STATS)
+#define LATENCY_BUCKET_CNT CONFIG_APP_EVENT_MANAGER_LATENCY_STATS_BUCKETS
+
+/* Log-scale histogram of times in cycles. Bucket i counts the times with bit length i, that is
+ * the times in range [2^(i-1), 2^i), and the last bucket also counts all longer times.
+ * A histogram is updated only by the thread processing the given event type, so no lock is
+ * taken on the dispatch path.
+ */
+struct latency_hist {
+	uint32_t cnt;
+	uint32_t max_cycles;
+	uint32_t buckets[LATENCY_BUCKET_CNT];
+};
+
+extern const struct event_subscriber __start_event_subscribers_all[];
+extern const struct event_subscriber __stop_event_subscribers_all[];
+
+static struct latency_hist residence_hists[CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT];
+static struct latency_hist handler_hists[CONFIG_APP_EVENT_MANAGER_LATENCY_STATS_MAX_SUBSCRIBERS];
+
+static void latency_hist_add(struct latency_hist *h, uint32_t cycles)
+{
+	h->buckets[MIN(find_msb_set(cycles), LATENCY_BUCKET_CNT - 1)]++;
+	h->max_cycles = MAX(h->max_cycles, cycles);
+	h->cnt++;
+}
+
+/* The percentile is estimated as the upper bound of the bucket holding it. */
+static uint32_t latency_hist_percentile_us(const struct latency_hist *h, uint32_t percent)
+{
+	uint32_t rank = DIV_ROUND_UP((uint64_t)h->cnt * percent, 100);
+	uint32_t sum = 0;
+
+	for (size_t i = 0; i < LATENCY_BUCKET_CNT - 1; i++) {
+		sum += h->buckets[i];
+
+		if ((sum >= rank) && (sum > 0)) {
+			uint32_t upper = (i == 0) ? 0 : (BIT(i) - 1);
+
+			return k_cyc_to_us_ceil32(MIN(upper, h->max_cycles));
+		}
+	}
+
+	return k_cyc_to_us_ceil32(h->max_cycles);
+}
+
+static void residence_stats_add(const struct app_event_header *aeh)
+{
+	latency_hist_add(&residence_hists[aeh->type_id - _event_type_list_start],
+			 k_cycle_get_32() - aeh->submit_cycles);
+}
+
+static uint32_t handler_stats_start(void)
+{
+	return k_cycle_get_32();
+}
+
+static void handler_stats_add(const struct event_subscriber *es, uint32_t start)
+{
+	size_t idx = es - __start_event_subscribers_all;
+
+	if (idx < ARRAY_SIZE(handler_hists)) {
+		latency_hist_add(&handler_hists[idx], k_cycle_get_32() - start);
+	}
+}
+
+static void latency_stats_init(void)
+{
+	size_t subs_cnt = __stop_event_subscribers_all - __start_event_subscribers_all;
+
+	if (subs_cnt > ARRAY_SIZE(handler_hists)) {
+		LOG_WRN("Handler time tracked for %zu of %zu subscribers",
+			ARRAY_SIZE(handler_hists), subs_cnt);
+	}
+}
+
+int app_event_manager_latency_stats_get(const struct event_type *et, const char *listener,
+					struct app_event_manager_latency_stats *stats)
+{
+	const struct latency_hist *h = NULL;
+	struct latency_hist hist;
+
+	if ((et < _event_type_list_start) || (et >= _event_type_list_end)) {
+		return -EINVAL;
+	}
+
+	if (!listener) {
+		h = &residence_hists[et - _event_type_list_start];
+	} else {
+		for (const struct event_subscriber *es = et->subs_start; es != et->subs_stop;
+		     es++) {
+			size_t idx = es - __start_event_subscribers_all;
+
+			if (!strcmp(es->listener->name, listener) &&
+			    (idx < ARRAY_SIZE(handler_hists))) {
+				h = &handler_hists[idx];
+				break;
+			}
+		}
+	}
+
+	if (!h) {
+		return -ENOENT;
+	}
+
+	/* The histogram may be updated in the meantime, work on a copy. */
+	hist = *h;
+
+	stats->cnt = hist.cnt;
+	stats->p50_us = latency_hist_percentile_us(&hist, 50);
+	stats->p99_us = latency_hist_percentile_us(&hist, 99);
+	stats->max_us = k_cyc_to_us_ceil32(hist.max_cycles);
+
+	return 0;
+}
+
+void app_event_manager_latency_stats_reset(void)
+{
+	memset(residence_hists, 0, sizeof(residence_hists));
+	memset(handler_hists, 0, sizeof(handler_hists));
+}
+#else
+static void residence_stats_add(const struct app_event_header *aeh)
+{
+}
+
+static uint32_t handler_stats_start(void)
+{
+	return 0;
+}
+
+static void handler_stats_add(const struct event_subscriber *es, uint32_t start)
+{
+}
+
+static void latency_stats_init(void)
+{
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_LATENCY_STATS */
+
 static bool log_is_event_displayed(const struct event_type *et)
 {
 	size_t idx = et - _event_type_list_start;
@@ -137,70 +423,297 @@ void __weak app_event_manager_free(void *addr)
 	k_free(addr);
 }
 
-static void event_processor_fn(struct k_work *work)
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+static const struct event_pool *pool_lut[CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT];
+
+static const struct event_pool *pool_get(const struct event_type *et)
 {
-	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
+	return pool_lut[et - _event_type_list_start];
+}
 
-	/* Make current event list local. */
-	k_spinlock_key_t key = k_spin_lock(&lock);
+static void event_pool_init(void)
+{
+	STRUCT_SECTION_FOREACH(event_pool, pool) {
+		size_t idx = pool->type - _event_type_list_start;
+		int err = k_mem_slab_init(pool->slab, pool->buffer, pool->block_size,
+					  pool->num_blocks);
 
-	if (sys_slist_is_empty(&eventq)) {
-		k_spin_unlock(&lock, key);
-		return;
+		__ASSERT_NO_MSG(!err);
+		ARG_UNUSED(err);
+		__ASSERT(!pool_lut[idx], "Multiple pools defined for %s", pool->type->name);
+
+		pool_lut[idx] = pool;
 	}
+}
 
-	sys_slist_merge_slist(&events, &eventq);
+static bool event_pool_free(struct app_event_header *aeh)
+{
+	const struct event_pool *pool = pool_get(aeh->type_id);
+	char *addr = (char *)aeh;
 
-	k_spin_unlock(&lock, key);
+	if (!pool || (addr < pool->buffer) ||
+	    (addr >= pool->buffer + pool->block_size * pool->num_blocks)) {
+		return false;
+	}
 
-	/* Traverse the list of events. */
-	sys_snode_t *node;
-	while (NULL != (node = sys_slist_get(&events))) {
-		struct app_event_header *aeh = CONTAINER_OF(node,
-						       struct app_event_header,
-						       node);
+	k_mem_slab_free(pool->slab, aeh);
 
-		APP_EVENT_ASSERT_ID(aeh->type_id);
+	return true;
+}
 
-		const struct event_type *et = aeh->type_id;
+void *_app_event_alloc(const struct event_type *et, size_t size)
+{
+	const struct event_pool *pool = pool_get(et);
+	void *event;
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
-				h->hook(aeh);
-			}
+	if (pool && !k_mem_slab_alloc(pool->slab, &event, K_NO_WAIT)) {
+		return event;
+	}
+
+	return app_event_manager_alloc(size);
+}
+#else
+static void event_pool_init(void)
+{
+}
+
+static bool event_pool_free(struct app_event_header *aeh)
+{
+	return false;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_EVENT_POOLS */
+
+void app_event_manager_event_free(struct app_event_header *aeh)
+{
+	__ASSERT_NO_MSG(aeh);
+	APP_EVENT_ASSERT_ID(aeh->type_id);
+
+	if (!event_pool_free(aeh)) {
+		app_event_manager_free(aeh);
+	}
+}
+
+static void event_preprocess(struct app_event_header *aeh)
+{
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
+			h->hook(aeh);
+		}
+	}
+
+	log_event(aeh);
+}
+
+static void event_postprocess(struct app_event_header *aeh)
+{
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
+			h->hook(aeh);
 		}
+	}
+
+	app_event_manager_event_free(aeh);
+}
+
+static bool event_notify(const struct event_type *et, const struct event_subscriber *es,
+			 const struct app_event_header *aeh)
+{
+	const struct event_listener *el = es->listener;
+
+	__ASSERT_NO_MSG(el->notification != NULL);
+
+	log_event_progress(et, el);
+
+	uint32_t start = handler_stats_start();
+	bool consumed = el->notification(aeh);
 
-		log_event(aeh);
+	handler_stats_add(es, start);
 
-		bool consumed = false;
+	if (consumed) {
+		log_event_consumed(et);
+	}
+
+	return consumed;
+}
+
+static void event_process(struct app_event_header *aeh)
+{
+	const struct event_type *et = aeh->type_id;
+
+	event_preprocess(aeh);
+
+	bool consumed = false;
+
+	for (const struct event_subscriber *es = et->subs_start;
+	     (es != et->subs_stop) && !consumed;
+	     es++) {
 
+		__ASSERT_NO_MSG(es != NULL);
+		__ASSERT_NO_MSG(es->listener != NULL);
+
+		consumed = event_notify(et, es, aeh);
+	}
+
+	event_postprocess(aeh);
+}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH)
+BUILD_ASSERT(CONFIG_APP_EVENT_MANAGER_BATCH_SIZE <= 32);
+
+/* Event types with at least one batch-aware subscriber. */
+static ATOMIC_DEFINE(batch_type_bm, CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT);
+
+static bool is_batch_type(const struct event_type *et)
+{
+	return atomic_test_bit(batch_type_bm, et - _event_type_list_start);
+}
+
+static void event_batch_init(void)
+{
+	STRUCT_SECTION_FOREACH(event_type, et) {
 		for (const struct event_subscriber *es = et->subs_start;
-		     (es != et->subs_stop) && !consumed;
+		     es != et->subs_stop;
 		     es++) {
+			if (es->listener->notification_batch) {
+				atomic_set_bit(batch_type_bm, et - _event_type_list_start);
+				break;
+			}
+		}
+	}
+}
 
-			__ASSERT_NO_MSG(es != NULL);
+static void event_batch_process(struct app_event_header *const *batch, size_t cnt)
+{
+	const struct event_type *et = batch[0]->type_id;
+	const struct app_event_header *pending[CONFIG_APP_EVENT_MANAGER_BATCH_SIZE];
+	uint32_t consumed_bm = 0;
+	size_t consumed_cnt = 0;
+
+	for (size_t i = 0; i < cnt; i++) {
+		event_preprocess(batch[i]);
+	}
+
+	/* Every subscriber gets the whole batch before the next one is notified. The per event
+	 * consumed flags keep the propagation rules of single event dispatch.
+	 */
+	for (const struct event_subscriber *es = et->subs_start;
+	     (es != et->subs_stop) && (consumed_cnt < cnt);
+	     es++) {
 
-			const struct event_listener *el = es->listener;
+		__ASSERT_NO_MSG(es != NULL);
 
-			__ASSERT_NO_MSG(el != NULL);
-			__ASSERT_NO_MSG(el->notification != NULL);
+		const struct event_listener *el = es->listener;
+
+		__ASSERT_NO_MSG(el != NULL);
+
+		if (el->notification_batch) {
+			size_t pending_cnt = 0;
+
+			for (size_t i = 0; i < cnt; i++) {
+				if (!(consumed_bm & BIT(i))) {
+					pending[pending_cnt++] = batch[i];
+				}
+			}
 
 			log_event_progress(et, el);
 
-			consumed = el->notification(aeh);
+			uint32_t start = handler_stats_start();
 
-			if (consumed) {
-				log_event_consumed(et);
+			el->notification_batch(pending, pending_cnt);
+			handler_stats_add(es, start);
+			continue;
+		}
+
+		for (size_t i = 0; i < cnt; i++) {
+			if (consumed_bm & BIT(i)) {
+				continue;
+			}
+
+			if (event_notify(et, es, batch[i])) {
+				consumed_bm |= BIT(i);
+				consumed_cnt++;
 			}
 		}
+	}
+
+	for (size_t i = 0; i < cnt; i++) {
+		event_postprocess(batch[i]);
+	}
+}
+
+/* Take consecutive events of the same type from the list, starting with aeh. */
+static size_t event_batch_collect(sys_slist_t *events, struct app_event_header *aeh,
+				  struct app_event_header **batch)
+{
+	size_t cnt = 0;
+	sys_snode_t *node;
+
+	batch[cnt++] = aeh;
+
+	while ((cnt < CONFIG_APP_EVENT_MANAGER_BATCH_SIZE) &&
+	       (NULL != (node = sys_slist_peek_head(events)))) {
+		struct app_event_header *next = CONTAINER_OF(node,
+							     struct app_event_header,
+							     node);
+
+		if (next->type_id != aeh->type_id) {
+			break;
+		}
+
+		(void)sys_slist_get(events);
+		batch[cnt++] = next;
+	}
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
-				h->hook(aeh);
+	return cnt;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH */
+
+static void event_processor_fn(struct k_work *work)
+{
+	struct event_queue *q = CONTAINER_OF(work, struct event_queue, work);
+	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
+
+	/* Make current event list local. */
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (sys_slist_is_empty(&q->events)) {
+		k_spin_unlock(&lock, key);
+		return;
+	}
+
+	sys_slist_merge_slist(&events, &q->events);
+
+	k_spin_unlock(&lock, key);
+
+	/* Traverse the list of events. */
+	sys_snode_t *node;
+	while (NULL != (node = sys_slist_get(&events))) {
+		struct app_event_header *aeh = CONTAINER_OF(node,
+						       struct app_event_header,
+						       node);
+
+		APP_EVENT_ASSERT_ID(aeh->type_id);
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH)
+		if (is_batch_type(aeh->type_id)) {
+			struct app_event_header *batch[CONFIG_APP_EVENT_MANAGER_BATCH_SIZE];
+			size_t cnt = event_batch_collect(&events, aeh, batch);
+
+			for (size_t i = 0; i < cnt; i++) {
+				queue_stats_taken(q, batch[i]);
+				residence_stats_add(batch[i]);
 			}
+
+			event_batch_process(batch, cnt);
+			event_queue_yield(q);
+			continue;
 		}
+#endif
 
-		app_event_manager_free(aeh);
+		queue_stats_taken(q, aeh);
+		residence_stats_add(aeh);
+		event_process(aeh);
+		event_queue_yield(q);
 	}
 }
 
@@ -209,6 +722,7 @@ void _event_submit(struct app_event_header *aeh)
 	__ASSERT_NO_MSG(aeh);
 	APP_EVENT_ASSERT_ID(aeh->type_id);
 
+	struct event_queue *q = event_queue_get(aeh->type_id);
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
@@ -216,10 +730,14 @@ void _event_submit(struct app_event_header *aeh)
 			h->hook(aeh);
 		}
 	}
-	sys_slist_append(&eventq, &aeh->node);
+#if _APP_EVENT_SUBMIT_TIMESTAMP
+	aeh->submit_cycles = k_cycle_get_32();
+#endif
+	queue_stats_submitted(q, aeh);
+	sys_slist_append(&q->events, &aeh->node);
 	k_spin_unlock(&lock, key);
 
-	k_work_submit(&event_processor);
+	(void)k_work_submit_to_queue(q->workq, &q->work);
 }
 
 int app_event_manager_init(void)
@@ -230,6 +748,13 @@ int app_event_manager_init(void)
 			CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT);
 
 	log_event_init();
+	event_pool_init();
+	event_queues_init();
+	latency_stats_init();
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH)
+	event_batch_init();
+#endif
 
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTINIT_HOOK)) {
 		STRUCT_SECTION_FOREACH(app_event_manager_postinit_hook, h) {
@@ -240,5 +765,10 @@ int app_event_manager_init(void)
 		}
 	}
 
+	/* Process events submitted before the dedicated queues were started. */
+	for (size_t i = 1; i < ARRAY_SIZE(queues); i++) {
+		(void)k_work_submit_to_queue(queues[i].workq, &queues[i].work);
+	}
+
 	return ret;
 }
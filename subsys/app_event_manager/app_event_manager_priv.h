@@ -119,6 +119,16 @@ extern "C" {
 #define _EVENT_ID(ename) (&_CONCAT(__event_type_, ename))
 
 
+/* Allocate memory for an event of the given type. Event types that do not
+ * have a pool defined are always allocated using app_event_manager_alloc.
+ */
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+#define _APP_EVENT_ALLOC(ename, size) _app_event_alloc(_EVENT_ID(ename), (size))
+#else
+#define _APP_EVENT_ALLOC(ename, size) app_event_manager_alloc(size)
+#endif
+
+
 /* Macro generates a function of name new_ename where ename is provided as
  * an argument. Allocator function is used to create an event of the given
  * ename type.
@@ -127,7 +137,7 @@ extern "C" {
 	static inline struct ename *_CONCAT(new_, ename)(void)			\
 	{									\
 		struct ename *event =						\
-			(struct ename *)app_event_manager_alloc(sizeof(*event));\
+			(struct ename *)_APP_EVENT_ALLOC(ename, sizeof(*event));\
 		BUILD_ASSERT(offsetof(struct ename, header) == 0,		\
 				 "");						\
 		if (event != NULL) {						\
@@ -195,6 +205,59 @@ extern "C" {
 	}
 
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH)
+#define _APP_EVENT_LISTENER_BATCH(lname, notification_fn, notification_batch_fn)	\
+	STRUCT_SECTION_ITERABLE(event_listener, _CONCAT(__event_listener_, lname)) = {	\
+		.name = STRINGIFY(lname),						\
+		.notification = (notification_fn),					\
+		.notification_batch = (notification_batch_fn),				\
+	}
+#else
+#define _APP_EVENT_LISTENER_BATCH(lname, notification_fn, notification_batch_fn)	\
+	_APP_EVENT_LISTENER(lname, notification_fn)
+#endif
+
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUES)
+#define _APP_EVENT_QUEUE_CNT CONFIG_APP_EVENT_MANAGER_QUEUE_COUNT
+
+#define _APP_EVENT_QUEUE_ASSIGN(ename, queue_idx)						\
+	BUILD_ASSERT((queue_idx) < _APP_EVENT_QUEUE_CNT, "Invalid event queue");		\
+	STRUCT_SECTION_ITERABLE(event_queue_assignment, _CONCAT(__event_queue_, ename)) = {	\
+		.type  = _EVENT_ID(ename),							\
+		.queue = (queue_idx),								\
+	}
+#else
+#define _APP_EVENT_QUEUE_CNT 1
+
+#define _APP_EVENT_QUEUE_ASSIGN(ename, queue_idx)						\
+	BUILD_ASSERT((queue_idx) == 0, "Enable APP_EVENT_MANAGER_QUEUES before usage")
+#endif
+
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_POOLS)
+#define _APP_EVENT_POOL_BLOCK_SIZE(ename) WB_UP(sizeof(struct ename))
+
+#define _APP_EVENT_POOL_DEFINE(ename, num_events)						\
+	BUILD_ASSERT(!_CONCAT(ename, _HAS_DYNDATA),						\
+		     "Events with dynamic data cannot use a pool");				\
+	BUILD_ASSERT((num_events) > 0, "Event pool cannot be empty");				\
+	static char __aligned(WB_UP(1))								\
+		_CONCAT(__event_pool_buf_, ename)[(num_events) * _APP_EVENT_POOL_BLOCK_SIZE(ename)];\
+	static struct k_mem_slab _CONCAT(__event_pool_slab_, ename);				\
+	STRUCT_SECTION_ITERABLE(event_pool, _CONCAT(__event_pool_, ename)) = {			\
+		.type       = _EVENT_ID(ename),							\
+		.slab       = &_CONCAT(__event_pool_slab_, ename),				\
+		.buffer     = _CONCAT(__event_pool_buf_, ename),				\
+		.block_size = _APP_EVENT_POOL_BLOCK_SIZE(ename),				\
+		.num_blocks = (num_events),							\
+	}
+#else
+#define _APP_EVENT_POOL_DEFINE(ename, num_events)						\
+	BUILD_ASSERT((num_events) > 0, "Event pool cannot be empty")
+#endif
+
+
 #define _APP_EVENT_TYPE_DECLARE_COMMON(ename)						\
 	extern Z_DECL_ALIGN(struct event_type) _CONCAT(__event_type_, ename);		\
 	_APP_EVENT_CASTER_FN(ename);							\
@@ -219,6 +282,11 @@ extern "C" {
 #define _APP_EVENT_TYPE_DEFINE_SIZES(ename)
 #endif
 
+/* Events are timestamped at submission if any statistics need their residence time. */
+#define _APP_EVENT_SUBMIT_TIMESTAMP						\
+	(IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS) ||			\
+	 IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LATENCY_STATS))
+
 /** @brief Event header.
  *
  * When defining an event structure, the application event header
@@ -230,6 +298,11 @@ struct app_event_header {
 
 	/** Pointer to the event type object. */
 	const struct event_type *type_id;
+
+#if _APP_EVENT_SUBMIT_TIMESTAMP
+	/** Cycle counter value at the event submission. */
+	uint32_t submit_cycles;
+#endif
 };
 
 /** Function to log data from this event. */
@@ -387,6 +460,49 @@ struct event_listener {
 	 * not propagated to further listeners, or false, otherwise.
 	 */
 	bool (*notification)(const struct app_event_header *aeh);
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH)
+	/** Pointer to the function that is called with a batch of events of the same type,
+	 * or NULL if the listener handles events one by one. Events that are passed in a batch
+	 * cannot be consumed.
+	 */
+	void (*notification_batch)(const struct app_event_header *const *aehs, size_t cnt);
+#endif
+};
+
+
+/** @brief Event pool.
+ *
+ * All event pools must be defined using @ref APP_EVENT_POOL_DEFINE.
+ */
+struct event_pool {
+	/** Event type allocated from this pool. */
+	const struct event_type *type;
+
+	/** Memory slab managing the pool. */
+	struct k_mem_slab *slab;
+
+	/** Memory backing the pool. */
+	char *buffer;
+
+	/** Size of a single pool block. */
+	size_t block_size;
+
+	/** Number of blocks in the pool. */
+	uint32_t num_blocks;
+};
+
+
+/** @brief Assignment of an event type to an event queue.
+ *
+ * All assignments must be defined using @ref APP_EVENT_QUEUE_ASSIGN.
+ */
+struct event_queue_assignment {
+	/** Event type. */
+	const struct event_type *type;
+
+	/** Index of the queue processing the event type. */
+	uint8_t queue;
 };
 
 
@@ -433,6 +549,16 @@ struct event_postprocess_hook {
  */
 void _event_submit(struct app_event_header *aeh);
 
+/** @brief Allocate an event from the pool of its type.
+ *
+ * If the event type has no pool or the pool is exhausted, the event is allocated
+ * using app_event_manager_alloc.
+ *
+ * @param et    Event type.
+ * @param size  Size of the event.
+ */
+void *_app_event_alloc(const struct event_type *et, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
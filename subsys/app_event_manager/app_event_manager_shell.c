@@ -81,6 +81,92 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+static int show_queues(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "Event queues:\n");
+
+	for (uint8_t i = 0; i < APP_EVENT_QUEUE_CNT; i++) {
+		struct app_event_manager_queue_stats stats;
+		uint32_t residence_avg_us = 0;
+
+		(void)app_event_manager_queue_stats_get(i, &stats);
+
+		if (stats.processed_cnt > 0) {
+			residence_avg_us = (uint32_t)(stats.residence_total_us /
+						      stats.processed_cnt);
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[Q:%u] depth: %u (max %u), processed: %u, "
+			      "residence: avg %u us, max %u us\n",
+			      i, stats.depth, stats.depth_max, stats.processed_cnt,
+			      residence_avg_us, stats.residence_max_us);
+	}
+
+	return 0;
+}
+
+static int reset_queues(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	app_event_manager_queue_stats_reset();
+	shell_fprintf(shell, SHELL_NORMAL, "Event queue statistics reset\n");
+
+	return 0;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_QUEUE_STATS */
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LATENCY_STATS)
+static int show_latency(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "Event latency (count, p50/p99/max us):\n");
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		struct app_event_manager_latency_stats stats;
+
+		(void)app_event_manager_latency_stats_get(et, NULL, &stats);
+
+		if (stats.cnt == 0) {
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "[E:%s] residence: %u, %u/%u/%u\n",
+			      et->name, stats.cnt, stats.p50_us, stats.p99_us, stats.max_us);
+
+		for (const struct event_subscriber *es = et->subs_start;
+		     es != et->subs_stop;
+		     es++) {
+			const struct event_listener *el = es->listener;
+
+			if (app_event_manager_latency_stats_get(et, el->name, &stats) ||
+			    (stats.cnt == 0)) {
+				continue;
+			}
+
+			shell_fprintf(shell, SHELL_NORMAL,
+				      "|\t[L:%s] handler: %u, %u/%u/%u\n",
+				      el->name, stats.cnt, stats.p50_us, stats.p99_us,
+				      stats.max_us);
+		}
+	}
+
+	return 0;
+}
+
+static int reset_latency(const struct shell *shell, size_t argc,
+		char **argv)
+{
+	app_event_manager_latency_stats_reset();
+	shell_fprintf(shell, SHELL_NORMAL, "Event latency statistics reset\n");
+
+	return 0;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_LATENCY_STATS */
+
 static void set_event_displaying(const struct shell *shell, size_t argc,
 				 char **argv, bool enable)
 {
@@ -155,6 +241,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_app_event_manager,
 	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
 		      show_subscribers, 0, 0),
 	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)
+	SHELL_CMD_ARG(show_queues, NULL, "Show event queue statistics", show_queues, 0, 0),
+	SHELL_CMD_ARG(reset_queues, NULL, "Reset event queue statistics", reset_queues, 0, 0),
+#endif
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LATENCY_STATS)
+	SHELL_CMD_ARG(show_latency, NULL, "Show event latency statistics", show_latency, 0, 0),
+	SHELL_CMD_ARG(reset_latency, NULL, "Reset event latency statistics", reset_latency, 0, 0),
+#endif
 	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
 		      disable_event_displaying, 0,
 		      sizeof(_app_event_manager_event_display_bm) * 8 - 1),
@@ -19,6 +19,12 @@ LOG_MODULE_REGISTER(audio_module, CONFIG_AUDIO_MODULE_LOG_LEVEL);
 /* Define a timeout to prevent system locking */
 #define LOCK_TIMEOUT_US (K_USEC(100))
 
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+/* Shared pool for the output buffers of modules opened without a data slab. */
+K_MEM_SLAB_DEFINE_STATIC(graph_pool, CONFIG_AUDIO_MODULE_GRAPH_POOL_BLOCK_SIZE,
+			 CONFIG_AUDIO_MODULE_GRAPH_POOL_BLOCK_NUM, 4);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 /**
  * @brief Helper function to validate the module state.
  *
@@ -126,13 +132,89 @@ static bool validate_parameters(struct audio_module_parameters const *const para
 		return false;
 	}
 
-	if (parameters->thread.stack == NULL || parameters->thread.stack_size == 0) {
+	if (parameters->thread.execution == AUDIO_MODULE_EXECUTION_INLINE) {
+		/* An input module generates its own data, so it needs a thread. */
+		if (!IS_ENABLED(CONFIG_AUDIO_MODULE_GRAPH) ||
+		    parameters->description->type == AUDIO_MODULE_TYPE_INPUT ||
+		    parameters->thread.stack != NULL) {
+			LOG_ERR("Invalid inline execution for module");
+			return false;
+		}
+	} else if (parameters->thread.execution != AUDIO_MODULE_EXECUTION_THREAD ||
+		   parameters->thread.stack == NULL || parameters->thread.stack_size == 0) {
 		return false;
 	}
 
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+	if (parameters->thread.data_slab == NULL &&
+	    parameters->thread.data_size > CONFIG_AUDIO_MODULE_GRAPH_POOL_BLOCK_SIZE) {
+		LOG_ERR("Data size %zu too large for the graph pool", parameters->thread.data_size);
+		return false;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	return true;
 }
 
+/**
+ * @brief Helper function to check if a module runs in the thread of the module that feeds it.
+ *
+ * @param handle  [in]  The handle for the module instance.
+ *
+ * @return true if the module has no thread of its own, false otherwise.
+ */
+static bool runs_inline(struct audio_module_handle const *const handle)
+{
+	return IS_ENABLED(CONFIG_AUDIO_MODULE_GRAPH) &&
+	       handle->thread.execution == AUDIO_MODULE_EXECUTION_INLINE;
+}
+
+/**
+ * @brief Call the data process function of a module, and count the cycles it takes.
+ *
+ * @param handle         [in/out]  The handle for the module instance.
+ * @param audio_data_rx  [in]      Pointer to the input audio data or NULL for an input module.
+ * @param audio_data_tx  [out]     Pointer to the output audio data or NULL for an output module.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int module_data_process(struct audio_module_handle *handle,
+			       struct audio_data const *const audio_data_rx,
+			       struct audio_data *audio_data_tx)
+{
+	int ret;
+
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+	uint32_t start = k_cycle_get_32();
+	uint32_t cycles;
+	struct audio_module_cycles *stats = &handle->cycles;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
+	ret = handle->description->functions->data_process(
+		(struct audio_module_handle_private *)handle, audio_data_rx, audio_data_tx);
+
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+	cycles = k_cycle_get_32() - start;
+
+	/* The budget is the duration of the audio data, an input module describes the
+	 * data it generates.
+	 */
+	stats->budget = k_us_to_cyc_ceil32(audio_data_rx != NULL
+						   ? audio_data_rx->meta.data_len_us
+						   : audio_data_tx->meta.data_len_us);
+	stats->count++;
+	stats->last = cycles;
+	stats->max = MAX(stats->max, cycles);
+	stats->total += cycles;
+
+	if (stats->budget != 0 && cycles > stats->budget) {
+		stats->over_budget++;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
+	return ret;
+}
+
 /**
  * @brief General callback for releasing the data when inter-module data
  *        passing.
@@ -160,6 +242,104 @@ static void audio_data_release_cb(struct audio_module_handle_private *handle,
 	}
 }
 
+static int send_to_connected_modules(struct audio_module_handle *handle,
+				     struct audio_data const *const audio_data);
+
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+/**
+ * @brief Call the data process function of a module that runs in the thread of the sending
+ *        module.
+ *
+ * @note Several modules can send data to the same module from their own threads, so the
+ *       calls are serialised and a sender may block until another sender is done.
+ *
+ * @param handle         [in/out]  The handle for the module instance.
+ * @param audio_data_rx  [in]      Pointer to the input audio data.
+ * @param audio_data_tx  [out]     Pointer to the output audio data or NULL for an output module.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int inline_data_process(struct audio_module_handle *handle,
+			       struct audio_data const *const audio_data_rx,
+			       struct audio_data *audio_data_tx)
+{
+	int ret;
+
+	k_mutex_lock(&handle->process_mutex, K_FOREVER);
+
+	ret = module_data_process(handle, audio_data_rx, audio_data_tx);
+
+	k_mutex_unlock(&handle->process_mutex);
+
+	return ret;
+}
+
+/**
+ * @brief Process an audio data item in a module that runs in the thread of the sending module,
+ *        and send the result on to the modules connected to it.
+ *
+ * @note The audio data is released as soon as the module has processed it, so a chain of
+ *       modules only holds the input and the output buffer of one module at a time.
+ *
+ * @param tx_handle            [in/out]  The handle for the sending module instance.
+ * @param rx_handle            [in/out]  The handle for the receiving module instance.
+ * @param audio_data           [in]      Pointer to the audio data to process.
+ * @param data_in_response_cb  [in]      A pointer to a callback to run when the buffer is
+ *                                       fully consumed.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int inline_tx(struct audio_module_handle *tx_handle, struct audio_module_handle *rx_handle,
+		     struct audio_data const *const audio_data,
+		     audio_module_response_cb data_in_response_cb)
+{
+	int ret;
+	struct audio_data audio_data_out;
+	void *data = NULL;
+
+	if (rx_handle->description->type == AUDIO_MODULE_TYPE_OUTPUT) {
+		ret = inline_data_process(rx_handle, audio_data, NULL);
+	} else {
+		ret = k_mem_slab_alloc(rx_handle->thread.data_slab, (void **)&data, K_NO_WAIT);
+		if (ret) {
+			LOG_ERR("No free data buffer for module %s, ret %d", rx_handle->name, ret);
+
+			if (data_in_response_cb != NULL) {
+				data_in_response_cb((struct audio_module_handle_private *)tx_handle,
+						    audio_data);
+			}
+
+			return ret;
+		}
+
+		audio_data_out.data = data;
+		audio_data_out.data_size = rx_handle->thread.data_size;
+
+		ret = inline_data_process(rx_handle, audio_data, &audio_data_out);
+	}
+
+	if (data_in_response_cb != NULL) {
+		data_in_response_cb((struct audio_module_handle_private *)tx_handle, audio_data);
+	}
+
+	if (ret) {
+		if (data != NULL) {
+			k_mem_slab_free(rx_handle->thread.data_slab, data);
+		}
+
+		LOG_ERR("Data process error in module %s, ret %d", rx_handle->name, ret);
+		return 0;
+	}
+
+	if (data != NULL) {
+		/* Send processed audio data to next module(s). */
+		send_to_connected_modules(rx_handle, &audio_data_out);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 /**
  * @brief Send an audio data item to a module, all data is consumed by the module.
  *
@@ -179,6 +359,12 @@ static int data_tx(struct audio_module_handle *tx_handle, struct audio_module_ha
 	struct audio_module_message *data_msg_rx;
 
 	if (rx_handle->state == AUDIO_MODULE_STATE_RUNNING) {
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+		if (runs_inline(rx_handle)) {
+			return inline_tx(tx_handle, rx_handle, audio_data, data_in_response_cb);
+		}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 		ret = data_fifo_pointer_first_vacant_get(rx_handle->thread.msg_rx,
 							 (void **)&data_msg_rx, K_NO_WAIT);
 		if (ret) {
@@ -380,8 +566,7 @@ static void module_thread_input(struct audio_module_handle *handle, void *p2, vo
 		audio_data.data_size = handle->thread.data_size;
 
 		/* Process the input audio data */
-		ret = handle->description->functions->data_process(
-			(struct audio_module_handle_private *)handle, NULL, &audio_data);
+		ret = module_data_process(handle, NULL, &audio_data);
 		if (ret) {
 			k_mem_slab_free(handle->thread.data_slab, (void *)(data));
 
@@ -437,8 +622,7 @@ static void module_thread_output(struct audio_module_handle *handle, void *p2, v
 		LOG_DBG("Module %s new audio data received", handle->name);
 
 		/* Process the input audio data and output from the audio system. */
-		ret = handle->description->functions->data_process(
-			(struct audio_module_handle_private *)handle, &msg_rx->audio_data, NULL);
+		ret = module_data_process(handle, &msg_rx->audio_data, NULL);
 		if (ret) {
 			if (msg_rx->response_cb != NULL) {
 				msg_rx->response_cb(
@@ -505,9 +689,7 @@ static void module_thread_in_out(struct audio_module_handle *handle, void *p2, v
 		audio_data.data_size = handle->thread.data_size;
 
 		/* Process the input audio data into the output audio data. */
-		ret = handle->description->functions->data_process(
-			(struct audio_module_handle_private *)handle, &msg_rx->audio_data,
-			&audio_data);
+		ret = module_data_process(handle, &msg_rx->audio_data, &audio_data);
 		if (ret) {
 			if (msg_rx->response_cb != NULL) {
 				msg_rx->response_cb(
@@ -577,6 +759,12 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 	memcpy(&handle->thread, &parameters->thread,
 	       sizeof(struct audio_module_thread_configuration));
 
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+	if (handle->thread.data_slab == NULL) {
+		handle->thread.data_slab = &graph_pool;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	if (handle->description->functions->open != NULL) {
 		ret = handle->description->functions->open(
 			(struct audio_module_handle_private *)handle, configuration);
@@ -639,6 +827,18 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 	sys_slist_init(&handle->handle_dest_list);
 	k_mutex_init(&handle->dest_mutex);
 
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+	if (runs_inline(handle)) {
+		k_mutex_init(&handle->process_mutex);
+
+		handle->state = AUDIO_MODULE_STATE_CONFIGURED;
+
+		LOG_DBG("Module %s runs in the thread of the module that feeds it", handle->name);
+
+		return 0;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	handle->thread_id = k_thread_create(
 		&handle->thread_data, handle->thread.stack, handle->thread.stack_size, thread_entry,
 		(void *)handle, NULL, NULL, K_PRIO_PREEMPT(handle->thread.priority), 0, K_FOREVER);
@@ -698,7 +898,9 @@ int audio_module_close(struct audio_module_handle *handle)
 	 *       Test the semaphore and wait for it to be zero.
 	 */
 
-	k_thread_abort(handle->thread_id);
+	if (handle->thread_id != NULL) {
+		k_thread_abort(handle->thread_id);
+	}
 
 	/* Ensure module handle data is fully cleared. */
 	memset(handle, 0, sizeof(struct audio_module_handle));
@@ -978,6 +1180,10 @@ int audio_module_start(struct audio_module_handle *handle)
 		}
 	}
 
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+	memset(&handle->cycles, 0, sizeof(struct audio_module_cycles));
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	handle->state = AUDIO_MODULE_STATE_RUNNING;
 
 	return 0;
@@ -1037,7 +1243,7 @@ int audio_module_data_tx(struct audio_module_handle *handle,
 		return -ECANCELED;
 	}
 
-	if (handle->thread.msg_rx == NULL) {
+	if (handle->thread.msg_rx == NULL && !runs_inline(handle)) {
 		LOG_ERR("Module %s has message queue set to NULL", handle->name);
 		return -ECANCELED;
 	}
@@ -1237,6 +1443,26 @@ int audio_module_state_get(struct audio_module_handle const *const handle,
 	return 0;
 };
 
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+int audio_module_cycles_get(struct audio_module_handle const *const handle,
+			    struct audio_module_cycles *cycles)
+{
+	if (handle == NULL || cycles == NULL) {
+		LOG_ERR("Input parameter is NULL");
+		return -EINVAL;
+	}
+
+	if (!state_not_undefined(handle->state)) {
+		LOG_ERR("Module is in an invalid state, %d", handle->state);
+		return -ECANCELED;
+	}
+
+	memcpy(cycles, &handle->cycles, sizeof(struct audio_module_cycles));
+
+	return 0;
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 int audio_module_number_channels_calculate(uint32_t locations, int8_t *number_channels)
 {
 	if (number_channels == NULL) {
@@ -316,7 +316,8 @@ static void bt_rpc_gatt_attr_write_cb_rpc_handler(const struct nrf_rpc_group *gr
 	uint16_t len;
 	uint16_t offset;
 	uint8_t flags;
-	uint8_t *buf;
+	const uint8_t *buf;
+	size_t buf_len;
 
 	NRF_RPC_SCRATCHPAD_DECLARE(&scratchpad, ctx);
 
@@ -325,7 +326,7 @@ static void bt_rpc_gatt_attr_write_cb_rpc_handler(const struct nrf_rpc_group *gr
 	len = nrf_rpc_decode_uint(ctx);
 	offset = nrf_rpc_decode_uint(ctx);
 	flags = nrf_rpc_decode_uint(ctx);
-	buf = nrf_rpc_decode_buffer_into_scratchpad(&scratchpad, NULL);
+	buf = nrf_rpc_decode_buffer_borrow(&scratchpad, &buf_len);
 
 	if (!nrf_rpc_decoding_done_and_check(group, ctx)) {
 		goto decoding_error;
@@ -343,8 +344,10 @@ static void bt_rpc_gatt_attr_write_cb_rpc_handler(const struct nrf_rpc_group *gr
 
 	nrf_rpc_rsp_send_int(group, write_len);
 
+	nrf_rpc_buffer_release(buf);
 	return;
 decoding_error:
+	nrf_rpc_buffer_release(buf);
 	bt_rpc_report_decoding_error(BT_RPC_GATT_CB_ATTR_WRITE_RPC_CMD);
 }
 
@@ -1322,7 +1325,7 @@ static void bt_gatt_read_callback_rpc_handler(const struct nrf_rpc_group *group,
 	uint8_t err;
 	uint8_t result;
 	struct bt_gatt_read_params *params;
-	void *data;
+	const void *data;
 	size_t length;
 
 	NRF_RPC_SCRATCHPAD_DECLARE(&scratchpad, ctx);
@@ -1332,7 +1335,7 @@ static void bt_gatt_read_callback_rpc_handler(const struct nrf_rpc_group *group,
 	params_pointer = nrf_rpc_decode_uint(ctx);
 	params = (struct bt_gatt_read_params *)params_pointer;
 
-	data = nrf_rpc_decode_buffer_into_scratchpad(&scratchpad, &length);
+	data = nrf_rpc_decode_buffer_borrow(&scratchpad, &length);
 
 	if (!nrf_rpc_decoding_done_and_check(group, ctx)) {
 		goto decoding_error;
@@ -1342,9 +1345,11 @@ static void bt_gatt_read_callback_rpc_handler(const struct nrf_rpc_group *group,
 
 	nrf_rpc_rsp_send_uint(group, result);
 
+	nrf_rpc_buffer_release(data);
 	return;
 
 decoding_error:
+	nrf_rpc_buffer_release(data);
 	bt_rpc_report_decoding_error(BT_GATT_READ_CALLBACK_RPC_CMD);
 }
 
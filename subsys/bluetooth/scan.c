@@ -162,6 +162,40 @@ struct bt_scan_manufacturer_data_filter {
 	bool enabled;
 };
 
+#if CONFIG_BT_SCAN_FILTER_INDEX
+/* Number of slots in a hashed filter table with cnt entries. */
+#define INDEX_SLOTS(cnt) (2 * (cnt))
+
+/* Hashed filter tables.
+ * Each slot holds the index of a filter plus one, or 0 if the slot is free.
+ * Collisions are resolved by linear probing.
+ */
+struct bt_scan_filter_index {
+	uint8_t addr[INDEX_SLOTS(CONFIG_BT_SCAN_ADDRESS_CNT)];
+
+	/* An advertised name matches if it is a prefix of the filter name,
+	 * so there is an entry for every prefix of a filter name.
+	 */
+	uint8_t name[INDEX_SLOTS(CONFIG_BT_SCAN_NAME_CNT * (CONFIG_BT_SCAN_NAME_MAX_LEN + 1))];
+
+	uint8_t short_name[INDEX_SLOTS(CONFIG_BT_SCAN_SHORT_NAME_CNT *
+				       (CONFIG_BT_SCAN_SHORT_NAME_MAX_LEN + 1))];
+
+	uint8_t uuid[INDEX_SLOTS(CONFIG_BT_SCAN_UUID_CNT)];
+
+	/* UUID filters as 128-bit UUIDs in little-endian order. */
+	uint8_t uuid_key[CONFIG_BT_SCAN_UUID_CNT][BT_SCAN_UUID_128_SIZE];
+
+	uint8_t appearance[INDEX_SLOTS(CONFIG_BT_SCAN_APPEARANCE_CNT)];
+
+	uint8_t manufacturer_data[INDEX_SLOTS(CONFIG_BT_SCAN_MANUFACTURER_DATA_CNT)];
+
+	/* Bit n is set if a manufacturer data filter is n + 1 bytes long. */
+	uint32_t manufacturer_data_lens[DIV_ROUND_UP(CONFIG_BT_SCAN_MANUFACTURER_DATA_MAX_LEN,
+						     32)];
+};
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
 /* Filters data.
  * This structure contains all filter data and the information
  * about enabling and disabling any type of filters.
@@ -194,6 +228,11 @@ struct bt_scan_filters {
 	 * matched to generate an event.
 	 */
 	bool all_mode;
+
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	/* Hashed tables of the filters above. */
+	struct bt_scan_filter_index index;
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
 };
 
 #if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
@@ -230,6 +269,55 @@ struct conn_blocklist {
 };
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if CONFIG_BT_SCAN_DEDUP
+/* Smoothing factor of the average RSSI. */
+#define DEDUP_RSSI_SMOOTH_DIV 8
+
+/* Advertising packets and scan responses are tracked separately. */
+#define DEDUP_PDU_ADV 0
+#define DEDUP_PDU_SCAN_RSP 1
+
+/* Recently seen advertiser. */
+struct dedup_entry {
+	/* Advertiser address. */
+	bt_addr_le_t addr;
+
+	/* Sequence number of the last report, to find the least recently
+	 * used entry.
+	 */
+	uint32_t seq;
+
+	/* Hash of the last delivered advertising data, per PDU type. */
+	uint32_t hash[2];
+
+	/* Uptime when the advertising data was last delivered [ms],
+	 * per PDU type.
+	 */
+	uint32_t delivered_ms[2];
+
+	/* Bit n is set if advertising data of PDU type n was delivered. */
+	uint8_t delivered;
+
+	/* Average RSSI in 1/16 dBm. */
+	int16_t rssi_avg_q4;
+
+	/* RSSI of the reports from the advertiser. */
+	struct bt_scan_rssi rssi;
+};
+
+/* Least recently used cache of advertisers. */
+struct dedup_cache {
+	/* Array of the advertisers. */
+	struct dedup_entry entry[CONFIG_BT_SCAN_DEDUP_CACHE_SIZE];
+
+	/* Advertiser count. */
+	size_t count;
+
+	/* Sequence number of the next report. */
+	uint32_t seq;
+};
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 /* Scanning module instance. Options for the different scanning modes.
  * This structure stores all module settings. It is used to enable
  * or disable scanning modes and to configure filters.
@@ -276,6 +364,11 @@ static struct bt_scan {
 	struct conn_blocklist blocklist;
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if CONFIG_BT_SCAN_DEDUP
+	/* Recently seen advertisers, to suppress repeated reports. */
+	struct dedup_cache dedup;
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 } bt_scan;
 
 static sys_slist_t callback_list;
@@ -519,22 +612,207 @@ static void scan_connect_with_target(struct bt_scan_control *control,
 }
 #endif /* CONFIG_BT_CENTRAL */
 
+#if CONFIG_BT_SCAN_FILTER_INDEX || CONFIG_BT_SCAN_DEDUP
+/* 32-bit FNV-1a hash. */
+#define INDEX_HASH_INIT 2166136261U
+#define INDEX_HASH_PRIME 16777619U
+
+static uint32_t index_hash(uint32_t hash, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ data[i]) * INDEX_HASH_PRIME;
+	}
+
+	return hash;
+}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX || CONFIG_BT_SCAN_DEDUP */
+
+#if CONFIG_BT_SCAN_DEDUP
+static struct dedup_entry *dedup_entry_get(const bt_addr_le_t *addr)
+{
+	struct dedup_cache *cache = &bt_scan.dedup;
+	struct dedup_entry *entry;
+
+	for (size_t i = 0; i < cache->count; i++) {
+		if (bt_addr_le_cmp(&cache->entry[i].addr, addr) == 0) {
+			return &cache->entry[i];
+		}
+	}
+
+	if (cache->count < ARRAY_SIZE(cache->entry)) {
+		entry = &cache->entry[cache->count];
+		cache->count++;
+	} else {
+		/* Replace the least recently used advertiser. */
+		entry = &cache->entry[0];
+
+		for (size_t i = 1; i < cache->count; i++) {
+			if ((int32_t)(cache->entry[i].seq - entry->seq) < 0) {
+				entry = &cache->entry[i];
+			}
+		}
+	}
+
+	memset(entry, 0, sizeof(*entry));
+	bt_addr_le_copy(&entry->addr, addr);
+
+	return entry;
+}
+
+static void dedup_rssi_update(struct dedup_entry *entry, int8_t rssi)
+{
+	struct bt_scan_rssi *stats = &entry->rssi;
+
+	if (stats->count == 0) {
+		stats->min = rssi;
+		stats->max = rssi;
+		entry->rssi_avg_q4 = rssi * 16;
+	} else {
+		stats->min = MIN(stats->min, rssi);
+		stats->max = MAX(stats->max, rssi);
+		entry->rssi_avg_q4 += ((rssi * 16) - entry->rssi_avg_q4) /
+				      DEDUP_RSSI_SMOOTH_DIV;
+	}
+
+	stats->last = rssi;
+	stats->avg = entry->rssi_avg_q4 / 16;
+
+	if (stats->count < UINT32_MAX) {
+		stats->count++;
+	}
+}
+
+/* Check if the report repeats the advertising data last delivered for
+ * the advertiser, and if it is not yet time to deliver it again.
+ */
+static bool dedup_report_suppress(const struct bt_le_scan_recv_info *info,
+				  struct net_buf_simple *ad)
+{
+	const uint8_t pdu = (info->adv_props & BT_GAP_ADV_PROP_SCAN_RESPONSE) ?
+			    DEDUP_PDU_SCAN_RSP : DEDUP_PDU_ADV;
+	uint32_t now_ms = k_uptime_get_32();
+	struct dedup_entry *entry;
+	uint32_t hash;
+	bool suppress;
+
+	hash = index_hash(INDEX_HASH_INIT, (const uint8_t *)&info->adv_props,
+			  sizeof(info->adv_props));
+	hash = index_hash(hash, ad->data, ad->len);
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	entry = dedup_entry_get(info->addr);
+	entry->seq = bt_scan.dedup.seq++;
+
+	dedup_rssi_update(entry, info->rssi);
+
+	suppress = (entry->delivered & BIT(pdu)) && (entry->hash[pdu] == hash);
+
+	if (suppress && (CONFIG_BT_SCAN_DEDUP_INTERVAL_MS > 0) &&
+	    ((now_ms - entry->delivered_ms[pdu]) >= CONFIG_BT_SCAN_DEDUP_INTERVAL_MS)) {
+		suppress = false;
+	}
+
+	if (!suppress) {
+		entry->delivered |= BIT(pdu);
+		entry->hash[pdu] = hash;
+		entry->delivered_ms[pdu] = now_ms;
+	}
+
+	k_mutex_unlock(&scan_mutex);
+
+	return suppress;
+}
+
+static void dedup_cache_clear(void)
+{
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+	memset(&bt_scan.dedup, 0, sizeof(bt_scan.dedup));
+	k_mutex_unlock(&scan_mutex);
+}
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
+#if CONFIG_BT_SCAN_FILTER_INDEX
+typedef bool (*index_match_t)(size_t filter_idx, const uint8_t *key, uint8_t key_len);
+
+static void index_slot_add(uint8_t *slots, size_t slot_cnt, uint32_t hash,
+			   size_t filter_idx)
+{
+	size_t i = hash % slot_cnt;
+
+	while (slots[i] != 0) {
+		i = (i + 1) % slot_cnt;
+	}
+
+	slots[i] = filter_idx + 1;
+}
+
+/* Find the lowest index of the filters that match the key, among the
+ * filters in the probe sequence of its hash. The tables are never more
+ * than half full, so the sequence ends on a free slot after a few steps.
+ */
+static int index_find(const uint8_t *slots, size_t slot_cnt, uint32_t hash,
+		      index_match_t match, const uint8_t *key, uint8_t key_len)
+{
+	int found = -1;
+	size_t i = hash % slot_cnt;
+
+	for (size_t n = 0; (n < slot_cnt) && (slots[i] != 0); n++) {
+		int filter_idx = slots[i] - 1;
+
+		if (((found < 0) || (filter_idx < found)) &&
+		    match(filter_idx, key, key_len)) {
+			found = filter_idx;
+		}
+
+		i = (i + 1) % slot_cnt;
+	}
+
+	return found;
+}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
+static bool addr_filter_match(size_t i, const uint8_t *addr, uint8_t addr_len)
+{
+	ARG_UNUSED(addr_len);
+
+	return bt_addr_le_cmp((const bt_addr_le_t *)addr,
+			      &bt_scan.scan_filters.addr.target_addr[i]) == 0;
+}
+
+static int addr_filter_find(const bt_addr_le_t *addr)
+{
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	const uint8_t *slots = bt_scan.scan_filters.index.addr;
+
+	return index_find(slots, ARRAY_SIZE(bt_scan.scan_filters.index.addr),
+			  index_hash(INDEX_HASH_INIT, (const uint8_t *)addr, sizeof(*addr)),
+			  addr_filter_match, (const uint8_t *)addr, sizeof(*addr));
+#else
+	for (size_t i = 0; i < bt_scan.scan_filters.addr.cnt; i++) {
+		if (addr_filter_match(i, (const uint8_t *)addr, sizeof(*addr))) {
+			return i;
+		}
+	}
+
+	return -1;
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+}
+
 static bool adv_addr_compare(const bt_addr_le_t *target_addr,
 			     struct bt_scan_control *control)
 {
 	const bt_addr_le_t *addr =
 			bt_scan.scan_filters.addr.target_addr;
-	uint8_t counter = bt_scan.scan_filters.addr.cnt;
-
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_addr_le_cmp(target_addr, &addr[i]) == 0) {
-			control->filter_status.addr.addr = &addr[i];
+	int i = addr_filter_find(target_addr);
 
-			return true;
-		}
+	if (i < 0) {
+		return false;
 	}
 
-	return false;
+	control->filter_status.addr.addr = &addr[i];
+
+	return true;
 }
 
 static bool is_addr_filter_enabled(void)
@@ -598,29 +876,50 @@ static bool adv_name_cmp(const uint8_t *data,
 	return strncmp(target_name, data, data_len) == 0;
 }
 
+static bool name_filter_match(size_t i, const uint8_t *data, uint8_t data_len)
+{
+	return adv_name_cmp(data, data_len, bt_scan.scan_filters.name.target_name[i]);
+}
+
+static int name_filter_find(const uint8_t *data, uint8_t data_len)
+{
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	const uint8_t *slots = bt_scan.scan_filters.index.name;
+	/* The comparison stops at the end of the string. */
+	size_t str_len = strnlen((const char *)data, data_len);
+
+	return index_find(slots, ARRAY_SIZE(bt_scan.scan_filters.index.name),
+			  index_hash(INDEX_HASH_INIT, data, str_len),
+			  name_filter_match, data, data_len);
+#else
+	for (size_t i = 0; i < bt_scan.scan_filters.name.cnt; i++) {
+		if (name_filter_match(i, data, data_len)) {
+			return i;
+		}
+	}
+
+	return -1;
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+}
+
 static bool adv_name_compare(const struct bt_data *data,
 			     struct bt_scan_control *control)
 {
 	struct bt_scan_name_filter const *name_filter =
 			&bt_scan.scan_filters.name;
-	uint8_t counter = bt_scan.scan_filters.name.cnt;
 	uint8_t data_len = data->data_len;
 
 	/* Compare the name found with the name filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (adv_name_cmp(data->data,
-				 data_len,
-				 name_filter->target_name[i])) {
+	int i = name_filter_find(data->data, data_len);
 
-			control->filter_status.name.name =
-				name_filter->target_name[i];
-			control->filter_status.name.len = data_len;
-
-			return true;
-		}
+	if (i < 0) {
+		return false;
 	}
 
-	return false;
+	control->filter_status.name.name = name_filter->target_name[i];
+	control->filter_status.name.len = data_len;
+
+	return true;
 }
 
 static inline bool is_name_filter_enabled(void)
@@ -690,30 +989,54 @@ static bool adv_short_name_cmp(const uint8_t *data,
 	return false;
 }
 
+static bool short_name_filter_match(size_t i, const uint8_t *data, uint8_t data_len)
+{
+	const struct bt_scan_short_name_filter *name_filter =
+			&bt_scan.scan_filters.short_name;
+
+	return adv_short_name_cmp(data, data_len, name_filter->name[i].target_name,
+				  name_filter->name[i].min_len);
+}
+
+static int short_name_filter_find(const uint8_t *data, uint8_t data_len)
+{
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	const uint8_t *slots = bt_scan.scan_filters.index.short_name;
+	/* The comparison stops at the end of the string. */
+	size_t str_len = strnlen((const char *)data, data_len);
+
+	return index_find(slots, ARRAY_SIZE(bt_scan.scan_filters.index.short_name),
+			  index_hash(INDEX_HASH_INIT, data, str_len),
+			  short_name_filter_match, data, data_len);
+#else
+	for (size_t i = 0; i < bt_scan.scan_filters.short_name.cnt; i++) {
+		if (short_name_filter_match(i, data, data_len)) {
+			return i;
+		}
+	}
+
+	return -1;
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+}
+
 static bool adv_short_name_compare(const struct bt_data *data,
 				   struct bt_scan_control *control)
 {
 	const struct bt_scan_short_name_filter *name_filter =
 			&bt_scan.scan_filters.short_name;
-	uint8_t counter = bt_scan.scan_filters.short_name.cnt;
 	uint8_t data_len = data->data_len;
 
 	/* Compare the name found with the name filters. */
-	for (size_t i = 0; i < counter; i++) {
-		if (adv_short_name_cmp(data->data,
-				       data_len,
-				       name_filter->name[i].target_name,
-				       name_filter->name[i].min_len)) {
-
-			control->filter_status.short_name.name =
-				name_filter->name[i].target_name;
-			control->filter_status.short_name.len = data_len;
+	int i = short_name_filter_find(data->data, data_len);
 
-			return true;
-		}
+	if (i < 0) {
+		return false;
 	}
 
-	return false;
+	control->filter_status.short_name.name = name_filter->name[i].target_name;
+	control->filter_status.short_name.len = data_len;
+
+	return true;
 }
 
 static inline bool is_short_name_filter_enabled(void)
@@ -777,6 +1100,7 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 	return 0;
 }
 
+#if !CONFIG_BT_SCAN_FILTER_INDEX
 static bool find_uuid(const uint8_t *data,
 		      uint8_t data_len,
 		      uint8_t uuid_type,
@@ -815,6 +1139,95 @@ static bool find_uuid(const uint8_t *data,
 
 	return false;
 }
+#endif /* !CONFIG_BT_SCAN_FILTER_INDEX */
+
+#if CONFIG_BT_SCAN_FILTER_INDEX
+/* Bluetooth Base UUID 00000000-0000-1000-8000-00805F9B34FB, little-endian. */
+static const uint8_t uuid_base[BT_SCAN_UUID_128_SIZE] = {
+	0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+/* Offset of a 16-bit or 32-bit UUID in the Bluetooth Base UUID. */
+#define UUID_BASE_VAL_OFFSET 12
+
+static bool uuid_filter_match(size_t i, const uint8_t *key, uint8_t key_len)
+{
+	return memcmp(bt_scan.scan_filters.index.uuid_key[i], key, key_len) == 0;
+}
+
+/* Look up every UUID of the advertising data once, and mark the
+ * UUID filters that are found.
+ */
+static void uuid_filters_find(const uint8_t *data, uint8_t data_len,
+			      uint8_t uuid_type, bool all_filters_mode,
+			      uint32_t *found)
+{
+	const uint8_t *slots = bt_scan.scan_filters.index.uuid;
+	uint8_t key[BT_SCAN_UUID_128_SIZE];
+	uint8_t uuid_len;
+	int i;
+
+	ARG_UNUSED(all_filters_mode);
+
+	switch (uuid_type) {
+	case BT_UUID_TYPE_16:
+		uuid_len = sizeof(uint16_t);
+		break;
+
+	case BT_UUID_TYPE_32:
+		uuid_len = sizeof(uint32_t);
+		break;
+
+	case BT_UUID_TYPE_128:
+		uuid_len = BT_SCAN_UUID_128_SIZE;
+		break;
+
+	default:
+		return;
+	}
+
+	memcpy(key, uuid_base, sizeof(key));
+
+	for (size_t pos = 0; (pos + uuid_len) <= data_len; pos += uuid_len) {
+		if (uuid_len == BT_SCAN_UUID_128_SIZE) {
+			memcpy(key, &data[pos], uuid_len);
+		} else {
+			memcpy(&key[UUID_BASE_VAL_OFFSET], &data[pos], uuid_len);
+		}
+
+		i = index_find(slots, ARRAY_SIZE(bt_scan.scan_filters.index.uuid),
+			       index_hash(INDEX_HASH_INIT, key, sizeof(key)),
+			       uuid_filter_match, key, sizeof(key));
+		if (i >= 0) {
+			found[i / 32] |= BIT(i % 32);
+		}
+	}
+}
+#else
+static void uuid_filters_find(const uint8_t *data, uint8_t data_len,
+			      uint8_t uuid_type, bool all_filters_mode,
+			      uint32_t *found)
+{
+	const struct bt_scan_uuid_filter *uuid_filter =
+			&bt_scan.scan_filters.uuid;
+
+	for (size_t i = 0; i < uuid_filter->cnt; i++) {
+		if (find_uuid(data, data_len, uuid_type, &uuid_filter->uuid[i])) {
+			found[i / 32] |= BIT(i % 32);
+
+			/* In the normal filter mode,
+			 * only one UUID is needed to match.
+			 */
+			if (!all_filters_mode) {
+				break;
+			}
+		} else if (all_filters_mode) {
+			break;
+		}
+	}
+}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
 
 static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
 			     struct bt_scan_control *control)
@@ -825,11 +1238,14 @@ static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
 	const uint8_t counter = bt_scan.scan_filters.uuid.cnt;
 	uint8_t data_len = data->data_len;
 	uint8_t uuid_match_cnt = 0;
+	uint32_t found[DIV_ROUND_UP(CONFIG_BT_SCAN_UUID_CNT, 32)];
+
+	memset(found, 0, sizeof(found));
+	uuid_filters_find(data->data, data_len, uuid_type, all_filters_mode, found);
 
 	for (size_t i = 0; i < counter; i++) {
 
-		if (find_uuid(data->data, data_len, uuid_type,
-			      &uuid_filter->uuid[i])) {
+		if (found[i / 32] & BIT(i % 32)) {
 			control->filter_status.uuid.uuid[uuid_match_cnt] =
 				uuid_filter->uuid[i].uuid;
 
@@ -954,31 +1370,53 @@ static bool find_appearance(const uint8_t *data,
 	return false;
 }
 
+static bool appearance_filter_match(size_t i, const uint8_t *data, uint8_t data_len)
+{
+	return find_appearance(data, data_len, &bt_scan.scan_filters.appearance.appearance[i]);
+}
+
+static int appearance_filter_find(const uint8_t *data, uint8_t data_len)
+{
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	const uint8_t *slots = bt_scan.scan_filters.index.appearance;
+
+	if (data_len != sizeof(uint16_t)) {
+		return -1;
+	}
+
+	return index_find(slots, ARRAY_SIZE(bt_scan.scan_filters.index.appearance),
+			  index_hash(INDEX_HASH_INIT, data, data_len),
+			  appearance_filter_match, data, data_len);
+#else
+	for (size_t i = 0; i < bt_scan.scan_filters.appearance.cnt; i++) {
+		if (appearance_filter_match(i, data, data_len)) {
+			return i;
+		}
+	}
+
+	return -1;
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+}
+
 static bool adv_appearance_compare(const struct bt_data *data,
 				   struct bt_scan_control *control)
 {
 	const struct bt_scan_appearance_filter *appearance_filter =
 			&bt_scan.scan_filters.appearance;
-	const uint8_t counter =
-			bt_scan.scan_filters.appearance.cnt;
-	uint8_t data_len = data->data_len;
 
 	/* Verify if the advertised appearance matches
 	 * the provided appearance.
 	 */
-	for (size_t i = 0; i < counter; i++) {
-		if (find_appearance(data->data,
-				    data_len,
-				    &appearance_filter->appearance[i])) {
-
-			control->filter_status.appearance.appearance =
-					&appearance_filter->appearance[i];
+	int i = appearance_filter_find(data->data, data->data_len);
 
-			return true;
-		}
+	if (i < 0) {
+		return false;
 	}
 
-	return false;
+	control->filter_status.appearance.appearance =
+			&appearance_filter->appearance[i];
+
+	return true;
 }
 
 static inline bool is_appearance_filter_enabled(void)
@@ -1042,30 +1480,73 @@ static bool adv_manufacturer_data_cmp(const uint8_t *data,
 	return true;
 }
 
-static bool adv_manufacturer_data_compare(const struct bt_data *data,
-					  struct bt_scan_control *control)
+static bool manufacturer_data_filter_match(size_t i, const uint8_t *data, uint8_t data_len)
 {
 	const struct bt_scan_manufacturer_data_filter *md_filter =
 		&bt_scan.scan_filters.manufacturer_data;
-	uint8_t counter = bt_scan.scan_filters.manufacturer_data.cnt;
 
-	/* Compare the name found with the name filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (adv_manufacturer_data_cmp(data->data,
-				data->data_len,
-				md_filter->manufacturer_data[i].data,
-				md_filter->manufacturer_data[i].data_len)) {
+	return adv_manufacturer_data_cmp(data, data_len,
+					 md_filter->manufacturer_data[i].data,
+					 md_filter->manufacturer_data[i].data_len);
+}
 
-			control->filter_status.manufacturer_data.data =
-				md_filter->manufacturer_data[i].data;
-			control->filter_status.manufacturer_data.len =
-				md_filter->manufacturer_data[i].data_len;
+static int manufacturer_data_filter_find(const uint8_t *data, uint8_t data_len)
+{
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	const struct bt_scan_filter_index *index = &bt_scan.scan_filters.index;
+	uint8_t len_max = MIN(data_len, CONFIG_BT_SCAN_MANUFACTURER_DATA_MAX_LEN);
+	uint32_t hash = INDEX_HASH_INIT;
+	int found = -1;
+	int i;
 
-			return true;
+	/* A filter matches the start of the data, so look up the hash of
+	 * every prefix as long as a filter.
+	 */
+	for (uint8_t len = 1; len <= len_max; len++) {
+		hash = index_hash(hash, &data[len - 1], 1);
+
+		if (!(index->manufacturer_data_lens[(len - 1) / 32] & BIT((len - 1) % 32))) {
+			continue;
+		}
+
+		i = index_find(index->manufacturer_data, ARRAY_SIZE(index->manufacturer_data),
+			       hash, manufacturer_data_filter_match, data, len);
+		if ((i >= 0) && ((found < 0) || (i < found))) {
+			found = i;
 		}
 	}
 
-	return false;
+	return found;
+#else
+	for (size_t i = 0; i < bt_scan.scan_filters.manufacturer_data.cnt; i++) {
+		if (manufacturer_data_filter_match(i, data, data_len)) {
+			return i;
+		}
+	}
+
+	return -1;
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+}
+
+static bool adv_manufacturer_data_compare(const struct bt_data *data,
+					  struct bt_scan_control *control)
+{
+	const struct bt_scan_manufacturer_data_filter *md_filter =
+		&bt_scan.scan_filters.manufacturer_data;
+
+	/* Compare the manufacturer data found with the filters. */
+	int i = manufacturer_data_filter_find(data->data, data->data_len);
+
+	if (i < 0) {
+		return false;
+	}
+
+	control->filter_status.manufacturer_data.data =
+		md_filter->manufacturer_data[i].data;
+	control->filter_status.manufacturer_data.len =
+		md_filter->manufacturer_data[i].data_len;
+
+	return true;
 }
 static inline bool is_manufacturer_data_filter_enabled(void)
 {
@@ -1169,6 +1650,100 @@ static void scan_default_conn_param_set(void)
 	bt_scan.conn_param = *conn_param;
 }
 
+#if CONFIG_BT_SCAN_FILTER_INDEX
+static void filter_index_name_add(uint8_t *slots, size_t slot_cnt,
+				  const char *target_name, size_t max_len,
+				  size_t filter_idx)
+{
+	size_t len = strnlen(target_name, max_len);
+	uint32_t hash = INDEX_HASH_INIT;
+
+	/* Add every prefix of the name, including the empty one. */
+	index_slot_add(slots, slot_cnt, hash, filter_idx);
+
+	for (size_t i = 0; i < len; i++) {
+		hash = index_hash(hash, (const uint8_t *)&target_name[i], 1);
+		index_slot_add(slots, slot_cnt, hash, filter_idx);
+	}
+}
+
+static void filter_index_uuid_key_set(uint8_t *key, const struct bt_uuid *uuid)
+{
+	memcpy(key, uuid_base, BT_SCAN_UUID_128_SIZE);
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		sys_put_le16(BT_UUID_16(uuid)->val, &key[UUID_BASE_VAL_OFFSET]);
+		break;
+
+	case BT_UUID_TYPE_32:
+		sys_put_le32(BT_UUID_32(uuid)->val, &key[UUID_BASE_VAL_OFFSET]);
+		break;
+
+	case BT_UUID_TYPE_128:
+		memcpy(key, BT_UUID_128(uuid)->val, BT_SCAN_UUID_128_SIZE);
+		break;
+
+	default:
+		break;
+	}
+}
+
+/* Rebuild the hashed filter tables from the filters. */
+static void filter_index_build(void)
+{
+	struct bt_scan_filters *filters = &bt_scan.scan_filters;
+	struct bt_scan_filter_index *index = &filters->index;
+	uint8_t appearance[sizeof(uint16_t)];
+	uint32_t hash;
+
+	memset(index, 0, sizeof(*index));
+
+	for (size_t i = 0; i < filters->addr.cnt; i++) {
+		hash = index_hash(INDEX_HASH_INIT, (const uint8_t *)&filters->addr.target_addr[i],
+				  sizeof(bt_addr_le_t));
+		index_slot_add(index->addr, ARRAY_SIZE(index->addr), hash, i);
+	}
+
+	for (size_t i = 0; i < filters->name.cnt; i++) {
+		filter_index_name_add(index->name, ARRAY_SIZE(index->name),
+				      filters->name.target_name[i],
+				      CONFIG_BT_SCAN_NAME_MAX_LEN, i);
+	}
+
+	for (size_t i = 0; i < filters->short_name.cnt; i++) {
+		filter_index_name_add(index->short_name, ARRAY_SIZE(index->short_name),
+				      filters->short_name.name[i].target_name,
+				      CONFIG_BT_SCAN_SHORT_NAME_MAX_LEN, i);
+	}
+
+	for (size_t i = 0; i < filters->uuid.cnt; i++) {
+		filter_index_uuid_key_set(index->uuid_key[i], filters->uuid.uuid[i].uuid);
+
+		hash = index_hash(INDEX_HASH_INIT, index->uuid_key[i], BT_SCAN_UUID_128_SIZE);
+		index_slot_add(index->uuid, ARRAY_SIZE(index->uuid), hash, i);
+	}
+
+	for (size_t i = 0; i < filters->appearance.cnt; i++) {
+		sys_put_le16(filters->appearance.appearance[i], appearance);
+
+		hash = index_hash(INDEX_HASH_INIT, appearance, sizeof(appearance));
+		index_slot_add(index->appearance, ARRAY_SIZE(index->appearance), hash, i);
+	}
+
+	for (size_t i = 0; i < filters->manufacturer_data.cnt; i++) {
+		uint8_t len = filters->manufacturer_data.manufacturer_data[i].data_len;
+
+		hash = index_hash(INDEX_HASH_INIT,
+				  filters->manufacturer_data.manufacturer_data[i].data, len);
+		index_slot_add(index->manufacturer_data, ARRAY_SIZE(index->manufacturer_data),
+			       hash, i);
+
+		index->manufacturer_data_lens[(len - 1) / 32] |= BIT((len - 1) % 32);
+	}
+}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
 int bt_scan_filter_add(enum bt_scan_filter_type type,
 		       const void *data)
 {
@@ -1222,6 +1797,17 @@ int bt_scan_filter_add(enum bt_scan_filter_type type,
 		break;
 	}
 
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	if (!err) {
+		filter_index_build();
+	}
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
+#if CONFIG_BT_SCAN_DEDUP
+	/* Deliver the next report from every advertiser with the new filters. */
+	dedup_cache_clear();
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 	k_mutex_unlock(&scan_mutex);
 
 	return err;
@@ -1255,6 +1841,14 @@ void bt_scan_filter_remove_all(void)
 		&bt_scan.scan_filters.manufacturer_data;
 	manufacturer_data_filter->cnt = 0;
 
+#if CONFIG_BT_SCAN_FILTER_INDEX
+	filter_index_build();
+#endif /* CONFIG_BT_SCAN_FILTER_INDEX */
+
+#if CONFIG_BT_SCAN_DEDUP
+	dedup_cache_clear();
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 	k_mutex_unlock(&scan_mutex);
 }
 
@@ -1267,6 +1861,10 @@ void bt_scan_filter_disable(void)
 	bt_scan.scan_filters.uuid.enabled = false;
 	bt_scan.scan_filters.appearance.enabled = false;
 	bt_scan.scan_filters.manufacturer_data.enabled = false;
+
+#if CONFIG_BT_SCAN_DEDUP
+	dedup_cache_clear();
+#endif /* CONFIG_BT_SCAN_DEDUP */
 }
 
 int bt_scan_filter_enable(uint8_t mode, bool match_all)
@@ -1351,6 +1949,10 @@ void bt_scan_init(const struct bt_scan_init_param *init)
 	/* Disable all scanning filters. */
 	memset(&bt_scan.scan_filters, 0, sizeof(bt_scan.scan_filters));
 
+#if CONFIG_BT_SCAN_DEDUP
+	dedup_cache_clear();
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 	/* If the pointer to the initialization structure exist,
 	 * use it to scan the configuration.
 	 */
@@ -1551,6 +2153,13 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 		connectable_cache_add(info->addr);
 	}
 
+#if CONFIG_BT_SCAN_DEDUP
+	/* Do not evaluate the filters again for a repeated report. */
+	if (dedup_report_suppress(info, ad)) {
+		return;
+	}
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 	/* Check the address filter. */
 	check_addr(&scan_control, info->addr);
 
@@ -1591,6 +2200,11 @@ int bt_scan_start(enum bt_scan_type scan_type)
 		return -EINVAL;
 	}
 
+#if CONFIG_BT_SCAN_DEDUP
+	/* Report every advertiser again in the new scanning session. */
+	dedup_cache_clear();
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 	/* Start the scanning. */
 	int err = bt_le_scan_start(&bt_scan.scan_param, NULL);
 
@@ -1666,6 +2280,38 @@ void bt_scan_blocklist_clear(void)
 }
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if CONFIG_BT_SCAN_DEDUP
+int bt_scan_dedup_rssi_get(const bt_addr_le_t *addr, struct bt_scan_rssi *rssi)
+{
+	struct dedup_cache *cache = &bt_scan.dedup;
+	int err = -ENOENT;
+
+	if (!addr || !rssi) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < cache->count; i++) {
+		if (bt_addr_le_cmp(&cache->entry[i].addr, addr) == 0) {
+			*rssi = cache->entry[i].rssi;
+			err = 0;
+
+			break;
+		}
+	}
+
+	k_mutex_unlock(&scan_mutex);
+
+	return err;
+}
+
+void bt_scan_dedup_clear(void)
+{
+	dedup_cache_clear();
+}
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 #if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
 void bt_scan_conn_attempts_filter_clear(void)
 {
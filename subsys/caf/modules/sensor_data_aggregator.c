@@ -129,32 +129,43 @@ static void send_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
 	APP_EVENT_SUBMIT(event);
 }
 
-static int enqueue_sample(struct aggregator *agg, struct sensor_event *event)
+static int enqueue_samples(struct aggregator *agg, struct sensor_event *event)
 {
 	size_t chunk_bytes = agg->values_in_sample * sizeof(struct sensor_value);
+	size_t sample_cnt = event->dyndata.size / chunk_bytes;
+	const struct sensor_value *data = sensor_event_get_data_ptr(event);
 
-	if ((event->dyndata.size) != chunk_bytes) {
+	/* A sensor event can carry a block of samples. */
+	if ((sample_cnt == 0) || ((event->dyndata.size % chunk_bytes) != 0)) {
 		return -EBADMSG;
 	}
-	if (!agg->active_buf) {
-		return -ENOMEM;
-	}
 
-	struct aggregator_buffer *ab = agg->active_buf;
-	size_t pos_values = ab->sample_cnt * agg->values_in_sample;
-	size_t avail_bytes = agg->buf_len - pos_values * sizeof(struct sensor_value);
+	while (sample_cnt > 0) {
+		if (!agg->active_buf) {
+			return -ENOMEM;
+		}
 
-	if (avail_bytes < chunk_bytes) {
-		__ASSERT_NO_MSG(false);
-		return -ENOMEM;
-	}
-	memcpy(&ab->samples[pos_values], (uint8_t *)event->dyndata.data, chunk_bytes);
-	ab->sample_cnt++;
-	avail_bytes -= chunk_bytes;
+		struct aggregator_buffer *ab = agg->active_buf;
+		size_t pos_values = ab->sample_cnt * agg->values_in_sample;
+		size_t avail_bytes = agg->buf_len - pos_values * sizeof(struct sensor_value);
+		size_t copy_cnt = MIN(sample_cnt, avail_bytes / chunk_bytes);
+
+		if (copy_cnt == 0) {
+			__ASSERT_NO_MSG(false);
+			return -ENOMEM;
+		}
 
-	if (avail_bytes < chunk_bytes) {
-		send_buffer(agg, ab);
-		agg->active_buf = get_free_buffer(agg);
+		/* Copy as many samples as fit in the active buffer at once. */
+		memcpy(&ab->samples[pos_values], data, copy_cnt * chunk_bytes);
+		ab->sample_cnt += copy_cnt;
+		avail_bytes -= copy_cnt * chunk_bytes;
+		data += copy_cnt * agg->values_in_sample;
+		sample_cnt -= copy_cnt;
+
+		if (avail_bytes < chunk_bytes) {
+			send_buffer(agg, ab);
+			agg->active_buf = get_free_buffer(agg);
+		}
 	}
 
 	return 0;
@@ -167,7 +178,7 @@ static bool event_handler(const struct app_event_header *aeh)
 		struct aggregator *agg = get_aggregator(event->descr);
 
 		if (agg) {
-			int err = enqueue_sample(agg, event);
+			int err = enqueue_samples(agg, event);
 
 			if (err) {
 				LOG_ERR("Error code: %d", err);
@@ -31,6 +31,8 @@ struct sensor_data {
 	atomic_t state;
 	unsigned int sleep_cntd;
 	atomic_t event_cnt;
+	struct sensor_event *batch;
+	uint8_t batch_cnt;
 };
 
 static struct sensor_data sensor_data[ARRAY_SIZE(sensor_configs)];
@@ -52,21 +54,6 @@ static void update_sensor_state(const struct sm_sensor_config *sc, struct sensor
 	APP_EVENT_SUBMIT(event);
 }
 
-static void send_sensor_event(const char *descr, const struct sensor_value *data, const size_t data_cnt,
-			      atomic_t *event_cnt)
-{
-	struct sensor_event *event = new_sensor_event(sizeof(struct sensor_value) * data_cnt);
-	struct sensor_value *data_ptr = sensor_event_get_data_ptr(event);
-
-	event->descr = descr;
-
-	__ASSERT_NO_MSG(sensor_event_get_data_cnt(event) == data_cnt);
-	memcpy(data_ptr, data, sizeof(struct sensor_value) * data_cnt);
-
-	atomic_inc(event_cnt);
-	APP_EVENT_SUBMIT(event);
-}
-
 static struct sensor_data *get_sensor_data(const struct device *dev)
 {
 	for (size_t i = 0; i < ARRAY_SIZE(sensor_configs); i++) {
@@ -105,6 +92,54 @@ static size_t get_sensor_data_cnt(const struct sm_sensor_config *sc)
 	return data_cnt;
 }
 
+static uint8_t get_samples_in_event(const struct sm_sensor_config *sc)
+{
+	return MAX(sc->samples_in_event, 1);
+}
+
+static struct sensor_value *get_batch_slot(const struct sm_sensor_config *sc,
+					   struct sensor_data *sd, size_t data_cnt)
+{
+	if (!sd->batch) {
+		if (atomic_get(&sd->event_cnt) >= sc->active_events_limit) {
+			return NULL;
+		}
+
+		sd->batch = new_sensor_event(sizeof(struct sensor_value) * data_cnt *
+					     get_samples_in_event(sc));
+		sd->batch->descr = sc->event_descr;
+		sd->batch_cnt = 0;
+		atomic_inc(&sd->event_cnt);
+	}
+
+	__ASSERT_NO_MSG(sd->batch_cnt < get_samples_in_event(sc));
+
+	return sensor_event_get_data_ptr(sd->batch) + sd->batch_cnt * data_cnt;
+}
+
+static void submit_batch(const struct sm_sensor_config *sc, struct sensor_data *sd)
+{
+	struct sensor_event *event = sd->batch;
+
+	if (!event) {
+		return;
+	}
+
+	sd->batch = NULL;
+
+	if (sd->batch_cnt == 0) {
+		app_event_manager_free(event);
+		atomic_dec(&sd->event_cnt);
+		return;
+	}
+
+	/* A batch that is submitted before it is full carries only the samples taken so far. */
+	event->dyndata.size = sizeof(struct sensor_value) * get_sensor_data_cnt(sc) *
+			      sd->batch_cnt;
+
+	APP_EVENT_SUBMIT(event);
+}
+
 static void reset_sensor_sleep_cnt(const struct sm_sensor_config *sc,
 				   struct sensor_data *sd)
 {
@@ -220,36 +255,52 @@ static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config
 	size_t data_idx = 0;
 	size_t data_cnt = get_sensor_data_cnt(sc);
 	struct sensor_value data[data_cnt];
+	bool sleep = false;
+
+	/* Channels are read directly into the pending sensor_event. The local buffer is used
+	 * only if the event cannot be sent.
+	 */
+	struct sensor_value *sample = get_batch_slot(sc, sd, data_cnt);
+
+	if (!sample) {
+		sample = data;
+	}
 
 	int err = sensor_sample_fetch(sc->dev);
 
 	for (size_t i = 0; !err && (i < sc->chan_cnt); i++) {
 		const struct caf_sampled_channel *sampled_chan = &sc->chans[i];
 
-		err = sensor_channel_get(sc->dev, sampled_chan->chan, &data[data_idx]);
+		err = sensor_channel_get(sc->dev, sampled_chan->chan, &sample[data_idx]);
 		data_idx += sampled_chan->data_cnt;
 	}
 
 	if (err) {
 		LOG_ERR("Sensor sampling error (err %d)", err);
+		submit_batch(sc, sd);
 		update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
-	} else {
-		if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
-			send_sensor_event(sc->event_descr, data, ARRAY_SIZE(data),
-					  &sd->event_cnt);
-		} else {
-			LOG_WRN("Did not send event due to too many active events on sensor: %s",
-				sc->dev->name);
-		}
+		return;
+	}
 
-		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
-			process_sensor_activity(sc, sd, data);
-			if (!is_sensor_active(sd)) {
-				enter_sleep(sc, sd);
-			}
+	/* The sample must be processed before the event is submitted. */
+	if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
+		process_sensor_activity(sc, sd, sample);
+		sleep = !is_sensor_active(sd);
+	}
 
+	if (sample == data) {
+		LOG_WRN("Did not send event due to too many active events on sensor: %s",
+			sc->dev->name);
+	} else {
+		sd->batch_cnt++;
+		if (sleep || (sd->batch_cnt == get_samples_in_event(sc))) {
+			submit_batch(sc, sd);
 		}
 	}
+
+	if (sleep) {
+		enter_sleep(sc, sd);
+	}
 }
 
 static size_t sample_sensors(int64_t *next_timeout)
@@ -277,6 +328,9 @@ static size_t sample_sensors(int64_t *next_timeout)
 			if (drops > 0) {
 				LOG_WRN("%d sample dropped", drops);
 			}
+		} else if (sd->batch) {
+			/* Sensor was put to sleep by the power down event. */
+			submit_batch(sc, sd);
 		}
 
 		if (atomic_get(&sd->state) != SENSOR_STATE_ERROR) {
@@ -468,6 +522,8 @@ static bool handle_power_down_event(const struct app_event_header *aeh)
 		}
 		k_sched_unlock();
 	}
+	/* Let the sampling thread submit the partially filled batches. */
+	k_sem_give(&can_sample);
 	configure_max_power_state();
 	return false;
 }
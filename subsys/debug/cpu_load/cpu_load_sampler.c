@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <debug/cpu_load_sampler.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/util.h>
+#ifdef CONFIG_ARMV7_M_ARMV8_M_MAINLINE
+#include <cmsis_core.h>
+#endif
+
+#define PC_SLOTS	CONFIG_NRF_CPU_LOAD_SAMPLER_PC_SLOTS
+#define THREAD_SLOTS	CONFIG_NRF_CPU_LOAD_SAMPLER_THREAD_SLOTS
+
+/* Pseudo threads placed after the thread slots. */
+#define THREAD_ISR	THREAD_SLOTS
+#define THREAD_OTHER	(THREAD_SLOTS + 1)
+#define THREAD_CNT	(THREAD_SLOTS + 2)
+
+/* Number of slots checked when looking up a program counter, to bound the time spent in
+ * the interrupt when the table is almost full.
+ */
+#define PC_MAX_PROBES	8
+
+#ifdef CONFIG_THREAD_NAME
+#define THREAD_NAME_LEN CONFIG_THREAD_MAX_NAME_LEN
+#else
+#define THREAD_NAME_LEN 1
+#endif
+
+BUILD_ASSERT(IS_POWER_OF_TWO(PC_SLOTS), "Number of PC slots must be a power of two");
+BUILD_ASSERT(THREAD_CNT <= UINT8_MAX, "Too many thread slots");
+
+struct sampler_thread {
+	const struct k_thread *thread;
+	uint32_t count;
+	char name[THREAD_NAME_LEN];
+};
+
+/* A slot is empty when its count is zero. */
+struct sampler_pc {
+	uintptr_t pc;
+	uint32_t count;
+	uint8_t thread;
+};
+
+static struct sampler_thread threads[THREAD_CNT];
+static struct sampler_pc pcs[PC_SLOTS];
+static struct cpu_load_sampler_stats stats;
+static struct k_spinlock lock;
+
+static void sample(struct k_timer *timer);
+
+static K_TIMER_DEFINE(sampler_timer, sample, NULL);
+
+static bool interrupted_isr(void)
+{
+#ifdef CONFIG_ARMV7_M_ARMV8_M_MAINLINE
+	/* RETTOBASE is cleared if the timer interrupt preempted another exception. */
+	return (SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0;
+#else
+	return false;
+#endif
+}
+
+static uintptr_t interrupted_pc_get(void)
+{
+#ifdef CONFIG_ARMV7_M_ARMV8_M_MAINLINE
+	/* A preempted thread has its exception stack frame on the process stack, with the
+	 * program counter in the seventh word.
+	 */
+	const uint32_t *frame = (const uint32_t *)__get_PSP();
+
+	return frame[6];
+#else
+	return 0;
+#endif
+}
+
+static uint8_t thread_slot_get(const struct k_thread *thread)
+{
+	for (uint8_t i = 0; i < THREAD_SLOTS; i++) {
+		if (threads[i].thread == thread) {
+			return i;
+		}
+
+		if (!threads[i].thread) {
+			threads[i].thread = thread;
+#ifdef CONFIG_THREAD_NAME
+			strncpy(threads[i].name, thread->name, sizeof(threads[i].name) - 1);
+#endif
+			return i;
+		}
+	}
+
+	return THREAD_OTHER;
+}
+
+static bool pc_add(uintptr_t pc, uint8_t thread)
+{
+	uint32_t hash = ((uint32_t)(pc >> 1) ^ ((uint32_t)thread << 24)) * 0x9E3779B1;
+
+	for (size_t i = 0; i < PC_MAX_PROBES; i++) {
+		struct sampler_pc *slot = &pcs[(hash + i) & (PC_SLOTS - 1)];
+
+		if (slot->count == 0) {
+			slot->pc = pc;
+			slot->thread = thread;
+		} else if ((slot->pc != pc) || (slot->thread != thread)) {
+			continue;
+		}
+
+		slot->count++;
+		return true;
+	}
+
+	return false;
+}
+
+static void sample(struct k_timer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uintptr_t pc = 0;
+	uint8_t thread;
+
+	if (interrupted_isr()) {
+		thread = THREAD_ISR;
+	} else {
+		thread = thread_slot_get(k_current_get());
+		pc = interrupted_pc_get();
+	}
+
+	threads[thread].count++;
+	stats.samples++;
+
+	if (!pc_add(pc, thread)) {
+		stats.dropped++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+/* Must be called with the lock held. */
+static void thread_name_get(uint8_t thread, char *name, size_t len)
+{
+	if (thread == THREAD_ISR) {
+		strncpy(name, CPU_LOAD_SAMPLER_ISR_NAME, len);
+	} else if (thread == THREAD_OTHER) {
+		strncpy(name, CPU_LOAD_SAMPLER_OTHER_NAME, len);
+	} else if (threads[thread].name[0] != '\0') {
+		strncpy(name, threads[thread].name, len);
+	} else {
+		snprintf(name, len, "%p", (void *)threads[thread].thread);
+	}
+
+	name[len - 1] = '\0';
+}
+
+int cpu_load_sampler_start(uint32_t interval_us)
+{
+	if (interval_us == 0) {
+		return -EINVAL;
+	}
+
+	k_timer_start(&sampler_timer, K_USEC(interval_us), K_USEC(interval_us));
+
+	return 0;
+}
+
+void cpu_load_sampler_stop(void)
+{
+	k_timer_stop(&sampler_timer);
+}
+
+void cpu_load_sampler_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(threads, 0, sizeof(threads));
+	memset(pcs, 0, sizeof(pcs));
+	memset(&stats, 0, sizeof(stats));
+
+	k_spin_unlock(&lock, key);
+}
+
+void cpu_load_sampler_stats_get(struct cpu_load_sampler_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*out = stats;
+
+	k_spin_unlock(&lock, key);
+}
+
+void cpu_load_sampler_pc_foreach(cpu_load_sampler_pc_cb_t cb, void *user_data)
+{
+	char name[MAX(THREAD_NAME_LEN, 2 * sizeof(void *) + sizeof("0x"))];
+
+	for (size_t i = 0; i < ARRAY_SIZE(pcs); i++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		struct sampler_pc slot = pcs[i];
+
+		if (slot.count > 0) {
+			thread_name_get(slot.thread, name, sizeof(name));
+		}
+
+		k_spin_unlock(&lock, key);
+
+		if (slot.count > 0) {
+			cb(name, slot.pc, slot.count, user_data);
+		}
+	}
+}
+
+void cpu_load_sampler_thread_foreach(cpu_load_sampler_thread_cb_t cb, void *user_data)
+{
+	char name[MAX(THREAD_NAME_LEN, 2 * sizeof(void *) + sizeof("0x"))];
+
+	for (uint8_t i = 0; i < ARRAY_SIZE(threads); i++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		uint32_t count = threads[i].count;
+
+		if (count > 0) {
+			thread_name_get(i, name, sizeof(name));
+		}
+
+		k_spin_unlock(&lock, key);
+
+		if (count > 0) {
+			cb(name, count, user_data);
+		}
+	}
+}
+
+#ifdef CONFIG_NRF_CPU_LOAD_SAMPLER_AUTOSTART
+static int cpu_load_sampler_init(void)
+{
+	return cpu_load_sampler_start(CONFIG_NRF_CPU_LOAD_SAMPLER_INTERVAL_US);
+}
+
+SYS_INIT(cpu_load_sampler_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif
+
+static void print_folded(const char *thread, uintptr_t pc, uint32_t count, void *user_data)
+{
+	const struct shell *shell = user_data;
+
+	if (pc == 0) {
+		shell_print(shell, "%s %u", thread, count);
+	} else {
+		shell_print(shell, "%s;0x%lx %u", thread, (unsigned long)pc, count);
+	}
+}
+
+static void print_thread(const char *thread, uint32_t count, void *user_data)
+{
+	const struct shell *shell = user_data;
+
+	shell_print(shell, "%-20s %u", thread, count);
+}
+
+static int cmd_start(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t interval_us = CONFIG_NRF_CPU_LOAD_SAMPLER_INTERVAL_US;
+	int err = 0;
+
+	if (argc > 1) {
+		interval_us = shell_strtoul(argv[1], 10, &err);
+	}
+
+	if (!err) {
+		err = cpu_load_sampler_start(interval_us);
+	}
+
+	if (err) {
+		shell_error(shell, "Invalid interval");
+	}
+
+	return err;
+}
+
+static int cmd_stop(const struct shell *shell, size_t argc, char **argv)
+{
+	cpu_load_sampler_stop();
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	cpu_load_sampler_reset();
+
+	return 0;
+}
+
+static int cmd_threads(const struct shell *shell, size_t argc, char **argv)
+{
+	struct cpu_load_sampler_stats s;
+
+	cpu_load_sampler_stats_get(&s);
+	shell_print(shell, "Samples:%u dropped:%u", s.samples, s.dropped);
+	cpu_load_sampler_thread_foreach(print_thread, (void *)shell);
+
+	return 0;
+}
+
+static int cmd_folded(const struct shell *shell, size_t argc, char **argv)
+{
+	cpu_load_sampler_pc_foreach(print_folded, (void *)shell);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_cmd_cpu_sampler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling [interval_us]", cmd_start, 1, 1),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling", cmd_stop, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Remove collected samples", cmd_reset, 1, 0),
+	SHELL_CMD_ARG(threads, NULL, "Print samples per thread", cmd_threads, 1, 0),
+	SHELL_CMD_ARG(folded, NULL, "Print samples in folded stack format", cmd_folded, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_COND_CMD_REGISTER(CONFIG_NRF_CPU_LOAD_SAMPLER_CMDS, cpu_sampler, &sub_cmd_cpu_sampler,
+			"CPU usage sampler", NULL);
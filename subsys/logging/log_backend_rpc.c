@@ -36,15 +36,6 @@ LOG_MODULE_REGISTER(log_rpc);
 #define USEC_PER_TICK (1000000 / CONFIG_SYS_CLOCK_TICKS_PER_SEC)
 #define DUMP_META_VERSION 1
 #define ASSERT_FILENAME_SIZE CONFIG_LOG_BACKED_RPC_CRASH_INFO_FILENAME_SIZE
-#define DUMP_METADATA_SIZE(meta) \
-	sizeof((meta).uuid) + 1 + \
-	sizeof((meta).reason) + 1 + \
-	sizeof((meta).lr) + 1 + \
-	sizeof((meta).pc) + 1 + \
-	sizeof((meta).xpsr) + 1 + \
-	sizeof((meta).sp) + 1 + \
-	sizeof((meta).assert_line) + 1 + \
-	((meta).assert_line ? (strlen((meta).assert_filename) + 3) : 1)
 
 #ifdef CONFIG_LOG_BACKEND_RPC_CRASH_LOG
 struct arm_arch_block {
@@ -407,16 +398,11 @@ static void log_rpc_crash_info(const struct nrf_rpc_group *group, struct nrf_rpc
 
 		nrf_rpc_encode_null(&rsp_ctx);
 	} else {
-		NRF_RPC_CBOR_ALLOC(group, rsp_ctx, DUMP_METADATA_SIZE(info));
-
-		nrf_rpc_encode_uint(&rsp_ctx, info.uuid);
-		nrf_rpc_encode_uint(&rsp_ctx, info.reason);
-		nrf_rpc_encode_uint(&rsp_ctx, info.pc);
-		nrf_rpc_encode_uint(&rsp_ctx, info.lr);
-		nrf_rpc_encode_uint(&rsp_ctx, info.sp);
-		nrf_rpc_encode_uint(&rsp_ctx, info.xpsr);
-		nrf_rpc_encode_uint(&rsp_ctx, info.assert_line);
-		nrf_rpc_encode_str(&rsp_ctx, info.assert_filename, -1);
+		NRF_RPC_CBOR_ALLOC(group, rsp_ctx, NRF_RPC_SCHEMA_SIZE_MAX(log_rpc_crash_info));
+
+		if (!log_rpc_crash_info_encode(&rsp_ctx, &info)) {
+			nrf_rpc_encoder_invalid(&rsp_ctx);
+		}
 	}
 
 	nrf_rpc_cbor_rsp_no_err(group, &rsp_ctx);
@@ -319,15 +319,10 @@ int log_rpc_get_crash_info(struct nrf_rpc_crash_info *info)
 		goto out;
 	}
 
-	info->uuid = nrf_rpc_decode_uint(&ctx);
-	info->reason = nrf_rpc_decode_uint(&ctx);
-	info->pc = nrf_rpc_decode_uint(&ctx);
-	info->lr = nrf_rpc_decode_uint(&ctx);
-	info->sp = nrf_rpc_decode_uint(&ctx);
-	info->xpsr = nrf_rpc_decode_uint(&ctx);
-	info->assert_line = nrf_rpc_decode_uint(&ctx);
-
-	nrf_rpc_decode_str(&ctx, info->assert_filename, sizeof(info->assert_filename));
+	if (!log_rpc_crash_info_decode(&ctx, info)) {
+		nrf_rpc_decoder_invalid(&ctx, ZCBOR_ERR_UNKNOWN);
+		result = -EBADMSG;
+	}
 
 out:
 	if (!nrf_rpc_decoding_done_and_check(&log_rpc_group, &ctx)) {
@@ -7,7 +7,9 @@
 #ifndef LOG_RPC_INTERNAL_H_
 #define LOG_RPC_INTERNAL_H_
 
+#include <logging/log_rpc.h>
 #include <nrf_rpc.h>
+#include <nrf_rpc/nrf_rpc_schema.h>
 #include <zephyr/device.h>
 
 #ifdef CONFIG_NRF_RPC_IPC_SERVICE
@@ -52,6 +54,18 @@ enum log_rpc_cmd_backend {
 	LOG_RPC_CMD_GET_CRASH_INFO,
 };
 
+#define LOG_RPC_CRASH_INFO_SCHEMA(X)                                                               \
+	X(UINT, uuid)                                                                              \
+	X(UINT, reason)                                                                            \
+	X(UINT, pc)                                                                                \
+	X(UINT, lr)                                                                                \
+	X(UINT, sp)                                                                                \
+	X(UINT, xpsr)                                                                              \
+	X(UINT, assert_line)                                                                       \
+	X(STR, assert_filename)
+
+NRF_RPC_SCHEMA_DEFINE(log_rpc_crash_info, struct nrf_rpc_crash_info, LOG_RPC_CRASH_INFO_SCHEMA);
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,35 @@ LOG_MODULE_DECLARE(downloader, CONFIG_DOWNLOADER_LOG_LEVEL);
 #define COAP_DEFAULT_MAX_RETRANSMISSION 4
 #define COAP_DEFAULT_MAX_RECONNECTS	3
 
+/* Smallest block size used when the block size is adapted to packet loss */
+#define COAP_WINDOW_MIN_BLOCK_SIZE COAP_BLOCK_64
+/* Room for the CoAP header and options of a response, in addition to the block */
+#define COAP_WINDOW_HEADER_SIZE 128
+
+enum coap_window_slot_state {
+	COAP_WINDOW_SLOT_FREE,
+	COAP_WINDOW_SLOT_SENT,
+	COAP_WINDOW_SLOT_RECEIVED,
+};
+
+/** Block request in flight, or block received out of order. */
+struct coap_window_slot {
+	/** Offset of the block. */
+	uint32_t offset;
+	/** Time the request was last sent. */
+	uint32_t t0;
+	/** Message ID of the request. */
+	uint16_t id;
+	/** Length of the received block. */
+	uint16_t len;
+	/** Block size of the request. */
+	uint8_t szx;
+	/** Number of retransmissions. */
+	uint8_t retries;
+	/** Slot state. */
+	uint8_t state;
+};
+
 struct transport_params_coap {
 	/** Flag whether config is set */
 	bool cfg_set;
@@ -76,6 +105,22 @@ struct transport_params_coap {
 	const char *proxy_uri;
 	/* Client auth callback */
 	int (*auth_cb)(int sock);
+
+	/** Windowed block-wise transfer, used when several blocks are requested at once. */
+	struct {
+		/** Block requests in flight and blocks received out of order. */
+		struct coap_window_slot slots[CONFIG_DOWNLOADER_TRANSPORT_COAP_WINDOW];
+		/** Number of slots in use, zero when blocks are requested one at a time. */
+		uint8_t size;
+		/** Block size of the next request. */
+		uint8_t szx;
+		/** Blocks received since the block size was last changed. */
+		uint8_t successes;
+		/** Size of the reordering area at the start of the buffer. */
+		uint16_t ring_size;
+		/** Offset of the next block to request. */
+		uint32_t next_req;
+	} window;
 };
 
 BUILD_ASSERT(CONFIG_DOWNLOADER_TRANSPORT_PARAMS_SIZE >= sizeof(struct transport_params_coap));
@@ -292,26 +337,19 @@ static int coap_parse(struct downloader *dl, size_t len)
 	return 0;
 }
 
-static int coap_request_send(struct downloader *dl)
+static int coap_request_build(struct downloader *dl, struct coap_packet *request, uint8_t *buf,
+			      size_t size, uint16_t id, struct coap_block_context *block_ctx)
 {
 	int err;
-	uint16_t id;
 	char file[FILENAME_SIZE];
 	char *path_elem;
 	char *path_elem_saveptr;
-	struct coap_packet request;
 	struct transport_params_coap *coap;
 
 	coap = (struct transport_params_coap *)dl->transport_internal;
 
-	if (has_pending(dl)) {
-		id = coap->pending.id;
-	} else {
-		id = coap_next_id();
-	}
-
-	err = coap_packet_init(&request, dl->cfg.buf, dl->cfg.buf_size, COAP_VER,
-			       COAP_TYPE_CON, 8, coap_next_token(), COAP_METHOD_GET, id);
+	err = coap_packet_init(request, buf, size, COAP_VER, COAP_TYPE_CON, 8, coap_next_token(),
+			       COAP_METHOD_GET, id);
 	if (err) {
 		LOG_ERR("Failed to init CoAP message, err %d", err);
 		return err;
@@ -322,7 +360,7 @@ static int coap_request_send(struct downloader *dl)
 
 	path_elem = strtok_r(file, COAP_PATH_ELEM_DELIM, &path_elem_saveptr);
 	do {
-		err = coap_packet_append_option(&request, COAP_OPTION_URI_PATH, path_elem,
+		err = coap_packet_append_option(request, COAP_OPTION_URI_PATH, path_elem,
 						strlen(path_elem));
 		if (err) {
 			LOG_ERR("Unable add option to request");
@@ -330,20 +368,20 @@ static int coap_request_send(struct downloader *dl)
 		}
 	} while ((path_elem = strtok_r(NULL, COAP_PATH_ELEM_DELIM, &path_elem_saveptr)));
 
-	err = coap_append_block2_option(&request, &coap->block_ctx);
+	err = coap_append_block2_option(request, block_ctx);
 	if (err) {
 		LOG_ERR("Unable to add block2 option");
 		return err;
 	}
 
-	err = coap_append_size2_option(&request, &coap->block_ctx);
+	err = coap_append_size2_option(request, block_ctx);
 	if (err) {
 		LOG_ERR("Unable to add size2 option");
 		return err;
 	}
 
 	if (coap->proxy_uri != NULL) {
-		err = coap_packet_append_option(&request, COAP_OPTION_PROXY_URI,
+		err = coap_packet_append_option(request, COAP_OPTION_PROXY_URI,
 			coap->proxy_uri, strlen(coap->proxy_uri));
 		if (err) {
 			LOG_ERR("Unable to add Proxy-URI option");
@@ -351,6 +389,29 @@ static int coap_request_send(struct downloader *dl)
 		}
 	}
 
+	return 0;
+}
+
+static int coap_request_send(struct downloader *dl)
+{
+	int err;
+	uint16_t id;
+	struct coap_packet request;
+	struct transport_params_coap *coap;
+
+	coap = (struct transport_params_coap *)dl->transport_internal;
+
+	if (has_pending(dl)) {
+		id = coap->pending.id;
+	} else {
+		id = coap_next_id();
+	}
+
+	err = coap_request_build(dl, &request, dl->cfg.buf, dl->cfg.buf_size, id, &coap->block_ctx);
+	if (err) {
+		return err;
+	}
+
 	if (!has_pending(dl)) {
 		struct coap_transmission_parameters params = coap_get_transmission_parameters();
 
@@ -383,6 +444,438 @@ static int coap_request_send(struct downloader *dl)
 	return 0;
 }
 
+/* Windowed block-wise transfer.
+ *
+ * Several Block2 requests are kept in flight, each with its own message ID. Blocks that
+ * arrive ahead of the download progress are stored in a reordering area at the start of the
+ * buffer, at the block offset modulo the area size, and are passed on in order. The area
+ * holds a whole number of the largest blocks, and blocks are aligned to their size, so a
+ * block never wraps around. The remainder of the buffer holds the requests and responses.
+ *
+ * Requests that time out are retransmitted and decrease the block size of the next
+ * requests; the block size grows back after a couple of windows without loss.
+ */
+static void coap_window_init(struct downloader *dl)
+{
+	struct transport_params_coap *coap;
+	size_t block;
+	size_t slots = 0;
+
+	coap = (struct transport_params_coap *)dl->transport_internal;
+
+	memset(&coap->window, 0, sizeof(coap->window));
+
+	if (coap->cfg.window < 2) {
+		return;
+	}
+
+	block = coap_block_size_to_bytes(coap->cfg.block_size);
+	if (dl->cfg.buf_size > block + COAP_WINDOW_HEADER_SIZE) {
+		slots = (dl->cfg.buf_size - block - COAP_WINDOW_HEADER_SIZE) / block;
+	}
+
+	slots = MIN(slots, coap->cfg.window);
+	if (slots < 2) {
+		LOG_WRN("Buffer too small for a window of %u blocks, requesting one at a time",
+			coap->cfg.window);
+		return;
+	}
+
+	/* Resume with the largest block size the progress is aligned to */
+	coap->window.szx = coap->cfg.block_size;
+	while (coap->window.szx > COAP_BLOCK_16 &&
+	       dl->progress % coap_block_size_to_bytes(coap->window.szx)) {
+		coap->window.szx--;
+	}
+
+	if (dl->progress % coap_block_size_to_bytes(coap->window.szx)) {
+		LOG_WRN("Offset %u not aligned to a block, requesting one at a time", dl->progress);
+		return;
+	}
+
+	coap->window.size = slots;
+	coap->window.ring_size = slots * block;
+	coap->window.next_req = dl->progress;
+
+	LOG_DBG("CoAP window of %u blocks", coap->window.size);
+}
+
+static uint32_t coap_window_slot_timeout(const struct coap_window_slot *slot)
+{
+	return coap_get_transmission_parameters().ack_timeout << slot->retries;
+}
+
+static int coap_window_request_send(struct downloader *dl, struct coap_window_slot *slot)
+{
+	int err;
+	struct coap_packet request;
+	struct transport_params_coap *coap;
+	struct coap_block_context block_ctx = {
+		.block_size = slot->szx,
+		.current = slot->offset,
+	};
+
+	coap = (struct transport_params_coap *)dl->transport_internal;
+
+	err = coap_request_build(dl, &request, dl->cfg.buf + coap->window.ring_size,
+				 dl->cfg.buf_size - coap->window.ring_size, slot->id, &block_ctx);
+	if (err) {
+		return err;
+	}
+
+	LOG_DBG("CoAP block request %u, %u bytes, retry %u", slot->offset,
+		coap_block_size_to_bytes(slot->szx), slot->retries);
+
+	err = dl_socket_send_timeout_set(coap->sock.fd, coap_window_slot_timeout(slot));
+	if (err) {
+		return err;
+	}
+
+	err = dl_socket_send(coap->sock.fd, request.data, request.offset);
+	if (err) {
+		LOG_ERR("Failed to send CoAP request, errno %d", errno);
+		return err;
+	}
+
+	if (IS_ENABLED(CONFIG_DOWNLOADER_LOG_HEADERS)) {
+		LOG_HEXDUMP_DBG(request.data, request.offset, "CoAP request");
+	}
+
+	slot->t0 = k_uptime_get_32();
+
+	return 0;
+}
+
+static bool coap_window_busy(struct transport_params_coap *coap)
+{
+	for (size_t i = 0; i < coap->window.size; i++) {
+		if (coap->window.slots[i].state != COAP_WINDOW_SLOT_FREE) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int coap_window_fill(struct downloader *dl)
+{
+	int err;
+	size_t block;
+	struct coap_window_slot *slot;
+	struct transport_params_coap *coap;
+
+	coap = (struct transport_params_coap *)dl->transport_internal;
+
+	for (size_t i = 0; i < coap->window.size; i++) {
+		slot = &coap->window.slots[i];
+		if (slot->state != COAP_WINDOW_SLOT_FREE) {
+			continue;
+		}
+
+		if (dl->file_size == 0) {
+			/* Request one block at a time until the server tells the size */
+			if (coap_window_busy(coap)) {
+				break;
+			}
+		} else if (coap->window.next_req >= dl->file_size) {
+			break;
+		}
+
+		block = coap_block_size_to_bytes(coap->window.szx);
+		if (coap->window.next_req + block - dl->progress > coap->window.ring_size) {
+			/* No room for the block if it arrives out of order */
+			break;
+		}
+
+		slot->offset = coap->window.next_req;
+		slot->szx = coap->window.szx;
+		slot->id = coap_next_id();
+		slot->len = 0;
+		slot->retries = 0;
+		slot->state = COAP_WINDOW_SLOT_SENT;
+
+		err = coap_window_request_send(dl, slot);
+		if (err) {
+			return err;
+		}
+
+		coap->window.next_req += block;
+	}
+
+	return 0;
+}
+
+static void coap_window_loss(struct transport_params_coap *coap,
+			     const struct coap_window_slot *slot)
+{
+	coap->window.successes = 0;
+
+	/* Decrease the block size once per window, requests that were sent before the last
+	 * decrease are likely lost for the same reason.
+	 */
+	if (slot->szx >= coap->window.szx && coap->window.szx > COAP_WINDOW_MIN_BLOCK_SIZE) {
+		coap->window.szx--;
+		LOG_DBG("Block lost, block size decreased to %u",
+			coap_block_size_to_bytes(coap->window.szx));
+	}
+}
+
+static void coap_window_success(struct transport_params_coap *coap)
+{
+	if (coap->window.successes < UINT8_MAX) {
+		coap->window.successes++;
+	}
+
+	/* The block size can only grow at an offset that is aligned to the larger size */
+	if (coap->window.successes >= coap->window.size &&
+	    coap->window.szx < coap->cfg.block_size &&
+	    coap->window.next_req % coap_block_size_to_bytes(coap->window.szx + 1) == 0) {
+		coap->window.szx++;
+		coap->window.successes = 0;
+		LOG_DBG("No blocks lost, block size increased to %u",
+			coap_block_size_to_bytes(coap->window.szx));
+	}
+}
+
+/* Retransmit the requests that have timed out, and return the time until the next one does. */
+static int coap_window_retransmit(struct downloader *dl, uint32_t *timeout)
+{
+	int err;
+	uint32_t elapsed;
+	uint32_t slot_timeout;
+	struct coap_window_slot *slot;
+	struct transport_params_coap *coap;
+
+	coap = (struct transport_params_coap *)dl->transport_internal;
+
+	*timeout = UINT32_MAX;
+
+	for (size_t i = 0; i < coap->window.size; i++) {
+		slot = &coap->window.slots[i];
+		if (slot->state != COAP_WINDOW_SLOT_SENT) {
+			continue;
+		}
+
+		slot_timeout = coap_window_slot_timeout(slot);
+		elapsed = k_uptime_get_32() - slot->t0;
+		if (elapsed < slot_timeout) {
+			*timeout = MIN(*timeout, slot_timeout - elapsed);
+			continue;
+		}
+
+		if (slot->retries >= coap->cfg.max_retransmission) {
+			LOG_ERR("CoAP max-retransmissions exceeded");
+			return -ECONNRESET;
+		}
+
+		slot->retries++;
+		coap_window_loss(coap, slot);
+
+		err = coap_window_request_send(dl, slot);
+		if (err) {
+			LOG_DBG("coap_window_request_send failed, err %d", err);
+			return -ECONNRESET;
+		}
+
+		*timeout = MIN(*timeout, coap_window_slot_timeout(slot));
+	}
+
+	return 0;
+}
+
+/* Pass on the stored blocks that follow the download progress. */
+static void coap_window_deliver(struct downloader *dl)
+{
+	bool delivered;
+	struct coap_window_slot *slot;
+	struct transport_params_coap *coap;
+
+	coap = (struct transport_params_coap *)dl->transport_internal;
+
+	do {
+		delivered = false;
+
+		for (size_t i = 0; i < coap->window.size; i++) {
+			slot = &coap->window.slots[i];
+			if (slot->state != COAP_WINDOW_SLOT_RECEIVED || slot->offset != dl->progress) {
+				continue;
+			}
+
+			dl->progress += slot->len;
+			slot->state = COAP_WINDOW_SLOT_FREE;
+			dl_transport_evt_data(dl, dl->cfg.buf + slot->offset % coap->window.ring_size,
+					      slot->len);
+			delivered = true;
+		}
+	} while (delivered);
+}
+
+static int coap_window_parse(struct downloader *dl, uint8_t *buf, size_t len)
+{
+	int err;
+	int block;
+	int size2;
+	uint32_t offset;
+	uint16_t id;
+	uint8_t response_code;
+	uint16_t payload_len;
+	const uint8_t *payload;
+	struct coap_packet response;
+	struct coap_window_slot *slot = NULL;
+	struct transport_params_coap *coap;
+
+	coap = (struct transport_params_coap *)dl->transport_internal;
+
+	/* Unexpected responses are dropped, the request is retransmitted when it times out */
+	err = coap_packet_parse(&response, buf, len, NULL, 0);
+	if (err) {
+		LOG_WRN("Failed to parse CoAP packet, err %d", err);
+		return 0;
+	}
+
+	id = coap_header_get_id(&response);
+	for (size_t i = 0; i < coap->window.size; i++) {
+		if (coap->window.slots[i].state == COAP_WINDOW_SLOT_SENT &&
+		    coap->window.slots[i].id == id) {
+			slot = &coap->window.slots[i];
+			break;
+		}
+	}
+
+	if (!slot) {
+		/* Duplicate, or response to a request that was dropped from the window */
+		LOG_DBG("Response %u is not pending", id);
+		return 0;
+	}
+
+	if (coap_header_get_type(&response) != COAP_TYPE_ACK) {
+		LOG_WRN("Response must be of coap type ACK");
+		return 0;
+	}
+
+	response_code = coap_header_get_code(&response);
+	if (response_code != COAP_RESPONSE_CODE_CONTENT) {
+		/* Definitive answer from the server, see coap_parse() */
+		LOG_ERR("Server responded with code 0x%x", response_code);
+		return -ECONNREFUSED;
+	}
+
+	block = coap_get_option_int(&response, COAP_OPTION_BLOCK2);
+	if (block < 0) {
+		LOG_WRN("No block2 option in response");
+		return 0;
+	}
+
+	payload = coap_packet_get_payload(&response, &payload_len);
+	if (!payload) {
+		LOG_WRN("No CoAP payload!");
+		return 0;
+	}
+
+	offset = GET_BLOCK_NUM(block) << (GET_BLOCK_SIZE(block) + 4);
+	if (offset != slot->offset ||
+	    payload_len > coap_block_size_to_bytes(slot->szx) ||
+	    (GET_MORE(block) && payload_len != coap_block_size_to_bytes(GET_BLOCK_SIZE(block)))) {
+		LOG_WRN("Unexpected block %u of %u bytes, expected %u", offset, payload_len,
+			slot->offset);
+		return 0;
+	}
+
+	size2 = coap_get_option_int(&response, COAP_OPTION_SIZE2);
+	if (dl->file_size == 0 && size2 > 0) {
+		LOG_DBG("Total size: %d", size2);
+		dl->file_size = size2;
+	}
+
+	if (!GET_MORE(block)) {
+		LOG_DBG("Last block received");
+		dl->file_size = offset + payload_len;
+	} else if (payload_len < coap_block_size_to_bytes(slot->szx)) {
+		/* The server uses a smaller block size. Drop the requests that follow this
+		 * block from the window, and request the rest of the file in smaller blocks.
+		 */
+		LOG_DBG("Server block size %u", payload_len);
+
+		for (size_t i = 0; i < coap->window.size; i++) {
+			if (coap->window.slots[i].offset > offset) {
+				coap->window.slots[i].state = COAP_WINDOW_SLOT_FREE;
+			}
+		}
+
+		coap->window.next_req = offset + payload_len;
+		coap->window.szx = MIN(coap->window.szx, GET_BLOCK_SIZE(block));
+		coap->window.successes = 0;
+	}
+
+	/* Forward progress was made, reset the reconnect budget. */
+	coap->reconnects = 0;
+	coap_window_success(coap);
+
+	if (offset == dl->progress) {
+		dl->progress += payload_len;
+		slot->state = COAP_WINDOW_SLOT_FREE;
+		dl_transport_evt_data(dl, (void *)payload, payload_len);
+		coap_window_deliver(dl);
+	} else {
+		LOG_DBG("Block %u received out of order, expected %u", offset, dl->progress);
+		memcpy(dl->cfg.buf + offset % coap->window.ring_size, payload, payload_len);
+		slot->len = payload_len;
+		slot->state = COAP_WINDOW_SLOT_RECEIVED;
+	}
+
+	return 0;
+}
+
+static int coap_window_download(struct downloader *dl)
+{
+	int ret, len;
+	uint32_t timeout;
+	struct transport_params_coap *coap;
+
+	coap = (struct transport_params_coap *)dl->transport_internal;
+
+	ret = coap_window_fill(dl);
+	if (ret) {
+		LOG_DBG("data_req failed, err %d", ret);
+		/** Attempt reconnection. */
+		return ret;
+	}
+
+	ret = coap_window_retransmit(dl, &timeout);
+	if (ret) {
+		return ret;
+	}
+
+	/* A timeout of zero would block */
+	ret = dl_socket_recv_timeout_set(coap->sock.fd, MAX(timeout, 1));
+	if (ret) {
+		LOG_DBG("Failed to set CoAP recv timeout, err %d", ret);
+		return ret;
+	}
+
+	len = dl_socket_recv(coap->sock.fd, dl->cfg.buf + coap->window.ring_size,
+			     dl->cfg.buf_size - coap->window.ring_size);
+	if (len < 0) {
+		if ((len == -ETIMEDOUT) || (len == -EWOULDBLOCK) || (len == -EAGAIN)) {
+			/* Retransmitted on the next call */
+			return 0;
+		}
+
+		return len;
+	}
+
+	ret = coap_window_parse(dl, dl->cfg.buf + coap->window.ring_size, len);
+	if (ret) {
+		return ret;
+	}
+
+	if (dl->progress == dl->file_size) {
+		dl->complete = true;
+	}
+
+	return 0;
+}
+
 static bool dl_coap_proto_supported(struct downloader *dl, const char *url)
 {
 	if (strncmp(url, COAPS, (sizeof(COAPS) - 1)) == 0) {
@@ -416,6 +909,12 @@ static int dl_coap_init(struct downloader *dl, struct downloader_host_cfg *dl_ho
 		coap->cfg.max_retransmission = COAP_DEFAULT_MAX_RETRANSMISSION;
 	}
 
+	if (coap->cfg.window == 0) {
+		coap->cfg.window = CONFIG_DOWNLOADER_TRANSPORT_COAP_WINDOW;
+	}
+
+	coap->cfg.window = MIN(coap->cfg.window, CONFIG_DOWNLOADER_TRANSPORT_COAP_WINDOW);
+
 	/* A value of 0 (e.g. from a config that predates this field) selects the
 	 * default so that there is always an upper bound on retries.
 	 */
@@ -508,6 +1007,7 @@ static int dl_coap_connect(struct downloader *dl)
 	}
 
 	coap_block_init(dl, dl->progress);
+	coap_window_init(dl);
 
 cleanup:
 	if (err) {
@@ -548,6 +1048,10 @@ static int dl_coap_download(struct downloader *dl)
 
 	coap = (struct transport_params_coap *)dl->transport_internal;
 
+	if (coap->window.size) {
+		return coap_window_download(dl);
+	}
+
 	if (coap->new_data_req) {
 		/* Request next fragment */
 		dl->buf_offset = 0;
@@ -4,10 +4,10 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
-#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/__assert.h>
@@ -32,6 +32,11 @@ LOG_MODULE_DECLARE(downloader, CONFIG_DOWNLOADER_LOG_LEVEL);
 #define DEFAULT_PORT_TLS 443
 #define DEFAULT_PORT_TCP 80
 
+/* Upper limit of CONFIG_DOWNLOADER_TRANSPORT_HTTP_PIPELINE_DEPTH, req_pending counts up to it */
+#define PIPELINE_DEPTH_MAX 8
+
+BUILD_ASSERT(CONFIG_DOWNLOADER_TRANSPORT_HTTP_PIPELINE_DEPTH <= PIPELINE_DEPTH_MAX);
+
 #define HTTP_RESPONSE_OK 200
 #define HTTP_RESPONSE_PARTIAL_CONTENT 206
 #define HTTP_RESPONSE_MOVED_PERMANENTLY 301
@@ -80,12 +85,22 @@ struct transport_params_http {
 	bool ranged;
 	/** Ranged progress */
 	size_t ranged_progress;
+	/** Offset of the next range to request */
+	size_t req_offset;
+	/** Number of range requests sent whose response is not fully received */
+	uint8_t req_pending;
+	/** The buffer holds data of the next pipelined response, process it before receiving. */
+	bool buffered;
 	/** HTTP header */
 	struct {
-		/** Header length */
-		size_t hdr_len;
 		/** Status code */
 		unsigned long status_code;
+		/** Number of bytes of the incomplete line at the start of the buffer
+		 * that have already been scanned for the end of line.
+		 */
+		size_t line_scanned;
+		/** Whether the status line has been parsed. */
+		bool has_status;
 		/** Whether the HTTP header for
 		 * the current fragment has been processed.
 		 */
@@ -113,48 +128,127 @@ struct transport_params_http {
 
 BUILD_ASSERT(CONFIG_DOWNLOADER_TRANSPORT_PARAMS_SIZE >= sizeof(struct transport_params_http));
 
-/* Include size flavour of strstr for safety. */
-#if defined(CONFIG_EXTERNAL_LIBC)
-/* Pull in memmem and strnstr due to being an extension to the C library and
- * not included by default.
+static int parse_protocol(struct downloader *dl, const char *url);
+
+static void http_header_reset(struct transport_params_http *http)
+{
+	memset(&http->header, 0, sizeof(http->header));
+}
+
+static int http_request_send(struct downloader *dl, char *req, int len, size_t req_size)
+{
+	int err;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	if (len < 0 || (size_t)len >= req_size) {
+		LOG_ERR("Cannot create GET request, buffer too small");
+		return -ENOMEM;
+	}
+
+	if (IS_ENABLED(CONFIG_DOWNLOADER_LOG_HEADERS)) {
+		LOG_HEXDUMP_DBG(req, len, "HTTP request");
+	}
+
+	LOG_DBG("http request:\n%s", req);
+
+	err = dl_socket_send(http->sock.fd, req, len);
+	if (err) {
+		LOG_ERR("Failed to send HTTP request, errno %d", errno);
+		return err;
+	}
+
+	return 0;
+}
+
+/* Request the range starting at req_offset. The request is built in the unused part of the
+ * buffer, after the received data that has not been processed yet.
  */
-extern void *memmem(const void *haystack, size_t hs_len, const void *needle, size_t ne_len);
-extern size_t strnlen(const char *s, size_t maxlen);
-static char *strnstr(const char *haystack, const char *needle, size_t haystack_len)
+static int http_range_request_send(struct downloader *dl)
 {
-	char *x;
+	int err;
+	int len;
+	size_t off;
+	char *req = dl->cfg.buf + dl->buf_offset;
+	size_t req_size = dl->cfg.buf_size - dl->buf_offset;
+	struct transport_params_http *http;
 
-	if (!haystack || !needle) {
-		return NULL;
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	off = http->req_offset + dl->host_cfg.range_override - 1;
+
+	if (dl->file_size) {
+		/* Don't request bytes past the end of file */
+		off = MIN(off, dl->file_size - 1);
 	}
-	size_t needle_len = strnlen(needle, haystack_len);
 
-	if (needle_len < haystack_len || !needle[needle_len]) {
-		x = memmem(haystack, haystack_len, needle, needle_len);
-		if (x && !memchr(haystack, 0, x - haystack)) {
-			return x;
-		}
+	len = snprintf(req, req_size, HTTP_GET_RANGE, dl->file, dl->hostname, http->req_offset,
+		       off);
+	if (dl->buf_offset && (len < 0 || (size_t)len >= req_size)) {
+		/* Not enough room after the received data, send it later */
+		return -ENOMEM;
 	}
 
-	return NULL;
+	err = http_request_send(dl, req, len, req_size);
+	if (err) {
+		return err;
+	}
+
+	LOG_DBG("Range request up to %d bytes", dl->host_cfg.range_override);
+
+	http->req_offset = off + 1;
+	http->req_pending++;
+
+	return 0;
 }
-#else
-extern char *strnstr(const char *haystack, const char *needle, size_t haystack_sz);
-#endif
 
-static int parse_protocol(struct downloader *dl, const char *url);
+/* Keep up to pipeline_depth range requests in flight. The requests following the first one
+ * are sent once the file size is known, so that no bytes past the end of file are requested.
+ */
+static void http_pipeline_fill(struct downloader *dl)
+{
+	int err;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	while (http->ranged && !http->new_data_req && !http->connection_close && dl->file_size &&
+	       http->req_pending < http->cfg.pipeline_depth &&
+	       http->req_offset < dl->file_size) {
+		err = http_range_request_send(dl);
+		if (err) {
+			/* Retried when the next response is received */
+			LOG_DBG("Pipelined range request not sent, err %d", err);
+			break;
+		}
+	}
+}
+
+/* Number of bytes left to receive in the current range response. */
+static size_t http_range_left(struct downloader *dl)
+{
+	size_t range_start;
+	size_t range_len;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	range_start = dl->progress - http->ranged_progress;
+	range_len = MIN(dl->host_cfg.range_override, dl->file_size - range_start);
+
+	return range_len - http->ranged_progress;
+}
 
 static int http_get_request_send(struct downloader *dl)
 {
-	int err;
 	int len;
-	size_t off = 0;
 	bool tls_force_range;
 	struct transport_params_http *http;
 
 	http = (struct transport_params_http *)dl->transport_internal;
 
-	http->header.has_end = false;
+	http_header_reset(http);
 
 	/* nRF91 series has a limitation of decoding ~2k of data at once when using TLS */
 	tls_force_range = (http->sock.proto == NET_IPPROTO_TLS_1_2 &&
@@ -169,19 +263,13 @@ static int http_get_request_send(struct downloader *dl)
 	}
 
 	if (dl->host_cfg.range_override) {
-		off = dl->progress + dl->host_cfg.range_override - 1;
-
-		if (dl->file_size) {
-			/* Don't request bytes past the end of file */
-			off = MIN(off, dl->file_size - 1);
-		}
-
-		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET_RANGE, dl->file,
-			       dl->hostname, dl->progress, off);
 		http->ranged = true;
 		http->ranged_progress = 0;
-		LOG_DBG("Range request up to %d bytes", dl->host_cfg.range_override);
-		goto send;
+		http->req_offset = dl->progress;
+		http->req_pending = 0;
+		http->buffered = false;
+
+		return http_range_request_send(dl);
 	} else if (dl->progress) {
 		len = snprintf(dl->cfg.buf, dl->cfg.buf_size, HTTP_GET_OFFSET, dl->file,
 			       dl->hostname, dl->progress);
@@ -192,225 +280,214 @@ static int http_get_request_send(struct downloader *dl)
 		http->ranged = false;
 	}
 
-send:
-	if (len < 0 || len > dl->cfg.buf_size) {
-		LOG_ERR("Cannot create GET request, buffer too small");
-		return -ENOMEM;
-	}
+	return http_request_send(dl, dl->cfg.buf, len, dl->cfg.buf_size);
+}
 
-	if (IS_ENABLED(CONFIG_DOWNLOADER_LOG_HEADERS)) {
-		LOG_HEXDUMP_DBG(dl->cfg.buf, len, "HTTP request");
+static bool http_status_is_redirect(unsigned long status_code)
+{
+	return status_code == HTTP_RESPONSE_MOVED_PERMANENTLY ||
+	       status_code == HTTP_RESPONSE_FOUND ||
+	       status_code == HTTP_RESPONSE_SEE_OTHER ||
+	       status_code == HTTP_RESPONSE_TEMPORARY_REDIRECT ||
+	       status_code == HTTP_RESPONSE_PERMANENT_REDIRECT;
+}
+
+static bool http_field_is(const char *name, size_t name_len, const char *field)
+{
+	return name_len == strlen(field) && strncasecmp(name, field, name_len) == 0;
+}
+
+static int http_redirect(struct downloader *dl, const char *location)
+{
+	int err;
+	struct transport_params_http *http;
+
+	http = (struct transport_params_http *)dl->transport_internal;
+
+	/* Resource is moved, update host and file before reconnecting. */
+	LOG_INF("Resource moved to %s", location);
+
+	err = parse_protocol(dl, location);
+	if (err) {
+		LOG_ERR("Failed to parse protocol, err %d, url %s", err, location);
+		return -EBADMSG;
 	}
 
-	LOG_DBG("http request:\n%s", dl->cfg.buf);
+	err = dl_parse_url_host(location, dl->hostname, sizeof(dl->hostname));
+	if (err) {
+		LOG_ERR("Failed to parse hostname, err %d, url %s", err, location);
+		return -EBADMSG;
+	}
 
-	err = dl_socket_send(http->sock.fd, dl->cfg.buf, len);
+	err = dl_parse_url_file(location, dl->file, sizeof(dl->file));
 	if (err) {
-		LOG_ERR("Failed to send HTTP request, errno %d", errno);
-		return err;
+		LOG_ERR("Failed to parse filename, err %d, url %s", err, location);
+		return -EBADMSG;
 	}
 
-	return 0;
+	http->redirects++;
+
+	if (http->redirects > dl->host_cfg.redirects_max) {
+		LOG_ERR("Maximum redirections reached, aborting");
+		return -EMLINK;
+	}
+
+	return -ECONNRESET;
 }
 
-/* Returns:
- * Number of bytes parsed on success.
- * Negative errno on error.
+/* Parse a single header line, without the line ending.
+ *
+ * Returns:
+ * Zero on success.
+ * Negative errno on error, or -ECONNRESET to follow a redirect.
  */
-static int http_header_parse(struct downloader *dl, size_t buf_len)
+static int http_header_line_parse(struct downloader *dl, char *line)
 {
-	int err;
+	char *value;
 	char *p;
-	char *q;
-	size_t parse_len;
-	unsigned int expected_status;
+	size_t name_len;
 	struct transport_params_http *http;
 
 	http = (struct transport_params_http *)dl->transport_internal;
 
-	LOG_HEXDUMP_DBG(dl->cfg.buf, buf_len, "(partial) http header response:");
+	if (!http->header.has_status) {
+		/* Look for the status code just after "HTTP/1.1 " */
+		http->header.has_status = true;
+		if (strncasecmp(line, "http/1.1 ", strlen("http/1.1 ")) == 0) {
+			http->header.status_code = strtoul(line + strlen("http/1.1 "), NULL, 10);
+		}
+		return 0;
+	}
 
-	p = strnstr(dl->cfg.buf, "\r\n\r\n", buf_len);
-	if (p) {
-		/* End of header received */
-		http->header.has_end = true;
-		parse_len = p + strlen("\r\n\r\n") - (char *)dl->cfg.buf;
-	} else {
-		parse_len = buf_len;
+	value = strchr(line, ':');
+	if (!value) {
+		/* Not a header field */
+		return 0;
+	}
+
+	name_len = value - line;
+
+	/* Skip optional whitespace after the colon (RFC 7230 OWS);
+	 * the value (URI) is matched as-is.
+	 */
+	value++;
+	while (*value == ' ' || *value == '\t') {
+		value++;
 	}
 
-	/* Convert HTTP headers to lowercase, but not the values (for example URI) */
-	bool value = false;
-	for (size_t i = 0; i < parse_len; i++) {
-		if (dl->cfg.buf[i] == '\r' || dl->cfg.buf[i] == '\n') {
-			value = false;
+	if (http_field_is(line, name_len, "location")) {
+		if (http_status_is_redirect(http->header.status_code)) {
+			return http_redirect(dl, value);
 		}
-		if (value) {
-			continue;
+	} else if (http_field_is(line, name_len, "content-range")) {
+		/* The file size is returned via "Content-Range" in case of range requests */
+		p = strchr(value, '/');
+		if (p && dl->file_size == 0 && http->ranged) {
+			dl->file_size = atoi(p + 1);
+			LOG_DBG("File size = %u", dl->file_size);
 		}
-		if (dl->cfg.buf[i] == ':') {
-			value = true;
-			continue;
+	} else if (http_field_is(line, name_len, "content-length")) {
+		/* and via "Content-Length" otherwise. Accumulate any eventual progress
+		 * (starting offset) when reading the file size from Content-Length.
+		 */
+		if (dl->file_size == 0 && !http->ranged) {
+			dl->file_size = dl->progress + atoi(value);
+			LOG_DBG("File size = %u", dl->file_size);
 		}
-		dl->cfg.buf[i] = tolower((unsigned char)dl->cfg.buf[i]);
-	}
-
-	/* Look for the status code just after "http/1.1 " */
-	p = strnstr(dl->cfg.buf, "http/1.1 ", parse_len);
-	if (p) {
-		q = strnstr(p, "\r\n", parse_len - (p - dl->cfg.buf));
-		if (q) {
-			/* Received entire line */
-			p += strlen("http/1.1 ");
-			http->header.status_code = strtoul(p, &q, 10);
+	} else if (http_field_is(line, name_len, "connection")) {
+		if (strncasecmp(value, "close", strlen("close")) == 0) {
+			LOG_WRN("Peer closed connection, will re-connect");
+			http->connection_close = true;
 		}
 	}
 
-	if (http->header.status_code == HTTP_RESPONSE_MOVED_PERMANENTLY ||
-	    http->header.status_code == HTTP_RESPONSE_FOUND ||
-	    http->header.status_code == HTTP_RESPONSE_SEE_OTHER ||
-	    http->header.status_code == HTTP_RESPONSE_TEMPORARY_REDIRECT ||
-	    http->header.status_code == HTTP_RESPONSE_PERMANENT_REDIRECT) {
-		/* Resource is moved, update host and file before reconnecting. */
-		p = strnstr(dl->cfg.buf, "\r\nlocation:", parse_len);
-		if (p) {
-			q = strnstr((p + 1), "\r\n", parse_len - ((p + 1) - dl->cfg.buf));
-			if (q) {
-
-				/* Received entire line */
-				p += strlen("\r\nlocation:");
-				*q = '\0';
-
-				/* Skip optional whitespace after the colon
-				 * (RFC 7230 OWS); the value (URI) is not
-				 * lowercased so it is matched as-is.
-				 */
-				while (*p == ' ' || *p == '\t') {
-					p++;
-				}
-
-				LOG_INF("Resource moved to %s", p);
+	return 0;
+}
 
-				err = parse_protocol(dl, p);
-				if (err) {
-					LOG_ERR("Failed to parse protocol, err %d, url %s", err, p);
-					return -EBADMSG;
-				}
+/* Parse the complete header lines in the buffer. The incomplete line at the end of the buffer
+ * is left for the next call, which only scans the bytes that have been received since.
+ *
+ * Returns:
+ * Number of bytes parsed on success.
+ * Negative errno on error.
+ */
+static int http_header_parse(struct downloader *dl, size_t buf_len)
+{
+	int err;
+	char *line;
+	char *eol;
+	char *end;
+	size_t line_len;
+	size_t scanned;
+	size_t parse_len;
+	unsigned int expected_status;
+	struct transport_params_http *http;
 
-				err = dl_parse_url_host(p, dl->hostname, sizeof(dl->hostname));
-				if (err) {
-					LOG_ERR("Failed to parse hostname, err %d, url %s", err, p);
-					return -EBADMSG;
-				}
+	http = (struct transport_params_http *)dl->transport_internal;
 
-				err = dl_parse_url_file(p, dl->file, sizeof(dl->file));
-				if (err) {
-					LOG_ERR("Failed to parse filename, err %d, url %s", err, p);
-					return -EBADMSG;
-				}
+	LOG_HEXDUMP_DBG(dl->cfg.buf, buf_len, "(partial) http header response:");
 
-				http->redirects++;
+	line = dl->cfg.buf;
+	end = dl->cfg.buf + buf_len;
+	scanned = MIN(http->header.line_scanned, buf_len);
 
-				if (http->redirects > dl->host_cfg.redirects_max) {
-					LOG_ERR("Maximum redirections reached, aborting");
-					return -EMLINK;
-				}
+	while (!http->header.has_end) {
+		eol = memchr(line + scanned, '\n', end - line - scanned);
+		if (!eol) {
+			break;
+		}
 
-				return -ECONNRESET;
-			}
+		scanned = 0;
+		line_len = eol - line;
+		if (line_len > 0 && line[line_len - 1] == '\r') {
+			line_len--;
 		}
-	}
+		line[line_len] = '\0';
 
-	/* The file size is returned via "Content-Length" in case of HTTP,
-	 * and via "Content-Range" in case of HTTPS with range requests.
-	 */
-	do {
-		if (dl->file_size == 0) {
-			if (http->ranged) {
-				p = strnstr(dl->cfg.buf, "\r\ncontent-range", parse_len);
-				if (!p) {
-					break;
-				}
-				p = strnstr(p, "/", parse_len - (p - dl->cfg.buf));
-				if (!p) {
-					break;
-				}
-				q = strnstr(p, "\r\n", parse_len - (p - dl->cfg.buf));
-				if (!q) {
-					/* Missing end of line */
-					break;
-				}
-			} else { /* proto == PROTO_HTTP */
-				p = strnstr(dl->cfg.buf, "\r\ncontent-length", parse_len);
-				if (!p) {
-					break;
-				}
-				p = strstr(p, ":");
-				if (!p) {
-					break;
-				}
-				q = strnstr(p, "\r\n", parse_len - (p - dl->cfg.buf));
-				if (!q) {
-					/* Missing end of line */
-					break;
-				}
-				/* Accumulate any eventual progress (starting offset)
-				 * when reading the file size from Content-Length
-				 */
-				dl->file_size = dl->progress;
+		if (line_len == 0) {
+			/* End of header received */
+			http->header.has_end = true;
+		} else {
+			err = http_header_line_parse(dl, line);
+			if (err) {
+				return err;
 			}
-
-			dl->file_size += atoi(p + 1);
-			LOG_DBG("File size = %u", dl->file_size);
 		}
-	} while (0);
 
-	p = strnstr(dl->cfg.buf, "\r\nconnection: close", parse_len);
-	if (p) {
-		LOG_WRN("Peer closed connection, will re-connect");
-		http->connection_close = true;
+		line = eol + 1;
 	}
 
-	if (http->header.has_end) {
-		/* We have received the end of the header.
-		 * Verify that we have received everything that we need.
-		 */
-
-		if (!http->header.status_code) {
-			LOG_ERR("Server response malformed: status code not found");
-			return -EBADMSG;
-		}
-
-		expected_status = (http->ranged || dl->progress) ? HTTP_RESPONSE_PARTIAL_CONTENT :
-								   HTTP_RESPONSE_OK;
-		if (http->header.status_code != expected_status) {
-			LOG_ERR("Unexpected HTTP response code %lu", http->header.status_code);
-			return -EBADMSG;
-		}
-
-		if (!dl->file_size) {
-			LOG_ERR("File size not set");
-			return -EBADMSG;
-		}
+	parse_len = line - dl->cfg.buf;
 
+	if (!http->header.has_end) {
+		/* We are still missing part of the header.
+		 * Return the lines (in number of bytes) that we have parsed.
+		 */
+		http->header.line_scanned = buf_len - parse_len;
 		return parse_len;
 	}
 
-	/* We are still missing part of the header.
-	 * Return the lines (in number of bytes) that we have parsed,
-	 * scanning backwards from the last received byte.
+	/* We have received the end of the header.
+	 * Verify that we have received everything that we need.
 	 */
-	q = dl->cfg.buf + buf_len - 1;
-	while (q > dl->cfg.buf && (*q != '\r') && (*q != '\n')) {
-		q--;
+	http->header.line_scanned = 0;
+
+	if (!http->header.status_code) {
+		LOG_ERR("Server response malformed: status code not found");
+		return -EBADMSG;
 	}
 
-	/* Keep \r and \n in the buffer in case it is part of the header ending. */
-	while (q > dl->cfg.buf && (*(q - 1) == '\r' || *(q - 1) == '\n')) {
-		q--;
+	expected_status = (http->ranged || dl->progress) ? HTTP_RESPONSE_PARTIAL_CONTENT :
+							   HTTP_RESPONSE_OK;
+	if (http->header.status_code != expected_status) {
+		LOG_ERR("Unexpected HTTP response code %lu", http->header.status_code);
+		return -EBADMSG;
 	}
 
-	parse_len = (q - dl->cfg.buf);
+	if (!dl->file_size) {
+		LOG_ERR("File size not set");
+		return -EBADMSG;
+	}
 
 	return parse_len;
 }
@@ -440,15 +517,12 @@ static int http_parse(struct downloader *dl, size_t len)
 			return parsed_len;
 		}
 
-		if (parsed_len == len) {
-			dl->buf_offset = 0;
-			return 0;
-		} else if (parsed_len) {
-			/* Keep remaining payload */
-			len = len - parsed_len;
+		/* Keep remaining payload */
+		len = len - parsed_len;
+		if (parsed_len && len) {
 			memmove(dl->cfg.buf, dl->cfg.buf + parsed_len, len);
-			dl->buf_offset = len;
 		}
+		dl->buf_offset = len;
 
 		if (!http->header.has_end) {
 			if (dl->cfg.buf_size == dl->buf_offset) {
@@ -537,6 +611,10 @@ static int dl_http_init(struct downloader *dl, struct downloader_host_cfg *dl_ho
 		http->cfg.sock_recv_timeo_ms = 30 * MSEC_PER_SEC;
 	}
 
+	if (http->cfg.pipeline_depth == 0) {
+		http->cfg.pipeline_depth = CONFIG_DOWNLOADER_TRANSPORT_HTTP_PIPELINE_DEPTH;
+	}
+
 	/* Reset all fields after the config. */
 	reset_ptr = (uint8_t *)&http->cfg + sizeof(http->cfg);
 	memset(reset_ptr,
@@ -609,6 +687,9 @@ static int dl_http_close(struct downloader *dl)
 static int dl_http_download(struct downloader *dl)
 {
 	int ret, recv_len, data_len, expected_len;
+	size_t range_left = 0;
+	size_t next_len = 0;
+	bool closed = false;
 	struct transport_params_http *http;
 
 	http = (struct transport_params_http *)dl->transport_internal;
@@ -628,31 +709,39 @@ static int dl_http_download(struct downloader *dl)
 
 	__ASSERT(dl->buf_offset < dl->cfg.buf_size, "Buffer overflow");
 
-	LOG_DBG("Receiving up to %d bytes at %p...", (dl->cfg.buf_size - dl->buf_offset),
-		(void *)(dl->cfg.buf + dl->buf_offset));
+	if (http->buffered) {
+		/* Start of the next pipelined response, received with the previous one. */
+		http->buffered = false;
+		recv_len = 0;
+	} else {
+		LOG_DBG("Receiving up to %d bytes at %p...", (dl->cfg.buf_size - dl->buf_offset),
+			(void *)(dl->cfg.buf + dl->buf_offset));
 
-	recv_len = dl_socket_recv(http->sock.fd, dl->cfg.buf + dl->buf_offset,
-			     dl->cfg.buf_size - dl->buf_offset);
+		recv_len = dl_socket_recv(http->sock.fd, dl->cfg.buf + dl->buf_offset,
+					  dl->cfg.buf_size - dl->buf_offset);
 
-	if (recv_len < 0) {
-		if (recv_len == -EMSGSIZE && dl->host_cfg.range_override) {
-			/* We do not have enough space for the http header and requested data,
-			 * reattempt with shorter range request.
-			 */
-			dl->host_cfg.range_override -=
-				((dl->host_cfg.range_override > 256) ? 128 : 8);
-			if (dl->host_cfg.range_override <= 8) {
-				return -EMSGSIZE;
+		if (recv_len < 0) {
+			if (recv_len == -EMSGSIZE && dl->host_cfg.range_override) {
+				/* We do not have enough space for the http header and requested
+				 * data, reattempt with shorter range request.
+				 */
+				dl->host_cfg.range_override -=
+					((dl->host_cfg.range_override > 256) ? 128 : 8);
+				if (dl->host_cfg.range_override <= 8) {
+					return -EMSGSIZE;
+				}
+				LOG_DBG("Message size too big, reattempting with range size %d",
+					dl->host_cfg.range_override);
+				return -ECONNRESET;
 			}
-			LOG_DBG("Message size too big, reattempting with range size %d",
-				dl->host_cfg.range_override);
-			return -ECONNRESET;
-		}
-		if (http->connection_close) {
-			return -ECONNRESET;
+			if (http->connection_close) {
+				return -ECONNRESET;
+			}
+
+			return recv_len;
 		}
 
-		return recv_len;
+		closed = (recv_len == 0);
 	}
 
 	data_len = http_parse(dl, recv_len + dl->buf_offset);
@@ -660,13 +749,30 @@ static int dl_http_download(struct downloader *dl)
 		return data_len;
 	}
 
-	expected_len = MIN(MIN_SIZE_IDENTIFY_BUF, dl->file_size - dl->progress);
+	if (!http->header.has_end) {
+		/* Wait for the rest of the header */
+		return closed ? -ECONNRESET : 0;
+	}
+
+	http_pipeline_fill(dl);
+
+	if (http->ranged) {
+		range_left = http_range_left(dl);
+		if (data_len > range_left) {
+			/* The rest of the buffer is the next pipelined response */
+			next_len = data_len - range_left;
+			data_len = range_left;
+		}
+		expected_len = MIN(MIN_SIZE_IDENTIFY_BUF, range_left);
+	} else {
+		expected_len = MIN(MIN_SIZE_IDENTIFY_BUF, dl->file_size - dl->progress);
+	}
 
 	if (data_len < expected_len) {
 		/* Wait for more data after the HTTP headers,
 		 * so we don't end up forwarding too small chunks to FOTA library.
 		 */
-		return recv_len > 0 ? 0 : -ECONNRESET; /* Fail if closed while expecting more */
+		return closed ? -ECONNRESET : 0; /* Fail if closed while expecting more */
 	}
 
 	/* Accumulate progress */
@@ -676,11 +782,16 @@ static int dl_http_download(struct downloader *dl)
 	}
 	if (http->ranged) {
 		http->ranged_progress += data_len;
-		if (http->ranged_progress < dl->host_cfg.range_override) {
-			/* Ranged query: read until a full fragment is received */
-		} else {
-			/* Ranged query: request next fragment */
-			http->new_data_req = true;
+		if (data_len == range_left) {
+			/* Ranged query: full fragment received, continue with the next response
+			 * in flight, or request the next fragment.
+			 */
+			http->ranged_progress = 0;
+			http->req_pending--;
+			http_header_reset(http);
+			if (http->req_pending == 0) {
+				http->new_data_req = true;
+			}
 		}
 	}
 	if (dl->progress == dl->file_size) {
@@ -688,13 +799,27 @@ static int dl_http_download(struct downloader *dl)
 		dl->complete = true;
 		http->new_data_req = true;
 	}
-	dl->buf_offset = 0;
+
+	if (next_len && !dl->complete && http->req_pending) {
+		memmove(dl->cfg.buf, dl->cfg.buf + data_len, next_len);
+		http->buffered = true;
+	} else {
+		next_len = 0;
+	}
+	dl->buf_offset = next_len;
 
 	if (dl->complete) {
 		return 0;
 	}
+
+	http_pipeline_fill(dl);
+
+	if (http->buffered) {
+		return 0;
+	}
+
 	/* Continue reading, unless connection is closed */
-	return recv_len > 0 ? 0 : -ECONNRESET;
+	return closed ? -ECONNRESET : 0;
 }
 
 static const struct dl_transport dl_transport_http = {
@@ -717,6 +842,12 @@ int downloader_transport_http_set_config(struct downloader *dl,
 		return -EINVAL;
 	}
 
+	if (cfg->pipeline_depth > PIPELINE_DEPTH_MAX) {
+		LOG_ERR("Pipeline depth %u out of range, max %d", cfg->pipeline_depth,
+			PIPELINE_DEPTH_MAX);
+		return -EINVAL;
+	}
+
 	http = (struct transport_params_http *)dl->transport_internal;
 	http->cfg_set = true;
 	http->cfg = *cfg;
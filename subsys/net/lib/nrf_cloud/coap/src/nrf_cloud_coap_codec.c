@@ -98,22 +98,9 @@ static int encode_message(struct nrf_cloud_obj_coap_cbor *msg, uint8_t *buf, siz
 			*len = out_len;
 		}
 	} else if (fmt == COAP_CONTENT_FORMAT_APP_JSON) {
-		struct nrf_cloud_data out;
-
-		err = nrf_cloud_encode_message(msg->app_id, msg->double_val, msg->str_val, NULL,
-					       msg->ts, &out);
-		if (err) {
-			*len = 0;
-		} else if (*len <= out.len) {
-			*len = 0;
-			cJSON_free((void *)out.ptr);
-			err = -E2BIG;
-		} else {
-			*len = out.len;
-			memcpy(buf, out.ptr, *len);
-			buf[*len - 1] = '\0';
-			cJSON_free((void *)out.ptr);
-		}
+		/* Written directly into the message buffer */
+		err = nrf_cloud_encode_message_buf(msg->app_id, msg->double_val, msg->str_val,
+						   NULL, msg->ts, (char *)buf, len);
 	} else {
 		err = -EINVAL;
 	}
@@ -65,7 +65,17 @@ int nrf_cloud_sensor_data_encode(const struct nrf_cloud_sensor_data *input,
 int nrf_cloud_encode_message(const char *app_id, double value, const char *str_val,
 			     const char *topic, int64_t ts, struct nrf_cloud_data *output);
 
-/** @brief Encode the sensor data to be sent to the device shadow. */
+/** @brief Encode the same message as @ref nrf_cloud_encode_message into the provided buffer,
+ *  without allocating memory. On input, len is the size of the buffer. On output, it is the
+ *  length of the null-terminated message.
+ *  Returns -E2BIG if the message does not fit in the buffer.
+ */
+int nrf_cloud_encode_message_buf(const char *app_id, double value, const char *str_val,
+				 const char *topic, int64_t ts, char *const buf, size_t *const len);
+
+/** @brief Encode the sensor data to be sent to the device shadow.
+ *  Returns -EBADMSG if the sensor data is not valid JSON.
+ */
 int nrf_cloud_shadow_data_encode(const struct nrf_cloud_sensor_data *sensor,
 				 struct nrf_cloud_data *output);
 
@@ -83,6 +93,16 @@ int nrf_cloud_state_encode(uint32_t reported_state, const bool update_desired_to
 int nrf_cloud_obj_shadow_delta_decode(struct nrf_cloud_obj *const shadow_obj,
 				      struct nrf_cloud_obj_shadow_delta *const delta);
 
+/** @brief Decode the delta shadow data from the received JSON document.
+ * Only the "state" object is parsed, the other items are read without parsing the document.
+ * Decoded data should be freed with @ref nrf_cloud_obj_shadow_delta_free.
+ * Returns -ENOTSUP if the delta contains an error, -ENOMSG if the document is malformed
+ * and -ENODEV if it has no "state" object. On any error, use
+ * @ref nrf_cloud_obj_shadow_delta_decode to decode the document.
+ */
+int nrf_cloud_shadow_delta_stream_decode(const struct nrf_cloud_data *const input,
+					 struct nrf_cloud_obj_shadow_delta *const delta);
+
 /** @brief Free the delta shadow data. */
 void nrf_cloud_obj_shadow_delta_free(struct nrf_cloud_obj_shadow_delta *const delta);
 
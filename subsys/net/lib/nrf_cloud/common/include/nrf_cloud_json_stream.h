@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_JSON_STREAM_H__
+#define NRF_CLOUD_JSON_STREAM_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting depth of objects and arrays supported by the writer */
+#define NRF_CLOUD_JSON_WRITER_DEPTH_MAX 16
+
+/** @brief Streaming JSON writer.
+ *
+ * Writes unformatted JSON directly into a caller-supplied buffer, without building a
+ * cJSON tree and without allocating memory. Numbers and strings are printed the same
+ * way as cJSON_PrintUnformatted() prints them.
+ *
+ * Errors are sticky: once an item could not be written, all following calls are ignored
+ * and @ref nrf_cloud_json_writer_finish returns the error.
+ * The length of the complete output is counted even if it does not fit in the buffer,
+ * so a writer with a NULL buffer can be used to find the buffer size that is needed.
+ */
+struct nrf_cloud_json_writer {
+	char *buf;
+	size_t size;
+	/** Length of the output, including what did not fit in the buffer */
+	size_t len;
+	int err;
+	uint8_t depth;
+	/** Bit per nesting level: the container at that level is an array */
+	uint32_t is_array;
+	/** Bit per nesting level: an item has been written at that level */
+	uint32_t has_items;
+};
+
+/** @brief Initialize a writer. @p buf can be NULL to only measure the output length. */
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *const w, char *const buf,
+				const size_t size);
+
+/** @brief Start an object. @p key must be NULL at the root level and inside arrays. */
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *const w, const char *const key);
+
+/** @brief End the current object. */
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *const w);
+
+/** @brief Start an array. @p key must be NULL at the root level and inside arrays. */
+void nrf_cloud_json_arr_start(struct nrf_cloud_json_writer *const w, const char *const key);
+
+/** @brief End the current array. */
+void nrf_cloud_json_arr_end(struct nrf_cloud_json_writer *const w);
+
+/** @brief Add a string. */
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char *const val);
+
+/** @brief Add a number. */
+void nrf_cloud_json_num_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const double val);
+
+/** @brief Add a boolean. */
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			     const bool val);
+
+/** @brief Add a null value. */
+void nrf_cloud_json_null_add(struct nrf_cloud_json_writer *const w, const char *const key);
+
+/** @brief Add a JSON document as a value.
+ *
+ * The document is written in the same format as cJSON_PrintUnformatted() prints it after
+ * parsing it, so that it does not need to be parsed into a cJSON tree first.
+ * Anything after the first value of the document is ignored, as cJSON_ParseWithLength()
+ * does. If the document is not valid JSON, or its containers would be nested deeper than
+ * @ref NRF_CLOUD_JSON_WRITER_DEPTH_MAX in the output, the error of the writer is set to
+ * -EBADMSG.
+ *
+ * @param doc JSON document, does not need to be null-terminated.
+ * @param len Length of the document.
+ */
+void nrf_cloud_json_doc_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char *const doc, const size_t len);
+
+/** @brief Null-terminate the output.
+ *
+ * If the writer was initialized without a buffer, only the length is returned.
+ *
+ * @retval Length of the output, excluding the null terminator.
+ * @retval -E2BIG The output, including the null terminator, does not fit in the buffer.
+ * @retval -EINVAL The calls did not form a complete JSON value, or were nested too deep.
+ * @retval -EBADMSG A document added with @ref nrf_cloud_json_doc_add is not valid JSON.
+ */
+int nrf_cloud_json_writer_finish(struct nrf_cloud_json_writer *const w);
+
+/** JSON value types found by the reader */
+enum nrf_cloud_json_type {
+	NRF_CLOUD_JSON_TYPE_OBJECT,
+	NRF_CLOUD_JSON_TYPE_ARRAY,
+	NRF_CLOUD_JSON_TYPE_STRING,
+	NRF_CLOUD_JSON_TYPE_NUMBER,
+	NRF_CLOUD_JSON_TYPE_BOOL,
+	NRF_CLOUD_JSON_TYPE_NULL,
+};
+
+/** @brief A value in a JSON document, referring to the text of the document. */
+struct nrf_cloud_json_value {
+	enum nrf_cloud_json_type type;
+	/** Start of the value text. For strings, the first character after the quote. */
+	const char *ptr;
+	/** Length of the value text. For strings, without the quotes and still escaped. */
+	size_t len;
+};
+
+/** @brief Find a value in a JSON document without parsing the whole document.
+ *
+ * Follows @p path, a list of object member names, from the root of the document.
+ * Members that are not on the path are skipped without being decoded, so this is
+ * much cheaper than parsing the document with cJSON when only a few values are needed.
+ * The skipped parts of the document are not validated.
+ *
+ * @param buf JSON document, does not need to be null-terminated.
+ * @param len Length of the document.
+ * @param path Member names to follow, or NULL to get the root value.
+ * @param path_len Number of member names in @p path.
+ * @param val Found value.
+ *
+ * @retval 0 The value was found.
+ * @retval -ENOENT A member on the path does not exist, or its parent is not an object.
+ * @retval -EBADMSG The document is not valid JSON.
+ */
+int nrf_cloud_json_value_find(const char *const buf, const size_t len,
+			      const char *const *const path, const size_t path_len,
+			      struct nrf_cloud_json_value *const val);
+
+/** @brief Get a number value. @retval -ENOMSG The value is not a number. */
+int nrf_cloud_json_value_num_get(const struct nrf_cloud_json_value *const val,
+				 double *const num);
+
+/** @brief Get a boolean value. @retval -ENOMSG The value is not a boolean. */
+int nrf_cloud_json_value_bool_get(const struct nrf_cloud_json_value *const val,
+				  bool *const b);
+
+/** @brief Get a string value, unescaped and null-terminated.
+ *
+ * @retval -ENOMSG The value is not a string.
+ * @retval -E2BIG The string does not fit in @p str.
+ * @retval -EBADMSG The string has an invalid escape sequence.
+ */
+int nrf_cloud_json_value_str_get(const struct nrf_cloud_json_value *const val, char *const str,
+				 const size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_JSON_STREAM_H__ */
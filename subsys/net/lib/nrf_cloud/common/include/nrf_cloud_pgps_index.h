@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+
+#ifndef NRF_CLOUD_PGPS_INDEX_H_
+#define NRF_CLOUD_PGPS_INDEX_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct nrf_cloud_pgps_prediction;
+
+/** Index entry describing what is stored in one prediction slot in flash */
+struct npgps_index_entry {
+	/** GPS time of the stored prediction, same as its sentinel; 0 if the slot is empty */
+	uint32_t gps_sec;
+	/** CRC32 of the stored prediction */
+	uint32_t crc;
+} __packed;
+
+/** Function to read the prediction stored in a slot; returns NULL if it cannot be read */
+typedef const struct nrf_cloud_pgps_prediction *(*npgps_index_read_t)(int slot);
+
+/**
+ * @brief Load the persisted index of prediction slots.
+ *
+ * Slots without an index entry are read with @p read_slot when they are first looked up,
+ * and their entries are then saved.
+ */
+int npgps_index_init(npgps_index_read_t read_slot);
+
+/**
+ * @brief Get the GPS time of the prediction stored in a slot.
+ *
+ * @retval 0 The slot holds a prediction.
+ * @retval -ENODATA The slot does not hold a valid prediction.
+ * @retval -EIO The slot is not indexed and could not be read.
+ */
+int npgps_index_slot_time_get(int slot, uint32_t *gps_sec);
+
+/** @brief Update the index entry of a slot from the prediction just written to it. */
+void npgps_index_slot_update(int slot, const struct nrf_cloud_pgps_prediction *p);
+
+/** @brief Forget the index entry of a slot, so that the slot is read when looked up. */
+void npgps_index_slot_forget(int slot);
+
+/**
+ * @brief Check a prediction read from a slot against the CRC in the index.
+ *
+ * Each slot is checked once after init, or after its entry changes.
+ * If the CRC does not match, the entry is forgotten.
+ *
+ * @retval 0 The prediction matches its entry, or the slot is not indexed.
+ * @retval -EBADMSG The prediction does not match its entry.
+ */
+int npgps_index_slot_verify(int slot, const struct nrf_cloud_pgps_prediction *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_PGPS_INDEX_H_ */
@@ -78,9 +78,6 @@ static const char *const sensor_type_str[] = {
 };
 #define SENSOR_TYPE_ARRAY_SIZE (sizeof(sensor_type_str) / sizeof(*sensor_type_str))
 
-/* Max length of a NRF_CLOUD_JSON_MSG_TYPE_VAL_DISCONNECT message */
-#define NRF_CLOUD_JSON_MSG_MAX_LEN_DISCONNECT 200
-
 #if defined(CONFIG_NRF_CLOUD_COAP)
 #define API_FOTA_JOB_EXEC	     "fota/exec"
 #define API_UPDATE_FOTA_URL_TEMPLATE (API_FOTA_JOB_EXEC "/%s")
@@ -444,59 +441,6 @@ int nrf_cloud_shadow_control_decode(struct nrf_cloud_obj *const ctrl_obj,
 	return 0;
 }
 
-int nrf_cloud_shadow_control_response_encode(struct nrf_cloud_ctrl_data const *const data,
-					     bool accept, struct nrf_cloud_data *const output)
-{
-	__ASSERT_NO_MSG(data != NULL);
-	__ASSERT_NO_MSG(output != NULL);
-
-	char *buffer = NULL;
-	int err = 0;
-
-	/* Prepare JSON response for the delta */
-	cJSON *root_obj = cJSON_CreateObject();
-	cJSON *state_obj = NULL;
-	cJSON *reported_obj = NULL;
-	cJSON *desired_obj = NULL;
-
-	if (!IS_ENABLED(CONFIG_NRF_CLOUD_COAP)) {
-		state_obj = cJSON_AddObjectToObjectCS(root_obj, NRF_CLOUD_JSON_KEY_STATE);
-		if (!accept) {
-			desired_obj = cJSON_AddObjectToObjectCS(state_obj, NRF_CLOUD_JSON_KEY_DES);
-			/* Rejecting, add nulls to desired control items */
-			err = nrf_cloud_device_control_encode_internal(desired_obj, NULL);
-			if (err) {
-				goto end;
-			}
-		}
-		reported_obj = cJSON_AddObjectToObjectCS(state_obj, NRF_CLOUD_JSON_KEY_REP);
-	} else {
-		/* CoAP can currently only modify reported, not desired, so we need to simply
-		 * ignore invalid values.
-		 */
-		reported_obj = root_obj;
-	}
-
-	err = nrf_cloud_device_control_encode_internal(reported_obj, data);
-	if (err) {
-		goto end;
-	}
-
-	buffer = cJSON_PrintUnformatted(root_obj);
-	if (!buffer) {
-		err = -ENOMEM;
-		goto end;
-	}
-	LOG_DBG("Shadow response: %s", buffer);
-
-	output->ptr = buffer;
-	output->len = strlen(buffer);
-
-end:
-	cJSON_Delete(root_obj);
-	return err;
-}
-
 static int shadow_connection_info_update(cJSON *device_obj)
 {
 	int ret = 0;
@@ -1298,42 +1242,6 @@ cleanup:
 	return err;
 }
 
-int nrf_cloud_shadow_data_encode(const struct nrf_cloud_sensor_data *sensor,
-				 struct nrf_cloud_data *output)
-{
-	int ret;
-	char *buffer = NULL;
-
-	__ASSERT_NO_MSG(sensor != NULL);
-	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
-	__ASSERT_NO_MSG(sensor->data.len != 0);
-	__ASSERT_NO_MSG(output != NULL);
-	__ASSERT_NO_MSG(sensor->type < SENSOR_TYPE_ARRAY_SIZE);
-
-	cJSON *root_obj = cJSON_CreateObject();
-	cJSON *state_obj = cJSON_AddObjectToObjectCS(root_obj, NRF_CLOUD_JSON_KEY_STATE);
-	cJSON *reported_obj = cJSON_AddObjectToObjectCS(state_obj, NRF_CLOUD_JSON_KEY_REP);
-	cJSON *input_obj = cJSON_ParseWithLength(sensor->data.ptr, sensor->data.len);
-
-	ret = !cJSON_AddItemToObjectCS(reported_obj, sensor_type_str[sensor->type], input_obj);
-
-	if (ret == 0) {
-		buffer = cJSON_PrintUnformatted(root_obj);
-	} else {
-		cJSON_Delete(input_obj);
-	}
-
-	if (buffer) {
-		output->ptr = buffer;
-		output->len = strlen(buffer);
-	} else {
-		ret = -ENOMEM;
-	}
-
-	cJSON_Delete(root_obj);
-	return ret;
-}
-
 int nrf_cloud_dev_status_json_encode(const struct nrf_cloud_device_status *const dev_status,
 				     const int64_t timestamp, cJSON *const msg_obj_out)
 {
@@ -2543,42 +2451,6 @@ cleanup:
 	return ret;
 }
 
-bool nrf_cloud_disconnection_request_decode(const char *const buf)
-{
-	if (buf == NULL) {
-		return false;
-	}
-
-	/* The candidate buffer must be a null-terminated string less than
-	 * a certain length
-	 */
-	if (memchr(buf, '\0', NRF_CLOUD_JSON_MSG_MAX_LEN_DISCONNECT) == NULL) {
-		return false;
-	}
-
-	/* Fast test to avoid parsing EVERY message with cJSON. */
-	if (strstr(buf, NRF_CLOUD_JSON_APPID_VAL_DEVICE) == NULL ||
-	    strstr(buf, NRF_CLOUD_JSON_MSG_TYPE_VAL_DISCONNECT) == NULL) {
-		return false;
-	}
-
-	/* If the quick test passes, use cJSON to get certainty */
-	bool ret = true;
-	cJSON *discon_request_obj = cJSON_Parse(buf);
-
-	/* Check for nRF Cloud disconnection request MQTT message */
-	if (!json_item_string_exists(discon_request_obj, NRF_CLOUD_JSON_MSG_TYPE_KEY,
-				     NRF_CLOUD_JSON_MSG_TYPE_VAL_DISCONNECT) ||
-	    !json_item_string_exists(discon_request_obj, NRF_CLOUD_JSON_APPID_KEY,
-				     NRF_CLOUD_JSON_APPID_VAL_DEVICE)) {
-		/* Not a disconnection request message */
-		ret = false;
-	}
-
-	cJSON_Delete(discon_request_obj);
-	return ret;
-}
-
 int nrf_cloud_gnss_msg_json_encode(const struct nrf_cloud_gnss_data *const gnss,
 				   cJSON *const gnss_msg_obj)
 {
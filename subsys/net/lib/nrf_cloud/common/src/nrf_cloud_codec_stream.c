@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_mem.h"
+#include "nrf_cloud_json_stream.h"
+#include <net/nrf_cloud_defs.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include "cJSON.h"
+
+LOG_MODULE_REGISTER(nrf_cloud_codec_stream, CONFIG_NRF_CLOUD_LOG_LEVEL);
+
+/* Max length of a NRF_CLOUD_JSON_MSG_TYPE_VAL_DISCONNECT message */
+#define NRF_CLOUD_JSON_MSG_MAX_LEN_DISCONNECT 200
+
+/* Write the control section; NULL data writes nulls for all control items */
+static void device_control_stream(struct nrf_cloud_json_writer *const w,
+				  struct nrf_cloud_ctrl_data const *const data)
+{
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_CTRL);
+
+	if (data) {
+#if (CONFIG_MEMFAULT)
+		nrf_cloud_json_bool_add(w, NRF_CLOUD_JSON_KEY_MEMFAULT, data->memfault_enabled);
+#endif /* CONFIG_MEMFAULT */
+#if defined(CONFIG_MEMFAULT_FOTA_MODEM_UPDATE)
+		/* Only report a key once one has been applied  */
+		if (data->modem_project_key[0] != '\0') {
+			nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_KEY_MEMFAULT_MODEM_KEY,
+					       data->modem_project_key);
+		}
+#endif /* CONFIG_MEMFAULT_FOTA_MODEM_UPDATE */
+	} else {
+#if (CONFIG_MEMFAULT)
+		nrf_cloud_json_null_add(w, NRF_CLOUD_JSON_KEY_MEMFAULT);
+#endif /* CONFIG_MEMFAULT */
+#if defined(CONFIG_MEMFAULT_FOTA_MODEM_UPDATE)
+		nrf_cloud_json_null_add(w, NRF_CLOUD_JSON_KEY_MEMFAULT_MODEM_KEY);
+#endif /* CONFIG_MEMFAULT_FOTA_MODEM_UPDATE */
+	}
+
+	nrf_cloud_json_obj_end(w);
+}
+
+static void shadow_control_response_stream(struct nrf_cloud_json_writer *const w,
+					   struct nrf_cloud_ctrl_data const *const data,
+					   bool accept)
+{
+	nrf_cloud_json_obj_start(w, NULL);
+
+	if (!IS_ENABLED(CONFIG_NRF_CLOUD_COAP)) {
+		nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_STATE);
+		if (!accept) {
+			/* Rejecting, add nulls to desired control items */
+			nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_DES);
+			device_control_stream(w, NULL);
+			nrf_cloud_json_obj_end(w);
+		}
+		nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_REP);
+		device_control_stream(w, data);
+		nrf_cloud_json_obj_end(w);
+		nrf_cloud_json_obj_end(w);
+	} else {
+		/* CoAP can currently only modify reported, not desired, so we need to simply
+		 * ignore invalid values.
+		 */
+		device_control_stream(w, data);
+	}
+
+	nrf_cloud_json_obj_end(w);
+}
+
+int nrf_cloud_shadow_control_response_encode(struct nrf_cloud_ctrl_data const *const data,
+					     bool accept, struct nrf_cloud_data *const output)
+{
+	__ASSERT_NO_MSG(data != NULL);
+	__ASSERT_NO_MSG(output != NULL);
+
+	struct nrf_cloud_json_writer w;
+	char *buffer;
+	int len;
+
+	/* Written without a cJSON tree: measure the response, then write it */
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	shadow_control_response_stream(&w, data, accept);
+	len = nrf_cloud_json_writer_finish(&w);
+	if (len < 0) {
+		return len;
+	}
+
+	buffer = nrf_cloud_malloc(len + 1);
+	if (!buffer) {
+		return -ENOMEM;
+	}
+
+	nrf_cloud_json_writer_init(&w, buffer, len + 1);
+	shadow_control_response_stream(&w, data, accept);
+	len = nrf_cloud_json_writer_finish(&w);
+	if (len < 0) {
+		nrf_cloud_free(buffer);
+		return len;
+	}
+	LOG_DBG("Shadow response: %s", buffer);
+
+	output->ptr = buffer;
+	output->len = len;
+
+	return 0;
+}
+
+static void shadow_data_stream(struct nrf_cloud_json_writer *const w,
+			       const struct nrf_cloud_sensor_data *const sensor)
+{
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_STATE);
+	nrf_cloud_json_obj_start(w, NRF_CLOUD_JSON_KEY_REP);
+	/* The sensor data is copied as it is printed by cJSON, without parsing it first */
+	nrf_cloud_json_doc_add(w, nrf_cloud_get_sensor_type_str_internal(sensor->type),
+			       sensor->data.ptr, sensor->data.len);
+	nrf_cloud_json_obj_end(w);
+	nrf_cloud_json_obj_end(w);
+	nrf_cloud_json_obj_end(w);
+}
+
+int nrf_cloud_shadow_data_encode(const struct nrf_cloud_sensor_data *sensor,
+				 struct nrf_cloud_data *output)
+{
+	__ASSERT_NO_MSG(sensor != NULL);
+	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
+	__ASSERT_NO_MSG(sensor->data.len != 0);
+	__ASSERT_NO_MSG(output != NULL);
+
+	struct nrf_cloud_json_writer w;
+	char *buffer;
+	int len;
+
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	shadow_data_stream(&w, sensor);
+	len = nrf_cloud_json_writer_finish(&w);
+	if (len < 0) {
+		return len;
+	}
+
+	buffer = nrf_cloud_malloc(len + 1);
+	if (!buffer) {
+		return -ENOMEM;
+	}
+
+	nrf_cloud_json_writer_init(&w, buffer, len + 1);
+	shadow_data_stream(&w, sensor);
+	len = nrf_cloud_json_writer_finish(&w);
+	if (len < 0) {
+		nrf_cloud_free(buffer);
+		return len;
+	}
+
+	output->ptr = buffer;
+	output->len = len;
+
+	return 0;
+}
+
+int nrf_cloud_encode_message_buf(const char *app_id, double value, const char *str_val,
+				 const char *topic, int64_t ts, char *const buf, size_t *const len)
+{
+	__ASSERT_NO_MSG(app_id != NULL);
+	__ASSERT_NO_MSG(buf != NULL);
+	__ASSERT_NO_MSG(len != NULL);
+
+	struct nrf_cloud_json_writer w;
+	int ret;
+
+	/* Same output as nrf_cloud_encode_message(), without a cJSON tree */
+	nrf_cloud_json_writer_init(&w, buf, *len);
+	nrf_cloud_json_obj_start(&w, NULL);
+
+	if (topic != NULL) {
+		nrf_cloud_json_str_add(&w, NRF_CLOUD_TOPIC_KEY, topic);
+	}
+
+	nrf_cloud_json_obj_start(&w, NRF_CLOUD_MSG_KEY);
+	nrf_cloud_json_str_add(&w, NRF_CLOUD_JSON_APPID_KEY, app_id);
+	nrf_cloud_json_str_add(&w, NRF_CLOUD_JSON_MSG_TYPE_KEY, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	nrf_cloud_json_num_add(&w, NRF_CLOUD_MSG_TIMESTAMP_KEY, ts);
+
+	if (str_val != NULL) {
+		nrf_cloud_json_str_add(&w, NRF_CLOUD_JSON_DATA_KEY, str_val);
+	} else {
+		nrf_cloud_json_num_add(&w, NRF_CLOUD_JSON_DATA_KEY, value);
+	}
+
+	nrf_cloud_json_obj_end(&w);
+	nrf_cloud_json_obj_end(&w);
+
+	ret = nrf_cloud_json_writer_finish(&w);
+	if (ret < 0) {
+		*len = 0;
+		return ret;
+	}
+
+	*len = ret;
+
+	return 0;
+}
+
+/* Check if the top level member key of the JSON string buf is the string val */
+static bool json_stream_str_equals(const char *const buf, const char *const key,
+				   const char *const val)
+{
+	struct nrf_cloud_json_value item;
+	const char *path[] = { key };
+
+	if (nrf_cloud_json_value_find(buf, strlen(buf), path, ARRAY_SIZE(path), &item) ||
+	    (item.type != NRF_CLOUD_JSON_TYPE_STRING)) {
+		return false;
+	}
+
+	return (item.len == strlen(val)) && (memcmp(item.ptr, val, item.len) == 0);
+}
+
+bool nrf_cloud_disconnection_request_decode(const char *const buf)
+{
+	if (buf == NULL) {
+		return false;
+	}
+
+	/* The candidate buffer must be a null-terminated string less than
+	 * a certain length
+	 */
+	if (memchr(buf, '\0', NRF_CLOUD_JSON_MSG_MAX_LEN_DISCONNECT) == NULL) {
+		return false;
+	}
+
+	/* Fast test to avoid parsing EVERY message with cJSON. */
+	if (strstr(buf, NRF_CLOUD_JSON_APPID_VAL_DEVICE) == NULL ||
+	    strstr(buf, NRF_CLOUD_JSON_MSG_TYPE_VAL_DISCONNECT) == NULL) {
+		return false;
+	}
+
+	/* If the quick test passes, check the message without parsing all of it */
+	return json_stream_str_equals(buf, NRF_CLOUD_JSON_MSG_TYPE_KEY,
+				      NRF_CLOUD_JSON_MSG_TYPE_VAL_DISCONNECT) &&
+	       json_stream_str_equals(buf, NRF_CLOUD_JSON_APPID_KEY,
+				      NRF_CLOUD_JSON_APPID_VAL_DEVICE);
+}
+
+/* Get a top level number from a JSON document without parsing the document */
+static int json_stream_num_get(const struct nrf_cloud_data *const input, const char *const key,
+			       double *const num)
+{
+	struct nrf_cloud_json_value item;
+	const char *path[] = { key };
+	int err;
+
+	err = nrf_cloud_json_value_find(input->ptr, input->len, path, ARRAY_SIZE(path), &item);
+	if (err) {
+		return err;
+	}
+
+	return nrf_cloud_json_value_num_get(&item, num);
+}
+
+int nrf_cloud_shadow_delta_stream_decode(const struct nrf_cloud_data *const input,
+					 struct nrf_cloud_obj_shadow_delta *const delta)
+{
+	if (!input || !input->ptr || !delta) {
+		return -EINVAL;
+	}
+
+	struct nrf_cloud_json_value state;
+	const char *path[] = { NRF_CLOUD_JSON_KEY_STATE };
+	double ver = 0;
+	double ts = 0;
+	double num;
+	int err;
+
+	memset(delta, 0, sizeof(*delta));
+
+	/* The error information refers to the whole document, which is only available
+	 * when the document is parsed by nrf_cloud_obj_shadow_delta_decode().
+	 */
+	err = json_stream_num_get(input, NRF_CLOUD_JSON_KEY_ERR, &num);
+	if (err == 0) {
+		return -ENOTSUP;
+	} else if (err == -EBADMSG) {
+		return -ENOMSG;
+	}
+
+	err = json_stream_num_get(input, NRF_CLOUD_JSON_KEY_SHADOW_VERSION, &ver);
+	if (err) {
+		LOG_DBG("\"%s\" not found in shadow data, error: %d",
+			NRF_CLOUD_JSON_KEY_SHADOW_VERSION, err);
+	}
+
+	err = json_stream_num_get(input, NRF_CLOUD_JSON_KEY_SHADOW_TIMESTAMP, &ts);
+	if (err) {
+		LOG_DBG("\"%s\" not found in shadow data, error: %d",
+			NRF_CLOUD_JSON_KEY_SHADOW_TIMESTAMP, err);
+	}
+
+	delta->ver = (int)ver;
+	delta->ts = (int64_t)ts;
+
+	err = nrf_cloud_json_value_find(input->ptr, input->len, path, ARRAY_SIZE(path), &state);
+	if (err == -EBADMSG) {
+		return -ENOMSG;
+	} else if (err || (state.type != NRF_CLOUD_JSON_TYPE_OBJECT)) {
+		LOG_DBG("Item with key \"%s\" not found", NRF_CLOUD_JSON_KEY_STATE);
+		return -ENODEV;
+	}
+
+	/* Only the state object is parsed, the metadata sent with it is skipped */
+	delta->state.json = cJSON_ParseWithLength(state.ptr, state.len);
+	if (!delta->state.json) {
+		return -ENOMSG;
+	}
+
+	delta->state.type = NRF_CLOUD_OBJ_TYPE_JSON;
+	delta->state.enc_src = NRF_CLOUD_ENC_SRC_NONE;
+
+	return 0;
+}
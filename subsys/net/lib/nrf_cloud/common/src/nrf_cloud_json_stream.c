@@ -0,0 +1,778 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "nrf_cloud_json_stream.h"
+
+/* Large enough for "%1.17g" of any double, as in cJSON */
+#define NUM_STR_SIZE 26
+
+void nrf_cloud_json_writer_init(struct nrf_cloud_json_writer *const w, char *const buf,
+				const size_t size)
+{
+	memset(w, 0, sizeof(*w));
+	w->buf = buf;
+	w->size = buf ? size : 0;
+}
+
+static void put(struct nrf_cloud_json_writer *const w, const char *const str, const size_t len)
+{
+	if (w->len < w->size) {
+		memcpy(&w->buf[w->len], str, MIN(len, w->size - w->len));
+	}
+
+	w->len += len;
+}
+
+static void put_char(struct nrf_cloud_json_writer *const w, const char c)
+{
+	put(w, &c, 1);
+}
+
+/* Same escaping as cJSON */
+static void put_escaped(struct nrf_cloud_json_writer *const w, const char *str,
+			const size_t len)
+{
+	const char *run = str;
+	const char *const end = str + len;
+	char esc[7];
+
+	for (; str < end; str++) {
+		const unsigned char c = *str;
+
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+
+		put(w, run, str - run);
+		run = str + 1;
+
+		switch (c) {
+		case '"':
+			put(w, "\\\"", 2);
+			break;
+		case '\\':
+			put(w, "\\\\", 2);
+			break;
+		case '\b':
+			put(w, "\\b", 2);
+			break;
+		case '\f':
+			put(w, "\\f", 2);
+			break;
+		case '\n':
+			put(w, "\\n", 2);
+			break;
+		case '\r':
+			put(w, "\\r", 2);
+			break;
+		case '\t':
+			put(w, "\\t", 2);
+			break;
+		default:
+			snprintf(esc, sizeof(esc), "\\u%04x", c);
+			put(w, esc, 6);
+			break;
+		}
+	}
+
+	put(w, run, str - run);
+}
+
+static void put_string(struct nrf_cloud_json_writer *const w, const char *const str)
+{
+	put_char(w, '"');
+
+	if (str) {
+		put_escaped(w, str, strlen(str));
+	}
+
+	put_char(w, '"');
+}
+
+/* Write the separator and key of an item, if the item is allowed at the current level */
+static bool item_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	const uint32_t level = BIT(w->depth);
+	const bool in_obj = w->depth && !(w->is_array & level);
+
+	if (w->err) {
+		return false;
+	}
+
+	/* Keys are used for object members only, and the root holds a single value */
+	if ((in_obj != (key != NULL)) || (!w->depth && (w->has_items & level))) {
+		w->err = -EINVAL;
+		return false;
+	}
+
+	if (w->has_items & level) {
+		put_char(w, ',');
+	}
+	w->has_items |= level;
+
+	if (key) {
+		put_string(w, key);
+		put_char(w, ':');
+	}
+
+	return true;
+}
+
+static void container_start(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const bool array)
+{
+	if (!item_start(w, key)) {
+		return;
+	}
+
+	if (w->depth >= NRF_CLOUD_JSON_WRITER_DEPTH_MAX) {
+		w->err = -EINVAL;
+		return;
+	}
+
+	put_char(w, array ? '[' : '{');
+
+	w->depth++;
+	w->has_items &= ~BIT(w->depth);
+	WRITE_BIT(w->is_array, w->depth, array);
+}
+
+static void container_end(struct nrf_cloud_json_writer *const w, const bool array)
+{
+	if (w->err) {
+		return;
+	}
+
+	if (!w->depth || (array != !!(w->is_array & BIT(w->depth)))) {
+		w->err = -EINVAL;
+		return;
+	}
+
+	put_char(w, array ? ']' : '}');
+	w->depth--;
+}
+
+void nrf_cloud_json_obj_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	container_start(w, key, false);
+}
+
+void nrf_cloud_json_obj_end(struct nrf_cloud_json_writer *const w)
+{
+	container_end(w, false);
+}
+
+void nrf_cloud_json_arr_start(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	container_start(w, key, true);
+}
+
+void nrf_cloud_json_arr_end(struct nrf_cloud_json_writer *const w)
+{
+	container_end(w, true);
+}
+
+void nrf_cloud_json_str_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char *const val)
+{
+	if (item_start(w, key)) {
+		put_string(w, val);
+	}
+}
+
+/* Same format as cJSON, so that the output does not depend on the encoder that is used */
+static void put_number(struct nrf_cloud_json_writer *const w, const double val)
+{
+	char str[NUM_STR_SIZE];
+	double test;
+	int valueint;
+	int len;
+
+	/* Checked first, converting NaN to an integer is undefined */
+	if (isnan(val) || isinf(val)) {
+		put(w, "null", 4);
+		return;
+	}
+
+	/* cJSON saturates the integer value of a number */
+	if (val >= INT_MAX) {
+		valueint = INT_MAX;
+	} else if (val <= (double)INT_MIN) {
+		valueint = INT_MIN;
+	} else {
+		valueint = (int)val;
+	}
+
+	if (val == (double)valueint) {
+		len = snprintf(str, sizeof(str), "%d", valueint);
+	} else {
+		/* Use 15 digits if they are enough to get the same value back */
+		len = snprintf(str, sizeof(str), "%1.15g", val);
+		if ((sscanf(str, "%lg", &test) != 1) ||
+		    (fabs(test - val) > MAX(fabs(test), fabs(val)) * DBL_EPSILON)) {
+			len = snprintf(str, sizeof(str), "%1.17g", val);
+		}
+	}
+
+	put(w, str, len);
+}
+
+void nrf_cloud_json_num_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const double val)
+{
+	if (item_start(w, key)) {
+		put_number(w, val);
+	}
+}
+
+void nrf_cloud_json_bool_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			     const bool val)
+{
+	if (item_start(w, key)) {
+		put(w, val ? "true" : "false", val ? 4 : 5);
+	}
+}
+
+void nrf_cloud_json_null_add(struct nrf_cloud_json_writer *const w, const char *const key)
+{
+	if (item_start(w, key)) {
+		put(w, "null", 4);
+	}
+}
+
+int nrf_cloud_json_writer_finish(struct nrf_cloud_json_writer *const w)
+{
+	if (w->err) {
+		return w->err;
+	}
+
+	if (w->depth || !(w->has_items & BIT(0))) {
+		return -EINVAL;
+	}
+
+	if (!w->buf) {
+		return w->len;
+	}
+
+	if (w->len >= w->size) {
+		return -E2BIG;
+	}
+
+	w->buf[w->len] = '\0';
+
+	return w->len;
+}
+
+static const char *ws_skip(const char *p, const char *const end)
+{
+	while ((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\n') || (*p == '\r'))) {
+		p++;
+	}
+
+	return p;
+}
+
+/* Return the end of the string starting after the opening quote at p */
+static const char *string_end(const char *p, const char *const end)
+{
+	for (; p < end; p++) {
+		if (*p == '\\') {
+			p++;
+		} else if (*p == '"') {
+			return p;
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the extent of the value at p and return the position after it.
+ * Containers are only scanned for their end, their contents are not validated.
+ */
+static const char *value_scan(const char *p, const char *const end,
+			      struct nrf_cloud_json_value *const val)
+{
+	static const struct {
+		const char *str;
+		enum nrf_cloud_json_type type;
+	} literals[] = {
+		{ "true", NRF_CLOUD_JSON_TYPE_BOOL },
+		{ "false", NRF_CLOUD_JSON_TYPE_BOOL },
+		{ "null", NRF_CLOUD_JSON_TYPE_NULL },
+	};
+	const char *start = p;
+	int depth = 0;
+
+	if (p >= end) {
+		return NULL;
+	}
+
+	switch (*p) {
+	case '"':
+		p = string_end(p + 1, end);
+		if (!p) {
+			return NULL;
+		}
+		val->type = NRF_CLOUD_JSON_TYPE_STRING;
+		val->ptr = start + 1;
+		val->len = p - val->ptr;
+		return p + 1;
+	case '{':
+	case '[':
+		val->type = (*p == '{') ? NRF_CLOUD_JSON_TYPE_OBJECT : NRF_CLOUD_JSON_TYPE_ARRAY;
+		for (; p < end; p++) {
+			if ((*p == '{') || (*p == '[')) {
+				depth++;
+			} else if ((*p == '}') || (*p == ']')) {
+				depth--;
+			} else if (*p == '"') {
+				p = string_end(p + 1, end);
+				if (!p) {
+					return NULL;
+				}
+			}
+
+			if (depth == 0) {
+				val->ptr = start;
+				val->len = p + 1 - start;
+				return p + 1;
+			}
+		}
+		return NULL;
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(literals); i++) {
+		const size_t len = strlen(literals[i].str);
+
+		if (((size_t)(end - p) >= len) && !memcmp(p, literals[i].str, len)) {
+			val->type = literals[i].type;
+			val->ptr = start;
+			val->len = len;
+			return p + len;
+		}
+	}
+
+	if ((*p != '-') && !isdigit((unsigned char)*p)) {
+		return NULL;
+	}
+
+	while ((p < end) && (isdigit((unsigned char)*p) || (*p == '-') || (*p == '+') ||
+			     (*p == '.') || (*p == 'e') || (*p == 'E'))) {
+		p++;
+	}
+
+	val->type = NRF_CLOUD_JSON_TYPE_NUMBER;
+	val->ptr = start;
+	val->len = p - start;
+
+	return p;
+}
+
+/* Find the member of the object in val whose name is key, and replace val with it */
+static int member_find(struct nrf_cloud_json_value *const val, const char *const key)
+{
+	const char *const end = val->ptr + val->len;
+	const char *p = val->ptr + 1;
+	const size_t key_len = strlen(key);
+	struct nrf_cloud_json_value name;
+	struct nrf_cloud_json_value member;
+
+	if (val->type != NRF_CLOUD_JSON_TYPE_OBJECT) {
+		return -ENOENT;
+	}
+
+	p = ws_skip(p, end);
+	if ((p < end) && (*p == '}')) {
+		return -ENOENT;
+	}
+
+	while (p < end) {
+		p = value_scan(p, end, &name);
+		if (!p || (name.type != NRF_CLOUD_JSON_TYPE_STRING)) {
+			return -EBADMSG;
+		}
+
+		p = ws_skip(p, end);
+		if ((p >= end) || (*p != ':')) {
+			return -EBADMSG;
+		}
+
+		p = value_scan(ws_skip(p + 1, end), end, &member);
+		if (!p) {
+			return -EBADMSG;
+		}
+
+		/* Names are compared as written, escaped names are not expected here */
+		if ((name.len == key_len) && !memcmp(name.ptr, key, key_len)) {
+			*val = member;
+			return 0;
+		}
+
+		p = ws_skip(p, end);
+		if ((p < end) && (*p == ',')) {
+			p = ws_skip(p + 1, end);
+		} else if ((p < end) && (*p == '}')) {
+			return -ENOENT;
+		} else {
+			return -EBADMSG;
+		}
+	}
+
+	return -EBADMSG;
+}
+
+int nrf_cloud_json_value_find(const char *const buf, const size_t len,
+			      const char *const *const path, const size_t path_len,
+			      struct nrf_cloud_json_value *const val)
+{
+	const char *const end = buf + len;
+	int err;
+
+	if (!buf || !val || (path_len && !path)) {
+		return -EINVAL;
+	}
+
+	if (!value_scan(ws_skip(buf, end), end, val)) {
+		return -EBADMSG;
+	}
+
+	for (size_t i = 0; i < path_len; i++) {
+		err = member_find(val, path[i]);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+int nrf_cloud_json_value_num_get(const struct nrf_cloud_json_value *const val,
+				 double *const num)
+{
+	char str[NUM_STR_SIZE + 1];
+	char *end;
+
+	if (val->type != NRF_CLOUD_JSON_TYPE_NUMBER) {
+		return -ENOMSG;
+	}
+
+	/* The value is not null-terminated in the document */
+	if (val->len > NUM_STR_SIZE) {
+		return -EBADMSG;
+	}
+
+	memcpy(str, val->ptr, val->len);
+	str[val->len] = '\0';
+
+	*num = strtod(str, &end);
+
+	return (end == &str[val->len]) ? 0 : -EBADMSG;
+}
+
+int nrf_cloud_json_value_bool_get(const struct nrf_cloud_json_value *const val,
+				  bool *const b)
+{
+	if (val->type != NRF_CLOUD_JSON_TYPE_BOOL) {
+		return -ENOMSG;
+	}
+
+	*b = (val->ptr[0] == 't');
+
+	return 0;
+}
+
+static int hex4_decode(const char *p, uint32_t *const out)
+{
+	*out = 0;
+
+	for (int i = 0; i < 4; i++) {
+		const char c = p[i];
+
+		*out <<= 4;
+		if ((c >= '0') && (c <= '9')) {
+			*out |= c - '0';
+		} else if ((c >= 'a') && (c <= 'f')) {
+			*out |= c - 'a' + 10;
+		} else if ((c >= 'A') && (c <= 'F')) {
+			*out |= c - 'A' + 10;
+		} else {
+			return -EBADMSG;
+		}
+	}
+
+	return 0;
+}
+
+/* Decode a \uXXXX escape, or a surrogate pair of them, at p into UTF-8 */
+static int unicode_decode(const char **p, const char *const end, char *utf8, size_t *utf8_len)
+{
+	uint32_t cp;
+	uint32_t low;
+
+	if ((end - *p < 6) || hex4_decode(*p + 2, &cp)) {
+		return -EBADMSG;
+	}
+	*p += 6;
+
+	if ((cp >= 0xd800) && (cp <= 0xdbff)) {
+		if ((end - *p < 6) || ((*p)[0] != '\\') || ((*p)[1] != 'u') ||
+		    hex4_decode(*p + 2, &low) || (low < 0xdc00) || (low > 0xdfff)) {
+			return -EBADMSG;
+		}
+		*p += 6;
+		cp = 0x10000 + (((cp & 0x3ff) << 10) | (low & 0x3ff));
+	} else if ((cp >= 0xdc00) && (cp <= 0xdfff)) {
+		return -EBADMSG;
+	}
+
+	if (cp < 0x80) {
+		utf8[0] = cp;
+		*utf8_len = 1;
+	} else if (cp < 0x800) {
+		utf8[0] = 0xc0 | (cp >> 6);
+		utf8[1] = 0x80 | (cp & 0x3f);
+		*utf8_len = 2;
+	} else if (cp < 0x10000) {
+		utf8[0] = 0xe0 | (cp >> 12);
+		utf8[1] = 0x80 | ((cp >> 6) & 0x3f);
+		utf8[2] = 0x80 | (cp & 0x3f);
+		*utf8_len = 3;
+	} else {
+		utf8[0] = 0xf0 | (cp >> 18);
+		utf8[1] = 0x80 | ((cp >> 12) & 0x3f);
+		utf8[2] = 0x80 | ((cp >> 6) & 0x3f);
+		utf8[3] = 0x80 | (cp & 0x3f);
+		*utf8_len = 4;
+	}
+
+	return 0;
+}
+
+/* Decode the character or escape sequence at p into UTF-8 */
+static int char_decode(const char **p, const char *const end, char *dec, size_t *dec_len)
+{
+	const char *const c = *p;
+
+	if (*c != '\\') {
+		dec[0] = *c;
+		*dec_len = 1;
+		*p += 1;
+		return 0;
+	}
+
+	if (c + 1 >= end) {
+		return -EBADMSG;
+	}
+
+	switch (c[1]) {
+	case 'u':
+		return unicode_decode(p, end, dec, dec_len);
+	case '"':
+	case '\\':
+	case '/':
+		dec[0] = c[1];
+		break;
+	case 'b':
+		dec[0] = '\b';
+		break;
+	case 'f':
+		dec[0] = '\f';
+		break;
+	case 'n':
+		dec[0] = '\n';
+		break;
+	case 'r':
+		dec[0] = '\r';
+		break;
+	case 't':
+		dec[0] = '\t';
+		break;
+	default:
+		return -EBADMSG;
+	}
+
+	*dec_len = 1;
+	*p += 2;
+
+	return 0;
+}
+
+int nrf_cloud_json_value_str_get(const struct nrf_cloud_json_value *const val, char *const str,
+				 const size_t size)
+{
+	const char *p = val->ptr;
+	const char *const end = val->ptr + val->len;
+	size_t out = 0;
+	char dec[4];
+	size_t dec_len;
+	int err;
+
+	if (val->type != NRF_CLOUD_JSON_TYPE_STRING) {
+		return -ENOMSG;
+	}
+
+	while (p < end) {
+		err = char_decode(&p, end, dec, &dec_len);
+		if (err) {
+			return err;
+		}
+
+		if (out + dec_len >= size) {
+			return -E2BIG;
+		}
+
+		memcpy(&str[out], dec, dec_len);
+		out += dec_len;
+	}
+
+	str[out] = '\0';
+
+	return 0;
+}
+
+/* Write a string value as cJSON prints it after parsing it: cJSON keeps the decoded
+ * string null-terminated, so it ends at a decoded \u0000.
+ */
+static int string_copy(struct nrf_cloud_json_writer *const w,
+		       const struct nrf_cloud_json_value *const val)
+{
+	const char *p = val->ptr;
+	const char *const end = val->ptr + val->len;
+	bool ended = false;
+	char dec[4];
+	size_t dec_len;
+	int err;
+
+	put_char(w, '"');
+
+	while (p < end) {
+		err = char_decode(&p, end, dec, &dec_len);
+		if (err) {
+			return err;
+		}
+
+		ended = ended || (dec[0] == '\0');
+		if (!ended) {
+			put_escaped(w, dec, dec_len);
+		}
+	}
+
+	put_char(w, '"');
+
+	return 0;
+}
+
+/* Write the value at p in the format of cJSON, and return the position after it */
+static const char *value_copy(struct nrf_cloud_json_writer *const w, const char *p,
+			      const char *const end, const uint8_t depth)
+{
+	struct nrf_cloud_json_value val;
+	const char *next;
+	bool array;
+	char close;
+	double num;
+
+	if ((p < end) && ((*p == '{') || (*p == '['))) {
+		if (depth >= NRF_CLOUD_JSON_WRITER_DEPTH_MAX) {
+			return NULL;
+		}
+
+		array = (*p == '[');
+		close = array ? ']' : '}';
+		put_char(w, *p);
+
+		p = ws_skip(p + 1, end);
+		if ((p < end) && (*p == close)) {
+			put_char(w, close);
+			return p + 1;
+		}
+
+		while (p < end) {
+			if (!array) {
+				p = value_scan(p, end, &val);
+				if (!p || (val.type != NRF_CLOUD_JSON_TYPE_STRING) ||
+				    string_copy(w, &val)) {
+					return NULL;
+				}
+
+				p = ws_skip(p, end);
+				if ((p >= end) || (*p != ':')) {
+					return NULL;
+				}
+
+				put_char(w, ':');
+				p = ws_skip(p + 1, end);
+			}
+
+			p = value_copy(w, p, end, depth + 1);
+			if (!p) {
+				return NULL;
+			}
+
+			p = ws_skip(p, end);
+			if ((p < end) && (*p == ',')) {
+				put_char(w, ',');
+				p = ws_skip(p + 1, end);
+			} else if ((p < end) && (*p == close)) {
+				put_char(w, close);
+				return p + 1;
+			} else {
+				return NULL;
+			}
+		}
+
+		return NULL;
+	}
+
+	next = value_scan(p, end, &val);
+	if (!next) {
+		return NULL;
+	}
+
+	switch (val.type) {
+	case NRF_CLOUD_JSON_TYPE_STRING:
+		return string_copy(w, &val) ? NULL : next;
+	case NRF_CLOUD_JSON_TYPE_NUMBER:
+		if (nrf_cloud_json_value_num_get(&val, &num)) {
+			return NULL;
+		}
+		put_number(w, num);
+		return next;
+	default:
+		put(w, val.ptr, val.len);
+		return next;
+	}
+}
+
+void nrf_cloud_json_doc_add(struct nrf_cloud_json_writer *const w, const char *const key,
+			    const char *const doc, const size_t len)
+{
+	if (!item_start(w, key)) {
+		return;
+	}
+
+	if (!doc) {
+		w->err = -EINVAL;
+		return;
+	}
+
+	/* Like cJSON_ParseWithLength(), anything after the value is ignored */
+	if (!value_copy(w, ws_skip(doc, doc + len), doc + len, w->depth)) {
+		w->err = -EBADMSG;
+	}
+}
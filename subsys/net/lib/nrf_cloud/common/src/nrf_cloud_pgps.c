@@ -33,6 +33,7 @@ LOG_MODULE_REGISTER(nrf_cloud_pgps, CONFIG_NRF_CLOUD_GPS_LOG_LEVEL);
 
 #include "nrf_cloud_pgps_schema_v1.h"
 #include "nrf_cloud_pgps_utils.h"
+#include "nrf_cloud_pgps_index.h"
 #include "nrf_cloud_codec_internal.h"
 
 #define DOWNLOAD_PROTOCOL "https://"
@@ -78,8 +79,11 @@ struct pgps_index {
 	bool stale_server_data;
 	int32_t storage_extent;
 	int store_block;
+	/* Position of prediction num 0 in predictions[] */
+	uint8_t pred_first;
 
-	/* Array of memory offsets to predictions, in sorted time order.
+	/* Circular array of memory offsets to predictions, in sorted time
+	 * order starting at pred_first; use prediction_ref() to access it.
 	 * If flash device is external, this must be passed
 	 * to read_prediction() to read a copy to a local buffer.
 	 * If flash device is internal, it can be converted directly to
@@ -131,9 +135,14 @@ static void discard_prediction_buffer(void)
 #endif
 }
 
+static struct nrf_cloud_pgps_prediction **prediction_ref(int pnum)
+{
+	return &index.predictions[(index.pred_first + pnum) % NUM_PREDICTIONS];
+}
+
 static int get_prediction_block(int pnum)
 {
-	return npgps_pointer_to_block((uint8_t *)index.predictions[pnum]);
+	return npgps_pointer_to_block((uint8_t *)*prediction_ref(pnum));
 }
 
 /**
@@ -177,7 +186,7 @@ static struct nrf_cloud_pgps_prediction *get_cached_prediction(off_t off)
 
 static struct nrf_cloud_pgps_prediction *get_prediction(int pnum)
 {
-	off_t off = (off_t)index.predictions[pnum];
+	off_t off = (off_t)*prediction_ref(pnum);
 
 	return get_cached_prediction(off);
 }
@@ -193,13 +202,16 @@ static struct nrf_cloud_pgps_prediction *get_prediction_slot(int slot, off_t *fl
 	return get_cached_prediction(off);
 }
 
-static int determine_prediction_num(struct nrf_cloud_pgps_header *header,
-				    struct nrf_cloud_pgps_prediction *p)
+static const struct nrf_cloud_pgps_prediction *read_prediction_slot(int slot)
+{
+	return get_prediction_slot(slot, NULL);
+}
+
+static int determine_prediction_num(struct nrf_cloud_pgps_header *header, int64_t pred_sec)
 {
 	int64_t start_sec = npgps_gps_day_time_to_sec(header->gps_day, header->gps_time_of_day);
 	uint32_t period_sec = header->prediction_period_min * SEC_PER_MIN;
 	int64_t end_sec = start_sec + header->prediction_count * period_sec;
-	int64_t pred_sec = npgps_gps_day_time_to_sec(p->time.date_day, p->time.time_full_s);
 
 	if ((start_sec <= pred_sec) && (pred_sec < end_sec)) {
 		return (int)((pred_sec - start_sec) / period_sec);
@@ -294,6 +306,63 @@ static int validate_prediction(const struct nrf_cloud_pgps_prediction *p, uint16
 	return 0;
 }
 
+/* Get the GPS time of the prediction stored in a slot, from the index if enabled */
+static int get_slot_gps_sec(int slot, int64_t *gps_sec)
+{
+	if (IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)) {
+		uint32_t sentinel;
+		int err;
+
+		err = npgps_index_slot_time_get(slot, &sentinel);
+		if (!err) {
+			*gps_sec = sentinel;
+		}
+		return err;
+	}
+
+	struct nrf_cloud_pgps_prediction *pred = get_prediction_slot(slot, NULL);
+
+	if (pred == NULL) {
+		return -EIO;
+	}
+
+	*gps_sec = npgps_gps_day_time_to_sec(pred->time.date_day, pred->time.time_full_s);
+	return 0;
+}
+
+/* Check that a cataloged prediction is the one expected for the given time */
+static int check_stored_prediction(int pnum, uint16_t gps_day, uint32_t gps_time_of_day,
+				   uint16_t period_min)
+{
+	if (IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)) {
+		uint32_t expected_sentinel = npgps_gps_day_time_to_sec(gps_day, gps_time_of_day);
+		uint32_t sentinel;
+		int err;
+
+		/* Index entries are only made for complete predictions; the contents are
+		 * checked against the CRC in the index when the prediction is first used.
+		 */
+		err = npgps_index_slot_time_get(get_prediction_block(pnum), &sentinel);
+		if (err) {
+			return err;
+		}
+		if (sentinel != expected_sentinel) {
+			LOG_ERR("prediction num:%d has stored_sentinel:0x%08X, expected:0x%08X",
+				pnum, sentinel, expected_sentinel);
+			return -EINVAL;
+		}
+		return 0;
+	}
+
+	struct nrf_cloud_pgps_prediction *pred = get_prediction(pnum);
+
+	if (pred == NULL) {
+		return -EIO;
+	}
+
+	return validate_prediction(pred, gps_day, gps_time_of_day, period_min, true, false);
+}
+
 static int validate_stored_predictions(uint16_t *first_bad_day, uint32_t *first_bad_time)
 {
 	int err;
@@ -303,36 +372,37 @@ static int validate_stored_predictions(uint16_t *first_bad_day, uint32_t *first_
 	uint16_t period_min = index.header.prediction_period_min;
 	uint16_t gps_day = index.header.gps_day;
 	uint32_t gps_time_of_day = index.header.gps_time_of_day;
-	struct nrf_cloud_pgps_prediction *pred;
 	int64_t start_gps_sec = index.start_sec;
-	off_t off;
+	int64_t pred_sec;
 	int64_t gps_sec;
 
 	/* reset catalog of predictions */
 	discard_prediction_buffer();
-	for (pnum = 0; pnum < count; pnum++) {
-		index.predictions[pnum] = NULL;
-	}
+	memset(index.predictions, 0, sizeof(index.predictions));
+	index.pred_first = 0;
 
 	npgps_reset_block_pool();
 
-	/* build catalog of predictions by block */
+	/* build catalog of predictions by block; with the index enabled,
+	 * only slots that are not indexed yet are read from flash
+	 */
 	for (i = 0; i < count; i++) {
-		pred = (struct nrf_cloud_pgps_prediction *)get_prediction_slot(i, &off);
-		if (pred == NULL) {
+		err = get_slot_gps_sec(i, &pred_sec);
+		if (err == -ENODATA) {
+			LOG_DBG("No prediction at idx:%d", i);
+			continue;
+		} else if (err) {
 			LOG_ERR("Prediction at idx:%d not accessible", i);
 			continue;
 		}
 
-		pnum = determine_prediction_num(&index.header, pred);
+		pnum = determine_prediction_num(&index.header, pred_sec);
 		if (pnum < 0) {
-			LOG_ERR("prediction idx:%u, ofs:%p, out of expected time range;"
-				" day:%u, time:%u",
-				i, (void *)pred, pred->time.date_day, pred->time.time_full_s);
-		} else if (index.predictions[pnum] == NULL) {
-			index.predictions[pnum] = (struct nrf_cloud_pgps_prediction *)off;
-			LOG_DBG("Prediction num:%u stored at idx:%d, off:0x%lX", pnum, i,
-				(unsigned long)off);
+			LOG_ERR("prediction idx:%u out of expected time range; gps sec:%u", i,
+				(uint32_t)pred_sec);
+		} else if (*prediction_ref(pnum) == NULL) {
+			*prediction_ref(pnum) = npgps_block_to_pointer(i);
+			LOG_DBG("Prediction num:%u stored at idx:%d", pnum, i);
 		} else {
 			LOG_WRN("Prediction num:%u stored more than once!", pnum);
 		}
@@ -345,8 +415,7 @@ static int validate_stored_predictions(uint16_t *first_bad_day, uint32_t *first_
 		gps_sec = start_gps_sec + pnum * period_min * SEC_PER_MIN;
 		npgps_gps_sec_to_day_time(gps_sec, &gps_day, &gps_time_of_day);
 
-		pred = get_prediction(pnum);
-		if (pred == NULL) {
+		if (*prediction_ref(pnum) == NULL) {
 			LOG_WRN("Prediction num:%u missing", pnum);
 			/* request partial data; download interrupted? */
 			*first_bad_day = gps_day;
@@ -354,11 +423,11 @@ static int validate_stored_predictions(uint16_t *first_bad_day, uint32_t *first_
 			break;
 		}
 
-		err = validate_prediction(pred, gps_day, gps_time_of_day, period_min, true, false);
+		err = check_stored_prediction(pnum, gps_day, gps_time_of_day, period_min);
 		if (err) {
 			LOG_ERR("Prediction num:%u, gps_day:%u, "
-				"gps_time_of_day:%u is bad:%d; loc:%p",
-				pnum, gps_day, gps_time_of_day, err, pred);
+				"gps_time_of_day:%u is bad:%d; blk:%d",
+				pnum, gps_day, gps_time_of_day, err, get_prediction_block(pnum));
 			/* request partial data; download interrupted? */
 			*first_bad_day = gps_day;
 			*first_bad_time = gps_time_of_day;
@@ -366,8 +435,8 @@ static int validate_stored_predictions(uint16_t *first_bad_day, uint32_t *first_
 		}
 
 		i = get_prediction_block(pnum);
-		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, pred, i);
-		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", pred);
+		LOG_DBG("Prediction num:%u, blk:%d", pnum, i);
+		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", *prediction_ref(pnum));
 		npgps_mark_block_used(i, true);
 	}
 
@@ -404,7 +473,6 @@ static void get_prediction_day_time(int pnum, int64_t *gps_sec, uint16_t *gps_da
 
 static void discard_oldest_predictions(int num)
 {
-	int i;
 	int pnum;
 	int block;
 	int last = MIN(num, index.header.prediction_count);
@@ -421,22 +489,22 @@ static void discard_oldest_predictions(int num)
 	for (pnum = 0; pnum < last; pnum++) {
 		block = get_prediction_block(pnum);
 		__ASSERT((block != -1), "unexpected ptr:%p for Prediction num:%d",
-			 index.predictions[pnum], pnum);
+			 *prediction_ref(pnum), pnum);
 		npgps_free_block(block);
+		*prediction_ref(pnum) = NULL;
 	}
 
-	/* move predictions we are keeping to the start */
-	for (i = last; i < index.header.prediction_count; i++) {
-		pnum = i - last;
-		index.predictions[pnum] = index.predictions[i];
-	}
+	/* the predictions we are keeping now start at 'last'; rotate the
+	 * catalog instead of moving them to the start
+	 */
+	index.pred_first = (index.pred_first + last) % NUM_PREDICTIONS;
 
 	/* set prediction pointers for 'last' in the newly empty
 	 * entries to NULL
 	 */
 	for (pnum = index.header.prediction_count - last; pnum < index.header.prediction_count;
 	     pnum++) {
-		index.predictions[pnum] = NULL;
+		*prediction_ref(pnum) = NULL;
 	}
 	npgps_print_blocks();
 
@@ -666,6 +734,12 @@ int nrf_cloud_pgps_find_prediction(struct nrf_cloud_pgps_prediction **prediction
 	if (*prediction) {
 		err = validate_prediction(*prediction, cur_gps_day, cur_gps_time_of_day, period_min,
 					  false, margin);
+		if (!err && IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)) {
+			/* stored predictions are cataloged from the index, without reading
+			 * them; check the contents the first time each one is used
+			 */
+			err = npgps_index_slot_verify(get_prediction_block(pnum), *prediction);
+		}
 		if (!err) {
 			start_expiration_timer(pnum, cur_gps_sec);
 			return pnum;
@@ -1075,12 +1149,38 @@ int nrf_cloud_pgps_inject(struct nrf_cloud_pgps_prediction *p,
 	return ret; /* just return last non-zero error, if any */
 }
 
-#if VERIFY_FLASH
+#if defined(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)
+/* Update the index from a flash page that was just written and read back */
+static void index_page_written(const uint8_t *buf, size_t len, size_t offset)
+{
+	int slot = (offset - storage_addr) / PGPS_PREDICTION_STORAGE_SIZE;
+	size_t pos;
+
+	for (pos = 0; (pos < flash_page_size) && (slot < NUM_BLOCKS);
+	     pos += PGPS_PREDICTION_STORAGE_SIZE, slot++) {
+		if ((pos + sizeof(struct nrf_cloud_pgps_prediction)) <= len) {
+			npgps_index_slot_update(
+				slot, (const struct nrf_cloud_pgps_prediction *)&buf[pos]);
+		} else {
+			/* the rest of the page was erased, but not written */
+			npgps_index_slot_forget(slot);
+		}
+	}
+}
+#endif
+
+#if VERIFY_FLASH || defined(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)
 static int flash_callback(uint8_t *buf, size_t len, size_t offset)
 {
+	int err = 0;
+
+#if defined(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)
+	index_page_written(buf, len, offset);
+#endif
+
+#if VERIFY_FLASH
 	size_t erased_start = 0;
 	bool erased_found = false;
-	int err;
 
 	struct nrf_cloud_pgps_prediction *pred = (struct nrf_cloud_pgps_prediction *)buf;
 
@@ -1097,6 +1197,7 @@ static int flash_callback(uint8_t *buf, size_t len, size_t offset)
 		LOG_DBG("Block at offset:0x%zX len %zu: written", offset, len);
 		err = 0;
 	}
+#endif
 	return err;
 }
 #else
@@ -1413,7 +1514,7 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 	if (!err) {
 		LOG_DBG("Parsing finished");
 
-		if (index.predictions[pnum]) {
+		if (*prediction_ref(pnum)) {
 			LOG_WRN("Received duplicate packet; ignoring");
 		} else if (gps_sec == 0) {
 			LOG_ERR("Prediction did not include GPS day and time of day; ignoring");
@@ -1430,7 +1531,7 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 				LOG_ERR("Error storing prediction:%d", err);
 				goto fail;
 			}
-			index.predictions[pnum] = npgps_block_to_pointer(index.store_block);
+			*prediction_ref(pnum) = npgps_block_to_pointer(index.store_block);
 
 			if (!finished) {
 				if (loading_in_progress && !notified && (index.loading_count > 1)) {
@@ -1532,10 +1633,11 @@ int nrf_cloud_pgps_begin_update(void)
 		index.header.prediction_period_min = PREDICTION_PERIOD;
 		index.period_sec = index.header.prediction_period_min * SEC_PER_MIN;
 		memset(index.predictions, 0, sizeof(index.predictions));
+		index.pred_first = 0;
 	} else {
 		for (uint8_t pnum = index.pnum_offset;
 		     pnum < index.expected_count + index.pnum_offset; pnum++) {
-			index.predictions[pnum] = NULL;
+			*prediction_ref(pnum) = NULL;
 		}
 	}
 
@@ -1676,6 +1778,9 @@ int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 
 	memset(&index, 0, sizeof(index));
 	(void)npgps_settings_init();
+	if (IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)) {
+		(void)npgps_index_init(read_prediction_slot);
+	}
 
 #if defined(CONFIG_NRF_CLOUD_PGPS_DOWNLOAD_TRANSPORT_HTTP)
 	err = npgps_download_init(nrf_cloud_pgps_process_update, end_transfer_handler);
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/crc.h>
+
+#include <net/nrf_cloud_pgps.h>
+
+#include "nrf_cloud_pgps_index.h"
+#include "nrf_cloud_pgps_utils.h"
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(nrf_cloud_pgps, CONFIG_NRF_CLOUD_GPS_LOG_LEVEL);
+
+#define SETTINGS_NAME "nrf_cloud_pgps_idx"
+/* Room for the subtree name, a separator and the slot number */
+#define SETTINGS_KEY_LEN (sizeof(SETTINGS_NAME) + 4)
+
+struct slot_index {
+	struct npgps_index_entry entry[NUM_BLOCKS];
+	/* The entry describes the slot; otherwise the slot must be read */
+	bool known[NUM_BLOCKS];
+	/* The slot contents were checked against the entry since init */
+	bool verified[NUM_BLOCKS];
+};
+
+static struct slot_index slots;
+static npgps_index_read_t read_slot_fn;
+
+static int settings_set(const char *key, size_t len_rd, settings_read_cb read_cb, void *cb_arg);
+
+SETTINGS_STATIC_HANDLER_DEFINE(nrf_cloud_pgps_idx, SETTINGS_NAME, NULL, settings_set, NULL, NULL);
+
+static int settings_set(const char *key, size_t len_rd, settings_read_cb read_cb, void *cb_arg)
+{
+	struct npgps_index_entry entry;
+	char *end;
+	long slot;
+
+	if (!key) {
+		return -EINVAL;
+	}
+
+	slot = strtol(key, &end, 10);
+	if ((end == key) || (slot < 0) || (slot >= NUM_BLOCKS) || (len_rd != sizeof(entry))) {
+		LOG_DBG("Ignoring index key:%s, size:%zu", key, len_rd);
+		return -ENOTSUP;
+	}
+
+	if (read_cb(cb_arg, &entry, len_rd) != len_rd) {
+		return -EIO;
+	}
+
+	slots.entry[slot] = entry;
+	slots.known[slot] = true;
+	slots.verified[slot] = false;
+
+	return 0;
+}
+
+static void settings_key_get(int slot, char *key)
+{
+	(void)snprintk(key, SETTINGS_KEY_LEN, SETTINGS_NAME "/%d", slot);
+}
+
+static void entry_save(int slot, const struct npgps_index_entry *entry)
+{
+	char key[SETTINGS_KEY_LEN];
+	int err;
+
+	if (slots.known[slot] && !memcmp(&slots.entry[slot], entry, sizeof(*entry))) {
+		return; /* Unchanged; spare the settings storage */
+	}
+
+	slots.entry[slot] = *entry;
+	slots.known[slot] = true;
+	slots.verified[slot] = false;
+
+	settings_key_get(slot, key);
+	err = settings_save_one(key, entry, sizeof(*entry));
+	if (err) {
+		LOG_WRN("Error saving index of slot:%d: %d", slot, err);
+	}
+}
+
+static void entry_from_prediction(const struct nrf_cloud_pgps_prediction *p,
+				  struct npgps_index_entry *entry)
+{
+	/* Same truncation as the sentinel written with the prediction */
+	uint32_t gps_sec =
+		(uint32_t)((int64_t)p->time.date_day * SEC_PER_DAY + p->time.time_full_s);
+
+	entry->gps_sec = 0;
+	entry->crc = 0;
+
+	/* Only complete predictions are indexed; anything else, such as erased
+	 * flash or an interrupted write, leaves the slot empty.
+	 */
+	if ((p->schema_version != NRF_CLOUD_AGNSS_BIN_SCHEMA_VERSION) ||
+	    (p->time_type != NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK) || (p->time_count != 1) ||
+	    (p->ephemeris_type != NRF_CLOUD_AGNSS_GPS_EPHEMERIDES) ||
+	    (p->ephemeris_count != NRF_CLOUD_PGPS_NUM_SV) || (p->sentinel != gps_sec) ||
+	    (gps_sec == 0)) {
+		return;
+	}
+
+	entry->gps_sec = gps_sec;
+	entry->crc = crc32_ieee((const uint8_t *)p, sizeof(*p));
+}
+
+int npgps_index_init(npgps_index_read_t read_slot)
+{
+	int err;
+
+	__ASSERT(read_slot != NULL, "Must specify slot read function");
+	read_slot_fn = read_slot;
+	memset(&slots, 0, sizeof(slots));
+
+	err = settings_subsys_init();
+	if (err) {
+		LOG_ERR("Settings init failed:%d", err);
+		return err;
+	}
+
+	err = settings_load_subtree(SETTINGS_NAME);
+	if (err) {
+		LOG_ERR("Cannot load prediction index:%d", err);
+	}
+
+	return err;
+}
+
+int npgps_index_slot_time_get(int slot, uint32_t *gps_sec)
+{
+	__ASSERT((slot >= 0) && (slot < NUM_BLOCKS), "slot %d out of range", slot);
+
+	if (!slots.known[slot]) {
+		const struct nrf_cloud_pgps_prediction *p = read_slot_fn(slot);
+		struct npgps_index_entry entry;
+
+		if (p == NULL) {
+			return -EIO;
+		}
+
+		LOG_DBG("Indexing slot:%d", slot);
+		entry_from_prediction(p, &entry);
+		entry_save(slot, &entry);
+		/* The entry was made from what is in flash now */
+		slots.verified[slot] = true;
+	}
+
+	if (slots.entry[slot].gps_sec == 0) {
+		return -ENODATA;
+	}
+
+	*gps_sec = slots.entry[slot].gps_sec;
+	return 0;
+}
+
+void npgps_index_slot_update(int slot, const struct nrf_cloud_pgps_prediction *p)
+{
+	struct npgps_index_entry entry;
+
+	__ASSERT((slot >= 0) && (slot < NUM_BLOCKS), "slot %d out of range", slot);
+
+	entry_from_prediction(p, &entry);
+	entry_save(slot, &entry);
+	LOG_DBG("Index slot:%d, gps sec:%u", slot, entry.gps_sec);
+}
+
+void npgps_index_slot_forget(int slot)
+{
+	char key[SETTINGS_KEY_LEN];
+	int err;
+
+	__ASSERT((slot >= 0) && (slot < NUM_BLOCKS), "slot %d out of range", slot);
+
+	if (!slots.known[slot]) {
+		return;
+	}
+
+	slots.known[slot] = false;
+	slots.verified[slot] = false;
+
+	settings_key_get(slot, key);
+	err = settings_delete(key);
+	if (err) {
+		LOG_WRN("Error deleting index of slot:%d: %d", slot, err);
+	}
+}
+
+int npgps_index_slot_verify(int slot, const struct nrf_cloud_pgps_prediction *p)
+{
+	__ASSERT((slot >= 0) && (slot < NUM_BLOCKS), "slot %d out of range", slot);
+
+	if (!slots.known[slot] || slots.verified[slot]) {
+		return 0;
+	}
+
+	if ((slots.entry[slot].gps_sec != p->sentinel) ||
+	    (slots.entry[slot].crc != crc32_ieee((const uint8_t *)p, sizeof(*p)))) {
+		LOG_ERR("Prediction in slot:%d does not match its index", slot);
+		npgps_index_slot_forget(slot);
+		return -EBADMSG;
+	}
+
+	slots.verified[slot] = true;
+	return 0;
+}
@@ -432,6 +432,52 @@ static void accept_associated_or_wait_state(enum nfsm_state cur_state, enum nfsm
 	*do_discon = false;
 }
 
+/* Decode shadow data by parsing the whole document */
+static int shadow_obj_decode(const struct nct_cc_data *const cc,
+			     struct nrf_cloud_obj_shadow_data *const shadow_data,
+			     struct nrf_cloud_obj_shadow_delta *const shadow_delta,
+			     struct nrf_cloud_obj_shadow_transform *const shadow_tf)
+{
+	int err;
+
+	NRF_CLOUD_OBJ_JSON_DEFINE(shadow_obj);
+
+	/* Decode input data */
+	err = nrf_cloud_obj_input_decode(&shadow_obj, &cc->data);
+	if (err) {
+		return -ENOMSG;
+	}
+
+	/* Decode data based on the topic */
+	if (cc->opcode == NCT_CC_OPCODE_UPDATE_DELTA) {
+		err = nrf_cloud_obj_shadow_delta_decode(&shadow_obj, shadow_delta);
+		if (!err) {
+			shadow_data->type = NRF_CLOUD_OBJ_SHADOW_TYPE_DELTA;
+			shadow_data->delta = shadow_delta;
+			LOG_DBG("Delta shadow decoded");
+		}
+	} else if (cc->opcode == NCT_CC_OPCODE_UPDATE_DELTA_ERR) {
+		err = nrf_cloud_obj_shadow_delta_decode(&shadow_obj, shadow_delta);
+		if (!err) {
+			shadow_data->type = NRF_CLOUD_OBJ_SHADOW_TYPE_DELTA;
+			shadow_data->delta = shadow_delta;
+			LOG_DBG("Delta shadow error decoded");
+		}
+	} else if (cc->opcode == NCT_CC_OPCODE_TRANSFORM) {
+		err = nrf_cloud_obj_shadow_transform_decode(&shadow_obj, shadow_tf);
+		if (!err) {
+			shadow_data->type = NRF_CLOUD_OBJ_SHADOW_TYPE_TF;
+			shadow_data->transform = shadow_tf;
+			LOG_DBG("Transform result received");
+		}
+	}
+
+	nrf_cloud_obj_free(&shadow_obj);
+
+	/* -ENOMSG is kept for input that is not valid JSON */
+	return (err == -ENOMSG) ? -EIO : err;
+}
+
 static int cc_rx_data_handler(const struct nct_evt *nct_evt)
 {
 	__ASSERT_NO_MSG(nct_evt != NULL);
@@ -446,8 +492,6 @@ static int cc_rx_data_handler(const struct nct_evt *nct_evt)
 	struct nrf_cloud_obj_shadow_transform shadow_tf = {0};
 	struct nrf_cloud_obj_shadow_data shadow_data = {0};
 
-	NRF_CLOUD_OBJ_JSON_DEFINE(shadow_obj);
-
 	LOG_DBG("CC RX on topic [%d] %.*s: %s", nct_evt->param.cc->opcode,
 		nct_evt->param.cc->topic.len, (const char *)nct_evt->param.cc->topic.ptr,
 		(const char *)nct_evt->param.cc->data.ptr);
@@ -465,40 +509,30 @@ static int cc_rx_data_handler(const struct nct_evt *nct_evt)
 		return 0;
 	}
 
-	/* Decode input data */
-	err = nrf_cloud_obj_input_decode(&shadow_obj, &nct_evt->param.cc->data);
-	if (err) {
-		LOG_ERR("Error decoding shadow data, error: %d", err);
-		return -ENOMSG;
-	}
+	err = -ENOTSUP;
 
-	/* Decode data based on the topic */
+	/* Delta updates are decoded without parsing the whole document. If that fails
+	 * for any reason, the whole document is decoded, which also handles errors.
+	 */
 	if (nct_evt->param.cc->opcode == NCT_CC_OPCODE_UPDATE_DELTA) {
-		err = nrf_cloud_obj_shadow_delta_decode(&shadow_obj, &shadow_delta);
+		err = nrf_cloud_shadow_delta_stream_decode(&nct_evt->param.cc->data, &shadow_delta);
 		if (!err) {
 			shadow_data.type = NRF_CLOUD_OBJ_SHADOW_TYPE_DELTA;
 			shadow_data.delta = &shadow_delta;
 			LOG_DBG("Delta shadow decoded");
-		}
-	} else if (nct_evt->param.cc->opcode == NCT_CC_OPCODE_UPDATE_DELTA_ERR) {
-		err = nrf_cloud_obj_shadow_delta_decode(&shadow_obj, &shadow_delta);
-		if (!err) {
-			shadow_data.type = NRF_CLOUD_OBJ_SHADOW_TYPE_DELTA;
-			shadow_data.delta = &shadow_delta;
-			LOG_DBG("Delta shadow error decoded");
-		}
-	} else if (nct_evt->param.cc->opcode == NCT_CC_OPCODE_TRANSFORM) {
-		err = nrf_cloud_obj_shadow_transform_decode(&shadow_obj, &shadow_tf);
-		if (!err) {
-			shadow_data.type = NRF_CLOUD_OBJ_SHADOW_TYPE_TF;
-			shadow_data.transform = &shadow_tf;
-			LOG_DBG("Transform result received");
+		} else {
+			LOG_DBG("Delta shadow not stream decoded, error: %d", err);
 		}
 	}
 
-	nrf_cloud_obj_free(&shadow_obj);
-
 	if (err) {
+		err = shadow_obj_decode(nct_evt->param.cc, &shadow_data, &shadow_delta, &shadow_tf);
+	}
+
+	if (err == -ENOMSG) {
+		LOG_ERR("Error decoding shadow data, error: %d", err);
+		return -ENOMSG;
+	} else if (err) {
 		return 0;
 	}
 
@@ -9,9 +9,11 @@
 #include <nrf_compress/implementation.h>
 
 #if !defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_STATIC) && \
-	!defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+	!defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC) && \
+	!defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
 #error "Missing compression static buffer configuration, please select " \
-	"CONFIG_NRF_COMPRESS_MEMORY_TYPE_STATIC or CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC"
+	"CONFIG_NRF_COMPRESS_MEMORY_TYPE_STATIC, CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC or " \
+	"CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA"
 #endif
 
 #if !defined(CONFIG_NRF_COMPRESS_COMPRESSION) && !defined(CONFIG_NRF_COMPRESS_DECOMPRESSION)
@@ -36,8 +36,13 @@ LOG_MODULE_REGISTER(nrf_compress_lzma, CONFIG_NRF_COMPRESS_LOG_LEVEL);
 	"CONFIG_NRF_COMPRESS_LZMA_VERSION_LZMA1 or CONFIG_NRF_COMPRESS_LZMA_VERSION_LZMA2"
 #endif
 
+BUILD_ASSERT(NRF_COMPRESS_LZMA_PROBS_SIZE == MAX_LZMA_PROB_SIZE * sizeof(uint16_t));
+
 #if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_STATIC)
 static uint16_t lzma_probs[MAX_LZMA_PROB_SIZE];
+#elif defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+/* Placed in the memory arena lent by the user between init and deinit. */
+static uint16_t *lzma_probs;
 #endif
 
 #if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC) && defined(CONFIG_NRF_COMPRESS_CLEANUP)
@@ -46,8 +51,9 @@ static size_t malloc_probs_size = 0;
 
 static void *lzma_probs_alloc(ISzAllocPtr p, size_t size)
 {
-#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_STATIC)
-	if (size > sizeof(lzma_probs)) {
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_STATIC) \
+	|| defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+	if (size > NRF_COMPRESS_LZMA_PROBS_SIZE) {
 		LOG_ERR("Compress library tried to allocate too large a buffer (0x%x)", size);
 		return NULL;
 	}
@@ -99,7 +105,9 @@ static void lzma_probs_free(ISzAllocPtr p, void *address)
 	free(address);
 #else
 #ifdef CONFIG_NRF_COMPRESS_CLEANUP
-	like_mbedtls_zeroize(lzma_probs, sizeof(lzma_probs));
+	if (address != NULL) {
+		like_mbedtls_zeroize(address, NRF_COMPRESS_LZMA_PROBS_SIZE);
+	}
 #endif
 #endif
 }
@@ -116,7 +124,8 @@ static uint8_t __aligned(CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT) lzma_dict[MAX_LZM
 #else
 static uint8_t lzma_dict[MAX_LZMA_DICT_SIZE];
 #endif
-#elif defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC) \
+#elif (defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC) \
+	|| defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)) \
 	&& !defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
 static uint8_t *lzma_dict = NULL;
 #else
@@ -147,6 +156,25 @@ typedef struct dict_cache_t {
 
 static dict_cache cache;
 #endif
+
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_SIZE > 0
+/**
+ * @brief Dictionary Read Cache Structure
+ *
+ * Holds a block of dictionary data read ahead from outside of the write cache window, so that
+ * matches which are copied byte by byte do not each result in an external dictionary read.
+ */
+typedef struct dict_read_cache_t {
+	/** Cached dictionary data. */
+	uint8_t data[CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_SIZE];
+	/** Indicates which dictionary element is stored as first element of @a data. */
+	SizeT dict_pos_begin;
+	/** Number of valid bytes in @a data, zero if the cache is empty. */
+	SizeT len;
+} dict_read_cache;
+
+static dict_read_cache read_cache;
+#endif
 #endif
 
 static size_t lzma_output_limit = SIZE_MAX;
@@ -157,6 +185,81 @@ static CLzma2Dec lzma_decoder;
 static CLzmaDec lzma_decoder;
 #endif
 
+#if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+/**
+ * @brief Drop read cache contents overlapping with data written to external dictionary.
+ *
+ * @param pos position of the first written dictionary element.
+ * @param len number of written elements.
+ */
+static void read_cache_invalidate(SizeT pos, SizeT len)
+{
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_SIZE > 0
+	if (pos < read_cache.dict_pos_begin + read_cache.len &&
+	    read_cache.dict_pos_begin < pos + len) {
+		read_cache.len = 0;
+	}
+#else
+	ARG_UNUSED(pos);
+	ARG_UNUSED(len);
+#endif
+}
+
+/**
+ * @brief Read data from external dictionary through the read cache.
+ *
+ * @param handle pointer to Lzma dictionary handle struct, for dictionary size reference.
+ * @param pos position of the first dictionary element to read.
+ * @param data buffer to read into.
+ * @param len number of elements to read.
+ *
+ * @retval Number of bytes read.
+ */
+static SizeT external_read(const DictHandle *handle, SizeT pos, Byte *data, SizeT len)
+{
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_SIZE > 0
+	SizeT bytes_read = 0;
+
+	if (len >= sizeof(read_cache.data)) {
+		return ext_dict->read(pos, data, len);
+	}
+
+	while (bytes_read < len) {
+		SizeT read_pos = pos + bytes_read;
+		SizeT copy_size;
+
+		if (read_pos < read_cache.dict_pos_begin ||
+		    read_pos >= read_cache.dict_pos_begin + read_cache.len) {
+			/* Cache miss, read ahead a block starting at the requested position. */
+			SizeT fill_size = MIN(sizeof(read_cache.data),
+					      handle->dicBufSize - read_pos);
+
+			read_cache.len = 0;
+
+			if (ext_dict->read(read_pos, read_cache.data, fill_size) != fill_size) {
+				break;
+			}
+
+			read_cache.dict_pos_begin = read_pos;
+			read_cache.len = fill_size;
+		}
+
+		copy_size = MIN(len - bytes_read,
+				read_cache.dict_pos_begin + read_cache.len - read_pos);
+		memcpy(data + bytes_read, read_cache.data + (read_pos - read_cache.dict_pos_begin),
+		       copy_size);
+		bytes_read += copy_size;
+	}
+
+	return bytes_read;
+#else
+	ARG_UNUSED(handle);
+
+	return ext_dict->read(pos, data, len);
+#endif
+}
+#endif
+
 #if CONFIG_NRF_COMPRESS_DICTIONARY_CACHE_SIZE > 0
 /**
  * @brief Synchronize dictionary cache with external dictionary.
@@ -179,6 +282,7 @@ static int synchronize_cache(const DictHandle *handle)
 		return -EIO;
 	}
 
+	read_cache_invalidate(cache.dict_pos_begin, dict_write_size);
 	cache.write_offset = 0;
 
 	cache.dict_pos_begin = cache.dict_pos_end + 1;
@@ -221,6 +325,57 @@ static int check_inst(void *inst)
 #define check_inst(...) 0
 #endif
 
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+/**
+ * @brief Place the decoder buffers in the memory arena lent by the user.
+ *
+ * @param codec pointer to initialization context holding the arena.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the arena is missing, too small or misaligned
+ */
+static int lzma_arena_borrow(const lzma_codec *codec)
+{
+	uint8_t *arena;
+
+	if (codec == NULL || codec->arena == NULL ||
+	    codec->arena_size < NRF_COMPRESS_LZMA_ARENA_SIZE ||
+	    !IS_ALIGNED(codec->arena,
+			MAX(CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT, sizeof(uint16_t)))) {
+		return -EINVAL;
+	}
+
+	arena = codec->arena;
+
+#if !defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+	lzma_dict = arena;
+	arena += ROUND_UP(MAX_LZMA_DICT_SIZE, sizeof(uint32_t));
+#endif
+
+	lzma_probs = (uint16_t *)arena;
+
+	return 0;
+}
+
+/**
+ * @brief Give the memory arena back to the user.
+ */
+static void lzma_arena_return(void)
+{
+#if !defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+#ifdef CONFIG_NRF_COMPRESS_CLEANUP
+	if (lzma_dict != NULL) {
+		like_mbedtls_zeroize(lzma_dict, MAX_LZMA_DICT_SIZE);
+	}
+#endif
+
+	lzma_dict = NULL;
+#endif
+
+	lzma_probs = NULL;
+}
+#endif
+
 static int lzma_reset(void *inst, size_t decompressed_size);
 
 static int lzma_init(void *inst, size_t decompressed_size)
@@ -262,6 +417,26 @@ static int lzma_init(void *inst, size_t decompressed_size)
 	}
 #endif
 
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+#if !defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+	if (lzma_dict != NULL) {
+		/* Already borrowed */
+		lzma_reset(inst, decompressed_size);
+
+		return rc;
+	}
+#endif
+
+	rc = lzma_arena_borrow(inst);
+
+	if (rc) {
+#if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+		ext_dict = NULL;
+#endif
+		return rc;
+	}
+#endif
+
 	lzma_output_limit = decompressed_size != 0 ? decompressed_size : SIZE_MAX;
 
 	return rc;
@@ -288,6 +463,10 @@ static int lzma_deinit(void *inst)
 #endif
 	rc = lzma_reset(inst, 0);
 
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+	lzma_arena_return();
+#endif
+
 #if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
 	ext_dict = NULL;
 #endif
@@ -345,7 +524,8 @@ static size_t lzma_bytes_needed(void *inst)
 		return arg_check_rc;
 	}
 
-#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC) \
+#if (defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC) \
+	|| defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)) \
 	&& !defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
 	if (lzma_dict == NULL) {
 		return 0;
@@ -378,7 +558,8 @@ static int lzma_decompress(void *inst, const uint8_t *input, size_t input_size,
 
 	ARG_UNUSED(inst);
 
-#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC)
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_MALLOC) \
+	|| defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
 	if (lzma_dict == NULL) {
 		return -ESRCH;
 	}
@@ -647,6 +828,9 @@ DictHandle *LzmaDictionaryOpen(SizeT size)
 	cache.dict_pos_end = sizeof(cache.data) - 1;
 	cache.write_offset = 0;
 #endif
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_SIZE > 0
+	read_cache.len = 0;
+#endif
 
 	return &dict_handle;
 }
@@ -696,6 +880,8 @@ SizeT LzmaDictionaryWrite(DictHandle *handle, SizeT pos, const Byte *data, SizeT
 	}
 	return bytes_written;
 #else
+	read_cache_invalidate(pos, write_len);
+
 	return ext_dict->write(pos, data, write_len);
 #endif
 }
@@ -722,7 +908,7 @@ SizeT LzmaDictionaryRead(DictHandle *handle, SizeT pos, Byte *data, SizeT len)
 
 		if (pos < cache.dict_pos_begin) {
 			/* First part of data is from dictionary... */
-			bytes_read = ext_dict->read(pos, data, cache.dict_pos_begin - pos);
+			bytes_read = external_read(handle, pos, data, cache.dict_pos_begin - pos);
 			if (bytes_read != cache.dict_pos_begin - pos) {
 				return bytes_read;
 			}
@@ -741,16 +927,16 @@ SizeT LzmaDictionaryRead(DictHandle *handle, SizeT pos, Byte *data, SizeT len)
 
 		if (bytes_read != read_len) {
 			/* Last part of data is from dictionary. */
-			bytes_read += ext_dict->read(pos + bytes_read, data + bytes_read,
-								read_len - bytes_read);
+			bytes_read += external_read(handle, pos + bytes_read, data + bytes_read,
+						    read_len - bytes_read);
 		}
 	} else {
 		/* Requested data is not cached at all. */
-		bytes_read = ext_dict->read(pos, data, read_len);
+		bytes_read = external_read(handle, pos, data, read_len);
 	}
 	return bytes_read;
 #else
-	return ext_dict->read(pos, data, read_len);
+	return external_read(handle, pos, data, read_len);
 #endif
 }
 
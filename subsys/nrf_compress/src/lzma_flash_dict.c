@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <nrf_compress/lzma_flash_dict.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_DECLARE(nrf_compress_lzma, CONFIG_NRF_COMPRESS_LOG_LEVEL);
+
+/* The decoder writes the dictionary in blocks of the dictionary cache size. */
+#define WRITE_CHUNK_SIZE MAX(CONFIG_NRF_COMPRESS_DICTIONARY_CACHE_SIZE, 1)
+
+/* Largest supported write block size of the flash area. */
+#define WRITE_BLOCK_MAX 32
+
+static const struct flash_area *dest_fa;
+static size_t dest_offset;
+static bool opened;
+
+/* Size of the dictionary ring, as reported to the decoder. */
+static size_t window_size;
+/* Offset of the output data held by the dictionary position 0. */
+static size_t window_base;
+/* Dictionary position following the last written data. */
+static size_t next_pos;
+/* Total number of output bytes written. */
+static size_t written;
+
+int lzma_flash_dict_set(const struct flash_area *fa, size_t offset)
+{
+	if (opened) {
+		return -EBUSY;
+	}
+
+	if (fa == NULL || offset > fa->fa_size || (offset % flash_area_align(fa)) != 0) {
+		return -EINVAL;
+	}
+
+	dest_fa = fa;
+	dest_offset = offset;
+
+	return 0;
+}
+
+int lzma_flash_dict_open(size_t dict_size, size_t *buff_size)
+{
+	uint32_t align;
+
+	if (dest_fa == NULL) {
+		return -ENODEV;
+	}
+
+	align = flash_area_align(dest_fa);
+
+	if (align > WRITE_BLOCK_MAX || (WRITE_CHUNK_SIZE % align) != 0) {
+		LOG_ERR("Dictionary cache size not aligned to flash write block size %u", align);
+		return -EINVAL;
+	}
+
+	/* Every dictionary pass is written in full chunks, so all writes but the last one are
+	 * aligned to the write block size.
+	 */
+	window_size = ROUND_UP(dict_size, WRITE_CHUNK_SIZE);
+	window_base = 0;
+	next_pos = 0;
+	written = 0;
+	opened = true;
+
+	*buff_size = window_size;
+
+	return 0;
+}
+
+int lzma_flash_dict_close(void)
+{
+	opened = false;
+
+	return 0;
+}
+
+size_t lzma_flash_dict_write(size_t pos, const uint8_t *data, size_t len)
+{
+	uint32_t align = flash_area_align(dest_fa);
+	size_t aligned_len = ROUND_DOWN(len, align);
+	size_t out_pos;
+
+	if (!opened) {
+		return 0;
+	}
+
+	if (pos < next_pos) {
+		/* Decoder wrapped around the dictionary, the next pass follows the previous one. */
+		window_base += window_size;
+	}
+
+	out_pos = window_base + pos;
+
+	if (out_pos != written || dest_offset + out_pos + len > dest_fa->fa_size) {
+		LOG_ERR("Invalid flash dictionary write at %zu", out_pos);
+		return 0;
+	}
+
+	if (aligned_len > 0 &&
+	    flash_area_write(dest_fa, dest_offset + out_pos, data, aligned_len) != 0) {
+		return 0;
+	}
+
+	if (aligned_len < len) {
+		/* End of the output, pad the last write block with the erased value. */
+		uint8_t block[WRITE_BLOCK_MAX];
+
+		memset(block, flash_area_erased_val(dest_fa), align);
+		memcpy(block, data + aligned_len, len - aligned_len);
+
+		if (flash_area_write(dest_fa, dest_offset + out_pos + aligned_len, block,
+				     align) != 0) {
+			return 0;
+		}
+	}
+
+	next_pos = pos + len;
+	written = out_pos + len;
+
+	return len;
+}
+
+size_t lzma_flash_dict_read(size_t pos, uint8_t *data, size_t len)
+{
+	size_t bytes_read = 0;
+
+	if (!opened) {
+		return 0;
+	}
+
+	while (bytes_read < len) {
+		size_t read_pos = pos + bytes_read;
+		size_t read_size;
+		size_t out_pos;
+
+		if (read_pos < next_pos) {
+			/* Written in the current dictionary pass. */
+			read_size = MIN(len - bytes_read, next_pos - read_pos);
+			out_pos = window_base + read_pos;
+		} else if (window_base >= window_size) {
+			/* Written in the previous dictionary pass. */
+			read_size = len - bytes_read;
+			out_pos = window_base - window_size + read_pos;
+		} else {
+			/* Not written yet, the decoder does not use the content. */
+			read_size = len - bytes_read;
+			memset(data + bytes_read, 0, read_size);
+			bytes_read += read_size;
+			continue;
+		}
+
+		if (flash_area_read(dest_fa, dest_offset + out_pos, data + bytes_read,
+				    read_size) != 0) {
+			break;
+		}
+
+		bytes_read += read_size;
+	}
+
+	return bytes_read;
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <nrf_profiler.h>
+
+#define RING_SIZE		CONFIG_NRF_PROFILER_RING_BUFFER_SIZE
+/* Offsets in the payload encoded by nrf_profiler_log_start() and the encode helpers. */
+#define PAYLOAD_TIMESTAMP_POS	sizeof(uint8_t)
+#define PAYLOAD_ARGS_POS	(PAYLOAD_TIMESTAMP_POS + sizeof(uint32_t))
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RING_SIZE), "Ring buffer size must be a power of two");
+
+/* Header of a record stored in the ring buffer and printed by the drain thread.
+ * The multi-byte fields are little-endian.
+ *
+ * | Offset | Size | Field                                                        |
+ * |--------|------|--------------------------------------------------------------|
+ * | 0      | 2    | Length of the event arguments that follow the header         |
+ * | 2      | 1    | ID of the CPU that logged the event                          |
+ * | 3      | 1    | Event type ID                                                |
+ * | 4      | 4    | Timestamp, in cycles of k_cycle_get_32()                     |
+ * | 8      | len  | Event arguments, as encoded by nrf_profiler_log_encode_*()   |
+ */
+struct profiler_ring_record {
+	uint16_t len;
+	uint8_t cpu;
+	uint8_t type_id;
+	uint32_t timestamp;
+} __packed;
+
+BUILD_ASSERT(sizeof(struct profiler_ring_record) == 8, "Unexpected record header layout");
+
+enum state {
+	STATE_DISABLED,
+	STATE_ACTIVE,
+	STATE_TERMINATED,
+};
+
+/* Records of the events profiled on a single CPU. Only the owning CPU writes records, with its
+ * interrupts locked, and only the drain thread reads them. The positions are free running.
+ */
+struct profiler_ring {
+	uint8_t buf[RING_SIZE];
+	atomic_t head;
+	atomic_t tail;
+	atomic_t dropped;
+};
+
+static struct profiler_ring rings[CONFIG_MP_MAX_NUM_CPUS];
+
+static K_SEM_DEFINE(nrf_profiler_sem, 0, 1);
+static atomic_t nrf_profiler_state;
+static uint8_t info_event_cnt;
+
+static k_tid_t drain_thread_id;
+
+static K_THREAD_STACK_DEFINE(nrf_profiler_ring_stack, CONFIG_NRF_PROFILER_RING_STACK_SIZE);
+static struct k_thread nrf_profiler_ring_thread;
+
+static uint8_t cpu_id_get(void)
+{
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+	return arch_curr_cpu()->id;
+#else
+	return 0;
+#endif
+}
+
+static void ring_write(struct profiler_ring *ring, uint32_t pos, const uint8_t *data, size_t len)
+{
+	size_t offset = pos & (RING_SIZE - 1);
+	size_t part = MIN(len, RING_SIZE - offset);
+
+	memcpy(&ring->buf[offset], data, part);
+	memcpy(ring->buf, data + part, len - part);
+}
+
+static void ring_read(const struct profiler_ring *ring, uint32_t pos, uint8_t *data, size_t len)
+{
+	size_t offset = pos & (RING_SIZE - 1);
+	size_t part = MIN(len, RING_SIZE - offset);
+
+	memcpy(data, &ring->buf[offset], part);
+	memcpy(data + part, ring->buf, len - part);
+}
+
+static void output_info(void)
+{
+	uint8_t ne = nrf_profiler_num_events;
+
+	barrier_dmem_fence_full();
+
+	/* The lines use the layout of the Nordic backend info channel. */
+	printk("nrf_profiler_info:<ev_info_start>\n");
+	for (size_t t = 0; t < ne; t++) {
+		printk("nrf_profiler_info:%s\n", nrf_profiler_get_event_descr(t));
+	}
+	printk("nrf_profiler_info:<ev_info_stop>\n");
+	printk("nrf_profiler_info:<sys_config_start>\n");
+	printk("nrf_profiler_info:sys_clock_hw_cycles_per_sec,%u\n",
+	       (uint32_t)sys_clock_hw_cycles_per_sec());
+	printk("nrf_profiler_info:<sys_config_stop>\n");
+
+	info_event_cnt = ne;
+}
+
+static void output_record(const uint8_t *data, size_t len)
+{
+	static char hex[2 * (sizeof(struct profiler_ring_record) +
+			     CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN) + 1];
+
+	(void)bin2hex(data, len, hex, sizeof(hex));
+	printk("nrf_profiler_data:%s\n", hex);
+}
+
+/* Find the ring with the oldest pending record, so that the records of all CPUs are output
+ * in the order of their timestamps.
+ */
+static struct profiler_ring *oldest_ring_get(void)
+{
+	struct profiler_ring *oldest = NULL;
+	uint32_t oldest_timestamp = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(rings); i++) {
+		struct profiler_ring *ring = &rings[i];
+		uint32_t tail = atomic_get(&ring->tail);
+		struct profiler_ring_record hdr;
+		uint32_t timestamp;
+
+		if (tail == (uint32_t)atomic_get(&ring->head)) {
+			continue;
+		}
+
+		ring_read(ring, tail, (uint8_t *)&hdr, sizeof(hdr));
+		timestamp = sys_le32_to_cpu(hdr.timestamp);
+
+		if (!oldest || ((int32_t)(timestamp - oldest_timestamp) < 0)) {
+			oldest = ring;
+			oldest_timestamp = timestamp;
+		}
+	}
+
+	return oldest;
+}
+
+static void drain(void)
+{
+	static uint8_t record[sizeof(struct profiler_ring_record) +
+			      CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN];
+	struct profiler_ring *ring;
+
+	if (info_event_cnt != nrf_profiler_num_events) {
+		output_info();
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(rings); i++) {
+		atomic_val_t dropped = atomic_clear(&rings[i].dropped);
+
+		if (dropped > 0) {
+			printk("nrf_profiler_dropped:%zu,%ld\n", i, (long)dropped);
+		}
+	}
+
+	while ((ring = oldest_ring_get()) != NULL) {
+		uint32_t tail = atomic_get(&ring->tail);
+		struct profiler_ring_record *hdr = (struct profiler_ring_record *)record;
+		size_t len;
+
+		barrier_dmem_fence_full();
+		ring_read(ring, tail, record, sizeof(*hdr));
+		len = sizeof(*hdr) + sys_le16_to_cpu(hdr->len);
+		__ASSERT_NO_MSG(len <= sizeof(record));
+		ring_read(ring, tail + sizeof(*hdr), record + sizeof(*hdr), len - sizeof(*hdr));
+
+		barrier_dmem_fence_full();
+		atomic_set(&ring->tail, tail + len);
+
+		output_record(record, len);
+	}
+}
+
+static void nrf_profiler_ring_thread_fn(void)
+{
+	while (atomic_get(&nrf_profiler_state) != STATE_TERMINATED) {
+		drain();
+		k_sleep(K_MSEC(CONFIG_NRF_PROFILER_RING_DRAIN_PERIOD_MS));
+	}
+
+	drain();
+	k_sem_give(&nrf_profiler_sem);
+}
+
+int nrf_profiler_init(void)
+{
+	k_sched_lock();
+
+	if (!atomic_cas(&nrf_profiler_state, STATE_DISABLED, STATE_ACTIVE)) {
+		k_sched_unlock();
+		return 0;
+	}
+
+	if (!IS_ENABLED(CONFIG_SHELL)) {
+		for (size_t i = 0; i < NRF_PROFILER_MAX_NUMBER_OF_APPLICATION_AND_INTERNAL_EVENTS;
+		     i++) {
+			atomic_set_bit(_nrf_profiler_event_enabled_bm.flags, i);
+		}
+	}
+
+	drain_thread_id = k_thread_create(&nrf_profiler_ring_thread,
+			nrf_profiler_ring_stack,
+			K_THREAD_STACK_SIZEOF(nrf_profiler_ring_stack),
+			(k_thread_entry_t)nrf_profiler_ring_thread_fn,
+			NULL, NULL, NULL,
+			CONFIG_NRF_PROFILER_RING_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(drain_thread_id, "nrf_profiler_ring");
+
+	k_sched_unlock();
+	return 0;
+}
+
+void nrf_profiler_term(void)
+{
+	if (atomic_set(&nrf_profiler_state, STATE_TERMINATED) != STATE_ACTIVE) {
+		/* Not initialized or already terminated. */
+		return;
+	}
+
+	k_wakeup(drain_thread_id);
+	k_sem_take(&nrf_profiler_sem, K_FOREVER);
+}
+
+void nrf_profiler_log_send(struct log_event_buf *buf, uint16_t event_type_id)
+{
+	__ASSERT_NO_MSG(event_type_id <= UINT8_MAX);
+
+	if (atomic_get(&nrf_profiler_state) != STATE_ACTIVE) {
+		return;
+	}
+
+	uint16_t args_len = buf->payload - buf->payload_start - PAYLOAD_ARGS_POS;
+	struct profiler_ring_record hdr = {
+		.len = sys_cpu_to_le16(args_len),
+		.type_id = event_type_id & UINT8_MAX,
+	};
+	size_t len = sizeof(hdr) + args_len;
+
+	/* The timestamp is already little-endian in the payload. */
+	memcpy(&hdr.timestamp, &buf->payload_start[PAYLOAD_TIMESTAMP_POS], sizeof(hdr.timestamp));
+
+	/* Records are written to the ring of the current CPU, so locking interrupts on this CPU
+	 * is enough to serialize the writers.
+	 */
+	unsigned int key = arch_irq_lock();
+
+	hdr.cpu = cpu_id_get();
+
+	struct profiler_ring *ring = &rings[hdr.cpu];
+	uint32_t head = atomic_get(&ring->head);
+	uint32_t tail = atomic_get(&ring->tail);
+
+	if ((RING_SIZE - (head - tail)) < len) {
+		atomic_inc(&ring->dropped);
+	} else {
+		ring_write(ring, head, (const uint8_t *)&hdr, sizeof(hdr));
+		ring_write(ring, head + sizeof(hdr), &buf->payload_start[PAYLOAD_ARGS_POS],
+			   args_len);
+
+		barrier_dmem_fence_full();
+		atomic_set(&ring->head, head + len);
+	}
+
+	arch_irq_unlock(key);
+}
@@ -118,6 +118,62 @@ static inline uint64_t nrf_rpc_os_timestamp_get_now(void)
 uint32_t nrf_rpc_os_ctx_pool_reserve(void);
 void nrf_rpc_os_ctx_pool_release(uint32_t number);
 
+/** @brief Per-group packet processing statistics. */
+struct nrf_rpc_os_group_stats {
+	/** Number of packets processed by the thread pool. */
+	uint32_t count;
+	/** Longest time a packet waited for a pool thread. */
+	uint32_t queue_time_max_us;
+	/** Longest time a pool thread spent processing a packet. */
+	uint32_t exec_time_max_us;
+	/** Total time packets waited for a pool thread. */
+	uint64_t queue_time_total_us;
+	/** Total time pool threads spent processing packets. */
+	uint64_t exec_time_total_us;
+};
+
+/** @brief Get the processing statistics of a group.
+ *
+ * Available if @kconfig{CONFIG_NRF_RPC_OS_GROUP_STATS} is enabled.
+ *
+ * @param[in] group_id Local group ID.
+ * @param[out] stats Statistics of the group.
+ *
+ * @retval 0 On success.
+ * @retval -NRF_EINVAL The group ID is above the number of groups with statistics.
+ */
+int nrf_rpc_os_group_stats_get(uint8_t group_id, struct nrf_rpc_os_group_stats *stats);
+
+/** @brief Reset the processing statistics of all groups. */
+void nrf_rpc_os_group_stats_reset(void);
+
+/** @brief Allocate a receive buffer.
+ *
+ * Receive buffers are reference counted, so that decoders can keep a reference to a part of
+ * a received packet after decoding is done instead of copying it. A transport receives packets
+ * into these buffers and allocates a new one for the next packet if the previous one is still
+ * referenced. Available if @kconfig{CONFIG_NRF_RPC_OS_RX_BUF_POOL} is enabled.
+ *
+ * @retval Buffer of @kconfig{CONFIG_NRF_RPC_OS_RX_BUF_SIZE} bytes with one reference, or NULL
+ *         if all buffers are in use.
+ */
+void *nrf_rpc_os_rx_buf_alloc(void);
+
+/** @brief Check if a pointer points into a receive buffer. */
+bool nrf_rpc_os_rx_buf_contains(const void *ptr);
+
+/** @brief Take a reference to the receive buffer that contains @p ptr. */
+void nrf_rpc_os_rx_buf_ref(const void *ptr);
+
+/** @brief Release a reference to the receive buffer that contains @p ptr.
+ *
+ * The buffer is freed when the last reference is released.
+ */
+void nrf_rpc_os_rx_buf_unref(const void *ptr);
+
+/** @brief Check if the receive buffer that contains @p ptr has more than one reference. */
+bool nrf_rpc_os_rx_buf_shared(const void *ptr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,8 @@
 #include "nrf_rpc_os.h"
 #include <zephyr/sys/math_extras.h>
 
+#include <string.h>
+
 /* Maximum number of remote thread that this implementation allows. */
 #define MAX_REMOTE_THREADS 255
 
@@ -20,15 +22,53 @@
 	(~(((atomic_val_t)1 << (8 * sizeof(atomic_val_t) -		       \
 				CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE)) - 1))
 
+/* Offset of the destination group ID in the nRF RPC packet header */
+#define HEADER_DST_GROUP_IDX 4
+
 struct pool_start_msg {
+#if defined(CONFIG_NRF_RPC_OS_GROUP_DISPATCH)
+	sys_snode_t node;
+#endif
 	const uint8_t *data;
 	size_t len;
+#if defined(CONFIG_NRF_RPC_OS_GROUP_STATS)
+	uint32_t send_cycles;
+#endif
 };
 
 static nrf_rpc_os_work_t thread_pool_callback;
 
+#if defined(CONFIG_NRF_RPC_OS_GROUP_DISPATCH)
+/* Packets of one group are queued in the same lane in the order of reception. Pool threads take
+ * packets from the lanes in the round-robin order, so a busy group cannot starve other groups.
+ */
+struct dispatch_lane {
+	sys_slist_t msgs;
+	uint8_t active;
+};
+
+static struct dispatch_lane lanes[CONFIG_NRF_RPC_OS_DISPATCH_LANES];
+static uint8_t lane_next;
+static struct k_spinlock dispatch_lock;
+static struct k_sem dispatch_sem;
+
+K_MEM_SLAB_DEFINE_STATIC(pool_msg_slab, sizeof(struct pool_start_msg),
+			 CONFIG_NRF_RPC_OS_DISPATCH_QUEUE_SIZE, sizeof(void *));
+#else
 static struct pool_start_msg pool_start_msg_buf[2];
 static struct k_msgq pool_start_msg;
+#endif /* CONFIG_NRF_RPC_OS_GROUP_DISPATCH */
+
+#if defined(CONFIG_NRF_RPC_OS_GROUP_STATS)
+static struct nrf_rpc_os_group_stats group_stats[CONFIG_NRF_RPC_OS_GROUP_STATS_MAX];
+static struct k_spinlock stats_lock;
+#endif
+
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+static uint8_t __aligned(sizeof(void *))
+	rx_bufs[CONFIG_NRF_RPC_OS_RX_BUF_COUNT][CONFIG_NRF_RPC_OS_RX_BUF_SIZE];
+static atomic_t rx_buf_refs[CONFIG_NRF_RPC_OS_RX_BUF_COUNT];
+#endif
 
 static struct k_sem context_reserved;
 static atomic_t context_mask;
@@ -46,15 +86,119 @@ BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE <= 8 * sizeof(atomic_val_t),
 BUILD_ASSERT(sizeof(uint32_t) == sizeof(atomic_val_t),
 	     "Only atomic_val_t is implemented that is the same as uint32_t");
 
+#if defined(CONFIG_NRF_RPC_OS_GROUP_DISPATCH) || defined(CONFIG_NRF_RPC_OS_GROUP_STATS)
+static uint8_t packet_group_id(const uint8_t *data, size_t len)
+{
+	return (len > HEADER_DST_GROUP_IDX) ? data[HEADER_DST_GROUP_IDX] : 0;
+}
+#endif
+
+static void packet_execute(const struct pool_start_msg *msg)
+{
+#if defined(CONFIG_NRF_RPC_OS_GROUP_STATS)
+	uint8_t group_id = packet_group_id(msg->data, msg->len);
+	uint32_t start = k_cycle_get_32();
+	uint32_t queue_us = k_cyc_to_us_floor32(start - msg->send_cycles);
+	uint32_t exec_us;
+	struct nrf_rpc_os_group_stats *stats;
+	k_spinlock_key_t key;
+
+	thread_pool_callback(msg->data, msg->len);
+
+	if (group_id >= ARRAY_SIZE(group_stats)) {
+		return;
+	}
+
+	exec_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	stats = &group_stats[group_id];
+
+	key = k_spin_lock(&stats_lock);
+	stats->count++;
+	stats->queue_time_total_us += queue_us;
+	stats->queue_time_max_us = MAX(stats->queue_time_max_us, queue_us);
+	stats->exec_time_total_us += exec_us;
+	stats->exec_time_max_us = MAX(stats->exec_time_max_us, exec_us);
+	k_spin_unlock(&stats_lock, key);
+#else
+	thread_pool_callback(msg->data, msg->len);
+#endif
+}
+
+#if defined(CONFIG_NRF_RPC_OS_GROUP_DISPATCH)
+/* Take the next packet from the first lane, starting from the round-robin position, that has
+ * pending packets and is below its thread limit. Must be called with dispatch_lock held.
+ */
+static struct pool_start_msg *dispatch_next(struct dispatch_lane **lane_out)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(lanes); i++) {
+		uint8_t idx = (lane_next + i) % ARRAY_SIZE(lanes);
+		struct dispatch_lane *lane = &lanes[idx];
+		sys_snode_t *node;
+
+		if (lane->active >= CONFIG_NRF_RPC_OS_DISPATCH_LANE_THREADS) {
+			continue;
+		}
+
+		node = sys_slist_get(&lane->msgs);
+		if (node == NULL) {
+			continue;
+		}
+
+		lane->active++;
+		lane_next = (idx + 1) % ARRAY_SIZE(lanes);
+		*lane_out = lane;
+
+		return CONTAINER_OF(node, struct pool_start_msg, node);
+	}
+
+	return NULL;
+}
+
+static void thread_pool_entry(void *p1, void *p2, void *p3)
+{
+	struct pool_start_msg *msg;
+	struct dispatch_lane *lane;
+	k_spinlock_key_t key;
+	bool pending;
+
+	do {
+		k_sem_take(&dispatch_sem, K_FOREVER);
+
+		key = k_spin_lock(&dispatch_lock);
+		msg = dispatch_next(&lane);
+		k_spin_unlock(&dispatch_lock, key);
+
+		if (msg == NULL) {
+			/* All pending packets belong to lanes at their thread limit. The thread
+			 * that finishes first signals again.
+			 */
+			continue;
+		}
+
+		packet_execute(msg);
+		k_mem_slab_free(&pool_msg_slab, msg);
+
+		key = k_spin_lock(&dispatch_lock);
+		lane->active--;
+		pending = !sys_slist_is_empty(&lane->msgs);
+		k_spin_unlock(&dispatch_lock, key);
+
+		if (pending) {
+			k_sem_give(&dispatch_sem);
+		}
+	} while (1);
+}
+#else
 static void thread_pool_entry(void *p1, void *p2, void *p3)
 {
 	struct pool_start_msg msg;
 
 	do {
 		k_msgq_get(&pool_start_msg, &msg, K_FOREVER);
-		thread_pool_callback(msg.data, msg.len);
+		packet_execute(&msg);
 	} while (1);
 }
+#endif /* CONFIG_NRF_RPC_OS_GROUP_DISPATCH */
 
 int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 {
@@ -73,9 +217,18 @@ int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 
 	atomic_set(&context_mask, CONTEXT_MASK_INIT_VALUE);
 
+#if defined(CONFIG_NRF_RPC_OS_GROUP_DISPATCH)
+	k_sem_init(&dispatch_sem, 0, K_SEM_MAX_LIMIT);
+
+	for (i = 0; i < ARRAY_SIZE(lanes); i++) {
+		sys_slist_init(&lanes[i].msgs);
+		lanes[i].active = 0;
+	}
+#else
 	k_msgq_init(&pool_start_msg, (char *)pool_start_msg_buf,
 		    sizeof(struct pool_start_msg),
 		    ARRAY_SIZE(pool_start_msg_buf));
+#endif
 
 	for (i = 0; i < CONFIG_NRF_RPC_THREAD_POOL_SIZE; i++) {
 		k_thread_create(&pool_threads[i], pool_stacks[i],
@@ -89,14 +242,42 @@ int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 	return 0;
 }
 
+#if defined(CONFIG_NRF_RPC_OS_GROUP_DISPATCH)
+void nrf_rpc_os_thread_pool_send(const uint8_t *data, size_t len)
+{
+	struct pool_start_msg *msg;
+	struct dispatch_lane *lane;
+	k_spinlock_key_t key;
+
+	(void)k_mem_slab_alloc(&pool_msg_slab, (void **)&msg, K_FOREVER);
+
+	msg->data = data;
+	msg->len = len;
+#if defined(CONFIG_NRF_RPC_OS_GROUP_STATS)
+	msg->send_cycles = k_cycle_get_32();
+#endif
+
+	lane = &lanes[packet_group_id(data, len) % ARRAY_SIZE(lanes)];
+
+	key = k_spin_lock(&dispatch_lock);
+	sys_slist_append(&lane->msgs, &msg->node);
+	k_spin_unlock(&dispatch_lock, key);
+
+	k_sem_give(&dispatch_sem);
+}
+#else
 void nrf_rpc_os_thread_pool_send(const uint8_t *data, size_t len)
 {
 	struct pool_start_msg msg;
 
 	msg.data = data;
 	msg.len = len;
+#if defined(CONFIG_NRF_RPC_OS_GROUP_STATS)
+	msg.send_cycles = k_cycle_get_32();
+#endif
 	k_msgq_put(&pool_start_msg, &msg, K_FOREVER);
 }
+#endif /* CONFIG_NRF_RPC_OS_GROUP_DISPATCH */
 
 void nrf_rpc_os_msg_set(struct nrf_rpc_os_msg *msg, const uint8_t *data,
 			size_t len)
@@ -154,3 +335,86 @@ void nrf_rpc_os_ctx_pool_release(uint32_t number)
 	atomic_or(&context_mask, 0x80000000u >> number);
 	k_sem_give(&context_reserved);
 }
+
+#if defined(CONFIG_NRF_RPC_OS_GROUP_STATS)
+int nrf_rpc_os_group_stats_get(uint8_t group_id, struct nrf_rpc_os_group_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	if (group_id >= ARRAY_SIZE(group_stats)) {
+		return -NRF_EINVAL;
+	}
+
+	key = k_spin_lock(&stats_lock);
+	*stats = group_stats[group_id];
+	k_spin_unlock(&stats_lock, key);
+
+	return 0;
+}
+
+void nrf_rpc_os_group_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	memset(group_stats, 0, sizeof(group_stats));
+	k_spin_unlock(&stats_lock, key);
+}
+#endif /* CONFIG_NRF_RPC_OS_GROUP_STATS */
+
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+static int rx_buf_index(const void *ptr)
+{
+	uintptr_t offset = (uintptr_t)ptr - (uintptr_t)rx_bufs;
+
+	if ((uintptr_t)ptr < (uintptr_t)rx_bufs || offset >= sizeof(rx_bufs)) {
+		return -1;
+	}
+
+	return offset / CONFIG_NRF_RPC_OS_RX_BUF_SIZE;
+}
+
+void *nrf_rpc_os_rx_buf_alloc(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(rx_bufs); i++) {
+		if (atomic_cas(&rx_buf_refs[i], 0, 1)) {
+			return rx_bufs[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool nrf_rpc_os_rx_buf_contains(const void *ptr)
+{
+	return rx_buf_index(ptr) >= 0;
+}
+
+void nrf_rpc_os_rx_buf_ref(const void *ptr)
+{
+	int idx = rx_buf_index(ptr);
+
+	__ASSERT_NO_MSG(idx >= 0);
+	__ASSERT_NO_MSG(atomic_get(&rx_buf_refs[idx]) > 0);
+
+	atomic_inc(&rx_buf_refs[idx]);
+}
+
+void nrf_rpc_os_rx_buf_unref(const void *ptr)
+{
+	int idx = rx_buf_index(ptr);
+
+	__ASSERT_NO_MSG(idx >= 0);
+	__ASSERT_NO_MSG(atomic_get(&rx_buf_refs[idx]) > 0);
+
+	atomic_dec(&rx_buf_refs[idx]);
+}
+
+bool nrf_rpc_os_rx_buf_shared(const void *ptr)
+{
+	int idx = rx_buf_index(ptr);
+
+	__ASSERT_NO_MSG(idx >= 0);
+
+	return atomic_get(&rx_buf_refs[idx]) > 1;
+}
+#endif /* CONFIG_NRF_RPC_OS_RX_BUF_POOL */
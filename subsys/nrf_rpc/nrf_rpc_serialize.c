@@ -7,6 +7,7 @@
 #include <string.h>
 #include <nrf_rpc/nrf_rpc_cbkproxy.h>
 #include <nrf_rpc/nrf_rpc_serialize.h>
+#include <nrf_rpc_os.h>
 
 static inline bool is_decoder_invalid(const struct nrf_rpc_cbor_ctx *ctx)
 {
@@ -282,6 +283,40 @@ const void *nrf_rpc_decode_buffer_ptr_and_size(struct nrf_rpc_cbor_ctx *ctx, siz
 	return zst.value;
 }
 
+const void *nrf_rpc_decode_buffer_borrow(struct nrf_rpc_scratchpad *scratchpad, size_t *size)
+{
+	const void *ptr = nrf_rpc_decode_buffer_ptr_and_size(scratchpad->ctx, size);
+	void *copy;
+
+	if (ptr == NULL) {
+		return NULL;
+	}
+
+	if (IS_ENABLED(CONFIG_NRF_RPC_OS_RX_BUF_POOL) && nrf_rpc_os_rx_buf_contains(ptr)) {
+		nrf_rpc_os_rx_buf_ref(ptr);
+		return ptr;
+	}
+
+	/* The packet is owned by the transport and released when decoding is done */
+	copy = nrf_rpc_scratchpad_add(scratchpad, *size);
+	if (!copy) {
+		nrf_rpc_decoder_invalid(scratchpad->ctx, ZCBOR_ERR_UNKNOWN);
+		return NULL;
+	}
+
+	memcpy(copy, ptr, *size);
+
+	return copy;
+}
+
+void nrf_rpc_buffer_release(const void *buffer)
+{
+	if (IS_ENABLED(CONFIG_NRF_RPC_OS_RX_BUF_POOL) && buffer != NULL &&
+	    nrf_rpc_os_rx_buf_contains(buffer)) {
+		nrf_rpc_os_rx_buf_unref(buffer);
+	}
+}
+
 char *nrf_rpc_decode_str(struct nrf_rpc_cbor_ctx *ctx, char *buffer, size_t buffer_size)
 {
 	struct zcbor_string zst;
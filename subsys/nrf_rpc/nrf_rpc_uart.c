@@ -8,6 +8,7 @@
 #include <nrf_rpc_tr.h>
 #include <nrf_rpc/nrf_rpc_uart.h>
 #include <nrf_rpc_errno.h>
+#include <nrf_rpc_os.h>
 
 #include <zephyr/drivers/uart.h>
 #include <zephyr/logging/log.h>
@@ -19,6 +20,55 @@ LOG_MODULE_REGISTER(nrf_rpc_uart, CONFIG_NRF_RPC_TR_LOG_LEVEL);
 
 #define CRC_SIZE sizeof(uint16_t)
 
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+BUILD_ASSERT(CONFIG_NRF_RPC_OS_RX_BUF_SIZE >= CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE,
+	     "Receive buffers must fit the maximum packet size");
+#endif
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+#define WINDOW_SIZE CONFIG_NRF_RPC_UART_WINDOW_SIZE
+BUILD_ASSERT(IS_POWER_OF_TWO(WINDOW_SIZE), "Window size must be a power of two");
+BUILD_ASSERT(WINDOW_SIZE <= 32, "Window size must fit in the selective ACK bitmap");
+
+#define SEQ_MASK	 0x7fu
+#define SEQ_NEXT(seq)	 (((seq) + 1) & SEQ_MASK)
+#define SEQ_DIFF(a, b)	 (((a) - (b)) & SEQ_MASK)
+#define SEQ_SLOT(seq)	 ((seq) & (WINDOW_SIZE - 1))
+
+/* Frames of the windowed mode use a different CRC seed, so they are dropped by the CRC check of
+ * a peer that does not support the windowed mode, and vice versa.
+ */
+#define WINDOW_CRC_SEED 0x1d0fu
+
+/* The first byte of a windowed frame is the sequence number of a data frame, or the ACK flag
+ * combined with the sequence number of the next expected frame, followed by the selective ACK
+ * bitmap.
+ */
+#define WINDOW_ACK_FLAG 0x80u
+#define WINDOW_ACK_SIZE (1 + sizeof(uint32_t) + CRC_SIZE)
+#define ACK_FRAME_SIZE	WINDOW_ACK_SIZE
+
+/* Control frames consist of a single byte, which is silently ignored by legacy peers. The lower
+ * nibble holds the base-2 logarithm of the window size.
+ */
+#define CTRL_TYPE_MASK	 0xf0u
+#define CTRL_WINDOW_MASK 0x0fu
+#define CTRL_CAP_REQ	 0xa0u
+#define CTRL_CAP_RSP	 0xb0u
+#define CTRL_START	 0xc0u
+
+/* Position of the packet type in the nRF RPC header */
+#define HEADER_TYPE_IDX 0
+
+/* Bits in nrf_rpc_uart.win_flags */
+enum {
+	WIN_FLAG_TX_WINDOWED,
+	WIN_FLAG_TX_RESTART,
+};
+#else
+#define ACK_FRAME_SIZE CRC_SIZE
+#endif /* CONFIG_NRF_RPC_UART_WINDOW */
+
 enum {
 	HDLC_CHAR_ESCAPE = 0x7d,
 	HDLC_CHAR_DELIMITER = 0x7e,
@@ -54,6 +104,21 @@ struct hdlc_decode_ctx {
 	uint16_t capacity;
 };
 
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+struct tx_slot {
+	/* Packet owned by the transport until it is acknowledged */
+	const uint8_t *data;
+	size_t len;
+	int64_t deadline;
+	uint8_t attempts;
+	bool acked;
+	/* Selective ACK reported the frame missing */
+	bool nacked;
+	/* The last transmission was a fast retransmission */
+	bool fast_retx;
+};
+#endif /* CONFIG_NRF_RPC_UART_WINDOW */
+
 struct nrf_rpc_uart {
 	const struct device *uart;
 	nrf_rpc_tr_receive_handler_t receive_callback;
@@ -72,11 +137,17 @@ struct nrf_rpc_uart {
 
 	/* HDLC ack decoding state */
 	struct hdlc_decode_ctx rx_ack_ctx;
-	uint8_t rx_ack[CRC_SIZE];
+	uint8_t rx_ack[ACK_FRAME_SIZE];
 
 	/* HDLC packet decoding state */
 	struct hdlc_decode_ctx rx_pkt_ctx;
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+	/* Receive buffer from the nRF RPC OS pool, or rx_pkt_buf if the pool is exhausted */
+	uint8_t *rx_pkt;
+	uint8_t rx_pkt_buf[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE];
+#else
 	uint8_t rx_pkt[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE];
+#endif
 
 	/* Ack waiting semaphore */
 	struct k_sem ack_sem;
@@ -86,6 +157,35 @@ struct nrf_rpc_uart {
 
 	/* TX lock */
 	struct k_mutex tx_lock;
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	/* Window size advertised by the peer, 0 if the peer does not support the windowed mode */
+	atomic_t peer_window;
+	atomic_t win_flags;
+
+	/* TX window. The slot state is protected by win_lock, as it is updated from the ISR.
+	 * The packet memory is protected by win_mutex.
+	 */
+	struct tx_slot tx_slots[WINDOW_SIZE];
+	uint8_t tx_base;
+	uint8_t tx_next;
+	uint8_t tx_window;
+	struct k_spinlock win_lock;
+	struct k_mutex win_mutex;
+	struct k_sem win_sem;
+	struct k_work_delayable retx_work;
+	/* Unacknowledged packets dropped while win_mutex was held, reported on unlock */
+	uint8_t tx_lost;
+	uint8_t tx_lost_type;
+
+	/* RX window, protected by ack_tx_lock */
+	bool rx_windowed;
+	uint8_t rx_expected;
+	uint8_t rx_unacked;
+	uint32_t rx_ooo_bm;
+	uint8_t *rx_ooo[WINDOW_SIZE];
+	size_t rx_ooo_len[WINDOW_SIZE];
+#endif /* CONFIG_NRF_RPC_UART_WINDOW */
 };
 
 static void log_hexdump_dbg(const uint8_t *data, size_t length, const char *fmt, ...)
@@ -104,8 +204,41 @@ static void log_hexdump_dbg(const uint8_t *data, size_t length, const char *fmt,
 
 static void send_byte(const struct device *dev, uint8_t byte);
 
+static void frame_write(const struct device *dev, const uint8_t *hdr, size_t hdr_len,
+			const uint8_t *data, size_t length, uint16_t crc_val)
+{
+	uint8_t crc[CRC_SIZE];
+
+	uart_poll_out(dev, HDLC_CHAR_DELIMITER);
+
+	for (size_t i = 0; i < hdr_len; i++) {
+		send_byte(dev, hdr[i]);
+	}
+
+	for (size_t i = 0; i < length; i++) {
+		send_byte(dev, data[i]);
+	}
+
+	sys_put_le16(crc_val, crc);
+	send_byte(dev, crc[0]);
+	send_byte(dev, crc[1]);
+
+	uart_poll_out(dev, HDLC_CHAR_DELIMITER);
+}
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+static void window_ack_rx(struct nrf_rpc_uart *uart_tr);
+#endif
+
 static void ack_rx(struct nrf_rpc_uart *uart_tr)
 {
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	if (uart_tr->rx_ack_ctx.len == WINDOW_ACK_SIZE) {
+		window_ack_rx(uart_tr);
+		return;
+	}
+#endif
+
 	if (!IS_ENABLED(CONFIG_NRF_RPC_UART_RELIABLE) || uart_tr->rx_ack_ctx.len != CRC_SIZE) {
 		log_hexdump_dbg(uart_tr->rx_ack, uart_tr->rx_ack_ctx.len, ">>> RX invalid frame");
 		return;
@@ -190,6 +323,496 @@ static bool crc_compare(uint16_t rx_crc, uint16_t calc_crc)
 	return rx_crc == calc_crc;
 }
 
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+static uint8_t window_log2(uint8_t window)
+{
+	return find_lsb_set(window) - 1;
+}
+
+static void ctrl_tx(struct nrf_rpc_uart *uart_tr, uint8_t ctrl)
+{
+	k_mutex_lock(&uart_tr->ack_tx_lock, K_FOREVER);
+	LOG_DBG("<<< TX control %02x", ctrl);
+
+	uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+	send_byte(uart_tr->uart, ctrl);
+	uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+
+	k_mutex_unlock(&uart_tr->ack_tx_lock);
+}
+
+static void ctrl_rx(struct nrf_rpc_uart *uart_tr, uint8_t ctrl)
+{
+	uint8_t window = MIN(BIT(MIN(ctrl & CTRL_WINDOW_MASK, 7)), WINDOW_SIZE);
+
+	LOG_DBG(">>> RX control %02x", ctrl);
+
+	switch (ctrl & CTRL_TYPE_MASK) {
+	case CTRL_CAP_REQ:
+		/* The peer has just started, so it has lost the state of our TX window */
+		atomic_set(&uart_tr->peer_window, window);
+		atomic_set_bit(&uart_tr->win_flags, WIN_FLAG_TX_RESTART);
+		k_sem_give(&uart_tr->win_sem);
+		ctrl_tx(uart_tr, CTRL_CAP_RSP | window_log2(WINDOW_SIZE));
+		break;
+	case CTRL_CAP_RSP:
+		atomic_set(&uart_tr->peer_window, window);
+		break;
+	case CTRL_START:
+		k_mutex_lock(&uart_tr->ack_tx_lock, K_FOREVER);
+
+		for (size_t i = 0; i < ARRAY_SIZE(uart_tr->rx_ooo); i++) {
+			k_free(uart_tr->rx_ooo[i]);
+			uart_tr->rx_ooo[i] = NULL;
+		}
+
+		uart_tr->rx_windowed = true;
+		uart_tr->rx_expected = 0;
+		uart_tr->rx_unacked = 0;
+		uart_tr->rx_ooo_bm = 0;
+
+		k_mutex_unlock(&uart_tr->ack_tx_lock);
+		LOG_INF("Windowed mode started by peer, window %u", window);
+		break;
+	default:
+		LOG_DBG("Unknown control frame %02x", ctrl);
+		break;
+	}
+}
+
+static void window_ack_tx(struct nrf_rpc_uart *uart_tr)
+{
+	uint8_t ack[WINDOW_ACK_SIZE - CRC_SIZE];
+
+	k_mutex_lock(&uart_tr->ack_tx_lock, K_FOREVER);
+
+	if (!uart_tr->rx_windowed || uart_tr->rx_unacked == 0) {
+		k_mutex_unlock(&uart_tr->ack_tx_lock);
+		return;
+	}
+
+	ack[0] = WINDOW_ACK_FLAG | uart_tr->rx_expected;
+	sys_put_le32(uart_tr->rx_ooo_bm, &ack[1]);
+
+	LOG_DBG("<<< TX window ack %02x %08x", uart_tr->rx_expected, uart_tr->rx_ooo_bm);
+
+	frame_write(uart_tr->uart, NULL, 0, ack, sizeof(ack),
+		    crc16_ccitt(WINDOW_CRC_SEED, ack, sizeof(ack)));
+	uart_tr->rx_unacked = 0;
+
+	k_mutex_unlock(&uart_tr->ack_tx_lock);
+}
+
+/* Called from the ISR. */
+static void window_ack_rx(struct nrf_rpc_uart *uart_tr)
+{
+	const uint8_t *ack = uart_tr->rx_ack;
+	uint8_t ack_next;
+	uint32_t sack;
+	uint8_t sack_span;
+	bool gap = false;
+	k_spinlock_key_t key;
+
+	if (!(ack[0] & WINDOW_ACK_FLAG) ||
+	    crc16_ccitt(WINDOW_CRC_SEED, ack, WINDOW_ACK_SIZE - CRC_SIZE) !=
+		    sys_get_le16(&ack[WINDOW_ACK_SIZE - CRC_SIZE])) {
+		/* A short data frame */
+		return;
+	}
+
+	ack_next = ack[0] & SEQ_MASK;
+	sack = sys_get_le32(&ack[1]);
+	/* Frames before the last one reported by the selective ACK are missing */
+	sack_span = (sack != 0) ? (32 - __builtin_clz(sack)) : 0;
+
+	key = k_spin_lock(&uart_tr->win_lock);
+
+	if (SEQ_DIFF(ack_next, uart_tr->tx_base) > SEQ_DIFF(uart_tr->tx_next, uart_tr->tx_base)) {
+		k_spin_unlock(&uart_tr->win_lock, key);
+		LOG_DBG("Stale ack %02x", ack_next);
+		return;
+	}
+
+	for (uint8_t seq = uart_tr->tx_base; seq != uart_tr->tx_next; seq = SEQ_NEXT(seq)) {
+		struct tx_slot *slot = &uart_tr->tx_slots[SEQ_SLOT(seq)];
+		uint8_t offset = SEQ_DIFF(seq, ack_next);
+
+		if (SEQ_DIFF(seq, uart_tr->tx_base) < SEQ_DIFF(ack_next, uart_tr->tx_base)) {
+			slot->acked = true;
+		} else if (offset > 0 && (sack & BIT(offset - 1))) {
+			slot->acked = true;
+		} else if (offset < sack_span && !slot->acked && !slot->fast_retx) {
+			slot->nacked = true;
+			gap = true;
+		}
+	}
+
+	k_spin_unlock(&uart_tr->win_lock, key);
+
+	k_sem_give(&uart_tr->win_sem);
+
+	if (gap) {
+		k_work_reschedule(&uart_tr->retx_work, K_NO_WAIT);
+	}
+}
+
+static void window_frame_tx(struct nrf_rpc_uart *uart_tr, uint8_t seq, const struct tx_slot *slot)
+{
+	uint16_t crc_val = crc16_ccitt(WINDOW_CRC_SEED, &seq, 1);
+
+	crc_val = crc16_ccitt(crc_val, slot->data, slot->len);
+	log_hexdump_dbg(slot->data, slot->len, "<<< TX frame %02x", seq);
+
+	k_mutex_lock(&uart_tr->ack_tx_lock, K_FOREVER);
+	frame_write(uart_tr->uart, &seq, 1, slot->data, slot->len, crc_val);
+	k_mutex_unlock(&uart_tr->ack_tx_lock);
+}
+
+/* Free acknowledged packets at the start of the window. Must be called with win_mutex held. */
+static void window_reclaim(struct nrf_rpc_uart *uart_tr)
+{
+	while (true) {
+		k_spinlock_key_t key = k_spin_lock(&uart_tr->win_lock);
+		struct tx_slot *slot = &uart_tr->tx_slots[SEQ_SLOT(uart_tr->tx_base)];
+		const uint8_t *data = slot->data;
+
+		if (uart_tr->tx_base == uart_tr->tx_next || !slot->acked) {
+			k_spin_unlock(&uart_tr->win_lock, key);
+			return;
+		}
+
+		slot->data = NULL;
+		uart_tr->tx_base = SEQ_NEXT(uart_tr->tx_base);
+		k_spin_unlock(&uart_tr->win_lock, key);
+
+		k_free((void *)data);
+	}
+}
+
+/* Drop all packets in the window. The packets that have not been acknowledged are reported as
+ * lost when win_mutex is released. Must be called with win_mutex held.
+ */
+static void window_drop(struct nrf_rpc_uart *uart_tr)
+{
+	k_spinlock_key_t key = k_spin_lock(&uart_tr->win_lock);
+	uint8_t base = uart_tr->tx_base;
+	uint8_t next = uart_tr->tx_next;
+
+	uart_tr->tx_base = next;
+	k_spin_unlock(&uart_tr->win_lock, key);
+
+	for (uint8_t seq = base; seq != next; seq = SEQ_NEXT(seq)) {
+		struct tx_slot *slot = &uart_tr->tx_slots[SEQ_SLOT(seq)];
+
+		if (!slot->acked) {
+			if (uart_tr->tx_lost == 0) {
+				uart_tr->tx_lost_type = slot->data[HEADER_TYPE_IDX];
+			}
+
+			uart_tr->tx_lost++;
+		}
+
+		k_free((void *)slot->data);
+		slot->data = NULL;
+	}
+
+	(void)k_work_cancel_delayable(&uart_tr->retx_work);
+}
+
+/* Release win_mutex. The sender has already been told that the dropped packets were sent, so
+ * their loss is reported to the nRF RPC error handler instead.
+ */
+static void window_unlock(struct nrf_rpc_uart *uart_tr)
+{
+	uint8_t lost = uart_tr->tx_lost;
+	uint8_t type = uart_tr->tx_lost_type;
+
+	uart_tr->tx_lost = 0;
+	k_mutex_unlock(&uart_tr->win_mutex);
+
+	if (lost > 0) {
+		LOG_ERR("%u packets not acknowledged", lost);
+		nrf_rpc_err(-EPROTO, NRF_RPC_ERR_SRC_SEND, NULL, NRF_RPC_ID_UNKNOWN, type);
+	}
+}
+
+/* Switch the TX direction to the windowed mode once the peer supports it. Must be called with
+ * win_mutex held.
+ */
+static void window_tx_update(struct nrf_rpc_uart *uart_tr)
+{
+	uint8_t window;
+
+	if (atomic_test_and_clear_bit(&uart_tr->win_flags, WIN_FLAG_TX_RESTART) &&
+	    atomic_test_and_clear_bit(&uart_tr->win_flags, WIN_FLAG_TX_WINDOWED)) {
+		LOG_WRN("Peer restarted, dropping the TX window");
+		window_drop(uart_tr);
+	}
+
+	window = atomic_get(&uart_tr->peer_window);
+
+	if (window == 0 || atomic_test_bit(&uart_tr->win_flags, WIN_FLAG_TX_WINDOWED)) {
+		return;
+	}
+
+	uart_tr->tx_window = window;
+	uart_tr->tx_base = 0;
+	uart_tr->tx_next = 0;
+
+	/* The peer resets its RX window when it receives this frame */
+	ctrl_tx(uart_tr, CTRL_START | window_log2(window));
+	atomic_set_bit(&uart_tr->win_flags, WIN_FLAG_TX_WINDOWED);
+
+	LOG_INF("Windowed mode started, window %u", window);
+}
+
+static void window_fail(struct nrf_rpc_uart *uart_tr)
+{
+	LOG_ERR("Packet not acknowledged, falling back to stop-and-wait mode");
+
+	window_drop(uart_tr);
+	atomic_set(&uart_tr->peer_window, 0);
+	atomic_clear_bit(&uart_tr->win_flags, WIN_FLAG_TX_WINDOWED);
+	k_sem_give(&uart_tr->win_sem);
+}
+
+static void retx_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct nrf_rpc_uart *uart_tr = CONTAINER_OF(dwork, struct nrf_rpc_uart, retx_work);
+	int64_t next_deadline = INT64_MAX;
+
+	k_mutex_lock(&uart_tr->win_mutex, K_FOREVER);
+
+	window_tx_update(uart_tr);
+
+	if (!atomic_test_bit(&uart_tr->win_flags, WIN_FLAG_TX_WINDOWED)) {
+		window_unlock(uart_tr);
+		return;
+	}
+
+	window_reclaim(uart_tr);
+
+	for (uint8_t seq = uart_tr->tx_base; seq != uart_tr->tx_next; seq = SEQ_NEXT(seq)) {
+		struct tx_slot *slot = &uart_tr->tx_slots[SEQ_SLOT(seq)];
+		k_spinlock_key_t key = k_spin_lock(&uart_tr->win_lock);
+		bool pending = !slot->acked;
+		bool nacked = slot->nacked;
+		bool expired = k_uptime_get() >= slot->deadline;
+		bool last_attempt = slot->attempts >= CONFIG_NRF_RPC_UART_TX_ATTEMPTS;
+		bool resend = pending && (nacked || expired) && !last_attempt;
+
+		slot->nacked = false;
+
+		if (resend) {
+			slot->attempts++;
+			slot->fast_retx = nacked;
+			slot->deadline = k_uptime_get() + CONFIG_NRF_RPC_UART_ACK_WAITING_TIME;
+		}
+
+		k_spin_unlock(&uart_tr->win_lock, key);
+
+		if (pending && expired && last_attempt) {
+			window_fail(uart_tr);
+			window_unlock(uart_tr);
+			return;
+		}
+
+		if (!resend) {
+			if (pending) {
+				next_deadline = MIN(next_deadline, slot->deadline);
+			}
+			continue;
+		}
+
+		LOG_DBG("Retransmitting frame %02x%s", seq, nacked ? " (selective)" : "");
+		window_frame_tx(uart_tr, seq, slot);
+		next_deadline = MIN(next_deadline, slot->deadline);
+	}
+
+	if (next_deadline != INT64_MAX) {
+		k_work_reschedule(dwork, K_MSEC(MAX(next_deadline - k_uptime_get(), 0)));
+	}
+
+	window_unlock(uart_tr);
+}
+
+/**
+ * @brief Send a packet in the windowed mode.
+ *
+ * @retval 0		The packet is queued for transmission, the transport frees it once
+ *			acknowledged. If the packet is not acknowledged after all transmission
+ *			attempts, the failure is reported to the nRF RPC error handler.
+ * @retval -EAGAIN	The windowed mode is not active, the packet must be sent in the
+ *			stop-and-wait mode.
+ */
+static int window_send(struct nrf_rpc_uart *uart_tr, const uint8_t *data, size_t length)
+{
+	struct tx_slot *slot;
+	k_spinlock_key_t key;
+	uint8_t seq;
+
+	k_mutex_lock(&uart_tr->win_mutex, K_FOREVER);
+
+	while (true) {
+		window_tx_update(uart_tr);
+
+		if (!atomic_test_bit(&uart_tr->win_flags, WIN_FLAG_TX_WINDOWED)) {
+			window_unlock(uart_tr);
+			return -EAGAIN;
+		}
+
+		window_reclaim(uart_tr);
+
+		if (SEQ_DIFF(uart_tr->tx_next, uart_tr->tx_base) < uart_tr->tx_window) {
+			break;
+		}
+
+		window_unlock(uart_tr);
+
+		/* The peer may be waiting for ACKs from us as well, so do not keep them pending
+		 * while blocked.
+		 */
+		window_ack_tx(uart_tr);
+		k_sem_take(&uart_tr->win_sem, K_FOREVER);
+
+		k_mutex_lock(&uart_tr->win_mutex, K_FOREVER);
+	}
+
+	seq = uart_tr->tx_next;
+	slot = &uart_tr->tx_slots[SEQ_SLOT(seq)];
+
+	key = k_spin_lock(&uart_tr->win_lock);
+	slot->data = data;
+	slot->len = length;
+	slot->attempts = 1;
+	slot->acked = false;
+	slot->nacked = false;
+	slot->fast_retx = false;
+	slot->deadline = k_uptime_get() + CONFIG_NRF_RPC_UART_ACK_WAITING_TIME;
+	uart_tr->tx_next = SEQ_NEXT(seq);
+	k_spin_unlock(&uart_tr->win_lock, key);
+
+	window_frame_tx(uart_tr, seq, slot);
+	k_work_schedule(&uart_tr->retx_work, K_MSEC(CONFIG_NRF_RPC_UART_ACK_WAITING_TIME));
+
+	window_unlock(uart_tr);
+
+	return 0;
+}
+
+/**
+ * @brief Handle a frame that may belong to the windowed mode.
+ *
+ * @retval true		The frame was a windowed frame and has been handled.
+ * @retval false	The frame must be handled as a legacy frame.
+ */
+static bool window_frame_rx(struct nrf_rpc_uart *uart_tr, size_t len, uint16_t crc_received)
+{
+	const uint8_t *data;
+	size_t data_len;
+	uint8_t seq;
+	uint8_t offset;
+	bool owned = false;
+
+	if (len < 2 || crc16_ccitt(WINDOW_CRC_SEED, uart_tr->rx_pkt, len) != crc_received) {
+		return false;
+	}
+
+	if (uart_tr->rx_pkt[0] & WINDOW_ACK_FLAG) {
+		/* ACKs are already handled in ISR */
+		return true;
+	}
+
+	seq = uart_tr->rx_pkt[0];
+	data = &uart_tr->rx_pkt[1];
+	data_len = len - 1;
+
+	log_hexdump_dbg(data, data_len, ">>> RX frame %02x", seq);
+
+	k_mutex_lock(&uart_tr->ack_tx_lock, K_FOREVER);
+
+	if (!uart_tr->rx_windowed) {
+		k_mutex_unlock(&uart_tr->ack_tx_lock);
+		LOG_WRN("Windowed frame %02x before start", seq);
+		return true;
+	}
+
+	offset = SEQ_DIFF(seq, uart_tr->rx_expected);
+	uart_tr->rx_unacked++;
+
+	if (offset != 0) {
+		if (offset < WINDOW_SIZE && !(uart_tr->rx_ooo_bm & BIT(offset - 1))) {
+			uint8_t *copy = k_malloc(data_len);
+
+			/* Keep the frame until the missing ones are retransmitted. If there is
+			 * no memory, the frame is retransmitted as well.
+			 */
+			if (copy) {
+				memcpy(copy, data, data_len);
+				uart_tr->rx_ooo[SEQ_SLOT(seq)] = copy;
+				uart_tr->rx_ooo_len[SEQ_SLOT(seq)] = data_len;
+				uart_tr->rx_ooo_bm |= BIT(offset - 1);
+			}
+
+			LOG_DBG("Out of order frame %02x, expected %02x", seq,
+				uart_tr->rx_expected);
+		} else {
+			LOG_DBG("Duplicate frame %02x", seq);
+		}
+
+		k_mutex_unlock(&uart_tr->ack_tx_lock);
+
+		/* Report the gap or the duplicate right away */
+		window_ack_tx(uart_tr);
+		return true;
+	}
+
+	k_mutex_unlock(&uart_tr->ack_tx_lock);
+
+	/* Deliver the frame and all following frames that were received out of order */
+	while (data) {
+		const uint8_t *next = NULL;
+		size_t next_len = 0;
+		bool ack_now;
+
+		k_mutex_lock(&uart_tr->ack_tx_lock, K_FOREVER);
+
+		uart_tr->rx_expected = SEQ_NEXT(uart_tr->rx_expected);
+
+		if (uart_tr->rx_ooo_bm & BIT(0)) {
+			uint8_t slot = SEQ_SLOT(uart_tr->rx_expected);
+
+			next = uart_tr->rx_ooo[slot];
+			next_len = uart_tr->rx_ooo_len[slot];
+			uart_tr->rx_ooo[slot] = NULL;
+		}
+
+		uart_tr->rx_ooo_bm >>= 1;
+		ack_now = uart_tr->rx_unacked >= MAX(WINDOW_SIZE / 2, 1);
+
+		k_mutex_unlock(&uart_tr->ack_tx_lock);
+
+		/* Acknowledge in batches, but keep the peer's window open while processing */
+		if (ack_now) {
+			window_ack_tx(uart_tr);
+		}
+
+		uart_tr->receive_callback(uart_tr->transport, data, data_len, uart_tr->receive_ctx);
+
+		if (owned) {
+			k_free((void *)data);
+		}
+
+		data = next;
+		data_len = next_len;
+		owned = true;
+	}
+
+	return true;
+}
+#endif /* CONFIG_NRF_RPC_UART_WINDOW */
+
 static void hdlc_decode_byte(struct hdlc_decode_ctx *ctx, uint8_t *out, uint8_t in)
 {
 	switch (ctx->state) {
@@ -229,14 +852,79 @@ static void hdlc_decode_byte(struct hdlc_decode_ctx *ctx, uint8_t *out, uint8_t
 	out[ctx->len++] = in;
 }
 
+/* Decoders may keep a reference to the last packet, so decode the next one into a free buffer */
+static void rx_pkt_renew(struct nrf_rpc_uart *uart_tr)
+{
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+	uint8_t *buf;
+
+	if (uart_tr->rx_pkt != uart_tr->rx_pkt_buf && !nrf_rpc_os_rx_buf_shared(uart_tr->rx_pkt)) {
+		return;
+	}
+
+	buf = nrf_rpc_os_rx_buf_alloc();
+
+	if (uart_tr->rx_pkt != uart_tr->rx_pkt_buf) {
+		nrf_rpc_os_rx_buf_unref(uart_tr->rx_pkt);
+	}
+
+	uart_tr->rx_pkt = (buf != NULL) ? buf : uart_tr->rx_pkt_buf;
+#endif
+}
+
+static void rx_frame_process(struct nrf_rpc_uart *uart_tr)
+{
+	uint16_t crc_received;
+	uint16_t crc_calculated;
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	if (uart_tr->rx_pkt_ctx.len == 1) {
+		ctrl_rx(uart_tr, uart_tr->rx_pkt[0]);
+		return;
+	}
+#endif
+
+	/* ACKs are already handled in ISR, so process only normal packets here */
+	if (uart_tr->rx_pkt_ctx.len <= CRC_SIZE) {
+		return;
+	}
+
+	uart_tr->rx_pkt_ctx.len -= CRC_SIZE;
+	crc_received = sys_get_le16(uart_tr->rx_pkt + uart_tr->rx_pkt_ctx.len);
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	if (window_frame_rx(uart_tr, uart_tr->rx_pkt_ctx.len, crc_received)) {
+		return;
+	}
+#endif
+
+	crc_calculated = crc16_ccitt(0xffff, uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len);
+
+	log_hexdump_dbg(uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len, ">>> RX packet %04x",
+			crc_received);
+
+	if (!crc_compare(crc_received, crc_calculated)) {
+		LOG_ERR("Invalid packet CRC: calculated %04x but received %04x", crc_calculated,
+			crc_received);
+		return;
+	}
+
+	ack_tx(uart_tr, crc_received);
+
+	if (rx_flip_check(uart_tr, crc_received)) {
+		LOG_WRN("Duplicate packet %04x", crc_received);
+	} else {
+		uart_tr->receive_callback(uart_tr->transport, uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len,
+					  uart_tr->receive_ctx);
+	}
+}
+
 static void work_handler(struct k_work *work)
 {
 	struct nrf_rpc_uart *uart_tr = CONTAINER_OF(work, struct nrf_rpc_uart, rx_work);
 	uint8_t *data;
 	size_t len;
 	int ret;
-	uint16_t crc_received = 0;
-	uint16_t crc_calculated = 0;
 
 	while (!ring_buf_is_empty(&uart_tr->rx_ringbuf)) {
 		len = ring_buf_get_claim(&uart_tr->rx_ringbuf, &data,
@@ -248,34 +936,8 @@ static void work_handler(struct k_work *work)
 				continue;
 			}
 
-			/* ACKs are already handled in ISR, so process only normal packets here */
-			if (uart_tr->rx_pkt_ctx.len <= CRC_SIZE) {
-				continue;
-			}
-
-			uart_tr->rx_pkt_ctx.len -= CRC_SIZE;
-			crc_received = sys_get_le16(uart_tr->rx_pkt + uart_tr->rx_pkt_ctx.len);
-			crc_calculated =
-				crc16_ccitt(0xffff, uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len);
-
-			log_hexdump_dbg(uart_tr->rx_pkt, uart_tr->rx_pkt_ctx.len,
-					">>> RX packet %04x", crc_received);
-
-			if (!crc_compare(crc_received, crc_calculated)) {
-				LOG_ERR("Invalid packet CRC: calculated %04x but received %04x",
-					crc_calculated, crc_received);
-				continue;
-			}
-
-			ack_tx(uart_tr, crc_received);
-
-			if (rx_flip_check(uart_tr, crc_received)) {
-				LOG_WRN("Duplicate packet %04x", crc_received);
-			} else {
-				uart_tr->receive_callback(uart_tr->transport, uart_tr->rx_pkt,
-							  uart_tr->rx_pkt_ctx.len,
-							  uart_tr->receive_ctx);
-			}
+			rx_frame_process(uart_tr);
+			rx_pkt_renew(uart_tr);
 		}
 
 		ret = ring_buf_get_finish(&uart_tr->rx_ringbuf, len);
@@ -283,6 +945,11 @@ static void work_handler(struct k_work *work)
 			LOG_DBG("Cannot flush ring buffer: %d", ret);
 		}
 	}
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	/* Acknowledge all frames received in this burst at once */
+	window_ack_tx(uart_tr);
+#endif
 }
 
 static void decode_ack(struct nrf_rpc_uart *inst, const uint8_t *in, size_t len)
@@ -380,6 +1047,14 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 		uart_tr->flips.rx_flip_any = 1;
 	}
 
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	k_mutex_init(&uart_tr->win_mutex);
+	k_sem_init(&uart_tr->win_sem, 0, 1);
+	k_work_init_delayable(&uart_tr->retx_work, retx_work_handler);
+	atomic_clear(&uart_tr->peer_window);
+	atomic_clear(&uart_tr->win_flags);
+#endif
+
 	k_work_queue_init(&uart_tr->rx_workq);
 	k_work_queue_start(&uart_tr->rx_workq, uart_tr->rx_workq_stack,
 			   K_THREAD_STACK_SIZEOF(uart_tr->rx_workq_stack), K_PRIO_PREEMPT(0),
@@ -389,10 +1064,24 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 	ring_buf_init(&uart_tr->rx_ringbuf, sizeof(uart_tr->rx_buffer), uart_tr->rx_buffer);
 
 	uart_tr->rx_pkt_ctx.state = HDLC_STATE_UNSYNC;
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+	uart_tr->rx_pkt = uart_tr->rx_pkt_buf;
+	rx_pkt_renew(uart_tr);
+	uart_tr->rx_pkt_ctx.capacity = sizeof(uart_tr->rx_pkt_buf);
+#else
 	uart_tr->rx_pkt_ctx.capacity = sizeof(uart_tr->rx_pkt);
+#endif
 	uart_tr->rx_ack_ctx.state = HDLC_STATE_UNSYNC;
 	uart_tr->rx_ack_ctx.capacity = sizeof(uart_tr->rx_ack);
 	uart_irq_rx_enable(uart_tr->uart);
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	/* Advertise the windowed mode. A legacy peer ignores the frame and the link stays in
+	 * the stop-and-wait mode.
+	 */
+	ctrl_tx(uart_tr, CTRL_CAP_REQ | window_log2(WINDOW_SIZE));
+#endif
+
 	nrf_rpc_uart_initialized_hook(uart_tr->uart);
 
 	return 0;
@@ -410,13 +1099,21 @@ static void send_byte(const struct device *dev, uint8_t byte)
 
 static int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t length)
 {
-	uint8_t crc[2];
 	uint16_t crc_val;
 	bool acked = true;
 	struct nrf_rpc_uart *uart_tr = transport->ctx;
 
 	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
 
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	int ret = window_send(uart_tr, data, length);
+
+	if (ret != -EAGAIN) {
+		k_mutex_unlock(&uart_tr->tx_lock);
+		return ret;
+	}
+#endif
+
 	crc_val = crc16_ccitt(0xffff, data, length);
 	crc_val = tx_flip(uart_tr, crc_val);
 	log_hexdump_dbg(data, length, "<<< TX packet %04x", crc_val);
@@ -433,17 +1130,7 @@ static int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t
 		k_sem_reset(&uart_tr->ack_sem);
 #endif /* CONFIG_NRF_RPC_UART_RELIABLE */
 
-		uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
-
-		for (size_t i = 0; i < length; i++) {
-			send_byte(uart_tr->uart, data[i]);
-		}
-
-		sys_put_le16(crc_val, crc);
-		send_byte(uart_tr->uart, crc[0]);
-		send_byte(uart_tr->uart, crc[1]);
-
-		uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+		frame_write(uart_tr->uart, NULL, 0, data, length, crc_val);
 
 #if CONFIG_NRF_RPC_UART_RELIABLE
 		k_mutex_unlock(&uart_tr->ack_tx_lock);
@@ -515,3 +1202,8 @@ const struct nrf_rpc_tr_api nrf_rpc_uart_service_api = {
 	};
 
 DT_FOREACH_STATUS_OKAY(nordic_nrf_uarte, NRF_RPC_UART_TRANSPORT_DEFINE);
+
+#if defined(CONFIG_UART_EMUL)
+/* Emulated UARTs allow to test the transport on native_sim */
+DT_FOREACH_STATUS_OKAY(zephyr_uart_emul, NRF_RPC_UART_TRANSPORT_DEFINE);
+#endif
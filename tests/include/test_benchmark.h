@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TEST_BENCHMARK_H_
+#define TEST_BENCHMARK_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup test_benchmark Test benchmark helper
+ * @brief Timing helper for benchmarks that run as part of a ztest suite.
+ *
+ * @{
+ */
+
+/** @brief Benchmark measurement. */
+struct test_benchmark {
+	/** Name printed with the result. */
+	const char *name;
+	/** Number of iterations the measured time is divided by. */
+	uint32_t iterations;
+	/** Time at which the measurement was started. */
+	uint64_t start_ns;
+};
+
+/**
+ * @brief Get the current benchmark time.
+ *
+ * On native_sim, the monotonic clock of the host is used, as the simulated
+ * time does not advance while the measured code runs. On other platforms,
+ * the kernel uptime is used.
+ *
+ * @return Time in nanoseconds.
+ */
+uint64_t test_benchmark_time_ns(void);
+
+/**
+ * @brief Start a measurement.
+ *
+ * @param bench       Measurement to start.
+ * @param name        Name printed with the result.
+ * @param iterations  Number of iterations that will be measured.
+ */
+void test_benchmark_start(struct test_benchmark *bench, const char *name, uint32_t iterations);
+
+/**
+ * @brief Stop a measurement and print the time per iteration.
+ *
+ * Fails the running test if no time has elapsed since the measurement was
+ * started, as the result would then not mean anything.
+ *
+ * @param bench  Measurement to stop.
+ *
+ * @return Time per iteration in nanoseconds.
+ */
+uint64_t test_benchmark_stop(struct test_benchmark *bench);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEST_BENCHMARK_H_ */
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <unity.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <modem/at_monitor.h>
+
+#include "cmock_nrf_modem_at.h"
+
+#define NOTIF_MAX_LEN 128
+
+struct mon_data {
+	int count;
+	char notif[NOTIF_MAX_LEN];
+};
+
+static struct mon_data cereg_data;
+static struct mon_data ereg_data;
+static struct mon_data cereg_isr_data;
+static struct mon_data cscon_data;
+static struct mon_data any_data;
+static struct mon_data xtime_isr_data;
+static struct mon_data cgev_data;
+
+/* Order in which notifications were dispatched to the +CGEV monitor */
+static int cgev_order[8];
+/* Number of +CGEV notifications to receive while dispatching the previous one */
+static int cgev_chain_left;
+/* Number of +CGEV notifications received with unexpected content */
+static int cgev_corrupt;
+
+/* at_monitor_dispatch() is implemented in at_monitor library and
+ * we'll call it directly to fake received AT notifications
+ */
+extern void at_monitor_dispatch(const char *at_notif);
+
+static void mon_data_update(struct mon_data *data, const char *notif)
+{
+	data->count++;
+	strncpy(data->notif, notif, sizeof(data->notif) - 1);
+}
+
+AT_MONITOR(mon_cereg, "+CEREG", on_cereg);
+AT_MONITOR(mon_ereg, "EREG", on_ereg);
+AT_MONITOR_ISR(mon_cereg_isr, "+CEREG", on_cereg_isr);
+AT_MONITOR(mon_cscon, "+CSCON", on_cscon, PAUSED);
+AT_MONITOR(mon_any, ANY, on_any, PAUSED);
+AT_MONITOR_ISR(mon_xtime_isr, "%XTIME", on_xtime_isr);
+AT_MONITOR(mon_cgev, "+CGEV", on_cgev);
+
+static void on_cereg(const char *notif)
+{
+	mon_data_update(&cereg_data, notif);
+}
+
+static void on_ereg(const char *notif)
+{
+	mon_data_update(&ereg_data, notif);
+}
+
+static void on_cereg_isr(const char *notif)
+{
+	mon_data_update(&cereg_isr_data, notif);
+}
+
+static void on_cscon(const char *notif)
+{
+	mon_data_update(&cscon_data, notif);
+}
+
+static void on_any(const char *notif)
+{
+	mon_data_update(&any_data, notif);
+}
+
+static void on_xtime_isr(const char *notif)
+{
+	mon_data_update(&xtime_isr_data, notif);
+}
+
+/* Create a +CGEV notification with a length that depends on the sequence number. */
+static void cgev_make(char *buf, size_t size, int seq)
+{
+	size_t len = MIN(20 + (seq * 13) % 50, size - 1);
+
+	memset(buf, 'x', len);
+	buf[len] = '\0';
+	buf[snprintf(buf, size, "+CGEV: %d ", seq % 10)] = 'x';
+}
+
+static void on_cgev(const char *notif)
+{
+	char expected[NOTIF_MAX_LEN];
+
+	if (cgev_data.count < ARRAY_SIZE(cgev_order)) {
+		cgev_order[cgev_data.count] = notif[strlen("+CGEV: ")] - '0';
+	}
+
+	if (cgev_chain_left > 0) {
+		cgev_make(expected, sizeof(expected), cgev_data.count);
+		if (strcmp(notif, expected) != 0) {
+			cgev_corrupt++;
+		}
+
+		/* Receive the next notification before this one is released */
+		cgev_chain_left--;
+		cgev_make(expected, sizeof(expected), cgev_data.count + 1);
+		at_monitor_dispatch(expected);
+	}
+
+	mon_data_update(&cgev_data, notif);
+}
+
+/* Let the system workqueue dispatch the queued notifications. */
+static void workqueue_drain(void)
+{
+	k_sleep(K_MSEC(10));
+}
+
+void setUp(void)
+{
+	mock_nrf_modem_at_Init();
+
+	memset(&cereg_data, 0, sizeof(cereg_data));
+	memset(&ereg_data, 0, sizeof(ereg_data));
+	memset(&cereg_isr_data, 0, sizeof(cereg_isr_data));
+	memset(&cscon_data, 0, sizeof(cscon_data));
+	memset(&any_data, 0, sizeof(any_data));
+	memset(&xtime_isr_data, 0, sizeof(xtime_isr_data));
+	memset(&cgev_data, 0, sizeof(cgev_data));
+	memset(cgev_order, 0, sizeof(cgev_order));
+	cgev_chain_left = 0;
+	cgev_corrupt = 0;
+}
+
+void tearDown(void)
+{
+	at_monitor_pause(&mon_cscon);
+	at_monitor_pause(&mon_any);
+
+	mock_nrf_modem_at_Verify();
+}
+
+void test_dispatch_all_matching_monitors(void)
+{
+	const char *notif = "+CEREG: 1,\"002F\",\"0012BEEF\",7\r\n";
+
+	at_monitor_dispatch(notif);
+	workqueue_drain();
+
+	TEST_ASSERT_EQUAL(1, cereg_data.count);
+	TEST_ASSERT_EQUAL_STRING(notif, cereg_data.notif);
+	TEST_ASSERT_EQUAL(1, ereg_data.count);
+	TEST_ASSERT_EQUAL_STRING(notif, ereg_data.notif);
+	TEST_ASSERT_EQUAL(1, cereg_isr_data.count);
+	TEST_ASSERT_EQUAL_STRING(notif, cereg_isr_data.notif);
+	TEST_ASSERT_EQUAL(0, cscon_data.count);
+	TEST_ASSERT_EQUAL(0, any_data.count);
+	TEST_ASSERT_EQUAL(0, xtime_isr_data.count);
+	TEST_ASSERT_EQUAL(0, cgev_data.count);
+}
+
+void test_dispatch_filter_in_the_middle(void)
+{
+	const char *notif = "+CGEREG: 5\r\n";
+
+	at_monitor_dispatch(notif);
+	workqueue_drain();
+
+	TEST_ASSERT_EQUAL(0, cereg_data.count);
+	TEST_ASSERT_EQUAL(1, ereg_data.count);
+	TEST_ASSERT_EQUAL_STRING(notif, ereg_data.notif);
+	TEST_ASSERT_EQUAL(0, cereg_isr_data.count);
+}
+
+void test_dispatch_isr_before_workqueue(void)
+{
+	k_sched_lock();
+
+	at_monitor_dispatch("+CEREG: 2\r\n");
+
+	TEST_ASSERT_EQUAL(1, cereg_isr_data.count);
+	TEST_ASSERT_EQUAL(0, cereg_data.count);
+
+	k_sched_unlock();
+	workqueue_drain();
+
+	TEST_ASSERT_EQUAL(1, cereg_data.count);
+}
+
+void test_dispatch_isr_only_not_queued(void)
+{
+	struct at_monitor_stats before;
+	struct at_monitor_stats after;
+
+	at_monitor_stats_get(&before);
+
+	at_monitor_dispatch("%XTIME: ,\"52018061528300\",\"00\"\r\n");
+	at_monitor_dispatch("+CMT: \"+1234\",22\r\n");
+	workqueue_drain();
+
+	at_monitor_stats_get(&after);
+
+	TEST_ASSERT_EQUAL(1, xtime_isr_data.count);
+	TEST_ASSERT_EQUAL(before.queued, after.queued);
+}
+
+void test_dispatch_paused_and_resumed(void)
+{
+	at_monitor_dispatch("+CSCON: 1\r\n");
+	workqueue_drain();
+
+	TEST_ASSERT_EQUAL(0, cscon_data.count);
+
+	at_monitor_resume(&mon_cscon);
+
+	at_monitor_dispatch("+CSCON: 0\r\n");
+	workqueue_drain();
+
+	TEST_ASSERT_EQUAL(1, cscon_data.count);
+	TEST_ASSERT_EQUAL_STRING("+CSCON: 0\r\n", cscon_data.notif);
+}
+
+void test_dispatch_paused_before_workqueue(void)
+{
+	at_monitor_resume(&mon_cscon);
+
+	k_sched_lock();
+
+	at_monitor_dispatch("+CSCON: 1\r\n");
+	at_monitor_pause(&mon_cscon);
+
+	k_sched_unlock();
+	workqueue_drain();
+
+	TEST_ASSERT_EQUAL(0, cscon_data.count);
+}
+
+void test_dispatch_any(void)
+{
+	at_monitor_resume(&mon_any);
+
+	at_monitor_dispatch("+CSCON: 1\r\n");
+	at_monitor_dispatch("+CEREG: 1\r\n");
+	workqueue_drain();
+
+	TEST_ASSERT_EQUAL(2, any_data.count);
+	TEST_ASSERT_EQUAL_STRING("+CEREG: 1\r\n", any_data.notif);
+	TEST_ASSERT_EQUAL(1, cereg_data.count);
+	TEST_ASSERT_EQUAL(0, cscon_data.count);
+}
+
+void test_pool_overflow(void)
+{
+	/* Each notification takes more than a third of the pool */
+	char notif[100];
+	struct at_monitor_stats before;
+	struct at_monitor_stats after;
+	int i;
+
+	at_monitor_stats_get(&before);
+
+	k_sched_lock();
+
+	for (i = 0; i < 4; i++) {
+		memset(notif, 'x', sizeof(notif) - 1);
+		notif[sizeof(notif) - 1] = '\0';
+		notif[snprintf(notif, sizeof(notif), "+CGEV: %d ", i)] = 'x';
+		at_monitor_dispatch(notif);
+	}
+
+	k_sched_unlock();
+	workqueue_drain();
+
+	at_monitor_stats_get(&after);
+
+	TEST_ASSERT_EQUAL(2, cgev_data.count);
+	TEST_ASSERT_EQUAL(0, cgev_order[0]);
+	TEST_ASSERT_EQUAL(1, cgev_order[1]);
+	TEST_ASSERT_EQUAL(before.queued + 2, after.queued);
+	TEST_ASSERT_EQUAL(before.dropped + 2, after.dropped);
+	TEST_ASSERT_LESS_OR_EQUAL(CONFIG_AT_MONITOR_HEAP_SIZE, after.pool_peak);
+	TEST_ASSERT_GREATER_THAN(2 * sizeof(notif), after.pool_peak);
+}
+
+void test_pool_wrap(void)
+{
+	char notif[NOTIF_MAX_LEN];
+	struct at_monitor_stats before;
+	struct at_monitor_stats after;
+
+	at_monitor_stats_get(&before);
+
+	/* The pool is never empty, so the notifications wrap around the end of the pool */
+	cgev_chain_left = 40;
+	cgev_make(notif, sizeof(notif), 0);
+
+	at_monitor_dispatch(notif);
+	workqueue_drain();
+
+	at_monitor_stats_get(&after);
+
+	TEST_ASSERT_EQUAL(41, cgev_data.count);
+	TEST_ASSERT_EQUAL(0, cgev_corrupt);
+	TEST_ASSERT_EQUAL(before.queued + 41, after.queued);
+	TEST_ASSERT_EQUAL(before.dropped, after.dropped);
+}
+
+/* This is needed because AT Monitor library is initialized in SYS_INIT. */
+static int sys_init_helper(void)
+{
+	__cmock_nrf_modem_at_notif_handler_set_ExpectAnyArgsAndReturn(0);
+
+	return 0;
+}
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
+
+SYS_INIT(sys_init_helper, POST_KERNEL, 0);
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <modem/at_parser.h>
+
+#include <test_benchmark.h>
+
+#define NUM_ITERATIONS 1000
+#define MAX_TOKENS     128
+
+/* Responses recorded from an nRF91 Series modem. */
+static const char * const responses[] = {
+	/* Neighbor cell measurement with 20 neighbor cells */
+	"%NCELLMEAS: 0,\"00112233\",\"98712\",\"0AB9\",4800,7,63,31,456,4800,"
+	"333333,100,101,102,0,333333,103,104,105,0,"
+	"333333,106,107,108,0,333333,109,110,111,0,"
+	"444444,112,113,114,0,444444,115,116,117,0,"
+	"444444,118,119,120,0,444444,121,122,123,0,"
+	"555555,124,125,126,0,555555,127,128,129,0,"
+	"555555,130,131,132,0,555555,133,134,135,0,"
+	"666666,136,137,138,0,666666,139,140,141,0,"
+	"666666,142,143,144,0,666666,145,146,147,0,"
+	"777777,148,149,150,0,777777,151,152,153,0,"
+	"888888,154,155,156,0,888888,157,158,159,0,"
+	"11\r\n",
+	/* Modem parameters */
+	"%XMONITOR: 1,\"Operator\",\"OP\",\"20065\",\"002F\",7,20,\"0012BEEF\","
+	"334,6200,66,44,\"\",\"11100000\",\"11100000\",\"01001001\",0\r\nOK\r\n",
+};
+
+static struct at_parser_token tokens[MAX_TOKENS];
+
+/* Value read at each index of a response */
+struct value {
+	int err;
+	int32_t num;
+	const char *str;
+	size_t len;
+};
+
+static struct value sequential_values[MAX_TOKENS];
+static struct value indexed_values[MAX_TOKENS];
+
+/* Read all values of the line, starting from the last one, as a parser without a token index
+ * would rewind for every value.
+ */
+static void read_all(struct at_parser *parser, size_t count, struct value *values)
+{
+	for (size_t i = count; i > 0; i--) {
+		struct value *v = &values[i - 1];
+
+		v->err = at_parser_num_get(parser, i - 1, &v->num);
+		if (v->err == -EOPNOTSUPP) {
+			v->err = at_parser_string_ptr_get(parser, i - 1, &v->str, &v->len);
+		}
+
+		zassert_true(v->err == 0 || v->err == -ENODATA, "Failed to read index %zu: %d",
+			     i - 1, v->err);
+	}
+}
+
+static size_t run(const char *at, bool indexed, struct value *values)
+{
+	struct test_benchmark bench;
+	struct at_parser parser;
+	size_t count;
+	int err;
+
+	memset(values, 0, MAX_TOKENS * sizeof(*values));
+
+	test_benchmark_start(&bench, indexed ? "at_parser indexed" : "at_parser sequential",
+			     NUM_ITERATIONS);
+
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		if (indexed) {
+			err = at_parser_init_indexed(&parser, at, tokens, ARRAY_SIZE(tokens));
+		} else {
+			err = at_parser_init(&parser, at);
+		}
+		zassert_ok(err);
+
+		err = at_parser_cmd_count_get(&parser, &count);
+		zassert_ok(err);
+		zassert_true(count <= MAX_TOKENS);
+
+		read_all(&parser, count, values);
+	}
+
+	test_benchmark_stop(&bench);
+
+	return count;
+}
+
+ZTEST(at_parser_benchmark, test_random_access)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(responses); i++) {
+		size_t sequential_count;
+		size_t indexed_count;
+
+		printk("at_parser %.10s: %zu B\n", responses[i], strlen(responses[i]));
+
+		sequential_count = run(responses[i], false, sequential_values);
+		indexed_count = run(responses[i], true, indexed_values);
+
+		/* The index must not change what is read */
+		zassert_equal(indexed_count, sequential_count);
+		for (size_t j = 0; j < sequential_count; j++) {
+			zassert_equal(indexed_values[j].err, sequential_values[j].err, "index %zu", j);
+			zassert_equal(indexed_values[j].num, sequential_values[j].num, "index %zu", j);
+			zassert_equal_ptr(indexed_values[j].str, sequential_values[j].str,
+					  "index %zu", j);
+			zassert_equal(indexed_values[j].len, sequential_values[j].len, "index %zu", j);
+		}
+	}
+}
+
+ZTEST_SUITE(at_parser_benchmark, NULL, NULL, NULL, NULL, NULL);
@@ -2190,4 +2190,186 @@ ZTEST(at_parser, test_at_parser_cmd_next)
 	zassert_equal(num, 6);
 }
 
+ZTEST(at_parser, test_at_parser_init_indexed_einval)
+{
+	int ret;
+	struct at_parser parser;
+	struct at_parser_token tokens[4];
+
+	ret = at_parser_init_indexed(NULL, "AT+CFUN?", tokens, ARRAY_SIZE(tokens));
+	zassert_equal(ret, -EINVAL);
+
+	ret = at_parser_init_indexed(&parser, NULL, tokens, ARRAY_SIZE(tokens));
+	zassert_equal(ret, -EINVAL);
+
+	ret = at_parser_init_indexed(&parser, "AT+CFUN?", NULL, ARRAY_SIZE(tokens));
+	zassert_equal(ret, -EINVAL);
+
+	ret = at_parser_init_indexed(&parser, "AT+CFUN?", tokens, 0);
+	zassert_equal(ret, -EINVAL);
+}
+
+static void check_random_access(size_t num_tokens)
+{
+	int ret;
+	struct at_parser parser;
+	struct at_parser_token tokens[32];
+	int32_t num;
+	size_t len;
+	char str[16];
+	size_t count = 0;
+
+	/* Integer values starting from index 5 */
+	static const int32_t expected[] = {
+		4800, 7, 63, 31, 456, 4800, 8, 60, 29, 4, 3500, 9, 99, 18, 5, 5300, 11
+	};
+
+	const char *str1 = "%NCELLMEAS: 0,\"00112233\",\"98712\",\"0AB9\",4800,7,63,31,"
+			   "456,4800,8,60,29,4,3500,9,99,18,5,5300,11\r\nOK\r\n";
+
+	zassert_true(num_tokens <= ARRAY_SIZE(tokens));
+
+	ret = at_parser_init_indexed(&parser, str1, tokens, num_tokens);
+	zassert_ok(ret);
+
+	/* Read in reverse order, so that a parser without the index would rewind every time. */
+	for (size_t i = ARRAY_SIZE(expected); i > 0; i--) {
+		ret = at_parser_num_get(&parser, 4 + i, &num);
+		zassert_ok(ret, "index %zu", 4 + i);
+		zassert_equal(num, expected[i - 1], "index %zu", 4 + i);
+	}
+
+	len = sizeof(str);
+	ret = at_parser_string_get(&parser, 4, str, &len);
+	zassert_ok(ret);
+	zassert_str_equal(str, "0AB9");
+
+	len = sizeof(str);
+	ret = at_parser_string_get(&parser, 0, str, &len);
+	zassert_ok(ret);
+	zassert_str_equal(str, "%NCELLMEAS");
+
+	ret = at_parser_num_get(&parser, 1, &num);
+	zassert_ok(ret);
+	zassert_equal(num, 0);
+
+	ret = at_parser_num_get(&parser, 2, &num);
+	zassert_equal(ret, -EOPNOTSUPP);
+
+	ret = at_parser_num_get(&parser, 5 + ARRAY_SIZE(expected), &num);
+	zassert_equal(ret, -EIO);
+
+	ret = at_parser_cmd_count_get(&parser, &count);
+	zassert_ok(ret);
+	zassert_equal(count, 5 + ARRAY_SIZE(expected));
+
+	ret = at_parser_cmd_next(&parser);
+	zassert_equal(ret, -EOPNOTSUPP);
+}
+
+ZTEST(at_parser, test_at_parser_indexed_random_access)
+{
+	/* Whole line indexed */
+	check_random_access(32);
+	/* Exactly the number of tokens in the line */
+	check_random_access(22);
+	/* Only a part of the line indexed */
+	check_random_access(5);
+	check_random_access(1);
+}
+
+ZTEST(at_parser, test_at_parser_indexed_empty)
+{
+	int ret;
+	struct at_parser parser;
+	struct at_parser_token tokens[8];
+	int32_t num;
+
+	const char *str1 = "+CPSMS: 1,,,\"10101111\",\r\nOK\r\n";
+
+	ret = at_parser_init_indexed(&parser, str1, tokens, ARRAY_SIZE(tokens));
+	zassert_ok(ret);
+
+	ret = at_parser_num_get(&parser, 5, &num);
+	zassert_equal(ret, -ENODATA);
+
+	ret = at_parser_num_get(&parser, 2, &num);
+	zassert_equal(ret, -ENODATA);
+
+	ret = at_parser_num_get(&parser, 1, &num);
+	zassert_ok(ret);
+	zassert_equal(num, 1);
+
+	ret = at_parser_num_get(&parser, 6, &num);
+	zassert_equal(ret, -EIO);
+}
+
+ZTEST(at_parser, test_at_parser_indexed_ebadmsg)
+{
+	int ret;
+	struct at_parser parser;
+	struct at_parser_token tokens[8];
+	int32_t num;
+
+	const char *str1 = "+NOTIF: 1,2 3,4\r\nOK\r\n";
+
+	ret = at_parser_init_indexed(&parser, str1, tokens, ARRAY_SIZE(tokens));
+	zassert_ok(ret);
+
+	ret = at_parser_num_get(&parser, 1, &num);
+	zassert_ok(ret);
+	zassert_equal(num, 1);
+
+	ret = at_parser_num_get(&parser, 3, &num);
+	zassert_equal(ret, -EBADMSG);
+
+	ret = at_parser_num_get(&parser, 2, &num);
+	zassert_equal(ret, -EBADMSG);
+}
+
+ZTEST(at_parser, test_at_parser_indexed_cmd_next)
+{
+	int ret;
+	struct at_parser parser;
+	struct at_parser_token tokens[3];
+	int32_t num = 0;
+
+	const char *str1 = "+NOTIF: 1,2,3,,\r\n"
+			   "+NOTIF2: 4,5\r\n"
+			   "+NOTIF3: 6,7,8\r\n"
+			   "OK\r\n";
+
+	ret = at_parser_init_indexed(&parser, str1, tokens, ARRAY_SIZE(tokens));
+	zassert_ok(ret);
+
+	ret = at_parser_num_get(&parser, 3, &num);
+	zassert_ok(ret);
+	zassert_equal(num, 3);
+
+	ret = at_parser_num_get(&parser, 2, &num);
+	zassert_ok(ret);
+	zassert_equal(num, 2);
+
+	ret = at_parser_cmd_next(&parser);
+	zassert_ok(ret);
+
+	ret = at_parser_num_get(&parser, 2, &num);
+	zassert_ok(ret);
+	zassert_equal(num, 5);
+
+	ret = at_parser_num_get(&parser, 3, &num);
+	zassert_equal(ret, -EAGAIN);
+
+	ret = at_parser_cmd_next(&parser);
+	zassert_ok(ret);
+
+	ret = at_parser_num_get(&parser, 3, &num);
+	zassert_ok(ret);
+	zassert_equal(num, 8);
+
+	ret = at_parser_num_get(&parser, 1, &num);
+	zassert_ok(ret);
+	zassert_equal(num, 6);
+}
+
 ZTEST_SUITE(at_parser, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <data_fifo.h>
+
+#include <test_benchmark.h>
+
+/* 1 ms of 48 kHz stereo 16-bit audio */
+#define BLOCK_SIZE	   192
+#define BLOCKS_NUM	   8
+#define NUM_ITERATIONS	   10000
+#define NUM_LATENCY_BLOCKS 1000
+
+#define THREAD_STACK_SIZE 1024
+/* The consumer has higher priority than the producer, so it is woken by every lock */
+#define CONSUMER_PRIORITY K_PRIO_PREEMPT(1)
+#define PRODUCER_PRIORITY K_PRIO_PREEMPT(2)
+
+#if defined(CONFIG_DATA_FIFO_BACKEND_SPSC)
+#define BACKEND_NAME "spsc"
+#else
+#define BACKEND_NAME "msgq"
+#endif
+
+DATA_FIFO_DEFINE(bench_fifo, BLOCKS_NUM, BLOCK_SIZE);
+
+K_THREAD_STACK_DEFINE(consumer_stack, THREAD_STACK_SIZE);
+K_THREAD_STACK_DEFINE(producer_stack, THREAD_STACK_SIZE);
+static struct k_thread consumer_thread;
+static struct k_thread producer_thread;
+static K_SEM_DEFINE(consumer_done, 0, 1);
+static uint64_t latency_ns_total;
+static uint64_t latency_ns_max;
+
+ZTEST(suite_data_fifo_benchmark, test_throughput)
+{
+	struct test_benchmark bench;
+	void *data;
+	size_t size;
+	int ret;
+
+	test_benchmark_start(&bench, BACKEND_NAME " block round trip", NUM_ITERATIONS);
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		ret = data_fifo_pointer_first_vacant_get(&bench_fifo, &data, K_NO_WAIT);
+		zassert_equal(ret, 0, "first_vacant_get failed: %d", ret);
+
+		ret = data_fifo_block_lock(&bench_fifo, &data, BLOCK_SIZE);
+		zassert_equal(ret, 0, "block_lock failed: %d", ret);
+
+		ret = data_fifo_pointer_last_filled_get(&bench_fifo, &data, &size, K_NO_WAIT);
+		zassert_equal(ret, 0, "last_filled_get failed: %d", ret);
+
+		data_fifo_block_free(&bench_fifo, data);
+	}
+	test_benchmark_stop(&bench);
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_LATENCY_BLOCKS; i++) {
+		uint64_t now;
+		uint64_t sent;
+		void *data;
+		size_t size;
+
+		(void)data_fifo_pointer_last_filled_get(&bench_fifo, &data, &size, K_FOREVER);
+		now = test_benchmark_time_ns();
+
+		memcpy(&sent, data, sizeof(sent));
+		data_fifo_block_free(&bench_fifo, data);
+
+		latency_ns_total += now - sent;
+		latency_ns_max = MAX(latency_ns_max, now - sent);
+	}
+
+	k_sem_give(&consumer_done);
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_LATENCY_BLOCKS; i++) {
+		uint64_t now;
+		void *data;
+		int ret;
+
+		ret = data_fifo_pointer_first_vacant_get(&bench_fifo, &data, K_FOREVER);
+		__ASSERT_NO_MSG(ret == 0);
+
+		now = test_benchmark_time_ns();
+		memcpy(data, &now, sizeof(now));
+
+		ret = data_fifo_block_lock(&bench_fifo, &data, BLOCK_SIZE);
+		__ASSERT_NO_MSG(ret == 0);
+	}
+}
+
+ZTEST(suite_data_fifo_benchmark, test_latency)
+{
+	int ret;
+
+	latency_ns_total = 0;
+	latency_ns_max = 0;
+
+	k_thread_create(&consumer_thread, consumer_stack, K_THREAD_STACK_SIZEOF(consumer_stack),
+			consumer, NULL, NULL, NULL, CONSUMER_PRIORITY, 0, K_NO_WAIT);
+	k_thread_create(&producer_thread, producer_stack, K_THREAD_STACK_SIZEOF(producer_stack),
+			producer, NULL, NULL, NULL, PRODUCER_PRIORITY, 0, K_NO_WAIT);
+
+	ret = k_sem_take(&consumer_done, K_SECONDS(10));
+	zassert_equal(ret, 0, "Consumer did not receive all blocks");
+
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	TC_PRINT("%s: lock to get latency avg %llu ns, max %llu ns\n", BACKEND_NAME,
+		 (unsigned long long)(latency_ns_total / NUM_LATENCY_BLOCKS),
+		 (unsigned long long)latency_ns_max);
+	zassert_true(latency_ns_total > 0, "No time elapsed between lock and get");
+}
+
+static void *benchmark_setup(void)
+{
+	int ret;
+
+	ret = data_fifo_init(&bench_fifo);
+	zassert_equal(ret, 0, "init failed: %d", ret);
+
+	return NULL;
+}
+
+ZTEST_SUITE(suite_data_fifo_benchmark, NULL, benchmark_setup, NULL, NULL, NULL);
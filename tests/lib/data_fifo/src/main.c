@@ -231,4 +231,136 @@ ZTEST(suite_data_fifo, test_data_fifo_data_put_size_zero)
 	zassert_equal(ret, -EINVAL, "block_lock did not return -EINVAL");
 }
 
+ZTEST(suite_data_fifo, test_data_fifo_free_unlocked_block)
+{
+	DATA_FIFO_DEFINE(data_fifo, 4, 128);
+
+	int ret;
+	uint8_t *data_ptr;
+	uint8_t *data_ptr_prev;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+
+	internal_test_remaining_elements(&data_fifo, 1, 0, __LINE__);
+
+	/* Give the block back without locking it, as done on producer error paths */
+	data_fifo_block_free(&data_fifo, data_ptr);
+
+	internal_test_remaining_elements(&data_fifo, 0, 0, __LINE__);
+
+	data_ptr_prev = data_ptr;
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+	zassert_equal(ret, 0, "first_vacant_get did not return 0");
+
+	ret = data_fifo_block_lock(&data_fifo, (void **)&data_ptr, 1);
+	zassert_equal(ret, 0, "block_lock did not return 0");
+
+	internal_test_remaining_elements(&data_fifo, 1, 1, __LINE__);
+
+	if (IS_ENABLED(CONFIG_DATA_FIFO_BACKEND_SPSC)) {
+		zassert_equal_ptr(data_ptr, data_ptr_prev, "Freed block was not reused");
+	}
+}
+
+ZTEST(suite_data_fifo, test_data_fifo_get_timeout)
+{
+	DATA_FIFO_DEFINE(data_fifo, 2, 128);
+
+	int ret;
+	void *data_ptr;
+	size_t data_size;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	ret = data_fifo_pointer_last_filled_get(&data_fifo, &data_ptr, &data_size, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, "last_filled_get on empty FIFO did not return -ENOMSG");
+
+	ret = data_fifo_pointer_last_filled_get(&data_fifo, &data_ptr, &data_size, K_MSEC(10));
+	zassert_equal(ret, -EAGAIN, "last_filled_get did not time out");
+}
+
+#if defined(CONFIG_DATA_FIFO_BACKEND_SPSC)
+ZTEST(suite_data_fifo, test_data_fifo_index_wrap)
+{
+#define BLOCKS_NUM 10
+#define BLOCK_SIZE 128
+	DATA_FIFO_DEFINE(data_fifo, BLOCKS_NUM, BLOCK_SIZE);
+
+	int ret;
+	uint8_t *data_ptr;
+	uint8_t *data_ptr_unlocked;
+	size_t data_size;
+	uint32_t slot;
+
+	ret = data_fifo_init(&data_fifo);
+	zassert_equal(ret, 0, "init did not return 0");
+
+	/* Start a few blocks before the indices wrap around */
+	data_fifo.alloc_idx = 2 * BLOCKS_NUM - 3;
+	data_fifo.commit_idx = data_fifo.alloc_idx;
+	data_fifo.read_idx = data_fifo.alloc_idx;
+	data_fifo.free_idx = data_fifo.alloc_idx;
+	slot = data_fifo.alloc_idx % BLOCKS_NUM;
+
+	/* Fill the ring across the wrap */
+	for (int i = 0; i < BLOCKS_NUM; i++) {
+		ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+		zassert_equal(ret, 0, "first_vacant_get did not return 0");
+		zassert_equal_ptr(data_ptr,
+				  data_fifo.slab_buffer + ((slot + i) % BLOCKS_NUM) * BLOCK_SIZE,
+				  "Block %d is not in the next slot", i);
+		data_ptr[0] = i;
+		ret = data_fifo_block_lock(&data_fifo, (void **)&data_ptr, 1);
+		zassert_equal(ret, 0, "block_lock did not return 0");
+	}
+
+	internal_test_remaining_elements(&data_fifo, BLOCKS_NUM, BLOCKS_NUM, __LINE__);
+
+	ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+	zassert_equal(ret, -ENOMEM, "first_vacant_get on full FIFO did not return -ENOMEM");
+
+	for (int i = 0; i < BLOCKS_NUM; i++) {
+		ret = data_fifo_pointer_last_filled_get(&data_fifo, (void **)&data_ptr, &data_size,
+							K_NO_WAIT);
+		zassert_equal(ret, 0, "last_filled_get did not return 0");
+		zassert_equal(data_ptr[0], i, "Block %d read out of order", i);
+		data_fifo_block_free(&data_fifo, data_ptr);
+	}
+
+	internal_test_remaining_elements(&data_fifo, 0, 0, __LINE__);
+
+	/* Pass each index over the wrap several times, giving back an unlocked block each time */
+	for (int i = 0; i < 4 * BLOCKS_NUM; i++) {
+		ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr, K_NO_WAIT);
+		zassert_equal(ret, 0, "first_vacant_get did not return 0");
+		zassert_equal_ptr(data_ptr, data_fifo.slab_buffer + slot * BLOCK_SIZE,
+				  "Block %d is not in the next slot", i);
+		data_ptr[0] = i;
+		ret = data_fifo_block_lock(&data_fifo, (void **)&data_ptr, 1);
+		zassert_equal(ret, 0, "block_lock did not return 0");
+
+		ret = data_fifo_pointer_first_vacant_get(&data_fifo, (void **)&data_ptr_unlocked,
+							 K_NO_WAIT);
+		zassert_equal(ret, 0, "first_vacant_get did not return 0");
+		data_fifo_block_free(&data_fifo, data_ptr_unlocked);
+
+		internal_test_remaining_elements(&data_fifo, 1, 1, __LINE__);
+
+		ret = data_fifo_pointer_last_filled_get(&data_fifo, (void **)&data_ptr, &data_size,
+							K_NO_WAIT);
+		zassert_equal(ret, 0, "last_filled_get did not return 0");
+		zassert_equal(data_ptr[0], (uint8_t)i, "Block %d read out of order", i);
+		data_fifo_block_free(&data_fifo, data_ptr);
+
+		internal_test_remaining_elements(&data_fifo, 0, 0, __LINE__);
+		slot = (slot + 1) % BLOCKS_NUM;
+	}
+}
+#endif /* CONFIG_DATA_FIFO_BACKEND_SPSC */
+
 ZTEST_SUITE(suite_data_fifo, NULL, NULL, NULL, NULL, NULL);
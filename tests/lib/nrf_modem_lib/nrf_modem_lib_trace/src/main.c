@@ -46,6 +46,10 @@ static struct nrf_modem_trace_data write_frags[MAX_N_STATIC_FRAGS];
 
 #define TRACE_THREAD_HANDLER_MULTI_RUNS 32
 
+#define BITRATE_PERIOD_MS CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE_PERIOD_MS
+#define BITRATE_FRAG_LEN 1000
+#define BITRATE_SLOW_WRITE_MS 100
+
 K_FIFO_DEFINE(get_fifo);
 K_FIFO_DEFINE(write_fifo);
 
@@ -191,6 +195,16 @@ int trace_backend_write_stub(const void *data, size_t len, int cmock_num_calls)
 	return (int)len;
 }
 
+/* The first write waits for the backend, the following ones return immediately. */
+int trace_backend_write_slow_stub(const void *data, size_t len, int cmock_num_calls)
+{
+	if (cmock_num_calls == 0) {
+		k_msleep(BITRATE_SLOW_WRITE_MS);
+	}
+
+	return trace_backend_write_stub(data, len, cmock_num_calls);
+}
+
 /* Function implementing a mechanism to synchronize main testing thread with trace thread via
  * a semaphore. This is the last function in the execution flow that can be mocked.
  */
@@ -352,6 +366,53 @@ void test_trace_thread_handler_get_eshutdown(void)
 	TEST_ASSERT_EQUAL(1, nrf_modem_trace_get_cmock_num_calls);
 }
 
+void test_trace_backend_bitrate_sustained(void)
+{
+	struct nrf_modem_trace_data header = { 0 };
+	struct nrf_modem_trace_data data = { 0 };
+	int64_t start;
+	int64_t elapsed;
+	uint32_t bps;
+	/* All bytes written over the time spent writing them. */
+	uint32_t expected = 2 * BITRATE_FRAG_LEN * 8 * MSEC_PER_SEC / BITRATE_SLOW_WRITE_MS;
+
+	__cmock_trace_backend_init_ExpectAndReturn(nrf_modem_trace_processed, 0);
+	__cmock_nrf_modem_trace_get_Stub(nrf_modem_trace_get_stub);
+	__cmock_trace_backend_write_Stub(trace_backend_write_slow_stub);
+	__cmock_trace_backend_deinit_Stub(trace_backend_deinit_stub);
+
+	nrf_modem_lib_trace_init();
+	start = k_uptime_get();
+
+	generate_trace_frag(&header);
+	generate_trace_frag(&data);
+	header.len = BITRATE_FRAG_LEN;
+	data.len = BITRATE_FRAG_LEN;
+
+	k_fifo_alloc_put(&get_fifo, &header);
+	k_fifo_alloc_put(&get_fifo, &data);
+
+	(void)k_fifo_get(&write_fifo, K_FOREVER);
+	(void)k_fifo_get(&write_fifo, K_FOREVER);
+
+	/* Both writes fall in the first period, read the bitrate before the second one ends. */
+	elapsed = k_uptime_get() - start;
+	TEST_ASSERT_LESS_THAN(BITRATE_PERIOD_MS, elapsed);
+	k_msleep(BITRATE_PERIOD_MS + BITRATE_PERIOD_MS / 2 - elapsed);
+
+	bps = nrf_modem_lib_trace_backend_bitrate_get();
+
+	/* Averaging the bitrate of each write would let the fast write dominate. The writes
+	 * can only take longer than requested, by a few ticks, which gives a lower bitrate.
+	 */
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(expected, bps);
+	TEST_ASSERT_GREATER_OR_EQUAL_UINT32(expected * 3 / 4, bps);
+
+	nrf_modem_trace_get_error = -ESHUTDOWN;
+
+	wait_trace_deinit();
+}
+
 void test_nrf_modem_lib_trace_level_set(void)
 {
 	int ret;
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <unity.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <modem/trace_backend.h>
+
+#include "trace_compression.h"
+
+#define BLOCK_SIZE CONFIG_NRF_MODEM_LIB_TRACE_COMPRESSION_BLOCK_SIZE
+
+extern int unity_main(void);
+
+extern struct nrf_modem_lib_trace_backend trace_backend_compression;
+
+/* Trace backend the compression stage writes to */
+static uint8_t backend_data[16 * BLOCK_SIZE];
+static size_t backend_data_len;
+static size_t backend_write_max;
+static int backend_write_err;
+static int backend_init_count;
+
+static int backend_init(trace_backend_processed_cb trace_processed_cb)
+{
+	backend_init_count++;
+	return 0;
+}
+
+static int backend_deinit(void)
+{
+	return 0;
+}
+
+static int backend_write(const void *data, size_t len)
+{
+	if (backend_write_err) {
+		return backend_write_err;
+	}
+
+	len = MIN(len, backend_write_max);
+	TEST_ASSERT_LESS_OR_EQUAL(sizeof(backend_data), backend_data_len + len);
+
+	memcpy(&backend_data[backend_data_len], data, len);
+	backend_data_len += len;
+
+	return len;
+}
+
+struct nrf_modem_lib_trace_backend trace_backend = {
+	.init = backend_init,
+	.deinit = backend_deinit,
+	.write = backend_write,
+};
+
+static size_t processed_len;
+
+static int processed_cb(size_t len)
+{
+	processed_len += len;
+	return 0;
+}
+
+/* Decode one LZ4 block, as done by the host side decompressor */
+static size_t lz4_decode(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_size)
+{
+	const uint8_t *ip = src;
+	const uint8_t *ip_end = src + len;
+	size_t op = 0;
+
+	while (true) {
+		uint8_t token = *ip++;
+		size_t lit_len = token >> 4;
+		size_t match_len = token & 0x0f;
+		size_t offset;
+		uint8_t b;
+
+		if (lit_len == 15) {
+			do {
+				b = *ip++;
+				lit_len += b;
+			} while (b == 255);
+		}
+
+		TEST_ASSERT_LESS_OR_EQUAL(dst_size, op + lit_len);
+		memcpy(&dst[op], ip, lit_len);
+		ip += lit_len;
+		op += lit_len;
+
+		if (ip >= ip_end) {
+			break;
+		}
+
+		offset = sys_get_le16(ip);
+		ip += 2;
+
+		if (match_len == 15) {
+			do {
+				b = *ip++;
+				match_len += b;
+			} while (b == 255);
+		}
+		match_len += 4;
+
+		TEST_ASSERT_NOT_EQUAL(0, offset);
+		TEST_ASSERT_LESS_OR_EQUAL(op, offset);
+		TEST_ASSERT_LESS_OR_EQUAL(dst_size, op + match_len);
+
+		/* Byte by byte, matches can overlap the data they produce */
+		for (size_t i = 0; i < match_len; i++, op++) {
+			dst[op] = dst[op - offset];
+		}
+	}
+
+	return op;
+}
+
+/* Decode all blocks written to the backend */
+static size_t backend_data_decode(uint8_t *dst, size_t dst_size)
+{
+	size_t pos = 0;
+	size_t out = 0;
+
+	while (pos < backend_data_len) {
+		const uint8_t *hdr = &backend_data[pos];
+		uint16_t raw_len = sys_get_le16(&hdr[4]);
+		uint16_t len = sys_get_le16(&hdr[6]);
+
+		TEST_ASSERT_EQUAL('M', hdr[0]);
+		TEST_ASSERT_EQUAL('T', hdr[1]);
+		TEST_ASSERT_EQUAL(hdr[0] ^ hdr[1] ^ hdr[2] ^ hdr[4] ^ hdr[5] ^ hdr[6] ^ hdr[7],
+				  hdr[3]);
+		TEST_ASSERT_LESS_OR_EQUAL(backend_data_len, pos + TRACE_COMPRESSION_HDR_SIZE + len);
+		TEST_ASSERT_LESS_OR_EQUAL(dst_size, out + raw_len);
+
+		if (hdr[2] == TRACE_COMPRESSION_BLOCK_LZ4) {
+			TEST_ASSERT_LESS_THAN(raw_len, len);
+			TEST_ASSERT_EQUAL(raw_len, lz4_decode(&hdr[TRACE_COMPRESSION_HDR_SIZE], len,
+							      &dst[out], raw_len));
+		} else {
+			TEST_ASSERT_EQUAL(TRACE_COMPRESSION_BLOCK_STORED, hdr[2]);
+			TEST_ASSERT_EQUAL(raw_len, len);
+			memcpy(&dst[out], &hdr[TRACE_COMPRESSION_HDR_SIZE], len);
+		}
+
+		pos += TRACE_COMPRESSION_HDR_SIZE + len;
+		out += raw_len;
+	}
+
+	return out;
+}
+
+/* Trace-like data: records with a fixed header, a timestamp and one of a few payloads */
+static void trace_data_fill(uint8_t *buf, size_t len)
+{
+	static const char *const payloads[] = {"RRC_CONNECTION", "PDCP", "NAS_EMM_STATE",
+					       "L1_MEAS"};
+	uint32_t timestamp = 1000;
+	size_t pos = 0;
+
+	while (pos < len) {
+		const char *payload = payloads[(timestamp / 7) % ARRAY_SIZE(payloads)];
+		uint8_t record[32];
+		size_t record_len;
+
+		record[0] = 0xef;
+		record[1] = 0xbe;
+		sys_put_le32(timestamp, &record[2]);
+		record_len = 6 + strlen(payload);
+		memcpy(&record[6], payload, strlen(payload));
+
+		memcpy(&buf[pos], record, MIN(record_len, len - pos));
+		pos += MIN(record_len, len - pos);
+		timestamp += 13;
+	}
+}
+
+/* Write all data, as the trace thread does */
+static void trace_write(const uint8_t *data, size_t len)
+{
+	int ret;
+
+	while (len) {
+		ret = trace_backend_compression.write(data, len);
+		TEST_ASSERT_GREATER_THAN(0, ret);
+		TEST_ASSERT_LESS_OR_EQUAL(len, ret);
+
+		data += ret;
+		len -= ret;
+	}
+}
+
+void setUp(void)
+{
+	backend_data_len = 0;
+	backend_write_max = SIZE_MAX;
+	backend_write_err = 0;
+	backend_init_count = 0;
+	processed_len = 0;
+
+	TEST_ASSERT_EQUAL(0, trace_backend_compression.init(processed_cb));
+}
+
+void tearDown(void)
+{
+	backend_write_err = 0;
+	TEST_ASSERT_EQUAL(0, trace_backend_compression.deinit());
+}
+
+void test_init_efault(void)
+{
+	TEST_ASSERT_EQUAL(-EFAULT, trace_backend_compression.init(NULL));
+}
+
+void test_init_initializes_backend(void)
+{
+	TEST_ASSERT_EQUAL(1, backend_init_count);
+}
+
+/* Data is processed as soon as it is copied, and written once a block is full */
+void test_write_batches_data_in_blocks(void)
+{
+	static uint8_t data[BLOCK_SIZE];
+
+	trace_data_fill(data, sizeof(data));
+
+	trace_write(data, BLOCK_SIZE / 2);
+	TEST_ASSERT_EQUAL(BLOCK_SIZE / 2, processed_len);
+	TEST_ASSERT_EQUAL(0, backend_data_len);
+
+	trace_write(&data[BLOCK_SIZE / 2], BLOCK_SIZE / 2);
+	TEST_ASSERT_EQUAL(BLOCK_SIZE, processed_len);
+	TEST_ASSERT_NOT_EQUAL(0, backend_data_len);
+	TEST_ASSERT_LESS_THAN(BLOCK_SIZE, backend_data_len);
+}
+
+void test_write_roundtrip(void)
+{
+	static uint8_t data[10 * BLOCK_SIZE + 100];
+	static uint8_t decoded[sizeof(data)];
+	uint32_t raw_bytes_start;
+	uint32_t compressed_bytes_start;
+	uint32_t raw_bytes;
+	uint32_t compressed_bytes;
+
+	trace_data_fill(data, sizeof(data));
+	trace_compression_stats_get(&raw_bytes_start, &compressed_bytes_start);
+
+	/* Fragments of varying size, and partial writes in the backend */
+	backend_write_max = 100;
+	for (size_t pos = 0, frag = 1; pos < sizeof(data); pos += frag, frag = frag * 3 % 511) {
+		trace_write(&data[pos], MIN(frag, sizeof(data) - pos));
+	}
+
+	/* The partial block is written when the backend is suspended */
+	TEST_ASSERT_EQUAL(0, trace_backend_compression.suspend());
+
+	TEST_ASSERT_EQUAL(sizeof(data), processed_len);
+	TEST_ASSERT_EQUAL(sizeof(data), backend_data_decode(decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decoded, sizeof(data));
+
+	trace_compression_stats_get(&raw_bytes, &compressed_bytes);
+	TEST_ASSERT_EQUAL(sizeof(data), raw_bytes - raw_bytes_start);
+	TEST_ASSERT_EQUAL(backend_data_len, compressed_bytes - compressed_bytes_start);
+	TEST_ASSERT_LESS_THAN(sizeof(data) * 3 / 4, backend_data_len);
+}
+
+void test_write_incompressible_data_is_stored(void)
+{
+	static uint8_t data[BLOCK_SIZE];
+	static uint8_t decoded[sizeof(data)];
+	uint32_t x = 1;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		/* xorshift */
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		data[i] = x;
+	}
+
+	trace_write(data, sizeof(data));
+
+	TEST_ASSERT_EQUAL(TRACE_COMPRESSION_HDR_SIZE + BLOCK_SIZE, backend_data_len);
+	TEST_ASSERT_EQUAL(TRACE_COMPRESSION_BLOCK_STORED, backend_data[2]);
+	TEST_ASSERT_EQUAL(sizeof(data), backend_data_decode(decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decoded, sizeof(data));
+}
+
+/* A backend error is returned before more data is consumed, and the block is written when
+ * the backend accepts data again.
+ */
+void test_write_backend_error_is_retried(void)
+{
+	static uint8_t data[2 * BLOCK_SIZE];
+	static uint8_t decoded[sizeof(data)];
+	int ret;
+
+	trace_data_fill(data, sizeof(data));
+
+	backend_write_err = -ENOSPC;
+	trace_write(data, BLOCK_SIZE);
+	TEST_ASSERT_EQUAL(0, backend_data_len);
+
+	ret = trace_backend_compression.write(&data[BLOCK_SIZE], BLOCK_SIZE);
+	TEST_ASSERT_EQUAL(-ENOSPC, ret);
+	TEST_ASSERT_EQUAL(BLOCK_SIZE, processed_len);
+
+	backend_write_err = 0;
+	trace_write(&data[BLOCK_SIZE], BLOCK_SIZE);
+
+	TEST_ASSERT_EQUAL(sizeof(data), backend_data_decode(decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decoded, sizeof(data));
+}
+
+void test_deinit_writes_partial_block(void)
+{
+	static uint8_t data[BLOCK_SIZE / 4];
+	static uint8_t decoded[sizeof(data)];
+
+	trace_data_fill(data, sizeof(data));
+
+	trace_write(data, sizeof(data));
+	TEST_ASSERT_EQUAL(0, backend_data_len);
+
+	TEST_ASSERT_EQUAL(0, trace_backend_compression.deinit());
+
+	TEST_ASSERT_EQUAL(sizeof(data), backend_data_decode(decoded, sizeof(decoded)));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decoded, sizeof(data));
+}
+
+void test_unsupported_ops(void)
+{
+	uint8_t buf[16];
+
+	TEST_ASSERT_EQUAL(-ENOTSUP, trace_backend_compression.read(buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL(-ENOTSUP, trace_backend_compression.peek_at(0, buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL(-ENOTSUP, trace_backend_compression.clear());
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
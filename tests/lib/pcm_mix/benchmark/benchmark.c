@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <pcm_mix.h>
+
+#include <test_benchmark.h>
+
+/* 10 ms of 48 kHz stereo */
+#define FRAME_SAMPLES	 (480 * 2)
+#define NUM_INPUTS	 4
+#define NUM_ITERATIONS	 200
+
+static int16_t input_16[NUM_INPUTS][FRAME_SAMPLES];
+static int16_t output_16[FRAME_SAMPLES];
+static int32_t input_32[NUM_INPUTS][FRAME_SAMPLES];
+static int32_t output_32[FRAME_SAMPLES];
+static uint8_t input_24[NUM_INPUTS][FRAME_SAMPLES * 3];
+static uint8_t output_24[FRAME_SAMPLES * 3];
+
+/* Per-sample mixing with a limiter call for every sample, as done by pcm_mix */
+static void reference_mix_16(int16_t *pcm_a, int16_t const *pcm_b, size_t num_samples)
+{
+	for (size_t i = 0; i < num_samples; i++) {
+		int32_t res = pcm_a[i] + pcm_b[i];
+
+		if (res < INT16_MIN) {
+			res = INT16_MIN;
+		} else if (res > INT16_MAX) {
+			res = INT16_MAX;
+		}
+
+		pcm_a[i] = (int16_t)res;
+	}
+}
+
+static void fill_inputs(void)
+{
+	uint32_t seed = 0x12345678;
+
+	for (size_t k = 0; k < NUM_INPUTS; k++) {
+		for (size_t i = 0; i < FRAME_SAMPLES; i++) {
+			seed = seed * 1664525 + 1013904223;
+			input_16[k][i] = (int16_t)(seed >> 16);
+			input_32[k][i] = (int32_t)seed;
+			input_24[k][i * 3] = (uint8_t)seed;
+			input_24[k][i * 3 + 1] = (uint8_t)(seed >> 8);
+			input_24[k][i * 3 + 2] = (uint8_t)(seed >> 16);
+		}
+	}
+}
+
+static void run_multi(void *out, size_t size, uint8_t const *base, size_t stride,
+		      uint8_t bit_depth, char const *name)
+{
+	struct pcm_mix_input inputs[NUM_INPUTS];
+	struct test_benchmark bench;
+	int ret;
+
+	for (size_t k = 0; k < NUM_INPUTS; k++) {
+		inputs[k].pcm = base + k * stride;
+		inputs[k].size = size;
+		inputs[k].gain = PCM_MIX_GAIN_UNITY;
+	}
+
+	test_benchmark_start(&bench, name, NUM_ITERATIONS);
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		ret = pcm_mix_multi(out, size, inputs, NUM_INPUTS, bit_depth);
+		zassert_equal(ret, 0, "pcm_mix_multi failed: %d", ret);
+	}
+	test_benchmark_stop(&bench);
+}
+
+ZTEST(suite_pcm_mix_benchmark, test_benchmark)
+{
+	struct test_benchmark bench;
+
+	fill_inputs();
+
+	test_benchmark_start(&bench, "reference 16-bit, " STRINGIFY(NUM_INPUTS) " inputs",
+			     NUM_ITERATIONS);
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		memcpy(output_16, input_16[0], sizeof(output_16));
+		for (size_t k = 1; k < NUM_INPUTS; k++) {
+			reference_mix_16(output_16, input_16[k], FRAME_SAMPLES);
+		}
+	}
+	test_benchmark_stop(&bench);
+
+	test_benchmark_start(&bench, "pcm_mix 16-bit, " STRINGIFY(NUM_INPUTS) " inputs",
+			     NUM_ITERATIONS);
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		memcpy(output_16, input_16[0], sizeof(output_16));
+		for (size_t k = 1; k < NUM_INPUTS; k++) {
+			(void)pcm_mix(output_16, sizeof(output_16), input_16[k],
+				      sizeof(input_16[k]), B_STEREO_INTO_A_STEREO);
+		}
+	}
+	test_benchmark_stop(&bench);
+
+	run_multi(output_16, sizeof(output_16), (uint8_t const *)input_16, sizeof(input_16[0]), 16,
+		  "pcm_mix_multi 16-bit");
+	run_multi(output_24, sizeof(output_24), (uint8_t const *)input_24, sizeof(input_24[0]), 24,
+		  "pcm_mix_multi 24-bit");
+	run_multi(output_32, sizeof(output_32), (uint8_t const *)input_32, sizeof(input_32[0]), 32,
+		  "pcm_mix_multi 32-bit");
+}
+
+ZTEST_SUITE(suite_pcm_mix_benchmark, NULL, NULL, NULL, NULL, NULL);
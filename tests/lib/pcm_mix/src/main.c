@@ -127,4 +127,105 @@ ZTEST(suite_pcm_mix, test_mono_into_stereo_r)
 	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
 }
 
+ZTEST(suite_pcm_mix, test_multi_16_bit)
+{
+	int ret;
+	int16_t sample_a[] = { 100, INT16_MAX, INT16_MIN, -5, 7 };
+	int16_t sample_b[] = { -100, 10, -10, 5, 8 };
+	int16_t sample_c[] = { 200, 0, 0, 4, 8 };
+	int16_t sample_o[ARRAY_SIZE(sample_a)];
+	int16_t sample_r[] = { 100, INT16_MAX, INT16_MIN, 2, 19 };
+	struct pcm_mix_input inputs[] = {
+		{ .pcm = sample_a, .size = sizeof(sample_a), .gain = PCM_MIX_GAIN_UNITY },
+		{ .pcm = sample_b, .size = sizeof(sample_b), .gain = PCM_MIX_GAIN_UNITY },
+		{ .pcm = NULL, .size = 0, .gain = PCM_MIX_GAIN_UNITY },
+		{ .pcm = sample_c, .size = sizeof(sample_c), .gain = PCM_MIX_GAIN_UNITY / 2 },
+	};
+
+	ret = pcm_mix_multi(sample_o, sizeof(sample_o), inputs, ARRAY_SIZE(inputs), 16);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_o, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_multi_in_place)
+{
+	int ret;
+	int16_t sample_a[] = { 1, 2, 3, 4 };
+	int16_t sample_b[] = { 10, 20, 30, 40 };
+	int16_t sample_r[] = { 11, 22, 33, 44 };
+	struct pcm_mix_input inputs[] = {
+		{ .pcm = sample_b, .size = sizeof(sample_b), .gain = PCM_MIX_GAIN_UNITY },
+		{ .pcm = sample_a, .size = sizeof(sample_a), .gain = PCM_MIX_GAIN_UNITY },
+	};
+
+	ret = pcm_mix_multi(sample_a, sizeof(sample_a), inputs, ARRAY_SIZE(inputs), 16);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_multi_24_bit)
+{
+	int ret;
+	/* Packed little endian: INT24_MAX, INT24_MIN, 1 */
+	uint8_t sample_a[] = { 0xff, 0xff, 0x7f, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00 };
+	/* 1, -1, -2 */
+	uint8_t sample_b[] = { 0x01, 0x00, 0x00, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xff };
+	uint8_t sample_o[sizeof(sample_a)];
+	/* INT24_MAX, INT24_MIN, -1 */
+	uint8_t sample_r[] = { 0xff, 0xff, 0x7f, 0x00, 0x00, 0x80, 0xff, 0xff, 0xff };
+	struct pcm_mix_input inputs[] = {
+		{ .pcm = sample_a, .size = sizeof(sample_a), .gain = PCM_MIX_GAIN_UNITY },
+		{ .pcm = sample_b, .size = sizeof(sample_b), .gain = PCM_MIX_GAIN_UNITY },
+	};
+
+	ret = pcm_mix_multi(sample_o, sizeof(sample_o), inputs, ARRAY_SIZE(inputs), 24);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_o, sample_r, sizeof(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_multi_32_bit)
+{
+	int ret;
+	int32_t sample_a[] = { INT32_MAX, INT32_MIN, -4 };
+	int32_t sample_b[] = { 1, -1, 8 };
+	int32_t sample_o[ARRAY_SIZE(sample_a)];
+	int32_t sample_r[] = { INT32_MAX, INT32_MIN, 12 };
+	struct pcm_mix_input inputs[] = {
+		{ .pcm = sample_a, .size = sizeof(sample_a), .gain = PCM_MIX_GAIN_UNITY },
+		{ .pcm = sample_b, .size = sizeof(sample_b), .gain = PCM_MIX_GAIN_UNITY * 2 },
+	};
+
+	ret = pcm_mix_multi(sample_o, sizeof(sample_o), inputs, ARRAY_SIZE(inputs), 32);
+	ZEQ(ret, 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(sample_r); i++) {
+		ZEQ(sample_o[i], sample_r[i]);
+	}
+}
+
+ZTEST(suite_pcm_mix, test_multi_illegal_arguments)
+{
+	int ret;
+	int16_t sample_a[] = { 0, 1, 2 };
+	int16_t sample_b[] = { 0, 1 };
+	struct pcm_mix_input inputs[] = {
+		{ .pcm = sample_b, .size = sizeof(sample_b), .gain = PCM_MIX_GAIN_UNITY },
+	};
+
+	ret = pcm_mix_multi(NULL, sizeof(sample_a), inputs, ARRAY_SIZE(inputs), 16);
+	ZEQ(ret, -EINVAL);
+
+	ret = pcm_mix_multi(sample_a, sizeof(sample_a), inputs, ARRAY_SIZE(inputs), 8);
+	ZEQ(ret, -EINVAL);
+
+	ret = pcm_mix_multi(sample_a, sizeof(sample_a), inputs, ARRAY_SIZE(inputs), 32);
+	ZEQ(ret, -EINVAL);
+
+	ret = pcm_mix_multi(sample_a, sizeof(sample_a), inputs, ARRAY_SIZE(inputs), 16);
+	ZEQ(ret, -EPERM);
+}
+
 ZTEST_SUITE(suite_pcm_mix, NULL, NULL, NULL, NULL, NULL);
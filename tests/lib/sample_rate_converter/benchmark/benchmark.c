@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <sample_rate_converter.h>
+
+#include <test_benchmark.h>
+
+#define PI		3.14159265358979
+#define TONE_HZ		1000.0
+#define TONE_AMPLITUDE	(0.5 * INT16_MAX)
+#define BLOCK_MS	10
+#define NUM_BLOCKS	100
+/* Output samples skipped at both ends so that the filter has settled */
+#define SETTLE_SAMPLES	256
+#define THD_N_LIMIT_DB	(-80.0)
+
+static struct sample_rate_converter_polyphase_ctx bench_ctx;
+static sample_rate_converter_sample_t bench_input[CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX];
+static sample_rate_converter_sample_t bench_output[NUM_BLOCKS * 480 + 2];
+
+/**
+ * @brief Calculate THD+N by fitting a sine at the known tone frequency with least squares and
+ *	  treating everything else as distortion and noise.
+ */
+static double thd_n_db(sample_rate_converter_sample_t const *y, size_t n, double freq,
+		       uint32_t sample_rate)
+{
+	double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0;
+	double a, b, det;
+	double signal = 0, residual = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		double s = sin(2 * PI * freq * i / sample_rate);
+		double c = cos(2 * PI * freq * i / sample_rate);
+
+		ss += s * s;
+		sc += s * c;
+		cc += c * c;
+		ys += y[i] * s;
+		yc += y[i] * c;
+	}
+
+	det = ss * cc - sc * sc;
+	a = (ys * cc - yc * sc) / det;
+	b = (yc * ss - ys * sc) / det;
+
+	for (size_t i = 0; i < n; i++) {
+		double fit = a * sin(2 * PI * freq * i / sample_rate) +
+			     b * cos(2 * PI * freq * i / sample_rate);
+
+		signal += fit * fit;
+		residual += (y[i] - fit) * (y[i] - fit);
+	}
+
+	return 10 * log10(residual / signal);
+}
+
+static void run_conversion(uint32_t rate_in, uint32_t rate_out)
+{
+	size_t block_samples = rate_in * BLOCK_MS / 1000;
+	size_t total = 0;
+	uint64_t ns = 0;
+	double thd_n;
+	int ret;
+
+	zassert_true(block_samples <= ARRAY_SIZE(bench_input), "Block too large");
+
+	ret = sample_rate_converter_polyphase_open(&bench_ctx, rate_in, rate_out);
+	zassert_equal(ret, 0, "Open failed (%d)", ret);
+
+	for (int b = 0; b < NUM_BLOCKS; b++) {
+		uint64_t start;
+		size_t written;
+
+		for (size_t i = 0; i < block_samples; i++) {
+			size_t n = b * block_samples + i;
+
+			bench_input[i] = (sample_rate_converter_sample_t)(
+				TONE_AMPLITUDE * sin(2 * PI * TONE_HZ * n / rate_in));
+		}
+
+		/* Only the conversion is timed, not the generation of the tone */
+		start = test_benchmark_time_ns();
+		ret = sample_rate_converter_polyphase_process(
+			&bench_ctx, bench_input, block_samples * sizeof(bench_input[0]),
+			&bench_output[total], sizeof(bench_output) - total * sizeof(bench_output[0]),
+			&written);
+		ns += test_benchmark_time_ns() - start;
+
+		zassert_equal(ret, 0, "Process failed (%d)", ret);
+		total += written / sizeof(bench_output[0]);
+	}
+
+	thd_n = thd_n_db(&bench_output[SETTLE_SAMPLES], total - 2 * SETTLE_SAMPLES, TONE_HZ,
+			 rate_out);
+
+	TC_PRINT("%u -> %u Hz: %llu ns/block, THD+N %d.%d dB\n", rate_in, rate_out,
+		 (unsigned long long)(ns / NUM_BLOCKS), (int)thd_n, abs((int)(thd_n * 10) % 10));
+
+	zassert_true(ns > 0, "No time elapsed for %u -> %u Hz", rate_in, rate_out);
+
+	zassert_true(thd_n < THD_N_LIMIT_DB, "THD+N too high for %u -> %u Hz", rate_in, rate_out);
+}
+
+ZTEST(suite_sample_rate_converter_benchmark, test_polyphase)
+{
+	run_conversion(44100, 48000);
+	run_conversion(48000, 44100);
+	run_conversion(48000, 16000);
+	run_conversion(16000, 48000);
+	run_conversion(48000, 24000);
+	run_conversion(32000, 48000);
+}
+
+ZTEST_SUITE(suite_sample_rate_converter_benchmark, NULL, NULL, NULL, NULL, NULL);
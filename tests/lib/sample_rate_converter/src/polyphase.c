@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <sample_rate_converter.h>
+
+#define BLOCK_SAMPLES 441
+
+static struct sample_rate_converter_polyphase_ctx poly_ctx;
+static sample_rate_converter_sample_t input_block[BLOCK_SAMPLES];
+static sample_rate_converter_sample_t output_block[BLOCK_SAMPLES * 8 + 2];
+
+static size_t run_blocks(int num_blocks, sample_rate_converter_sample_t value)
+{
+	size_t total = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(input_block); i++) {
+		input_block[i] = value;
+	}
+
+	for (int b = 0; b < num_blocks; b++) {
+		size_t written;
+		int ret;
+
+		ret = sample_rate_converter_polyphase_process(&poly_ctx, input_block,
+							      sizeof(input_block), output_block,
+							      sizeof(output_block), &written);
+		zassert_equal(ret, 0, "Process failed (%d)", ret);
+		total += written / sizeof(sample_rate_converter_sample_t);
+	}
+
+	return total;
+}
+
+ZTEST(suite_sample_rate_converter_polyphase, test_output_count_44100_to_48000)
+{
+	int ret;
+	size_t total;
+
+	ret = sample_rate_converter_polyphase_open(&poly_ctx, 44100, 48000);
+	zassert_equal(ret, 0, "Open failed (%d)", ret);
+
+	/* 100 blocks of 441 samples is one second of input */
+	total = run_blocks(100, 1000);
+
+	/* Only the filter delay may be held back */
+	zassert_within(total, 48000, CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS,
+		       "Unexpected number of output samples: %d", total);
+}
+
+ZTEST(suite_sample_rate_converter_polyphase, test_dc_gain)
+{
+	int ret;
+
+	ret = sample_rate_converter_polyphase_open(&poly_ctx, 48000, 16000);
+	zassert_equal(ret, 0, "Open failed (%d)", ret);
+
+	(void)run_blocks(4, 1000);
+
+	/* Filter has settled, the last block must pass DC unchanged within rounding */
+	zassert_within(output_block[0], 1000, 1, "DC gain not unity: %d", output_block[0]);
+}
+
+ZTEST(suite_sample_rate_converter_polyphase, test_drift_correction)
+{
+	int ret;
+	size_t total;
+
+	ret = sample_rate_converter_polyphase_open(&poly_ctx, 48000, 48000);
+	zassert_equal(ret, 0, "Open failed (%d)", ret);
+
+	/* Consume input 0.1 % faster than nominal */
+	ret = sample_rate_converter_polyphase_drift_set(&poly_ctx, 1000000);
+	zassert_equal(ret, 0, "Drift set failed (%d)", ret);
+
+	total = run_blocks(200, 0);
+
+	zassert_within(total, (200 * BLOCK_SAMPLES) - (200 * BLOCK_SAMPLES) / 1000,
+		       CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS,
+		       "Drift not applied, %d output samples", total);
+}
+
+ZTEST(suite_sample_rate_converter_polyphase, test_invalid_parameters)
+{
+	int ret;
+	size_t written;
+
+	ret = sample_rate_converter_polyphase_open(NULL, 44100, 48000);
+	zassert_equal(ret, -EINVAL, "NULL context accepted");
+
+	ret = sample_rate_converter_polyphase_open(&poly_ctx, 0, 48000);
+	zassert_equal(ret, -EINVAL, "Zero sample rate accepted");
+
+	ret = sample_rate_converter_polyphase_open(&poly_ctx, 8000, 96000);
+	zassert_equal(ret, -EINVAL, "Too large ratio accepted");
+
+	ret = sample_rate_converter_polyphase_open(&poly_ctx, 44100, 48000);
+	zassert_equal(ret, 0, "Open failed (%d)", ret);
+
+	ret = sample_rate_converter_polyphase_drift_set(
+		&poly_ctx, SAMPLE_RATE_CONVERTER_POLYPHASE_DRIFT_MAX_PPB + 1);
+	zassert_equal(ret, -EINVAL, "Too large drift accepted");
+
+	ret = sample_rate_converter_polyphase_process(&poly_ctx, input_block, 1, output_block,
+						      sizeof(output_block), &written);
+	zassert_equal(ret, -EINVAL, "Input size not a sample multiple accepted");
+
+	ret = sample_rate_converter_polyphase_process(&poly_ctx, input_block, sizeof(input_block),
+						      NULL, sizeof(output_block), &written);
+	zassert_equal(ret, -EINVAL, "NULL output accepted");
+}
+
+ZTEST_SUITE(suite_sample_rate_converter_polyphase, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/ztest.h>
+
+#include "jitter_buf.h"
+#include "traces.h"
+
+#define FRAME_DUR_US	 10000
+#define BLK_DUR_US	 500
+#define BLKS_PER_FRAME	 (FRAME_DUR_US / BLK_DUR_US)
+#define DEPTH_MIN_US	 1000
+#define DEPTH_MAX_US	 50000
+#define MARGIN_US	 500
+#define WINDOW_US	 500000
+#define WINDOW_FRAMES	 (WINDOW_US / FRAME_DUR_US)
+#define PLC_FRAMES_MAX	 3
+/* Frames before the buffer has grown from empty to its target depth */
+#define START_FRAMES	 10
+/* Arbitrary start of the SDU reference clock, to cover wrapping */
+#define REF_TS_START_US	 (UINT32_MAX - (100 * FRAME_DUR_US))
+
+struct replay_result {
+	uint32_t underruns;
+	/* Index of the last frame that was preceded by an under-run, or -1 */
+	int last_underrun_frame;
+	/* Highest audio level in the buffer at the arrival of a frame */
+	uint32_t max_level_us;
+};
+
+static struct jitter_buf jb;
+
+/* Feed an arrival trace to the jitter buffer, and play the output buffer out block by block,
+ * in the same way as the audio datapath does.
+ */
+static void replay(const int16_t *trace, size_t len, size_t from, struct replay_result *result)
+{
+	uint32_t num_blks = 0;
+	uint32_t next_blk_us = 0;
+	bool started = false;
+
+	memset(result, 0, sizeof(*result));
+	result->last_underrun_frame = -1;
+
+	for (size_t i = 0; i < len; i++) {
+		uint32_t ref_ts_us = REF_TS_START_US + (i * FRAME_DUR_US);
+		uint32_t rx_ts_us = ref_ts_us + trace[i];
+		uint32_t level_us;
+		uint32_t num_missing;
+		int32_t depth_adj_us;
+
+		if (trace[i] == TRACE_LOST) {
+			continue;
+		}
+
+		/* Play out the blocks that are due before the frame arrives */
+		while (started && (int32_t)(rx_ts_us - next_blk_us) >= 0) {
+			if (num_blks > 0) {
+				num_blks--;
+			} else if (i >= from) {
+				result->underruns++;
+				result->last_underrun_frame = i;
+			}
+
+			next_blk_us += BLK_DUR_US;
+		}
+
+		if (!started) {
+			started = true;
+			next_blk_us = rx_ts_us;
+		}
+
+		level_us = num_blks * BLK_DUR_US;
+
+		num_missing = jitter_buf_gap_get(&jb, ref_ts_us, level_us);
+		num_blks += (num_missing + 1) * BLKS_PER_FRAME;
+
+		depth_adj_us = jitter_buf_frame_rx(&jb, ref_ts_us, rx_ts_us, level_us, num_missing,
+						   false);
+		if (depth_adj_us > 0) {
+			num_blks++;
+		} else if (depth_adj_us < 0 && num_blks > 1) {
+			num_blks--;
+		}
+
+		if (i >= from) {
+			result->max_level_us = MAX(result->max_level_us, level_us);
+		}
+	}
+}
+
+static void jitter_buf_setup(uint32_t depth_min_us)
+{
+	int ret;
+
+	ret = jitter_buf_init(&jb, FRAME_DUR_US, BLK_DUR_US, depth_min_us, DEPTH_MAX_US, MARGIN_US,
+			      WINDOW_US, PLC_FRAMES_MAX);
+	zassert_ok(ret);
+}
+
+ZTEST(suite_jitter_buf, test_init_invalid)
+{
+	int ret;
+
+	ret = jitter_buf_init(&jb, 0, BLK_DUR_US, DEPTH_MIN_US, DEPTH_MAX_US, MARGIN_US,
+			      WINDOW_US, PLC_FRAMES_MAX);
+	zassert_equal(ret, -EINVAL);
+
+	ret = jitter_buf_init(&jb, FRAME_DUR_US, BLK_DUR_US, DEPTH_MAX_US, DEPTH_MIN_US,
+			      MARGIN_US, WINDOW_US, PLC_FRAMES_MAX);
+	zassert_equal(ret, -EINVAL);
+
+	ret = jitter_buf_init(&jb, FRAME_DUR_US, BLK_DUR_US, DEPTH_MIN_US, DEPTH_MAX_US,
+			      MARGIN_US, FRAME_DUR_US - 1, PLC_FRAMES_MAX);
+	zassert_equal(ret, -EINVAL);
+}
+
+ZTEST(suite_jitter_buf, test_clean_link_lowest_depth)
+{
+	struct replay_result result;
+	struct jitter_buf_stats stats;
+
+	jitter_buf_setup(DEPTH_MIN_US);
+
+	replay(trace_clean, trace_clean_len, START_FRAMES, &result);
+	jitter_buf_stats_get(&jb, &stats);
+
+	zassert_equal(result.underruns, 0);
+	zassert_equal(stats.late_frames, 0);
+	zassert_equal(stats.concealed_frames, 0);
+	/* 400 us of jitter and the margin need less than two blocks */
+	zassert_equal(stats.target_us, 2 * BLK_DUR_US);
+	zassert_true(stats.late_peak_us <= 400, "Late peak %d us", stats.late_peak_us);
+	zassert_true(result.max_level_us <= stats.target_us + BLK_DUR_US, "Level %d us",
+		     result.max_level_us);
+}
+
+ZTEST(suite_jitter_buf, test_burst_adapts_and_recovers)
+{
+	struct replay_result result;
+	struct jitter_buf_stats stats;
+
+	jitter_buf_setup(DEPTH_MIN_US);
+
+	/* Late frames come every 17 frames from frame 100 */
+	replay(trace_burst, 300, START_FRAMES, &result);
+	jitter_buf_stats_get(&jb, &stats);
+
+	/* Only the first late frames run the buffer empty, before the depth has grown */
+	zassert_true(result.last_underrun_frame < 100 + (3 * 17), "Under-run at frame %d",
+		     result.last_underrun_frame);
+	zassert_true(stats.late_frames > 0);
+	zassert_true(stats.late_peak_us >= 4000, "Late peak %d us", stats.late_peak_us);
+	zassert_true(stats.target_us >= stats.late_peak_us + MARGIN_US);
+
+	/* The depth goes back to the lowest value when the link has been stable for two
+	 * windows
+	 */
+	jitter_buf_setup(DEPTH_MIN_US);
+
+	replay(trace_burst, trace_burst_len, 300 + (2 * WINDOW_FRAMES), &result);
+	jitter_buf_stats_get(&jb, &stats);
+
+	zassert_equal(result.underruns, 0);
+	zassert_equal(stats.target_us, 2 * BLK_DUR_US);
+}
+
+ZTEST(suite_jitter_buf, test_lost_frames_concealed)
+{
+	struct replay_result result;
+	struct jitter_buf_stats stats;
+
+	/* A depth of 25 ms leaves room to conceal up to two missing frames */
+	jitter_buf_setup(25000);
+
+	replay(trace_lossy, 300, START_FRAMES, &result);
+	jitter_buf_stats_get(&jb, &stats);
+
+	zassert_equal(result.underruns, 0);
+	zassert_equal(stats.late_frames, 0);
+	/* Single lost frames at 40, 77, 114, 151, 188, 225 and 262, and two at 200 */
+	zassert_equal(stats.concealed_frames, 9);
+}
+
+ZTEST(suite_jitter_buf, test_long_gap_not_concealed)
+{
+	struct replay_result result;
+	struct jitter_buf_stats stats;
+
+	jitter_buf_setup(25000);
+
+	replay(trace_lossy, trace_lossy_len, START_FRAMES, &result);
+	jitter_buf_stats_get(&jb, &stats);
+
+	/* The five lost frames at 310 are played as silence, the single lost frames at 299,
+	 * 336 and 373 are concealed
+	 */
+	zassert_equal(stats.concealed_frames, 12);
+	zassert_true(result.underruns > 0);
+	zassert_true(result.last_underrun_frame == 315, "Under-run at frame %d",
+		     result.last_underrun_frame);
+}
+
+ZTEST(suite_jitter_buf, test_gap_get)
+{
+	uint32_t ref_ts_us = REF_TS_START_US;
+
+	jitter_buf_setup(DEPTH_MIN_US);
+
+	/* Nothing to conceal before the first frame */
+	zassert_equal(jitter_buf_gap_get(&jb, ref_ts_us, FRAME_DUR_US), 0);
+
+	(void)jitter_buf_frame_rx(&jb, ref_ts_us, ref_ts_us + 2000, 0, 0, false);
+
+	zassert_equal(jitter_buf_gap_get(&jb, ref_ts_us + FRAME_DUR_US, FRAME_DUR_US), 0);
+	zassert_equal(jitter_buf_gap_get(&jb, ref_ts_us + (2 * FRAME_DUR_US) + 100, FRAME_DUR_US),
+		      1);
+	zassert_equal(jitter_buf_gap_get(&jb, ref_ts_us + (4 * FRAME_DUR_US) - 100, FRAME_DUR_US),
+		      3);
+	/* More frames missing than can be concealed */
+	zassert_equal(jitter_buf_gap_get(&jb, ref_ts_us + (5 * FRAME_DUR_US), FRAME_DUR_US), 0);
+	/* The output buffer has run empty */
+	zassert_equal(jitter_buf_gap_get(&jb, ref_ts_us + (2 * FRAME_DUR_US), 0), 0);
+}
+
+ZTEST(suite_jitter_buf, test_depth_limited)
+{
+	uint32_t ref_ts_us = REF_TS_START_US;
+	struct jitter_buf_stats stats;
+
+	jitter_buf_setup(DEPTH_MIN_US);
+
+	(void)jitter_buf_frame_rx(&jb, ref_ts_us, ref_ts_us, 0, 0, false);
+	(void)jitter_buf_frame_rx(&jb, ref_ts_us + FRAME_DUR_US,
+				  ref_ts_us + FRAME_DUR_US + (2 * DEPTH_MAX_US), 0, 0, false);
+
+	jitter_buf_stats_get(&jb, &stats);
+
+	zassert_equal(stats.target_us, DEPTH_MAX_US);
+}
+
+ZTEST(suite_jitter_buf, test_bad_frames_counted)
+{
+	uint32_t ref_ts_us = REF_TS_START_US;
+	struct jitter_buf_stats stats;
+
+	jitter_buf_setup(DEPTH_MIN_US);
+
+	for (int i = 0; i < 4; i++) {
+		(void)jitter_buf_frame_rx(&jb, ref_ts_us + (i * FRAME_DUR_US),
+					  ref_ts_us + (i * FRAME_DUR_US) + 2000, FRAME_DUR_US, 0,
+					  i % 2);
+	}
+
+	jitter_buf_stats_get(&jb, &stats);
+
+	zassert_equal(stats.concealed_frames, 2);
+}
+
+ZTEST_SUITE(suite_jitter_buf, NULL, NULL, NULL, NULL, NULL);
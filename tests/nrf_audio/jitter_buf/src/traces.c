@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "traces.h"
+
+#include <zephyr/sys/util.h>
+
+/* Stable link, arrivals spread over 400 us */
+const int16_t trace_clean[] = {
+	1833, 2054, 2098, 2131, 1868, 2174, 1878, 1879, 2039, 2185,
+	2034, 2025, 2105, 2126, 1968, 1881, 1928, 2014, 2188, 1890,
+	1800, 1813, 2049, 2134, 1826, 2126, 1874, 1900, 2025, 2112,
+	2132, 1840, 1858, 1977, 1863, 1851, 1876, 2178, 1938, 2062,
+	1815, 1898, 2111, 2183, 2016, 1939, 1983, 1972, 2180, 2158,
+	2043, 2136, 2172, 1981, 2024, 1992, 2157, 1852, 1859, 1869,
+	1995, 2196, 1914, 1960, 2179, 1948, 2074, 1937, 2166, 1997,
+	2168, 2013, 1963, 2150, 2145, 1894, 2199, 2153, 2188, 1985,
+	1828, 2095, 2030, 1937, 2141, 1840, 2020, 1865, 2127, 1989,
+	1871, 2147, 2169, 2063, 2139, 1861, 2182, 2015, 2138, 1887,
+	1867, 1976, 2009, 1942, 2167, 2178, 2052, 2108, 1943, 1941,
+	1919, 1802, 1948, 1803, 1925, 1862, 1856, 2197, 2061, 1863,
+	2055, 1949, 1821, 1895, 1890, 2182, 2200, 1937, 1889, 2182,
+	2086, 2017, 1864, 2061, 2178, 1998, 1883, 1981, 1928, 1868,
+	2051, 2166, 1979, 2136, 2081, 2024, 2069, 2134, 1868, 2074,
+	1908, 1859, 1944, 2050, 1950, 2045, 1844, 1852, 1960, 2040,
+	1852, 2078, 1977, 2109, 2140, 1826, 1937, 1963, 1962, 2142,
+	1893, 2147, 2025, 1994, 1823, 2094, 1981, 2138, 2009, 2084,
+	2128, 2109, 1895, 1963, 1852, 2041, 1861, 1855, 2064, 2065,
+	2030, 2106, 2056, 1888, 2067, 2200, 2085, 1915, 2124, 2095,
+	2000, 2131, 1977, 2087, 1936, 1867, 2047, 1852, 2070, 2135,
+	1933, 1952, 2064, 1876, 2184, 1891, 1966, 2042, 1853, 2097,
+	2051, 1808, 2073, 2192, 2169, 2038, 1894, 2141, 1926, 2150,
+	2054, 1924, 1938, 2001, 2199, 2106, 2039, 1994, 1918, 2072,
+	1898, 2147, 2084, 2198, 1944, 1951, 2143, 1903, 1989, 2118,
+	2081, 2074, 2038, 2024, 2048, 1978, 1933, 1892, 1969, 2125,
+	2063, 2115, 2106, 1832, 2017, 1980, 2166, 1894, 1875, 1976,
+	2125, 1943, 2095, 1876, 2004, 1810, 1935, 2091, 1928, 1831,
+	2155, 1929, 1871, 1829, 2028, 1990, 1908, 2180, 1830, 2002,
+	2200, 2046, 1910, 2146, 1978, 2150, 2178, 2101, 2031, 1985,
+	1937, 2153, 2041, 1903, 2198, 1809, 1972, 1876, 2150, 1876,
+	1844, 2153, 1824, 2091, 2084, 2188, 1840, 1984, 2111, 2066,
+	2139, 1953, 2110, 1815, 1882, 1856, 2172, 1913, 2014, 1809,
+	1985, 1977, 1988, 1850, 1925, 1993, 2188, 2151, 2086, 1816,
+	1877, 2082, 1920, 1883, 2069, 1815, 2066, 1960, 1835, 1930,
+	2087, 2159, 2096, 1939, 2061, 2000, 2068, 2088, 1841, 1879,
+	2028, 2052, 1966, 1956, 1857, 1974, 1980, 1934, 2135, 1826,
+	2099, 1977, 2075, 1945, 2198, 2157, 2110, 2157, 1932, 1883,
+	1976, 2054, 2029, 1819, 1825, 2101, 1982, 1809, 2048, 1826,
+	2031, 1852, 1883, 1853, 1823, 2115, 2027, 1840, 1917, 2166,
+};
+const size_t trace_clean_len = ARRAY_SIZE(trace_clean);
+
+/* Periodic late arrivals of 4 to 7 ms from frame 100 to 300, as caused by
+ * coexistence with another radio, then a stable link
+ */
+const int16_t trace_burst[] = {
+	2165, 1875, 2067, 1973, 1845, 2177, 1909, 1924, 1922, 1854,
+	2156, 2084, 2172, 2038, 2124, 2164, 1878, 2107, 2197, 1965,
+	2137, 1835, 2061, 2097, 1987, 1914, 2163, 1820, 2086, 1948,
+	2055, 1965, 2040, 2003, 2090, 2150, 1998, 2179, 2147, 2111,
+	1824, 1801, 2032, 1868, 1900, 1895, 2142, 2137, 1840, 2046,
+	2059, 1848, 1830, 2040, 1878, 1957, 1856, 2059, 1862, 1815,
+	2066, 1815, 2164, 2049, 1853, 2029, 1922, 1886, 1997, 2050,
+	2102, 2063, 1888, 2044, 1838, 1904, 2139, 2180, 1900, 2185,
+	2185, 1921, 1884, 1846, 1971, 1820, 2031, 1957, 1910, 1840,
+	1820, 1984, 2083, 1875, 2120, 2109, 2160, 2023, 2182, 2073,
+	2170, 1948, 2033, 2038, 2181, 2028, 1952, 7242, 1912, 1819,
+	1986, 2132, 1894, 2070, 1822, 1869, 2140, 1903, 2137, 2139,
+	1814, 1924, 2117, 1831, 6975, 1841, 2034, 1923, 1827, 1870,
+	2141, 1915, 1959, 2155, 1825, 2059, 2138, 1890, 1856, 1965,
+	2126, 8253, 1925, 1958, 2117, 1839, 1970, 2069, 2128, 2153,
+	1978, 2161, 1804, 2049, 1892, 2099, 2095, 1929, 6612, 2035,
+	1993, 2044, 1830, 1972, 1885, 1985, 1972, 2161, 2000, 2141,
+	2158, 2166, 1836, 2046, 2160, 7473, 1835, 1965, 2105, 1841,
+	2099, 2033, 2182, 2055, 1852, 2036, 2127, 1888, 1822, 1825,
+	1985, 2060, 8808, 1848, 1987, 2107, 2035, 2060, 2119, 1981,
+	2161, 2126, 2170, 1856, 2089, 2063, 1903, 2091, 2179, 8513,
+	1865, 1902, 2117, 1822, 2043, 1917, 2039, 2060, 2013, 1972,
+	1880, 1977, 2132, 1920, 2141, 1975, 6779, 1883, 1809, 2009,
+	1813, 2006, 2008, 2074, 2110, 2193, 1888, 1892, 2077, 1917,
+	2180, 1947, 1842, 8820, 1944, 2138, 2003, 2066, 2132, 2018,
+	2153, 1873, 1976, 1894, 2043, 1916, 2080, 2081, 2053, 1876,
+	6746, 1816, 2079, 1841, 2040, 2028, 1927, 1922, 1972, 2127,
+	2157, 2054, 2014, 1910, 1805, 2107, 1951, 7945, 1977, 1918,
+	2190, 1889, 2185, 2027, 1873, 1988, 1936, 2082, 1847, 1812,
+	2030, 1820, 2054, 2016, 7916, 1926, 1807, 1838, 1992, 1801,
+	1893, 1937, 2149, 1812, 2090, 2168, 2119, 2055, 2118, 2024,
+	2046, 1921, 2075, 1985, 2097, 2150, 2099, 2053, 1861, 2150,
+	2091, 1972, 2176, 1964, 1958, 1910, 1821, 2058, 1830, 2073,
+	2040, 1837, 1962, 1927, 2166, 1842, 1990, 2180, 2063, 1947,
+	1931, 2105, 2170, 2140, 2073, 2003, 2033, 1850, 1859, 1861,
+	1880, 1941, 2138, 2145, 1894, 2200, 1847, 1806, 1846, 1965,
+	2041, 1990, 1861, 1908, 2127, 2057, 2192, 2055, 2069, 1921,
+	2080, 1838, 2188, 1835, 2064, 2032, 1811, 2027, 1968, 2199,
+	1913, 1988, 2115, 2106, 2093, 1897, 2164, 2163, 1973, 2066,
+	1894, 2011, 1932, 2135, 1855, 1884, 1987, 1860, 1938, 2157,
+	1962, 2055, 1820, 2048, 1905, 2028, 1805, 1831, 1906, 1837,
+	2177, 1895, 2126, 1973, 2175, 1952, 1944, 2056, 2173, 2132,
+	1803, 1888, 1807, 2095, 1810, 2028, 2003, 1808, 2083, 2006,
+	1969, 2158, 1972, 2086, 2123, 2096, 2171, 1839, 2165, 2037,
+	2134, 1978, 2009, 2007, 2055, 1879, 2190, 2030, 2011, 2156,
+	2017, 1817, 2011, 2093, 2042, 1930, 1820, 2153, 2158, 2036,
+	1919, 2194, 2065, 1874, 2067, 1939, 1914, 2066, 1900, 1872,
+	2040, 1924, 1897, 1942, 2082, 1984, 1965, 1911, 2150, 1962,
+	1852, 2180, 2060, 2074, 2163, 1817, 1950, 2200, 2094, 1947,
+	2156, 1859, 1944, 2198, 1800, 1952, 1873, 1930, 2110, 1823,
+	1926, 1823, 2106, 2017, 1980, 1876, 2043, 1841, 1947, 2138,
+	1892, 1825, 2110, 1866, 1887, 2069, 1942, 1889, 1958, 1985,
+	1943, 1821, 2063, 1934, 2142, 1984, 2162, 2154, 1911, 1842,
+	2196, 2153, 1923, 2040, 1868, 1940, 2076, 1814, 2162, 2046,
+	2163, 2169, 1922, 2038, 1883, 2064, 1994, 2039, 1964, 2096,
+	1868, 2069, 2018, 2163, 2059, 1800, 1888, 2064, 2137, 1885,
+	1910, 2004, 1845, 1934, 1926, 1912, 2026, 1969, 1895, 2162,
+	2129, 1972, 2032, 2112, 2200, 2034, 2127, 1808, 2121, 1814,
+	1892, 2181, 1969, 2029, 1844, 1942, 2093, 1844, 2166, 1914,
+	1904, 1853, 1868, 2095, 1821, 2099, 1864, 2100, 1967, 1860,
+};
+const size_t trace_burst_len = ARRAY_SIZE(trace_burst);
+
+/* Stable link with single lost frames, two consecutive lost frames at frame 200
+ * and five consecutive lost frames at frame 310
+ */
+const int16_t trace_lossy[] = {
+	2075, 2119, 2023, 2049, 2162, 1940, 2153, 2127, 1807, 1955,
+	1885, 2003, 1891, 1815, 1877, 2124, 2109, 1825, 1902, 1989,
+	2177, 2134, 2071, 1840, 1883, 1899, 2039, 2001, 1826, 2151,
+	2081, 2085, 1962, 1878, 1818, 1943, 2102, 1942, 2061, 1948,
+	TRACE_LOST, 1901, 1890, 2081, 2154, 1888, 1916, 1952, 1840, 1972,
+	2116, 2042, 1832, 2094, 1992, 1806, 2031, 1991, 2022, 1830,
+	1961, 1937, 1829, 1891, 2032, 1823, 1880, 2089, 1936, 2064,
+	1876, 1871, 1812, 1960, 1926, 1888, 2087, TRACE_LOST, 1975, 2193,
+	1945, 1972, 2159, 1856, 1841, 1805, 2163, 2195, 2013, 1942,
+	2001, 1872, 2047, 1806, 2102, 1997, 2016, 2133, 2033, 1877,
+	2120, 2084, 2111, 1972, 2045, 2045, 1894, 2167, 1995, 1829,
+	1981, 1894, 2128, 1985, TRACE_LOST, 1833, 2196, 1960, 1805, 1883,
+	2049, 1818, 1876, 2178, 2039, 2157, 1802, 2109, 2080, 2131,
+	2038, 1934, 1867, 1823, 1997, 1906, 2025, 1873, 2178, 1942,
+	1867, 2029, 1977, 2198, 2152, 1863, 1951, 2039, 2029, 2022,
+	1845, TRACE_LOST, 1981, 1912, 1923, 2167, 1962, 2111, 2175, 2184,
+	2169, 2075, 2116, 1820, 2157, 2020, 2096, 1893, 2030, 1907,
+	2037, 1823, 1986, 1893, 2025, 2073, 1876, 1948, 1867, 2164,
+	1842, 1948, 1951, 2061, 1946, 1937, 2069, 1969, TRACE_LOST, 2019,
+	2102, 1848, 2044, 2011, 2000, 1969, 2124, 2042, 1959, 2002,
+	TRACE_LOST, TRACE_LOST, 2193, 2187, 2067, 2035, 1890, 2056, 1973, 2065,
+	1854, 2153, 1816, 1978, 1957, 2129, 2132, 2149, 2172, 2130,
+	1889, 2100, 1901, 2049, 1840, TRACE_LOST, 1971, 1989, 2045, 2098,
+	1874, 2103, 2099, 2182, 1992, 1909, 1861, 1855, 2167, 1828,
+	2184, 1872, 1865, 1971, 1961, 1996, 1824, 2072, 2097, 1887,
+	2090, 1830, 1963, 1952, 2130, 1820, 2075, 1906, 1882, 1950,
+	1909, 1907, TRACE_LOST, 2152, 2107, 1819, 2194, 2076, 2103, 2070,
+	2049, 1974, 2040, 1877, 1957, 2161, 1863, 1900, 2054, 2072,
+	1801, 1921, 2118, 1961, 2099, 1923, 1852, 1937, 2008, 1941,
+	1841, 1819, 2197, 1953, 1967, 1864, 1824, 1913, 2067, TRACE_LOST,
+	1918, 2002, 1809, 2139, 2008, 2118, 1865, 1808, 2083, 1893,
+	TRACE_LOST, TRACE_LOST, TRACE_LOST, TRACE_LOST, TRACE_LOST, 1907, 2146, 2125, 2053, 1922,
+	2185, 1834, 1894, 1968, 2115, 1899, 1875, 2009, 1982, 1995,
+	2071, 2066, 1937, 2097, 2110, 2159, TRACE_LOST, 1813, 1832, 1837,
+	1848, 2016, 2096, 1884, 1955, 2192, 1929, 1935, 2027, 1890,
+	2197, 2198, 2062, 1942, 2127, 1813, 1869, 2181, 1964, 1935,
+	1994, 2142, 1914, 2016, 2122, 2192, 2116, 2118, 2081, 2180,
+	1945, 2039, 2130, TRACE_LOST, 1835, 1887, 1835, 2052, 1898, 1943,
+	1950, 2146, 2094, 2119, 2095, 1962, 1944, 2080, 1813, 1862,
+	1940, 1989, 1877, 2097, 2083, 2145, 1901, 1809, 1965, 2165,
+};
+const size_t trace_lossy_len = ARRAY_SIZE(trace_lossy);
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _TRACES_H_
+#define _TRACES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Arrival traces of 10 ms frames. Each entry is the reception time of a frame relative to its
+ * SDU reference in microseconds, or TRACE_LOST if the frame was not received.
+ */
+#define TRACE_LOST INT16_MIN
+
+extern const int16_t trace_clean[];
+extern const size_t trace_clean_len;
+
+extern const int16_t trace_burst[];
+extern const size_t trace_burst_len;
+
+extern const int16_t trace_lossy[];
+extern const size_t trace_lossy_len;
+
+#endif /* _TRACES_H_ */
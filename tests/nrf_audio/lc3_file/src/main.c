@@ -260,4 +260,277 @@ ZTEST(lc3_file, test_lc3_file_init_invalid_sd_card)
 	zassert_equal(1, sd_card_init_fake.call_count, "sd_card_init() should be called once");
 }
 
+#define CACHE_RING_SIZE	     (2 * LC3_FILE_CACHE_CHUNK_SIZE)
+#define CACHE_FRAME_SIZE_MAX 251
+#define GEN_NUM_FRAMES	     60
+
+static uint8_t cache_buf[LC3_FILE_CACHE_BUF_SIZE(CACHE_RING_SIZE, CACHE_FRAME_SIZE_MAX)];
+
+/* Generated LC3 file with frames of varying size, which wrap around the end of the ring */
+static uint8_t gen_file[sizeof(struct lc3_file_header) +
+		       GEN_NUM_FRAMES * (sizeof(uint16_t) + CACHE_FRAME_SIZE_MAX)];
+static size_t gen_file_size;
+static size_t gen_file_pos;
+
+static size_t gen_frame_size(int frame)
+{
+	return 1 + (frame * 97) % CACHE_FRAME_SIZE_MAX;
+}
+
+static void gen_file_create(void)
+{
+	struct lc3_file_header header = {
+		.file_id = 0xCC1C,
+		.hdr_size = sizeof(header),
+	};
+
+	memcpy(gen_file, &header, sizeof(header));
+	gen_file_size = sizeof(header);
+
+	for (int i = 0; i < GEN_NUM_FRAMES; i++) {
+		size_t frame_size = gen_frame_size(i);
+
+		gen_file[gen_file_size++] = frame_size & 0xFF;
+		gen_file[gen_file_size++] = frame_size >> 8;
+
+		for (size_t j = 0; j < frame_size; j++) {
+			gen_file[gen_file_size++] = i + j;
+		}
+	}
+
+	gen_file_pos = 0;
+}
+
+static int sd_card_read_gen_file_fake(char *buf, size_t *size, struct fs_file_t *f_seg_read_entry)
+{
+	ARG_UNUSED(f_seg_read_entry);
+
+	size_t read_size = MIN(*size, gen_file_size - gen_file_pos);
+
+	/* Frame data is read in chunks that end on a sector boundary */
+	if (gen_file_pos >= sizeof(struct lc3_file_header)) {
+		zassert_true(*size <= LC3_FILE_CACHE_CHUNK_SIZE, "Read larger than a chunk");
+		zassert_equal(0, (gen_file_pos + *size) % LC3_FILE_CACHE_CHUNK_SIZE,
+			      "Read not aligned to a sector boundary");
+	}
+
+	memcpy(buf, &gen_file[gen_file_pos], read_size);
+	gen_file_pos += read_size;
+	*size = read_size;
+
+	return 0;
+}
+
+ZTEST(lc3_file, test_lc3_file_cache_frame_get_valid)
+{
+	int ret;
+	struct lc3_file_ctx file;
+	struct lc3_file_cache cache;
+	const uint8_t *frame;
+	size_t frame_size;
+
+	sd_card_read_fake.custom_fake = sd_card_read_lc3_file_fake_valid;
+
+	ret = lc3_file_open(&file, "test.lc3");
+	zassert_equal(0, ret, "lc3_file_open() should return 0");
+
+	ret = lc3_file_cache_init(&cache, &file, cache_buf, CACHE_RING_SIZE,
+				  CACHE_FRAME_SIZE_MAX);
+	zassert_equal(0, ret, "lc3_file_cache_init() should return 0");
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(-EAGAIN, ret, "lc3_file_cache_frame_get() should return -EAGAIN");
+
+	ret = lc3_file_cache_fill(&cache);
+	zassert_equal(-ENODATA, ret, "lc3_file_cache_fill() should return -ENODATA");
+	zassert_equal(2, sd_card_read_fake.call_count,
+		      "sd_card_read() should be called once for the header and once for frames");
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(0, ret, "lc3_file_cache_frame_get() should return 0");
+	zassert_equal(lc3_file_dataset1_valid_frame1_size, frame_size, "Frame 1 size should match");
+	zassert_mem_equal(lc3_file_dataset1_valid_frame1, frame,
+			  lc3_file_dataset1_valid_frame1_size, "Frame 1 data should match");
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(0, ret, "lc3_file_cache_frame_get() should return 0");
+	zassert_mem_equal(lc3_file_dataset1_valid_frame2, frame,
+			  lc3_file_dataset1_valid_frame2_size, "Frame 2 data should match");
+
+	lc3_file_cache_frames_release(&cache);
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(0, ret, "lc3_file_cache_frame_get() should return 0");
+	zassert_mem_equal(lc3_file_dataset1_valid_frame3, frame,
+			  lc3_file_dataset1_valid_frame3_size, "Frame 3 data should match");
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(0, ret, "lc3_file_cache_frame_get() should return 0");
+	zassert_mem_equal(lc3_file_dataset1_valid_frame4, frame,
+			  lc3_file_dataset1_valid_frame4_size, "Frame 4 data should match");
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(0, ret, "lc3_file_cache_frame_get() should return 0");
+	zassert_mem_equal(lc3_file_dataset1_valid_frame5, frame,
+			  lc3_file_dataset1_valid_frame5_size, "Frame 5 data should match");
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(-ENODATA, ret, "lc3_file_cache_frame_get() should return -ENODATA");
+	zassert_equal(2, sd_card_read_fake.call_count, "sd_card_read() should not be called");
+}
+
+ZTEST(lc3_file, test_lc3_file_cache_frame_get_wrap)
+{
+	int ret;
+	struct lc3_file_ctx file;
+	struct lc3_file_cache cache;
+	const uint8_t *frame;
+	size_t frame_size;
+	int frame_num = 0;
+
+	gen_file_create();
+	sd_card_read_fake.custom_fake = sd_card_read_gen_file_fake;
+
+	ret = lc3_file_open(&file, "test.lc3");
+	zassert_equal(0, ret, "lc3_file_open() should return 0");
+
+	ret = lc3_file_cache_init(&cache, &file, cache_buf, CACHE_RING_SIZE,
+				  CACHE_FRAME_SIZE_MAX);
+	zassert_equal(0, ret, "lc3_file_cache_init() should return 0");
+
+	while (true) {
+		lc3_file_cache_frames_release(&cache);
+
+		ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+		if (ret == -EAGAIN) {
+			ret = lc3_file_cache_fill(&cache);
+			zassert_true(ret == 0 || ret == -ENODATA,
+				     "lc3_file_cache_fill() should succeed");
+			continue;
+		} else if (ret == -ENODATA) {
+			break;
+		}
+
+		zassert_equal(0, ret, "lc3_file_cache_frame_get() should return 0");
+		zassert_equal(gen_frame_size(frame_num), frame_size, "Frame %d size should match",
+			      frame_num);
+
+		for (size_t j = 0; j < frame_size; j++) {
+			zassert_equal((uint8_t)(frame_num + j), frame[j],
+				      "Frame %d data should match at %zu", frame_num, j);
+		}
+
+		frame_num++;
+	}
+
+	zassert_equal(GEN_NUM_FRAMES, frame_num, "All frames should be read");
+	zassert_true(sd_card_read_fake.call_count < GEN_NUM_FRAMES,
+		     "sd_card_read() should be called fewer times than there are frames");
+}
+
+ZTEST(lc3_file, test_lc3_file_cache_full)
+{
+	int ret;
+	struct lc3_file_ctx file;
+	struct lc3_file_cache cache;
+	const uint8_t *frame;
+	size_t frame_size;
+
+	gen_file_create();
+	sd_card_read_fake.custom_fake = sd_card_read_gen_file_fake;
+
+	ret = lc3_file_open(&file, "test.lc3");
+	zassert_equal(0, ret, "lc3_file_open() should return 0");
+
+	ret = lc3_file_cache_init(&cache, &file, cache_buf, CACHE_RING_SIZE,
+				  CACHE_FRAME_SIZE_MAX);
+	zassert_equal(0, ret, "lc3_file_cache_init() should return 0");
+
+	ret = lc3_file_cache_fill(&cache);
+	zassert_equal(0, ret, "lc3_file_cache_fill() should return 0");
+	/* The rest of the first sector and one full sector fit in the ring, the next does not */
+	zassert_equal(2 * LC3_FILE_CACHE_CHUNK_SIZE, gen_file_pos,
+		      "The ring should be filled up to the last chunk that fits");
+
+	/* Frames that are not released keep the ring full */
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(0, ret, "lc3_file_cache_frame_get() should return 0");
+
+	ret = lc3_file_cache_fill(&cache);
+	zassert_equal(0, ret, "lc3_file_cache_fill() should return 0");
+	zassert_equal(3, sd_card_read_fake.call_count, "sd_card_read() should not be called");
+}
+
+ZTEST(lc3_file, test_lc3_file_cache_frame_get_invalid_frame_too_large)
+{
+	int ret;
+	struct lc3_file_ctx file;
+	struct lc3_file_cache cache;
+	const uint8_t *frame;
+	size_t frame_size;
+
+	sd_card_read_fake.custom_fake = sd_card_read_lc3_file_fake_valid;
+
+	ret = lc3_file_open(&file, "test.lc3");
+	zassert_equal(0, ret, "lc3_file_open() should return 0");
+
+	ret = lc3_file_cache_init(&cache, &file, cache_buf, CACHE_RING_SIZE, 10);
+	zassert_equal(0, ret, "lc3_file_cache_init() should return 0");
+
+	ret = lc3_file_cache_fill(&cache);
+	zassert_equal(-ENODATA, ret, "lc3_file_cache_fill() should return -ENODATA");
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(-ENOMEM, ret, "lc3_file_cache_frame_get() should return -ENOMEM");
+}
+
+ZTEST(lc3_file, test_lc3_file_cache_frame_get_invalid_frame_size_mismatch)
+{
+	int ret;
+	struct lc3_file_ctx file;
+	struct lc3_file_cache cache;
+	const uint8_t *frame;
+	size_t frame_size;
+
+	sd_card_read_fake.custom_fake = sd_card_read_lc3_file_fake_invalid_frame;
+
+	ret = lc3_file_open(&file, "test.lc3");
+	zassert_equal(0, ret, "lc3_file_open() should return 0");
+
+	ret = lc3_file_cache_init(&cache, &file, cache_buf, CACHE_RING_SIZE,
+				  CACHE_FRAME_SIZE_MAX);
+	zassert_equal(0, ret, "lc3_file_cache_init() should return 0");
+
+	ret = lc3_file_cache_fill(&cache);
+	zassert_equal(-ENODATA, ret, "lc3_file_cache_fill() should return -ENODATA");
+
+	ret = lc3_file_cache_frame_get(&cache, &frame, &frame_size);
+	zassert_equal(-EIO, ret, "lc3_file_cache_frame_get() should return -EIO");
+}
+
+ZTEST(lc3_file, test_lc3_file_cache_init_invalid)
+{
+	int ret;
+	struct lc3_file_ctx file;
+	struct lc3_file_cache cache;
+
+	ret = lc3_file_cache_init(NULL, &file, cache_buf, CACHE_RING_SIZE, CACHE_FRAME_SIZE_MAX);
+	zassert_equal(-EINVAL, ret, "lc3_file_cache_init() should return -EINVAL");
+
+	ret = lc3_file_cache_init(&cache, &file, NULL, CACHE_RING_SIZE, CACHE_FRAME_SIZE_MAX);
+	zassert_equal(-EINVAL, ret, "lc3_file_cache_init() should return -EINVAL");
+
+	ret = lc3_file_cache_init(&cache, &file, cache_buf, CACHE_RING_SIZE - 1,
+				  CACHE_FRAME_SIZE_MAX);
+	zassert_equal(-EINVAL, ret, "lc3_file_cache_init() should return -EINVAL");
+
+	ret = lc3_file_cache_init(&cache, &file, cache_buf, CACHE_RING_SIZE, CACHE_RING_SIZE);
+	zassert_equal(-EINVAL, ret, "lc3_file_cache_init() should return -EINVAL");
+
+	/* A chunk does not fit in the ring next to a frame of the maximum size */
+	ret = lc3_file_cache_init(&cache, &file, cache_buf, LC3_FILE_CACHE_CHUNK_SIZE,
+				  CACHE_FRAME_SIZE_MAX);
+	zassert_equal(-EINVAL, ret, "lc3_file_cache_init() should return -EINVAL");
+}
+
 ZTEST_SUITE(lc3_file, NULL, NULL, test_setup, NULL, NULL);
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <modules/lc3_file.h>
+#include <modules/lc3_streamer.h>
+#include <stdint.h>
+
+#include "sd_card/sd_card_fake.h"
+#include "k_work/k_work_fake.h"
+
+#define GEN_NUM_FRAMES_MAX 60
+
+/* Generated LC3 file with frames of varying size, which wrap around the end of the ring */
+static uint8_t gen_file[sizeof(struct lc3_file_header) +
+		       GEN_NUM_FRAMES_MAX *
+			       (sizeof(uint16_t) + CONFIG_SD_CARD_LC3_STREAMER_MAX_FRAME_SIZE)];
+static size_t gen_file_size;
+static size_t gen_file_pos;
+
+static size_t gen_frame_size(int frame)
+{
+	return 1 + (frame * 97) % CONFIG_SD_CARD_LC3_STREAMER_MAX_FRAME_SIZE;
+}
+
+static void gen_file_create(int num_frames)
+{
+	struct lc3_file_header header = {
+		.file_id = 0xCC1C,
+		.hdr_size = sizeof(header),
+	};
+
+	memcpy(gen_file, &header, sizeof(header));
+	gen_file_size = sizeof(header);
+
+	for (int i = 0; i < num_frames; i++) {
+		size_t frame_size = gen_frame_size(i);
+
+		gen_file[gen_file_size++] = frame_size & 0xFF;
+		gen_file[gen_file_size++] = frame_size >> 8;
+
+		for (size_t j = 0; j < frame_size; j++) {
+			gen_file[gen_file_size++] = i + j;
+		}
+	}
+
+	gen_file_pos = 0;
+}
+
+/* Number of the first num_frames frames that wrap around the end of the ring */
+static int gen_frames_wrapped(int num_frames)
+{
+	int wrapped = 0;
+	size_t pos = sizeof(struct lc3_file_header);
+
+	for (int i = 0; i < num_frames; i++) {
+		size_t start = (pos + sizeof(uint16_t)) % CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD_SIZE;
+
+		if (start + gen_frame_size(i) > CONFIG_SD_CARD_LC3_STREAMER_READ_AHEAD_SIZE) {
+			wrapped++;
+		}
+
+		pos += sizeof(uint16_t) + gen_frame_size(i);
+	}
+
+	return wrapped;
+}
+
+static int sd_card_open_gen_file_fake(const char *filename, struct fs_file_t *f_seg_read_entry)
+{
+	ARG_UNUSED(filename);
+	ARG_UNUSED(f_seg_read_entry);
+
+	gen_file_pos = 0;
+
+	return 0;
+}
+
+static int sd_card_read_gen_file_fake(char *buf, size_t *size, struct fs_file_t *f_seg_read_entry)
+{
+	ARG_UNUSED(f_seg_read_entry);
+
+	size_t read_size = MIN(*size, gen_file_size - gen_file_pos);
+
+	memcpy(buf, &gen_file[gen_file_pos], read_size);
+	gen_file_pos += read_size;
+	*size = read_size;
+
+	return 0;
+}
+
+static void frame_check(int frame_num, const uint8_t *frame)
+{
+	zassert_not_null(frame, "Frame %d should not be NULL", frame_num);
+
+	for (size_t j = 0; j < gen_frame_size(frame_num); j++) {
+		zassert_equal((uint8_t)(frame_num + j), frame[j], "Frame %d data should match at %zu",
+			      frame_num, j);
+	}
+}
+
+static void *suite_setup(void)
+{
+	DO_FOREACH_FAKE(RESET_FAKE);
+	DO_FOREACH_K_WORK_FAKE(RESET_FAKE);
+
+	FFF_RESET_HISTORY();
+
+	int ret = lc3_streamer_init();
+
+	zassert_equal(0, ret, "lc3_streamer_init should return success");
+
+	return NULL;
+}
+
+static void test_setup(void *f)
+{
+	ARG_UNUSED(f);
+
+	DO_FOREACH_FAKE(RESET_FAKE);
+	DO_FOREACH_K_WORK_FAKE(RESET_FAKE);
+
+	FFF_RESET_HISTORY();
+
+	sd_card_open_fake.custom_fake = sd_card_open_gen_file_fake;
+	sd_card_read_fake.custom_fake = sd_card_read_gen_file_fake;
+	k_work_init_fake.custom_fake = k_work_init_valid_fake;
+}
+
+static void test_teardown(void *f)
+{
+	int ret;
+
+	ret = lc3_streamer_close_all_streams();
+	zassert_equal(0, ret, "lc3_streamer_close_all_streams should return success");
+}
+
+ZTEST(lc3_streamer_read_ahead, test_lc3_streamer_read_ahead_next_frame_get_valid_wrap)
+{
+	int ret;
+	uint8_t streamer_idx;
+	const uint8_t *frame_buffer;
+
+	gen_file_create(GEN_NUM_FRAMES_MAX);
+	zassert_true(gen_frames_wrapped(GEN_NUM_FRAMES_MAX) > 0,
+		     "Some frames should wrap around the end of the ring");
+
+	k_work_submit_to_queue_fake.custom_fake = k_work_submit_to_queue_valid_fake;
+
+	ret = lc3_streamer_stream_register("test", &streamer_idx, false);
+	zassert_equal(0, ret, "lc3_streamer_stream_register should return success");
+
+	for (int i = 0; i < GEN_NUM_FRAMES_MAX; i++) {
+		frame_buffer = NULL;
+
+		ret = lc3_streamer_next_frame_get(streamer_idx, &frame_buffer);
+		zassert_equal(0, ret, "lc3_streamer_next_frame_get should return success");
+		frame_check(i, frame_buffer);
+	}
+
+	ret = lc3_streamer_next_frame_get(streamer_idx, &frame_buffer);
+	zassert_equal(-ENODATA, ret, "lc3_streamer_next_frame_get should return -ENODATA");
+
+	zassert_true(sd_card_read_fake.call_count < GEN_NUM_FRAMES_MAX,
+		     "sd_card_read should be called fewer times than there are frames");
+}
+
+ZTEST(lc3_streamer_read_ahead, test_lc3_streamer_read_ahead_next_frame_get_valid_stream_end)
+{
+	int ret;
+	uint8_t streamer_idx;
+	const uint8_t *frame_buffer = NULL;
+
+	gen_file_create(3);
+	k_work_submit_to_queue_fake.custom_fake = k_work_submit_to_queue_valid_fake;
+
+	/* The whole file fits in the cache */
+	ret = lc3_streamer_stream_register("test", &streamer_idx, false);
+	zassert_equal(0, ret, "lc3_streamer_stream_register should return success");
+	zassert_equal(2, sd_card_read_fake.call_count,
+		      "sd_card_read should be called once for the header and once for frames");
+
+	for (int i = 0; i < 3; i++) {
+		ret = lc3_streamer_next_frame_get(streamer_idx, &frame_buffer);
+		zassert_equal(0, ret, "lc3_streamer_next_frame_get should return success");
+		frame_check(i, frame_buffer);
+	}
+
+	ret = lc3_streamer_next_frame_get(streamer_idx, &frame_buffer);
+	zassert_equal(-ENODATA, ret, "lc3_streamer_next_frame_get should return -ENODATA");
+
+	ret = lc3_streamer_next_frame_get(streamer_idx, &frame_buffer);
+	zassert_equal(-EFAULT, ret, "lc3_streamer_next_frame_get should return -EFAULT");
+
+	zassert_equal(2, sd_card_read_fake.call_count, "sd_card_read should not be called");
+	zassert_equal(0, sd_card_close_fake.call_count, "sd_card_close should not be called");
+}
+
+ZTEST(lc3_streamer_read_ahead, test_lc3_streamer_read_ahead_next_frame_get_valid_loop_stream)
+{
+	int ret;
+	uint8_t streamer_idx;
+	const uint8_t *frame_buffer = NULL;
+
+	gen_file_create(3);
+	k_work_submit_to_queue_fake.custom_fake = k_work_submit_to_queue_valid_fake;
+
+	ret = lc3_streamer_stream_register("test", &streamer_idx, true);
+	zassert_equal(0, ret, "lc3_streamer_stream_register should return success");
+
+	/* The frames of the reopened file follow the last frame without a gap */
+	for (int i = 0; i < 9; i++) {
+		ret = lc3_streamer_next_frame_get(streamer_idx, &frame_buffer);
+		zassert_equal(0, ret, "lc3_streamer_next_frame_get should return success");
+		frame_check(i % 3, frame_buffer);
+	}
+
+	zassert_true(sd_card_close_fake.call_count >= 2, "The file should be closed on each loop");
+	zassert_equal(sd_card_close_fake.call_count + 1, sd_card_open_fake.call_count,
+		      "The file should be reopened on each loop");
+}
+
+ZTEST(lc3_streamer_read_ahead, test_lc3_streamer_read_ahead_next_frame_get_not_ready)
+{
+	int ret;
+	uint8_t streamer_idx;
+	const uint8_t *frame_buffer = NULL;
+	int frame_num = 0;
+
+	gen_file_create(GEN_NUM_FRAMES_MAX);
+
+	/* The work queue does not run, the cache is only filled on register */
+	ret = lc3_streamer_stream_register("test", &streamer_idx, false);
+	zassert_equal(0, ret, "lc3_streamer_stream_register should return success");
+
+	while (true) {
+		ret = lc3_streamer_next_frame_get(streamer_idx, &frame_buffer);
+		if (ret) {
+			break;
+		}
+
+		frame_check(frame_num, frame_buffer);
+		frame_num++;
+	}
+
+	zassert_equal(-ENOMSG, ret, "lc3_streamer_next_frame_get should return -ENOMSG");
+	zassert_true(frame_num > 0, "Frames should be read from the cache");
+	zassert_true(frame_num < GEN_NUM_FRAMES_MAX, "The cache should not hold the whole file");
+
+	/* Run the work item submitted by the last call */
+	k_work_init_fake.arg1_val(k_work_submit_to_queue_fake.arg1_val);
+
+	ret = lc3_streamer_next_frame_get(streamer_idx, &frame_buffer);
+	zassert_equal(0, ret, "lc3_streamer_next_frame_get should return success");
+	frame_check(frame_num, frame_buffer);
+}
+
+ZTEST(lc3_streamer_read_ahead, test_lc3_streamer_read_ahead_stream_register_invalid_file)
+{
+	int ret;
+	uint8_t streamer_idx;
+
+	sd_card_read_fake.custom_fake = sd_card_read_fake_invalid_header;
+
+	ret = lc3_streamer_stream_register("test", &streamer_idx, false);
+	zassert_equal(-EINVAL, ret, "lc3_streamer_stream_register should return -EINVAL");
+	zassert_equal(0, lc3_streamer_num_active_streams(), "Number of active streams should be 0");
+}
+
+ZTEST_SUITE(lc3_streamer_read_ahead, NULL, suite_setup, test_setup, test_teardown, NULL);
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+
+#include <test_benchmark.h>
+
+#include <modules/sd_card.h>
+#include <modules/lc3_file.h>
+
+#define NUM_STREAMS	3
+#define NUM_FRAMES	500
+/* 10 ms frames at 96 kbps */
+#define FRAME_SIZE	120
+#define FRAME_SIZE_MAX	251
+#define CACHE_RING_SIZE (2 * LC3_FILE_CACHE_CHUNK_SIZE)
+
+static struct lc3_file_ctx files[NUM_STREAMS];
+static struct lc3_file_cache caches[NUM_STREAMS];
+static uint8_t cache_bufs[NUM_STREAMS][LC3_FILE_CACHE_BUF_SIZE(CACHE_RING_SIZE, FRAME_SIZE_MAX)];
+static uint8_t frame_buf[FRAME_SIZE_MAX];
+
+static void file_name_get(char *name, size_t size, int stream)
+{
+	snprintf(name, size, "bench_%d.lc3", stream);
+}
+
+static void lc3_file_create(int stream)
+{
+	int ret;
+	struct fs_file_t file;
+	char name[32];
+	char path[48];
+	uint8_t frame[sizeof(uint16_t) + FRAME_SIZE];
+	struct lc3_file_header header = {
+		.file_id = 0xCC1C,
+		.hdr_size = sizeof(header),
+		.sample_rate = 480,
+		.bit_rate = 960,
+		.channels = 1,
+		.frame_duration = 1000,
+	};
+
+	file_name_get(name, sizeof(name), stream);
+	snprintf(path, sizeof(path), "%s%s", SD_ROOT_PATH, name);
+
+	fs_file_t_init(&file);
+
+	ret = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+	zassert_ok(ret, "Failed to create %s", path);
+
+	ret = fs_write(&file, &header, sizeof(header));
+	zassert_equal(sizeof(header), ret);
+
+	frame[0] = FRAME_SIZE & 0xFF;
+	frame[1] = FRAME_SIZE >> 8;
+
+	for (int i = 0; i < NUM_FRAMES; i++) {
+		memset(&frame[sizeof(uint16_t)], i, FRAME_SIZE);
+		ret = fs_write(&file, frame, sizeof(frame));
+		zassert_equal(sizeof(frame), ret);
+	}
+
+	ret = fs_close(&file);
+	zassert_ok(ret);
+}
+
+static void frame_check(int frame_num, const uint8_t *frame, size_t frame_size)
+{
+	zassert_equal(FRAME_SIZE, frame_size, "Frame %d has the wrong size", frame_num);
+
+	for (int k = 0; k < FRAME_SIZE; k++) {
+		zassert_equal((uint8_t)frame_num, frame[k], "Frame %d has the wrong data",
+			      frame_num);
+	}
+}
+
+static void streams_open(void)
+{
+	int ret;
+	char name[32];
+
+	for (int i = 0; i < NUM_STREAMS; i++) {
+		file_name_get(name, sizeof(name), i);
+
+		ret = lc3_file_open(&files[i], name);
+		zassert_ok(ret);
+	}
+}
+
+static void streams_close(void)
+{
+	for (int i = 0; i < NUM_STREAMS; i++) {
+		lc3_file_close(&files[i]);
+	}
+}
+
+/* Read the frames of all streams in turn, one frame at a time. */
+static void run_sequential(void)
+{
+	int ret;
+	struct test_benchmark bench;
+
+	streams_open();
+
+	test_benchmark_start(&bench, "lc3_file one by one", NUM_FRAMES * NUM_STREAMS);
+
+	for (int i = 0; i < NUM_FRAMES; i++) {
+		for (int j = 0; j < NUM_STREAMS; j++) {
+			ret = lc3_file_frame_get(&files[j], frame_buf, sizeof(frame_buf));
+			zassert_ok(ret);
+			frame_check(i, frame_buf, FRAME_SIZE);
+		}
+	}
+
+	test_benchmark_stop(&bench);
+
+	for (int j = 0; j < NUM_STREAMS; j++) {
+		ret = lc3_file_frame_get(&files[j], frame_buf, sizeof(frame_buf));
+		zassert_equal(-ENODATA, ret, "All frames should have been read");
+	}
+
+	streams_close();
+}
+
+/* Get the next frame from the read-ahead cache, filling it when it is empty. */
+static int cache_frame_get(struct lc3_file_cache *cache, const uint8_t **frame,
+			   size_t *frame_size)
+{
+	int ret;
+
+	lc3_file_cache_frames_release(cache);
+
+	ret = lc3_file_cache_frame_get(cache, frame, frame_size);
+	if (ret == -EAGAIN) {
+		ret = lc3_file_cache_fill(cache);
+		zassert_true(ret == 0 || ret == -ENODATA);
+
+		ret = lc3_file_cache_frame_get(cache, frame, frame_size);
+	}
+
+	return ret;
+}
+
+/* Read the frames of all streams in turn through the read-ahead caches. */
+static void run_read_ahead(void)
+{
+	int ret;
+	struct test_benchmark bench;
+	const uint8_t *frame;
+	size_t frame_size;
+
+	streams_open();
+
+	for (int j = 0; j < NUM_STREAMS; j++) {
+		ret = lc3_file_cache_init(&caches[j], &files[j], cache_bufs[j], CACHE_RING_SIZE,
+					  FRAME_SIZE_MAX);
+		zassert_ok(ret);
+	}
+
+	test_benchmark_start(&bench, "lc3_file read-ahead", NUM_FRAMES * NUM_STREAMS);
+
+	for (int i = 0; i < NUM_FRAMES; i++) {
+		for (int j = 0; j < NUM_STREAMS; j++) {
+			ret = cache_frame_get(&caches[j], &frame, &frame_size);
+			zassert_ok(ret);
+			frame_check(i, frame, frame_size);
+		}
+	}
+
+	test_benchmark_stop(&bench);
+
+	for (int j = 0; j < NUM_STREAMS; j++) {
+		ret = cache_frame_get(&caches[j], &frame, &frame_size);
+		zassert_equal(-ENODATA, ret, "All frames should have been read");
+	}
+
+	streams_close();
+}
+
+/* Both runs read and check the same frames of the same files */
+ZTEST(lc3_file_benchmark, test_streams)
+{
+	run_sequential();
+	run_read_ahead();
+}
+
+static void *setup(void)
+{
+	int ret;
+
+	ret = lc3_file_init();
+	zassert_ok(ret, "Failed to initialize the SD card: %d", ret);
+
+	for (int i = 0; i < NUM_STREAMS; i++) {
+		lc3_file_create(i);
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(lc3_file_benchmark, NULL, setup, NULL, NULL, NULL);
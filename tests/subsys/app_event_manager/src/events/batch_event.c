@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "batch_event.h"
+#include "test_config.h"
+
+APP_EVENT_TYPE_DEFINE(batch_event,
+		  NULL,
+		  NULL,
+		  APP_EVENT_FLAGS_CREATE());
+
+APP_EVENT_POOL_DEFINE(batch_event, TEST_BATCH_POOL_SIZE);
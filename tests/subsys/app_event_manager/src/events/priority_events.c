@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "priority_events.h"
+
+APP_EVENT_TYPE_DEFINE(low_prio_event,
+		  NULL,
+		  NULL,
+		  APP_EVENT_FLAGS_CREATE());
+
+APP_EVENT_TYPE_DEFINE(high_prio_event,
+		  NULL,
+		  NULL,
+		  APP_EVENT_FLAGS_CREATE());
+
+/* Use the queue with the highest priority. Without multiple queues it is the default one. */
+APP_EVENT_QUEUE_ASSIGN(high_prio_event, APP_EVENT_QUEUE_CNT - 1);
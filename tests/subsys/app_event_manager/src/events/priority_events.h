@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _PRIORITY_EVENTS_H_
+#define _PRIORITY_EVENTS_H_
+
+/**
+ * @brief Priority Events
+ * @defgroup priority_events Priority Events
+ * @{
+ */
+
+#include <app_event_manager.h>
+#include <app_event_manager_profiler_tracer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct low_prio_event {
+	struct app_event_header header;
+
+	int val;
+};
+
+APP_EVENT_TYPE_DECLARE(low_prio_event);
+
+struct high_prio_event {
+	struct app_event_header header;
+};
+
+APP_EVENT_TYPE_DECLARE(high_prio_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _PRIORITY_EVENTS_H_ */
@@ -7,8 +7,11 @@
 #include <zephyr/ztest.h>
 #include <app_event_manager.h>
 
+#include "batch_event.h"
+#include "priority_events.h"
 #include "sized_events.h"
 #include "test_events.h"
+#include "test_config.h"
 
 static enum test_id cur_test_id;
 static K_SEM_DEFINE(test_end_sem, 0, 1);
@@ -78,6 +81,96 @@ ZTEST(suite0, test_multicontext)
 	test_start(TEST_MULTICONTEXT);
 }
 
+ZTEST(suite0, test_batch)
+{
+	test_start(TEST_BATCH);
+}
+
+ZTEST(suite0, test_queues)
+{
+	test_start(TEST_QUEUES);
+}
+
+ZTEST(suite0, test_queue_stats)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUE_STATS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	struct app_event_manager_queue_stats stats;
+
+	test_start(TEST_QUEUES);
+
+	zassert_equal(app_event_manager_queue_stats_get(APP_EVENT_QUEUE_CNT, &stats), -EINVAL,
+		      "Invalid queue accepted");
+
+	zassert_ok(app_event_manager_queue_stats_get(0, &stats), "Cannot get queue stats");
+	zassert_true(stats.depth_max >= TEST_QUEUES_LOW_CNT, "Depth not recorded");
+	zassert_true(stats.residence_max_us >= TEST_QUEUES_LOW_PROCESSING_US,
+		     "Residence time not recorded");
+
+	app_event_manager_queue_stats_reset();
+	zassert_ok(app_event_manager_queue_stats_get(0, &stats), "Cannot get queue stats");
+	zassert_equal(stats.processed_cnt, 0, "Stats not reset");
+	zassert_equal(stats.residence_max_us, 0, "Stats not reset");
+}
+
+ZTEST(suite0, test_latency_stats)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_LATENCY_STATS)) {
+		ztest_test_skip();
+		return;
+	}
+
+	struct app_event_manager_latency_stats stats;
+
+	app_event_manager_latency_stats_reset();
+	test_start(TEST_QUEUES);
+
+	zassert_equal(app_event_manager_latency_stats_get(APP_EVENT_ID(low_prio_event),
+							  "unknown", &stats),
+		      -ENOENT, "Unknown listener accepted");
+
+	zassert_ok(app_event_manager_latency_stats_get(APP_EVENT_ID(low_prio_event),
+						       "test_queues", &stats),
+		   "Cannot get handler stats");
+	zassert_equal(stats.cnt, TEST_QUEUES_LOW_CNT, "Unexpected handler count");
+	/* Allow for the resolution of the system clock. */
+	zassert_true(stats.p50_us >= TEST_QUEUES_LOW_PROCESSING_US / 2,
+		     "Handler time not recorded");
+	zassert_true(stats.p50_us <= stats.p99_us, "Unexpected percentiles");
+	zassert_true(stats.p99_us <= stats.max_us, "Unexpected percentiles");
+
+	/* The low priority events wait for the processing of the previous ones. */
+	zassert_ok(app_event_manager_latency_stats_get(APP_EVENT_ID(low_prio_event), NULL,
+						       &stats),
+		   "Cannot get residence stats");
+	zassert_equal(stats.cnt, TEST_QUEUES_LOW_CNT, "Unexpected residence count");
+	zassert_true(stats.max_us >= TEST_QUEUES_LOW_PROCESSING_US, "Residence time not recorded");
+
+	app_event_manager_latency_stats_reset();
+	zassert_ok(app_event_manager_latency_stats_get(APP_EVENT_ID(low_prio_event), NULL,
+						       &stats),
+		   "Cannot get residence stats");
+	zassert_equal(stats.cnt, 0, "Stats not reset");
+}
+
+ZTEST(suite0, test_event_free_unsubmitted)
+{
+	struct batch_event *events[TEST_BATCH_POOL_SIZE + 1];
+
+	/* Exhaust the pool so that the last event is allocated from the heap. */
+	for (size_t i = 0; i < ARRAY_SIZE(events); i++) {
+		events[i] = new_batch_event();
+		zassert_not_null(events[i], "Event allocation failed");
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(events); i++) {
+		app_event_manager_event_free(&events[i]->header);
+	}
+}
+
 ZTEST(suite0, test_event_size_static)
 {
 	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROVIDE_EVENT_SIZE)) {
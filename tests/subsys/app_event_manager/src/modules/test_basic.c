@@ -10,6 +10,7 @@
 #include "test_events.h"
 #include "data_event.h"
 #include "order_event.h"
+#include "batch_event.h"
 
 #include "test_config.h"
 
@@ -67,6 +68,20 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			break;
 		}
 
+		case TEST_BATCH:
+		{
+			/* Events submitted from a listener are processed together in the next
+			 * processor run, so they can be coalesced into a single batch.
+			 */
+			for (size_t i = 0; i < TEST_BATCH_EVENT_CNT; i++) {
+				struct batch_event *event = new_batch_event();
+
+				event->val = i;
+				APP_EVENT_SUBMIT(event);
+			}
+			break;
+		}
+
 		default:
 			/* Ignore other test cases, check if proper test_id. */
 			zassert_true(st->test_id < TEST_CNT,
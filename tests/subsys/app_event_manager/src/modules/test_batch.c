@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_events.h"
+#include "batch_event.h"
+
+#include "test_config.h"
+
+static int filter_expected_val;
+static int batch_expected_val;
+static int single_expected_val;
+static int batch_call_cnt;
+
+static int next_not_consumed(int val)
+{
+	val++;
+	if ((val % 4) == TEST_BATCH_CONSUMED_MOD) {
+		val++;
+	}
+
+	return val;
+}
+
+static bool app_event_handler_filter(const struct app_event_header *aeh)
+{
+	struct batch_event *event = cast_batch_event(aeh);
+
+	zassert_not_null(event, "Event unhandled");
+
+	if (event->val == 0) {
+		filter_expected_val = 0;
+		batch_expected_val = 0;
+		single_expected_val = 0;
+		batch_call_cnt = 0;
+	}
+
+	zassert_equal(event->val, filter_expected_val, "Incorrect event order");
+	filter_expected_val++;
+
+	/* Consumed events must not be passed to further listeners. */
+	return (event->val % 4) == TEST_BATCH_CONSUMED_MOD;
+}
+
+/* Consume some of the events before they reach the batch-aware listener. */
+APP_EVENT_LISTENER(test_batch_filter, app_event_handler_filter);
+APP_EVENT_SUBSCRIBE_FIRST(test_batch_filter, batch_event);
+
+
+static void check_batch_event(const struct app_event_header *aeh)
+{
+	struct batch_event *event = cast_batch_event(aeh);
+
+	zassert_not_null(event, "Event unhandled");
+	zassert_equal(event->val, batch_expected_val, "Incorrect event order");
+
+	batch_expected_val = next_not_consumed(batch_expected_val);
+}
+
+static bool app_event_handler_batch_single(const struct app_event_header *aeh)
+{
+	zassert_false(IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH),
+		      "Batch-aware listener notified about a single event");
+
+	check_batch_event(aeh);
+
+	return false;
+}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH)
+static void app_event_handler_batch(const struct app_event_header *const *aehs, size_t cnt)
+{
+	zassert_true(cnt > 0, "Empty batch");
+	zassert_true(cnt <= CONFIG_APP_EVENT_MANAGER_BATCH_SIZE, "Batch too big");
+
+	/* All events of the batch have already been seen by the first listener. */
+	zassert_equal(filter_expected_val, TEST_BATCH_EVENT_CNT, "Batch not coalesced");
+
+	for (size_t i = 0; i < cnt; i++) {
+		check_batch_event(aehs[i]);
+	}
+
+	batch_call_cnt++;
+}
+#endif
+
+APP_EVENT_LISTENER_BATCH(test_batch, app_event_handler_batch_single, app_event_handler_batch);
+APP_EVENT_SUBSCRIBE_EARLY(test_batch, batch_event);
+
+
+static bool app_event_handler_single(const struct app_event_header *aeh)
+{
+	struct batch_event *event = cast_batch_event(aeh);
+
+	zassert_not_null(event, "Event unhandled");
+	zassert_equal(event->val, single_expected_val, "Incorrect event order");
+	zassert_true((event->val % 4) != TEST_BATCH_CONSUMED_MOD,
+		     "Consumed event propagated");
+
+	/* The batch-aware listener is notified about the event before. */
+	zassert_true(batch_expected_val > event->val, "Incorrect subscriber order");
+
+	single_expected_val = next_not_consumed(single_expected_val);
+
+	if (event->val == (TEST_BATCH_EVENT_CNT - 1)) {
+		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_BATCH_DISPATCH)) {
+			zassert_equal(batch_call_cnt, 1, "Events were not coalesced");
+		}
+
+		struct test_end_event *te = new_test_end_event();
+
+		zassert_not_null(te, "Failed to allocate event");
+		te->test_id = TEST_BATCH;
+		APP_EVENT_SUBMIT(te);
+	}
+
+	return false;
+}
+
+APP_EVENT_LISTENER(test_batch_single, app_event_handler_single);
+APP_EVENT_SUBSCRIBE(test_batch_single, batch_event);
@@ -23,6 +23,15 @@ extern "C" {
 
 #define TEST_EVENT_ORDER_CNT 20
 
+#define TEST_BATCH_EVENT_CNT 10
+#define TEST_BATCH_POOL_SIZE 4
+
+/* Every event with this remainder of val divided by 4 is consumed. */
+#define TEST_BATCH_CONSUMED_MOD 3
+
+#define TEST_QUEUES_LOW_CNT 10
+#define TEST_QUEUES_LOW_PROCESSING_US 1000
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_events.h"
+#include "priority_events.h"
+
+#include "test_config.h"
+
+#define MODULE test_queues
+
+static atomic_t low_cnt;
+static atomic_t processed_cnt;
+
+static void processed(void)
+{
+	/* The events are processed in different threads, the last one ends the test. */
+	if (atomic_inc(&processed_cnt) == TEST_QUEUES_LOW_CNT) {
+		struct test_end_event *te = new_test_end_event();
+
+		zassert_not_null(te, "Failed to allocate event");
+		te->test_id = TEST_QUEUES;
+		APP_EVENT_SUBMIT(te);
+	}
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_test_start_event(aeh)) {
+		struct test_start_event *st = cast_test_start_event(aeh);
+
+		if (st->test_id != TEST_QUEUES) {
+			return false;
+		}
+
+		atomic_clear(&low_cnt);
+		atomic_clear(&processed_cnt);
+
+		/* Flood the default queue before submitting the high priority event. */
+		for (size_t i = 0; i < TEST_QUEUES_LOW_CNT; i++) {
+			struct low_prio_event *event = new_low_prio_event();
+
+			zassert_not_null(event, "Failed to allocate event");
+			event->val = i;
+			APP_EVENT_SUBMIT(event);
+		}
+
+		struct high_prio_event *event = new_high_prio_event();
+
+		zassert_not_null(event, "Failed to allocate event");
+		APP_EVENT_SUBMIT(event);
+
+		return false;
+	}
+
+	if (is_low_prio_event(aeh)) {
+		struct low_prio_event *event = cast_low_prio_event(aeh);
+
+		zassert_equal(event->val, atomic_get(&low_cnt), "Incorrect event order");
+
+		/* Simulate a slow listener. */
+		k_busy_wait(TEST_QUEUES_LOW_PROCESSING_US);
+		atomic_inc(&low_cnt);
+		processed();
+
+		return false;
+	}
+
+	if (is_high_prio_event(aeh)) {
+		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_QUEUES)) {
+			zassert_true(atomic_get(&low_cnt) < TEST_QUEUES_LOW_CNT,
+				     "High priority event delayed by the low priority events");
+		} else {
+			zassert_equal(atomic_get(&low_cnt), TEST_QUEUES_LOW_CNT,
+				      "Incorrect event order");
+		}
+
+		processed();
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+APP_EVENT_LISTENER(MODULE, app_event_handler);
+APP_EVENT_SUBSCRIBE(MODULE, test_start_event);
+APP_EVENT_SUBSCRIBE(MODULE, low_prio_event);
+APP_EVENT_SUBSCRIBE(MODULE, high_prio_event);
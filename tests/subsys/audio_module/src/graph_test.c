@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+#include <errno.h>
+#include "audio_module/audio_module.h"
+
+#include "audio_module_test_fakes.h"
+#include "audio_module_test_common.h"
+
+#define TEST_DATA_LEN_US (10000)
+
+struct graph_context {
+	/* Must be first, it is used by the common configuration functions. */
+	struct mod_context mod;
+
+	int calls;
+	int busy;
+	int busy_max;
+	const void *data_rx;
+	const void *data_tx;
+	uint32_t slab_used;
+};
+
+K_THREAD_STACK_DEFINE(graph_stack, TEST_MOD_THREAD_STACK_SIZE);
+K_THREAD_STACK_DEFINE(sender_stack, TEST_MOD_THREAD_STACK_SIZE);
+K_MEM_SLAB_DEFINE(graph_slab, TEST_MOD_DATA_SIZE, FAKE_FIFO_MSG_QUEUE_SIZE, 4);
+
+static struct mod_config mod_config = {
+	.test_int1 = 5, .test_int2 = 4, .test_int3 = 3, .test_int4 = 2};
+static struct graph_context ctx_gain1, ctx_gain2, ctx_sink;
+static struct audio_module_handle gain1, gain2, sink;
+static uint8_t sink_data[TEST_MOD_DATA_SIZE];
+static int response_count;
+
+/* Add one to every byte, and record the buffers used. */
+static int graph_add_one_process(struct audio_module_handle_private *handle,
+				 struct audio_data const *const audio_data_rx,
+				 struct audio_data *audio_data_tx)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct graph_context *ctx = (struct graph_context *)hdl->context;
+	const uint8_t *in = audio_data_rx->data;
+	uint8_t *out = audio_data_tx->data;
+
+	ctx->calls++;
+	ctx->data_rx = audio_data_rx->data;
+	ctx->data_tx = audio_data_tx->data;
+
+	for (size_t i = 0; i < audio_data_rx->data_size; i++) {
+		out[i] = in[i] + 1;
+	}
+
+	audio_data_tx->data_size = audio_data_rx->data_size;
+	memcpy(&audio_data_tx->meta, &audio_data_rx->meta, sizeof(struct audio_metadata));
+
+	return 0;
+}
+
+/* Keep a copy of the audio data, and the number of buffers in use in the first module's slab. */
+static int graph_sink_process(struct audio_module_handle_private *handle,
+			      struct audio_data const *const audio_data_rx,
+			      struct audio_data *audio_data_tx)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct graph_context *ctx = (struct graph_context *)hdl->context;
+
+	ARG_UNUSED(audio_data_tx);
+
+	ctx->calls++;
+	ctx->data_rx = audio_data_rx->data;
+	ctx->slab_used = k_mem_slab_num_used_get(&graph_slab);
+
+	memcpy(sink_data, audio_data_rx->data, audio_data_rx->data_size);
+
+	return 0;
+}
+
+/* Count the callers inside the function, and give another sender the chance to enter it. */
+static int graph_slow_sink_process(struct audio_module_handle_private *handle,
+				   struct audio_data const *const audio_data_rx,
+				   struct audio_data *audio_data_tx)
+{
+	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
+	struct graph_context *ctx = (struct graph_context *)hdl->context;
+
+	ARG_UNUSED(audio_data_rx);
+	ARG_UNUSED(audio_data_tx);
+
+	ctx->busy++;
+	ctx->busy_max = MAX(ctx->busy_max, ctx->busy);
+
+	k_sleep(K_MSEC(5));
+
+	ctx->calls++;
+	ctx->busy--;
+
+	return 0;
+}
+
+static void test_response_cb(struct audio_module_handle_private *handle,
+			     struct audio_data const *const audio_data)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(audio_data);
+
+	response_count++;
+}
+
+static const struct audio_module_functions ft_add_one = {
+	.configuration_set = test_config_set_function,
+	.configuration_get = test_config_get_function,
+	.data_process = graph_add_one_process};
+static const struct audio_module_functions ft_sink = {
+	.configuration_set = test_config_set_function,
+	.configuration_get = test_config_get_function,
+	.data_process = graph_sink_process};
+static const struct audio_module_functions ft_slow_sink = {
+	.configuration_set = test_config_set_function,
+	.configuration_get = test_config_get_function,
+	.data_process = graph_slow_sink_process};
+static struct audio_module_description add_one_description = {
+	.name = "Add one", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &ft_add_one};
+static struct audio_module_description sink_description = {
+	.name = "Sink", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &ft_sink};
+static struct audio_module_description slow_sink_description = {
+	.name = "Slow sink", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &ft_slow_sink};
+
+/**
+ * @brief Open the modules add one -> add one -> sink and start them.
+ *
+ * @param fifo_rx  [in]  RX data FIFO for the sink, or NULL to run the sink without a thread.
+ */
+static void graph_open(struct data_fifo *fifo_rx)
+{
+	int ret;
+	struct audio_module_parameters params;
+
+	memset(&ctx_gain1, 0, sizeof(ctx_gain1));
+	memset(&ctx_gain2, 0, sizeof(ctx_gain2));
+	memset(&ctx_sink, 0, sizeof(ctx_sink));
+	memset(sink_data, 0, sizeof(sink_data));
+	response_count = 0;
+
+	/* The first module takes its buffers from its own slab, the second from the graph pool */
+	AUDIO_MODULE_PARAMETERS(params, &add_one_description, NULL, 0, TEST_MOD_THREAD_PRIORITY,
+				NULL, NULL, &graph_slab, TEST_MOD_DATA_SIZE);
+	params.thread.execution = AUDIO_MODULE_EXECUTION_INLINE;
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Gain 1", (struct audio_module_context *)&ctx_gain1, &gain1);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+
+	AUDIO_MODULE_PARAMETERS(params, &add_one_description, NULL, 0, TEST_MOD_THREAD_PRIORITY,
+				NULL, NULL, NULL, TEST_MOD_DATA_SIZE);
+	params.thread.execution = AUDIO_MODULE_EXECUTION_INLINE;
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Gain 2", (struct audio_module_context *)&ctx_gain2, &gain2);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+
+	if (fifo_rx == NULL) {
+		AUDIO_MODULE_PARAMETERS(params, &sink_description, NULL, 0,
+					TEST_MOD_THREAD_PRIORITY, NULL, NULL, NULL, 0);
+		params.thread.execution = AUDIO_MODULE_EXECUTION_INLINE;
+	} else {
+		AUDIO_MODULE_PARAMETERS(params, &sink_description, graph_stack,
+					TEST_MOD_THREAD_STACK_SIZE, TEST_MOD_THREAD_PRIORITY,
+					fifo_rx, NULL, NULL, 0);
+	}
+
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config, "Sink",
+				(struct audio_module_context *)&ctx_sink, &sink);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+
+	ret = audio_module_connect(&gain1, &gain2, false);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+
+	ret = audio_module_connect(&gain2, &sink, false);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+
+	zassert_equal(audio_module_start(&gain1), 0, "Failed to start module");
+	zassert_equal(audio_module_start(&gain2), 0, "Failed to start module");
+	zassert_equal(audio_module_start(&sink), 0, "Failed to start module");
+}
+
+static void graph_close(void)
+{
+	struct audio_module_handle *handles[] = {&gain1, &gain2, &sink};
+
+	for (int i = 0; i < ARRAY_SIZE(handles); i++) {
+		zassert_equal(audio_module_stop(handles[i]), 0, "Failed to stop module");
+		zassert_equal(audio_module_close(handles[i]), 0, "Failed to close module");
+	}
+}
+
+static void graph_data_tx(uint8_t *test_data)
+{
+	int ret;
+	struct audio_data audio_data = {0};
+
+	for (int i = 0; i < TEST_MOD_DATA_SIZE; i++) {
+		test_data[i] = i;
+	}
+
+	audio_data.data = test_data;
+	audio_data.data_size = TEST_MOD_DATA_SIZE;
+	audio_data.meta.data_len_us = TEST_DATA_LEN_US;
+
+	ret = audio_module_data_tx(&gain1, &audio_data, test_response_cb);
+	zassert_equal(ret, 0, "Data TX function did not return successfully: ret %d", ret);
+}
+
+static void graph_sender_thread(void *test_data, void *dummy2, void *dummy3)
+{
+	int ret;
+	struct audio_data audio_data = {0};
+
+	ARG_UNUSED(dummy2);
+	ARG_UNUSED(dummy3);
+
+	audio_data.data = test_data;
+	audio_data.data_size = TEST_MOD_DATA_SIZE;
+	audio_data.meta.data_len_us = TEST_DATA_LEN_US;
+
+	ret = audio_module_data_tx(&gain2, &audio_data, test_response_cb);
+	zassert_equal(ret, 0, "Data TX function did not return successfully: ret %d", ret);
+}
+
+ZTEST(suite_audio_module_graph, test_graph_chain_one_thread)
+{
+	uint8_t test_data[TEST_MOD_DATA_SIZE];
+	struct audio_module_cycles cycles;
+
+	graph_open(NULL);
+
+	/* The whole chain runs in this thread before the call returns */
+	graph_data_tx(test_data);
+
+	zassert_equal(response_count, 1, "Input released %d times", response_count);
+	zassert_equal(ctx_gain1.calls, 1, "First module called %d times", ctx_gain1.calls);
+	zassert_equal(ctx_gain2.calls, 1, "Second module called %d times", ctx_gain2.calls);
+	zassert_equal(ctx_sink.calls, 1, "Sink called %d times", ctx_sink.calls);
+
+	/* The buffers are passed on by reference */
+	zassert_equal_ptr(ctx_gain1.data_rx, test_data, "Input data copied");
+	zassert_equal_ptr(ctx_gain2.data_rx, ctx_gain1.data_tx, "First module output copied");
+	zassert_equal_ptr(ctx_sink.data_rx, ctx_gain2.data_tx, "Second module output copied");
+
+	for (int i = 0; i < TEST_MOD_DATA_SIZE; i++) {
+		zassert_equal(sink_data[i], test_data[i] + 2, "Sink data differs at %d", i);
+	}
+
+	/* The output of the first module is released once the second module has processed it */
+	zassert_equal(ctx_sink.slab_used, 0, "%d buffers of the first module still in use",
+		      ctx_sink.slab_used);
+	zassert_equal(k_mem_slab_num_used_get(&graph_slab), 0, "Buffers not released");
+
+	zassert_equal(audio_module_cycles_get(&gain1, &cycles), 0, "Failed to get cycles");
+	zassert_equal(cycles.count, 1, "Cycles counted for %d items", cycles.count);
+	zassert_equal(cycles.budget, k_us_to_cyc_ceil32(TEST_DATA_LEN_US), "Wrong budget %d",
+		      cycles.budget);
+	zassert_equal(cycles.max, cycles.last, "Wrong maximum cycles");
+	zassert_equal(cycles.total, cycles.last, "Wrong total cycles");
+
+	graph_close();
+}
+
+ZTEST(suite_audio_module_graph, test_graph_thread_boundary)
+{
+	uint8_t test_data[TEST_MOD_DATA_SIZE];
+	struct data_fifo fifo_rx = {0};
+
+	fake_fifo_counter_reset();
+
+	data_fifo_init_fake.custom_fake = fake_data_fifo_init__succeeds;
+	data_fifo_uninit_fake.custom_fake = fake_data_fifo_uninit__succeeds;
+	data_fifo_state_fake.custom_fake = fake_data_fifo_state__succeeds;
+	data_fifo_pointer_first_vacant_get_fake.custom_fake =
+		fake_data_fifo_pointer_first_vacant_get__succeeds;
+	data_fifo_block_lock_fake.custom_fake = fake_data_fifo_block_lock__succeeds;
+	data_fifo_pointer_last_filled_get_fake.custom_fake =
+		fake_data_fifo_pointer_last_filled_get__succeeds;
+	data_fifo_block_free_fake.custom_fake = fake_data_fifo_block_free__succeeds;
+
+	/* The sink has a thread of its own, so only its connection goes through a FIFO */
+	graph_open(&fifo_rx);
+
+	graph_data_tx(test_data);
+
+	zassert_equal(response_count, 1, "Input released %d times", response_count);
+	zassert_equal(ctx_gain2.calls, 1, "Second module called %d times", ctx_gain2.calls);
+	zassert_equal(data_fifo_block_lock_fake.call_count, 1, "Data FIFO send called %d times",
+		      data_fifo_block_lock_fake.call_count);
+
+	/* Let the sink thread consume the audio data */
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(ctx_sink.calls, 1, "Sink called %d times", ctx_sink.calls);
+	zassert_equal_ptr(ctx_sink.data_rx, ctx_gain2.data_tx, "Second module output copied");
+
+	for (int i = 0; i < TEST_MOD_DATA_SIZE; i++) {
+		zassert_equal(sink_data[i], test_data[i] + 2, "Sink data differs at %d", i);
+	}
+
+	zassert_equal(k_mem_slab_num_used_get(&graph_slab), 0, "Buffers not released");
+
+	graph_close();
+}
+
+ZTEST(suite_audio_module_graph, test_graph_fan_in_serialised)
+{
+	int ret;
+	uint8_t test_data1[TEST_MOD_DATA_SIZE];
+	uint8_t test_data2[TEST_MOD_DATA_SIZE] = {0};
+	struct audio_module_parameters params;
+	struct k_thread sender;
+
+	memset(&ctx_gain1, 0, sizeof(ctx_gain1));
+	memset(&ctx_gain2, 0, sizeof(ctx_gain2));
+	memset(&ctx_sink, 0, sizeof(ctx_sink));
+	response_count = 0;
+
+	/* Two modules, fed from different threads, run the sink in their own thread */
+	AUDIO_MODULE_PARAMETERS(params, &add_one_description, NULL, 0, TEST_MOD_THREAD_PRIORITY,
+				NULL, NULL, &graph_slab, TEST_MOD_DATA_SIZE);
+	params.thread.execution = AUDIO_MODULE_EXECUTION_INLINE;
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Gain 1", (struct audio_module_context *)&ctx_gain1, &gain1);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Gain 2", (struct audio_module_context *)&ctx_gain2, &gain2);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+
+	AUDIO_MODULE_PARAMETERS(params, &slow_sink_description, NULL, 0, TEST_MOD_THREAD_PRIORITY,
+				NULL, NULL, NULL, 0);
+	params.thread.execution = AUDIO_MODULE_EXECUTION_INLINE;
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config, "Sink",
+				(struct audio_module_context *)&ctx_sink, &sink);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+
+	ret = audio_module_connect(&gain1, &sink, false);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+
+	ret = audio_module_connect(&gain2, &sink, false);
+	zassert_equal(ret, 0, "Connect function did not return successfully: ret %d", ret);
+
+	zassert_equal(audio_module_start(&gain1), 0, "Failed to start module");
+	zassert_equal(audio_module_start(&gain2), 0, "Failed to start module");
+	zassert_equal(audio_module_start(&sink), 0, "Failed to start module");
+
+	/* The sender enters the sink while this thread sleeps in it */
+	k_thread_create(&sender, sender_stack, K_THREAD_STACK_SIZEOF(sender_stack),
+			graph_sender_thread, test_data2, NULL, NULL,
+			K_PRIO_PREEMPT(TEST_MOD_THREAD_PRIORITY), 0, K_NO_WAIT);
+
+	graph_data_tx(test_data1);
+
+	ret = k_thread_join(&sender, K_MSEC(100));
+	zassert_equal(ret, 0, "Sender thread did not finish: ret %d", ret);
+
+	zassert_equal(response_count, 2, "Input released %d times", response_count);
+	zassert_equal(ctx_sink.calls, 2, "Sink called %d times", ctx_sink.calls);
+	zassert_equal(ctx_sink.busy_max, 1, "Sink entered by %d threads at once",
+		      ctx_sink.busy_max);
+	zassert_equal(k_mem_slab_num_used_get(&graph_slab), 0, "Buffers not released");
+
+	graph_close();
+}
+
+ZTEST(suite_audio_module_graph, test_graph_open_no_thread)
+{
+	int ret;
+	struct audio_module_parameters params;
+	struct graph_context ctx;
+	struct audio_module_handle handle = {0};
+	struct audio_module_description input_description = {
+		.name = "Input", .type = AUDIO_MODULE_TYPE_INPUT, .functions = &ft_add_one};
+
+	/* An input module generates its own data, so it must have a thread */
+	AUDIO_MODULE_PARAMETERS(params, &input_description, NULL, 0, TEST_MOD_THREAD_PRIORITY,
+				NULL, NULL, &graph_slab, TEST_MOD_DATA_SIZE);
+	params.thread.execution = AUDIO_MODULE_EXECUTION_INLINE;
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Input", (struct audio_module_context *)&ctx, &handle);
+	zassert_equal(ret, -ECANCELED, "Open function did not return -ECANCELED (%d): ret %d",
+		      -ECANCELED, ret);
+
+	/* The buffers from the graph pool are too small */
+	AUDIO_MODULE_PARAMETERS(params, &add_one_description, NULL, 0, TEST_MOD_THREAD_PRIORITY,
+				NULL, NULL, NULL, CONFIG_AUDIO_MODULE_GRAPH_POOL_BLOCK_SIZE + 1);
+	params.thread.execution = AUDIO_MODULE_EXECUTION_INLINE;
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Gain", (struct audio_module_context *)&ctx, &handle);
+	zassert_equal(ret, -ECANCELED, "Open function did not return -ECANCELED (%d): ret %d",
+		      -ECANCELED, ret);
+
+	/* A module without a stack only runs inline when asked to */
+	AUDIO_MODULE_PARAMETERS(params, &add_one_description, NULL, 0, TEST_MOD_THREAD_PRIORITY,
+				NULL, NULL, NULL, TEST_MOD_DATA_SIZE);
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Gain", (struct audio_module_context *)&ctx, &handle);
+	zassert_equal(ret, -ECANCELED, "Open function did not return -ECANCELED (%d): ret %d",
+		      -ECANCELED, ret);
+
+	/* An inline module does not take a stack */
+	AUDIO_MODULE_PARAMETERS(params, &add_one_description, graph_stack,
+				TEST_MOD_THREAD_STACK_SIZE, TEST_MOD_THREAD_PRIORITY, NULL, NULL,
+				NULL, TEST_MOD_DATA_SIZE);
+	params.thread.execution = AUDIO_MODULE_EXECUTION_INLINE;
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Gain", (struct audio_module_context *)&ctx, &handle);
+	zassert_equal(ret, -ECANCELED, "Open function did not return -ECANCELED (%d): ret %d",
+		      -ECANCELED, ret);
+
+	/* A stack without a size is still invalid */
+	AUDIO_MODULE_PARAMETERS(params, &add_one_description, graph_stack, 0,
+				TEST_MOD_THREAD_PRIORITY, NULL, NULL, NULL, TEST_MOD_DATA_SIZE);
+	ret = audio_module_open(&params, (struct audio_module_configuration *)&mod_config,
+				"Gain", (struct audio_module_context *)&ctx, &handle);
+	zassert_equal(ret, -ECANCELED, "Open function did not return -ECANCELED (%d): ret %d",
+		      -ECANCELED, ret);
+}
+
+ZTEST(suite_audio_module_graph, test_graph_cycles_get_null)
+{
+	int ret;
+	struct audio_module_cycles cycles;
+	struct audio_module_handle handle = {0};
+
+	ret = audio_module_cycles_get(NULL, &cycles);
+	zassert_equal(ret, -EINVAL, "Cycles get function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	ret = audio_module_cycles_get(&gain1, NULL);
+	zassert_equal(ret, -EINVAL, "Cycles get function did not return -EINVAL (%d): ret %d",
+		      -EINVAL, ret);
+
+	ret = audio_module_cycles_get(&handle, &cycles);
+	zassert_equal(ret, -ECANCELED, "Cycles get function did not return -ECANCELED (%d): ret %d",
+		      -ECANCELED, ret);
+}
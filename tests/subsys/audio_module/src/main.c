@@ -23,3 +23,7 @@ static void run_before(void *fixture)
 
 ZTEST_SUITE(suite_audio_module_bad_param, NULL, NULL, run_before, NULL, NULL);
 ZTEST_SUITE(suite_audio_module_functional, NULL, NULL, run_before, NULL, NULL);
+
+#ifdef CONFIG_AUDIO_MODULE_GRAPH
+ZTEST_SUITE(suite_audio_module_graph, NULL, NULL, run_before, NULL, NULL);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/scan.h>
+
+#include <test_benchmark.h>
+
+#include "../src/scan_test.h"
+
+#define NUM_ITERATIONS 1000
+
+static int match_cnt;
+static int no_match_cnt;
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	match_cnt++;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	no_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_benchmark_cb, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+/* An AD field of an advertising report. */
+struct adv_field {
+	uint8_t type;
+	uint8_t len;
+	const uint8_t *data;
+};
+
+#define ADV_FIELD(_type, ...)                                                                      \
+	{                                                                                          \
+		.type = (_type),                                                                   \
+		.len = sizeof((const uint8_t[]){__VA_ARGS__}),                                     \
+		.data = (const uint8_t[]){__VA_ARGS__},                                            \
+	}
+
+/* Advertising reports of common device types. None of them match the filters,
+ * so every filter is checked.
+ */
+static const struct adv_field report_beacon[] = {
+	ADV_FIELD(BT_DATA_FLAGS, BT_LE_AD_NO_BREDR),
+	ADV_FIELD(BT_DATA_MANUFACTURER_DATA, 0x4C, 0x00, 0x02, 0x15, 0xE2, 0xC5, 0x6D, 0xB5, 0xDF,
+		  0xFB, 0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0, 0x00, 0x01,
+		  0x00, 0x02, 0xC5),
+};
+
+static const struct adv_field report_eddystone[] = {
+	ADV_FIELD(BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR),
+	ADV_FIELD(BT_DATA_UUID16_ALL, BT_UUID_16_ENCODE(0xFEAA)),
+	ADV_FIELD(BT_DATA_SVC_DATA16, BT_UUID_16_ENCODE(0xFEAA), 0x10, 0x00, 0x03, 'n', 'o', 'r',
+		  'd', 'i', 'c', 's', 'e', 'm', 'i', 0x07),
+};
+
+static const struct adv_field report_keyboard[] = {
+	ADV_FIELD(BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR),
+	ADV_FIELD(BT_DATA_GAP_APPEARANCE, BT_BYTES_LIST_LE16(BT_APPEARANCE_HID_KEYBOARD)),
+	ADV_FIELD(BT_DATA_UUID16_ALL, BT_UUID_16_ENCODE(BT_UUID_HIDS_VAL),
+		  BT_UUID_16_ENCODE(BT_UUID_BAS_VAL)),
+	ADV_FIELD(BT_DATA_NAME_COMPLETE, 'K', 'e', 'y', 'b', 'o', 'a', 'r', 'd', ' ', 'K', '3'),
+};
+
+static const struct adv_field report_tracker[] = {
+	ADV_FIELD(BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR),
+	ADV_FIELD(BT_DATA_UUID128_ALL, BT_UUID_128_ENCODE(0xADAF0001, 0xC332, 0x42A8, 0x93BD,
+							  0x25E905756CB8)),
+	ADV_FIELD(BT_DATA_NAME_SHORTENED, 'F', 'i', 't', 'B', 'a', 'n', 'd'),
+	ADV_FIELD(BT_DATA_MANUFACTURER_DATA, 0x0F, 0x00, 0x01, 0x22, 0x5A, 0x11, 0x80),
+};
+
+static const struct adv_field report_thermometer[] = {
+	ADV_FIELD(BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR),
+	ADV_FIELD(BT_DATA_UUID16_SOME, BT_UUID_16_ENCODE(BT_UUID_HTS_VAL),
+		  BT_UUID_16_ENCODE(BT_UUID_DIS_VAL), BT_UUID_16_ENCODE(BT_UUID_BAS_VAL)),
+	ADV_FIELD(BT_DATA_NAME_COMPLETE, 'T', 'e', 'm', 'p', 'S', 'e', 'n', 's', 'o', 'r', ' ',
+		  'L', 'i', 'v', 'i', 'n', 'g', ' ', 'R', 'o', 'o', 'm'),
+};
+
+static const struct {
+	const char *name;
+	const struct adv_field *fields;
+	size_t cnt;
+} reports[] = {
+	{"beacon", report_beacon, ARRAY_SIZE(report_beacon)},
+	{"eddystone", report_eddystone, ARRAY_SIZE(report_eddystone)},
+	{"keyboard", report_keyboard, ARRAY_SIZE(report_keyboard)},
+	{"tracker", report_tracker, ARRAY_SIZE(report_tracker)},
+	{"thermometer", report_thermometer, ARRAY_SIZE(report_thermometer)},
+};
+
+static const bt_addr_le_t report_addr = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = {0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xE6},
+};
+
+/* Fill all name, UUID and manufacturer data filters, with names sharing a prefix with the
+ * names of the reports.
+ */
+static void filters_fill(void)
+{
+	char name[CONFIG_BT_SCAN_NAME_MAX_LEN];
+	struct bt_uuid_16 uuid = BT_UUID_INIT_16(0);
+	uint8_t md[CONFIG_BT_SCAN_MANUFACTURER_DATA_CNT][3];
+
+	for (int i = 0; i < CONFIG_BT_SCAN_NAME_CNT; i++) {
+		snprintf(name, sizeof(name), "TempSensor %02d", i);
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, name));
+	}
+
+	for (int i = 0; i < CONFIG_BT_SCAN_UUID_CNT; i++) {
+		uuid.val = 0xFD00 + i;
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &uuid));
+	}
+
+	for (int i = 0; i < CONFIG_BT_SCAN_MANUFACTURER_DATA_CNT; i++) {
+		struct bt_scan_manufacturer_data filter = {
+			.data = md[i],
+			.data_len = sizeof(md[i]),
+		};
+
+		md[i][0] = 0x59;
+		md[i][1] = 0x00;
+		md[i][2] = i;
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA, &filter));
+	}
+
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER | BT_SCAN_UUID_FILTER |
+					 BT_SCAN_MANUFACTURER_DATA_FILTER, false));
+}
+
+static void run(const char *name, const struct adv_field *fields, size_t cnt)
+{
+	/* Some of the reports are longer than legacy advertising data */
+	NET_BUF_SIMPLE_DEFINE_STATIC(buf, BT_GAP_ADV_MAX_EXT_ADV_DATA_LEN);
+	const char *mode = IS_ENABLED(CONFIG_BT_SCAN_FILTER_INDEX) ? "indexed" : "linear";
+	char bench_name[48];
+	struct test_benchmark bench;
+
+	net_buf_simple_reset(&buf);
+
+	for (size_t i = 0; i < cnt; i++) {
+		scan_test_adv_add(&buf, fields[i].type, fields[i].data, fields[i].len);
+	}
+
+	snprintf(bench_name, sizeof(bench_name), "bt_scan %s %s, %u B", mode, name, buf.len);
+
+	match_cnt = 0;
+	no_match_cnt = 0;
+
+	test_benchmark_start(&bench, bench_name, NUM_ITERATIONS);
+
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		scan_test_report(&report_addr, &buf);
+	}
+
+	test_benchmark_stop(&bench);
+
+	/* Every report must have been checked against all filters without a match */
+	zassert_equal(0, match_cnt, "%s should not match any filter", name);
+	zassert_equal(NUM_ITERATIONS, no_match_cnt, "%s should be reported as not matching",
+		      name);
+}
+
+ZTEST(bt_scan_benchmark, test_filter_match)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_GAP_ADV_MAX_LEGACY_ADV_DATA_LEN);
+	static const char match_name[] = "TempSensor 05";
+
+	filters_fill();
+
+	for (size_t i = 0; i < ARRAY_SIZE(reports); i++) {
+		run(reports[i].name, reports[i].fields, reports[i].cnt);
+	}
+
+	/* The filters are active, a report with a filtered name matches */
+	match_cnt = 0;
+	scan_test_adv_add(&buf, BT_DATA_NAME_COMPLETE, match_name, strlen(match_name));
+	scan_test_report(&report_addr, &buf);
+	zassert_equal(1, match_cnt, "A report with a filtered name should match");
+}
+
+static void *setup(void)
+{
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_benchmark_cb);
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	bt_scan_filter_remove_all();
+	bt_scan_filter_disable();
+}
+
+ZTEST_SUITE(bt_scan_benchmark, NULL, setup, NULL, NULL, teardown);
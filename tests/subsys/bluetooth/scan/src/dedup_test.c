@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <bluetooth/scan.h>
+
+#include "scan_test.h"
+
+/* Number of filter match and no match events */
+static int event_cnt;
+
+static void dedup_filter_match(struct bt_scan_device_info *device_info,
+			       struct bt_scan_filter_match *filter_match,
+			       bool connectable)
+{
+	event_cnt++;
+}
+
+static void dedup_filter_no_match(struct bt_scan_device_info *device_info,
+				  bool connectable)
+{
+	event_cnt++;
+}
+
+BT_SCAN_CB_INIT(dedup_test_cb, dedup_filter_match, dedup_filter_no_match, NULL, NULL);
+
+static bt_addr_le_t test_addr(uint8_t n)
+{
+	bt_addr_le_t addr = {
+		.type = BT_ADDR_LE_RANDOM,
+		.a.val = {n, 0x02, 0x03, 0x04, 0x05, 0xC6},
+	};
+
+	return addr;
+}
+
+/* Send a report with a complete name, and return the number of events it caused. */
+static int report(uint8_t n, const char *name, int8_t rssi, uint16_t adv_props)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_GAP_ADV_MAX_ADV_DATA_LEN);
+	bt_addr_le_t addr = test_addr(n);
+	struct bt_le_scan_recv_info info = {
+		.addr = &addr,
+		.rssi = rssi,
+		.adv_props = adv_props,
+	};
+	int cnt = event_cnt;
+
+	scan_test_adv_add(&buf, BT_DATA_NAME_COMPLETE, name, strlen(name));
+	scan_test_report_info(&info, &buf);
+
+	return event_cnt - cnt;
+}
+
+ZTEST(bt_scan_dedup, test_repeated_report_suppressed)
+{
+	zassert_equal(report(1, "Sensor", -50, 0), 1);
+	zassert_equal(report(1, "Sensor", -50, 0), 0);
+	zassert_equal(report(1, "Sensor", -51, 0), 0);
+
+	/* Changed advertising data is delivered, also when it changes back */
+	zassert_equal(report(1, "Sensor 2", -50, 0), 1);
+	zassert_equal(report(1, "Sensor", -50, 0), 1);
+
+	/* The address is part of the key */
+	zassert_equal(report(2, "Sensor", -50, 0), 1);
+}
+
+ZTEST(bt_scan_dedup, test_scan_response_tracked_separately)
+{
+	zassert_equal(report(1, "Sensor", -50, BT_GAP_ADV_PROP_SCANNABLE), 1);
+	zassert_equal(report(1, "Sensor", -50, BT_GAP_ADV_PROP_SCAN_RESPONSE), 1);
+	zassert_equal(report(1, "Sensor", -50, BT_GAP_ADV_PROP_SCANNABLE), 0);
+	zassert_equal(report(1, "Sensor", -50, BT_GAP_ADV_PROP_SCAN_RESPONSE), 0);
+}
+
+ZTEST(bt_scan_dedup, test_repeat_interval)
+{
+	zassert_equal(report(1, "Sensor", -50, 0), 1);
+
+	k_sleep(K_MSEC(CONFIG_BT_SCAN_DEDUP_INTERVAL_MS / 2));
+	zassert_equal(report(1, "Sensor", -50, 0), 0);
+
+	k_sleep(K_MSEC(CONFIG_BT_SCAN_DEDUP_INTERVAL_MS / 2));
+	zassert_equal(report(1, "Sensor", -50, 0), 1);
+	zassert_equal(report(1, "Sensor", -50, 0), 0);
+}
+
+ZTEST(bt_scan_dedup, test_lru_replacement)
+{
+	/* Fill the cache */
+	for (uint8_t n = 1; n <= CONFIG_BT_SCAN_DEDUP_CACHE_SIZE; n++) {
+		zassert_equal(report(n, "Sensor", -50, 0), 1);
+	}
+
+	/* Advertiser 1 is seen again, so advertiser 2 is the least recently seen one */
+	zassert_equal(report(1, "Sensor", -50, 0), 0);
+	zassert_equal(report(CONFIG_BT_SCAN_DEDUP_CACHE_SIZE + 1, "Sensor", -50, 0), 1);
+
+	zassert_equal(report(1, "Sensor", -50, 0), 0);
+	zassert_equal(report(2, "Sensor", -50, 0), 1);
+}
+
+ZTEST(bt_scan_dedup, test_rssi)
+{
+	bt_addr_le_t addr = test_addr(1);
+	struct bt_scan_rssi rssi;
+
+	zassert_equal(bt_scan_dedup_rssi_get(&addr, &rssi), -ENOENT);
+	zassert_equal(bt_scan_dedup_rssi_get(NULL, &rssi), -EINVAL);
+	zassert_equal(bt_scan_dedup_rssi_get(&addr, NULL), -EINVAL);
+
+	(void)report(1, "Sensor", -40, 0);
+	(void)report(1, "Sensor", -70, 0);
+	(void)report(1, "Sensor", -55, 0);
+
+	zassert_ok(bt_scan_dedup_rssi_get(&addr, &rssi));
+	zassert_equal(rssi.count, 3);
+	zassert_equal(rssi.last, -55);
+	zassert_equal(rssi.min, -70);
+	zassert_equal(rssi.max, -40);
+	zassert_true(rssi.avg < -40 && rssi.avg > -70, "Average %d", rssi.avg);
+}
+
+ZTEST(bt_scan_dedup, test_clear)
+{
+	zassert_equal(report(1, "Sensor", -50, 0), 1);
+	zassert_equal(report(1, "Sensor", -50, 0), 0);
+
+	bt_scan_dedup_clear();
+	zassert_equal(report(1, "Sensor", -50, 0), 1);
+
+	/* Changing the filters clears the cache */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Sensor"));
+	zassert_equal(report(1, "Sensor", -50, 0), 1);
+}
+
+static void *dedup_setup(void)
+{
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&dedup_test_cb);
+
+	return NULL;
+}
+
+static void dedup_before(void *fixture)
+{
+	bt_scan_filter_remove_all();
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Thingy"));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER, false));
+
+	event_cnt = 0;
+}
+
+ZTEST_SUITE(bt_scan_dedup, NULL, dedup_setup, dedup_before, NULL, NULL);
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/scan.h>
+
+#include "scan_test.h"
+
+static struct bt_le_scan_cb *scan_cb;
+
+static int match_cnt;
+static int no_match_cnt;
+static struct bt_scan_filter_match match_status;
+
+/* The scan callback of the library, captured to feed it advertising reports. */
+int __wrap_bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	scan_cb = cb;
+
+	return 0;
+}
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	match_cnt++;
+	match_status = *filter_match;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	no_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_test_cb, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+static const bt_addr_le_t peer_addr = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = {0x01, 0x02, 0x03, 0x04, 0x05, 0xC6},
+};
+
+static const bt_addr_le_t other_addr = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = {0x11, 0x12, 0x13, 0x14, 0x15, 0xC6},
+};
+
+void scan_test_adv_add(struct net_buf_simple *buf, uint8_t type, const void *data, uint8_t len)
+{
+	net_buf_simple_add_u8(buf, len + 1);
+	net_buf_simple_add_u8(buf, type);
+	net_buf_simple_add_mem(buf, data, len);
+}
+
+void scan_test_report_info(const struct bt_le_scan_recv_info *info, struct net_buf_simple *buf)
+{
+	zassert_not_null(scan_cb);
+	scan_cb->recv(info, buf);
+}
+
+void scan_test_report(const bt_addr_le_t *addr, struct net_buf_simple *buf)
+{
+	struct bt_le_scan_recv_info info = {
+		.addr = addr,
+		.rssi = -60,
+		.adv_type = BT_GAP_ADV_TYPE_ADV_NONCONN_IND,
+	};
+
+	scan_test_report_info(&info, buf);
+}
+
+/* Send a report with a single AD field, and return true if the filters matched. */
+static bool report_one(uint8_t type, const void *data, uint8_t len)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_GAP_ADV_MAX_ADV_DATA_LEN);
+	int cnt = match_cnt;
+
+	scan_test_adv_add(&buf, type, data, len);
+	scan_test_report(&peer_addr, &buf);
+
+	return match_cnt > cnt;
+}
+
+static bool report_name(uint8_t type, const char *name)
+{
+	return report_one(type, name, strlen(name));
+}
+
+ZTEST(bt_scan, test_name_prefix)
+{
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Thingy52"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Thing"));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER, false));
+
+	zassert_true(report_name(BT_DATA_NAME_COMPLETE, "Thingy52"));
+	zassert_str_equal(match_status.name.name, "Thingy52");
+	zassert_equal(match_status.name.len, strlen("Thingy52"));
+
+	/* The advertised name is a prefix of both filters, the first one is reported */
+	zassert_true(report_name(BT_DATA_NAME_COMPLETE, "Thing"));
+	zassert_str_equal(match_status.name.name, "Thingy52");
+
+	zassert_false(report_name(BT_DATA_NAME_COMPLETE, "Thingy53"));
+	zassert_false(report_name(BT_DATA_NAME_COMPLETE, "Thingy52 XL"));
+	zassert_false(report_name(BT_DATA_NAME_SHORTENED, "Thingy52"));
+	zassert_equal(no_match_cnt, 3);
+}
+
+ZTEST(bt_scan, test_short_name_min_len)
+{
+	struct bt_scan_short_name short_name = {
+		.name = "Periph",
+		.min_len = 3,
+	};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_SHORT_NAME, &short_name));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_SHORT_NAME_FILTER, false));
+
+	zassert_false(report_name(BT_DATA_NAME_SHORTENED, "Pe"));
+	zassert_true(report_name(BT_DATA_NAME_SHORTENED, "Per"));
+	zassert_true(report_name(BT_DATA_NAME_SHORTENED, "Periph"));
+	zassert_false(report_name(BT_DATA_NAME_SHORTENED, "Pex"));
+	zassert_false(report_name(BT_DATA_NAME_COMPLETE, "Periph"));
+}
+
+ZTEST(bt_scan, test_addr)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_GAP_ADV_MAX_ADV_DATA_LEN);
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &peer_addr));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false));
+
+	scan_test_report(&other_addr, &buf);
+	zassert_equal(match_cnt, 0);
+
+	scan_test_report(&peer_addr, &buf);
+	zassert_equal(match_cnt, 1);
+	zassert_true(bt_addr_le_eq(match_status.addr.addr, &peer_addr));
+}
+
+ZTEST(bt_scan, test_uuid_any)
+{
+	const struct bt_uuid_16 hrs = BT_UUID_INIT_16(BT_UUID_HRS_VAL);
+	const struct bt_uuid_32 uuid_32 = BT_UUID_INIT_32(0x12345678);
+	const uint8_t hrs_list[] = {BT_UUID_16_ENCODE(BT_UUID_BAS_VAL),
+				    BT_UUID_16_ENCODE(BT_UUID_HRS_VAL)};
+	const uint8_t uuid_32_list[] = {BT_UUID_32_ENCODE(0x12345678)};
+	/* The Heart Rate Service UUID as a 128-bit UUID */
+	const uint8_t hrs_128[] = {BT_UUID_128_ENCODE(BT_UUID_HRS_VAL, 0x0000, 0x1000, 0x8000,
+						      0x00805F9B34FB)};
+	const uint8_t bas_128[] = {BT_UUID_128_ENCODE(BT_UUID_BAS_VAL, 0x0000, 0x1000, 0x8000,
+						      0x00805F9B34FB)};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &hrs));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &uuid_32));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false));
+
+	zassert_true(report_one(BT_DATA_UUID16_ALL, hrs_list, sizeof(hrs_list)));
+	zassert_equal(match_status.uuid.count, 1);
+	zassert_equal(bt_uuid_cmp(match_status.uuid.uuid[0], &hrs.uuid), 0);
+
+	zassert_false(report_one(BT_DATA_UUID16_SOME, hrs_list, sizeof(uint16_t)));
+
+	zassert_true(report_one(BT_DATA_UUID32_SOME, uuid_32_list, sizeof(uuid_32_list)));
+	zassert_equal(bt_uuid_cmp(match_status.uuid.uuid[0], &uuid_32.uuid), 0);
+
+	zassert_true(report_one(BT_DATA_UUID128_ALL, hrs_128, sizeof(hrs_128)));
+	zassert_equal(bt_uuid_cmp(match_status.uuid.uuid[0], &hrs.uuid), 0);
+
+	zassert_false(report_one(BT_DATA_UUID128_ALL, bas_128, sizeof(bas_128)));
+}
+
+ZTEST(bt_scan, test_uuid_all)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_GAP_ADV_MAX_ADV_DATA_LEN);
+	const struct bt_uuid_16 hrs = BT_UUID_INIT_16(BT_UUID_HRS_VAL);
+	const struct bt_uuid_16 bas = BT_UUID_INIT_16(BT_UUID_BAS_VAL);
+	const struct bt_uuid_128 nus = BT_UUID_INIT_128(
+		BT_UUID_128_ENCODE(0x6E400001, 0xB5A3, 0xF393, 0xE0A9, 0xE50E24DCCA9E));
+	const uint8_t uuid_16_list[] = {BT_UUID_16_ENCODE(BT_UUID_BAS_VAL),
+					BT_UUID_16_ENCODE(BT_UUID_HRS_VAL)};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &hrs));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &bas));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &nus));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, true));
+
+	/* Each UUID field is matched on its own, so a field must hold all the UUIDs */
+	scan_test_adv_add(&buf, BT_DATA_UUID16_ALL, uuid_16_list, sizeof(uuid_16_list));
+	scan_test_adv_add(&buf, BT_DATA_UUID128_ALL, nus.val, sizeof(nus.val));
+	scan_test_report(&peer_addr, &buf);
+	zassert_equal(match_cnt, 0);
+
+	bt_scan_filter_remove_all();
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &hrs));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &bas));
+
+	zassert_true(report_one(BT_DATA_UUID16_ALL, uuid_16_list, sizeof(uuid_16_list)));
+	zassert_equal(match_status.uuid.count, 2);
+	zassert_equal(bt_uuid_cmp(match_status.uuid.uuid[0], &hrs.uuid), 0);
+	zassert_equal(bt_uuid_cmp(match_status.uuid.uuid[1], &bas.uuid), 0);
+
+	zassert_false(report_one(BT_DATA_UUID16_ALL, uuid_16_list, sizeof(uint16_t)));
+}
+
+ZTEST(bt_scan, test_appearance)
+{
+	uint16_t appearance = BT_APPEARANCE_HID_KEYBOARD;
+	const uint8_t keyboard[] = {BT_BYTES_LIST_LE16(BT_APPEARANCE_HID_KEYBOARD)};
+	const uint8_t mouse[] = {BT_BYTES_LIST_LE16(BT_APPEARANCE_HID_MOUSE)};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_APPEARANCE, &appearance));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_APPEARANCE_FILTER, false));
+
+	zassert_true(report_one(BT_DATA_GAP_APPEARANCE, keyboard, sizeof(keyboard)));
+	zassert_equal(*match_status.appearance.appearance, BT_APPEARANCE_HID_KEYBOARD);
+
+	zassert_false(report_one(BT_DATA_GAP_APPEARANCE, mouse, sizeof(mouse)));
+	zassert_false(report_one(BT_DATA_GAP_APPEARANCE, keyboard, sizeof(uint8_t)));
+}
+
+ZTEST(bt_scan, test_manufacturer_data)
+{
+	uint8_t long_data[] = {0x59, 0x00, 0x01};
+	uint8_t short_data[] = {0x59, 0x00};
+	struct bt_scan_manufacturer_data md_long = {
+		.data = long_data,
+		.data_len = sizeof(long_data),
+	};
+	struct bt_scan_manufacturer_data md_short = {
+		.data = short_data,
+		.data_len = sizeof(short_data),
+	};
+	const uint8_t adv_long[] = {0x59, 0x00, 0x01, 0xAA, 0xBB};
+	const uint8_t adv_short[] = {0x59, 0x00, 0x02};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA, &md_long));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA, &md_short));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_MANUFACTURER_DATA_FILTER, false));
+
+	/* Both filters are at the start of the data, the first one is reported */
+	zassert_true(report_one(BT_DATA_MANUFACTURER_DATA, adv_long, sizeof(adv_long)));
+	zassert_equal(match_status.manufacturer_data.len, sizeof(long_data));
+
+	zassert_true(report_one(BT_DATA_MANUFACTURER_DATA, adv_short, sizeof(adv_short)));
+	zassert_equal(match_status.manufacturer_data.len, sizeof(short_data));
+
+	zassert_false(report_one(BT_DATA_MANUFACTURER_DATA, adv_short, sizeof(uint8_t)));
+}
+
+ZTEST(bt_scan, test_all_mode)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_GAP_ADV_MAX_ADV_DATA_LEN);
+	uint16_t appearance = BT_APPEARANCE_GENERIC_WATCH;
+	const uint8_t watch[] = {BT_BYTES_LIST_LE16(BT_APPEARANCE_GENERIC_WATCH)};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Watch"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_APPEARANCE, &appearance));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER | BT_SCAN_APPEARANCE_FILTER, true));
+
+	zassert_false(report_name(BT_DATA_NAME_COMPLETE, "Watch"));
+
+	scan_test_adv_add(&buf, BT_DATA_NAME_COMPLETE, "Watch", strlen("Watch"));
+	scan_test_adv_add(&buf, BT_DATA_GAP_APPEARANCE, watch, sizeof(watch));
+	scan_test_report(&peer_addr, &buf);
+	zassert_equal(match_cnt, 1);
+	zassert_true(match_status.name.match);
+	zassert_true(match_status.appearance.match);
+}
+
+ZTEST(bt_scan, test_filter_remove_all)
+{
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Thingy52"));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER, false));
+	zassert_true(report_name(BT_DATA_NAME_COMPLETE, "Thingy52"));
+
+	bt_scan_filter_remove_all();
+	zassert_false(report_name(BT_DATA_NAME_COMPLETE, "Thingy52"));
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Thingy91"));
+	zassert_false(report_name(BT_DATA_NAME_COMPLETE, "Thingy52"));
+	zassert_true(report_name(BT_DATA_NAME_COMPLETE, "Thingy91"));
+}
+
+static void *setup(void)
+{
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_test_cb);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	bt_scan_filter_disable();
+	bt_scan_filter_remove_all();
+
+	match_cnt = 0;
+	no_match_cnt = 0;
+	memset(&match_status, 0, sizeof(match_status));
+}
+
+ZTEST_SUITE(bt_scan, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SCAN_TEST_H_
+#define _SCAN_TEST_H_
+
+#include <zephyr/bluetooth/addr.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/net_buf.h>
+
+/* Add an AD field to advertising data. */
+void scan_test_adv_add(struct net_buf_simple *buf, uint8_t type, const void *data, uint8_t len);
+
+/* Pass advertising data to the Scan library with the given report information. */
+void scan_test_report_info(const struct bt_le_scan_recv_info *info, struct net_buf_simple *buf);
+
+/* Pass advertising data to the Scan library as a report from the given address. */
+void scan_test_report(const bt_addr_le_t *addr, struct net_buf_simple *buf);
+
+#endif /* _SCAN_TEST_H_ */
@@ -96,6 +96,46 @@ ZTEST(caf_sensor_aggregator_tests, test_order)
 	zassert_ok(err, "Test execution hanged");
 }
 
+ZTEST(caf_sensor_aggregator_tests, test_batch)
+{
+	cur_test_id = TEST_BATCH;
+	struct test_start_event *ts = new_test_start_event();
+
+	zassert_not_null(ts, "Failed to allocate event");
+	ts->test_id = cur_test_id;
+	APP_EVENT_SUBMIT(ts);
+
+	/* Blocks of samples are not aligned to the aggregator buffers. */
+	size_t sample_cnt = SAMPLES_IN_AGG_BUF * BATCH_TEST_AGG_EVENTS;
+	size_t sample_idx = 0;
+
+	BUILD_ASSERT((SAMPLES_IN_AGG_BUF * BATCH_TEST_AGG_EVENTS) %
+		     BATCH_TEST_SAMPLES_IN_EVENT == 0);
+
+	for (size_t i = 0; i < sample_cnt / BATCH_TEST_SAMPLES_IN_EVENT; i++) {
+		size_t size = sizeof(struct sensor_value) * BATCH_TEST_SENSOR_SAMPLE_SIZE *
+			      BATCH_TEST_SAMPLES_IN_EVENT;
+		struct sensor_event *se = new_sensor_event(size);
+
+		zassert_not_null(se, "Failed to allocate event");
+		se->descr = BATCH_TEST_AGG_DESCR;
+		se->dyndata.size = size;
+
+		struct sensor_value *data = sensor_event_get_data_ptr(se);
+
+		for (size_t j = 0; j < BATCH_TEST_SAMPLES_IN_EVENT; j++) {
+			data[j * BATCH_TEST_SENSOR_SAMPLE_SIZE].val1 = sample_idx;
+			sample_idx++;
+		}
+
+		APP_EVENT_SUBMIT(se);
+	}
+
+	int err = k_sem_take(&test_end_sem, K_SECONDS(30));
+
+	zassert_ok(err, "Test execution hanged");
+}
+
 ZTEST(caf_sensor_aggregator_tests, test_status)
 {
 	test_start(TEST_STATUS);
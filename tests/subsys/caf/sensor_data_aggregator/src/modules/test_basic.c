@@ -40,6 +40,11 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			break;
 		}
 
+		case TEST_BATCH:
+		{
+			break;
+		}
+
 		case TEST_STATUS:
 		{
 			for (size_t i = 0; i < STATUS_TEST_SENSOR_EVENTS; i++) {
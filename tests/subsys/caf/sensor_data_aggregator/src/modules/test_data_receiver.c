@@ -19,6 +19,7 @@
 static enum test_id cur_test_id;
 int msg_num;
 int order_event_indicator = SAMPLES_IN_AGG_BUF * ORDER_TEST_AGG_EVENTS;
+int batch_sample_idx;
 
 static bool app_event_handler(const struct app_event_header *aeh)
 {
@@ -71,6 +72,25 @@ static bool app_event_handler(const struct app_event_header *aeh)
 				APP_EVENT_SUBMIT(te);
 			}
 
+		} else if (strcmp(event->sensor_descr, BATCH_TEST_AGG_DESCR) == 0) {
+
+			zassert_equal(event->sample_cnt, SAMPLES_IN_AGG_BUF,
+				      "Incorrect number of samples");
+
+			for (int j = 0; j < SAMPLES_IN_AGG_BUF; j++) {
+				zassert_equal(event->samples[j * BATCH_TEST_SENSOR_SAMPLE_SIZE].val1,
+					      batch_sample_idx, "Incorrect sample order");
+				batch_sample_idx++;
+			}
+
+			if (batch_sample_idx == SAMPLES_IN_AGG_BUF * BATCH_TEST_AGG_EVENTS) {
+				struct test_end_event *te = new_test_end_event();
+
+				zassert_not_null(te, "Failed to allocate event");
+				te->test_id = cur_test_id;
+				APP_EVENT_SUBMIT(te);
+			}
+
 		} else if (strcmp(event->sensor_descr, STATUS_TEST_AGG_DESCR) == 0) {
 
 			for (int k = 0; k < STATUS_TEST_SENSOR_EVENTS; k++) {
@@ -27,6 +27,7 @@ enum test_id {
 	TEST_CHANGE_PERIOD_PRE,
 	TEST_CHANGE_PERIOD_POST,
 	TEST_MULTIPLE_SENSORS,
+	TEST_BATCH,
 
 	TEST_CNT
 };
@@ -42,6 +42,15 @@ static int set_wave(void)
 		return err;
 	}
 
+	err = sensor_sim_set_wave_param(DEVICE_DT_GET(DT_NODELABEL(sensor_sim_4)),
+					    sim_signal_params.chan,
+					    &w->wave_param);
+
+	if (err) {
+		zassert_ok(err, "Cannot set simulated accel params ");
+		return err;
+	}
+
 	return 0;
 }
 
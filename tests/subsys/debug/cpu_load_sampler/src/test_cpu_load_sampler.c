@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <zephyr/ztest.h>
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <debug/cpu_load_sampler.h>
+
+#define SAMPLE_INTERVAL_US 1000
+#define BUSY_TIME_US 100000
+#define HOT_THREAD_NAME "hot"
+#define HOT_STACK_SIZE 1024
+
+static K_THREAD_STACK_DEFINE(hot_stack, HOT_STACK_SIZE);
+static struct k_thread hot_thread;
+
+struct hot_samples {
+	uint32_t count;
+	uint32_t no_pc;
+};
+
+static void hot_thread_fn(void *p1, void *p2, void *p3)
+{
+	k_busy_wait(BUSY_TIME_US);
+}
+
+static void run_hot_thread(void)
+{
+	k_tid_t tid = k_thread_create(&hot_thread, hot_stack, K_THREAD_STACK_SIZEOF(hot_stack),
+				      hot_thread_fn, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_FOREVER);
+
+	k_thread_name_set(tid, HOT_THREAD_NAME);
+	k_thread_start(tid);
+	zassert_ok(k_thread_join(tid, K_FOREVER));
+}
+
+static void thread_cb(const char *thread, uint32_t count, void *user_data)
+{
+	struct hot_samples *hot = user_data;
+
+	if (!strcmp(thread, HOT_THREAD_NAME)) {
+		hot->count += count;
+	}
+}
+
+static void pc_cb(const char *thread, uintptr_t pc, uint32_t count, void *user_data)
+{
+	struct hot_samples *hot = user_data;
+
+	if (!strcmp(thread, HOT_THREAD_NAME)) {
+		hot->count += count;
+		if (pc == 0) {
+			hot->no_pc += count;
+		}
+	}
+}
+
+static void count_cb(const char *thread, uint32_t count, void *user_data)
+{
+	uint32_t *total = user_data;
+
+	*total += count;
+}
+
+ZTEST(cpu_load_sampler, test_busy_thread)
+{
+	struct cpu_load_sampler_stats stats;
+	struct hot_samples by_thread = {0};
+	struct hot_samples by_pc = {0};
+
+	zassert_ok(cpu_load_sampler_start(SAMPLE_INTERVAL_US));
+	run_hot_thread();
+	cpu_load_sampler_stop();
+
+	cpu_load_sampler_stats_get(&stats);
+	cpu_load_sampler_thread_foreach(thread_cb, &by_thread);
+	cpu_load_sampler_pc_foreach(pc_cb, &by_pc);
+
+	/* Most of the samples are taken while the busy thread is running */
+	zassert_true(by_thread.count > (BUSY_TIME_US / SAMPLE_INTERVAL_US) / 2,
+		     "Unexpected samples:%u", by_thread.count);
+	zassert_true(by_thread.count <= stats.samples);
+	zassert_equal(stats.dropped, 0);
+	zassert_equal(by_pc.count, by_thread.count);
+
+	if (IS_ENABLED(CONFIG_ARMV7_M_ARMV8_M_MAINLINE)) {
+		zassert_equal(by_pc.no_pc, 0, "Program counter not sampled");
+	} else {
+		zassert_equal(by_pc.no_pc, by_pc.count);
+	}
+}
+
+ZTEST(cpu_load_sampler, test_stop_and_reset)
+{
+	struct cpu_load_sampler_stats stats;
+	uint32_t total = 0;
+
+	zassert_equal(cpu_load_sampler_start(0), -EINVAL);
+
+	zassert_ok(cpu_load_sampler_start(SAMPLE_INTERVAL_US));
+	k_busy_wait(10 * SAMPLE_INTERVAL_US);
+	cpu_load_sampler_stop();
+
+	cpu_load_sampler_stats_get(&stats);
+	zassert_true(stats.samples > 0);
+
+	/* No samples are taken when the sampler is stopped */
+	k_busy_wait(10 * SAMPLE_INTERVAL_US);
+	cpu_load_sampler_thread_foreach(count_cb, &total);
+	zassert_equal(total, stats.samples);
+
+	cpu_load_sampler_reset();
+	cpu_load_sampler_stats_get(&stats);
+	zassert_equal(stats.samples, 0);
+
+	total = 0;
+	cpu_load_sampler_thread_foreach(count_cb, &total);
+	zassert_equal(total, 0);
+}
+
+static void before(void *fixture)
+{
+	cpu_load_sampler_stop();
+	cpu_load_sampler_reset();
+}
+
+ZTEST_SUITE(cpu_load_sampler, NULL, NULL, before, NULL, NULL);
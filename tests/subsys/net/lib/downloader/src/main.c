@@ -190,6 +190,7 @@
 
 static int dl_callback(const struct downloader_evt *event);
 static int dl_callback_abort(const struct downloader_evt *event);
+static int dl_callback_coap_window(const struct downloader_evt *event);
 
 static struct downloader dl;
 
@@ -212,6 +213,12 @@ struct downloader_cfg dl_cfg_cb_abort = {
 	.buf_size = sizeof(dl_buf),
 };
 
+struct downloader_cfg dl_cfg_coap_window = {
+	.callback = dl_callback_coap_window,
+	.buf = dl_buf,
+	.buf_size = sizeof(dl_buf),
+};
+
 static struct downloader_host_cfg dl_host_cfg = {
 	.pdn_id = 1,
 	.keep_connection = true,
@@ -242,6 +249,11 @@ struct downloader_transport_http_cfg dl_http_cfg = {
 	.sock_recv_timeo_ms = 60000,
 };
 
+struct downloader_transport_http_cfg dl_http_cfg_pipelined = {
+	.sock_recv_timeo_ms = 60000,
+	.pipeline_depth = 2,
+};
+
 DEFINE_FFF_GLOBALS;
 
 FAKE_VALUE_FUNC(int, z_impl_zsock_setsockopt, int, int, int, const void *, net_socklen_t);
@@ -898,6 +910,39 @@ static ssize_t z_impl_zsock_recvfrom_https_partial_content(
 	return 0;
 }
 
+/* The second range is requested as soon as the first header has been received, and its
+ * response arrives in the same read as the end of the first one.
+ */
+static ssize_t z_impl_zsock_recvfrom_https_pipelined(
+	int sock, void *buf, size_t max_len, int flags, struct net_sockaddr *src_addr,
+	net_socklen_t *addrlen)
+{
+	size_t len;
+
+	TEST_ASSERT_EQUAL(FD, sock);
+	TEST_ASSERT(sizeof(dl_buf) >= max_len);
+
+	switch (z_impl_zsock_recvfrom_fake.call_count) {
+	case 1:
+		TEST_ASSERT_EQUAL(1, z_impl_zsock_sendto_fake.call_count);
+		memcpy(buf, HTTPS_HDR_OK_PARTIAL_CONTENT_1, strlen(HTTPS_HDR_OK_PARTIAL_CONTENT_1));
+		memset((char *)buf + strlen(HTTPS_HDR_OK_PARTIAL_CONTENT_1), 23, 16);
+		return strlen(HTTPS_HDR_OK_PARTIAL_CONTENT_1) + 16;
+	case 2:
+		/* Both ranges requested before the first one is complete */
+		TEST_ASSERT_EQUAL(2, z_impl_zsock_sendto_fake.call_count);
+		memset(buf, 23, 16);
+		len = 16;
+		memcpy((char *)buf + len, HTTPS_HDR_OK_PARTIAL_CONTENT_2,
+		       strlen(HTTPS_HDR_OK_PARTIAL_CONTENT_2));
+		len += strlen(HTTPS_HDR_OK_PARTIAL_CONTENT_2);
+		memset((char *)buf + len, 23, 32);
+		return len + 32;
+	}
+
+	return 0;
+}
+
 static ssize_t z_impl_zsock_recvfrom_https_partial_content_partial_2nd_header(
 	int sock, void *buf, size_t max_len, int flags, struct net_sockaddr *src_addr,
 	net_socklen_t *addrlen)
@@ -1306,6 +1351,237 @@ struct coap_transmission_parameters coap_get_transmission_parameters_ok(void)
 	return coap_transmission_params;
 }
 
+/* Windowed block-wise transfer. The fakes below act as a server that logs the Block2
+ * requests and answers them from coap_window_file, in the order picked by the recvfrom fake
+ * of each test.
+ */
+#define COAP_WINDOW_FILE_SIZE 1500
+#define COAP_WINDOW_MAX_REQUESTS 64
+#define COAP_WINDOW_ACK_TIMEOUT_MS 100
+
+struct coap_window_request {
+	uint16_t id;
+	uint32_t offset;
+	enum coap_block_size szx;
+	bool answered;
+};
+
+static uint8_t coap_window_file[COAP_WINDOW_FILE_SIZE];
+static size_t coap_window_file_size;
+static size_t coap_window_received;
+static struct coap_window_request coap_window_requests[COAP_WINDOW_MAX_REQUESTS];
+static size_t coap_window_request_count;
+static uint16_t coap_window_request_id;
+
+static struct {
+	uint16_t id;
+	uint32_t offset;
+	int block2;
+	uint16_t len;
+} coap_window_response;
+
+static void coap_window_reset(size_t file_size)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(coap_window_file); i++) {
+		coap_window_file[i] = i % 251;
+	}
+
+	coap_window_file_size = file_size;
+	coap_window_received = 0;
+	coap_window_request_count = 0;
+	memset(coap_window_requests, 0, sizeof(coap_window_requests));
+}
+
+/* Answer a request with blocks of at most server_szx, like a server with a smaller block
+ * size than the one requested.
+ */
+static ssize_t coap_window_respond(struct coap_window_request *req,
+				   enum coap_block_size server_szx)
+{
+	enum coap_block_size szx = MIN(req->szx, server_szx);
+	size_t block = coap_block_size_to_bytes(szx);
+	bool more;
+
+	req->answered = true;
+
+	coap_window_response.id = req->id;
+	coap_window_response.offset = req->offset;
+	coap_window_response.len = MIN(block, coap_window_file_size - req->offset);
+
+	more = req->offset + coap_window_response.len < coap_window_file_size;
+	coap_window_response.block2 = ((req->offset / block) << 4) | (more ? 0x08 : 0) | szx;
+
+	return 32;
+}
+
+/* Nothing to answer, let the request time out */
+static ssize_t coap_window_no_response(void)
+{
+	k_sleep(K_MSEC(10));
+	errno = EAGAIN;
+	return -1;
+}
+
+static struct coap_window_request *coap_window_oldest(void)
+{
+	for (size_t i = 0; i < coap_window_request_count; i++) {
+		if (!coap_window_requests[i].answered) {
+			return &coap_window_requests[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct coap_window_request *coap_window_newest(void)
+{
+	for (size_t i = coap_window_request_count; i > 0; i--) {
+		if (!coap_window_requests[i - 1].answered) {
+			return &coap_window_requests[i - 1];
+		}
+	}
+
+	return NULL;
+}
+
+/* The blocks in flight are answered last to first */
+static ssize_t z_impl_zsock_recvfrom_coap_window_reordered(
+	int sock, void *buf, size_t max_len, int flags, struct net_sockaddr *src_addr,
+	net_socklen_t *addrlen)
+{
+	struct coap_window_request *req = coap_window_newest();
+
+	if (!req) {
+		return coap_window_no_response();
+	}
+
+	return coap_window_respond(req, COAP_BLOCK_1024);
+}
+
+/* The first request for the third block is lost */
+#define COAP_WINDOW_LOST_OFFSET 256
+
+static ssize_t z_impl_zsock_recvfrom_coap_window_lossy(
+	int sock, void *buf, size_t max_len, int flags, struct net_sockaddr *src_addr,
+	net_socklen_t *addrlen)
+{
+	struct coap_window_request *req = coap_window_oldest();
+
+	if (req == &coap_window_requests[2]) {
+		TEST_ASSERT_EQUAL(COAP_WINDOW_LOST_OFFSET, req->offset);
+		req->answered = true;
+		req = coap_window_oldest();
+	}
+
+	if (!req) {
+		return coap_window_no_response();
+	}
+
+	return coap_window_respond(req, COAP_BLOCK_1024);
+}
+
+/* The server switches to 64 byte blocks after the first one, with the requests for the
+ * following blocks already in flight.
+ */
+static ssize_t z_impl_zsock_recvfrom_coap_window_small_blocks(
+	int sock, void *buf, size_t max_len, int flags, struct net_sockaddr *src_addr,
+	net_socklen_t *addrlen)
+{
+	struct coap_window_request *req = coap_window_oldest();
+
+	if (!req) {
+		return coap_window_no_response();
+	}
+
+	if (req == &coap_window_requests[0]) {
+		return coap_window_respond(req, COAP_BLOCK_1024);
+	}
+
+	return coap_window_respond(req, COAP_BLOCK_64);
+}
+
+int coap_packet_init_coap_window(struct coap_packet *cpkt, uint8_t *data, uint16_t max_len,
+				 uint8_t ver, uint8_t type, uint8_t token_len,
+				 const uint8_t *token, uint8_t code, uint16_t id)
+{
+	cpkt->data = data;
+	cpkt->max_len = max_len;
+	/* Header only, the options are not encoded by the fakes */
+	cpkt->offset = 4;
+
+	coap_window_request_id = id;
+
+	return 0;
+}
+
+int coap_append_block2_option_coap_window(struct coap_packet *cpkt,
+					  struct coap_block_context *ctx)
+{
+	TEST_ASSERT(coap_window_request_count < COAP_WINDOW_MAX_REQUESTS);
+
+	coap_window_requests[coap_window_request_count++] = (struct coap_window_request){
+		.id = coap_window_request_id,
+		.offset = ctx->current,
+		.szx = ctx->block_size,
+	};
+
+	return 0;
+}
+
+uint16_t coap_header_get_id_coap_window(const struct coap_packet *cpkt)
+{
+	return coap_window_response.id;
+}
+
+int coap_get_option_int_coap_window(const struct coap_packet *cpkt, uint16_t code)
+{
+	switch (code) {
+	case COAP_OPTION_BLOCK2:
+		return coap_window_response.block2;
+	case COAP_OPTION_SIZE2:
+		return coap_window_file_size;
+	}
+
+	return -ENOENT;
+}
+
+const uint8_t *coap_packet_get_payload_coap_window(const struct coap_packet *cpkt,
+						   uint16_t *len)
+{
+	*len = coap_window_response.len;
+
+	return &coap_window_file[coap_window_response.offset];
+}
+
+struct coap_transmission_parameters coap_get_transmission_parameters_coap_window(void)
+{
+	struct coap_transmission_parameters params = coap_transmission_params;
+
+	params.ack_timeout = COAP_WINDOW_ACK_TIMEOUT_MS;
+
+	return params;
+}
+
+static void coap_window_fakes_set(void)
+{
+	zsock_getaddrinfo_fake.custom_fake = zsock_getaddrinfo_server_ok;
+	zsock_freeaddrinfo_fake.custom_fake = zsock_freeaddrinfo_server_ipv6;
+	z_impl_zsock_socket_fake.custom_fake = z_impl_zsock_socket_coap_ipv6_ok;
+	z_impl_zsock_connect_fake.custom_fake = z_impl_zsock_connect_ipv6_ok;
+	z_impl_zsock_setsockopt_fake.custom_fake = z_impl_zsock_setsockopt_coap_ok;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_ok;
+
+	coap_get_transmission_parameters_fake.custom_fake =
+		coap_get_transmission_parameters_coap_window;
+	coap_packet_init_fake.custom_fake = coap_packet_init_coap_window;
+	coap_append_block2_option_fake.custom_fake = coap_append_block2_option_coap_window;
+	coap_header_get_id_fake.custom_fake = coap_header_get_id_coap_window;
+	coap_header_get_type_fake.custom_fake = coap_header_get_type_ack;
+	coap_header_get_code_fake.custom_fake = coap_header_get_code_ok;
+	coap_get_option_int_fake.custom_fake = coap_get_option_int_coap_window;
+	coap_packet_get_payload_fake.custom_fake = coap_packet_get_payload_coap_window;
+}
+
 struct pipe {
 	struct downloader_evt data[10];
 	uint8_t wr_idx;
@@ -1402,6 +1678,22 @@ static int dl_callback_abort(const struct downloader_evt *event)
 	return 1; /* stop download*/
 }
 
+/* The blocks must be passed on in file order, whatever order they arrive in */
+static int dl_callback_coap_window(const struct downloader_evt *event)
+{
+	TEST_ASSERT(event != NULL);
+
+	if (event->id == DOWNLOADER_EVT_FRAGMENT) {
+		TEST_ASSERT(coap_window_received + event->fragment.len <= coap_window_file_size);
+		TEST_ASSERT_EQUAL_MEMORY(&coap_window_file[coap_window_received],
+					 event->fragment.buf, event->fragment.len);
+		coap_window_received += event->fragment.len;
+		return 0;
+	}
+
+	return dl_callback(event);
+}
+
 static struct downloader_evt dl_wait_for_event(enum downloader_evt_id event,
 						     k_timeout_t timeout)
 {
@@ -1623,6 +1915,61 @@ void test_downloader_get_https_partial_content(void)
 	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
 }
 
+void test_downloader_get_https_pipelined(void)
+{
+	int err;
+	struct downloader_evt evt;
+
+	err = downloader_init(&dl, &dl_cfg);
+	TEST_ASSERT_EQUAL(0, err);
+
+	err = downloader_transport_http_set_config(&dl, &dl_http_cfg_pipelined);
+	TEST_ASSERT_EQUAL(0, err);
+
+	zsock_getaddrinfo_fake.custom_fake = zsock_getaddrinfo_server_ok;
+	zsock_freeaddrinfo_fake.custom_fake = zsock_freeaddrinfo_server_ipv6;
+	z_impl_zsock_socket_fake.custom_fake = z_impl_zsock_socket_https_ipv6_ok;
+	z_impl_zsock_connect_fake.custom_fake = z_impl_zsock_connect_ipv6_ok;
+	z_impl_zsock_setsockopt_fake.custom_fake = z_impl_zsock_setsockopt_https_ok;
+	z_impl_zsock_sendto_fake.custom_fake = z_impl_zsock_sendto_ok;
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_https_pipelined;
+
+	err = downloader_get(&dl, &dl_host_conf_w_sec_tags_range_override_32, HTTPS_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(2, z_impl_zsock_sendto_fake.call_count);
+	TEST_ASSERT_EQUAL(2, z_impl_zsock_recvfrom_fake.call_count);
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+}
+
+void test_downloader_transport_http_set_config_einval(void)
+{
+	int err;
+	/* Not the shared instance, the configuration stays set for later downloads */
+	static struct downloader dl_cfg_test;
+	struct downloader_transport_http_cfg cfg = {
+		.sock_recv_timeo_ms = 60000,
+		.pipeline_depth = 9,
+	};
+
+	err = downloader_transport_http_set_config(NULL, &cfg);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	err = downloader_transport_http_set_config(&dl_cfg_test, NULL);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	/* Deeper than the number of requests that can be tracked in flight */
+	err = downloader_transport_http_set_config(&dl_cfg_test, &cfg);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+
+	cfg.pipeline_depth = 8;
+	err = downloader_transport_http_set_config(&dl_cfg_test, &cfg);
+	TEST_ASSERT_EQUAL(0, err);
+}
+
 void test_downloader_get_https_partial_content_partial_2nd_header(void)
 {
 	int err;
@@ -2318,6 +2665,140 @@ void test_downloader_get_coap_unauthorized_response(void)
 	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
 }
 
+void test_downloader_get_coap_window_reordered(void)
+{
+	int err;
+	struct downloader_evt evt;
+	struct downloader_transport_coap_cfg coap_cfg = {
+		.block_size = COAP_BLOCK_64,
+		.max_retransmission = 4,
+		.window = 4,
+	};
+
+	coap_window_reset(600);
+
+	err = downloader_init(&dl, &dl_cfg_coap_window);
+	TEST_ASSERT_EQUAL(0, err);
+
+	err = downloader_transport_coap_set_config(&dl, &coap_cfg);
+	TEST_ASSERT_EQUAL(0, err);
+
+	coap_window_fakes_set();
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_coap_window_reordered;
+
+	err = downloader_get(&dl, &dl_host_cfg, COAP_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(600, coap_window_received);
+
+	/* One request per block, the blocks that arrived early were kept */
+	TEST_ASSERT_EQUAL(10, coap_window_request_count);
+	TEST_ASSERT_EQUAL(10, z_impl_zsock_sendto_fake.call_count);
+	for (size_t i = 0; i < coap_window_request_count; i++) {
+		TEST_ASSERT_EQUAL(i * 64, coap_window_requests[i].offset);
+		TEST_ASSERT_EQUAL(COAP_BLOCK_64, coap_window_requests[i].szx);
+	}
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+}
+
+void test_downloader_get_coap_window_lossy(void)
+{
+	int err;
+	size_t retransmission = 0;
+	struct downloader_evt evt;
+	struct downloader_transport_coap_cfg coap_cfg = {
+		.block_size = COAP_BLOCK_128,
+		.max_retransmission = 4,
+		.window = 4,
+	};
+
+	coap_window_reset(1000);
+
+	err = downloader_init(&dl, &dl_cfg_coap_window);
+	TEST_ASSERT_EQUAL(0, err);
+
+	err = downloader_transport_coap_set_config(&dl, &coap_cfg);
+	TEST_ASSERT_EQUAL(0, err);
+
+	coap_window_fakes_set();
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_coap_window_lossy;
+
+	err = downloader_get(&dl, &dl_host_cfg, COAP_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(1000, coap_window_received);
+
+	/* The lost block is requested again with the same message ID */
+	for (size_t i = 3; i < coap_window_request_count; i++) {
+		if (coap_window_requests[i].offset == COAP_WINDOW_LOST_OFFSET) {
+			TEST_ASSERT_EQUAL(0, retransmission);
+			retransmission = i;
+		}
+	}
+
+	TEST_ASSERT_NOT_EQUAL(0, retransmission);
+	TEST_ASSERT_EQUAL(coap_window_requests[2].id, coap_window_requests[retransmission].id);
+	TEST_ASSERT_EQUAL(COAP_BLOCK_128, coap_window_requests[retransmission].szx);
+
+	/* The loss decreases the block size of the next request */
+	TEST_ASSERT(retransmission + 1 < coap_window_request_count);
+	TEST_ASSERT_EQUAL(COAP_BLOCK_64, coap_window_requests[retransmission + 1].szx);
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+}
+
+void test_downloader_get_coap_window_server_smaller_block(void)
+{
+	int err;
+	struct downloader_evt evt;
+	struct downloader_transport_coap_cfg coap_cfg = {
+		.block_size = COAP_BLOCK_256,
+		.max_retransmission = 4,
+		.window = 4,
+	};
+
+	coap_window_reset(1500);
+
+	err = downloader_init(&dl, &dl_cfg_coap_window);
+	TEST_ASSERT_EQUAL(0, err);
+
+	err = downloader_transport_coap_set_config(&dl, &coap_cfg);
+	TEST_ASSERT_EQUAL(0, err);
+
+	coap_window_fakes_set();
+	z_impl_zsock_recvfrom_fake.custom_fake = z_impl_zsock_recvfrom_coap_window_small_blocks;
+
+	err = downloader_get(&dl, &dl_host_cfg, COAP_URL, 0);
+	TEST_ASSERT_EQUAL(0, err);
+
+	evt = dl_wait_for_event(DOWNLOADER_EVT_DONE, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(1500, coap_window_received);
+
+	/* The first block and the window that followed it */
+	TEST_ASSERT(coap_window_request_count > 5);
+	for (size_t i = 0; i < 5; i++) {
+		TEST_ASSERT_EQUAL(i * 256, coap_window_requests[i].offset);
+		TEST_ASSERT_EQUAL(COAP_BLOCK_256, coap_window_requests[i].szx);
+	}
+
+	/* The requests in flight after the smaller block are dropped, and the rest of the
+	 * file is requested from the end of that block, in blocks no larger than twice the
+	 * server block size.
+	 */
+	TEST_ASSERT_EQUAL(256 + 64, coap_window_requests[5].offset);
+	for (size_t i = 5; i < coap_window_request_count; i++) {
+		TEST_ASSERT(coap_window_requests[i].szx <= COAP_BLOCK_128);
+	}
+
+	downloader_deinit(&dl);
+	dl_wait_for_event(DOWNLOADER_EVT_DEINITIALIZED, K_SECONDS(1));
+}
+
 void test_downloader_get_einval(void)
 {
 	int err;
@@ -0,0 +1,179 @@
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+import asyncio
+import logging
+import threading
+
+import pytest
+from twister_harness import DeviceAdapter
+
+logger = logging.getLogger(__name__)
+
+# Must match SERVER_URL, SERVER_URL_LOSSY and FILE_SIZE in src/main.c
+SERVER_PORT = 15683
+FILE_PATH = 'window.bin'
+FILE_PATH_LOSSY = 'lossy.bin'
+FILE_SIZE = 32 * 1024
+# Emulated round trip time, each response is sent this long after its request arrived
+RTT = 0.1
+# Every LOSS_INTERVAL-th request for the lossy file is dropped
+LOSS_INTERVAL = 5
+# Must match WINDOW in src/main.c
+WINDOW = 4
+
+FILE_DATA = bytes(((i * 7 + i // 251) & 0xff) for i in range(FILE_SIZE))
+
+COAP_TYPE_CON = 0
+COAP_TYPE_ACK = 2
+COAP_METHOD_GET = 0x01
+COAP_CONTENT = 0x45
+COAP_BAD_OPTION = 0x82
+COAP_NOT_FOUND = 0x84
+OPTION_URI_PATH = 11
+OPTION_BLOCK2 = 23
+OPTION_SIZE2 = 28
+# Largest block size, 1024 bytes
+MAX_SZX = 6
+
+
+def coap_parse(data: bytes):
+    """Return the message type, code, message ID, token and options of a CoAP message."""
+    if len(data) < 4 or data[0] >> 6 != 1:
+        raise ValueError('Not a CoAP message')
+
+    tkl = data[0] & 0x0f
+    msg_type = (data[0] >> 4) & 0x03
+    code = data[1]
+    mid = int.from_bytes(data[2:4], 'big')
+    token = data[4:4 + tkl]
+    options = []
+    pos = 4 + tkl
+    number = 0
+
+    while pos < len(data) and data[pos] != 0xff:
+        delta, length = data[pos] >> 4, data[pos] & 0x0f
+        pos += 1
+        ext = []
+        for nibble in (delta, length):
+            if nibble == 13:
+                ext.append(data[pos] + 13)
+                pos += 1
+            elif nibble == 14:
+                ext.append(int.from_bytes(data[pos:pos + 2], 'big') + 269)
+                pos += 2
+            elif nibble == 15:
+                raise ValueError('Invalid option')
+            else:
+                ext.append(nibble)
+        number += ext[0]
+        options.append((number, data[pos:pos + ext[1]]))
+        pos += ext[1]
+
+    return msg_type, code, mid, token, options
+
+
+def coap_uint(value: int) -> bytes:
+    return value.to_bytes((value.bit_length() + 7) // 8, 'big')
+
+
+def coap_message(msg_type, code, mid, token, options, payload=b'') -> bytes:
+    data = bytes([0x40 | (msg_type << 4) | len(token), code]) + mid.to_bytes(2, 'big') + token
+    number = 0
+
+    for option, value in options:
+        delta, number = option - number, option
+        # Options used here need at most one extension byte
+        header = [(min(delta, 13) << 4) | min(len(value), 13)]
+        header += [delta - 13] if delta >= 13 else []
+        header += [len(value) - 13] if len(value) >= 13 else []
+        data += bytes(header) + value
+
+    return data + (b'\xff' + payload if payload else b'')
+
+
+class CoapServer(asyncio.DatagramProtocol):
+    """Block-wise GET server, answering each request one RTT after it was received."""
+
+    def __init__(self):
+        self.transport = None
+        self.lossy_requests = 0
+        self.in_flight = 0
+        self.max_in_flight = 0
+
+    def connection_made(self, transport):
+        self.transport = transport
+
+    def response(self, data: bytes):
+        msg_type, code, mid, token, options = coap_parse(data)
+        if msg_type != COAP_TYPE_CON or code != COAP_METHOD_GET:
+            return None
+
+        path = '/'.join(value.decode() for number, value in options
+                        if number == OPTION_URI_PATH)
+        if path not in (FILE_PATH, FILE_PATH_LOSSY):
+            return coap_message(COAP_TYPE_ACK, COAP_NOT_FOUND, mid, token, [])
+
+        if path == FILE_PATH_LOSSY:
+            self.lossy_requests += 1
+            if self.lossy_requests % LOSS_INTERVAL == 0:
+                return None
+
+        block2 = next((int.from_bytes(value, 'big') for number, value in options
+                       if number == OPTION_BLOCK2), 0)
+        szx = min(block2 & 0x07, MAX_SZX)
+        size = 1 << (szx + 4)
+        offset = (block2 >> 4) << ((block2 & 0x07) + 4)
+        if offset >= FILE_SIZE:
+            return coap_message(COAP_TYPE_ACK, COAP_BAD_OPTION, mid, token, [])
+
+        num = offset // size
+        more = offset + size < FILE_SIZE
+        return coap_message(COAP_TYPE_ACK, COAP_CONTENT, mid, token,
+                            [(OPTION_BLOCK2, coap_uint((num << 4) | (more << 3) | szx)),
+                             (OPTION_SIZE2, coap_uint(FILE_SIZE))],
+                            FILE_DATA[num * size:(num + 1) * size])
+
+    def datagram_received(self, data, addr):
+        try:
+            response = self.response(data)
+        except (ValueError, IndexError):
+            logger.warning('Invalid CoAP message from %s', addr)
+            return
+
+        if response:
+            self.in_flight += 1
+            self.max_in_flight = max(self.max_in_flight, self.in_flight)
+            asyncio.get_running_loop().call_later(RTT, self.send, response, addr)
+
+    def send(self, response, addr):
+        self.in_flight -= 1
+        self.transport.sendto(response, addr)
+
+
+@pytest.fixture(scope='module')
+def coap_server():
+    loop = asyncio.new_event_loop()
+    transport, server = loop.run_until_complete(
+        loop.create_datagram_endpoint(CoapServer, local_addr=('127.0.0.1', SERVER_PORT)))
+    thread = threading.Thread(target=loop.run_forever, daemon=True)
+    thread.start()
+    yield server
+    loop.call_soon_threadsafe(transport.close)
+    loop.call_soon_threadsafe(loop.stop)
+    thread.join()
+
+
+def test_downloader_coap_window(coap_server, dut: DeviceAdapter):
+    lines = dut.readlines_until(regex='PROJECT EXECUTION SUCCESSFUL', timeout=120)
+
+    for line in lines:
+        if 'window' in line:
+            logger.info(line)
+
+    # The requests are counted as in flight until their delayed response is sent
+    logger.info('Requests in flight: %d', coap_server.max_in_flight)
+    assert 1 < coap_server.max_in_flight <= WINDOW
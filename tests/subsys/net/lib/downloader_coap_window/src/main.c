@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <net/downloader.h>
+#include <net/downloader_transport_coap.h>
+
+#include "dl_test.h"
+
+/* Served by pytest/test_downloader_coap_window.py, which delays each response by the
+ * emulated round trip time. Every fifth request for the lossy file is dropped.
+ */
+#define SERVER_URL "coap://127.0.0.1:15683/window.bin"
+#define SERVER_URL_LOSSY "coap://127.0.0.1:15683/lossy.bin"
+#define FILE_SIZE (32 * 1024)
+#define WINDOW 4
+
+/* Room for the blocks in flight, and one response */
+static char dl_buf[(WINDOW + 1) * 1024 + 256];
+static struct downloader_host_cfg dl_host_cfg;
+
+static void download(const char *url, uint8_t window)
+{
+	struct downloader_transport_coap_cfg coap_cfg = {
+		.block_size = COAP_BLOCK_1024,
+		.max_retransmission = 4,
+		.window = window,
+	};
+	struct downloader *dl;
+	int64_t duration;
+
+	dl = dl_test_init(dl_buf, sizeof(dl_buf));
+	zassert_ok(downloader_transport_coap_set_config(dl, &coap_cfg));
+
+	duration = dl_test_download(&dl_host_cfg, url, FILE_SIZE, K_SECONDS(60));
+
+	/* Informational only, the window logic is covered by the downloader unit tests */
+	TC_PRINT("%s window %u: %lld ms\n", url, window, duration);
+}
+
+ZTEST(downloader_coap_window, test_windowed_blocks)
+{
+	download(SERVER_URL, 1);
+	download(SERVER_URL, WINDOW);
+}
+
+ZTEST(downloader_coap_window, test_windowed_blocks_lossy)
+{
+	/* Lost blocks are requested again, and the blocks that follow them are reordered */
+	download(SERVER_URL_LOSSY, WINDOW);
+}
+
+ZTEST_SUITE(downloader_coap_window, NULL, NULL, NULL, NULL, NULL);
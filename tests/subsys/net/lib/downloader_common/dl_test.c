@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "dl_test.h"
+
+static struct downloader dl;
+static size_t received;
+static bool data_ok;
+static int dl_err;
+
+static K_SEM_DEFINE(dl_done, 0, 1);
+static K_SEM_DEFINE(dl_deinitialized, 0, 1);
+
+static int dl_callback(const struct downloader_evt *event)
+{
+	const uint8_t *data;
+
+	switch (event->id) {
+	case DOWNLOADER_EVT_FRAGMENT:
+		data = event->fragment.buf;
+		for (size_t i = 0; i < event->fragment.len; i++) {
+			if (data[i] != dl_test_file_byte(received + i)) {
+				data_ok = false;
+			}
+		}
+		received += event->fragment.len;
+		break;
+	case DOWNLOADER_EVT_ERROR:
+		dl_err = event->error;
+		k_sem_give(&dl_done);
+		/* Stop the download */
+		return 1;
+	case DOWNLOADER_EVT_DONE:
+		k_sem_give(&dl_done);
+		break;
+	case DOWNLOADER_EVT_DEINITIALIZED:
+		k_sem_give(&dl_deinitialized);
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+static struct downloader_cfg dl_cfg = {
+	.callback = dl_callback,
+};
+
+struct downloader *dl_test_init(char *buf, size_t buf_size)
+{
+	received = 0;
+	data_ok = true;
+	dl_err = 0;
+
+	dl_cfg.buf = buf;
+	dl_cfg.buf_size = buf_size;
+
+	zassert_ok(downloader_init(&dl, &dl_cfg));
+
+	return &dl;
+}
+
+int64_t dl_test_download(struct downloader_host_cfg *host_cfg, const char *url,
+			 size_t file_size, k_timeout_t timeout)
+{
+	int64_t start;
+	int64_t duration;
+	size_t size;
+
+	start = k_uptime_get();
+	zassert_ok(downloader_get(&dl, host_cfg, url, 0));
+	zassert_ok(k_sem_take(&dl_done, timeout), "Download timed out");
+	duration = k_uptime_get() - start;
+
+	zassert_ok(dl_err, "Download failed");
+	zassert_ok(downloader_file_size_get(&dl, &size));
+	zassert_equal(size, file_size);
+	zassert_equal(received, file_size);
+	zassert_true(data_ok, "Unexpected data");
+
+	zassert_ok(downloader_deinit(&dl));
+	zassert_ok(k_sem_take(&dl_deinitialized, K_SECONDS(5)));
+
+	return duration;
+}
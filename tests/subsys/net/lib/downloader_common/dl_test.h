@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DL_TEST_H_
+#define DL_TEST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <net/downloader.h>
+
+/* Downloads from the test servers under pytest/, which serve files with the pattern
+ * of dl_test_file_byte().
+ */
+
+/* Byte at position pos of the files generated by the test servers */
+static inline uint8_t dl_test_file_byte(size_t pos)
+{
+	return (pos * 7 + pos / 251) & 0xff;
+}
+
+/* Initialize the downloader instance of the test, for the transport to be configured
+ * before dl_test_download().
+ */
+struct downloader *dl_test_init(char *buf, size_t buf_size);
+
+/* Download url, check the file size and content, and deinitialize the downloader.
+ * Returns the download time in milliseconds.
+ */
+int64_t dl_test_download(struct downloader_host_cfg *host_cfg, const char *url,
+			 size_t file_size, k_timeout_t timeout);
+
+#endif /* DL_TEST_H_ */
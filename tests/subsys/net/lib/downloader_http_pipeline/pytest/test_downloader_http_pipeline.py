@@ -0,0 +1,113 @@
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+import asyncio
+import logging
+import re
+import threading
+import time
+
+import pytest
+from twister_harness import DeviceAdapter
+
+logger = logging.getLogger(__name__)
+
+# Must match SERVER_URL and FILE_SIZE in src/main.c
+SERVER_PORT = 18080
+FILE_PATH = '/pipeline.bin'
+FILE_SIZE = 32 * 1024
+# Must match PIPELINE_DEPTH in src/main.c
+PIPELINE_DEPTH = 4
+# Emulated round trip time, each response is sent this long after its request arrived
+RTT = 0.1
+
+FILE_DATA = bytes(((i * 7 + i // 251) & 0xff) for i in range(FILE_SIZE))
+RANGE_RE = re.compile(r'^range:\s*bytes=(\d+)-(\d*)\s*$', re.IGNORECASE | re.MULTILINE)
+
+
+def http_response(head: str) -> bytes:
+    request_line = head.split('\r\n', 1)[0]
+    method, path, _ = request_line.split(' ', 2)
+    if method != 'GET' or path != FILE_PATH:
+        return b'HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n'
+
+    match = RANGE_RE.search(head)
+    if not match:
+        return (f'HTTP/1.1 200 OK\r\nContent-Length: {FILE_SIZE}\r\n'
+                'Connection: keep-alive\r\n\r\n').encode() + FILE_DATA
+
+    first = int(match[1])
+    last = min(int(match[2]) if match[2] else FILE_SIZE - 1, FILE_SIZE - 1)
+    return (f'HTTP/1.1 206 Partial Content\r\nContent-Length: {last - first + 1}\r\n'
+            f'Content-Range: bytes {first}-{last}/{FILE_SIZE}\r\n'
+            'Connection: keep-alive\r\n\r\n').encode() + FILE_DATA[first:last + 1]
+
+
+# Largest number of requests received and not yet answered, for each connection
+max_in_flight = []
+
+
+async def handle_connection(reader, writer):
+    """Answer pipelined requests in order, each one RTT after it was received."""
+    responses = asyncio.Queue()
+    conn = len(max_in_flight)
+    in_flight = 0
+    max_in_flight.append(0)
+
+    async def send_responses():
+        nonlocal in_flight
+        while True:
+            due, response = await responses.get()
+            if response is None:
+                break
+            await asyncio.sleep(max(0, due - time.monotonic()))
+            try:
+                writer.write(response)
+                await writer.drain()
+            except ConnectionError:
+                break
+            in_flight -= 1
+
+    sender = asyncio.create_task(send_responses())
+    try:
+        while True:
+            head = await reader.readuntil(b'\r\n\r\n')
+            in_flight += 1
+            max_in_flight[conn] = max(max_in_flight[conn], in_flight)
+            await responses.put((time.monotonic() + RTT, http_response(head.decode())))
+    except (asyncio.IncompleteReadError, ConnectionError):
+        pass
+    finally:
+        await responses.put((0, None))
+        await sender
+        writer.close()
+
+
+@pytest.fixture(scope='module')
+def http_server():
+    loop = asyncio.new_event_loop()
+    server = loop.run_until_complete(
+        asyncio.start_server(handle_connection, '127.0.0.1', SERVER_PORT))
+    thread = threading.Thread(target=loop.run_forever, daemon=True)
+    thread.start()
+    yield server
+    loop.call_soon_threadsafe(server.close)
+    loop.call_soon_threadsafe(loop.stop)
+    thread.join()
+
+
+def test_downloader_http_pipeline(http_server, dut: DeviceAdapter):
+    lines = dut.readlines_until(regex='PROJECT EXECUTION SUCCESSFUL', timeout=60)
+
+    for line in lines:
+        if 'pipeline depth' in line:
+            logger.info(line)
+
+    logger.info('Requests in flight per connection: %s', max_in_flight)
+    # The sequential download waits for each response, the pipelined one does not wait
+    # for more than the configured depth.
+    assert min(max_in_flight) == 1
+    assert 1 < max(max_in_flight) <= PIPELINE_DEPTH
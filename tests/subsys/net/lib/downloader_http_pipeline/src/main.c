@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <net/downloader.h>
+#include <net/downloader_transport_http.h>
+
+#include "dl_test.h"
+
+/* Served by pytest/test_downloader_http_pipeline.py, which delays each response by the
+ * emulated round trip time and checks how many requests are in flight.
+ */
+#define SERVER_URL "http://127.0.0.1:18080/pipeline.bin"
+#define FILE_SIZE (32 * 1024)
+#define RANGE_SIZE 1024
+#define PIPELINE_DEPTH 4
+
+static char dl_buf[2048];
+static struct downloader_host_cfg dl_host_cfg = {
+	.range_override = RANGE_SIZE,
+};
+
+static void download(uint8_t pipeline_depth)
+{
+	struct downloader_transport_http_cfg http_cfg = {
+		.sock_recv_timeo_ms = 10 * MSEC_PER_SEC,
+		.pipeline_depth = pipeline_depth,
+	};
+	struct downloader *dl;
+	int64_t duration;
+
+	dl = dl_test_init(dl_buf, sizeof(dl_buf));
+	zassert_ok(downloader_transport_http_set_config(dl, &http_cfg));
+
+	duration = dl_test_download(&dl_host_cfg, SERVER_URL, FILE_SIZE, K_SECONDS(30));
+
+	/* Informational only, the requests in flight are checked by the test server */
+	TC_PRINT("pipeline depth %u: %u ranges in %lld ms\n", pipeline_depth,
+		 FILE_SIZE / RANGE_SIZE, duration);
+}
+
+ZTEST(downloader_http_pipeline, test_pipelined_ranges)
+{
+	download(1);
+	download(PIPELINE_DEPTH);
+}
+
+ZTEST_SUITE(downloader_http_pipeline, NULL, NULL, NULL, NULL, NULL);
@@ -18,7 +18,7 @@
  *   - nrf_cloud_agnss_type_array_get  (called in coap_codec_agnss_encode)
  *   - nrf_cloud_calloc / nrf_cloud_free / nrf_cloud_malloc  (link-time deps)
  *
- * The remaining symbols (nrf_cloud_encode_message, nrf_cloud_error_msg_decode,
+ * The remaining symbols (nrf_cloud_encode_message_buf, nrf_cloud_error_msg_decode,
  * nrf_cloud_coap_fota_execution_decode) are only reachable via JSON paths that
  * the CBOR tests do not exercise; they are stubbed out with safe no-op or
  * error-returning implementations so that the linker is satisfied.
@@ -64,15 +64,16 @@ void nrf_cloud_free(void *ptr)
  * -------------------------------------------------------------------------
  */
 
-int nrf_cloud_encode_message(const char *app_id, double value, const char *str_val,
-			     const char *topic, int64_t ts, struct nrf_cloud_data *output)
+int nrf_cloud_encode_message_buf(const char *app_id, double value, const char *str_val,
+				 const char *topic, int64_t ts, char *const buf, size_t *const len)
 {
 	ARG_UNUSED(app_id);
 	ARG_UNUSED(value);
 	ARG_UNUSED(str_val);
 	ARG_UNUSED(topic);
 	ARG_UNUSED(ts);
-	ARG_UNUSED(output);
+	ARG_UNUSED(buf);
+	*len = 0;
 	return -ENOTSUP;
 }
 
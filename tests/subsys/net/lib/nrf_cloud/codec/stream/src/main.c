@@ -0,0 +1,764 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Tests and benchmark for the streaming JSON codec of the nRF Cloud library.
+ *
+ * Representative messages are encoded by the library functions that use the streaming
+ * writer, and by building a cJSON tree and printing it, as the library did before. The
+ * outputs must be identical. Shadow deltas and disconnection requests are decoded by the
+ * library functions that use the streaming reader, and with cJSON. Documents added to the
+ * writer are compared with documents parsed and printed by cJSON. The number of
+ * allocations, the peak heap usage and the time per message are printed for both.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_defs.h>
+#include <cJSON.h>
+#include <test_benchmark.h>
+
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_json_stream.h"
+#include "nrf_cloud_mem.h"
+
+#define ITERATIONS 1000
+#define MSG_BUF_SIZE 512
+
+#define MSG_APP_ID "TEMP"
+#define MSG_TOPIC "d/nrf-test/d2c"
+#define MSG_TS 1700000000123LL
+#define MSG_VALUE 23.5
+#define MSG_STR_VALUE "open \"door\""
+
+/* Allocation header, keeps the alignment of malloc() */
+#define ALLOC_HDR_SIZE 16
+
+static size_t alloc_count;
+static size_t heap_used;
+static size_t heap_peak;
+
+static void *counting_malloc(size_t size)
+{
+	uint8_t *p = malloc(ALLOC_HDR_SIZE + size);
+
+	if (!p) {
+		return NULL;
+	}
+
+	memcpy(p, &size, sizeof(size));
+	alloc_count++;
+	heap_used += size;
+	heap_peak = MAX(heap_peak, heap_used);
+
+	return p + ALLOC_HDR_SIZE;
+}
+
+static void counting_free(void *ptr)
+{
+	uint8_t *p = ptr;
+	size_t size;
+
+	if (!p) {
+		return;
+	}
+
+	p -= ALLOC_HDR_SIZE;
+	memcpy(&size, p, sizeof(size));
+	heap_used -= size;
+	free(p);
+}
+
+static void heap_stats_reset(void)
+{
+	alloc_count = 0;
+	heap_used = 0;
+	heap_peak = 0;
+}
+
+/* Memory wrappers of the library (nrf_cloud_mem.c), counted like the cJSON allocations */
+void *nrf_cloud_malloc(size_t size)
+{
+	return counting_malloc(size);
+}
+
+void *nrf_cloud_calloc(size_t count, size_t size)
+{
+	void *p = counting_malloc(count * size);
+
+	if (p) {
+		memset(p, 0, count * size);
+	}
+
+	return p;
+}
+
+void nrf_cloud_free(void *ptr)
+{
+	counting_free(ptr);
+}
+
+/* Sensor type names of the library (nrf_cloud_codec_internal.c) */
+const char *nrf_cloud_get_sensor_type_str_internal(enum nrf_cloud_sensor type)
+{
+	return (type == NRF_CLOUD_SENSOR_TEMP) ? NRF_CLOUD_JSON_APPID_VAL_TEMP : NULL;
+}
+
+/* Device message, as encoded by nrf_cloud_encode_message() */
+static char *msg_cjson(const char *topic, const char *str_val)
+{
+	cJSON *root = cJSON_CreateObject();
+	cJSON *msg;
+	char *out;
+
+	if (topic) {
+		cJSON_AddStringToObject(root, NRF_CLOUD_TOPIC_KEY, topic);
+	}
+
+	msg = cJSON_AddObjectToObject(root, NRF_CLOUD_MSG_KEY);
+	cJSON_AddStringToObject(msg, NRF_CLOUD_JSON_APPID_KEY, MSG_APP_ID);
+	cJSON_AddStringToObject(msg, NRF_CLOUD_JSON_MSG_TYPE_KEY,
+				NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	cJSON_AddNumberToObject(msg, NRF_CLOUD_MSG_TIMESTAMP_KEY, MSG_TS);
+	if (str_val) {
+		cJSON_AddStringToObject(msg, NRF_CLOUD_JSON_DATA_KEY, str_val);
+	} else {
+		cJSON_AddNumberToObject(msg, NRF_CLOUD_JSON_DATA_KEY, MSG_VALUE);
+	}
+
+	out = cJSON_PrintUnformatted(root);
+	cJSON_Delete(root);
+
+	return out;
+}
+
+static char *sensor_cjson(void)
+{
+	return msg_cjson(NULL, NULL);
+}
+
+static int sensor_stream(char *const buf, size_t *const len)
+{
+	return nrf_cloud_encode_message_buf(MSG_APP_ID, MSG_VALUE, NULL, NULL, MSG_TS, buf, len);
+}
+
+static char *topic_str_cjson(void)
+{
+	return msg_cjson(MSG_TOPIC, MSG_STR_VALUE);
+}
+
+static int topic_str_stream(char *const buf, size_t *const len)
+{
+	return nrf_cloud_encode_message_buf(MSG_APP_ID, 0, MSG_STR_VALUE, MSG_TOPIC, MSG_TS,
+					    buf, len);
+}
+
+/* Shadow control response, as encoded over MQTT before the streaming writer.
+ * Memfault is not enabled in this test, so the control sections are empty.
+ */
+static char *ctrl_cjson(bool accept)
+{
+	cJSON *root = cJSON_CreateObject();
+	cJSON *state = cJSON_AddObjectToObject(root, NRF_CLOUD_JSON_KEY_STATE);
+	char *out;
+
+	if (!accept) {
+		cJSON_AddObjectToObject(cJSON_AddObjectToObject(state, NRF_CLOUD_JSON_KEY_DES),
+					NRF_CLOUD_JSON_KEY_CTRL);
+	}
+	cJSON_AddObjectToObject(cJSON_AddObjectToObject(state, NRF_CLOUD_JSON_KEY_REP),
+				NRF_CLOUD_JSON_KEY_CTRL);
+
+	out = cJSON_PrintUnformatted(root);
+	cJSON_Delete(root);
+
+	return out;
+}
+
+static int ctrl_stream(bool accept, char *const buf, size_t *const len)
+{
+	struct nrf_cloud_ctrl_data ctrl = {0};
+	struct nrf_cloud_data out;
+	int err;
+
+	err = nrf_cloud_shadow_control_response_encode(&ctrl, accept, &out);
+	if (err) {
+		return err;
+	}
+
+	if (out.len >= *len) {
+		nrf_cloud_free((void *)out.ptr);
+		return -E2BIG;
+	}
+
+	memcpy(buf, out.ptr, out.len + 1);
+	*len = out.len;
+	nrf_cloud_free((void *)out.ptr);
+
+	return 0;
+}
+
+static char *ctrl_accept_cjson(void)
+{
+	return ctrl_cjson(true);
+}
+
+static int ctrl_accept_stream(char *const buf, size_t *const len)
+{
+	return ctrl_stream(true, buf, len);
+}
+
+static char *ctrl_reject_cjson(void)
+{
+	return ctrl_cjson(false);
+}
+
+static int ctrl_reject_stream(char *const buf, size_t *const len)
+{
+	return ctrl_stream(false, buf, len);
+}
+
+/* Sensor data as an application passes it, with whitespace that the encoders remove */
+static const char shadow_sensor_doc[] =
+	"{ \"temp\": 21.25, \"unit\": \"C\",\n \"limits\": [ -40, 85 ], \"alarm\": false }";
+
+/* Shadow update with sensor data, as encoded before the streaming writer */
+static char *shadow_data_cjson(void)
+{
+	cJSON *root = cJSON_CreateObject();
+	cJSON *state = cJSON_AddObjectToObject(root, NRF_CLOUD_JSON_KEY_STATE);
+	cJSON *reported = cJSON_AddObjectToObject(state, NRF_CLOUD_JSON_KEY_REP);
+	char *out;
+
+	cJSON_AddItemToObject(reported, NRF_CLOUD_JSON_APPID_VAL_TEMP,
+			      cJSON_ParseWithLength(shadow_sensor_doc,
+						    sizeof(shadow_sensor_doc) - 1));
+
+	out = cJSON_PrintUnformatted(root);
+	cJSON_Delete(root);
+
+	return out;
+}
+
+static int shadow_data_stream(char *const buf, size_t *const len)
+{
+	const struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_TEMP,
+		.data.ptr = shadow_sensor_doc,
+		.data.len = sizeof(shadow_sensor_doc) - 1,
+	};
+	struct nrf_cloud_data out;
+	int err;
+
+	err = nrf_cloud_shadow_data_encode(&sensor, &out);
+	if (err) {
+		return err;
+	}
+
+	if (out.len >= *len) {
+		nrf_cloud_free((void *)out.ptr);
+		return -E2BIG;
+	}
+
+	memcpy(buf, out.ptr, out.len + 1);
+	*len = out.len;
+	nrf_cloud_free((void *)out.ptr);
+
+	return 0;
+}
+
+static const struct {
+	const char *name;
+	char *(*cjson)(void);
+	int (*stream)(char *const buf, size_t *const len);
+} messages[] = {
+	{ "sensor", sensor_cjson, sensor_stream },
+	{ "topic_str", topic_str_cjson, topic_str_stream },
+	{ "ctrl_accept", ctrl_accept_cjson, ctrl_accept_stream },
+	{ "ctrl_reject", ctrl_reject_cjson, ctrl_reject_stream },
+	{ "shadow_data", shadow_data_cjson, shadow_data_stream },
+};
+
+/* Shadow delta, with the metadata that nRF Cloud sends along with the state */
+static const char delta_doc[] =
+	"{\"version\":37,\"timestamp\":1700000000,"
+	"\"state\":{\"control\":{\"memfaultEn\":true},\"config\":{\"interval\":60,\"mode\":\"lp\"}},"
+	"\"metadata\":{\"control\":{\"memfaultEn\":{\"timestamp\":1700000000}},"
+	"\"config\":{\"interval\":{\"timestamp\":1700000000},"
+	"\"mode\":{\"timestamp\":1700000000}}}}";
+
+static const char discon_doc[] = "{\"appId\":\"DEVICE\",\"messageType\":\"DISCON\"}";
+
+struct result {
+	size_t allocs;
+	size_t peak;
+	uint64_t ns;
+};
+
+static void result_print(const char *name, const char *codec, const struct result *res)
+{
+	TC_PRINT("%-12s %-7s %7zu %9zu %9llu\n", name, codec, res->allocs, res->peak,
+		 (unsigned long long)(res->ns / ITERATIONS));
+}
+
+static void table_header_print(void)
+{
+	TC_PRINT("%-12s %-7s %7s %9s %9s\n", "message", "codec", "allocs", "peak [B]",
+		 "ns/msg");
+}
+
+static void *stream_setup(void)
+{
+	cJSON_Hooks hooks = {
+		.malloc_fn = counting_malloc,
+		.free_fn = counting_free,
+	};
+
+	cJSON_InitHooks(&hooks);
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_json_stream, NULL, stream_setup, NULL, NULL, NULL);
+
+ZTEST(nrf_cloud_json_stream, test_encode_benchmark)
+{
+	static char buf[MSG_BUF_SIZE];
+	struct result cjson;
+	struct result stream;
+	uint64_t start;
+	size_t len;
+	char *out;
+
+	table_header_print();
+
+	for (size_t m = 0; m < ARRAY_SIZE(messages); m++) {
+		/* Allocations of one message */
+		heap_stats_reset();
+		out = messages[m].cjson();
+		zassert_not_null(out);
+		cjson.allocs = alloc_count;
+		cjson.peak = heap_peak;
+
+		heap_stats_reset();
+		len = sizeof(buf);
+		zassert_ok(messages[m].stream(buf, &len), "%s: encoding failed", messages[m].name);
+		stream.allocs = alloc_count;
+		stream.peak = heap_peak;
+
+		zassert_equal(len, strlen(out), "%s: length differs", messages[m].name);
+		zassert_mem_equal(buf, out, len + 1, "%s: %s != %s", messages[m].name, buf, out);
+		zassert_true(stream.allocs < cjson.allocs, "%s: %zu allocations",
+			     messages[m].name, stream.allocs);
+		zassert_true(stream.peak < cjson.peak, "%s: peak heap usage %zu B",
+			     messages[m].name, stream.peak);
+		zassert_equal(heap_used, 0, "%s: memory leaked", messages[m].name);
+		cJSON_free(out);
+
+		start = test_benchmark_time_ns();
+		for (int i = 0; i < ITERATIONS; i++) {
+			cJSON_free(messages[m].cjson());
+		}
+		cjson.ns = test_benchmark_time_ns() - start;
+
+		start = test_benchmark_time_ns();
+		for (int i = 0; i < ITERATIONS; i++) {
+			len = sizeof(buf);
+			(void)messages[m].stream(buf, &len);
+		}
+		stream.ns = test_benchmark_time_ns() - start;
+
+		result_print(messages[m].name, "cJSON", &cjson);
+		result_print(messages[m].name, "stream", &stream);
+	}
+}
+
+ZTEST(nrf_cloud_json_stream, test_encode_message_buf_too_small)
+{
+	char buf[16];
+	size_t len = sizeof(buf);
+
+	zassert_equal(sensor_stream(buf, &len), -E2BIG);
+	zassert_equal(len, 0);
+}
+
+/* Decode a delta the way nrf_cloud_obj_shadow_delta_decode() does */
+static cJSON *delta_cjson(int *ver, int64_t *ts)
+{
+	cJSON *root = cJSON_Parse(delta_doc);
+	cJSON *state;
+
+	*ver = cJSON_GetNumberValue(cJSON_GetObjectItem(root, NRF_CLOUD_JSON_KEY_SHADOW_VERSION));
+	*ts = cJSON_GetNumberValue(cJSON_GetObjectItem(root, NRF_CLOUD_JSON_KEY_SHADOW_TIMESTAMP));
+	state = cJSON_DetachItemFromObject(root, NRF_CLOUD_JSON_KEY_STATE);
+	cJSON_Delete(root);
+
+	return state;
+}
+
+static int delta_stream(const char *doc, size_t len, struct nrf_cloud_obj_shadow_delta *delta)
+{
+	const struct nrf_cloud_data input = {
+		.ptr = doc,
+		.len = len,
+	};
+
+	return nrf_cloud_shadow_delta_stream_decode(&input, delta);
+}
+
+/* Check a disconnection request the way nrf_cloud_disconnection_request_decode() did */
+static bool discon_cjson(void)
+{
+	cJSON *root = cJSON_Parse(discon_doc);
+	cJSON *app_id = cJSON_GetObjectItem(root, NRF_CLOUD_JSON_APPID_KEY);
+	cJSON *msg_type = cJSON_GetObjectItem(root, NRF_CLOUD_JSON_MSG_TYPE_KEY);
+	bool ret = cJSON_IsString(app_id) && cJSON_IsString(msg_type) &&
+		   !strcmp(app_id->valuestring, NRF_CLOUD_JSON_APPID_VAL_DEVICE) &&
+		   !strcmp(msg_type->valuestring, NRF_CLOUD_JSON_MSG_TYPE_VAL_DISCONNECT);
+
+	cJSON_Delete(root);
+
+	return ret;
+}
+
+ZTEST(nrf_cloud_json_stream, test_decode_benchmark)
+{
+	struct nrf_cloud_obj_shadow_delta delta;
+	struct result cjson;
+	struct result stream;
+	cJSON *state_cjson;
+	uint64_t start;
+	int ver;
+	int64_t ts;
+
+	table_header_print();
+
+	heap_stats_reset();
+	state_cjson = delta_cjson(&ver, &ts);
+	cjson.allocs = alloc_count;
+	cjson.peak = heap_peak;
+
+	heap_stats_reset();
+	zassert_ok(delta_stream(delta_doc, sizeof(delta_doc) - 1, &delta));
+	stream.allocs = alloc_count;
+	stream.peak = heap_peak;
+
+	zassert_not_null(state_cjson);
+	zassert_equal(ver, 37);
+	zassert_equal(ts, 1700000000);
+	zassert_equal(delta.ver, ver);
+	zassert_equal(delta.ts, ts);
+	zassert_false(delta.is_err);
+	zassert_equal(delta.state.type, NRF_CLOUD_OBJ_TYPE_JSON);
+	zassert_true(cJSON_Compare(state_cjson, delta.state.json, true));
+	zassert_true(stream.allocs < cjson.allocs);
+	zassert_true(stream.peak < cjson.peak);
+	cJSON_Delete(state_cjson);
+	cJSON_Delete(delta.state.json);
+
+	start = test_benchmark_time_ns();
+	for (int i = 0; i < ITERATIONS; i++) {
+		cJSON_Delete(delta_cjson(&ver, &ts));
+	}
+	cjson.ns = test_benchmark_time_ns() - start;
+
+	start = test_benchmark_time_ns();
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)delta_stream(delta_doc, sizeof(delta_doc) - 1, &delta);
+		cJSON_Delete(delta.state.json);
+	}
+	stream.ns = test_benchmark_time_ns() - start;
+
+	result_print("delta", "cJSON", &cjson);
+	result_print("delta", "stream", &stream);
+
+	heap_stats_reset();
+	zassert_true(discon_cjson());
+	cjson.allocs = alloc_count;
+	cjson.peak = heap_peak;
+
+	heap_stats_reset();
+	zassert_true(nrf_cloud_disconnection_request_decode(discon_doc));
+	stream.allocs = alloc_count;
+	stream.peak = heap_peak;
+	zassert_equal(stream.allocs, 0);
+
+	start = test_benchmark_time_ns();
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)discon_cjson();
+	}
+	cjson.ns = test_benchmark_time_ns() - start;
+
+	start = test_benchmark_time_ns();
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)nrf_cloud_disconnection_request_decode(discon_doc);
+	}
+	stream.ns = test_benchmark_time_ns() - start;
+
+	result_print("discon", "cJSON", &cjson);
+	result_print("discon", "stream", &stream);
+}
+
+ZTEST(nrf_cloud_json_stream, test_delta_stream_decode_errors)
+{
+	static const char err_doc[] =
+		"{\"version\":5,\"timestamp\":1700000000,\"err\":40001,\"errMsg\":\"bad\"}";
+	static const char no_state_doc[] = "{\"version\":5,\"timestamp\":1700000000}";
+	static const char bad_state_doc[] = "{\"version\":5,\"state\":[1,2]}";
+	struct nrf_cloud_obj_shadow_delta delta;
+
+	zassert_equal(nrf_cloud_shadow_delta_stream_decode(NULL, &delta), -EINVAL);
+
+	/* The error is decoded from the whole document by nrf_cloud_obj_shadow_delta_decode() */
+	zassert_equal(delta_stream(err_doc, sizeof(err_doc) - 1, &delta), -ENOTSUP);
+	zassert_equal(delta_stream(delta_doc, 40, &delta), -ENOMSG);
+	zassert_equal(delta_stream(no_state_doc, sizeof(no_state_doc) - 1, &delta), -ENODEV);
+	zassert_equal(delta_stream(bad_state_doc, sizeof(bad_state_doc) - 1, &delta), -ENODEV);
+	zassert_is_null(delta.state.json);
+}
+
+ZTEST(nrf_cloud_json_stream, test_disconnection_request_decode)
+{
+	zassert_true(nrf_cloud_disconnection_request_decode(
+		"{\"messageType\":\"DISCON\",\"appId\":\"DEVICE\",\"data\":{}}"));
+	zassert_false(nrf_cloud_disconnection_request_decode(NULL));
+	zassert_false(nrf_cloud_disconnection_request_decode(
+		"{\"appId\":\"DEVICE\",\"messageType\":\"DATA\",\"data\":\"DISCON\"}"));
+	zassert_false(nrf_cloud_disconnection_request_decode(
+		"{\"appId\":\"TEMP\",\"messageType\":\"DISCON\",\"data\":\"DEVICE\"}"));
+	zassert_false(nrf_cloud_disconnection_request_decode(
+		"{\"data\":{\"appId\":\"DEVICE\",\"messageType\":\"DISCON\"}}"));
+}
+
+/* Numbers and strings are printed the same way as cJSON prints them */
+ZTEST(nrf_cloud_json_stream, test_writer_matches_cjson)
+{
+	static const double nums[] = { 0, 1, -1, 0.1, 1.0 / 3, 1e-7, 123456.789, 2147483647,
+				       -2147483648.0, 3e9, 1700000000123LL, 1e300, -2.5e-300 };
+	static const char *const strs[] = { "", "plain", "quote\"back\\slash",
+					    "ctrl\b\f\n\r\t\x01\x1f", "utf8 \xc3\xa6\xc3\xb8" };
+	char buf[MSG_BUF_SIZE];
+	struct nrf_cloud_json_writer w;
+	cJSON *root = cJSON_CreateArray();
+	char *out;
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_arr_start(&w, NULL);
+
+	for (size_t i = 0; i < ARRAY_SIZE(nums); i++) {
+		cJSON_AddItemToArray(root, cJSON_CreateNumber(nums[i]));
+		nrf_cloud_json_num_add(&w, NULL, nums[i]);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(strs); i++) {
+		cJSON_AddItemToArray(root, cJSON_CreateString(strs[i]));
+		nrf_cloud_json_str_add(&w, NULL, strs[i]);
+	}
+
+	nrf_cloud_json_arr_end(&w);
+	zassert_true(nrf_cloud_json_writer_finish(&w) > 0);
+
+	out = cJSON_PrintUnformatted(root);
+	zassert_str_equal(buf, out);
+
+	cJSON_free(out);
+	cJSON_Delete(root);
+
+	/* Printed as null by cJSON, not passed to it because it converts them to int first */
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_arr_start(&w, NULL);
+	nrf_cloud_json_num_add(&w, NULL, NAN);
+	nrf_cloud_json_num_add(&w, NULL, INFINITY);
+	nrf_cloud_json_num_add(&w, NULL, -INFINITY);
+	nrf_cloud_json_arr_end(&w);
+	zassert_true(nrf_cloud_json_writer_finish(&w) > 0);
+	zassert_str_equal(buf, "[null,null,null]");
+}
+
+static void writer_msg_write(struct nrf_cloud_json_writer *w)
+{
+	nrf_cloud_json_obj_start(w, NULL);
+	nrf_cloud_json_str_add(w, NRF_CLOUD_JSON_APPID_KEY, MSG_APP_ID);
+	nrf_cloud_json_num_add(w, NRF_CLOUD_JSON_DATA_KEY, MSG_VALUE);
+	nrf_cloud_json_obj_end(w);
+}
+
+ZTEST(nrf_cloud_json_stream, test_writer_measure_and_too_small)
+{
+	char buf[16];
+	struct nrf_cloud_json_writer w;
+	int len;
+
+	nrf_cloud_json_writer_init(&w, NULL, 0);
+	writer_msg_write(&w);
+	len = nrf_cloud_json_writer_finish(&w);
+	zassert_true(len > sizeof(buf));
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	writer_msg_write(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -E2BIG);
+	zassert_equal(w.len, len);
+
+	/* The null terminator must fit as well */
+	nrf_cloud_json_writer_init(&w, buf, 2);
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_obj_end(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -E2BIG);
+}
+
+ZTEST(nrf_cloud_json_stream, test_writer_invalid_use)
+{
+	char buf[32];
+	struct nrf_cloud_json_writer w;
+
+	/* Object member without a key */
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_num_add(&w, NULL, 1);
+	nrf_cloud_json_obj_end(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	/* Array item with a key */
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_arr_start(&w, NULL);
+	nrf_cloud_json_num_add(&w, "key", 1);
+	nrf_cloud_json_arr_end(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	/* Mismatched end */
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	nrf_cloud_json_arr_end(&w);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	/* Unterminated object */
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_obj_start(&w, NULL);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	/* Two root values */
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_null_add(&w, NULL);
+	nrf_cloud_json_null_add(&w, NULL);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+
+	/* Nothing written */
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+}
+
+/* Documents are written the same way as cJSON prints them after parsing them */
+ZTEST(nrf_cloud_json_stream, test_writer_doc_add)
+{
+	static const char *const docs[] = {
+		" { \"a\" : [ 1 , 2.50, -0, 1e2 , { } , [ ] ] , \"b\" : { \"c\" : null } } ",
+		"[true,false,null,\"\\u00e6\\ud83d\\ude00\\/\\\"\\t\\u0001\"]",
+		"\"end\\u0000ed\"",
+		"3.141592653589793 trailing",
+		"{\"\\u0041\\n\":0.1}",
+	};
+	static const char *const bad_docs[] = {
+		"", "{", "[1,]", "{\"a\"}", "{\"a\":1,}", "{1:2}", "nul", "\"\\x\"",
+		"\"\\ud83d\"", "-", "[[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]]",
+	};
+	char buf[MSG_BUF_SIZE];
+	struct nrf_cloud_json_writer w;
+	cJSON *parsed;
+	char *out;
+
+	for (size_t i = 0; i < ARRAY_SIZE(docs); i++) {
+		nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+		nrf_cloud_json_obj_start(&w, NULL);
+		nrf_cloud_json_doc_add(&w, "doc", docs[i], strlen(docs[i]));
+		nrf_cloud_json_obj_end(&w);
+		zassert_true(nrf_cloud_json_writer_finish(&w) > 0, "%s", docs[i]);
+
+		parsed = cJSON_CreateObject();
+		cJSON_AddItemToObject(parsed, "doc", cJSON_ParseWithLength(docs[i],
+									  strlen(docs[i])));
+		out = cJSON_PrintUnformatted(parsed);
+		zassert_str_equal(buf, out);
+
+		cJSON_free(out);
+		cJSON_Delete(parsed);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(bad_docs); i++) {
+		nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+		nrf_cloud_json_doc_add(&w, NULL, bad_docs[i], strlen(bad_docs[i]));
+		zassert_equal(nrf_cloud_json_writer_finish(&w), -EBADMSG, "%s", bad_docs[i]);
+	}
+
+	nrf_cloud_json_writer_init(&w, buf, sizeof(buf));
+	nrf_cloud_json_doc_add(&w, NULL, NULL, 0);
+	zassert_equal(nrf_cloud_json_writer_finish(&w), -EINVAL);
+}
+
+ZTEST(nrf_cloud_json_stream, test_shadow_data_encode_invalid)
+{
+	const struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_TEMP,
+		.data.ptr = "{\"temp\":",
+		.data.len = 8,
+	};
+	struct nrf_cloud_data out;
+
+	/* Found while measuring the output, before anything is allocated */
+	heap_stats_reset();
+	zassert_equal(nrf_cloud_shadow_data_encode(&sensor, &out), -EBADMSG);
+	zassert_equal(alloc_count, 0);
+}
+
+ZTEST(nrf_cloud_json_stream, test_reader)
+{
+	static const char doc[] =
+		" { \"a\" : { \"skip\" : [ 1, { \"x\" : \"}]\" } ], \"b\" : false } ,"
+		"\"s\":\"q\\\"\\\\\\n\\u00e6\\ud83d\\ude00\", \"n\": -1.5e3, \"z\": null }";
+	static const char *const path_b[] = { "a", "b" };
+	static const char *const path_s[] = { "s" };
+	static const char *const path_n[] = { "n" };
+	static const char *const path_z[] = { "z" };
+	static const char *const path_missing[] = { "a", "missing" };
+	static const char *const path_not_obj[] = { "n", "x" };
+	struct nrf_cloud_json_value val;
+	double num;
+	bool b = true;
+	char str[16];
+
+	zassert_ok(nrf_cloud_json_value_find(doc, sizeof(doc) - 1, path_b, 2, &val));
+	zassert_ok(nrf_cloud_json_value_bool_get(&val, &b));
+	zassert_false(b);
+
+	zassert_ok(nrf_cloud_json_value_find(doc, sizeof(doc) - 1, path_s, 1, &val));
+	zassert_ok(nrf_cloud_json_value_str_get(&val, str, sizeof(str)));
+	zassert_str_equal(str, "q\"\\\n\xc3\xa6\xf0\x9f\x98\x80");
+	zassert_equal(nrf_cloud_json_value_str_get(&val, str, 4), -E2BIG);
+	zassert_equal(nrf_cloud_json_value_num_get(&val, &num), -ENOMSG);
+
+	zassert_ok(nrf_cloud_json_value_find(doc, sizeof(doc) - 1, path_n, 1, &val));
+	zassert_ok(nrf_cloud_json_value_num_get(&val, &num));
+	zassert_equal(num, -1500);
+
+	zassert_ok(nrf_cloud_json_value_find(doc, sizeof(doc) - 1, path_z, 1, &val));
+	zassert_equal(val.type, NRF_CLOUD_JSON_TYPE_NULL);
+
+	zassert_ok(nrf_cloud_json_value_find(doc, sizeof(doc) - 1, NULL, 0, &val));
+	zassert_equal(val.type, NRF_CLOUD_JSON_TYPE_OBJECT);
+
+	zassert_equal(nrf_cloud_json_value_find(doc, sizeof(doc) - 1, path_missing, 2, &val),
+		      -ENOENT);
+	zassert_equal(nrf_cloud_json_value_find(doc, sizeof(doc) - 1, path_not_obj, 2, &val),
+		      -ENOENT);
+
+	/* Truncated and malformed documents */
+	zassert_equal(nrf_cloud_json_value_find(doc, 20, path_b, 2, &val), -EBADMSG);
+	zassert_equal(nrf_cloud_json_value_find("{\"n\" 1}", 7, path_n, 1, &val), -EBADMSG);
+	zassert_equal(nrf_cloud_json_value_find("", 0, NULL, 0, &val), -EBADMSG);
+}
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Tests and init time benchmark of the P-GPS library, with predictions stored in the flash
+ * simulator and settings on NVS.
+ *
+ * The test acts as the application-provided transport: it answers the requests of the library
+ * by passing predictions to it as they would be downloaded from nRF Cloud. A reboot is
+ * simulated by initializing the library again, and the current time is faked to choose the
+ * prediction in use. The test is built with and without CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX,
+ * so the init times of both can be compared.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/util.h>
+
+#include <date_time.h>
+#include <net/nrf_cloud_agnss.h>
+#include <net/nrf_cloud_pgps.h>
+#include <test_benchmark.h>
+
+#include "nrf_cloud_download.h"
+#include "nrf_cloud_mem.h"
+#include "nrf_cloud_pgps_schema_v1.h"
+#include "nrf_cloud_pgps_utils.h"
+#include "nrf_cloud_pgps_index.h"
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, date_time_now, int64_t *);
+FAKE_VALUE_FUNC(int, downloader_init, struct downloader *, struct downloader_cfg *);
+FAKE_VALUE_FUNC(int, downloader_cancel, struct downloader *);
+FAKE_VALUE_FUNC(int, nrf_cloud_download_start, struct nrf_cloud_download_data *);
+FAKE_VOID_FUNC(nrf_cloud_download_end);
+FAKE_VALUE_FUNC(int, nrf_cloud_agnss_process, const char *, size_t);
+FAKE_VOID_FUNC(nrf_cloud_agnss_processed, struct nrf_modem_gnss_agnss_data_frame *);
+
+#define NUM_SLOTS NUM_BLOCKS
+#define SLOT_SIZE PGPS_PREDICTION_STORAGE_SIZE
+#define PAGE_SIZE 4096
+#define PERIOD_MIN 240
+#define PERIOD_SEC (PERIOD_MIN * SEC_PER_MIN)
+#define FIRST_GPS_SEC ((int64_t)16000 * SEC_PER_DAY + 2 * SEC_PER_HOUR)
+#define REPLACEMENT_THRESHOLD CONFIG_NRF_CLOUD_PGPS_REPLACEMENT_THRESHOLD
+#define ITERATIONS 20
+
+#define PGPS_PARTITION_ID FIXED_PARTITION_ID(slot1_partition)
+#define SETTINGS_PGPS_HEADER "nrf_cloud_pgps/pgps_header"
+#define SETTINGS_INDEX "nrf_cloud_pgps_idx"
+
+/* Events received from the library since the last reboot */
+static struct {
+	int count[PGPS_EVT_REQUEST + 1];
+	/* GPS time of the last prediction made available */
+	uint32_t prediction_sec;
+	struct gps_pgps_request request;
+} events;
+
+static const struct flash_area *fa;
+static int64_t now_gps_sec;
+
+void *nrf_cloud_malloc(size_t size)
+{
+	return k_malloc(size);
+}
+
+static int date_time_now_custom_fake(int64_t *unix_time_ms)
+{
+	*unix_time_ms = (now_gps_sec - (int64_t)GPS_TO_UTC_LEAP_SECONDS +
+			 (int64_t)GPS_TO_UNIX_UTC_OFFSET_SECONDS) * MSEC_PER_SEC;
+	return 0;
+}
+
+/* Set the current time to the start of the given prediction of the first set */
+static void time_set(int pnum)
+{
+	now_gps_sec = FIRST_GPS_SEC + (int64_t)pnum * PERIOD_SEC;
+}
+
+static void pgps_event_handler(struct nrf_cloud_pgps_event *event)
+{
+	events.count[event->type]++;
+
+	if (event->type == PGPS_EVT_AVAILABLE) {
+		events.prediction_sec = event->prediction->sentinel;
+	} else if (event->type == PGPS_EVT_REQUEST) {
+		events.request = *event->request;
+	}
+}
+
+/* Simulate a reboot: the library is initialized again from what is stored */
+static void reboot(void)
+{
+	struct nrf_cloud_pgps_init_param param = {
+		.event_handler = pgps_event_handler,
+	};
+
+	/* Drop the request of the previous boot; init does nothing while loading */
+	nrf_cloud_pgps_request_reset();
+
+	memset(&events, 0, sizeof(events));
+	zassert_ok(nrf_cloud_pgps_init(&param));
+}
+
+static void prediction_make(struct nrf_cloud_pgps_prediction *p, int64_t gps_sec)
+{
+	memset(p, 0, sizeof(*p));
+
+	p->time_type = NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK;
+	p->time_count = 1;
+	p->time.date_day = gps_sec / SEC_PER_DAY;
+	p->time.time_full_s = gps_sec % SEC_PER_DAY;
+	p->schema_version = NRF_CLOUD_AGNSS_BIN_SCHEMA_VERSION;
+	p->ephemeris_type = NRF_CLOUD_AGNSS_GPS_EPHEMERIDES;
+	p->ephemeris_count = NRF_CLOUD_PGPS_NUM_SV;
+
+	for (int i = 0; i < NRF_CLOUD_PGPS_NUM_SV; i++) {
+		p->ephemerii[i].sv_id = i + 1;
+		p->ephemerii[i].iodc = (gps_sec / PERIOD_SEC + i) & 0x3ff;
+		p->ephemerii[i].toc = (gps_sec / 16) & 0xffff;
+	}
+
+	p->sentinel = (uint32_t)gps_sec;
+}
+
+/* Pass predictions to the library as they are downloaded: a header, then each prediction
+ * without the schema version and sentinel, which the library adds when storing it.
+ */
+static void predictions_download(int64_t first_gps_sec, int count)
+{
+	const size_t schema_offset = offsetof(struct nrf_cloud_pgps_prediction, schema_version);
+	struct nrf_cloud_pgps_header header = {
+		.schema_version = NRF_CLOUD_PGPS_BIN_SCHEMA_VERSION,
+		.array_type = NRF_CLOUD_PGPS_PREDICTION_HEADER,
+		.num_items = 1,
+		.prediction_count = count,
+		.prediction_size = PGPS_PREDICTION_DL_SIZE,
+		.prediction_period_min = PERIOD_MIN,
+		.gps_day = first_gps_sec / SEC_PER_DAY,
+		.gps_time_of_day = first_gps_sec % SEC_PER_DAY,
+	};
+	struct nrf_cloud_pgps_prediction p;
+	uint8_t buf[PGPS_PREDICTION_DL_SIZE];
+
+	zassert_ok(nrf_cloud_pgps_begin_update());
+	zassert_ok(nrf_cloud_pgps_process_update((uint8_t *)&header, sizeof(header)));
+
+	for (int i = 0; i < count; i++) {
+		prediction_make(&p, first_gps_sec + (int64_t)i * PERIOD_SEC);
+		memcpy(buf, &p, schema_offset);
+		memcpy(&buf[schema_offset], (uint8_t *)&p + schema_offset + PGPS_SCHEMA_SIZE,
+		       sizeof(buf) - schema_offset);
+		zassert_ok(nrf_cloud_pgps_process_update(buf, sizeof(buf)));
+	}
+
+	zassert_ok(nrf_cloud_pgps_finish_update());
+}
+
+/* Boot with nothing stored, and answer the request for a full set of predictions */
+static void predictions_ready(void)
+{
+	reboot();
+	zassert_equal(1, events.count[PGPS_EVT_REQUEST]);
+	zassert_equal(NUM_PREDICTIONS, events.request.prediction_count);
+
+	predictions_download(FIRST_GPS_SEC, NUM_PREDICTIONS);
+	zassert_equal(1, events.count[PGPS_EVT_READY]);
+}
+
+/* Change a stored prediction behind the back of the library, as a FOTA update of a shared
+ * partition would.
+ */
+static void prediction_corrupt(int slot)
+{
+	static uint8_t page[PAGE_SIZE];
+	off_t page_off = ROUND_DOWN(slot * SLOT_SIZE, PAGE_SIZE);
+	struct nrf_cloud_pgps_prediction *p =
+		(struct nrf_cloud_pgps_prediction *)&page[slot * SLOT_SIZE - page_off];
+
+	zassert_ok(flash_area_read(fa, page_off, page, sizeof(page)));
+	p->ephemerii[0].iodc ^= 1;
+	zassert_ok(flash_area_erase(fa, page_off, sizeof(page)));
+	zassert_ok(flash_area_write(fa, page_off, page, sizeof(page)));
+}
+
+static int index_entry_load(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+			    void *param)
+{
+	uint32_t *gps_sec = param;
+	struct npgps_index_entry entry;
+	long slot = strtol(key, NULL, 10);
+
+	zassert_true((slot >= 0) && (slot < NUM_SLOTS), "Unexpected index key:%s", key);
+	zassert_equal(sizeof(entry), read_cb(cb_arg, &entry, sizeof(entry)));
+	gps_sec[slot] = entry.gps_sec;
+
+	return 0;
+}
+
+/* Get the GPS time of the prediction in each slot from the index stored in settings */
+static int index_load(uint32_t *gps_sec)
+{
+	int found = 0;
+
+	memset(gps_sec, 0, NUM_SLOTS * sizeof(*gps_sec));
+	zassert_ok(settings_load_subtree_direct(SETTINGS_INDEX, index_entry_load, gps_sec));
+
+	for (int slot = 0; slot < NUM_SLOTS; slot++) {
+		if (gps_sec[slot]) {
+			found++;
+		}
+	}
+
+	return found;
+}
+
+static bool index_has(const uint32_t *gps_sec, int64_t sec)
+{
+	for (int slot = 0; slot < NUM_SLOTS; slot++) {
+		if (gps_sec[slot] == (uint32_t)sec) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void index_clear(void)
+{
+	char key[32];
+
+	for (int slot = 0; slot < NUM_SLOTS; slot++) {
+		snprintk(key, sizeof(key), SETTINGS_INDEX "/%d", slot);
+		(void)settings_delete(key);
+	}
+}
+
+static void *pgps_setup(void)
+{
+	zassert_ok(settings_subsys_init());
+	zassert_ok(flash_area_open(PGPS_PARTITION_ID, &fa));
+	zassert_true(fa->fa_size >= NUM_SLOTS * SLOT_SIZE);
+
+	return NULL;
+}
+
+static void pgps_before(void *fixture)
+{
+	/* Loaded at init, so an empty header replaces the one of the previous test */
+	static const struct nrf_cloud_pgps_header no_header;
+
+	ARG_UNUSED(fixture);
+
+	RESET_FAKE(date_time_now);
+	date_time_now_fake.custom_fake = date_time_now_custom_fake;
+	time_set(0);
+
+	zassert_ok(flash_area_erase(fa, 0, NUM_SLOTS * SLOT_SIZE));
+	zassert_ok(settings_save_one(SETTINGS_PGPS_HEADER, &no_header, sizeof(no_header)));
+	index_clear();
+}
+
+ZTEST_SUITE(nrf_cloud_pgps, NULL, pgps_setup, pgps_before, NULL, NULL);
+
+ZTEST(nrf_cloud_pgps, test_init_finds_stored_prediction)
+{
+	const int64_t expected_sec = FIRST_GPS_SEC + 5 * PERIOD_SEC;
+	struct nrf_cloud_pgps_prediction *p;
+
+	reboot();
+	zassert_equal(1, events.count[PGPS_EVT_UNAVAILABLE]);
+	zassert_equal(1, events.count[PGPS_EVT_REQUEST]);
+
+	predictions_download(FIRST_GPS_SEC, NUM_PREDICTIONS);
+	zassert_equal(1, events.count[PGPS_EVT_READY]);
+
+	time_set(5);
+	reboot();
+
+	zassert_equal(0, events.count[PGPS_EVT_REQUEST]);
+	zassert_equal(1, events.count[PGPS_EVT_AVAILABLE]);
+	zassert_equal((uint32_t)expected_sec, events.prediction_sec);
+
+	zassert_equal(5, nrf_cloud_pgps_find_prediction(&p));
+	zassert_equal((uint32_t)expected_sec, p->sentinel);
+}
+
+ZTEST(nrf_cloud_pgps, test_download_is_indexed)
+{
+	uint32_t gps_sec[NUM_SLOTS];
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX);
+
+	predictions_ready();
+
+	zassert_equal(NUM_SLOTS, index_load(gps_sec));
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		zassert_true(index_has(gps_sec, FIRST_GPS_SEC + (int64_t)pnum * PERIOD_SEC),
+			     "Prediction num:%d not indexed", pnum);
+	}
+}
+
+ZTEST(nrf_cloud_pgps, test_missing_index_is_rebuilt)
+{
+	uint32_t gps_sec[NUM_SLOTS];
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX);
+
+	predictions_ready();
+
+	/* Stored by firmware without the index */
+	index_clear();
+	zassert_equal(0, index_load(gps_sec));
+
+	reboot();
+
+	zassert_equal(1, events.count[PGPS_EVT_AVAILABLE]);
+	zassert_equal((uint32_t)FIRST_GPS_SEC, events.prediction_sec);
+	zassert_equal(NUM_SLOTS, index_load(gps_sec));
+}
+
+ZTEST(nrf_cloud_pgps, test_changed_prediction_is_rejected)
+{
+	uint32_t gps_sec[NUM_SLOTS];
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX);
+
+	predictions_ready();
+
+	time_set(5);
+	reboot();
+	zassert_equal(1, events.count[PGPS_EVT_AVAILABLE]);
+
+	/* The time and sentinel are intact, only the contents do not match the index */
+	prediction_corrupt(5);
+	reboot();
+
+	zassert_equal(0, events.count[PGPS_EVT_AVAILABLE]);
+	zassert_equal(1, events.count[PGPS_EVT_UNAVAILABLE]);
+	zassert_equal(1, events.count[PGPS_EVT_REQUEST]);
+	zassert_equal(NUM_PREDICTIONS, events.request.prediction_count);
+
+	zassert_equal(NUM_SLOTS - 1, index_load(gps_sec));
+	zassert_false(index_has(gps_sec, FIRST_GPS_SEC + 5 * PERIOD_SEC));
+}
+
+ZTEST(nrf_cloud_pgps, test_expired_predictions_are_replaced)
+{
+	const int kept = REPLACEMENT_THRESHOLD;
+	const int replaced = NUM_PREDICTIONS - kept;
+	const int64_t new_gps_sec = FIRST_GPS_SEC + (int64_t)NUM_PREDICTIONS * PERIOD_SEC;
+	struct nrf_cloud_pgps_prediction *p;
+	int64_t expected_sec;
+
+	predictions_ready();
+
+	/* Only the last few predictions are left, so the older ones are discarded at init and
+	 * the ones following the stored set are requested.
+	 */
+	time_set(replaced);
+	reboot();
+
+	zassert_equal(0, events.count[PGPS_EVT_AVAILABLE]);
+	zassert_equal(1, events.count[PGPS_EVT_REQUEST]);
+	zassert_equal(replaced, events.request.prediction_count);
+	zassert_equal(new_gps_sec,
+		      npgps_gps_day_time_to_sec(events.request.gps_day,
+						events.request.gps_time_of_day));
+
+	predictions_download(new_gps_sec, replaced);
+	zassert_equal(1, events.count[PGPS_EVT_READY]);
+
+	/* The kept predictions come first, then the new ones stored in the discarded slots */
+	time_set(replaced + kept + 6);
+	expected_sec = FIRST_GPS_SEC + (int64_t)(replaced + kept + 6) * PERIOD_SEC;
+	zassert_equal(kept + 6, nrf_cloud_pgps_find_prediction(&p));
+	zassert_equal((uint32_t)expected_sec, p->sentinel);
+
+	reboot();
+
+	zassert_equal(1, events.count[PGPS_EVT_AVAILABLE]);
+	zassert_equal((uint32_t)expected_sec, events.prediction_sec);
+	zassert_equal(kept + 6, nrf_cloud_pgps_find_prediction(&p));
+
+	if (IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)) {
+		uint32_t gps_sec[NUM_SLOTS];
+
+		zassert_equal(NUM_SLOTS, index_load(gps_sec));
+		for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+			zassert_true(index_has(gps_sec, FIRST_GPS_SEC +
+							(int64_t)(replaced + pnum) * PERIOD_SEC),
+				     "Prediction num:%d not indexed", pnum);
+		}
+	}
+}
+
+/* Replace the expired predictions while running, without a reboot in between, until the
+ * catalog of predictions wraps around.
+ */
+ZTEST(nrf_cloud_pgps, test_expired_predictions_rotate)
+{
+	const int replaced = NUM_PREDICTIONS - REPLACEMENT_THRESHOLD;
+	const int rounds = DIV_ROUND_UP(NUM_PREDICTIONS, replaced) + 1;
+	struct nrf_cloud_pgps_prediction *p;
+	int first = 0;
+
+	predictions_ready();
+
+	for (int r = 0; r < rounds; r++) {
+		const int64_t new_gps_sec =
+			FIRST_GPS_SEC + (int64_t)(first + NUM_PREDICTIONS) * PERIOD_SEC;
+
+		time_set(first + replaced);
+		zassert_equal(replaced, nrf_cloud_pgps_find_prediction(&p));
+
+		memset(&events, 0, sizeof(events));
+		zassert_ok(nrf_cloud_pgps_preemptive_updates());
+		zassert_equal(1, events.count[PGPS_EVT_REQUEST], "Round:%d", r);
+		zassert_equal(replaced, events.request.prediction_count, "Round:%d", r);
+		zassert_equal(new_gps_sec,
+			      npgps_gps_day_time_to_sec(events.request.gps_day,
+							events.request.gps_time_of_day),
+			      "Round:%d", r);
+
+		predictions_download(new_gps_sec, replaced);
+		zassert_equal(1, events.count[PGPS_EVT_READY], "Round:%d", r);
+		first += replaced;
+	}
+
+	/* Every prediction is found through the rotated catalog, then after a reboot */
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		time_set(first + pnum);
+		zassert_equal(pnum, nrf_cloud_pgps_find_prediction(&p));
+		zassert_equal((uint32_t)(FIRST_GPS_SEC + (int64_t)(first + pnum) * PERIOD_SEC),
+			      p->sentinel, "Prediction num:%d", pnum);
+	}
+
+	time_set(first + 6);
+	reboot();
+
+	zassert_equal(1, events.count[PGPS_EVT_AVAILABLE]);
+	zassert_equal((uint32_t)(FIRST_GPS_SEC + (int64_t)(first + 6) * PERIOD_SEC),
+		      events.prediction_sec);
+	zassert_equal(6, nrf_cloud_pgps_find_prediction(&p));
+}
+
+ZTEST(nrf_cloud_pgps, test_init_benchmark)
+{
+	struct test_benchmark bench;
+
+	predictions_ready();
+
+	test_benchmark_start(&bench,
+			     IS_ENABLED(CONFIG_NRF_CLOUD_PGPS_STORAGE_INDEX)
+				     ? "P-GPS init, " STRINGIFY(NUM_PREDICTIONS)
+				       " predictions found in the index"
+				     : "P-GPS init, " STRINGIFY(NUM_PREDICTIONS)
+				       " predictions found by reading every slot",
+			     ITERATIONS);
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		reboot();
+		zassert_equal(1, events.count[PGPS_EVT_AVAILABLE]);
+	}
+
+	test_benchmark_stop(&bench);
+}
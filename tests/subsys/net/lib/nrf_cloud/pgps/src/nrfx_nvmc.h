@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Stub for the nRF NVMC driver, with the page size of the flash simulator */
+
+#ifndef NRFX_NVMC_H__
+#define NRFX_NVMC_H__
+
+#include <stdint.h>
+
+static inline uint32_t nrfx_nvmc_flash_page_size_get(void)
+{
+	return 4096;
+}
+
+#endif /* NRFX_NVMC_H__ */
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Tests for the P-GPS prediction index.
+ *
+ * Predictions are written to the flash simulator, and the index entry of each slot is
+ * updated after it is written. A reboot is simulated by loading the index from settings
+ * again. The index as used by the P-GPS library, and its effect on init time, is tested in
+ * the pgps test.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/logging/log.h>
+
+#include <net/nrf_cloud_pgps.h>
+
+#include "nrf_cloud_pgps_schema_v1.h"
+#include "nrf_cloud_pgps_utils.h"
+#include "nrf_cloud_pgps_index.h"
+
+/* The index logs as part of the P-GPS library */
+LOG_MODULE_REGISTER(nrf_cloud_pgps, CONFIG_NRF_CLOUD_GPS_LOG_LEVEL);
+
+#define NUM_SLOTS NUM_BLOCKS
+#define SLOT_SIZE PGPS_PREDICTION_STORAGE_SIZE
+#define PAGE_SIZE 4096
+#define PERIOD_SEC (240 * SEC_PER_MIN)
+#define FIRST_GPS_SEC ((int64_t)16000 * SEC_PER_DAY + 2 * SEC_PER_HOUR)
+
+#define PGPS_PARTITION_ID FIXED_PARTITION_ID(slot1_partition)
+
+static const struct flash_area *fa;
+static uint8_t slot_buf[SLOT_SIZE];
+static size_t slot_reads;
+
+/* Reads a whole slot, as the P-GPS library does for predictions in external flash */
+static const struct nrf_cloud_pgps_prediction *read_slot(int slot)
+{
+	slot_reads++;
+
+	if (flash_area_read(fa, slot * SLOT_SIZE, slot_buf, sizeof(slot_buf))) {
+		return NULL;
+	}
+
+	return (const struct nrf_cloud_pgps_prediction *)slot_buf;
+}
+
+static void prediction_make(struct nrf_cloud_pgps_prediction *p, int64_t gps_sec)
+{
+	memset(p, 0, sizeof(*p));
+
+	p->time_type = NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK;
+	p->time_count = 1;
+	p->time.date_day = gps_sec / SEC_PER_DAY;
+	p->time.time_full_s = gps_sec % SEC_PER_DAY;
+	p->schema_version = NRF_CLOUD_AGNSS_BIN_SCHEMA_VERSION;
+	p->ephemeris_type = NRF_CLOUD_AGNSS_GPS_EPHEMERIDES;
+	p->ephemeris_count = NRF_CLOUD_PGPS_NUM_SV;
+
+	for (int i = 0; i < NRF_CLOUD_PGPS_NUM_SV; i++) {
+		p->ephemerii[i].sv_id = i + 1;
+		p->ephemerii[i].iodc = (gps_sec / PERIOD_SEC + i) & 0x3ff;
+		p->ephemerii[i].toc = (gps_sec / 16) & 0xffff;
+	}
+
+	p->sentinel = (uint32_t)gps_sec;
+}
+
+/* Write predictions to consecutive slots, erasing the flash pages they are in first.
+ * If indexed, the index entry of each slot is updated, as the P-GPS library does.
+ */
+static void predictions_store(int first_slot, int count, int64_t first_gps_sec, bool indexed)
+{
+	off_t erase_off = ROUND_DOWN(first_slot * SLOT_SIZE, PAGE_SIZE);
+	off_t erase_end = ROUND_UP((first_slot + count) * SLOT_SIZE, PAGE_SIZE);
+	struct nrf_cloud_pgps_prediction *p = (struct nrf_cloud_pgps_prediction *)slot_buf;
+
+	zassert_ok(flash_area_erase(fa, erase_off, erase_end - erase_off));
+
+	for (int i = 0; i < count; i++) {
+		memset(slot_buf, 0xff, sizeof(slot_buf));
+		prediction_make(p, first_gps_sec + (int64_t)i * PERIOD_SEC);
+		zassert_ok(flash_area_write(fa, (first_slot + i) * SLOT_SIZE, slot_buf,
+					    sizeof(slot_buf)));
+		if (indexed) {
+			npgps_index_slot_update(first_slot + i, p);
+		}
+	}
+}
+
+/* Simulate a reboot: the index is loaded from settings again */
+static void reboot(void)
+{
+	zassert_ok(npgps_index_init(read_slot));
+	slot_reads = 0;
+}
+
+/* Find the GPS time of each stored prediction, as P-GPS init does */
+static int catalog_build(uint32_t *gps_sec)
+{
+	int found = 0;
+
+	for (int slot = 0; slot < NUM_SLOTS; slot++) {
+		gps_sec[slot] = 0;
+		if (!npgps_index_slot_time_get(slot, &gps_sec[slot])) {
+			found++;
+		}
+	}
+
+	return found;
+}
+
+static void *index_setup(void)
+{
+	zassert_ok(flash_area_open(PGPS_PARTITION_ID, &fa));
+	zassert_true(fa->fa_size >= NUM_SLOTS * SLOT_SIZE);
+
+	return NULL;
+}
+
+static void index_before(void *fixture)
+{
+	char key[32];
+
+	ARG_UNUSED(fixture);
+
+	zassert_ok(flash_area_erase(fa, 0, NUM_SLOTS * SLOT_SIZE));
+
+	for (int slot = 0; slot < NUM_SLOTS; slot++) {
+		snprintk(key, sizeof(key), "nrf_cloud_pgps_idx/%d", slot);
+		(void)settings_delete(key);
+	}
+
+	reboot();
+}
+
+ZTEST_SUITE(nrf_cloud_pgps_index, NULL, index_setup, index_before, NULL, NULL);
+
+ZTEST(nrf_cloud_pgps_index, test_indexed_init_reads_no_slots)
+{
+	uint32_t gps_sec[NUM_SLOTS];
+
+	predictions_store(0, NUM_SLOTS, FIRST_GPS_SEC, true);
+	reboot();
+
+	zassert_equal(NUM_SLOTS, catalog_build(gps_sec));
+	zassert_equal(0, slot_reads);
+
+	for (int slot = 0; slot < NUM_SLOTS; slot++) {
+		zassert_equal((uint32_t)(FIRST_GPS_SEC + (int64_t)slot * PERIOD_SEC),
+			      gps_sec[slot]);
+	}
+}
+
+ZTEST(nrf_cloud_pgps_index, test_unindexed_slots_are_read_once)
+{
+	uint32_t gps_sec[NUM_SLOTS];
+	uint32_t expected[NUM_SLOTS] = {0};
+
+	for (int slot = 0; slot < NUM_SLOTS - 2; slot++) {
+		expected[slot] = (uint32_t)(FIRST_GPS_SEC + (int64_t)slot * PERIOD_SEC);
+	}
+
+	/* Stored by firmware without the index */
+	predictions_store(0, NUM_SLOTS - 2, FIRST_GPS_SEC, false);
+	reboot();
+
+	zassert_equal(NUM_SLOTS - 2, catalog_build(gps_sec));
+	zassert_equal(NUM_SLOTS, slot_reads);
+	zassert_mem_equal(expected, gps_sec, sizeof(gps_sec));
+
+	reboot();
+
+	zassert_equal(NUM_SLOTS - 2, catalog_build(gps_sec));
+	zassert_equal(0, slot_reads);
+	zassert_mem_equal(expected, gps_sec, sizeof(gps_sec));
+}
+
+ZTEST(nrf_cloud_pgps_index, test_erased_slot_is_empty)
+{
+	uint32_t gps_sec[NUM_SLOTS];
+
+	predictions_store(0, NUM_SLOTS, FIRST_GPS_SEC, true);
+
+	/* Erased along with a neighbouring slot, which was then rewritten */
+	memset(slot_buf, 0xff, sizeof(slot_buf));
+	npgps_index_slot_update(3, (const struct nrf_cloud_pgps_prediction *)slot_buf);
+	reboot();
+
+	zassert_equal(NUM_SLOTS - 1, catalog_build(gps_sec));
+	zassert_equal(0, slot_reads);
+	zassert_equal(0, gps_sec[3]);
+	zassert_equal(-ENODATA, npgps_index_slot_time_get(3, &gps_sec[3]));
+}
+
+ZTEST(nrf_cloud_pgps_index, test_forgotten_slot_is_read_again)
+{
+	const int64_t new_gps_sec = FIRST_GPS_SEC + (int64_t)NUM_SLOTS * PERIOD_SEC;
+	uint32_t gps_sec[NUM_SLOTS];
+
+	predictions_store(0, NUM_SLOTS, FIRST_GPS_SEC, true);
+
+	/* Slots 2 and 3 share a flash page; both are forgotten before it is erased, and the
+	 * write is interrupted after slot 2.
+	 */
+	npgps_index_slot_forget(2);
+	npgps_index_slot_forget(3);
+	predictions_store(2, 1, new_gps_sec, false);
+	reboot();
+
+	zassert_equal(NUM_SLOTS - 1, catalog_build(gps_sec));
+	zassert_equal(2, slot_reads);
+	zassert_equal((uint32_t)new_gps_sec, gps_sec[2]);
+	zassert_equal(0, gps_sec[3]);
+	zassert_equal((uint32_t)(FIRST_GPS_SEC + 4 * PERIOD_SEC), gps_sec[4]);
+
+	/* Both were indexed when read */
+	reboot();
+	zassert_equal(NUM_SLOTS - 1, catalog_build(gps_sec));
+	zassert_equal(0, slot_reads);
+}
+
+ZTEST(nrf_cloud_pgps_index, test_verify_detects_changed_slot)
+{
+	const int64_t new_gps_sec = FIRST_GPS_SEC + (int64_t)NUM_SLOTS * PERIOD_SEC;
+	uint32_t sec;
+
+	predictions_store(0, NUM_SLOTS, FIRST_GPS_SEC, true);
+
+	/* Overwritten without updating the index, as a FOTA update of a shared partition does */
+	predictions_store(4, 2, new_gps_sec, false);
+	reboot();
+
+	/* The index is trusted until the prediction is used */
+	zassert_ok(npgps_index_slot_time_get(4, &sec));
+	zassert_equal((uint32_t)(FIRST_GPS_SEC + 4 * PERIOD_SEC), sec);
+	zassert_equal(0, slot_reads);
+
+	zassert_ok(npgps_index_slot_verify(6, read_slot(6)));
+	zassert_equal(-EBADMSG, npgps_index_slot_verify(4, read_slot(4)));
+
+	/* The entry was forgotten, so the slot is read again */
+	slot_reads = 0;
+	zassert_ok(npgps_index_slot_time_get(4, &sec));
+	zassert_equal((uint32_t)new_gps_sec, sec);
+	zassert_equal(1, slot_reads);
+	zassert_ok(npgps_index_slot_verify(4, read_slot(4)));
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""
+Generate benchmark data for the LZMA decompression benchmark.
+
+The plain data mixes pseudo-random text with copies of earlier parts of the data at
+distances of up to 160 KiB, so the compression ratio depends on the dictionary size.
+The data is compressed in the LZMA2 format used by the nRF Compression library, that is
+a raw LZMA2 stream preceded by the dictionary size and the properties bytes.
+"""
+
+import argparse
+import lzma
+import random
+
+DATA_SIZE = 192 * 1024
+MAX_DISTANCE = 160 * 1024
+SEED = 2025
+
+
+def generate_plain():
+    rng = random.Random(SEED)
+    words = [bytes(rng.choice(b'abcdefghijklmnopqrstuvwxyz') for _ in range(rng.randint(2, 9)))
+             for _ in range(512)]
+    data = bytearray()
+
+    while len(data) < DATA_SIZE:
+        if len(data) > 4096 and rng.random() < 0.5:
+            length = rng.randint(64, 1024)
+            start = len(data) - rng.randint(length, min(len(data), MAX_DISTANCE))
+            data += data[start:start + length]
+        else:
+            for _ in range(rng.randint(8, 64)):
+                data += rng.choice(words) + b' '
+
+    return bytes(data[:DATA_SIZE])
+
+
+def dict_size_prop(dict_size):
+    for prop in range(40):
+        if ((2 | (prop & 1)) << (prop // 2 + 11)) >= dict_size:
+            return prop
+    raise ValueError(f'Unsupported dictionary size {dict_size}')
+
+
+def compress(data, dict_size, lc, lp, pb):
+    filters = [{'id': lzma.FILTER_LZMA2, 'preset': 9, 'dict_size': dict_size,
+                'lc': lc, 'lp': lp, 'pb': pb}]
+    header = bytes([dict_size_prop(dict_size), (pb * 5 + lp) * 9 + lc])
+
+    return header + lzma.compress(data, format=lzma.FORMAT_RAW, filters=filters)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate LZMA decompression benchmark data.',
+                                     allow_abbrev=False)
+    parser.add_argument('--plain', help='Output file for the plain data')
+    parser.add_argument('--compressed', help='Output file for the compressed data')
+    parser.add_argument('--dict-size', type=int, default=4096,
+                        help='Dictionary size used for the compression')
+    parser.add_argument('--lc', type=int, default=3)
+    parser.add_argument('--lp', type=int, default=1)
+    parser.add_argument('--pb', type=int, default=2)
+    args = parser.parse_args()
+
+    data = generate_plain()
+
+    if args.plain:
+        with open(args.plain, 'wb') as f:
+            f.write(data)
+
+    if args.compressed:
+        with open(args.compressed, 'wb') as f:
+            f.write(compress(data, args.dict_size, args.lc, args.lp, args.pb))
+
+
+if __name__ == '__main__':
+    main()
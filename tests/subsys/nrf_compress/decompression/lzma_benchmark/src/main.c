@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <nrf_compress/implementation.h>
+#include <test_benchmark.h>
+#if defined(CONFIG_NRF_COMPRESS_FLASH_DICTIONARY)
+#include <nrf_compress/lzma_flash_dict.h>
+#endif
+
+static const uint8_t plain_data[] = {
+#include "benchmark_plain.inc"
+};
+
+static const uint8_t dict_4096_input[] = {
+#include "benchmark_dict_4096.inc"
+};
+
+static const uint8_t dict_16384_input[] = {
+#include "benchmark_dict_16384.inc"
+};
+
+static const uint8_t dict_65536_input[] = {
+#include "benchmark_dict_65536.inc"
+};
+
+static const uint8_t dict_131072_input[] = {
+#include "benchmark_dict_131072.inc"
+};
+
+static size_t dict_read_cnt;
+
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+static uint8_t __aligned(MAX(CONFIG_NRF_COMPRESS_MEMORY_ALIGNMENT, sizeof(uint16_t)))
+	arena[NRF_COMPRESS_LZMA_ARENA_SIZE];
+#endif
+
+#if defined(CONFIG_NRF_COMPRESS_FLASH_DICTIONARY)
+#define OUTPUT_PARTITION_ID FIXED_PARTITION_ID(slot1_partition)
+
+static const struct flash_area *output_fa;
+
+/* Count the reads that reach the flash, to show the effect of the dictionary caches. */
+static size_t read_dictionary(size_t pos, uint8_t *data, size_t len)
+{
+	dict_read_cnt++;
+	return lzma_flash_dict_read(pos, data, len);
+}
+
+static lzma_codec lzma_inst = {
+	.dict_if = {
+		.open = lzma_flash_dict_open,
+		.close = lzma_flash_dict_close,
+		.write = lzma_flash_dict_write,
+		.read = read_dictionary,
+	},
+	.arena = arena,
+	.arena_size = sizeof(arena),
+};
+#elif defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+#define LOCAL_DICT_SIZE (1024 * 128)
+static uint8_t local_dictionary[LOCAL_DICT_SIZE];
+
+static int open_dictionary(size_t dict_size, size_t *buff_size)
+{
+	*buff_size = LOCAL_DICT_SIZE;
+
+	return dict_size > LOCAL_DICT_SIZE ? -ENOMEM : 0;
+}
+
+static int close_dictionary(void)
+{
+	return 0;
+}
+
+static size_t write_dictionary(size_t pos, const uint8_t *data, size_t len)
+{
+	memcpy(local_dictionary + pos, data, len);
+	return len;
+}
+
+static size_t read_dictionary(size_t pos, uint8_t *data, size_t len)
+{
+	memcpy(data, local_dictionary + pos, len);
+	dict_read_cnt++;
+	return len;
+}
+
+static lzma_codec lzma_inst = {
+	.dict_if = {
+		.open = open_dictionary,
+		.close = close_dictionary,
+		.write = write_dictionary,
+		.read = read_dictionary,
+	},
+#if defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+	.arena = arena,
+	.arena_size = sizeof(arena),
+#endif
+};
+#elif defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+static lzma_codec lzma_inst = {
+	.arena = arena,
+	.arena_size = sizeof(arena),
+};
+#endif
+
+static void *codec_inst(void)
+{
+#if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY) || \
+	defined(CONFIG_NRF_COMPRESS_MEMORY_TYPE_ARENA)
+	return &lzma_inst;
+#else
+	return NULL;
+#endif
+}
+
+/* Compare decompressed data with the plain data, wherever the decoder left it. */
+static void check_output(const uint8_t *output, size_t output_size, size_t total_output_size)
+{
+	zassert_true(total_output_size + output_size <= sizeof(plain_data),
+		     "Too much data decompressed");
+
+#if defined(CONFIG_NRF_COMPRESS_FLASH_DICTIONARY)
+	ARG_UNUSED(output);
+#elif defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+	zassert_mem_equal(local_dictionary, &plain_data[total_output_size], output_size,
+			  "Expected decompressed data to match");
+#else
+	zassert_mem_equal(output, &plain_data[total_output_size], output_size,
+			  "Expected decompressed data to match");
+#endif
+}
+
+static void check_flash_output(void)
+{
+#if defined(CONFIG_NRF_COMPRESS_FLASH_DICTIONARY)
+	static uint8_t buf[1024];
+
+	for (size_t pos = 0; pos < sizeof(plain_data); pos += sizeof(buf)) {
+		size_t len = MIN(sizeof(buf), sizeof(plain_data) - pos);
+
+		zassert_ok(flash_area_read(output_fa, pos, buf, len));
+		zassert_mem_equal(buf, &plain_data[pos], len,
+				  "Expected data in flash to match at %zu", pos);
+	}
+#endif
+}
+
+static void benchmark(const uint8_t *input, size_t input_size, uint32_t dict_size)
+{
+	struct nrf_compress_implementation *implementation;
+	void *inst = codec_inst();
+	size_t total_output_size = 0;
+	size_t pos = 0;
+	uint64_t start;
+	uint64_t duration_us;
+	uint8_t *output;
+	size_t output_size;
+	uint32_t offset;
+	int rc;
+
+	implementation = nrf_compress_implementation_find(NRF_COMPRESS_TYPE_LZMA);
+	zassert_not_null(implementation, "Expected implementation to not be NULL");
+
+#if defined(CONFIG_NRF_COMPRESS_FLASH_DICTIONARY)
+	zassert_ok(flash_area_open(OUTPUT_PARTITION_ID, &output_fa));
+	zassert_ok(flash_area_erase(output_fa, 0, ROUND_UP(sizeof(plain_data), KB(4))));
+	zassert_ok(lzma_flash_dict_set(output_fa, 0));
+#endif
+
+	dict_read_cnt = 0;
+	start = test_benchmark_time_ns();
+
+	rc = implementation->init(inst, sizeof(plain_data));
+	zassert_ok(rc, "Expected init to be successful");
+
+	while (pos < input_size) {
+		size_t chunk_size = implementation->decompress_bytes_needed(inst);
+		bool last_part = (pos + chunk_size) >= input_size;
+
+		if (last_part) {
+			chunk_size = input_size - pos;
+		}
+
+		rc = implementation->decompress(inst, &input[pos], chunk_size, last_part, &offset,
+						&output, &output_size);
+		zassert_ok(rc, "Expected data decompress to be successful");
+
+		if (output_size > 0) {
+			check_output(output, output_size, total_output_size);
+			total_output_size += output_size;
+		}
+
+		pos += offset;
+	}
+
+	rc = implementation->deinit(inst);
+	zassert_ok(rc, "Expected deinit to be successful");
+
+	duration_us = MAX((test_benchmark_time_ns() - start) / NSEC_PER_USEC, 1);
+
+	zassert_equal(total_output_size, sizeof(plain_data),
+		      "Expected decompressed data size to match");
+	check_flash_output();
+
+#if defined(CONFIG_NRF_COMPRESS_FLASH_DICTIONARY)
+	flash_area_close(output_fa);
+#endif
+
+	/* Includes the time of comparing the output, which is the same for all dictionaries. */
+	TC_PRINT("dictionary %6u B: input %6zu B, output %6zu B, %6llu us, %6llu KiB/s, "
+		 "dictionary reads %zu\n", dict_size, input_size, total_output_size,
+		 (unsigned long long)duration_us,
+		 (unsigned long long)((uint64_t)total_output_size * USEC_PER_SEC / KB(1) /
+				      duration_us),
+		 dict_read_cnt);
+}
+
+ZTEST(nrf_compress_lzma_benchmark, test_dict_4096)
+{
+	benchmark(dict_4096_input, sizeof(dict_4096_input), 4096);
+}
+
+ZTEST(nrf_compress_lzma_benchmark, test_dict_16384)
+{
+	benchmark(dict_16384_input, sizeof(dict_16384_input), 16384);
+}
+
+ZTEST(nrf_compress_lzma_benchmark, test_dict_65536)
+{
+	benchmark(dict_65536_input, sizeof(dict_65536_input), 65536);
+}
+
+ZTEST(nrf_compress_lzma_benchmark, test_dict_131072)
+{
+	benchmark(dict_131072_input, sizeof(dict_131072_input), 131072);
+}
+
+ZTEST_SUITE(nrf_compress_lzma_benchmark, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk-hooks.h>
+#include <zephyr/sys/util.h>
+#include <nrf_profiler.h>
+
+#define RING_EVENT_NAME "ring event"
+#define INFO_PREFIX "nrf_profiler_info:"
+#define DATA_PREFIX "nrf_profiler_data:"
+#define DROPPED_PREFIX "nrf_profiler_dropped:"
+
+/* Record header followed by one u32 value. The header holds the length of the arguments,
+ * the CPU ID, the event type ID and the timestamp.
+ */
+#define RECORD_HDR_LEN 8
+#define RECORD_LEN (RECORD_HDR_LEN + sizeof(uint32_t))
+#define RECORD_TYPE_ID_POS 3
+#define RECORD_VALUE_POS RECORD_HDR_LEN
+
+#define RING_EVENTS_NB 50
+/* Enough records to overflow the ring buffer. */
+#define RING_OVERFLOW_EVENTS_NB (CONFIG_NRF_PROFILER_RING_BUFFER_SIZE / RECORD_LEN + 100)
+#define DRAIN_WAIT K_MSEC(3 * CONFIG_NRF_PROFILER_RING_DRAIN_PERIOD_MS)
+
+/* What the backend printed, collected by the drain thread. */
+struct ring_output {
+	bool info_found;
+	uint32_t records;
+	uint32_t dropped;
+	uint32_t next_value;
+	bool values_in_order;
+};
+
+static uint16_t ring_event_id;
+static uint32_t ring_value;
+static struct ring_output output;
+
+static printk_hook_fn_t console_out;
+static char line[sizeof(DATA_PREFIX) +
+		 2 * (RECORD_HDR_LEN + CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN)];
+static size_t line_len;
+
+static void data_line_parse(const char *hex)
+{
+	uint8_t record[RECORD_LEN];
+	uint32_t value;
+
+	if ((strlen(hex) != 2 * RECORD_LEN) ||
+	    (hex2bin(hex, strlen(hex), record, sizeof(record)) != RECORD_LEN) ||
+	    (record[RECORD_TYPE_ID_POS] != ring_event_id)) {
+		/* Records of the other test suite. */
+		return;
+	}
+
+	value = sys_get_le32(&record[RECORD_VALUE_POS]);
+	if ((value != output.next_value) || (sys_get_le16(record) != sizeof(uint32_t))) {
+		output.values_in_order = false;
+	}
+
+	output.next_value = value + 1;
+	output.records++;
+}
+
+static void line_parse(void)
+{
+	if (!strncmp(line, INFO_PREFIX, strlen(INFO_PREFIX))) {
+		if (!strncmp(line + strlen(INFO_PREFIX), RING_EVENT_NAME ",",
+			     strlen(RING_EVENT_NAME ","))) {
+			output.info_found = true;
+		}
+	} else if (!strncmp(line, DATA_PREFIX, strlen(DATA_PREFIX))) {
+		data_line_parse(line + strlen(DATA_PREFIX));
+	} else if (!strncmp(line, DROPPED_PREFIX, strlen(DROPPED_PREFIX))) {
+		const char *count = strchr(line, ',');
+
+		if (count) {
+			output.dropped += strtoul(count + 1, NULL, 10);
+		}
+	}
+}
+
+static int output_char(int c)
+{
+	if (c == '\n') {
+		line[line_len] = '\0';
+		line_parse();
+		line_len = 0;
+	} else if (line_len < sizeof(line) - 1) {
+		line[line_len++] = c;
+	}
+
+	return console_out ? console_out(c) : c;
+}
+
+static void output_reset(void)
+{
+	output.records = 0;
+	output.dropped = 0;
+	output.next_value = ring_value;
+	output.values_in_order = true;
+}
+
+static void ring_events_log(size_t events_nb)
+{
+	for (size_t i = 0; i < events_nb; i++) {
+		struct log_event_buf buf;
+
+		nrf_profiler_log_start(&buf);
+		nrf_profiler_log_encode_uint32(&buf, ring_value++);
+		nrf_profiler_log_send(&buf, ring_event_id);
+	}
+}
+
+static void *ring_setup(void)
+{
+	static const char * const data_names[] = {"value"};
+	static const enum nrf_profiler_arg data_types[] = {NRF_PROFILER_ARG_U32};
+
+	zassert_ok(nrf_profiler_init(), "Error when initializing");
+
+	/* The descriptions are printed again after a new event type is registered. */
+	console_out = __printk_get_hook();
+	__printk_hook_install(output_char);
+
+	ring_event_id = nrf_profiler_register_event_type(RING_EVENT_NAME, data_names,
+							 data_types, 1);
+	output_reset();
+
+	return NULL;
+}
+
+/* Test in the suite are expected to run in alphanumerical order. */
+ZTEST(suite_nrf_profiler_ring, test_ring_01_output)
+{
+	ring_events_log(RING_EVENTS_NB);
+
+	/* Let the drain thread print the records. */
+	k_sleep(DRAIN_WAIT);
+
+	zassert_true(output.info_found, "Event description not printed");
+	zassert_equal(output.records, RING_EVENTS_NB, "Printed %u records",
+		      output.records);
+	zassert_true(output.values_in_order, "Records printed out of order");
+	zassert_equal(output.dropped, 0, "Dropped %u records", output.dropped);
+}
+
+ZTEST(suite_nrf_profiler_ring, test_ring_02_dropped)
+{
+	output_reset();
+
+	/* The drain thread has a lower priority, so the ring buffer fills up. */
+	ring_events_log(RING_OVERFLOW_EVENTS_NB);
+
+	k_sleep(DRAIN_WAIT);
+
+	zassert_true(output.dropped > 0, "No records dropped");
+	zassert_equal(output.records + output.dropped, RING_OVERFLOW_EVENTS_NB,
+		      "Printed %u and dropped %u records", output.records, output.dropped);
+	zassert_true(output.values_in_order, "Records printed out of order");
+}
+
+static void ring_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Let the backend output the remaining data. */
+	nrf_profiler_term();
+
+	__printk_hook_install(console_out);
+}
+
+ZTEST_SUITE(suite_nrf_profiler_ring, NULL, ring_setup, NULL, NULL, ring_teardown);
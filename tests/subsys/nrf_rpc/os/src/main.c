@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <nrf_rpc_os.h>
+
+#define GROUP_SLOW	 1
+#define GROUP_FAST	 2
+#define NUM_SLOW_PACKETS 4
+#define NUM_FAST_PACKETS 6
+#define SLOW_EXEC_MS	 20
+
+/* nRF RPC header followed by a sequence number: type, id, dst, src group, dst group */
+#define PACKET(group, seq) {0x80, 0x00, 0xff, 0x00, (group), (seq)}
+#define PACKET_SEQ_IDX	   5
+#define PACKET_GROUP_IDX   4
+
+struct group_state {
+	uint8_t next_seq;
+	atomic_t active;
+	uint32_t errors;
+	uint32_t target;
+	struct k_sem done;
+};
+
+static struct group_state groups[GROUP_FAST + 1];
+static K_SEM_DEFINE(slow_release, 0, 1);
+
+static const uint8_t slow_packets[NUM_SLOW_PACKETS][6] = {
+	PACKET(GROUP_SLOW, 0), PACKET(GROUP_SLOW, 1), PACKET(GROUP_SLOW, 2),
+	PACKET(GROUP_SLOW, 3),
+};
+
+static const uint8_t fast_packets[NUM_FAST_PACKETS][6] = {
+	PACKET(GROUP_FAST, 0), PACKET(GROUP_FAST, 1), PACKET(GROUP_FAST, 2),
+	PACKET(GROUP_FAST, 3), PACKET(GROUP_FAST, 4), PACKET(GROUP_FAST, 5),
+};
+
+static void pool_callback(const uint8_t *data, size_t len)
+{
+	struct group_state *group = &groups[data[PACKET_GROUP_IDX]];
+	uint8_t seq = data[PACKET_SEQ_IDX];
+
+	/* Packets of one lane are never processed concurrently */
+	if (atomic_inc(&group->active) != 0) {
+		group->errors++;
+	}
+
+	if (seq != group->next_seq) {
+		group->errors++;
+	}
+
+	if (data[PACKET_GROUP_IDX] == GROUP_SLOW && seq == 0) {
+		k_sem_take(&slow_release, K_FOREVER);
+		k_sleep(K_MSEC(SLOW_EXEC_MS));
+	}
+
+	group->next_seq = seq + 1;
+	atomic_dec(&group->active);
+
+	if (group->next_seq == group->target) {
+		k_sem_give(&group->done);
+	}
+}
+
+static void group_expect(uint8_t group_id, uint32_t count)
+{
+	struct group_state *group = &groups[group_id];
+
+	group->next_seq = 0;
+	group->errors = 0;
+	group->target = count;
+	k_sem_reset(&group->done);
+}
+
+ZTEST(suite_nrf_rpc_os, test_group_dispatch)
+{
+	struct nrf_rpc_os_group_stats stats;
+
+	nrf_rpc_os_group_stats_reset();
+	group_expect(GROUP_SLOW, NUM_SLOW_PACKETS);
+	group_expect(GROUP_FAST, NUM_FAST_PACKETS);
+
+	for (size_t i = 0; i < NUM_SLOW_PACKETS; i++) {
+		nrf_rpc_os_thread_pool_send(slow_packets[i], sizeof(slow_packets[i]));
+	}
+
+	/* The slow group is blocked, but the fast group is processed by other pool threads */
+	for (size_t i = 0; i < NUM_FAST_PACKETS; i++) {
+		nrf_rpc_os_thread_pool_send(fast_packets[i], sizeof(fast_packets[i]));
+	}
+
+	zassert_ok(k_sem_take(&groups[GROUP_FAST].done, K_SECONDS(1)),
+		   "Fast group blocked by slow group");
+	zassert_equal(groups[GROUP_SLOW].next_seq, 0, "Slow group not blocked");
+
+	k_sem_give(&slow_release);
+
+	zassert_ok(k_sem_take(&groups[GROUP_SLOW].done, K_SECONDS(1)),
+		   "Slow group not processed");
+	zassert_equal(groups[GROUP_SLOW].errors, 0, "Slow group processed out of order");
+	zassert_equal(groups[GROUP_FAST].errors, 0, "Fast group processed out of order");
+
+	zassert_ok(nrf_rpc_os_group_stats_get(GROUP_SLOW, &stats));
+	zassert_equal(stats.count, NUM_SLOW_PACKETS);
+	zassert_true(stats.exec_time_max_us >= (SLOW_EXEC_MS - 1) * USEC_PER_MSEC);
+	/* The remaining packets of the slow group waited for the first one */
+	zassert_true(stats.queue_time_max_us >= (SLOW_EXEC_MS - 1) * USEC_PER_MSEC);
+
+	zassert_ok(nrf_rpc_os_group_stats_get(GROUP_FAST, &stats));
+	zassert_equal(stats.count, NUM_FAST_PACKETS);
+	zassert_true(stats.exec_time_max_us < SLOW_EXEC_MS * USEC_PER_MSEC);
+
+	zassert_equal(nrf_rpc_os_group_stats_get(CONFIG_NRF_RPC_OS_GROUP_STATS_MAX, &stats),
+		      -NRF_EINVAL);
+}
+
+ZTEST(suite_nrf_rpc_os, test_rx_buf)
+{
+	uint8_t *bufs[CONFIG_NRF_RPC_OS_RX_BUF_COUNT];
+	uint8_t local;
+
+	for (size_t i = 0; i < ARRAY_SIZE(bufs); i++) {
+		bufs[i] = nrf_rpc_os_rx_buf_alloc();
+		zassert_not_null(bufs[i], "Failed to allocate buffer %zu", i);
+	}
+
+	zassert_is_null(nrf_rpc_os_rx_buf_alloc(), "Allocated more buffers than available");
+
+	zassert_true(nrf_rpc_os_rx_buf_contains(bufs[0]));
+	zassert_true(nrf_rpc_os_rx_buf_contains(bufs[1] + CONFIG_NRF_RPC_OS_RX_BUF_SIZE - 1));
+	zassert_false(nrf_rpc_os_rx_buf_contains(&local));
+
+	/* A decoder borrows a slice of the buffer */
+	zassert_false(nrf_rpc_os_rx_buf_shared(bufs[0]));
+	nrf_rpc_os_rx_buf_ref(bufs[0] + 10);
+	zassert_true(nrf_rpc_os_rx_buf_shared(bufs[0]));
+
+	/* The transport releases the buffer, the slice is still valid */
+	nrf_rpc_os_rx_buf_unref(bufs[0]);
+	zassert_false(nrf_rpc_os_rx_buf_shared(bufs[0]));
+	zassert_is_null(nrf_rpc_os_rx_buf_alloc(), "Borrowed buffer reused");
+
+	/* The decoder releases the slice */
+	nrf_rpc_os_rx_buf_unref(bufs[0] + 10);
+	zassert_equal_ptr(nrf_rpc_os_rx_buf_alloc(), bufs[0], "Released buffer not reused");
+
+	for (size_t i = 0; i < ARRAY_SIZE(bufs); i++) {
+		nrf_rpc_os_rx_buf_unref(bufs[i]);
+	}
+}
+
+static void *setup(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(groups); i++) {
+		k_sem_init(&groups[i].done, 0, 1);
+	}
+
+	zassert_ok(nrf_rpc_os_init(pool_callback));
+
+	return NULL;
+}
+
+ZTEST_SUITE(suite_nrf_rpc_os, NULL, setup, NULL, NULL, NULL);
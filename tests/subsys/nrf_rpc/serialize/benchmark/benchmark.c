@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include <test_benchmark.h>
+
+#include "../src/test_schema.h"
+
+#define NUM_ITERATIONS 10000
+
+static const struct test_args bench_value = {
+	.handle = 0x1234,
+	.offset = 70000,
+	.delta = -300,
+	.notify = true,
+	.addr = {.type = 1, .val = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66}},
+	.name = "benchmark",
+	.data_len = 20,
+};
+
+static uint8_t generic_buf[TEST_BUF_SIZE];
+static uint8_t schema_buf[TEST_BUF_SIZE];
+
+static void check_decoded(const struct test_args *out)
+{
+	zassert_equal(out->handle, bench_value.handle);
+	zassert_equal(out->offset, bench_value.offset);
+	zassert_equal(out->delta, bench_value.delta);
+	zassert_equal(out->notify, bench_value.notify);
+	zassert_mem_equal(&out->addr, &bench_value.addr, sizeof(out->addr));
+	zassert_str_equal(out->name, bench_value.name);
+	zassert_equal(out->data_len, bench_value.data_len);
+	zassert_mem_equal(out->data, bench_value.data, bench_value.data_len);
+}
+
+ZTEST(suite_nrf_rpc_serialize_benchmark, test_encode)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct test_benchmark bench;
+	size_t generic_len;
+	size_t schema_len;
+
+	test_benchmark_start(&bench, "nrf_rpc_serialize encode generic", NUM_ITERATIONS);
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		test_ctx_encode_init(&ctx, generic_buf, sizeof(generic_buf));
+		test_args_encode_generic(&ctx, &bench_value);
+	}
+	test_benchmark_stop(&bench);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	generic_len = test_ctx_len(&ctx, generic_buf);
+
+	test_benchmark_start(&bench, "nrf_rpc_serialize encode schema", NUM_ITERATIONS);
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		test_ctx_encode_init(&ctx, schema_buf, sizeof(schema_buf));
+		test_args_encode(&ctx, &bench_value);
+	}
+	test_benchmark_stop(&bench);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	schema_len = test_ctx_len(&ctx, schema_buf);
+
+	/* Both encoders must have done the same work */
+	zassert_equal(schema_len, generic_len);
+	zassert_mem_equal(schema_buf, generic_buf, generic_len);
+}
+
+ZTEST(suite_nrf_rpc_serialize_benchmark, test_decode)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct test_benchmark bench;
+	struct test_args out;
+	size_t len;
+
+	test_ctx_encode_init(&ctx, schema_buf, sizeof(schema_buf));
+	zassert_true(test_args_encode(&ctx, &bench_value));
+	len = test_ctx_len(&ctx, schema_buf);
+
+	memset(&out, 0, sizeof(out));
+	test_benchmark_start(&bench, "nrf_rpc_serialize decode generic", NUM_ITERATIONS);
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		test_ctx_decode_init(&ctx, schema_buf, len);
+		test_args_decode_generic(&ctx, &out);
+	}
+	test_benchmark_stop(&bench);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	check_decoded(&out);
+
+	memset(&out, 0, sizeof(out));
+	test_benchmark_start(&bench, "nrf_rpc_serialize decode schema", NUM_ITERATIONS);
+	for (int i = 0; i < NUM_ITERATIONS; i++) {
+		test_ctx_decode_init(&ctx, schema_buf, len);
+		test_args_decode(&ctx, &out);
+	}
+	test_benchmark_stop(&bench);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	check_decoded(&out);
+}
+
+ZTEST_SUITE(suite_nrf_rpc_serialize_benchmark, NULL, NULL, NULL, NULL, NULL);
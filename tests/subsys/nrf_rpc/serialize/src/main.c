@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <nrf_rpc_os.h>
+
+#include "test_schema.h"
+
+static const struct test_args test_value = {
+	.handle = 0x1234,
+	.offset = 70000,
+	.delta = -300,
+	.notify = true,
+	.addr = {.type = 1, .val = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66}},
+	.name = "schema",
+	.data_len = 5,
+	.data = {1, 2, 3, 4, 5},
+};
+
+static uint8_t buf_schema[TEST_BUF_SIZE];
+static uint8_t buf_generic[TEST_BUF_SIZE];
+
+static size_t encode_schema(const struct test_args *in, uint8_t *buf, size_t size)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+
+	test_ctx_encode_init(&ctx, buf, size);
+	zassert_true(test_args_encode(&ctx, in), "Encoding failed");
+
+	return test_ctx_len(&ctx, buf);
+}
+
+static size_t encode_generic(const struct test_args *in, uint8_t *buf, size_t size)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+
+	test_ctx_encode_init(&ctx, buf, size);
+	test_args_encode_generic(&ctx, in);
+	zassert_true(nrf_rpc_decode_valid(&ctx), "Encoding failed");
+
+	return test_ctx_len(&ctx, buf);
+}
+
+ZTEST(nrf_rpc_serialize, test_schema_matches_generic_encoding)
+{
+	size_t len_schema = encode_schema(&test_value, buf_schema, sizeof(buf_schema));
+	size_t len_generic = encode_generic(&test_value, buf_generic, sizeof(buf_generic));
+
+	zassert_equal(len_schema, len_generic);
+	zassert_mem_equal(buf_schema, buf_generic, len_schema);
+}
+
+ZTEST(nrf_rpc_serialize, test_schema_decodes_generic_encoding)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct test_args out = {0};
+	size_t len = encode_generic(&test_value, buf_generic, sizeof(buf_generic));
+
+	test_ctx_decode_init(&ctx, buf_generic, len);
+	zassert_true(test_args_decode(&ctx, &out));
+	zassert_equal(test_ctx_len(&ctx, buf_generic), len);
+
+	zassert_equal(out.handle, test_value.handle);
+	zassert_equal(out.offset, test_value.offset);
+	zassert_equal(out.delta, test_value.delta);
+	zassert_equal(out.notify, test_value.notify);
+	zassert_mem_equal(&out.addr, &test_value.addr, sizeof(out.addr));
+	zassert_str_equal(out.name, test_value.name);
+	zassert_equal(out.data_len, test_value.data_len);
+	zassert_mem_equal(out.data, test_value.data, out.data_len);
+}
+
+ZTEST(nrf_rpc_serialize, test_schema_size_max)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct test_args in;
+	size_t len;
+
+	/* Largest values of all members */
+	memset(&in, 0xff, sizeof(in));
+	in.delta = INT32_MIN;
+	in.name[sizeof(in.name) - 1] = '\0';
+	in.data_len = sizeof(in.data);
+
+	len = encode_schema(&in, buf_schema, sizeof(buf_schema));
+	zassert_true(len <= NRF_RPC_SCHEMA_SIZE_MAX(test_args), "%zu > %zu", len,
+		     NRF_RPC_SCHEMA_SIZE_MAX(test_args));
+
+	/* The encoder reports a buffer that is too small */
+	test_ctx_encode_init(&ctx, buf_schema, len - 1);
+	zassert_false(test_args_encode(&ctx, &in), "Encoded into a too small buffer");
+}
+
+ZTEST(nrf_rpc_serialize, test_schema_decode_errors)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct test_args in = test_value;
+	struct test_args out;
+	size_t len;
+
+	/* Variable-length buffer longer than the destination */
+	in.data_len = sizeof(in.data) + 1;
+
+	test_ctx_encode_init(&ctx, buf_schema, sizeof(buf_schema));
+	zassert_false(test_args_encode(&ctx, &in), "Invalid length encoded");
+
+	/* Truncated data */
+	len = encode_schema(&test_value, buf_schema, sizeof(buf_schema));
+
+	for (size_t trunc = 0; trunc < len; trunc++) {
+		test_ctx_decode_init(&ctx, buf_schema, trunc);
+		zassert_false(test_args_decode(&ctx, &out), "Truncated data at %zu decoded", trunc);
+	}
+
+	/* Wrong item type */
+	test_ctx_encode_init(&ctx, buf_generic, sizeof(buf_generic));
+	nrf_rpc_encode_str(&ctx, "not a number", -1);
+	len = test_ctx_len(&ctx, buf_generic);
+
+	test_ctx_decode_init(&ctx, buf_generic, len);
+	zassert_false(test_args_decode(&ctx, &out));
+}
+
+ZTEST(nrf_rpc_serialize, test_schema_decode_string_too_long)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct test_args out;
+	char name[TEST_NAME_SIZE + 1];
+	size_t len;
+
+	memset(name, 'a', sizeof(name) - 1);
+	name[sizeof(name) - 1] = '\0';
+
+	test_ctx_encode_init(&ctx, buf_generic, sizeof(buf_generic));
+	nrf_rpc_encode_uint(&ctx, test_value.handle);
+	nrf_rpc_encode_uint(&ctx, test_value.offset);
+	nrf_rpc_encode_int(&ctx, test_value.delta);
+	nrf_rpc_encode_bool(&ctx, test_value.notify);
+	nrf_rpc_encode_buffer(&ctx, &test_value.addr, sizeof(test_value.addr));
+	nrf_rpc_encode_str(&ctx, name, -1);
+	nrf_rpc_encode_buffer(&ctx, test_value.data, test_value.data_len);
+	len = test_ctx_len(&ctx, buf_generic);
+
+	test_ctx_decode_init(&ctx, buf_generic, len);
+	zassert_false(test_args_decode(&ctx, &out), "String longer than destination decoded");
+}
+
+/* Scratchpad size followed by the data, as sent to a handler that decodes into a scratchpad */
+static size_t encode_borrow(uint8_t *buf, size_t size, const void *data, size_t data_len)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+
+	test_ctx_encode_init(&ctx, buf, size);
+	nrf_rpc_encode_uint(&ctx, NRF_RPC_SCRATCHPAD_ALIGN(data_len));
+	nrf_rpc_encode_buffer(&ctx, data, data_len);
+	zassert_true(nrf_rpc_decode_valid(&ctx), "Encoding failed");
+
+	return test_ctx_len(&ctx, buf);
+}
+
+ZTEST(nrf_rpc_serialize, test_buffer_borrow_copy)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct nrf_rpc_scratchpad scratchpad;
+	size_t len = encode_borrow(buf_generic, sizeof(buf_generic), test_value.data,
+				   test_value.data_len);
+	const uint8_t *data;
+	size_t data_len = 0;
+
+	test_ctx_decode_init(&ctx, buf_generic, len);
+	NRF_RPC_SCRATCHPAD_DECLARE(&scratchpad, &ctx);
+
+	/* The packet is not in a receive buffer, so the data is copied into the scratchpad */
+	data = nrf_rpc_decode_buffer_borrow(&scratchpad, &data_len);
+	zassert_not_null(data);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	zassert_equal_ptr(data, scratchpad.buf.data);
+	zassert_equal(scratchpad.buf.len, NRF_RPC_SCRATCHPAD_ALIGN(data_len));
+	zassert_equal(data_len, test_value.data_len);
+	zassert_mem_equal(data, test_value.data, data_len);
+
+	nrf_rpc_buffer_release(data);
+}
+
+ZTEST(nrf_rpc_serialize, test_buffer_borrow_nil)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct nrf_rpc_scratchpad scratchpad;
+	size_t len;
+	size_t data_len = 0;
+
+	test_ctx_encode_init(&ctx, buf_generic, sizeof(buf_generic));
+	nrf_rpc_encode_uint(&ctx, NRF_RPC_SCRATCHPAD_ALIGN(1));
+	nrf_rpc_encode_null(&ctx);
+	len = test_ctx_len(&ctx, buf_generic);
+
+	test_ctx_decode_init(&ctx, buf_generic, len);
+	NRF_RPC_SCRATCHPAD_DECLARE(&scratchpad, &ctx);
+
+	zassert_is_null(nrf_rpc_decode_buffer_borrow(&scratchpad, &data_len));
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+
+	nrf_rpc_buffer_release(NULL);
+}
+
+ZTEST(nrf_rpc_serialize, test_buffer_borrow_rx_buf)
+{
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+	struct nrf_rpc_cbor_ctx ctx;
+	struct nrf_rpc_scratchpad scratchpad;
+	uint8_t *rx_buf = nrf_rpc_os_rx_buf_alloc();
+	size_t len;
+	const uint8_t *data;
+	size_t data_len = 0;
+
+	zassert_not_null(rx_buf);
+	len = encode_borrow(rx_buf, CONFIG_NRF_RPC_OS_RX_BUF_SIZE, test_value.data,
+			    test_value.data_len);
+
+	test_ctx_decode_init(&ctx, rx_buf, len);
+	NRF_RPC_SCRATCHPAD_DECLARE(&scratchpad, &ctx);
+
+	/* The data points into the packet and keeps the receive buffer referenced */
+	data = nrf_rpc_decode_buffer_borrow(&scratchpad, &data_len);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	zassert_true(data > rx_buf && data < rx_buf + len, "Data copied out of the packet");
+	zassert_equal(data_len, test_value.data_len);
+	zassert_mem_equal(data, test_value.data, data_len);
+	zassert_equal(scratchpad.buf.len, 0, "Scratchpad used");
+	zassert_true(nrf_rpc_os_rx_buf_shared(rx_buf));
+
+	/* The transport releases the packet, the borrowed data remains valid */
+	nrf_rpc_os_rx_buf_unref(rx_buf);
+	zassert_mem_equal(data, test_value.data, data_len);
+
+	nrf_rpc_buffer_release(data);
+	zassert_equal_ptr(nrf_rpc_os_rx_buf_alloc(), rx_buf, "Released buffer not reused");
+	nrf_rpc_os_rx_buf_unref(rx_buf);
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST_SUITE(nrf_rpc_serialize, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TEST_SCHEMA_H_
+#define TEST_SCHEMA_H_
+
+#include <nrf_rpc/nrf_rpc_schema.h>
+#include <nrf_rpc/nrf_rpc_serialize.h>
+
+#define TEST_NAME_SIZE	16
+#define TEST_DATA_SIZE	32
+#define TEST_BUF_SIZE	128
+#define TEST_ELEM_COUNT 16
+
+struct test_addr {
+	uint8_t type;
+	uint8_t val[6];
+};
+
+struct test_args {
+	uint16_t handle;
+	uint32_t offset;
+	int32_t delta;
+	bool notify;
+	struct test_addr addr;
+	char name[TEST_NAME_SIZE];
+	uint16_t data_len;
+	uint8_t data[TEST_DATA_SIZE];
+};
+
+#define TEST_ARGS_SCHEMA(X)                                                                        \
+	X(UINT, handle)                                                                            \
+	X(UINT, offset)                                                                            \
+	X(INT, delta)                                                                              \
+	X(BOOL, notify)                                                                            \
+	X(BUF, addr)                                                                               \
+	X(STR, name)                                                                               \
+	X(VBUF, data, data_len)
+
+NRF_RPC_SCHEMA_DEFINE(test_args, struct test_args, TEST_ARGS_SCHEMA);
+
+/* Hand-written equivalents, as used by the RPC groups before the schema was introduced */
+static inline void test_args_encode_generic(struct nrf_rpc_cbor_ctx *ctx,
+					    const struct test_args *in)
+{
+	nrf_rpc_encode_uint(ctx, in->handle);
+	nrf_rpc_encode_uint(ctx, in->offset);
+	nrf_rpc_encode_int(ctx, in->delta);
+	nrf_rpc_encode_bool(ctx, in->notify);
+	nrf_rpc_encode_buffer(ctx, &in->addr, sizeof(in->addr));
+	nrf_rpc_encode_str(ctx, in->name, -1);
+	nrf_rpc_encode_buffer(ctx, in->data, in->data_len);
+}
+
+static inline void test_args_decode_generic(struct nrf_rpc_cbor_ctx *ctx, struct test_args *out)
+{
+	const void *data;
+	size_t data_len = 0;
+
+	out->handle = nrf_rpc_decode_uint(ctx);
+	out->offset = nrf_rpc_decode_uint(ctx);
+	out->delta = nrf_rpc_decode_int(ctx);
+	out->notify = nrf_rpc_decode_bool(ctx);
+	nrf_rpc_decode_buffer(ctx, &out->addr, sizeof(out->addr));
+	nrf_rpc_decode_str(ctx, out->name, sizeof(out->name));
+
+	data = nrf_rpc_decode_buffer_ptr_and_size(ctx, &data_len);
+	if (data && data_len <= sizeof(out->data)) {
+		memcpy(out->data, data, data_len);
+		out->data_len = data_len;
+	}
+}
+
+static inline void test_ctx_encode_init(struct nrf_rpc_cbor_ctx *ctx, uint8_t *buf, size_t size)
+{
+	zcbor_new_encode_state(ctx->zs, ARRAY_SIZE(ctx->zs), buf, size, 0);
+}
+
+static inline void test_ctx_decode_init(struct nrf_rpc_cbor_ctx *ctx, const uint8_t *buf,
+					size_t size)
+{
+	zcbor_new_decode_state(ctx->zs, ARRAY_SIZE(ctx->zs), buf, size, TEST_ELEM_COUNT, NULL, 0);
+}
+
+static inline size_t test_ctx_len(const struct nrf_rpc_cbor_ctx *ctx, const uint8_t *buf)
+{
+	return ctx->zs->payload - buf;
+}
+
+#endif /* TEST_SCHEMA_H_ */
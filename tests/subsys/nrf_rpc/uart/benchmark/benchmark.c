@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include "../src/link.h"
+
+#define NUM_PACKETS 500
+#define PACKET_LEN  256
+#define RX_TIMEOUT  K_SECONDS(120)
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+#define MODE_NAME "window " STRINGIFY(CONFIG_NRF_RPC_UART_WINDOW_SIZE)
+#else
+#define MODE_NAME "stop-and-wait"
+#endif
+
+/* Simulated time is used rather than test_benchmark_time_ns(), as the latency of the emulated
+ * link passes in simulated time; the result then depends only on the link and the protocol.
+ */
+ZTEST(suite_nrf_rpc_uart_benchmark, test_throughput)
+{
+	int64_t start;
+	int64_t elapsed;
+	int ret;
+
+	link_rx_expect(&link_rx_b, NUM_PACKETS);
+
+	start = k_uptime_get();
+
+	for (uint32_t id = 0; id < NUM_PACKETS; id++) {
+		ret = link_send(LINK_TR_A, id, PACKET_LEN);
+		zassert_equal(ret, 0, "Failed to send packet %u: %d", id, ret);
+	}
+
+	zassert_ok(k_sem_take(&link_rx_b.done, RX_TIMEOUT), "Not all packets received");
+	elapsed = MAX(k_uptime_get() - start, 1);
+
+	zassert_equal(link_rx_b.errors, 0, "Invalid packets received");
+
+	printk("nrf_rpc_uart %s, latency %d ms: %u packets of %u B in %lld ms, %lld B/s\n",
+	       MODE_NAME, CONFIG_NRF_RPC_UART_TEST_LATENCY_MS, NUM_PACKETS, PACKET_LEN, elapsed,
+	       (int64_t)NUM_PACKETS * PACKET_LEN * MSEC_PER_SEC / elapsed);
+}
+
+static void *setup(void)
+{
+	link_init();
+
+	return NULL;
+}
+
+ZTEST_SUITE(suite_nrf_rpc_uart_benchmark, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "link.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/ztest.h>
+
+#include <nrf_rpc_os.h>
+
+#define WIRE_BUF_SIZE	  8192
+#define WIRE_CHUNK_SIZE	  256
+#define WIRE_STACK_SIZE	  1024
+#define WIRE_PRIORITY	  K_PRIO_PREEMPT(1)
+/* 1 Mbaud, 10 bits per byte */
+#define WIRE_BYTE_TIME_US 10
+/* Packet with the sequence number and the checksum */
+#define FRAME_SIZE	  (CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE + 3)
+
+#define HDLC_CHAR_ESCAPE    0x7d
+#define HDLC_CHAR_DELIMITER 0x7e
+
+/* Frames of the windowed mode use a different checksum seed, and the checksum of the
+ * stop-and-wait mode does not contain the sequence bit.
+ */
+#define WINDOW_CRC_SEED 0x1d0fu
+
+/* One direction of the link */
+struct wire {
+	const struct device *from;
+	const struct device *to;
+	struct ring_buf buf;
+	uint8_t buf_data[WIRE_BUF_SIZE];
+	struct k_spinlock lock;
+	struct k_sem ready;
+	uint32_t byte_cnt;
+	/* Escaped frame being written by the sending end, without the delimiters */
+	uint8_t frame[2 * FRAME_SIZE];
+	size_t frame_len;
+	uint8_t decoded[FRAME_SIZE];
+	bool frame_overflow;
+	struct link_stats stats;
+	atomic_t cut;
+	atomic_t hold;
+};
+
+static struct wire wires[] = {
+	{
+		.from = DEVICE_DT_GET(DT_NODELABEL(euart0)),
+		.to = DEVICE_DT_GET(DT_NODELABEL(euart1)),
+	},
+	{
+		.from = DEVICE_DT_GET(DT_NODELABEL(euart1)),
+		.to = DEVICE_DT_GET(DT_NODELABEL(euart0)),
+	},
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(wire_stacks, ARRAY_SIZE(wires), WIRE_STACK_SIZE);
+static struct k_thread wire_threads[ARRAY_SIZE(wires)];
+static atomic_t corrupt_interval;
+
+struct link_rx link_rx_a;
+struct link_rx link_rx_b;
+
+static struct wire *wire_get(const struct nrf_rpc_tr *from)
+{
+	return (from == LINK_TR_A) ? &wires[0] : &wires[1];
+}
+
+static bool frame_crc_check(const uint8_t *frame, size_t len, uint16_t seed, uint16_t mask)
+{
+	uint16_t crc = crc16_ccitt(seed, frame, len - sizeof(crc));
+
+	return ((sys_get_le16(&frame[len - sizeof(crc)]) ^ crc) & mask) == 0;
+}
+
+static void frame_classify(struct wire *wire)
+{
+	uint8_t *frame = wire->decoded;
+	size_t len = 0;
+
+	for (size_t i = 0; i < wire->frame_len && len < sizeof(wire->decoded); i++) {
+		if (wire->frame[i] == HDLC_CHAR_ESCAPE && i + 1 < wire->frame_len) {
+			frame[len++] = wire->frame[++i] ^ 0x20;
+		} else {
+			frame[len++] = wire->frame[i];
+		}
+	}
+
+	if (len == 1) {
+		wire->stats.control++;
+	} else if (len <= 2) {
+		/* Acknowledgment of the stop-and-wait mode */
+	} else if (frame_crc_check(frame, len, WINDOW_CRC_SEED, 0xffffu)) {
+		wire->stats.windowed++;
+	} else if (frame_crc_check(frame, len, 0xffff, 0x7fffu)) {
+		wire->stats.legacy++;
+	}
+}
+
+/* Forward a complete frame to the other end, unless it is lost on the way */
+static void frame_forward(struct wire *wire)
+{
+	static const uint8_t delimiter = HDLC_CHAR_DELIMITER;
+	bool drop = atomic_get(&wire->cut) || wire->frame_overflow;
+
+	frame_classify(wire);
+
+	/* A peer without the windowed mode neither sends nor answers control frames */
+	if (IS_ENABLED(CONFIG_NRF_RPC_UART_TEST_LEGACY_PEER) && wire->frame_len == 1) {
+		drop = true;
+	}
+
+	if (drop || ring_buf_space_get(&wire->buf) < wire->frame_len + 2) {
+		/* Behaves like a lost frame */
+		return;
+	}
+
+	ring_buf_put(&wire->buf, &delimiter, 1);
+	ring_buf_put(&wire->buf, wire->frame, wire->frame_len);
+	ring_buf_put(&wire->buf, &delimiter, 1);
+}
+
+/* Called from uart_poll_out() of the sending end */
+static void tx_data_ready(const struct device *dev, size_t size, void *user_data)
+{
+	struct wire *wire = user_data;
+	uint8_t chunk[16];
+	uint32_t len;
+
+	ARG_UNUSED(size);
+
+	K_SPINLOCK(&wire->lock) {
+		while ((len = uart_emul_get_tx_data(dev, chunk, sizeof(chunk))) > 0) {
+			for (uint32_t i = 0; i < len; i++) {
+				if (chunk[i] != HDLC_CHAR_DELIMITER) {
+					if (wire->frame_len < sizeof(wire->frame)) {
+						wire->frame[wire->frame_len++] = chunk[i];
+					} else {
+						wire->frame_overflow = true;
+					}
+					continue;
+				}
+
+				if (wire->frame_len > 0) {
+					frame_forward(wire);
+				}
+
+				wire->frame_len = 0;
+				wire->frame_overflow = false;
+			}
+		}
+	}
+
+	k_sem_give(&wire->ready);
+}
+
+static void wire_deliver(struct wire *wire, uint32_t len)
+{
+	uint8_t chunk[WIRE_CHUNK_SIZE];
+	uint32_t interval;
+
+	while (len > 0) {
+		uint32_t n = 0;
+		uint32_t put = 0;
+
+		K_SPINLOCK(&wire->lock) {
+			n = ring_buf_get(&wire->buf, chunk, MIN(len, sizeof(chunk)));
+		}
+
+		interval = atomic_get(&corrupt_interval);
+
+		for (uint32_t i = 0; i < n; i++) {
+			if (interval != 0 && (++wire->byte_cnt % interval) == 0) {
+				chunk[i] ^= 0x01;
+			}
+		}
+
+		while (put < n) {
+			put += uart_emul_put_rx_data(wire->to, chunk + put, n - put);
+			if (put < n) {
+				k_sleep(K_MSEC(1));
+			}
+		}
+
+		k_usleep(n * WIRE_BYTE_TIME_US);
+		len -= n;
+	}
+}
+
+/* Bytes are delivered to the other end once the link latency has passed. Bytes written while
+ * the previous batch is in flight wait for the next batch, so the latency is approximate.
+ */
+static void wire_thread(void *p1, void *p2, void *p3)
+{
+	struct wire *wire = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		uint32_t len = 0;
+
+		k_sem_take(&wire->ready, K_FOREVER);
+
+		while (atomic_get(&wire->hold)) {
+			k_sleep(K_MSEC(1));
+		}
+
+		K_SPINLOCK(&wire->lock) {
+			len = ring_buf_size_get(&wire->buf);
+		}
+
+		k_sleep(K_MSEC(CONFIG_NRF_RPC_UART_TEST_LATENCY_MS));
+		wire_deliver(wire, len);
+
+		K_SPINLOCK(&wire->lock) {
+			if (!ring_buf_is_empty(&wire->buf)) {
+				k_sem_give(&wire->ready);
+			}
+		}
+	}
+}
+
+static void packet_received(const struct nrf_rpc_tr *transport, const uint8_t *packet,
+			    size_t len, void *context)
+{
+	struct link_rx *rx = context;
+	uint32_t id;
+
+	ARG_UNUSED(transport);
+
+	if (len < sizeof(id)) {
+		rx->errors++;
+		return;
+	}
+
+	id = sys_get_le32(packet);
+
+	if (id != rx->next_id) {
+		rx->errors++;
+	}
+
+	for (size_t i = sizeof(id); i < len; i++) {
+		if (packet[i] != (uint8_t)(id + i)) {
+			rx->errors++;
+			break;
+		}
+	}
+
+	rx->next_id = id + 1;
+
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+	if (!nrf_rpc_os_rx_buf_contains(packet)) {
+		rx->unpooled++;
+	} else if (rx->held_cnt < rx->hold) {
+		nrf_rpc_os_rx_buf_ref(packet);
+		rx->held[rx->held_cnt++] = packet;
+	}
+#endif
+
+	if (rx->next_id == rx->target) {
+		k_sem_give(&rx->done);
+	}
+}
+
+void link_init(void)
+{
+	static bool initialized;
+	int ret;
+
+	if (initialized) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(wires); i++) {
+		struct wire *wire = &wires[i];
+
+		zassert_true(device_is_ready(wire->from));
+		ring_buf_init(&wire->buf, sizeof(wire->buf_data), wire->buf_data);
+		k_sem_init(&wire->ready, 0, 1);
+		uart_emul_callback_tx_data_ready_set(wire->from, tx_data_ready, wire);
+		k_thread_create(&wire_threads[i], wire_stacks[i], WIRE_STACK_SIZE, wire_thread,
+				wire, NULL, NULL, WIRE_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	k_sem_init(&link_rx_a.done, 0, 1);
+	k_sem_init(&link_rx_b.done, 0, 1);
+
+	ret = LINK_TR_A->api->init(LINK_TR_A, packet_received, &link_rx_a);
+	zassert_equal(ret, 0, "Transport A init failed: %d", ret);
+
+	ret = LINK_TR_B->api->init(LINK_TR_B, packet_received, &link_rx_b);
+	zassert_equal(ret, 0, "Transport B init failed: %d", ret);
+
+	/* Let both ends negotiate the transmission mode */
+	k_sleep(K_MSEC(10 * CONFIG_NRF_RPC_UART_TEST_LATENCY_MS));
+
+	initialized = true;
+}
+
+void link_corrupt_set(uint32_t interval)
+{
+	atomic_set(&corrupt_interval, interval);
+}
+
+void link_cut_set(const struct nrf_rpc_tr *from, bool cut)
+{
+	atomic_set(&wire_get(from)->cut, cut);
+}
+
+void link_hold_set(const struct nrf_rpc_tr *from, bool hold)
+{
+	struct wire *wire = wire_get(from);
+
+	atomic_set(&wire->hold, hold);
+
+	if (!hold) {
+		k_sem_give(&wire->ready);
+	}
+}
+
+void link_stats_get(const struct nrf_rpc_tr *from, struct link_stats *stats)
+{
+	struct wire *wire = wire_get(from);
+
+	K_SPINLOCK(&wire->lock) {
+		*stats = wire->stats;
+	}
+}
+
+void link_rx_expect(struct link_rx *rx, uint32_t count)
+{
+	rx->next_id = 0;
+	rx->target = count;
+	rx->errors = 0;
+	k_sem_reset(&rx->done);
+}
+
+void link_rx_hold(struct link_rx *rx, uint32_t hold)
+{
+	__ASSERT_NO_MSG(hold <= LINK_RX_HOLD_MAX);
+
+	rx->hold = hold;
+	rx->held_cnt = 0;
+	rx->unpooled = 0;
+}
+
+void link_rx_release(struct link_rx *rx)
+{
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+	for (uint32_t i = 0; i < rx->held_cnt; i++) {
+		nrf_rpc_os_rx_buf_unref(rx->held[i]);
+	}
+#endif
+
+	rx->hold = 0;
+	rx->held_cnt = 0;
+}
+
+int link_send(const struct nrf_rpc_tr *tr, uint32_t id, size_t len)
+{
+	size_t size = len;
+	uint8_t *packet = tr->api->tx_buf_alloc(tr, &size);
+
+	__ASSERT_NO_MSG(len >= sizeof(id));
+
+	sys_put_le32(id, packet);
+
+	for (size_t i = sizeof(id); i < len; i++) {
+		packet[i] = (uint8_t)(id + i);
+	}
+
+	/* The transport takes the ownership of the packet */
+	return tr->api->send(tr, packet, len);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _LINK_H_
+#define _LINK_H_
+
+#include <nrf_rpc/nrf_rpc_uart.h>
+
+#define LINK_RX_HOLD_MAX 8
+
+#define LINK_TR_A (&NRF_RPC_UART_TRANSPORT(DT_NODELABEL(euart0)))
+#define LINK_TR_B (&NRF_RPC_UART_TRANSPORT(DT_NODELABEL(euart1)))
+
+/* Packets received by one end of the link */
+struct link_rx {
+	uint32_t next_id;
+	uint32_t target;
+	uint32_t errors;
+	struct k_sem done;
+	/* Packets received into the receive buffers of the nRF RPC OS, kept referenced as
+	 * a decoder that borrows them would do
+	 */
+	uint32_t hold;
+	uint32_t held_cnt;
+	const uint8_t *held[LINK_RX_HOLD_MAX];
+	/* Packets received outside of the receive buffers */
+	uint32_t unpooled;
+};
+
+/* Frames sent by one end of the link */
+struct link_stats {
+	/* Capability exchange and start frames of the windowed mode */
+	uint32_t control;
+	/* Data frames of the stop-and-wait mode */
+	uint32_t legacy;
+	/* Data and acknowledgment frames of the windowed mode */
+	uint32_t windowed;
+};
+
+extern struct link_rx link_rx_a;
+extern struct link_rx link_rx_b;
+
+/**
+ * @brief Connect the two emulated UARTs and initialize the transport on both ends.
+ *
+ * Can be called more than once.
+ */
+void link_init(void);
+
+/**
+ * @brief Corrupt one byte out of every @p interval bytes sent over the link.
+ *
+ * @param interval Corruption interval, 0 to disable the corruption.
+ */
+void link_corrupt_set(uint32_t interval);
+
+/**
+ * @brief Drop all frames sent by @p from, as if the link was cut in that direction.
+ */
+void link_cut_set(const struct nrf_rpc_tr *from, bool cut);
+
+/**
+ * @brief Stop delivering bytes sent by @p from until the hold is released. No bytes are lost.
+ */
+void link_hold_set(const struct nrf_rpc_tr *from, bool hold);
+
+/**
+ * @brief Get the number of frames sent by @p from since the link was initialized.
+ */
+void link_stats_get(const struct nrf_rpc_tr *from, struct link_stats *stats);
+
+/**
+ * @brief Start counting packets from id 0. The done semaphore is given after @p count packets
+ *	  have been received.
+ */
+void link_rx_expect(struct link_rx *rx, uint32_t count);
+
+/**
+ * @brief Keep a reference to the receive buffers of the next @p hold packets.
+ */
+void link_rx_hold(struct link_rx *rx, uint32_t hold);
+
+/**
+ * @brief Release the receive buffers referenced with @ref link_rx_hold.
+ */
+void link_rx_release(struct link_rx *rx);
+
+/**
+ * @brief Send a packet with the given id. The contents are derived from the id.
+ */
+int link_send(const struct nrf_rpc_tr *tr, uint32_t id, size_t len);
+
+#endif /* _LINK_H_ */
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include <nrf_rpc.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "link.h"
+
+#define NUM_PACKETS	   200
+#define MAX_PACKET_LEN	   400
+#define RX_TIMEOUT	   K_SECONDS(30)
+/* Corrupt rarely enough that no packet exhausts all transmission attempts */
+#define CORRUPT_INTERVAL   4001
+#define CORRUPT_PACKET_LEN 64
+
+#define MODE_PACKETS	   20
+#define MODE_PACKET_LEN	   32
+/* Time to fill the window, well below the acknowledgment waiting time */
+#define WINDOW_FILL_TIME   K_MSEC(CONFIG_NRF_RPC_UART_ACK_WAITING_TIME / 4)
+#define TX_FAIL_TIMEOUT	   K_MSEC(2 * CONFIG_NRF_RPC_UART_TX_ATTEMPTS * \
+				  CONFIG_NRF_RPC_UART_ACK_WAITING_TIME)
+
+#define REVERSE_STACK_SIZE 1024
+
+K_THREAD_STACK_DEFINE(reverse_stack, REVERSE_STACK_SIZE);
+static struct k_thread reverse_thread;
+
+static K_SEM_DEFINE(err_sem, 0, 1);
+static struct nrf_rpc_err_report last_err;
+static atomic_t window_sent;
+
+static bool window_active(void)
+{
+	return IS_ENABLED(CONFIG_NRF_RPC_UART_WINDOW) &&
+	       !IS_ENABLED(CONFIG_NRF_RPC_UART_TEST_LEGACY_PEER);
+}
+
+static void err_handler(const struct nrf_rpc_err_report *report)
+{
+	last_err = *report;
+	k_sem_give(&err_sem);
+}
+
+static size_t packet_len(uint32_t id)
+{
+	return sizeof(uint32_t) + (id * 37) % (MAX_PACKET_LEN - sizeof(uint32_t));
+}
+
+static void send_packets(const struct nrf_rpc_tr *tr, uint32_t count)
+{
+	int ret;
+
+	for (uint32_t id = 0; id < count; id++) {
+		ret = link_send(tr, id, packet_len(id));
+		zassert_equal(ret, 0, "Failed to send packet %u: %d", id, ret);
+	}
+}
+
+static void reverse_send(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	send_packets(LINK_TR_B, NUM_PACKETS);
+}
+
+ZTEST(suite_nrf_rpc_uart, test_one_way)
+{
+	link_rx_expect(&link_rx_b, NUM_PACKETS);
+
+	send_packets(LINK_TR_A, NUM_PACKETS);
+
+	zassert_ok(k_sem_take(&link_rx_b.done, RX_TIMEOUT), "Not all packets received");
+	zassert_equal(link_rx_b.errors, 0, "Invalid packets received");
+}
+
+ZTEST(suite_nrf_rpc_uart, test_both_ways)
+{
+	link_rx_expect(&link_rx_a, NUM_PACKETS);
+	link_rx_expect(&link_rx_b, NUM_PACKETS);
+
+	k_thread_create(&reverse_thread, reverse_stack, REVERSE_STACK_SIZE, reverse_send, NULL,
+			NULL, NULL, K_PRIO_PREEMPT(2), 0, K_NO_WAIT);
+
+	send_packets(LINK_TR_A, NUM_PACKETS);
+
+	zassert_ok(k_thread_join(&reverse_thread, RX_TIMEOUT));
+	zassert_ok(k_sem_take(&link_rx_a.done, RX_TIMEOUT), "Not all packets received by A");
+	zassert_ok(k_sem_take(&link_rx_b.done, RX_TIMEOUT), "Not all packets received by B");
+	zassert_equal(link_rx_a.errors, 0, "Invalid packets received by A");
+	zassert_equal(link_rx_b.errors, 0, "Invalid packets received by B");
+}
+
+ZTEST(suite_nrf_rpc_uart, test_corrupted_link)
+{
+	int ret;
+
+	link_rx_expect(&link_rx_b, NUM_PACKETS);
+	link_corrupt_set(CORRUPT_INTERVAL);
+
+	for (uint32_t id = 0; id < NUM_PACKETS; id++) {
+		ret = link_send(LINK_TR_A, id, CORRUPT_PACKET_LEN);
+		zassert_equal(ret, 0, "Failed to send packet %u: %d", id, ret);
+	}
+
+	zassert_ok(k_sem_take(&link_rx_b.done, RX_TIMEOUT), "Not all packets received");
+	zassert_equal(link_rx_b.errors, 0, "Lost or duplicate packets received");
+}
+
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+static void window_send(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t id = 0; id <= CONFIG_NRF_RPC_UART_WINDOW_SIZE; id++) {
+		zassert_ok(link_send(LINK_TR_A, id, MODE_PACKET_LEN));
+		atomic_inc(&window_sent);
+	}
+}
+#endif
+
+ZTEST(suite_nrf_rpc_uart, test_negotiated_mode)
+{
+	struct link_stats before;
+	struct link_stats after;
+
+	link_rx_expect(&link_rx_b, MODE_PACKETS);
+	link_stats_get(LINK_TR_A, &before);
+
+	for (uint32_t id = 0; id < MODE_PACKETS; id++) {
+		zassert_ok(link_send(LINK_TR_A, id, MODE_PACKET_LEN));
+	}
+
+	zassert_ok(k_sem_take(&link_rx_b.done, RX_TIMEOUT), "Not all packets received");
+	zassert_equal(link_rx_b.errors, 0, "Invalid packets received");
+
+	link_stats_get(LINK_TR_A, &after);
+
+	if (window_active()) {
+		zassert_equal(after.legacy, before.legacy, "Stop-and-wait frames sent");
+		zassert_true(after.windowed - before.windowed >= MODE_PACKETS,
+			     "Windowed frames not sent");
+	} else {
+		/* A peer without the windowed mode keeps the link in the stop-and-wait mode */
+		zassert_equal(after.windowed, before.windowed, "Windowed frames sent");
+		zassert_true(after.legacy - before.legacy >= MODE_PACKETS,
+			     "Stop-and-wait frames not sent");
+	}
+}
+
+ZTEST(suite_nrf_rpc_uart, test_window_overflow)
+{
+#if defined(CONFIG_NRF_RPC_UART_WINDOW)
+	if (!window_active()) {
+		ztest_test_skip();
+	}
+
+	link_rx_expect(&link_rx_b, CONFIG_NRF_RPC_UART_WINDOW_SIZE + 1);
+	atomic_clear(&window_sent);
+	link_hold_set(LINK_TR_A, true);
+
+	k_thread_create(&reverse_thread, reverse_stack, REVERSE_STACK_SIZE, window_send, NULL,
+			NULL, NULL, K_PRIO_PREEMPT(2), 0, K_NO_WAIT);
+
+	/* The packet that does not fit in the window waits for the acknowledgments */
+	k_sleep(WINDOW_FILL_TIME);
+	zassert_equal(atomic_get(&window_sent), CONFIG_NRF_RPC_UART_WINDOW_SIZE,
+		      "Send did not block on a full window");
+
+	link_hold_set(LINK_TR_A, false);
+
+	zassert_ok(k_thread_join(&reverse_thread, RX_TIMEOUT));
+	zassert_ok(k_sem_take(&link_rx_b.done, RX_TIMEOUT), "Not all packets received");
+	zassert_equal(link_rx_b.errors, 0, "Invalid packets received");
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(suite_nrf_rpc_uart, test_window_tx_failure)
+{
+	if (!window_active()) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&err_sem);
+	link_cut_set(LINK_TR_B, true);
+
+	/* The packets are queued, so the send operation succeeds */
+	for (uint32_t id = 0; id < 2; id++) {
+		zassert_ok(link_send(LINK_TR_B, id, MODE_PACKET_LEN));
+	}
+
+	zassert_ok(k_sem_take(&err_sem, TX_FAIL_TIMEOUT), "Lost packets not reported");
+	zassert_equal(last_err.code, -EPROTO);
+	zassert_equal(last_err.src, NRF_RPC_ERR_SRC_SEND);
+
+	link_cut_set(LINK_TR_B, false);
+
+	/* The transport falls back to the stop-and-wait mode */
+	link_rx_expect(&link_rx_a, MODE_PACKETS);
+
+	for (uint32_t id = 0; id < MODE_PACKETS; id++) {
+		zassert_ok(link_send(LINK_TR_B, id, MODE_PACKET_LEN));
+	}
+
+	zassert_ok(k_sem_take(&link_rx_a.done, RX_TIMEOUT), "Not all packets received");
+	zassert_equal(link_rx_a.errors, 0, "Invalid packets received");
+	zassert_equal(k_sem_count_get(&err_sem), 0, "Unexpected error reported");
+}
+
+ZTEST(suite_nrf_rpc_uart, test_rx_buf_renew)
+{
+#if defined(CONFIG_NRF_RPC_OS_RX_BUF_POOL)
+	/* The transport of the other end holds one receive buffer */
+	const uint32_t count = CONFIG_NRF_RPC_OS_RX_BUF_COUNT - 1;
+
+	/* Each held packet makes the transport switch to a free receive buffer. Once all of them
+	 * are held, the transport falls back to its internal buffer.
+	 */
+	link_rx_expect(&link_rx_b, count + 2);
+	link_rx_hold(&link_rx_b, count);
+
+	for (uint32_t id = 0; id < count + 2; id++) {
+		zassert_ok(link_send(LINK_TR_A, id, MODE_PACKET_LEN));
+	}
+
+	zassert_ok(k_sem_take(&link_rx_b.done, RX_TIMEOUT), "Not all packets received");
+	zassert_equal(link_rx_b.errors, 0, "Invalid packets received");
+	zassert_equal(link_rx_b.held_cnt, count, "Packets not received into receive buffers");
+	zassert_equal(link_rx_b.unpooled, 2, "Receive buffer reused while held");
+
+	/* Held packets were not overwritten by the following ones */
+	for (uint32_t id = 0; id < count; id++) {
+		zassert_equal(sys_get_le32(link_rx_b.held[id]), id, "Held packet %u overwritten",
+			      id);
+	}
+
+	link_rx_release(&link_rx_b);
+
+	/* The transport returns to the receive buffers once they are released */
+	link_rx_expect(&link_rx_b, 2);
+	link_rx_hold(&link_rx_b, 1);
+
+	for (uint32_t id = 0; id < 2; id++) {
+		zassert_ok(link_send(LINK_TR_A, id, MODE_PACKET_LEN));
+	}
+
+	zassert_ok(k_sem_take(&link_rx_b.done, RX_TIMEOUT), "Not all packets received");
+	zassert_equal(link_rx_b.held_cnt, 1, "Receive buffers not used after release");
+
+	link_rx_release(&link_rx_b);
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void *setup(void)
+{
+	zassert_ok(nrf_rpc_init(err_handler));
+	link_init();
+
+	return NULL;
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	link_corrupt_set(0);
+	/* Let retransmissions of the previous test settle */
+	k_sleep(K_MSEC(10 * CONFIG_NRF_RPC_UART_ACK_WAITING_TIME));
+}
+
+ZTEST_SUITE(suite_nrf_rpc_uart, NULL, setup, NULL, after, NULL);
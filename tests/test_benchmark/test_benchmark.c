@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <inttypes.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <test_benchmark.h>
+
+#if defined(CONFIG_NATIVE_LIBRARY)
+/* Implemented in host_time.c, which is built with the host C library */
+uint64_t test_benchmark_host_time_ns(void);
+#endif
+
+uint64_t test_benchmark_time_ns(void)
+{
+#if defined(CONFIG_NATIVE_LIBRARY)
+	return test_benchmark_host_time_ns();
+#else
+	return k_ticks_to_ns_floor64(k_uptime_ticks());
+#endif
+}
+
+void test_benchmark_start(struct test_benchmark *bench, const char *name, uint32_t iterations)
+{
+	__ASSERT_NO_MSG(iterations > 0);
+
+	bench->name = name;
+	bench->iterations = iterations;
+	bench->start_ns = test_benchmark_time_ns();
+}
+
+uint64_t test_benchmark_stop(struct test_benchmark *bench)
+{
+	uint64_t elapsed_ns = test_benchmark_time_ns() - bench->start_ns;
+	uint64_t ns_per_iteration = elapsed_ns / bench->iterations;
+
+	zassert_true(elapsed_ns > 0, "%s: no time elapsed while measuring", bench->name);
+
+	printk("%s: %" PRIu64 " ns/iteration (%u iterations)\n", bench->name, ns_per_iteration,
+	       bench->iterations);
+
+	return ns_per_iteration;
+}